@@ -0,0 +1,459 @@
+package com.bridgeone.app.input
+
+import androidx.compose.ui.geometry.Offset
+import com.bridgeone.app.ui.utils.DeltaCalculator
+import com.bridgeone.app.ui.utils.RightAngleAxis
+import java.util.concurrent.locks.LockSupport
+import kotlin.math.abs
+import kotlin.math.hypot
+
+/**
+ * 커서 이동 제스처 설정 (DOWN 시점 스냅샷)
+ *
+ * 제스처 도중 UI 상태가 바뀌어도 입력 스레드는 이 값으로 일관되게 처리합니다.
+ *
+ * @property deadZonePx 데드존 반경 (px, 터치 다운 지점 기준)
+ * @property rightAngle 직각 이동 모드 여부 (Phase 4.3.5)
+ * @property rightAngleLockDistPx 직각 이동 주축 판정 누적 거리 (px)
+ * @property rightAngleDeadbandDeg 직각 이동 대각선 데드밴드 (°)
+ * @property dpiMultiplier DPI 배율 (Phase 4.3.6)
+ * @property predictionHorizonMs 이동 예측 구간 (ms, 0 = 예측 끔, [MotionPredictor] 참조)
+ */
+data class CursorGestureConfig(
+    val deadZonePx: Float,
+    val rightAngle: Boolean,
+    val rightAngleLockDistPx: Float,
+    val rightAngleDeadbandDeg: Float,
+    val dpiMultiplier: Float,
+    val predictionHorizonMs: Float = 0f
+)
+
+/**
+ * 커서 이동 제스처 상태 머신 (단일 스레드 전용)
+ *
+ * 터치 샘플 하나마다:
+ * 1. 데드존 탈출 판정 (다운 지점 기준 거리)
+ * 2. 직각 이동 모드: 주축 판정 전에는 이동 차단, 판정 후 반대 축 = 0
+ * 3. (선택) 지연 보상: [MotionPredictor] 오프셋 변화량을 더함
+ * 4. DPI 배율 적용 후 서브픽셀 누산 (정수 절삭 손실 없음)
+ *
+ * 누산된 정수 카운트는 [takeCounts]로 꺼내며 ±127 초과분과 소수부는 다음 프레임으로 이월됩니다.
+ */
+class CursorMotionProcessor {
+
+    private var config = CursorGestureConfig(0f, false, 0f, 0f, 1f)
+    private var downX = 0f
+    private var downY = 0f
+    private var rightAngleAccumX = 0f
+    private var rightAngleAccumY = 0f
+    private var pendingX = 0f
+    private var pendingY = 0f
+    private val predictor = MotionPredictor()
+
+    /** 데드존 탈출 여부 */
+    var deadZoneEscaped = false
+        private set
+
+    /** 직각 이동 모드 주축 (미결정이면 UNDECIDED) */
+    var rightAngleAxis = RightAngleAxis.UNDECIDED
+        private set
+
+    /** 마지막 [onSample] 샘플이 누산기에 반영되었는지 (데드존/주축 판정 중이면 false) */
+    var lastSampleAccumulated = false
+        private set
+
+    /** 마지막 [takeCounts] 결과 (-127 ~ 127) */
+    var countX = 0
+        private set
+    var countY = 0
+        private set
+
+    /**
+     * 새 제스처 시작 (누산기/판정 상태 초기화).
+     */
+    fun begin(x: Float, y: Float, gestureConfig: CursorGestureConfig) {
+        config = gestureConfig
+        downX = x
+        downY = y
+        deadZoneEscaped = false
+        rightAngleAxis = RightAngleAxis.UNDECIDED
+        rightAngleAccumX = 0f
+        rightAngleAccumY = 0f
+        pendingX = 0f
+        pendingY = 0f
+        predictor.reset(gestureConfig.predictionHorizonMs)
+    }
+
+    /**
+     * 터치 샘플 1개 처리.
+     *
+     * @param prevX, prevY 직전 샘플 위치 (px)
+     * @param x, y 현재 샘플 위치 (px)
+     * @param eventTimeNanos 샘플 시각 (ns, 0이면 예측 생략)
+     * @return true: 이 샘플에서 직각 이동 주축이 확정됨
+     */
+    fun onSample(prevX: Float, prevY: Float, x: Float, y: Float, eventTimeNanos: Long = 0L): Boolean {
+        lastSampleAccumulated = false
+        val predict = predictor.isEnabled && eventTimeNanos != 0L
+        if (predict) predictor.observe(x, y, eventTimeNanos)
+        if (!deadZoneEscaped) {
+            if (hypot(x - downX, y - downY) < config.deadZonePx) return false
+            deadZoneEscaped = true
+        }
+
+        var delta = DeltaCalculator.calculateDelta(Offset(prevX, prevY), Offset(x, y))
+
+        if (config.rightAngle) {
+            if (rightAngleAxis == RightAngleAxis.UNDECIDED) {
+                rightAngleAccumX += delta.x
+                rightAngleAccumY += delta.y
+                rightAngleAxis = DeltaCalculator.determineRightAngleAxis(
+                    accumX = rightAngleAccumX,
+                    accumY = rightAngleAccumY,
+                    lockDistPx = config.rightAngleLockDistPx,
+                    deadbandDeg = config.rightAngleDeadbandDeg
+                )
+                // 주축 확정 전까지 커서 이동 차단 (확정 샘플 포함)
+                return rightAngleAxis != RightAngleAxis.UNDECIDED
+            }
+            delta = DeltaCalculator.applyRightAngleLock(delta, rightAngleAxis)
+        }
+
+        if (predict) {
+            // 이전 예측을 새 예측으로 교체 (차이만 더하므로 오차가 누적되지 않음)
+            predictor.update()
+            delta += DeltaCalculator.applyRightAngleLock(
+                Offset(predictor.correctionX, predictor.correctionY), rightAngleAxis
+            )
+        }
+
+        pendingX += delta.x * config.dpiMultiplier
+        pendingY += delta.y * config.dpiMultiplier
+        lastSampleAccumulated = true
+        return false
+    }
+
+    /**
+     * 남은 예측 오프셋을 되돌림 (제스처 종료 시 호출 → 총 이동량 = 실제 이동량).
+     */
+    fun retractPrediction() {
+        if (predictor.offsetX == 0f && predictor.offsetY == 0f) return
+        predictor.retract()
+        val correction = DeltaCalculator.applyRightAngleLock(
+            Offset(predictor.correctionX, predictor.correctionY), rightAngleAxis
+        )
+        pendingX += correction.x * config.dpiMultiplier
+        pendingY += correction.y * config.dpiMultiplier
+    }
+
+    /** 전송할 정수 카운트가 남아 있는지 */
+    fun hasPendingCounts(): Boolean = abs(pendingX) >= 1f || abs(pendingY) >= 1f
+
+    /**
+     * 누산기 정수부를 [countX]/[countY]로 꺼냄 (0 방향 절삭, ±127 제한, 나머지 이월).
+     */
+    fun takeCounts() {
+        countX = pendingX.toInt().coerceIn(-MAX_COUNT, MAX_COUNT)
+        countY = pendingY.toInt().coerceIn(-MAX_COUNT, MAX_COUNT)
+        pendingX -= countX
+        pendingY -= countY
+    }
+
+    private companion object {
+        const val MAX_COUNT = 127
+    }
+}
+
+/**
+ * 프레임 지연 측정 스탬프 (입력 스레드 소유, 프레임마다 재사용)
+ *
+ * 시각은 모두 System.nanoTime() 기준입니다 (MotionEvent.eventTime과 같은 단조 시계).
+ */
+class FrameTiming {
+    /** 프레임에 포함된 가장 오래된 샘플의 터치 시각 (ns, 0 = 측정 대상 아님) */
+    var sourceNanos = 0L
+        internal set
+
+    /** 그 샘플을 입력 스레드가 처리한 시각 (ns) */
+    var processedNanos = 0L
+        internal set
+
+    /** 이 프레임에 합쳐진 샘플 수 */
+    var sampleCount = 0
+        internal set
+}
+
+/**
+ * 커서 입력 파이프라인 - 전용 입력 스레드에서 터치 샘플 처리 및 1kHz 페이싱
+ *
+ * UI 스레드(Compose pointerInput)는 MotionEvent의 모든 샘플(historical 포함) 좌표를
+ * 사전 할당된 링에 넣기만 하고, 입력 스레드가:
+ * - [CursorMotionProcessor]로 데드존/직각 잠금/DPI/서브픽셀 누산
+ * - USB 프레임 예산(HID bInterval 1ms)에 맞춰 최대 [minFrameIntervalNanos]당 1프레임으로 합쳐 전송
+ * 을 수행합니다. 리컴포지션 지연이 있어도 샘플은 버려지지 않고 다음 프레임에 합쳐집니다.
+ *
+ * 순수 Kotlin(Android API 미사용)이므로 JVM 단위 테스트에서 [pump]로 직접 구동할 수 있습니다.
+ *
+ * @param sink 프레임 출력 (입력 스레드에서 호출)
+ * @param minFrameIntervalNanos 이동 프레임 최소 간격
+ * @param nanoClock 단조 시계 (테스트 주입용)
+ */
+class CursorInputPipeline(
+    private val sink: FrameSink,
+    private val minFrameIntervalNanos: Long = FRAME_INTERVAL_NANOS,
+    private val nanoClock: () -> Long = System::nanoTime
+) {
+
+    /**
+     * 프레임 출력 콜백 (buttons: 마우스 버튼 비트, dx/dy: -127 ~ 127).
+     * timing은 호출 동안만 유효합니다 (다음 프레임에서 재사용).
+     */
+    fun interface FrameSink {
+        fun send(buttons: Int, dx: Int, dy: Int, timing: FrameTiming)
+    }
+
+    /** 직각 이동 주축 확정 알림 (입력 스레드에서 호출 → UI 갱신은 메인 스레드로 post) */
+    fun interface AxisLockListener {
+        fun onAxisLocked(axis: RightAngleAxis)
+    }
+
+    @Volatile
+    var axisLockListener: AxisLockListener? = null
+
+    private val processor = CursorMotionProcessor()
+
+    // ── 이벤트 링 (UI 스레드 → 입력 스레드), 사전 할당 ──
+    // synchronized + park/unpark: Condition.await()는 대기 노드를 할당하므로 사용하지 않음
+    private val lock = Any()
+    private val eventTypes = IntArray(EVENT_CAPACITY)
+    private val eventCoords = FloatArray(EVENT_CAPACITY * 4)
+    private val eventArgs = IntArray(EVENT_CAPACITY)
+    private val eventTimes = LongArray(EVENT_CAPACITY)
+    private val eventConfigs = arrayOfNulls<CursorGestureConfig>(EVENT_CAPACITY)
+    private var head = 0
+    private var count = 0
+
+    // ── 입력 스레드 전용 ──
+    private var lastEmitNanos = Long.MIN_VALUE / 2
+    private var curType = 0
+    private var curPrevX = 0f
+    private var curPrevY = 0f
+    private var curX = 0f
+    private var curY = 0f
+    private var curArg = 0
+    private var curConfig: CursorGestureConfig? = null
+    private var curEventNanos = 0L
+    private val timing = FrameTiming()
+
+    @Volatile
+    private var worker: Thread? = null
+
+    // ==================== UI 스레드 API ====================
+
+    /**
+     * 새 제스처 시작 (터치 DOWN).
+     */
+    fun beginGesture(x: Float, y: Float, config: CursorGestureConfig) {
+        enqueue(EVENT_BEGIN, x, y, x, y, 0, config, 0L)
+    }
+
+    /**
+     * 커서 이동 샘플 추가 (MotionEvent historical 샘플 포함, 순서대로).
+     *
+     * 링이 가득 차면 직전 이동 샘플과 합칩니다 (시작점 유지, 끝점 갱신 → 총 이동량 보존).
+     *
+     * @param eventTimeNanos 샘플의 MotionEvent.eventTime (ns, 지연 측정용, 0 = 측정 안 함)
+     */
+    fun submitSample(prevX: Float, prevY: Float, x: Float, y: Float, eventTimeNanos: Long = 0L) {
+        enqueue(EVENT_MOVE, prevX, prevY, x, y, 0, null, eventTimeNanos)
+    }
+
+    /**
+     * 버튼 상태 프레임 요청 (클릭 press/release).
+     *
+     * 앞선 이동 샘플의 미전송 이동량을 포함하여 페이싱 없이 즉시 전송합니다.
+     */
+    fun submitButtons(buttons: Int) {
+        enqueue(EVENT_BUTTONS, 0f, 0f, 0f, 0f, buttons, null, 0L)
+    }
+
+    /**
+     * 입력 스레드 시작.
+     */
+    fun start() {
+        if (worker != null) return
+        worker = Thread({
+            while (!Thread.currentThread().isInterrupted) {
+                val waitNanos = pump()
+                // enqueue()는 count 증가 후 unpark하므로, 여기서 본 count == 0 이후의
+                // 이벤트는 park를 즉시 깨움 (unpark 허가가 남아 있음)
+                if (synchronized(lock) { count } == 0) {
+                    if (waitNanos < 0) LockSupport.park(this) else LockSupport.parkNanos(this, waitNanos)
+                }
+            }
+        }, "BridgeOne-Input").apply {
+            isDaemon = true
+            priority = Thread.MAX_PRIORITY // 커서 이동 지연 최소화 (UART 전송 스레드와 동일)
+            start()
+        }
+    }
+
+    /**
+     * 입력 스레드 중지 (대기 중 이벤트는 버림).
+     */
+    fun stop() {
+        worker?.interrupt()
+        worker = null
+        synchronized(lock) {
+            head = 0
+            count = 0
+        }
+    }
+
+    // ==================== 입력 스레드 ====================
+
+    /**
+     * 대기 중인 이벤트를 모두 처리하고, 페이싱이 허용하면 이동 프레임 1개를 전송합니다.
+     *
+     * @return 다음 이동 프레임까지 대기할 시간 (ns), 보낼 이동량이 없으면 -1
+     */
+    fun pump(): Long {
+        while (pollEvent()) {
+            when (curType) {
+                EVENT_BEGIN -> {
+                    processor.begin(curX, curY, curConfig!!)
+                    resetTiming()
+                }
+                EVENT_MOVE -> {
+                    if (processor.onSample(curPrevX, curPrevY, curX, curY, curEventNanos)) {
+                        axisLockListener?.onAxisLocked(processor.rightAngleAxis)
+                    }
+                    if (processor.lastSampleAccumulated) {
+                        if (timing.sampleCount == 0 && timing.sourceNanos == 0L) {
+                            timing.sourceNanos = curEventNanos
+                            timing.processedNanos = if (curEventNanos != 0L) nanoClock() else 0L
+                        }
+                        timing.sampleCount++
+                    }
+                }
+                EVENT_BUTTONS -> {
+                    // 클릭/릴리즈 = 제스처 종료: 예측 오프셋을 되돌려 순 이동량 보존
+                    processor.retractPrediction()
+                    processor.takeCounts()
+                    emit(curArg)
+                    lastEmitNanos = nanoClock()
+                }
+            }
+        }
+
+        if (!processor.hasPendingCounts()) return -1
+
+        val now = nanoClock()
+        val due = lastEmitNanos + minFrameIntervalNanos
+        if (now < due) return due - now
+
+        processor.takeCounts()
+        emit(0)
+        lastEmitNanos = now
+        return if (processor.hasPendingCounts()) minFrameIntervalNanos else -1
+    }
+
+    /**
+     * 프레임 1개 출력 후 타이밍 갱신.
+     *
+     * ±127 초과로 이월된 이동량이 남으면 원본 샘플 시각을 유지하여
+     * 다음 프레임의 지연도 같은 샘플 기준으로 측정합니다.
+     */
+    private fun emit(buttons: Int) {
+        sink.send(buttons, processor.countX, processor.countY, timing)
+        timing.sampleCount = 0
+        if (!processor.hasPendingCounts()) {
+            timing.sourceNanos = 0L
+            timing.processedNanos = 0L
+        }
+    }
+
+    private fun resetTiming() {
+        timing.sourceNanos = 0L
+        timing.processedNanos = 0L
+        timing.sampleCount = 0
+    }
+
+    /**
+     * 가장 오래된 이벤트를 cur* 필드로 꺼냄 (할당 없음).
+     *
+     * @return false: 큐가 비어 있음
+     */
+    private fun pollEvent(): Boolean = synchronized(lock) {
+        if (count == 0) return false
+        val base = head * 4
+        curType = eventTypes[head]
+        curPrevX = eventCoords[base]
+        curPrevY = eventCoords[base + 1]
+        curX = eventCoords[base + 2]
+        curY = eventCoords[base + 3]
+        curArg = eventArgs[head]
+        curEventNanos = eventTimes[head]
+        curConfig = eventConfigs[head]
+        eventConfigs[head] = null
+        head = (head + 1) % EVENT_CAPACITY
+        count--
+        true
+    }
+
+    private fun enqueue(
+        type: Int, prevX: Float, prevY: Float, x: Float, y: Float,
+        arg: Int, config: CursorGestureConfig?, eventNanos: Long
+    ) {
+        while (!tryEnqueue(type, prevX, prevY, x, y, arg, config, eventNanos)) {
+            // 링이 가득 찬 BEGIN/BUTTONS (드묾): 입력 스레드가 비울 때까지 짧게 대기
+            worker?.let { LockSupport.unpark(it) }
+            LockSupport.parkNanos(FULL_WAIT_NANOS)
+        }
+        worker?.let { LockSupport.unpark(it) }
+    }
+
+    /**
+     * 링 끝에 이벤트 기록 (가득 차면 이동 샘플은 직전 이동과 합침).
+     *
+     * @return false: 링이 가득 차 기록하지 못함
+     */
+    private fun tryEnqueue(
+        type: Int, prevX: Float, prevY: Float, x: Float, y: Float,
+        arg: Int, config: CursorGestureConfig?, eventNanos: Long
+    ): Boolean = synchronized(lock) {
+        if (count == EVENT_CAPACITY) {
+            val newest = (head + count - 1) % EVENT_CAPACITY
+            if (type != EVENT_MOVE || eventTypes[newest] != EVENT_MOVE) return false
+            eventCoords[newest * 4 + 2] = x
+            eventCoords[newest * 4 + 3] = y
+            return true
+        }
+        val slot = (head + count) % EVENT_CAPACITY
+        val base = slot * 4
+        eventTypes[slot] = type
+        eventCoords[base] = prevX
+        eventCoords[base + 1] = prevY
+        eventCoords[base + 2] = x
+        eventCoords[base + 3] = y
+        eventArgs[slot] = arg
+        eventTimes[slot] = eventNanos
+        eventConfigs[slot] = config
+        count++
+        true
+    }
+
+    companion object {
+        /** USB HID 프레임 주기 (ESP32-S3 HID 엔드포인트 bInterval = 1ms) */
+        const val FRAME_INTERVAL_NANOS = 1_000_000L
+
+        /** 이벤트 링 용량 (240Hz 터치 기준 약 1초분) */
+        const val EVENT_CAPACITY = 256
+
+        private const val FULL_WAIT_NANOS = 1_000_000L
+
+        private const val EVENT_BEGIN = 1
+        private const val EVENT_MOVE = 2
+        private const val EVENT_BUTTONS = 3
+    }
+}
@@ -0,0 +1,181 @@
+package com.bridgeone.app.input
+
+import kotlin.math.abs
+import kotlin.math.hypot
+import kotlin.math.sign
+
+/**
+ * 커서 이동 예측기 - 파이프라인 지연만큼 손가락 위치를 외삽 (지연 보상)
+ *
+ * 최근 샘플의 속도/가속도로 [horizonNanos] 뒤의 위치를 예측하고, 실제 위치와의 차이를
+ * "예측 오프셋"으로 유지합니다. 새 실제 샘플이 올 때마다 오프셋을 다시 계산하고
+ * 이전 오프셋과의 차이만 내보내므로, 오프셋은 누적되지 않고 매 샘플마다 스스로 보정됩니다.
+ * 제스처 종료 시 [retract]로 남은 오프셋을 되돌리면 총 이동량은 예측이 없을 때와 같습니다.
+ *
+ *   출력 이동량 = 실제 이동량 + (새 오프셋 - 이전 오프셋)
+ *   Σ 출력 = Σ 실제 + 마지막 오프셋 - 0  →  retract 후 Σ 출력 = Σ 실제
+ *
+ * 과잉 예측 방지:
+ * - 가속도 항은 [ACCEL_WEIGHT]로 감쇠하고, 축별로 속도 방향과 반대로 예측하지 않음 (정지 직전 역행 방지)
+ * - 오프셋 크기는 [MAX_OFFSET_PX]로 제한
+ * - 샘플 간격이 [STALE_GAP_NANOS]를 넘으면 속도를 초기화 (멈췄다 다시 움직이는 경우)
+ *
+ * 좌표 단위는 px(DPI 배율 적용 전), 시각은 System.nanoTime() 기준입니다.
+ */
+class MotionPredictor {
+
+    private var horizonNanos = 0L
+    private var hasSample = false
+    private var hasVelocity = false
+    private var lastT = 0L
+    private var lastX = 0f
+    private var lastY = 0f
+    private var vx = 0f   // px/ms
+    private var vy = 0f
+    private var ax = 0f   // px/ms²
+    private var ay = 0f
+
+    /** 현재 적용 중인 예측 오프셋 (px) */
+    var offsetX = 0f
+        private set
+    var offsetY = 0f
+        private set
+
+    /** 마지막 [update]/[retract]로 바뀐 오프셋 변화량 (출력 이동량에 더할 값, px) */
+    var correctionX = 0f
+        private set
+    var correctionY = 0f
+        private set
+
+    /** 예측 사용 여부 */
+    val isEnabled: Boolean
+        get() = horizonNanos > 0
+
+    /**
+     * 새 제스처 시작 (상태 초기화).
+     *
+     * @param horizonMs 예측 구간 (ms, 0이면 비활성)
+     */
+    fun reset(horizonMs: Float) {
+        horizonNanos = (horizonMs.coerceIn(0f, MAX_HORIZON_MS) * 1_000_000f).toLong()
+        hasSample = false
+        hasVelocity = false
+        vx = 0f; vy = 0f
+        ax = 0f; ay = 0f
+        offsetX = 0f; offsetY = 0f
+        correctionX = 0f; correctionY = 0f
+    }
+
+    /**
+     * 실제 샘플 반영 (속도/가속도 추정만 갱신, 오프셋은 변경하지 않음).
+     *
+     * @param x, y 샘플 위치 (px)
+     * @param tNanos 샘플 시각 (MotionEvent.eventTime, ns)
+     */
+    fun observe(x: Float, y: Float, tNanos: Long) {
+        if (!hasSample) {
+            hasSample = true
+        } else {
+            val dtNanos = tNanos - lastT
+            if (dtNanos > STALE_GAP_NANOS) {
+                hasVelocity = false
+                vx = 0f; vy = 0f
+                ax = 0f; ay = 0f
+            } else if (dtNanos > 0) {
+                val dtMs = dtNanos / 1_000_000f
+                val newVx = (x - lastX) / dtMs
+                val newVy = (y - lastY) / dtMs
+                if (hasVelocity) {
+                    ax += VELOCITY_SMOOTHING * ((newVx - vx) / dtMs - ax)
+                    ay += VELOCITY_SMOOTHING * ((newVy - vy) / dtMs - ay)
+                    vx += VELOCITY_SMOOTHING * (newVx - vx)
+                    vy += VELOCITY_SMOOTHING * (newVy - vy)
+                } else {
+                    vx = newVx
+                    vy = newVy
+                    hasVelocity = true
+                }
+            } else {
+                // 같은 ms 타임스탬프(배치 샘플): 위치만 갱신
+                lastX = x
+                lastY = y
+                return
+            }
+        }
+        lastT = tNanos
+        lastX = x
+        lastY = y
+    }
+
+    /**
+     * 직전 [observe] 기준으로 예측 오프셋을 다시 계산하고 변화량을 [correctionX]/[correctionY]에 기록.
+     */
+    fun update() {
+        var newX = 0f
+        var newY = 0f
+        if (isEnabled && hasVelocity) {
+            val h = horizonNanos / 1_000_000f
+            newX = extrapolate(vx, ax, h)
+            newY = extrapolate(vy, ay, h)
+            val magnitude = hypot(newX, newY)
+            if (magnitude > MAX_OFFSET_PX) {
+                val scale = MAX_OFFSET_PX / magnitude
+                newX *= scale
+                newY *= scale
+            }
+        }
+        correctionX = newX - offsetX
+        correctionY = newY - offsetY
+        offsetX = newX
+        offsetY = newY
+    }
+
+    /**
+     * 남은 예측 오프셋을 되돌림 (제스처 종료 시). 변화량은 [correctionX]/[correctionY]에 기록.
+     */
+    fun retract() {
+        correctionX = -offsetX
+        correctionY = -offsetY
+        offsetX = 0f
+        offsetY = 0f
+    }
+
+    private fun extrapolate(v: Float, a: Float, h: Float): Float {
+        val predicted = v * h + 0.5f * ACCEL_WEIGHT * a * h * h
+        // 속도 방향과 반대로는 예측하지 않음 (감속 중 역행 방지)
+        return if (sign(predicted) != sign(v) || abs(v) < MIN_SPEED_PX_MS) 0f else predicted
+    }
+
+    companion object {
+        /** 예측 구간 상한 (ms): 이보다 길면 오차가 이득보다 커짐 */
+        const val MAX_HORIZON_MS = 12f
+
+        /** 측정 지연이 없을 때 기본 예측 구간 (ms) */
+        const val DEFAULT_HORIZON_MS = 4f
+
+        /** 예측 오프셋 최대 크기 (px) */
+        const val MAX_OFFSET_PX = 48f
+
+        /** 속도/가속도 지수 평활 계수 */
+        private const val VELOCITY_SMOOTHING = 0.5f
+
+        /** 가속도 항 가중치 (노이즈가 크므로 절반만 반영) */
+        private const val ACCEL_WEIGHT = 0.5f
+
+        /** 이보다 느리면 예측하지 않음 (px/ms): 미세 조작 시 떨림 증폭 방지 */
+        private const val MIN_SPEED_PX_MS = 0.05f
+
+        /** 샘플 간격이 이보다 길면 속도 초기화 (ns) */
+        private const val STALE_GAP_NANOS = 50_000_000L
+
+        /**
+         * 측정된 터치 → UART 지연(p50)으로 예측 구간 결정.
+         *
+         * @param measuredMicros 측정 지연 (µs, 0 = 아직 측정값 없음)
+         * @return 예측 구간 (ms, [MAX_HORIZON_MS] 이하)
+         */
+        fun horizonForLatency(measuredMicros: Long): Float =
+            if (measuredMicros <= 0) DEFAULT_HORIZON_MS
+            else (measuredMicros / 1000f).coerceAtMost(MAX_HORIZON_MS)
+    }
+}
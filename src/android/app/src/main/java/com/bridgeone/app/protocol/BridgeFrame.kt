@@ -49,6 +49,13 @@ data class BridgeFrame(
         val BUTTON_RIGHT_MASK = 0x02.toUByte()
         val BUTTON_MIDDLE_MASK = 0x04.toUByte()
 
+        // buttons 상위 비트: wheel 필드 해석 플래그 (ESP32 BRIDGE_FLAG_*)
+        val BUTTON_FLAG_HORIZONTAL_WHEEL = 0x08.toUByte()  // wheel → 수평 휠(AC Pan)
+        val BUTTON_FLAG_HIRES_WHEEL = 0x10.toUByte()       // wheel 단위 = 1/WHEEL_UNITS_PER_DETENT 디텐트
+
+        /** 휠 1디텐트당 고해상도 단위 수 (ESP32 HID_WHEEL_UNITS_PER_DETENT, Windows WHEEL_DELTA) */
+        const val WHEEL_UNITS_PER_DETENT = 120
+
         // 키보드 수정자 키 비트 마스크
         val MODIFIER_LEFT_CTRL_MASK = 0x01.toUByte()
         val MODIFIER_LEFT_SHIFT_MASK = 0x02.toUByte()
@@ -105,6 +112,24 @@ data class BridgeFrame(
         this[7] = keyCode2.toByte()
     }
 
+    /**
+     * 프레임을 [FrameRing] 슬롯에 직접 기록합니다 ([toByteArray]와 같은 레이아웃, 할당 없음).
+     *
+     * @param ring 기록할 전송 링
+     */
+    fun writeTo(ring: FrameRing) {
+        ring.put(
+            seq.toByte(),
+            buttons.toByte(),
+            deltaX,
+            deltaY,
+            wheel,
+            modifiers.toByte(),
+            keyCode1.toByte(),
+            keyCode2.toByte()
+        )
+    }
+
     /**
      * 왼쪽 클릭 버튼이 눌린 상태인지 확인합니다.
      *
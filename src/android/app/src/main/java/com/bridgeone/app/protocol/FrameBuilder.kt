@@ -88,6 +88,49 @@ object FrameBuilder {
         keyCode2 = keyCode2
     )
 
+    /**
+     * 프레임을 [FrameRing] 슬롯에 직접 기록합니다 (할당 없음).
+     *
+     * [buildFrame]과 같은 시퀀스 카운터를 사용하므로 두 경로를 섞어 써도 순번이 이어집니다.
+     * BridgeFrame 객체와 ByteArray를 만들지 않으므로 120~240Hz 커서 이동 경로에 사용합니다.
+     *
+     * @param ring 기록할 전송 링
+     * @param buttons 마우스 버튼 비트 + 휠 플래그 (BridgeFrame.BUTTON_FLAG_*)
+     * @param deltaX X축 상대 이동값 (-128 ~ 127)
+     * @param deltaY Y축 상대 이동값 (-128 ~ 127)
+     * @param wheel 마우스 휠 값 (-128 ~ 127)
+     * @param modifiers 키보드 수정자 키 비트 (0x00~0x0F)
+     * @param keyCode1 첫 번째 키코드
+     * @param keyCode2 두 번째 키코드
+     * @param sourceNanos 프레임에 포함된 가장 오래된 터치 샘플 시각 (지연 측정용, 0 = 없음)
+     * @param processedNanos 그 샘플의 입력 스레드 처리 시각
+     */
+    fun writeFrame(
+        ring: FrameRing,
+        buttons: UByte,
+        deltaX: Byte,
+        deltaY: Byte,
+        wheel: Byte,
+        modifiers: UByte = 0u,
+        keyCode1: UByte = 0u,
+        keyCode2: UByte = 0u,
+        sourceNanos: Long = 0L,
+        processedNanos: Long = 0L
+    ) {
+        ring.put(
+            getNextSequence().toByte(),
+            buttons.toByte(),
+            deltaX,
+            deltaY,
+            wheel,
+            modifiers.toByte(),
+            keyCode1.toByte(),
+            keyCode2.toByte(),
+            sourceNanos,
+            processedNanos
+        )
+    }
+
     /**
      * 순번 카운터를 초기화합니다.
      *
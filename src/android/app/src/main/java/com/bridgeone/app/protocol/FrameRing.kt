@@ -0,0 +1,178 @@
+package com.bridgeone.app.protocol
+
+import java.util.concurrent.locks.LockSupport
+
+/**
+ * 사전 할당된 8바이트 프레임 슬롯 링 (다중 생산자 / 단일 소비자)
+ *
+ * 프레임 전송 핫패스에서 힙 할당을 없애기 위한 전송 큐입니다.
+ * - 생산자(입력 스레드, UI 스레드, 폴링 스레드)는 [put]으로 슬롯에 직접 기록
+ * - 소비자(UART 전송 스레드)는 [take]로 자신이 소유한 버퍼에 복사
+ * - 가득 차면 가장 오래된 프레임을 덮어씀 (이미 지연된 델타이므로 버려도 무방, 기존 큐 정책과 동일)
+ *
+ * 슬롯마다 지연 측정용 타임스탬프(원본 터치 시각, 처리 시각, 기록 시각)를 함께 보관하며,
+ * 소비자는 [take]/[poll] 직후 [lastSourceNanos] 등으로 읽습니다.
+ *
+ * 정상 상태에서 put/take는 객체를 생성하지 않습니다:
+ * 슬롯은 생성 시 한 번 할당하고, 소비자 대기는 LockSupport.park/unpark로 처리합니다
+ * (LinkedBlockingQueue 노드, Condition 대기 노드 할당 없음).
+ *
+ * @param capacity 슬롯 수 (기존 LinkedBlockingQueue 용량과 동일한 64 기본값)
+ */
+class FrameRing(private val capacity: Int = DEFAULT_CAPACITY) {
+
+    private val slots = ByteArray(capacity * FRAME_SIZE)
+    private val stamps = LongArray(capacity * STAMP_COUNT)
+    private var head = 0
+    private var count = 0
+
+    /** take()에서 대기 중인 소비자 스레드 */
+    @Volatile
+    private var waiter: Thread? = null
+
+    /** 링이 가득 차 덮어쓴 프레임 수 (디버그용) */
+    @Volatile
+    var droppedCount = 0L
+        private set
+
+    // ── 마지막으로 꺼낸 프레임의 타임스탬프 (소비자 스레드 전용, System.nanoTime 기준) ──
+
+    /** 프레임에 포함된 가장 오래된 터치 샘플 시각 (0 = 터치와 무관한 프레임) */
+    var lastSourceNanos = 0L
+        private set
+
+    /** 그 샘플을 입력 스레드가 처리한 시각 */
+    var lastProcessedNanos = 0L
+        private set
+
+    /** 링에 기록된 시각 */
+    var lastEnqueueNanos = 0L
+        private set
+
+    /** 대기 중인 프레임 수 */
+    val size: Int
+        get() = synchronized(this) { count }
+
+    /**
+     * 프레임 필드를 다음 슬롯에 직접 기록합니다.
+     *
+     * @param sourceNanos 프레임에 포함된 가장 오래된 터치 샘플 시각 (지연 측정용, 0 = 없음)
+     * @param processedNanos 그 샘플의 처리 시각
+     */
+    fun put(
+        b0: Byte, b1: Byte, b2: Byte, b3: Byte,
+        b4: Byte, b5: Byte, b6: Byte, b7: Byte,
+        sourceNanos: Long = 0L, processedNanos: Long = 0L
+    ) {
+        val enqueueNanos = System.nanoTime()
+        synchronized(this) {
+            val slot = reserveSlot()
+            writeStamps(slot, sourceNanos, processedNanos, enqueueNanos)
+            val base = slot * FRAME_SIZE
+            slots[base] = b0
+            slots[base + 1] = b1
+            slots[base + 2] = b2
+            slots[base + 3] = b3
+            slots[base + 4] = b4
+            slots[base + 5] = b5
+            slots[base + 6] = b6
+            slots[base + 7] = b7
+        }
+        wakeConsumer()
+    }
+
+    /**
+     * 이미 직렬화된 8바이트 프레임을 복사합니다 (쿼리/설정 프레임 등 비핫패스용).
+     */
+    fun put(frame: ByteArray) {
+        require(frame.size == FRAME_SIZE) { "Invalid frame size: ${frame.size}, expected: $FRAME_SIZE" }
+        val enqueueNanos = System.nanoTime()
+        synchronized(this) {
+            val slot = reserveSlot()
+            writeStamps(slot, 0L, 0L, enqueueNanos)
+            System.arraycopy(frame, 0, slots, slot * FRAME_SIZE, FRAME_SIZE)
+        }
+        wakeConsumer()
+    }
+
+    /**
+     * 가장 오래된 프레임을 [dest]에 복사합니다 (논블로킹).
+     *
+     * @param dest 8바이트 이상 버퍼 (호출자 소유, 재사용)
+     * @return false: 링이 비어 있음
+     */
+    fun poll(dest: ByteArray): Boolean = synchronized(this) {
+        if (count == 0) return false
+        System.arraycopy(slots, head * FRAME_SIZE, dest, 0, FRAME_SIZE)
+        val stampBase = head * STAMP_COUNT
+        lastSourceNanos = stamps[stampBase]
+        lastProcessedNanos = stamps[stampBase + 1]
+        lastEnqueueNanos = stamps[stampBase + 2]
+        head = (head + 1) % capacity
+        count--
+        true
+    }
+
+    /**
+     * 프레임이 들어올 때까지 대기한 뒤 [dest]에 복사합니다 (단일 소비자 전용).
+     *
+     * @throws InterruptedException 대기 중 인터럽트
+     */
+    fun take(dest: ByteArray) {
+        while (true) {
+            if (poll(dest)) return
+            waiter = Thread.currentThread()
+            // 대기 등록 후 재확인: 등록 직전에 들어온 프레임의 unpark 누락 방지
+            if (synchronized(this) { count } == 0) {
+                LockSupport.park(this)
+            }
+            waiter = null
+            if (Thread.interrupted()) throw InterruptedException()
+        }
+    }
+
+    /**
+     * 대기 중인 프레임을 모두 버립니다.
+     */
+    fun clear() {
+        synchronized(this) {
+            head = 0
+            count = 0
+        }
+    }
+
+    /** 기록할 슬롯 인덱스 (가득 차면 가장 오래된 슬롯 재사용). synchronized 안에서 호출 */
+    private fun reserveSlot(): Int {
+        if (count == capacity) {
+            head = (head + 1) % capacity
+            count--
+            droppedCount++
+        }
+        val slot = (head + count) % capacity
+        count++
+        return slot
+    }
+
+    private fun writeStamps(slot: Int, sourceNanos: Long, processedNanos: Long, enqueueNanos: Long) {
+        val base = slot * STAMP_COUNT
+        stamps[base] = sourceNanos
+        stamps[base + 1] = processedNanos
+        stamps[base + 2] = enqueueNanos
+    }
+
+    private fun wakeConsumer() {
+        val consumer = waiter
+        if (consumer != null) LockSupport.unpark(consumer)
+    }
+
+    companion object {
+        /** 프레임 크기 (BridgeFrame.FRAME_SIZE_BYTES) */
+        const val FRAME_SIZE = BridgeFrame.FRAME_SIZE_BYTES
+
+        /** 기본 슬롯 수: 360Hz 터치 / 60Hz Compose 기준 약 10프레임분 */
+        const val DEFAULT_CAPACITY = 64
+
+        /** 슬롯당 타임스탬프 수 (source, processed, enqueue) */
+        private const val STAMP_COUNT = 3
+    }
+}
@@ -11,10 +11,14 @@ package com.bridgeone.app.protocol
  * │ Header │ Event Type │  Data  │      Reserved (5B)       │
  * │  0xFE  │    1B      │   1B   │  0x00 * 5                │
  * └────────┴────────────┴────────┴──────────────────────────┘
+ *
+ * EVENT_MACRO_SLOTS는 바이트 2~5를 32비트 비트맵(Little-Endian)으로 사용합니다 ([word]).
  */
 data class NotificationFrame(
     val eventType: UByte,
-    val data: UByte
+    val data: UByte,
+    /** 바이트 2~5 (Little-Endian) — 32비트 데이터를 싣는 이벤트용 */
+    val word: UInt = data.toUInt()
 ) {
     companion object {
         /** 역방향 알림 프레임 헤더 바이트 (0xFE) */
@@ -26,6 +30,9 @@ data class NotificationFrame(
         /** 이벤트 타입: 연결 상태 변경 (향후 확장용) */
         val EVENT_CONNECTION_STATE: UByte = 0x02u
 
+        /** 이벤트 타입: 저장된 매크로 슬롯 비트맵 (MACRO_SLOTS 쿼리 응답, [word]의 비트 n = 매크로 ID n) */
+        val EVENT_MACRO_SLOTS: UByte = 0x03u
+
         /** 데이터: Essential 모드 */
         val MODE_ESSENTIAL: UByte = 0x00u
 
@@ -46,7 +53,11 @@ data class NotificationFrame(
             if (bytes[0].toUByte() != HEADER) return null
             return NotificationFrame(
                 eventType = bytes[1].toUByte(),
-                data = bytes[2].toUByte()
+                data = bytes[2].toUByte(),
+                word = (bytes[2].toUInt() and 0xFFu) or
+                       ((bytes[3].toUInt() and 0xFFu) shl 8) or
+                       ((bytes[4].toUInt() and 0xFFu) shl 16) or
+                       ((bytes[5].toUInt() and 0xFFu) shl 24)
             )
         }
     }
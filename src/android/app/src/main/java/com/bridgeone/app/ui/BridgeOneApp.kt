@@ -33,6 +33,7 @@ import androidx.compose.ui.unit.dp
 import androidx.compose.ui.unit.sp
 import com.bridgeone.app.protocol.BridgeMode
 import com.bridgeone.app.ui.common.BOTTOM_SAFE_ZONE
+import com.bridgeone.app.ui.common.LatencyDebugOverlay
 import com.bridgeone.app.ui.common.StatusToastOverlay
 import com.bridgeone.app.ui.common.TOP_SAFE_ZONE
 import com.bridgeone.app.ui.common.ToastController
@@ -56,6 +57,9 @@ private const val EXIT_CONFIRMATION_TOAST_DURATION_MS = 2000L
 // [DEV] true → USB 연결 없이 UI 테스트 (Splash 후 바로 Active, 모드 전환 버튼 표시)
 private const val DEV_SKIP_CONNECTION = true
 
+// [DEV] true → Active 화면 우상단에 터치 → UART 지연 오버레이 표시
+private const val DEV_SHOW_LATENCY_OVERLAY = false
+
 // ============================================================
 // 최상위 Composable
 // ============================================================
@@ -294,6 +298,11 @@ fun BridgeOneApp() {
                             )
                         }
                     }
+
+                    // [DEV] 터치 → UART 지연 오버레이 (우상단 고정)
+                    if (DEV_SHOW_LATENCY_OVERLAY) {
+                        LatencyDebugOverlay(modifier = Modifier.align(Alignment.TopEnd).padding(8.dp))
+                    }
                 }
             }
         }
@@ -0,0 +1,92 @@
+package com.bridgeone.app.ui.common
+
+import android.util.Log
+import androidx.compose.foundation.background
+import androidx.compose.foundation.clickable
+import androidx.compose.foundation.layout.Column
+import androidx.compose.foundation.layout.Row
+import androidx.compose.foundation.layout.Spacer
+import androidx.compose.foundation.layout.padding
+import androidx.compose.foundation.layout.width
+import androidx.compose.foundation.shape.RoundedCornerShape
+import androidx.compose.material3.Text
+import androidx.compose.runtime.Composable
+import androidx.compose.runtime.collectAsState
+import androidx.compose.runtime.getValue
+import androidx.compose.ui.Modifier
+import androidx.compose.ui.graphics.Color
+import androidx.compose.ui.platform.LocalContext
+import androidx.compose.ui.text.font.FontFamily
+import androidx.compose.ui.unit.dp
+import androidx.compose.ui.unit.sp
+import com.bridgeone.app.usb.LatencyStage
+import com.bridgeone.app.usb.UsbSerialManager
+import java.io.File
+import java.io.IOException
+
+private const val TAG = "LatencyDebugOverlay"
+
+/**
+ * [DEV] 터치 → UART 지연 디버그 오버레이
+ *
+ * UsbSerialManager.latencyStats를 구독하여 구간별 p50/p95/p99(ms)와
+ * 샘플 합침/프레임 덮어쓰기 수를 표시합니다.
+ * - CSV: 앱 외부 파일 디렉터리에 latency_<시각>.csv 저장 (adb pull로 회수)
+ * - RESET: 측정 구간 초기화
+ */
+@Composable
+fun LatencyDebugOverlay(modifier: Modifier = Modifier) {
+    val context = LocalContext.current
+    val stats by UsbSerialManager.latencyStats.collectAsState()
+
+    Column(
+        modifier = modifier
+            .background(Color(0xB0000000), RoundedCornerShape(6.dp))
+            .padding(horizontal = 8.dp, vertical = 6.dp)
+    ) {
+        val lineStyle = Modifier.padding(vertical = 1.dp)
+        Text(
+            text = "stage          p50   p95   p99 (ms)",
+            color = Color(0xFFB0BEC5), fontSize = 10.sp, fontFamily = FontFamily.Monospace
+        )
+        LatencyStage.entries.forEach { stage ->
+            stats.stages[stage]?.let { p ->
+                Text(
+                    text = "%-13s %5.2f %5.2f %5.2f".format(
+                        stage.label, p.p50Us / 1000f, p.p95Us / 1000f, p.p99Us / 1000f
+                    ),
+                    modifier = lineStyle,
+                    color = Color.White, fontSize = 10.sp, fontFamily = FontFamily.Monospace
+                )
+            }
+        }
+        Text(
+            text = "frames ${stats.framesWritten}  merged ${stats.mergedSamples}  dropped ${stats.droppedFrames}",
+            modifier = lineStyle,
+            color = Color(0xFFFFCC80), fontSize = 10.sp, fontFamily = FontFamily.Monospace
+        )
+        Row(modifier = Modifier.padding(top = 4.dp)) {
+            Text(
+                text = "CSV",
+                modifier = Modifier.clickable {
+                    val dir = context.getExternalFilesDir(null) ?: context.filesDir
+                    val file = File(dir, "latency_${System.currentTimeMillis()}.csv")
+                    try {
+                        file.writeText(UsbSerialManager.exportLatencyCsv())
+                        ToastController.show("지연 통계 저장: ${file.name}", ToastType.SUCCESS)
+                    } catch (e: IOException) {
+                        Log.e(TAG, "Failed to export latency CSV: ${e.message}", e)
+                        ToastController.show("지연 통계 저장 실패", ToastType.ERROR)
+                    }
+                },
+                color = Color(0xFF80CBC4), fontSize = 11.sp
+            )
+            Spacer(modifier = Modifier.width(16.dp))
+            Text(
+                text = "RESET",
+                modifier = Modifier.clickable { UsbSerialManager.resetLatencyStats() },
+                color = Color(0xFFEF9A9A), fontSize = 11.sp
+            )
+        }
+    }
+}
@@ -39,7 +39,7 @@ private const val TAG = "ShortcutButton"
  * ShortcutButton 컴포넌트
  *
  * 키 조합(예: Ctrl+C)을 원터치로 실행하는 버튼.
- * - TAP 모드: 탭 시 Modifier↓ → Key↓ → Key↑ → Modifier↑ 순차 전송
+ * - TAP 모드: 탭 시 Modifier↓ → Key↓ → Key↑ → Modifier↑ (호출 측이 ESP32 매크로 트리거 또는 누름/뗌 프레임으로 전송)
  * - HOLD 모드: 누름 동안 키 유지, 뗌 시 해제 (Alt+Tab 등)
  * - 디바운스: 기본 150ms (Win+D는 500ms)
  * - 스케일 피드백: 누름 시 0.98, 뗌 시 1.0 (200ms)
@@ -16,7 +16,7 @@ import com.bridgeone.app.ui.common.*
  * 단축키 동작 모드
  */
 enum class ShortcutHoldBehavior {
-    /** 탭: Modifier↓ → Key↓ → Key↑ → Modifier↑ 즉시 전송 */
+    /** 탭: Modifier↓ → Key↓ → Key↑ → Modifier↑ (ESP32 매크로로 재생, 없으면 누름/뗌 프레임) */
     TAP,
     /** 홀드: 누름 동안 키 유지, 뗌 시 해제 (Alt+Tab 등) */
     HOLD
@@ -33,6 +33,9 @@ enum class ShortcutHoldBehavior {
  * @param holdBehavior 동작 모드 (TAP 또는 HOLD)
  * @param debounceDurationMs 디바운스 시간 (ms)
  * @param description 접근성 설명 (예: "복사")
+ * @param macroId ESP32 매크로 ID (TAP 단축키만). Windows 앱이 같은 ID로 탭 매크로를 업로드하며
+ *                (BridgeOne.Protocol ShortcutMacros.Defaults와 일치해야 함), 저장되어 있으면
+ *                트리거 프레임 1개로 재생합니다.
  */
 data class ShortcutDef(
     val label: String,
@@ -42,7 +45,8 @@ data class ShortcutDef(
     val displayChips: List<String> = emptyList(),
     val holdBehavior: ShortcutHoldBehavior = ShortcutHoldBehavior.TAP,
     val debounceDurationMs: Long = 150L,
-    val description: String = ""
+    val description: String = "",
+    val macroId: Int? = null
 ) {
     /** 수정자 비트플래그를 합산한 단일 바이트 */
     val combinedModifiers: UByte
@@ -60,42 +64,48 @@ val DEFAULT_SHORTCUTS = listOf(
         modifiers = listOf(MOD_BIT_LCTRL),
         key = KEY_C,
         icon = Icons.Filled.ContentCopy,
-        description = "복사"
+        description = "복사",
+        macroId = 0
     ),
     ShortcutDef(
         label = "Ctrl+V",
         modifiers = listOf(MOD_BIT_LCTRL),
         key = KEY_V,
         icon = Icons.Filled.ContentPaste,
-        description = "붙여넣기"
+        description = "붙여넣기",
+        macroId = 1
     ),
     ShortcutDef(
         label = "Ctrl+S",
         modifiers = listOf(MOD_BIT_LCTRL),
         key = KEY_S,
         icon = Icons.Filled.Save,
-        description = "저장"
+        description = "저장",
+        macroId = 2
     ),
     ShortcutDef(
         label = "Ctrl+Z",
         modifiers = listOf(MOD_BIT_LCTRL),
         key = KEY_Z,
         icon = Icons.AutoMirrored.Filled.Undo,
-        description = "실행 취소"
+        description = "실행 취소",
+        macroId = 3
     ),
     ShortcutDef(
         label = "Ctrl+Shift+Z",
         modifiers = listOf(MOD_BIT_LCTRL, MOD_BIT_LSHIFT),
         key = KEY_Z,
         icon = Icons.AutoMirrored.Filled.Redo,
-        description = "다시 실행"
+        description = "다시 실행",
+        macroId = 4
     ),
     ShortcutDef(
         label = "Ctrl+X",
         modifiers = listOf(MOD_BIT_LCTRL),
         key = KEY_X,
         icon = Icons.Filled.ContentCut,
-        description = "잘라내기"
+        description = "잘라내기",
+        macroId = 5
     ),
     ShortcutDef(
         label = "Alt+Tab",
@@ -111,6 +121,7 @@ val DEFAULT_SHORTCUTS = listOf(
         key = KEY_D,
         icon = Icons.Filled.DesktopWindows,
         debounceDurationMs = 500L,
-        description = "바탕화면 보기"
+        description = "바탕화면 보기",
+        macroId = 6
     )
 )
@@ -5,6 +5,7 @@ import android.os.Build
 import android.os.VibrationEffect
 import android.os.Vibrator
 import android.view.HapticFeedbackConstants
+import android.view.InputDevice
 import androidx.compose.animation.AnimatedVisibility
 import androidx.compose.animation.animateColorAsState
 import androidx.compose.animation.core.Animatable
@@ -25,6 +26,7 @@ import androidx.compose.foundation.layout.size
 import androidx.compose.foundation.shape.RoundedCornerShape
 import androidx.compose.material3.Text
 import androidx.compose.runtime.Composable
+import androidx.compose.runtime.DisposableEffect
 import androidx.compose.runtime.LaunchedEffect
 import androidx.compose.runtime.getValue
 import androidx.compose.runtime.mutableFloatStateOf
@@ -49,6 +51,10 @@ import androidx.compose.ui.Alignment
 import androidx.compose.ui.ExperimentalComposeUiApi
 import androidx.compose.ui.unit.dp
 import androidx.compose.ui.tooling.preview.Preview
+import com.bridgeone.app.input.CursorGestureConfig
+import com.bridgeone.app.input.CursorInputPipeline
+import com.bridgeone.app.input.MotionPredictor
+import com.bridgeone.app.protocol.BridgeFrame
 import com.bridgeone.app.protocol.BridgeMode
 import com.bridgeone.app.ui.common.EdgeSwipeConstants
 import com.bridgeone.app.ui.common.ScrollConstants.INFINITE_SCROLL_HAPTIC_MAX_VELOCITY_DP_MS
@@ -63,7 +69,6 @@ import com.bridgeone.app.ui.common.ScrollConstants.SCROLL_GUIDELINE_HIDE_DELAY_M
 import com.bridgeone.app.ui.common.ScrollConstants.SCROLL_GUIDELINE_STEP_DP
 import com.bridgeone.app.ui.common.ScrollConstants.SCROLL_STOP_THRESHOLD_MS
 import com.bridgeone.app.ui.common.ScrollConstants.SCROLL_UNIT_DISTANCE_DP
-import com.bridgeone.app.ui.common.DYNAMICS_PRESETS
 import com.bridgeone.app.ui.components.touchpad.ClickMode
 import com.bridgeone.app.ui.components.touchpad.ControlButtonConfig
 import com.bridgeone.app.ui.components.touchpad.CursorMode
@@ -86,6 +91,9 @@ import com.bridgeone.app.ui.utils.ClickDetector
 import com.bridgeone.app.ui.utils.DeltaCalculator
 import com.bridgeone.app.ui.utils.RightAngleAxis
 import com.bridgeone.app.ui.utils.getDistance
+import com.bridgeone.app.usb.LatencyStage
+import com.bridgeone.app.usb.UsbSerialManager
+import kotlinx.coroutines.CancellationException
 import kotlinx.coroutines.Job
 import kotlinx.coroutines.delay
 import kotlinx.coroutines.launch
@@ -162,8 +170,6 @@ fun TouchpadWrapper(
     val previousTouchPosition = remember { mutableStateOf(Offset.Zero) }
     val touchDownTime = remember { mutableStateOf(0L) }
     val touchDownPosition = remember { mutableStateOf(Offset.Zero) }
-    val compensatedDeltaX = remember { mutableStateOf(0f) }
-    val compensatedDeltaY = remember { mutableStateOf(0f) }
     val deadZoneEscaped = remember { mutableStateOf(false) }
 
     // ── 스크롤 모드 상태 (Phase 4.3.3) ──
@@ -225,6 +231,49 @@ fun TouchpadWrapper(
     // 선택된(또는 선택 중인) 팝업 모드 (null = 미선택)
     var selectedPopupMode by remember { mutableStateOf<EdgePopupMode?>(null) }
 
+    // 커서 입력 파이프라인: 커서 이동 샘플 처리/전송은 전용 입력 스레드에서 수행
+    // UI 스레드는 좌표만 넘기므로 리컴포지션 지연이 커서 이동을 지연/누락시키지 않음
+    val cursorPipeline = remember {
+        // 프레임은 전송 링 슬롯에 직접 기록 (샘플마다 BridgeFrame/ByteArray 할당 없음)
+        CursorInputPipeline(sink = { buttons, dx, dy, timing ->
+            UsbSerialManager.sendMouseFrame(
+                buttons.toUByte(), dx.toByte(), dy.toByte(),
+                sourceNanos = timing.sourceNanos,
+                processedNanos = timing.processedNanos,
+                sampleCount = timing.sampleCount
+            )
+        })
+    }
+    DisposableEffect(cursorPipeline) {
+        // 직각 이동 주축 확정 → 가이드라인/햅틱은 메인 스레드에서 처리
+        cursorPipeline.axisLockListener = CursorInputPipeline.AxisLockListener { axis ->
+            view.post {
+                rightAngleGuidelineAxis = axis
+                rightAngleGuidelineVisible = true
+                // 축 결정 순간 Light 햅틱 1회
+                view.performHapticFeedback(HapticFeedbackConstants.CLOCK_TICK)
+            }
+        }
+        // vsync 단위 배치 없이 터치 샘플을 도착 즉시 전달받음 (API 30+)
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.R) {
+            view.requestUnbufferedDispatch(InputDevice.SOURCE_TOUCHSCREEN)
+        }
+        cursorPipeline.start()
+        onDispose {
+            cursorPipeline.axisLockListener = null
+            cursorPipeline.stop()
+        }
+    }
+
+    // 포인터 다이나믹스 설정을 ESP32-S3에 전달 (가속은 펌웨어에서 적용)
+    // scale = dp 1당 전송 델타 카운트 → 펌웨어가 Android와 같은 dp/ms 속도로 곡선을 조회
+    LaunchedEffect(touchpadState.dynamicsPresetIndex, touchpadState.effectiveDpiMultiplier, density.density) {
+        UsbSerialManager.setPointerDynamics(
+            presetIndex = touchpadState.dynamicsPresetIndex,
+            countsPerDp = density.density * touchpadState.effectiveDpiMultiplier
+        )
+    }
+
     // 프리셋 탭 라벨 표시 상태 (Phase 4.3.8)
     var showPresetLabel by remember { mutableStateOf(false) }
     var isFirstPresetRender by remember { mutableStateOf(true) }
@@ -360,9 +409,23 @@ fun TouchpadWrapper(
                     previousTouchPosition.value = currentTouchPosition.value
                     touchDownTime.value = System.currentTimeMillis()
                     touchDownPosition.value = currentTouchPosition.value
-                    compensatedDeltaX.value = 0f
-                    compensatedDeltaY.value = 0f
                     deadZoneEscaped.value = false
+                    cursorPipeline.beginGesture(
+                        currentTouchPosition.value.x,
+                        currentTouchPosition.value.y,
+                        CursorGestureConfig(
+                            deadZonePx = deadZoneThresholdPx,
+                            rightAngle = latestState.moveMode == MoveMode.RIGHT_ANGLE,
+                            rightAngleLockDistPx = rightAngleLockDistPx,
+                            rightAngleDeadbandDeg = RIGHT_ANGLE_DEADBAND_DEG,
+                            dpiMultiplier = latestState.effectiveDpiMultiplier,
+                            predictionHorizonMs = if (latestState.motionPrediction) {
+                                MotionPredictor.horizonForLatency(
+                                    UsbSerialManager.latencyStats.value.stages[LatencyStage.TOUCH_TO_WIRE]?.p50Us ?: 0L
+                                )
+                            } else 0f
+                        )
+                    )
 
                     // ── 팝업 열린 상태: 상대 이동으로 버튼 선택, 탭으로 토글/확정 ──
                     // DOWN 지점이 기준(0,0). 손가락이 navStepPx 이동할 때마다 선택이 1칸 이동.
@@ -555,17 +618,10 @@ fun TouchpadWrapper(
                     // 각 샘플: Pair(이동량 dp, 타임스탬프 ms)
                     val velocitySamples = ArrayDeque<Pair<Float, Long>>()
 
-                    // 직각 이동 모드 전용 로컬 상태 (Phase 4.3.5)
-                    var rightAngleAxis = RightAngleAxis.UNDECIDED
-                    var rightAngleAccumX = 0f
-                    var rightAngleAccumY = 0f
+                    // 직각 이동 모드: 주축 판정은 입력 파이프라인이 수행 (Phase 4.3.5)
                     // 새 제스처 시작 시 가이드라인 초기화
                     rightAngleGuidelineVisible = false
 
-                    // 커서 이동 속도 샘플 (Phase 4.3.8 다이나믹스용)
-                    // 각 샘플: Pair(이동량 dp, 타임스탬프 ms)
-                    val cursorVelocitySamples = ArrayDeque<Pair<Float, Long>>()
-
                     onTouchEvent(PointerEventType.Press, currentTouchPosition.value, previousTouchPosition.value)
 
                     // ── MOVE ──
@@ -578,9 +634,14 @@ fun TouchpadWrapper(
                         }
                         moveEvent.changes.forEach { it.consume() }
                         val change = moveEvent.changes.first()
-                        val allPositions = change.historical.map { it.position } + change.position
+                        val historical = change.historical
+
+                        for (sampleIndex in 0..historical.size) {
+                            val isHistorical = sampleIndex < historical.size
+                            val pos = if (isHistorical) historical[sampleIndex].position else change.position
+                            // MotionEvent.eventTime (uptimeMillis) → System.nanoTime() 기준 (같은 단조 시계)
+                            val sampleTimeNanos = (if (isHistorical) historical[sampleIndex].uptimeMillis else change.uptimeMillis) * 1_000_000L
 
-                        for (pos in allPositions) {
                             previousTouchPosition.value = currentTouchPosition.value
                             currentTouchPosition.value = pos
 
@@ -735,35 +796,39 @@ fun TouchpadWrapper(
 
                                     // 스크롤 단위 누적 (소수점 보존으로 단위 손실 방지)
                                     scrollAccum += axisDelta
+                                    val horizontal = scrollAxis == ScrollAxis.HORIZONTAL
 
-                                    while (abs(scrollAccum) >= effectiveUnitPx) {
-                                        val direction = if (scrollAccum > 0) 1 else -1
-                                        scrollAccum -= direction * effectiveUnitPx
-
-                                        // 스크롤 프레임 전송
-                                        val wheelDelta = (-direction).toByte()
-                                        val frame = when (scrollAxis) {
-                                            ScrollAxis.VERTICAL ->
-                                                ClickDetector.createWheelFrame(wheelDelta)
-                                            ScrollAxis.HORIZONTAL ->
-                                                ClickDetector.createHorizontalWheelFrame(wheelDelta)
-                                            ScrollAxis.UNDECIDED -> continue
+                                    if (latestState.scrollMode == ScrollMode.INFINITE_SCROLL) {
+                                        // 무한 스크롤: 디텐트 미만 이동도 고해상도 단위로 바로 전송 (관성과 같은 환산,
+                                        // 스크롤 단위 1개 = 1디텐트). 펌웨어가 Resolution Multiplier 미사용 호스트면 디텐트로 누산
+                                        val unitPx = effectiveUnitPx / BridgeFrame.WHEEL_UNITS_PER_DETENT
+                                        while (abs(scrollAccum) >= unitPx) {
+                                            val units = (scrollAccum / unitPx).toInt().coerceIn(-127, 127)
+                                            scrollAccum -= units * unitPx
+                                            ClickDetector.sendFrame(
+                                                ClickDetector.createHiResWheelFrame((-units).toByte(), horizontal)
+                                            )
                                         }
-                                        ClickDetector.sendFrame(frame)
-
-                                        // 가이드라인 재표시 및 타이머 리셋
                                         guidelineVisible = true
-                                        // 일반 스크롤: 단위별 스텝 이동 (무한 스크롤은 아래에서 연속 추적)
-                                        if (latestState.scrollMode == ScrollMode.NORMAL_SCROLL) {
+                                        scheduleGuidelineHide()
+                                    } else {
+                                        // 일반 스크롤: 스크롤 단위 1개 = 1디텐트 (고해상도 WHEEL_UNITS_PER_DETENT 단위)
+                                        while (abs(scrollAccum) >= effectiveUnitPx) {
+                                            val direction = if (scrollAccum > 0) 1 else -1
+                                            scrollAccum -= direction * effectiveUnitPx
+
+                                            val units = (-direction * BridgeFrame.WHEEL_UNITS_PER_DETENT).toByte()
+                                            ClickDetector.sendFrame(ClickDetector.createHiResWheelFrame(units, horizontal))
+
+                                            // 가이드라인 단위별 스텝 이동 + 타이머 리셋
+                                            guidelineVisible = true
                                             guidelineTarget += direction * SCROLL_GUIDELINE_STEP_DP
-                                        }
 
-                                        // 햅틱 피드백 (일반 스크롤: 단위별 틱)
-                                        if (latestState.scrollMode == ScrollMode.NORMAL_SCROLL) {
+                                            // 햅틱 피드백 (단위별 틱)
                                             view.performHapticFeedback(HapticFeedbackConstants.CLOCK_TICK)
-                                        }
 
-                                        scheduleGuidelineHide()
+                                            scheduleGuidelineHide()
+                                        }
                                     }
 
                                     // 무한 스크롤 전용: 가이드라인 연속 추적 + 속도 샘플 수집
@@ -785,102 +850,21 @@ fun TouchpadWrapper(
                                 }
 
                             } else {
-                                // ── 커서 이동 모드 (기존 로직) ──
+                                // ── 커서 이동 모드 ──
+                                // 데드존 판정은 클릭 판정용으로만 유지, 이동량 처리는 입력 스레드에서 수행
                                 if (!deadZoneEscaped.value) {
                                     val dist = (currentTouchPosition.value - touchDownPosition.value).getDistance()
                                     if (dist >= deadZoneThresholdPx) {
                                         deadZoneEscaped.value = true
                                     }
                                 }
-
-                                val finalDelta = if (deadZoneEscaped.value) {
-                                    DeltaCalculator.normalizeOnly(rawDelta)
-                                } else {
-                                    Offset.Zero
-                                }
-
-                                // ── 직각 이동 모드 축 잠금 (Phase 4.3.5) ──
-                                val axisLockedDelta = if (latestState.moveMode == MoveMode.RIGHT_ANGLE &&
-                                    deadZoneEscaped.value
-                                ) {
-                                    if (rightAngleAxis == RightAngleAxis.UNDECIDED) {
-                                        // 축 판정용 누적 (rawDelta: px 단위)
-                                        rightAngleAccumX += rawDelta.x
-                                        rightAngleAccumY += rawDelta.y
-                                        val determined = DeltaCalculator.determineRightAngleAxis(
-                                            accumX = rightAngleAccumX,
-                                            accumY = rightAngleAccumY,
-                                            lockDistPx = rightAngleLockDistPx,
-                                            deadbandDeg = RIGHT_ANGLE_DEADBAND_DEG
-                                        )
-                                        if (determined != RightAngleAxis.UNDECIDED) {
-                                            rightAngleAxis = determined
-                                            rightAngleGuidelineAxis = determined
-                                            rightAngleGuidelineVisible = true
-                                            // 축 결정 순간 Light 햅틱 1회
-                                            view.performHapticFeedback(HapticFeedbackConstants.CLOCK_TICK)
-                                        }
-                                        // 아직 미결정: 주축 확정 전까지 커서 이동 차단
-                                        Offset.Zero
-                                    } else {
-                                        // 주축 확정 후: 반대 축 이동량 = 0
-                                        DeltaCalculator.applyRightAngleLock(finalDelta, rightAngleAxis)
-                                    }
-                                } else {
-                                    finalDelta
-                                }
-
-                                // ── 커서 속도 샘플 수집 (Phase 4.3.8 다이나믹스용) ──
-                                val now = System.currentTimeMillis()
-                                val distDp = rawDelta.getDistance() / density.density
-                                cursorVelocitySamples.addLast(Pair(distDp, now))
-                                val cutoff = now - INFINITE_SCROLL_VELOCITY_WINDOW_MS
-                                while (cursorVelocitySamples.isNotEmpty() &&
-                                    cursorVelocitySamples.first().second < cutoff
-                                ) {
-                                    cursorVelocitySamples.removeFirst()
-                                }
-                                val velocityDpMs = if (cursorVelocitySamples.size >= 2) {
-                                    val oldest = cursorVelocitySamples.first()
-                                    val newest = cursorVelocitySamples.last()
-                                    val totalDp = cursorVelocitySamples.sumOf { it.first.toDouble() }.toFloat()
-                                    val timeSpanMs = (newest.second - oldest.second).toFloat()
-                                    if (timeSpanMs > 0f) totalDp / timeSpanMs else 0f
-                                } else 0f
-
-                                // ── DPI 곱수 적용 (Phase 4.3.6) ──
-                                val dpiMultiplierMove = latestState.effectiveDpiMultiplier
-                                val dpiDeltaRaw = Offset(
-                                    axisLockedDelta.x * dpiMultiplierMove,
-                                    axisLockedDelta.y * dpiMultiplierMove
+                                cursorPipeline.submitSample(
+                                    previousTouchPosition.value.x,
+                                    previousTouchPosition.value.y,
+                                    currentTouchPosition.value.x,
+                                    currentTouchPosition.value.y,
+                                    sampleTimeNanos
                                 )
-
-                                // ── 포인터 다이나믹스 배율 적용 (Phase 4.3.8) ──
-                                val dynamicsPreset = DYNAMICS_PRESETS.getOrNull(latestState.dynamicsPresetIndex)
-                                    ?: DYNAMICS_PRESETS.first()
-                                val dpiDelta = if (dynamicsPreset.algorithm != com.bridgeone.app.ui.components.touchpad.DynamicsAlgorithm.NONE) {
-                                    Offset(
-                                        DeltaCalculator.applyPointerDynamics(dpiDeltaRaw.x, velocityDpMs, dynamicsPreset).coerceIn(-127f, 127f),
-                                        DeltaCalculator.applyPointerDynamics(dpiDeltaRaw.y, velocityDpMs, dynamicsPreset).coerceIn(-127f, 127f)
-                                    )
-                                } else {
-                                    Offset(
-                                        dpiDeltaRaw.x.coerceIn(-127f, 127f),
-                                        dpiDeltaRaw.y.coerceIn(-127f, 127f)
-                                    )
-                                }
-
-                                compensatedDeltaX.value = dpiDelta.x
-                                compensatedDeltaY.value = dpiDelta.y
-
-                                if (dpiDelta.x != 0f || dpiDelta.y != 0f) {
-                                    val dragFrame = ClickDetector.createFrame(
-                                        buttonState = 0x00u,
-                                        deltaX = dpiDelta.x,
-                                        deltaY = dpiDelta.y
-                                    )
-                                    ClickDetector.sendFrame(dragFrame)
-                                }
                             }
                         }
 
@@ -972,50 +956,47 @@ fun TouchpadWrapper(
 
                                     inertiaJob = coroutineScope.launch {
                                         var velocity = initialVelocity
-                                        var inertiaScrollAccum = 0f
                                         var lastTimestamp = System.currentTimeMillis()
                                         val effectiveUnitDp = capturedScrollUnitDp / capturedSensitivity
 
-                                        while (abs(velocity) > INFINITE_SCROLL_MIN_VELOCITY_DP_MS) {
-                                            delay(16L)  // ~60fps
+                                        // 휠 리포트는 ESP32-S3가 1ms 주기로 생성 (초기 속도 프레임 1개만 전송)
+                                        // 단위 변환: dp/ms → 고해상도 휠 단위/ms (스크롤 단위 1개 = 1디텐트, 손가락과 반대 방향)
+                                        val unitsPerDp = BridgeFrame.WHEEL_UNITS_PER_DETENT / effectiveUnitDp
+                                        UsbSerialManager.sendScrollFling(
+                                            horizontal = capturedAxis == ScrollAxis.HORIZONTAL,
+                                            unitsPerMs = -initialVelocity * unitsPerDp,
+                                            timeConstantMs = INFINITE_SCROLL_TIME_CONSTANT_MS,
+                                            stopUnitsPerMs = INFINITE_SCROLL_MIN_VELOCITY_DP_MS * unitsPerDp
+                                        )
 
-                                            val now = System.currentTimeMillis()
-                                            val dt = (now - lastTimestamp).toFloat()
-                                            lastTimestamp = now
+                                        try {
+                                            // 햅틱/가이드라인만 같은 감쇠 곡선으로 로컬 재현
+                                            while (abs(velocity) > INFINITE_SCROLL_MIN_VELOCITY_DP_MS) {
+                                                delay(16L)  // ~60fps
 
-                                            // 지수 감쇠: v(t) = v0 * e^(-dt/τ)
-                                            velocity *= exp(-dt / INFINITE_SCROLL_TIME_CONSTANT_MS)
+                                                val now = System.currentTimeMillis()
+                                                val dt = (now - lastTimestamp).toFloat()
+                                                lastTimestamp = now
 
-                                            // 속도 비례 연속 진동 (매 프레임)
-                                            if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.O) {
-                                                val amplitude = (abs(velocity) / INFINITE_SCROLL_HAPTIC_MAX_VELOCITY_DP_MS * 255)
-                                                    .toInt().coerceIn(1, 255)
-                                                vibrator.vibrate(VibrationEffect.createOneShot(20, amplitude))
-                                            }
+                                                // 지수 감쇠: v(t) = v0 * e^(-dt/τ)
+                                                velocity *= exp(-dt / INFINITE_SCROLL_TIME_CONSTANT_MS)
 
-                                            // 이동량 누적 (dp 단위, velocity * dt = dp)
-                                            val moveDp = velocity * dt
-                                            inertiaScrollAccum += moveDp
-                                            // 가이드라인 연속 추적
-                                            guidelineTarget += moveDp
-
-                                            while (abs(inertiaScrollAccum) >= effectiveUnitDp) {
-                                                val dir = if (inertiaScrollAccum > 0) 1 else -1
-                                                inertiaScrollAccum -= dir * effectiveUnitDp
-
-                                                val wheelDelta = (-dir).toByte()
-                                                val frame = when (capturedAxis) {
-                                                    ScrollAxis.VERTICAL ->
-                                                        ClickDetector.createWheelFrame(wheelDelta)
-                                                    ScrollAxis.HORIZONTAL ->
-                                                        ClickDetector.createHorizontalWheelFrame(wheelDelta)
-                                                    ScrollAxis.UNDECIDED -> break
+                                                // 속도 비례 연속 진동 (매 프레임)
+                                                if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.O) {
+                                                    val amplitude = (abs(velocity) / INFINITE_SCROLL_HAPTIC_MAX_VELOCITY_DP_MS * 255)
+                                                        .toInt().coerceIn(1, 255)
+                                                    vibrator.vibrate(VibrationEffect.createOneShot(20, amplitude))
                                                 }
-                                                ClickDetector.sendFrame(frame)
 
+                                                // 가이드라인 연속 추적 (dp 단위, velocity * dt = dp)
+                                                guidelineTarget += velocity * dt
                                                 guidelineVisible = true
                                                 scheduleGuidelineHide()
                                             }
+                                        } catch (e: CancellationException) {
+                                            // 탭/새 제스처로 관성 중단 → 펌웨어 관성도 정지
+                                            UsbSerialManager.stopScrollFling()
+                                            throw e
                                         }
 
                                         // 관성 종료: 숨김 스케줄
@@ -1024,57 +1005,15 @@ fun TouchpadWrapper(
                                 }
                             }
                         } else {
-                            // 커서 이동 모드: 기존 클릭/드래그 로직
-                            val releaseDelta = DeltaCalculator.calculateDelta(
-                                previousTouchPosition.value,
-                                currentTouchPosition.value
-                            )
-                            val releaseFinalDelta = if (deadZoneEscaped.value) {
-                                DeltaCalculator.normalizeOnly(releaseDelta)
-                            } else {
-                                Offset.Zero
-                            }
-
-                            // 직각 이동 모드 축 잠금 적용 (Phase 4.3.5)
-                            val releaseAxisLockedDelta = if (latestState.moveMode == MoveMode.RIGHT_ANGLE &&
-                                rightAngleAxis != RightAngleAxis.UNDECIDED
-                            ) {
-                                DeltaCalculator.applyRightAngleLock(releaseFinalDelta, rightAngleAxis)
-                            } else {
-                                releaseFinalDelta
-                            }
-
-                            // ── DPI 곱수 적용 (Phase 4.3.6) ──
-                            val dpiMultiplierRelease = latestState.effectiveDpiMultiplier
-                            val releaseDpiDeltaRaw = Offset(
-                                releaseAxisLockedDelta.x * dpiMultiplierRelease,
-                                releaseAxisLockedDelta.y * dpiMultiplierRelease
+                            // 커서 이동 모드: 릴리즈 지점 이동량은 클릭 프레임에 포함되어 전송
+                            cursorPipeline.submitSample(
+                                previousTouchPosition.value.x,
+                                previousTouchPosition.value.y,
+                                currentTouchPosition.value.x,
+                                currentTouchPosition.value.y,
+                                moveEvent.changes.first().uptimeMillis * 1_000_000L
                             )
 
-                            // ── 포인터 다이나믹스 배율 적용 (Phase 4.3.8) ──
-                            val releaseVelocityDpMs = if (cursorVelocitySamples.size >= 2) {
-                                val oldest = cursorVelocitySamples.first()
-                                val newest = cursorVelocitySamples.last()
-                                val totalDp = cursorVelocitySamples.sumOf { it.first.toDouble() }.toFloat()
-                                val timeSpanMs = (newest.second - oldest.second).toFloat()
-                                if (timeSpanMs > 0f) totalDp / timeSpanMs else 0f
-                            } else 0f
-                            val releaseDynamicsPreset = DYNAMICS_PRESETS.getOrNull(latestState.dynamicsPresetIndex)
-                                ?: DYNAMICS_PRESETS.first()
-                            val releaseDpiDelta = if (releaseDynamicsPreset.algorithm != com.bridgeone.app.ui.components.touchpad.DynamicsAlgorithm.NONE) {
-                                Offset(
-                                    DeltaCalculator.applyPointerDynamics(releaseDpiDeltaRaw.x, releaseVelocityDpMs, releaseDynamicsPreset).coerceIn(-127f, 127f),
-                                    DeltaCalculator.applyPointerDynamics(releaseDpiDeltaRaw.y, releaseVelocityDpMs, releaseDynamicsPreset).coerceIn(-127f, 127f)
-                                )
-                            } else {
-                                Offset(
-                                    releaseDpiDeltaRaw.x.coerceIn(-127f, 127f),
-                                    releaseDpiDeltaRaw.y.coerceIn(-127f, 127f)
-                                )
-                            }
-                            compensatedDeltaX.value = releaseDpiDelta.x
-                            compensatedDeltaY.value = releaseDpiDelta.y
-
                             val buttonState = if (deadZoneEscaped.value) {
                                 0x00u.toUByte()
                             } else {
@@ -1095,24 +1034,15 @@ fun TouchpadWrapper(
                                 }
                             }
 
-                            val frame = ClickDetector.createFrame(
-                                buttonState = buttonState,
-                                deltaX = compensatedDeltaX.value,
-                                deltaY = compensatedDeltaY.value
-                            )
-                            ClickDetector.sendFrame(frame)
+                            // 같은 입력 스레드 큐를 거쳐 앞선 이동 프레임 뒤에 순서대로 전송
+                            cursorPipeline.submitButtons(buttonState.toInt())
 
                             if (buttonState != 0x00u.toUByte()) {
                                 // press→release 간 지연: OS가 버튼 다운/업을 별도 이벤트로 처리하도록
                                 // (지연 없으면 우클릭 메뉴가 토글처럼 동작하는 문제 발생)
                                 coroutineScope.launch {
                                     delay(30L)
-                                    val releaseFrame = ClickDetector.createFrame(
-                                        buttonState = 0x00u.toUByte(),
-                                        deltaX = 0f,
-                                        deltaY = 0f
-                                    )
-                                    ClickDetector.sendFrame(releaseFrame)
+                                    cursorPipeline.submitButtons(0x00)
                                 }
                             }
                         }
@@ -1130,8 +1060,6 @@ fun TouchpadWrapper(
                         // 공통 상태 초기화
                         touchDownTime.value = 0L
                         touchDownPosition.value = Offset.Zero
-                        compensatedDeltaX.value = 0f
-                        compensatedDeltaY.value = 0f
                         deadZoneEscaped.value = false
 
                         onTouchEvent(PointerEventType.Release, currentTouchPosition.value, previousTouchPosition.value)
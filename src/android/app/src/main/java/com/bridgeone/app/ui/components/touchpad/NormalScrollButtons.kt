@@ -7,6 +7,7 @@ import androidx.compose.foundation.layout.Box
 import androidx.compose.foundation.layout.Column
 import androidx.compose.foundation.layout.size
 import androidx.compose.foundation.shape.RoundedCornerShape
+import com.bridgeone.app.protocol.BridgeFrame
 import com.bridgeone.app.ui.common.AppIconDef
 import com.bridgeone.app.ui.common.AppIcon
 import com.bridgeone.app.ui.common.AppIcons
@@ -37,7 +38,7 @@ private val ScrollButtonIconColor = Color(0xFF1E1E1E)
  *
  * NORMAL_SCROLL 모드에서 터치패드 왼쪽 하단에 오버레이됩니다.
  * 버튼을 누르고 있으면 [NORMAL_SCROLL_BUTTON_INTERVAL_MS] 간격으로
- * 스크롤 프레임을 연속 전송합니다.
+ * 1디텐트(고해상도 [BridgeFrame.WHEEL_UNITS_PER_DETENT] 단위) 스크롤 프레임을 연속 전송합니다.
  *
  * - 위 버튼: 홀드 → 위로 스크롤 (wheelDelta = +1)
  * - 아래 버튼: 홀드 → 아래로 스크롤 (wheelDelta = -1)
@@ -91,12 +92,13 @@ private fun ScrollHoldButton(
                     isPressed = true
                     scrollJob?.cancel()
                     scrollJob = coroutineScope.launch {
+                        val units = (wheelDelta * BridgeFrame.WHEEL_UNITS_PER_DETENT).toByte()
                         // 첫 스크롤 즉시 전송
-                        ClickDetector.sendFrame(ClickDetector.createWheelFrame(wheelDelta))
+                        ClickDetector.sendFrame(ClickDetector.createHiResWheelFrame(units))
                         // 이후 일정 간격으로 반복
                         while (true) {
                             delay(NORMAL_SCROLL_BUTTON_INTERVAL_MS)
-                            ClickDetector.sendFrame(ClickDetector.createWheelFrame(wheelDelta))
+                            ClickDetector.sendFrame(ClickDetector.createHiResWheelFrame(units))
                         }
                     }
 
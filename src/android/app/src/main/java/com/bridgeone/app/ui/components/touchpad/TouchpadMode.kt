@@ -181,7 +181,9 @@ data class TouchpadState(
     /** 현재 포인터 다이나믹스 프리셋 인덱스 (DYNAMICS_PRESETS 기준). 기본값: 0 = Off */
     val dynamicsPresetIndex: Int = 0,
     /** 현재 모드 프리셋 인덱스 (MODE_PRESETS 기준). 기본값: 0 = Standard */
-    val modePresetIndex: Int = 0
+    val modePresetIndex: Int = 0,
+    /** 커서 이동 예측(지연 보상) 사용 여부. 측정된 터치 → UART 지연만큼 외삽 (MotionPredictor) */
+    val motionPrediction: Boolean = false
 ) {
     /** 실제 적용되는 DPI 배율 (커스텀 우선, 없으면 레벨 배율) */
     val effectiveDpiMultiplier: Float
@@ -73,6 +73,7 @@ import com.bridgeone.app.ui.components.touchpad.ModePresetPopup
 import com.bridgeone.app.ui.components.touchpad.ScrollMode
 import com.bridgeone.app.ui.components.touchpad.TouchpadState
 import com.bridgeone.app.ui.utils.ClickDetector
+import com.bridgeone.app.usb.UsbSerialManager
 import kotlin.math.abs
 
 // ============================================================
@@ -95,13 +96,23 @@ fun StandardModePage() {
     val context = LocalContext.current
 
     // Phase 4.3.3: 터치패드 상태를 페이지 레벨로 호이스팅
-    // DpiLevel은 SharedPreferences에서 복원 (Phase 4.3.6)
-    var touchpadState by remember { mutableStateOf(TouchpadState(dpiLevel = loadDpiLevel(context))) }
+    // DpiLevel/이동 예측 설정은 SharedPreferences에서 복원 (Phase 4.3.6)
+    var touchpadState by remember {
+        mutableStateOf(
+            TouchpadState(
+                dpiLevel = loadDpiLevel(context),
+                motionPrediction = loadMotionPrediction(context)
+            )
+        )
+    }
 
     // DPI 레벨(사전 정의 값)이 변경될 때 SharedPreferences에 저장
     LaunchedEffect(touchpadState.dpiLevel) {
         saveDpiLevel(context, touchpadState.dpiLevel)
     }
+    LaunchedEffect(touchpadState.motionPrediction) {
+        saveMotionPrediction(context, touchpadState.motionPrediction)
+    }
 
     // Phase 4.3.6: DPI 세밀 조절 팝업 상태
     var dpiAdjustPopupVisible by remember { mutableStateOf(false) }
@@ -581,8 +592,10 @@ private fun SpecialKeysGrid() {
  * Shortcuts 2열 그리드
  *
  * 8개 단축키: Ctrl+C, Ctrl+V, Ctrl+S, Ctrl+Z, Ctrl+Shift+Z, Ctrl+X, Alt+Tab, Win+D
- * - TAP 모드: 탭 → Modifier↓ → Key↓ → Key↑ → Modifier↑ 순차 전송
- * - HOLD 모드: Alt+Tab — 누름 동안 유지, 뗌 시 해제
+ * - TAP 모드: ESP32에 해당 매크로(ShortcutDef.macroId)가 저장되어 있으면 트리거 프레임 1개 전송
+ *   → Modifier↓ → Key↓ → Key↑ → Modifier↑ 타이밍은 ESP32 매크로 엔진이 보장.
+ *   아직 업로드되지 않았으면(Windows 앱 미실행 등) 누름/뗌 프레임으로 대신 전송
+ * - HOLD 모드: Alt+Tab — 누름 동안 유지, 뗌 시 해제 (손가락 시간에 따르므로 매크로 미사용)
  * - 150ms 디바운스 (Win+D는 500ms)
  *
  */
@@ -598,9 +611,18 @@ private fun ShortcutsGrid() {
                 horizontalArrangement = Arrangement.spacedBy(6.dp)
             ) {
                 rowShortcuts.forEach { shortcutDef ->
+                    // 이번 누름을 매크로로 보냈는지 (매크로가 키를 떼므로 뗌 프레임 생략)
+                    var sentAsMacro by remember { mutableStateOf(false) }
                     ShortcutButton(
                         shortcutDef = shortcutDef,
                         onShortcutTriggered = { mod, key ->
+                            val macroId = shortcutDef.macroId
+                            if (macroId != null && UsbSerialManager.isMacroStored(macroId)) {
+                                sentAsMacro = true
+                                UsbSerialManager.sendMacroTrigger(macroId)
+                                return@ShortcutButton
+                            }
+                            sentAsMacro = false
                             val frame = ClickDetector.createKeyboardFrame(
                                 activeModifierKeys = if (mod != 0u.toUByte()) setOf(mod) else emptySet(),
                                 keyCode1 = key
@@ -608,6 +630,10 @@ private fun ShortcutsGrid() {
                             ClickDetector.sendFrame(frame)
                         },
                         onShortcutReleased = { _, _ ->
+                            if (sentAsMacro) {
+                                sentAsMacro = false
+                                return@ShortcutButton
+                            }
                             val frame = ClickDetector.createKeyboardFrame(
                                 activeModifierKeys = emptySet(),
                                 keyCode1 = 0u
@@ -789,11 +815,12 @@ private fun Page4MinecraftPlaceholder() {
 }
 
 // ============================================================
-// DPI 레벨 SharedPreferences 저장/복원 (Phase 4.3.6)
+// DPI 레벨 / 이동 예측 SharedPreferences 저장/복원 (Phase 4.3.6)
 // ============================================================
 
 private const val PREF_NAME = "touchpad_prefs"
 private const val KEY_DPI_LEVEL = "dpi_level"
+private const val KEY_MOTION_PREDICTION = "motion_prediction"
 
 private fun loadDpiLevel(context: Context): DpiLevel {
     val name = context.getSharedPreferences(PREF_NAME, Context.MODE_PRIVATE)
@@ -807,3 +834,14 @@ private fun saveDpiLevel(context: Context, level: DpiLevel) {
         .putString(KEY_DPI_LEVEL, level.name)
         .apply()
 }
+
+private fun loadMotionPrediction(context: Context): Boolean =
+    context.getSharedPreferences(PREF_NAME, Context.MODE_PRIVATE)
+        .getBoolean(KEY_MOTION_PREDICTION, false)
+
+private fun saveMotionPrediction(context: Context, enabled: Boolean) {
+    context.getSharedPreferences(PREF_NAME, Context.MODE_PRIVATE)
+        .edit()
+        .putBoolean(KEY_MOTION_PREDICTION, enabled)
+        .apply()
+}
@@ -345,7 +345,7 @@ object ClickDetector {
      */
     fun createHorizontalWheelFrame(wheelDelta: Byte): BridgeFrame {
         return FrameBuilder.buildFrame(
-            buttons = 0x08u,   // bit3: 수평 스크롤 인디케이터
+            buttons = BridgeFrame.BUTTON_FLAG_HORIZONTAL_WHEEL,   // bit3: 수평 스크롤 인디케이터
             deltaX = 0,
             deltaY = 0,
             wheel = wheelDelta,
@@ -355,6 +355,36 @@ object ClickDetector {
         )
     }
 
+    /**
+     * 고해상도 휠 스크롤 프레임을 생성합니다.
+     *
+     * 프로토콜 인코딩:
+     * - buttons bit4 (0x10): wheel 값이 1/[BridgeFrame.WHEEL_UNITS_PER_DETENT] 디텐트 단위
+     * - buttons bit3 (0x08): 수평 스크롤 (horizontal = true)
+     *
+     * ESP32는 호스트가 Resolution Multiplier를 켠 경우 그대로, 아니면 디텐트로 누산해 전송합니다.
+     *
+     * @param units 스크롤 이동량 (고해상도 단위, -127 ~ 127, 양수=위/오른쪽)
+     * @param horizontal true=수평 휠, false=수직 휠
+     * @return BridgeFrame 객체
+     */
+    fun createHiResWheelFrame(units: Byte, horizontal: Boolean = false): BridgeFrame {
+        val flags = if (horizontal) {
+            BridgeFrame.BUTTON_FLAG_HIRES_WHEEL or BridgeFrame.BUTTON_FLAG_HORIZONTAL_WHEEL
+        } else {
+            BridgeFrame.BUTTON_FLAG_HIRES_WHEEL
+        }
+        return FrameBuilder.buildFrame(
+            buttons = flags,
+            deltaX = 0,
+            deltaY = 0,
+            wheel = units,
+            modifiers = 0u,
+            keyCode1 = 0u,
+            keyCode2 = 0u
+        )
+    }
+
     /**
      * 우클릭 프레임을 생성합니다 (Standard 모드 전용 버튼).
      *
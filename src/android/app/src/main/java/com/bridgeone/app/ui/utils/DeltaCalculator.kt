@@ -269,8 +269,10 @@ object DeltaCalculator {
     /**
      * 포인터 다이나믹스(커서 가속) 배율을 단일 축 델타에 적용합니다. (Phase 4.3.8)
      *
-     * DPI 배율 적용 이후에 호출합니다.
-     * 최종 파이프라인: rawDelta × dpiMultiplier → applyPointerDynamics → coerceIn(-127f, 127f)
+     * 가속은 ESP32-S3 펌웨어(pointer_dynamics.c)가 Q16 룩업 테이블로 수행하며,
+     * Android는 raw 델타와 프리셋 ID만 전송합니다 (UsbSerialManager.setPointerDynamics).
+     * 이 함수는 펌웨어 테이블이 생성된 기준 곡선이며, PointerDynamicsTableTest가
+     * 두 구현의 일치를 검증합니다. 프리셋 곡선을 바꾸면 펌웨어 테이블도 다시 생성해야 합니다.
      *
      * @param rawDelta      DPI 배율이 이미 적용된 단일 축 델타 (px)
      * @param velocityDpMs  현재 손가락 이동 속도 (dp/ms, 절댓값 0 이상)
@@ -0,0 +1,224 @@
+package com.bridgeone.app.usb
+
+/**
+ * 터치 → UART 전송 지연 측정 구간
+ *
+ * 모든 타임스탬프는 System.nanoTime() 기준입니다.
+ * Android에서 MotionEvent.eventTime(uptimeMillis)과 System.nanoTime()은 같은
+ * CLOCK_MONOTONIC을 사용하므로 eventTime × 10⁶을 그대로 비교할 수 있습니다.
+ *
+ * @property label CSV/오버레이 표시 이름
+ */
+enum class LatencyStage(val label: String) {
+    /** MotionEvent.eventTime → 입력 스레드의 DeltaCalculator 처리 */
+    TOUCH_TO_DELTA("touch→delta"),
+
+    /** DeltaCalculator 처리 → 전송 링(frameQueue) 기록 (1ms 페이싱 대기 포함) */
+    DELTA_TO_ENQUEUE("delta→enqueue"),
+
+    /** 전송 링 기록 → port.write() 반환 */
+    ENQUEUE_TO_WRITE("enqueue→write"),
+
+    /** MotionEvent.eventTime → port.write() 반환 (전체) */
+    TOUCH_TO_WIRE("touch→wire")
+}
+
+/**
+ * 구간 하나의 백분위 지연 (µs, 버킷 상한값)
+ */
+data class LatencyPercentiles(
+    val p50Us: Long = 0,
+    val p95Us: Long = 0,
+    val p99Us: Long = 0,
+    val count: Int = 0
+)
+
+/**
+ * 지연 통계 스냅샷 (디버그 오버레이/CSV 내보내기용)
+ *
+ * @property stages 구간별 백분위 (최근 윈도우 기준)
+ * @property framesWritten 측정된 누적 전송 프레임 수
+ * @property mergedSamples 다른 샘플과 합쳐져 단독 프레임으로 나가지 않은 터치 샘플 수
+ * @property droppedFrames 전송 링이 가득 차 덮어쓴 프레임 수
+ */
+data class FrameLatencySnapshot(
+    val stages: Map<LatencyStage, LatencyPercentiles> = emptyMap(),
+    val framesWritten: Long = 0,
+    val mergedSamples: Long = 0,
+    val droppedFrames: Long = 0
+) {
+    /**
+     * CSV 텍스트로 변환합니다 (구간별 1행 + 카운터 행).
+     */
+    fun toCsv(): String = buildString {
+        append("stage,p50_us,p95_us,p99_us,count\n")
+        for (stage in LatencyStage.entries) {
+            val p = stages[stage] ?: LatencyPercentiles()
+            append("${stage.name},${p.p50Us},${p.p95Us},${p.p99Us},${p.count}\n")
+        }
+        append("frames_written,,,,$framesWritten\n")
+        append("merged_samples,,,,$mergedSamples\n")
+        append("dropped_frames,,,,$droppedFrames\n")
+    }
+}
+
+/**
+ * 롤링 윈도우 지연 히스토그램 (단일 스레드 또는 외부 동기화 전제)
+ *
+ * 최근 [windowSize]개 샘플만 반영합니다. 기록은 버킷 카운트 증감만 하므로 할당이 없고,
+ * 백분위 조회는 버킷 수(281)에 비례합니다.
+ *
+ * 버킷 (µs):
+ * - 0 ~ 1ms: 10µs 간격 (100개)
+ * - 1 ~ 10ms: 100µs 간격 (90개)
+ * - 10 ~ 100ms: 1ms 간격 (90개)
+ * - 100ms 이상: 1개
+ *
+ * @param windowSize 롤링 윈도우 샘플 수
+ */
+class LatencyHistogram(private val windowSize: Int = DEFAULT_WINDOW) {
+
+    private val bucketCounts = IntArray(BUCKET_COUNT)
+    private val window = IntArray(windowSize)
+    private var windowPos = 0
+
+    /** 윈도우에 들어 있는 샘플 수 */
+    var count = 0
+        private set
+
+    /**
+     * 지연 샘플 1개 기록 (음수는 0으로 처리).
+     */
+    fun record(latencyNanos: Long) {
+        val bucket = bucketOf(latencyNanos / 1000)
+        if (count == windowSize) {
+            bucketCounts[window[windowPos]]--
+        } else {
+            count++
+        }
+        window[windowPos] = bucket
+        bucketCounts[bucket]++
+        windowPos = (windowPos + 1) % windowSize
+    }
+
+    /**
+     * 백분위 지연 (µs, 해당 버킷의 상한값). 샘플이 없으면 0.
+     *
+     * @param percentile 0.0 ~ 1.0
+     */
+    fun percentileMicros(percentile: Double): Long {
+        if (count == 0) return 0
+        val target = kotlin.math.ceil(percentile * count).toLong().coerceIn(1L, count.toLong())
+        var cumulative = 0L
+        for (bucket in 0 until BUCKET_COUNT) {
+            cumulative += bucketCounts[bucket]
+            if (cumulative >= target) return bucketUpperMicros(bucket)
+        }
+        return bucketUpperMicros(BUCKET_COUNT - 1)
+    }
+
+    fun percentiles() = LatencyPercentiles(
+        p50Us = percentileMicros(0.50),
+        p95Us = percentileMicros(0.95),
+        p99Us = percentileMicros(0.99),
+        count = count
+    )
+
+    fun clear() {
+        bucketCounts.fill(0)
+        windowPos = 0
+        count = 0
+    }
+
+    companion object {
+        /** 기본 윈도우: 1kHz 전송 기준 약 2초 */
+        const val DEFAULT_WINDOW = 2048
+
+        private const val FINE_BUCKETS = 100      // 10µs × 100 = 1ms
+        private const val MEDIUM_BUCKETS = 90     // 100µs × 90 = 1~10ms
+        private const val COARSE_BUCKETS = 90     // 1ms × 90 = 10~100ms
+        const val BUCKET_COUNT = FINE_BUCKETS + MEDIUM_BUCKETS + COARSE_BUCKETS + 1
+
+        /** 100ms 이상 버킷의 표시값 */
+        const val OVERFLOW_MICROS = 100_000L
+
+        internal fun bucketOf(micros: Long): Int = when {
+            micros < 0 -> 0
+            micros < 1_000 -> (micros / 10).toInt()
+            micros < 10_000 -> FINE_BUCKETS + ((micros - 1_000) / 100).toInt()
+            micros < 100_000 -> FINE_BUCKETS + MEDIUM_BUCKETS + ((micros - 10_000) / 1_000).toInt()
+            else -> BUCKET_COUNT - 1
+        }
+
+        internal fun bucketUpperMicros(bucket: Int): Long = when {
+            bucket < FINE_BUCKETS -> (bucket + 1) * 10L
+            bucket < FINE_BUCKETS + MEDIUM_BUCKETS -> 1_000L + (bucket - FINE_BUCKETS + 1) * 100L
+            bucket < BUCKET_COUNT - 1 -> 10_000L + (bucket - FINE_BUCKETS - MEDIUM_BUCKETS + 1) * 1_000L
+            else -> OVERFLOW_MICROS
+        }
+    }
+}
+
+/**
+ * 프레임 단위 터치 → UART 지연 추적기 (스레드 안전)
+ *
+ * UART 전송 스레드가 port.write() 반환 직후 [recordFrame]으로 구간별 지연을 기록하고,
+ * 입력 스레드는 샘플 합침 수를 [recordMerged]로 보고합니다.
+ * 기록 경로는 할당이 없으며, [snapshot]만 객체를 생성합니다 (오버레이 갱신 주기마다 1회).
+ *
+ * @param windowSize 구간별 롤링 윈도우 샘플 수
+ */
+class FrameLatencyTracker(windowSize: Int = LatencyHistogram.DEFAULT_WINDOW) {
+
+    private val histograms = Array(LatencyStage.entries.size) { LatencyHistogram(windowSize) }
+    private var framesWritten = 0L
+    private var mergedSamples = 0L
+
+    /**
+     * 전송 완료된 프레임 1개의 타임스탬프 기록.
+     *
+     * sourceNanos가 0이면 터치 샘플과 무관한 프레임(쿼리/키보드 등)이므로 enqueue→write만 기록합니다.
+     *
+     * @param sourceNanos 프레임에 포함된 가장 오래된 터치 샘플의 eventTime (ns, 0 = 없음)
+     * @param processedNanos 그 샘플을 입력 스레드가 처리한 시각 (ns)
+     * @param enqueueNanos 전송 링 기록 시각 (ns)
+     * @param writtenNanos port.write() 반환 시각 (ns)
+     */
+    @Synchronized
+    fun recordFrame(sourceNanos: Long, processedNanos: Long, enqueueNanos: Long, writtenNanos: Long) {
+        framesWritten++
+        histograms[LatencyStage.ENQUEUE_TO_WRITE.ordinal].record(writtenNanos - enqueueNanos)
+        if (sourceNanos == 0L) return
+        histograms[LatencyStage.TOUCH_TO_DELTA.ordinal].record(processedNanos - sourceNanos)
+        histograms[LatencyStage.DELTA_TO_ENQUEUE.ordinal].record(enqueueNanos - processedNanos)
+        histograms[LatencyStage.TOUCH_TO_WIRE.ordinal].record(writtenNanos - sourceNanos)
+    }
+
+    /**
+     * 프레임 하나에 합쳐진 추가 샘플 수 보고 (샘플 n개 → 프레임 1개이면 n - 1).
+     */
+    @Synchronized
+    fun recordMerged(samples: Int) {
+        mergedSamples += samples
+    }
+
+    /**
+     * 현재 통계 스냅샷.
+     *
+     * @param droppedFrames 전송 링 덮어쓰기 누적 수 (FrameRing.droppedCount)
+     */
+    @Synchronized
+    fun snapshot(droppedFrames: Long): FrameLatencySnapshot = FrameLatencySnapshot(
+        stages = LatencyStage.entries.associateWith { histograms[it.ordinal].percentiles() },
+        framesWritten = framesWritten,
+        mergedSamples = mergedSamples,
+        droppedFrames = droppedFrames
+    )
+
+    @Synchronized
+    fun reset() {
+        histograms.forEach { it.clear() }
+        framesWritten = 0
+        mergedSamples = 0
+    }
+}
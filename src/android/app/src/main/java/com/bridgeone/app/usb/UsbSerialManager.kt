@@ -5,6 +5,8 @@ import android.hardware.usb.UsbDevice
 import android.hardware.usb.UsbManager
 import android.util.Log
 import com.bridgeone.app.protocol.BridgeFrame
+import com.bridgeone.app.protocol.FrameBuilder
+import com.bridgeone.app.protocol.FrameRing
 import com.bridgeone.app.protocol.BridgeMode
 import com.bridgeone.app.protocol.NotificationFrame
 import com.bridgeone.app.usb.UsbConstants
@@ -13,10 +15,10 @@ import com.hoho.android.usbserial.driver.ProbeTable
 import com.hoho.android.usbserial.driver.UsbSerialPort
 import com.hoho.android.usbserial.driver.UsbSerialProber
 import java.io.IOException
-import java.util.concurrent.LinkedBlockingQueue
 import kotlinx.coroutines.flow.MutableStateFlow
 import kotlinx.coroutines.flow.StateFlow
 import kotlinx.coroutines.flow.asStateFlow
+import kotlin.math.roundToInt
 
 /**
  * USB Serial 통신 싱글톤 매니저
@@ -90,6 +92,23 @@ object UsbSerialManager {
     private val _debugState = MutableStateFlow(UsbDebugState())
     val debugState: StateFlow<UsbDebugState> = _debugState.asStateFlow()
 
+    // ========== 지연 통계 (디버그 오버레이용) ==========
+
+    /** 터치 → UART 전송 구간별 지연 추적기 (전송 스레드가 기록) */
+    private val latencyTracker = FrameLatencyTracker()
+
+    /** 통계 초기화 시점의 frameQueue 덮어쓰기 누적 수 */
+    @Volatile
+    private var droppedFramesBaseline = 0L
+
+    private val _latencyStats = MutableStateFlow(FrameLatencySnapshot())
+
+    /**
+     * 터치 → UART 지연 통계 (p50/p95/p99, 합침/덮어쓰기 수).
+     * 전송 중에는 [LATENCY_PUBLISH_INTERVAL_NS]마다 갱신됩니다.
+     */
+    val latencyStats: StateFlow<FrameLatencySnapshot> = _latencyStats.asStateFlow()
+
     // ========== 데이터 멤버 (상태 관리) ==========
 
     /**
@@ -276,6 +295,7 @@ object UsbSerialManager {
             // lastNotification은 자동 초기화되지 않으므로 bridgeMode를 직접 초기화
             _bridgeMode.value = BridgeMode.ESSENTIAL
             _modeConfirmed.value = false
+            storedMacroMask = 0
             Log.d(TAG, "BridgeMode reset to ESSENTIAL on port close")
         }
     }
@@ -385,15 +405,16 @@ object UsbSerialManager {
     // ========== 비동기 전송 큐 (Phase 2.3.6) ==========
 
     /**
-     * 프레임 전송 큐.
-     * UI 스레드(터치 이벤트 루프)는 큐에 프레임을 넣기만 하고,
-     * 전용 백그라운드 스레드가 큐에서 꺼내 UART로 전송합니다.
+     * 프레임 전송 큐 (사전 할당 슬롯 링).
+     * 입력/UI 스레드는 링 슬롯에 프레임을 기록하기만 하고,
+     * 전용 백그라운드 스레드가 꺼내 UART로 전송합니다.
      * 이를 통해 터치 이벤트 루프가 port.write() 블로킹에 영향받지 않습니다.
      *
-     * 큐 용량 64: 360Hz 터치 / 60Hz Compose = 최대 ~6개/프레임.
-     * 64개면 약 10프레임분 버퍼로 충분한 여유.
+     * 용량 64: 360Hz 터치 / 60Hz Compose = 최대 ~6개/프레임.
+     * 64개면 약 10프레임분 버퍼로 충분한 여유. 가득 차면 가장 오래된 프레임을 덮어씁니다.
+     * 프레임마다 객체를 만들지 않으므로(ByteArray, 큐 노드) 고주사율 이동 중 GC가 발생하지 않습니다.
      */
-    private val frameQueue = LinkedBlockingQueue<ByteArray>(64)
+    private val frameQueue = FrameRing(FrameRing.DEFAULT_CAPACITY)
 
     /**
      * 전송 전용 백그라운드 스레드.
@@ -418,14 +439,29 @@ object UsbSerialManager {
         frameQueue.clear()
         senderThread = Thread({
             Log.d(TAG, "Sender thread started")
+            // 전송 스레드 소유 버퍼 (프레임마다 재사용)
+            val frameData = ByteArray(UsbConstants.DELTA_FRAME_SIZE)
+            var lastPublishNanos = 0L
             while (!Thread.currentThread().isInterrupted) {
                 try {
-                    val frameData = frameQueue.take() // 큐가 비어있으면 블로킹 대기
+                    frameQueue.take(frameData) // 큐가 비어있으면 블로킹 대기
                     val port = usbSerialPort
                     if (port == null || !isConnected) continue
 
                     port.write(frameData, UsbConstants.USB_WRITE_TIMEOUT_MS)
                     consecutiveFailures = 0
+
+                    val writtenNanos = System.nanoTime()
+                    latencyTracker.recordFrame(
+                        frameQueue.lastSourceNanos,
+                        frameQueue.lastProcessedNanos,
+                        frameQueue.lastEnqueueNanos,
+                        writtenNanos
+                    )
+                    if (writtenNanos - lastPublishNanos >= LATENCY_PUBLISH_INTERVAL_NS) {
+                        lastPublishNanos = writtenNanos
+                        publishLatencyStats()
+                    }
                 } catch (e: InterruptedException) {
                     Thread.currentThread().interrupt()
                     break
@@ -480,11 +516,12 @@ object UsbSerialManager {
                     val len = port.read(buf, 100)
                     if (len < 0) {
                         Log.e(TAG, "Receiver: read error (len=$len)")
-                    } else if (len > 0) {
-                        Log.d(TAG, "Receiver: read $len bytes: ${buf.take(len).joinToString(" ") { "0x%02X".format(it) }}")
+                    } else if (len > 0 && Log.isLoggable(TAG, Log.DEBUG)) {
+                        // 16진수 덤프 문자열은 디버그 로그가 켜져 있을 때만 생성
+                        Log.d(TAG, "Receiver: read $len bytes: ${hexDump(buf, len)}")
                     }
                     if (len > 0 && len != NotificationFrame.FRAME_SIZE) {
-                        Log.w(TAG, "Receiver: partial read ($len bytes), discarding: ${buf.take(len).joinToString(" ") { "0x%02X".format(it) }}")
+                        Log.w(TAG, "Receiver: partial read ($len bytes), discarding: ${hexDump(buf, len)}")
                         continue
                     }
                     if (len != NotificationFrame.FRAME_SIZE) continue
@@ -505,6 +542,8 @@ object UsbSerialManager {
                         _bridgeMode.value = newMode
                         _modeConfirmed.value = true
                         Log.i(TAG, "BridgeMode changed: $oldMode → $newMode (confirmed)")
+                    } else if (frame.eventType == NotificationFrame.EVENT_MACRO_SLOTS) {
+                        storedMacroMask = frame.word.toInt()
                     }
 
                 } catch (e: InterruptedException) {
@@ -524,6 +563,10 @@ object UsbSerialManager {
         }
     }
 
+    /** 수신 바이트 16진수 덤프 (로그 전용) */
+    private fun hexDump(buf: ByteArray, len: Int): String =
+        buf.take(len).joinToString(" ") { "0x%02X".format(it) }
+
     /**
      * 수신 스레드를 중지합니다.
      */
@@ -554,7 +597,16 @@ object UsbSerialManager {
                     val query = ByteArray(8)
                     query[0] = 0xFF.toByte()
                     query[1] = 0x01.toByte()
-                    frameQueue.offer(query)
+                    frameQueue.put(query)
+
+                    // 포인터 다이나믹스 설정 재전송 (ESP32 재시작 시에도 설정 유지)
+                    pointerDynamicsFrame?.let { frameQueue.put(it) }
+
+                    // 저장된 매크로 슬롯 조회 (Windows 업로드 후 2초 안에 트리거 사용 시작)
+                    val slotsQuery = ByteArray(8)
+                    slotsQuery[0] = 0xFF.toByte()
+                    slotsQuery[1] = QUERY_MACRO_SLOTS
+                    frameQueue.put(slotsQuery)
 
                     // 쿼리 전송 후 2초 대기 (첫 쿼리는 즉시 전송됨)
                     Thread.sleep(2000)
@@ -582,22 +634,200 @@ object UsbSerialManager {
         // 포트 연결 상태 확인
         check(usbSerialPort != null && isConnected) { "USB Serial port is not connected" }
 
-        // BridgeFrame을 8바이트 ByteArray로 직렬화
-        val frameData = frame.toByteArray()
+        // 링 슬롯에 직접 기록 (toByteArray() 할당 없음).
+        // 링이 가득 차면 가장 오래된 프레임을 덮어씀: 이미 지연된 델타이므로 버려도 커서 위치에 영향 없음.
+        frame.writeTo(frameQueue)
+    }
 
-        // 프레임 크기 검증
-        check(frameData.size == UsbConstants.DELTA_FRAME_SIZE) {
-            "Invalid frame size: ${frameData.size}, expected: ${UsbConstants.DELTA_FRAME_SIZE}"
-        }
+    /**
+     * 마우스 프레임을 전송 링에 직접 기록합니다 (할당 없는 핫패스).
+     *
+     * BridgeFrame 객체를 만들지 않고 FrameBuilder가 시퀀스 번호와 함께 슬롯에 기록합니다.
+     * 커서 입력 파이프라인처럼 고주사율로 호출되는 경로에서 사용합니다.
+     * 연결되지 않은 상태면 조용히 버립니다.
+     *
+     * @param buttons 마우스 버튼 비트 (+ 휠 플래그)
+     * @param deltaX X축 이동 (-127 ~ 127)
+     * @param deltaY Y축 이동 (-127 ~ 127)
+     * @param wheel 휠 값
+     * @param sourceNanos 프레임에 포함된 가장 오래된 터치 샘플 시각 (지연 측정용, 0 = 측정 안 함)
+     * @param processedNanos 그 샘플의 입력 스레드 처리 시각
+     * @param sampleCount 이 프레임에 합쳐진 터치 샘플 수 (2 이상이면 합침 수에 반영)
+     */
+    fun sendMouseFrame(
+        buttons: UByte,
+        deltaX: Byte,
+        deltaY: Byte,
+        wheel: Byte = 0,
+        sourceNanos: Long = 0L,
+        processedNanos: Long = 0L,
+        sampleCount: Int = 0
+    ) {
+        if (usbSerialPort == null || !isConnected) return
+        if (sampleCount > 1) latencyTracker.recordMerged(sampleCount - 1)
+        FrameBuilder.writeFrame(
+            frameQueue, buttons, deltaX, deltaY, wheel,
+            sourceNanos = sourceNanos,
+            processedNanos = processedNanos
+        )
+    }
+
+    /**
+     * 현재 지연 통계를 [latencyStats]에 반영합니다.
+     */
+    private fun publishLatencyStats() {
+        _latencyStats.value = latencyTracker.snapshot(frameQueue.droppedCount - droppedFramesBaseline)
+    }
+
+    /**
+     * 지연 통계를 CSV로 내보냅니다 (최신 값으로 갱신 후 변환).
+     *
+     * 디바이스 측 통계와 비교하여 지연 증가가 폰/동글 중 어디서 발생했는지 판단하는 용도입니다.
+     */
+    fun exportLatencyCsv(): String {
+        publishLatencyStats()
+        return _latencyStats.value.toCsv()
+    }
+
+    /**
+     * 지연 통계를 초기화합니다 (측정 구간 시작).
+     */
+    fun resetLatencyStats() {
+        latencyTracker.reset()
+        droppedFramesBaseline = frameQueue.droppedCount
+        publishLatencyStats()
+    }
+
+    /**
+     * ESP32-S3에 저장된 매크로 재생을 요청합니다.
+     *
+     * 매크로는 Windows 서버가 Vendor CDC로 미리 업로드해 둔 것이며 (MacroUploadService),
+     * 스텝 간 타이밍은 ESP32-S3가 보장하므로 Android는 프레임 1개만 전송합니다.
+     * 저장 여부는 [isMacroStored]로 먼저 확인합니다 (빈 슬롯 트리거는 무시됨).
+     *
+     * 프레임: {0xFF=쿼리 헤더, 0x02=매크로 재생, macroId, 0x00*5}
+     *
+     * @param macroId 매크로 ID (0~31)
+     * @throws IllegalStateException 포트가 열려있지 않은 경우
+     */
+    fun sendMacroTrigger(macroId: Int) {
+        check(usbSerialPort != null && isConnected) { "USB Serial port is not connected" }
+        require(macroId in 0 until MACRO_MAX_COUNT) { "Invalid macroId: $macroId" }
+
+        val frame = ByteArray(UsbConstants.DELTA_FRAME_SIZE)
+        frame[0] = 0xFF.toByte()
+        frame[1] = QUERY_MACRO_RUN
+        frame[2] = macroId.toByte()
+        frameQueue.put(frame)
+    }
 
-        // 큐에 추가 (논블로킹). 큐가 가득 차면 가장 오래된 프레임 제거 후 추가.
-        // 오래된 프레임은 이미 지연된 델타이므로 버려도 커서 위치에 영향 없음.
-        if (!frameQueue.offer(frameData)) {
-            frameQueue.poll() // 가장 오래된 프레임 제거
-            frameQueue.offer(frameData)
+    /**
+     * ESP32-S3의 포인터 다이나믹스(커서 가속) 설정을 변경합니다.
+     *
+     * 가속은 펌웨어가 코얼레싱 후 Q16 룩업 테이블로 적용하므로,
+     * Android는 DPI 배율만 적용한 raw 델타를 전송합니다.
+     * 설정은 보관되었다가 모드 폴링 주기마다 재전송됩니다 (연결 직후/ESP32 재시작 대비).
+     *
+     * 프레임: {0xFF=쿼리 헤더, 0x03=다이나믹스 설정, presetIndex, scale LE16, 0x00*3}
+     * scale = dp 1당 델타 카운트 (Q8.8) = 화면 밀도 × DPI 배율
+     *
+     * @param presetIndex DYNAMICS_PRESETS 인덱스 (ESP32 pointer_dynamics_preset_t와 일치)
+     * @param countsPerDp dp 1당 델타 카운트 (px/dp × DPI 배율)
+     */
+    fun setPointerDynamics(presetIndex: Int, countsPerDp: Float) {
+        require(presetIndex in 0..0xFF) { "Invalid presetIndex: $presetIndex" }
+        val scaleQ8 = (countsPerDp * 256f).roundToInt().coerceIn(1, 0xFFFF)
+
+        val frame = ByteArray(UsbConstants.DELTA_FRAME_SIZE)
+        frame[0] = 0xFF.toByte()
+        frame[1] = QUERY_SET_DYNAMICS
+        frame[2] = presetIndex.toByte()
+        frame[3] = (scaleQ8 and 0xFF).toByte()
+        frame[4] = (scaleQ8 shr 8).toByte()
+        pointerDynamicsFrame = frame
+
+        if (usbSerialPort != null && isConnected) {
+            frameQueue.put(frame)
         }
     }
 
+    /**
+     * ESP32-S3 관성 스크롤을 시작합니다.
+     *
+     * 손가락을 뗄 때 초기 속도 프레임 1개만 보내면, 지수 감쇠 곡선과 1ms 주기
+     * 휠 리포트는 펌웨어가 생성합니다 (scroll_inertia.c).
+     *
+     * 프레임: {0xFF=쿼리 헤더, 0x04=관성 스크롤, axis, velocity Q8.8 LE16, tau LE16, stop Q4.4}
+     *
+     * @param horizontal true=수평 휠(AC Pan), false=수직 휠
+     * @param unitsPerMs 초기 속도 (1/[BridgeFrame.WHEEL_UNITS_PER_DETENT] 디텐트 단위/ms, 양수=위/오른쪽)
+     * @param timeConstantMs 감쇠 시간 상수 (ms)
+     * @param stopUnitsPerMs 정지 속도 (단위/ms)
+     */
+    fun sendScrollFling(horizontal: Boolean, unitsPerMs: Float, timeConstantMs: Float, stopUnitsPerMs: Float) {
+        val velocityQ8 = (unitsPerMs * 256f).roundToInt().coerceIn(-0x7FFF, 0x7FFF)
+        val tauMs = timeConstantMs.roundToInt().coerceIn(1, 0xFFFF)
+        val stopQ4 = (stopUnitsPerMs * 16f).roundToInt().coerceIn(1, 0xFF)
+        offerScrollFlingFrame(if (horizontal) 1 else 0, velocityQ8, tauMs, stopQ4)
+    }
+
+    /**
+     * 진행 중인 ESP32-S3 관성 스크롤을 정지합니다 (velocity = 0 프레임).
+     */
+    fun stopScrollFling() {
+        offerScrollFlingFrame(0, 0, 0, 0)
+    }
+
+    private fun offerScrollFlingFrame(axis: Int, velocityQ8: Int, tauMs: Int, stopQ4: Int) {
+        if (usbSerialPort == null || !isConnected) return
+
+        val frame = ByteArray(UsbConstants.DELTA_FRAME_SIZE)
+        frame[0] = 0xFF.toByte()
+        frame[1] = QUERY_SCROLL_FLING
+        frame[2] = axis.toByte()
+        frame[3] = (velocityQ8 and 0xFF).toByte()
+        frame[4] = (velocityQ8 shr 8).toByte()
+        frame[5] = (tauMs and 0xFF).toByte()
+        frame[6] = (tauMs shr 8).toByte()
+        frame[7] = stopQ4.toByte()
+        frameQueue.put(frame)
+    }
+
+    /**
+     * ESP32-S3에 해당 매크로가 저장되어 있는지 여부.
+     *
+     * 모드 폴링마다 보내는 MACRO_SLOTS 쿼리의 응답(비트맵)을 기준으로 하며,
+     * 포트가 닫히면 초기화됩니다. false이면 호출 측은 개별 키 프레임으로 대신 보냅니다.
+     */
+    fun isMacroStored(macroId: Int): Boolean =
+        isConnected && macroId in 0 until MACRO_MAX_COUNT && (storedMacroMask ushr macroId) and 1 != 0
+
+    /** 지연 통계 StateFlow 갱신 주기 (250ms) */
+    private const val LATENCY_PUBLISH_INTERVAL_NS = 250_000_000L
+
+    /** 관성 스크롤 쿼리 타입 (ESP32 UART_QUERY_SCROLL_FLING) */
+    private const val QUERY_SCROLL_FLING: Byte = 0x04
+
+    /** 마지막 포인터 다이나믹스 설정 프레임 (폴링 스레드가 재전송) */
+    @Volatile
+    private var pointerDynamicsFrame: ByteArray? = null
+
+    /** 포인터 다이나믹스 설정 쿼리 타입 (ESP32 UART_QUERY_SET_DYNAMICS) */
+    private const val QUERY_SET_DYNAMICS: Byte = 0x03
+
+    /** 매크로 재생 쿼리 타입 (ESP32 UART_QUERY_MACRO_RUN) */
+    private const val QUERY_MACRO_RUN: Byte = 0x02
+
+    /** 매크로 슬롯 조회 쿼리 타입 (ESP32 UART_QUERY_MACRO_SLOTS) */
+    private const val QUERY_MACRO_SLOTS: Byte = 0x05
+
+    /** 저장된 매크로 슬롯 비트맵 (ESP32 EVENT_MACRO_SLOTS 응답, 수신 스레드가 갱신) */
+    @Volatile
+    private var storedMacroMask: Int = 0
+
+    /** ESP32 매크로 슬롯 수 (ESP32 MACRO_MAX_COUNT) */
+    private const val MACRO_MAX_COUNT = 32
+
     // ========== 권한 처리 함수 (Phase 2.2.2.2에서 추가) ==========
 
     /**
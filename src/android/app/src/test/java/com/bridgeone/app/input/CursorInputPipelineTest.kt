@@ -0,0 +1,193 @@
+package com.bridgeone.app.input
+
+import com.bridgeone.app.ui.utils.RightAngleAxis
+import org.junit.Assert.*
+import org.junit.Test
+
+/**
+ * CursorInputPipeline / CursorMotionProcessor 단위 테스트
+ *
+ * 입력 스레드를 띄우지 않고 가짜 시계로 pump()를 직접 호출하여
+ * 서브픽셀 누산, 1ms 페이싱, 이벤트 순서를 결정적으로 검증합니다.
+ */
+class CursorInputPipelineTest {
+
+    private data class Sent(val buttons: Int, val dx: Int, val dy: Int)
+    private data class Timing(val sourceNanos: Long, val processedNanos: Long, val samples: Int)
+
+    private var nowNanos = 0L
+    private val sent = mutableListOf<Sent>()
+    private val timings = mutableListOf<Timing>()
+    private val pipeline = CursorInputPipeline(
+        sink = { buttons, dx, dy, timing ->
+            sent.add(Sent(buttons, dx, dy))
+            timings.add(Timing(timing.sourceNanos, timing.processedNanos, timing.sampleCount))
+        },
+        nanoClock = { nowNanos }
+    )
+
+    private val freeConfig = CursorGestureConfig(
+        deadZonePx = 10f,
+        rightAngle = false,
+        rightAngleLockDistPx = 20f,
+        rightAngleDeadbandDeg = 22.5f,
+        dpiMultiplier = 1f
+    )
+
+    /** 원점에서 시작해 (stepX, stepY)씩 n번 이동하는 샘플 제출 */
+    private fun submitLine(startX: Float, startY: Float, stepX: Float, stepY: Float, n: Int) {
+        var x = startX
+        var y = startY
+        repeat(n) {
+            pipeline.submitSample(x, y, x + stepX, y + stepY)
+            x += stepX
+            y += stepY
+        }
+    }
+
+    /** 보낼 이동량이 없어질 때까지 1ms씩 시계를 진행하며 pump */
+    private fun drainAll() {
+        var guard = 0
+        while (pipeline.pump() >= 0 && guard++ < 1000) {
+            nowNanos += CursorInputPipeline.FRAME_INTERVAL_NANOS
+        }
+    }
+
+    /**
+     * Test: 1픽셀 미만 샘플도 누산되어 총 이동량이 보존됨 (정수 절삭 손실 없음)
+     */
+    @Test
+    fun testSubpixelSamplesAreNotLost() {
+        pipeline.beginGesture(0f, 0f, freeConfig.copy(deadZonePx = 0f))
+        submitLine(0f, 0f, 0.25f, -0.125f, 96)
+        drainAll()
+
+        assertEquals("total dx", 24, sent.sumOf { it.dx })
+        assertEquals("total dy", -12, sent.sumOf { it.dy })
+    }
+
+    /**
+     * Test: 한 번에 도착한 샘플 묶음은 1ms당 1프레임으로 합쳐 전송
+     */
+    @Test
+    fun testSamplesArePacedToFrameInterval() {
+        pipeline.beginGesture(0f, 0f, freeConfig.copy(deadZonePx = 0f))
+        submitLine(0f, 0f, 5f, 0f, 8)   // 한 vsync에 도착한 8개 샘플
+
+        pipeline.pump()
+        assertEquals("one frame per interval", 1, sent.size)
+        assertEquals("coalesced motion", 40, sent[0].dx)
+
+        submitLine(40f, 0f, 5f, 0f, 2)
+        val wait = pipeline.pump()
+        assertEquals("must wait for next slot", 1, sent.size)
+        assertTrue("wait within one interval", wait in 1..CursorInputPipeline.FRAME_INTERVAL_NANOS)
+
+        nowNanos += CursorInputPipeline.FRAME_INTERVAL_NANOS
+        pipeline.pump()
+        assertEquals(2, sent.size)
+        assertEquals(10, sent[1].dx)
+    }
+
+    /**
+     * Test: ±127 초과 이동량은 잘리지 않고 다음 프레임으로 이월
+     */
+    @Test
+    fun testLargeMotionIsSplitAcrossFrames() {
+        pipeline.beginGesture(0f, 0f, freeConfig.copy(deadZonePx = 0f, dpiMultiplier = 2f))
+        pipeline.submitSample(0f, 0f, 150f, 0f)
+        drainAll()
+
+        assertTrue("every frame within HID range", sent.all { it.dx in -127..127 })
+        assertEquals("total dx with DPI", 300, sent.sumOf { it.dx })
+    }
+
+    /**
+     * Test: 데드존 안의 이동은 전송되지 않음
+     */
+    @Test
+    fun testDeadZoneSuppressesMotion() {
+        pipeline.beginGesture(0f, 0f, freeConfig)
+        submitLine(0f, 0f, 1f, 1f, 5)   // 거리 ≈ 7px < 10px
+        drainAll()
+        assertTrue("no frame inside dead zone", sent.isEmpty())
+    }
+
+    /**
+     * Test: 클릭 프레임은 앞선 이동량을 포함하여 순서대로 즉시 전송
+     */
+    @Test
+    fun testButtonsFollowPendingMotion() {
+        pipeline.beginGesture(0f, 0f, freeConfig.copy(deadZonePx = 0f))
+        pipeline.submitSample(0f, 0f, 3f, 4f)
+        pipeline.submitButtons(0x01)
+        pipeline.submitButtons(0x00)
+        pipeline.pump()
+
+        assertEquals(listOf(Sent(0x01, 3, 4), Sent(0x00, 0, 0)), sent)
+    }
+
+    /**
+     * Test: 직각 이동 모드 - 주축 확정 전 이동 차단, 확정 후 반대 축 제거, 리스너 1회 호출
+     */
+    @Test
+    fun testRightAngleLock() {
+        val locked = mutableListOf<RightAngleAxis>()
+        pipeline.axisLockListener = CursorInputPipeline.AxisLockListener { locked.add(it) }
+
+        pipeline.beginGesture(0f, 0f, freeConfig.copy(deadZonePx = 0f, rightAngle = true))
+        submitLine(0f, 0f, 5f, 1f, 4)    // 누적 20px 초과 → HORIZONTAL 확정 (이동 차단)
+        submitLine(20f, 4f, 5f, 1f, 4)   // 확정 후: Y 제거
+        drainAll()
+
+        assertEquals(listOf(RightAngleAxis.HORIZONTAL), locked)
+        assertEquals("x after lock only", 20, sent.sumOf { it.dx })
+        assertEquals("y removed", 0, sent.sumOf { it.dy })
+    }
+
+    /**
+     * Test: 새 제스처는 이전 제스처의 누산 잔여분을 이어받지 않음
+     */
+    @Test
+    fun testBeginResetsCarry() {
+        pipeline.beginGesture(0f, 0f, freeConfig.copy(deadZonePx = 0f))
+        pipeline.submitSample(0f, 0f, 0.9f, 0f)
+        pipeline.beginGesture(0f, 0f, freeConfig.copy(deadZonePx = 0f))
+        pipeline.submitSample(0f, 0f, 0.9f, 0f)
+        drainAll()
+        assertTrue("carry must not leak across gestures", sent.isEmpty())
+    }
+
+    /**
+     * Test: 링이 가득 차도 이동 샘플은 합쳐져 총 이동량 보존
+     */
+    @Test
+    fun testRingOverflowCoalescesMoves() {
+        pipeline.beginGesture(0f, 0f, freeConfig.copy(deadZonePx = 0f))
+        submitLine(0f, 0f, 1f, 0f, CursorInputPipeline.EVENT_CAPACITY * 2)
+        drainAll()
+        assertEquals(CursorInputPipeline.EVENT_CAPACITY * 2, sent.sumOf { it.dx })
+    }
+
+    /**
+     * Test: 프레임 타이밍은 합쳐진 샘플 중 가장 오래된 샘플의 터치 시각과 처리 시각을 보고
+     */
+    @Test
+    fun testFrameTimingReportsOldestSample() {
+        nowNanos = 5_000_000L
+        pipeline.beginGesture(0f, 0f, freeConfig.copy(deadZonePx = 0f))
+        pipeline.submitSample(0f, 0f, 2f, 0f, eventTimeNanos = 1_000_000L)
+        pipeline.submitSample(2f, 0f, 4f, 0f, eventTimeNanos = 2_000_000L)
+        pipeline.submitSample(4f, 0f, 6f, 0f, eventTimeNanos = 3_000_000L)
+        pipeline.pump()
+
+        assertEquals(1, sent.size)
+        assertEquals(Timing(1_000_000L, 5_000_000L, 3), timings[0])
+
+        // 다음 프레임은 새 샘플 기준
+        nowNanos += CursorInputPipeline.FRAME_INTERVAL_NANOS
+        pipeline.submitSample(6f, 0f, 8f, 0f, eventTimeNanos = 4_000_000L)
+        pipeline.pump()
+        assertEquals(Timing(4_000_000L, 6_000_000L, 1), timings[1])
+    }
+}
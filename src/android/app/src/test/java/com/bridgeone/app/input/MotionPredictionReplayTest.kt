@@ -0,0 +1,188 @@
+package com.bridgeone.app.input
+
+import org.junit.Assert.*
+import org.junit.Test
+import kotlin.math.abs
+import kotlin.math.sqrt
+
+/**
+ * MotionPredictor 터치 트레이스 재생 하네스
+ *
+ * src/test/resources/traces/ 의 터치 트레이스(t_ms,x,y)를 재생하여
+ * - 예측 오차: 표시 위치(실제 + 예측 오프셋)와 horizon 뒤 실제 위치의 RMS 거리
+ * - 절감 지연: 표시 위치가 가장 잘 맞는 실제 궤적의 시간 이동량 (예측 없음 = 0ms)
+ * - 순 이동량: 예측 on/off의 CursorMotionProcessor 총 카운트 차이 (드리프트 없음 확인)
+ * 을 측정하고 표로 출력합니다. 트레이스를 추가하면 [TRACES]에 이름만 넣으면 됩니다.
+ */
+class MotionPredictionReplayTest {
+
+    private class Sample(val tNanos: Long, val x: Float, val y: Float)
+
+    private class ReplayResult(
+        val baselineErrorPx: Double,
+        val predictedErrorPx: Double,
+        val latencySavedMs: Double
+    )
+
+    private fun loadTrace(name: String): List<Sample> {
+        val stream = javaClass.classLoader!!.getResourceAsStream("traces/$name")
+            ?: error("trace not found: $name")
+        return stream.bufferedReader().useLines { lines ->
+            lines.filter { it.isNotBlank() && !it.startsWith("#") && !it.startsWith("t_ms") }
+                .map { line ->
+                    val (t, x, y) = line.split(',')
+                    Sample(t.trim().toLong() * 1_000_000L, x.trim().toFloat(), y.trim().toFloat())
+                }
+                .toList()
+        }
+    }
+
+    /** t 시각의 실제 위치 (선형 보간, 트레이스 범위 밖이면 null) */
+    private fun positionAt(trace: List<Sample>, tNanos: Long): Pair<Double, Double>? {
+        for (i in 1 until trace.size) {
+            val b = trace[i]
+            if (b.tNanos < tNanos) continue
+            val a = trace[i - 1]
+            val f = if (b.tNanos == a.tNanos) 0.0 else (tNanos - a.tNanos).toDouble() / (b.tNanos - a.tNanos)
+            return Pair(a.x + f * (b.x - a.x), a.y + f * (b.y - a.y))
+        }
+        return null
+    }
+
+    /** 표시 위치 목록과 shiftMs 뒤 실제 위치의 RMS 거리 */
+    private fun rmsError(trace: List<Sample>, shown: List<Sample>, shiftMs: Double): Double {
+        var sum = 0.0
+        var n = 0
+        for (s in shown) {
+            val truth = positionAt(trace, s.tNanos + (shiftMs * 1_000_000).toLong()) ?: continue
+            val dx = s.x - truth.first
+            val dy = s.y - truth.second
+            sum += dx * dx + dy * dy
+            n++
+        }
+        return if (n == 0) 0.0 else sqrt(sum / n)
+    }
+
+    private fun replay(trace: List<Sample>, horizonMs: Float): ReplayResult {
+        val predictor = MotionPredictor()
+        predictor.reset(horizonMs)
+        val shown = ArrayList<Sample>(trace.size)
+        for (s in trace) {
+            predictor.observe(s.x, s.y, s.tNanos)
+            predictor.update()
+            shown.add(Sample(s.tNanos, s.x + predictor.offsetX, s.y + predictor.offsetY))
+        }
+
+        // 표시 위치와 가장 잘 맞는 시간 이동량 (0.25ms 단위 탐색)
+        var bestShift = 0.0
+        var bestError = Double.MAX_VALUE
+        var shift = 0.0
+        while (shift <= horizonMs * 2) {
+            val e = rmsError(trace, shown, shift)
+            if (e < bestError) {
+                bestError = e
+                bestShift = shift
+            }
+            shift += 0.25
+        }
+
+        return ReplayResult(
+            baselineErrorPx = rmsError(trace, trace, horizonMs.toDouble()),
+            predictedErrorPx = rmsError(trace, shown, horizonMs.toDouble()),
+            latencySavedMs = bestShift
+        )
+    }
+
+    /** CursorMotionProcessor로 트레이스 재생 후 총 출력 카운트 (릴리즈 시 예측 회수 포함) */
+    private fun totalCounts(trace: List<Sample>, horizonMs: Float): Pair<Int, Int> {
+        val processor = CursorMotionProcessor()
+        val first = trace.first()
+        processor.begin(
+            first.x, first.y,
+            CursorGestureConfig(
+                deadZonePx = 0f,
+                rightAngle = false,
+                rightAngleLockDistPx = 0f,
+                rightAngleDeadbandDeg = 0f,
+                dpiMultiplier = 1f,
+                predictionHorizonMs = horizonMs
+            )
+        )
+        var sumX = 0
+        var sumY = 0
+        fun drain() {
+            while (processor.hasPendingCounts()) {
+                processor.takeCounts()
+                sumX += processor.countX
+                sumY += processor.countY
+            }
+        }
+        for (i in 1 until trace.size) {
+            val prev = trace[i - 1]
+            val cur = trace[i]
+            processor.onSample(prev.x, prev.y, cur.x, cur.y, cur.tNanos)
+            drain()
+        }
+        processor.retractPrediction()
+        drain()
+        return Pair(sumX, sumY)
+    }
+
+    /**
+     * Test: 모든 트레이스에서 예측이 horizon 뒤 위치 오차를 줄이고 지연을 절감
+     */
+    @Test
+    fun testPredictionReducesErrorOnRecordedTraces() {
+        for (horizonMs in HORIZONS_MS) {
+            println("horizon ${horizonMs}ms")
+            println("%-16s %10s %10s %10s".format("trace", "base(px)", "pred(px)", "saved(ms)"))
+            for (name in TRACES) {
+                val result = replay(loadTrace(name), horizonMs)
+                println(
+                    "%-16s %10.2f %10.2f %10.2f".format(
+                        name, result.baselineErrorPx, result.predictedErrorPx, result.latencySavedMs
+                    )
+                )
+                assertTrue(
+                    "$name: prediction error must be well below baseline",
+                    result.predictedErrorPx < result.baselineErrorPx * MAX_ERROR_RATIO
+                )
+                assertTrue(
+                    "$name: must recover at least half the horizon",
+                    result.latencySavedMs >= horizonMs * MIN_SAVED_RATIO
+                )
+            }
+        }
+    }
+
+    /**
+     * Test: 예측을 켜도 제스처 종료 후 총 이동량은 같음 (순 드리프트 없음)
+     */
+    @Test
+    fun testPredictionHasNoNetDrift() {
+        for (name in TRACES) {
+            val trace = loadTrace(name)
+            val plain = totalCounts(trace, 0f)
+            val predicted = totalCounts(trace, MotionPredictor.MAX_HORIZON_MS)
+            assertTrue("$name: x drift ${predicted.first - plain.first}", abs(predicted.first - plain.first) <= 1)
+            assertTrue("$name: y drift ${predicted.second - plain.second}", abs(predicted.second - plain.second) <= 1)
+        }
+    }
+
+    /**
+     * Test: 측정 지연 → 예측 구간 변환 (측정값 없으면 기본값, 상한 적용)
+     */
+    @Test
+    fun testHorizonForLatency() {
+        assertEquals(MotionPredictor.DEFAULT_HORIZON_MS, MotionPredictor.horizonForLatency(0), 0f)
+        assertEquals(6.5f, MotionPredictor.horizonForLatency(6_500), 0.001f)
+        assertEquals(MotionPredictor.MAX_HORIZON_MS, MotionPredictor.horizonForLatency(80_000), 0f)
+    }
+
+    private companion object {
+        val TRACES = listOf("flick.csv", "slow_drag.csv", "circle.csv", "stop_and_go.csv")
+        val HORIZONS_MS = listOf(4f, 8f)
+        const val MAX_ERROR_RATIO = 0.6
+        const val MIN_SAVED_RATIO = 0.5
+    }
+}
@@ -0,0 +1,133 @@
+package com.bridgeone.app.protocol
+
+import org.junit.Assert.*
+import org.junit.Assume.assumeTrue
+import org.junit.Before
+import org.junit.Test
+import java.lang.management.ManagementFactory
+
+/**
+ * Unit tests for FrameRing and the allocation-free FrameBuilder.writeFrame() path
+ *
+ * Verifies FIFO order, overwrite-oldest policy, sequence continuity with buildFrame(),
+ * and zero heap allocation per frame in steady state.
+ */
+class FrameRingTest {
+
+    @Before
+    fun setUp() {
+        FrameBuilder.resetSequence()
+    }
+
+    /**
+     * Test: Frames come out in FIFO order with the same layout as toByteArray()
+     */
+    @Test
+    fun testFifoOrderAndLayout() {
+        val ring = FrameRing(4)
+        val a = BridgeFrame(1u, 0x01u, 10, -5, 0, 0u, 0u, 0u)
+        val b = BridgeFrame(2u, 0x00u, -1, 1, 3, 0x02u, 0x04u, 0x05u)
+        a.writeTo(ring)
+        b.writeTo(ring)
+
+        val dest = ByteArray(FrameRing.FRAME_SIZE)
+        assertTrue(ring.poll(dest))
+        assertArrayEquals(a.toByteArray(), dest)
+        assertTrue(ring.poll(dest))
+        assertArrayEquals(b.toByteArray(), dest)
+        assertFalse("ring should be empty", ring.poll(dest))
+    }
+
+    /**
+     * Test: When full, the oldest frame is overwritten and counted as dropped
+     */
+    @Test
+    fun testOverwriteOldestWhenFull() {
+        val ring = FrameRing(3)
+        for (i in 0 until 5) {
+            FrameBuilder.writeFrame(ring, 0x00u, i.toByte(), 0, 0)
+        }
+
+        assertEquals(3, ring.size)
+        assertEquals(2L, ring.droppedCount)
+
+        val dest = ByteArray(FrameRing.FRAME_SIZE)
+        for (expected in 2 until 5) {
+            assertTrue(ring.poll(dest))
+            assertEquals("deltaX of oldest surviving frame", expected.toByte(), dest[2])
+        }
+    }
+
+    /**
+     * Test: writeFrame() shares the sequence counter with buildFrame()
+     */
+    @Test
+    fun testSequenceContinuesAcrossPaths() {
+        val ring = FrameRing()
+        val first = FrameBuilder.buildFrame(0x00u, 0, 0, 0, 0u, 0u, 0u)
+        FrameBuilder.writeFrame(ring, 0x01u, 1, 1, 0)
+        val third = FrameBuilder.buildFrame(0x00u, 0, 0, 0, 0u, 0u, 0u)
+
+        val dest = ByteArray(FrameRing.FRAME_SIZE)
+        assertTrue(ring.poll(dest))
+        assertEquals(0.toUByte(), first.seq)
+        assertEquals(1.toByte(), dest[0])
+        assertEquals(2.toUByte(), third.seq)
+    }
+
+    /**
+     * Test: take() blocks until a producer thread puts a frame
+     */
+    @Test
+    fun testTakeWaitsForProducer() {
+        val ring = FrameRing()
+        val producer = Thread {
+            Thread.sleep(20)
+            FrameBuilder.writeFrame(ring, 0x01u, 7, 0, 0)
+        }
+        producer.start()
+
+        val dest = ByteArray(FrameRing.FRAME_SIZE)
+        ring.take(dest)
+        producer.join()
+        assertEquals(7.toByte(), dest[2])
+    }
+
+    /**
+     * Test: Steady-state encode + dequeue allocates nothing per frame
+     *
+     * Uses the HotSpot per-thread allocation counter; skipped on JVMs without it.
+     */
+    @Test
+    fun testZeroAllocationPerFrame() {
+        val threadBean = ManagementFactory.getThreadMXBean() as? com.sun.management.ThreadMXBean
+        assumeTrue(threadBean != null && threadBean.isThreadAllocatedMemorySupported)
+        threadBean!!.isThreadAllocatedMemoryEnabled = true
+
+        val ring = FrameRing()
+        val dest = ByteArray(FrameRing.FRAME_SIZE)
+        val threadId = Thread.currentThread().id
+
+        fun runFrames(n: Int) {
+            for (i in 0 until n) {
+                FrameBuilder.writeFrame(ring, 0x00u, (i and 0x3F).toByte(), (-i and 0x3F).toByte(), 0)
+                ring.poll(dest)
+            }
+        }
+
+        // JIT/클래스 로딩 워밍업
+        runFrames(FRAMES)
+
+        val before = threadBean.getThreadAllocatedBytes(threadId)
+        runFrames(FRAMES)
+        val allocated = threadBean.getThreadAllocatedBytes(threadId) - before
+
+        // 측정 호출 자체의 소량 할당만 허용 (프레임당 8바이트만 할당해도 800KB)
+        assertTrue("allocated $allocated bytes for $FRAMES frames", allocated < ALLOCATION_SLACK_BYTES)
+    }
+
+    private companion object {
+        const val FRAMES = 100_000
+        const val ALLOCATION_SLACK_BYTES = 1024L
+    }
+}
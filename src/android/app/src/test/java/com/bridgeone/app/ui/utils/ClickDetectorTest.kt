@@ -198,5 +198,26 @@ class ClickDetectorTest {
         assertEquals("keyCode1 should be 0 (key release)", 0u.toUByte(), frame.keyCode1)
         assertTrue("LEFT_SHIFT should still be active", frame.isShiftModifierActive())
     }
-}
 
+    /**
+     * Test: 휠 플래그 인코딩 (ESP32 BRIDGE_FLAG_HWHEEL / BRIDGE_FLAG_HIRES_WHEEL)
+     *
+     * Verifies: 고해상도/수평 휠 프레임은 버튼 비트(0x07)를 건드리지 않고 플래그 비트만 설정
+     * Expected: 수직 고해상도 = 0x10, 수평 고해상도 = 0x18, 수평 디텐트 = 0x08
+     */
+    @Test
+    fun testWheelFlagEncoding() {
+        val vertical = ClickDetector.createHiResWheelFrame(30, horizontal = false)
+        assertEquals("vertical hi-res flags", 0x10.toUByte(), vertical.buttons)
+        assertEquals("wheel units", 30.toByte(), vertical.wheel)
+        assertFalse("no mouse button", vertical.isLeftClickPressed())
+
+        val horizontal = ClickDetector.createHiResWheelFrame(-15, horizontal = true)
+        assertEquals("horizontal hi-res flags", 0x18.toUByte(), horizontal.buttons)
+        assertEquals("wheel units", (-15).toByte(), horizontal.wheel)
+
+        val detent = ClickDetector.createHorizontalWheelFrame(1)
+        assertEquals("horizontal detent flag", 0x08.toUByte(), detent.buttons)
+        assertEquals("flags outside button mask", 0.toUByte(), detent.buttons and 0x07.toUByte())
+    }
+}
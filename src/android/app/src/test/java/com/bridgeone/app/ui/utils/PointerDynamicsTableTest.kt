@@ -0,0 +1,94 @@
+package com.bridgeone.app.ui.utils
+
+import com.bridgeone.app.ui.common.DYNAMICS_PRESETS
+import com.bridgeone.app.ui.components.touchpad.DynamicsAlgorithm
+import org.junit.Assert.*
+import org.junit.Test
+import java.io.File
+import kotlin.math.abs
+import kotlin.math.roundToLong
+
+/**
+ * 펌웨어 포인터 다이나믹스 Q16 테이블(pointer_dynamics_table.h)과
+ * DeltaCalculator.applyPointerDynamics() 기준 곡선의 일치 검증
+ *
+ * 가속은 ESP32-S3에서 수행되므로, 프리셋 곡선을 바꾸고 펌웨어 테이블을
+ * 다시 생성하지 않으면 이 테스트가 실패합니다.
+ * 보간/누산기 동작은 펌웨어 호스트 테스트(src/board/BridgeOne/test/host)에서 검증합니다.
+ */
+class PointerDynamicsTableTest {
+
+    private val header: String by lazy {
+        val candidates = listOf(
+            "../../board/BridgeOne/main/pointer_dynamics_table.h",   // app 모듈 기준 (Gradle 기본)
+            "../board/BridgeOne/main/pointer_dynamics_table.h",      // src/android 기준
+        )
+        val file = candidates.map { File(it) }.firstOrNull { it.isFile }
+        assertNotNull("pointer_dynamics_table.h not found from ${File(".").absolutePath}", file)
+        file!!.readText()
+    }
+
+    private fun lut(name: String): List<Long> {
+        val match = Regex("""POINTER_DYNAMICS_LUT_$name\[[^\]]*\]\s*=\s*\{([^}]*)\}""").find(header)
+        assertNotNull("LUT for $name missing", match)
+        return Regex("""(\d+)u""").findAll(match!!.groupValues[1]).map { it.groupValues[1].toLong() }.toList()
+    }
+
+    private fun thresholdQ16(name: String): Long {
+        val match = Regex("""#define\s+POINTER_DYNAMICS_THRESHOLD_Q16_$name\s+(\d+)u""").find(header)
+        assertNotNull("threshold for $name missing", match)
+        return match!!.groupValues[1].toLong()
+    }
+
+    private fun defineValue(name: String): Int {
+        val match = Regex("""#define\s+$name\s+(\d+)""").find(header)
+        assertNotNull("$name missing", match)
+        return match!!.groupValues[1].toInt()
+    }
+
+    /**
+     * Test: 펌웨어 프리셋 ID(인덱스)가 Android 프리셋 목록 전체를 포함
+     */
+    @Test
+    fun testEveryAcceleratedPresetHasFirmwareTable() {
+        assertEquals("index 0 must be Off", DynamicsAlgorithm.NONE, DYNAMICS_PRESETS[0].algorithm)
+        DYNAMICS_PRESETS.drop(1).forEach { preset ->
+            assertNotEquals("only index 0 may be NONE", DynamicsAlgorithm.NONE, preset.algorithm)
+            assertEquals(
+                "${preset.name} LUT size",
+                defineValue("POINTER_DYNAMICS_LUT_SIZE"),
+                lut(preset.name.uppercase()).size
+            )
+        }
+    }
+
+    /**
+     * Test: 임계 속도 일치 (Q16)
+     */
+    @Test
+    fun testThresholdsMatch() {
+        DYNAMICS_PRESETS.drop(1).forEach { preset ->
+            val expected = (preset.velocityThresholdDpMs * 65536.0).roundToLong()
+            val actual = thresholdQ16(preset.name.uppercase())
+            assertTrue("${preset.name} threshold: expected=$expected actual=$actual", abs(expected - actual) <= 1)
+        }
+    }
+
+    /**
+     * Test: 모든 격자점에서 펌웨어 배율 = Kotlin 곡선 배율 (±2 LSB)
+     */
+    @Test
+    fun testTableMatchesKotlinCurve() {
+        val stepsPerDpMs = defineValue("POINTER_DYNAMICS_LUT_STEPS_PER_DP_MS")
+        DYNAMICS_PRESETS.drop(1).forEach { preset ->
+            lut(preset.name.uppercase()).forEachIndexed { index, q16 ->
+                val velocity = index / stepsPerDpMs.toFloat()
+                val expected = (DeltaCalculator.applyPointerDynamics(1f, velocity, preset) * 65536.0).roundToLong()
+                assertTrue(
+                    "${preset.name} v=$velocity: kotlin=$expected firmware=$q16",
+                    abs(expected - q16) <= 2
+                )
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+package com.bridgeone.app.usb
+
+import org.junit.Assert.*
+import org.junit.Test
+
+/**
+ * Unit tests for LatencyHistogram and FrameLatencyTracker
+ *
+ * Verifies bucket boundaries, percentile selection, rolling-window eviction,
+ * per-stage attribution and CSV export.
+ */
+class FrameLatencyStatsTest {
+
+    private fun micros(us: Long) = us * 1000
+
+    /**
+     * Test: Bucket resolution is 10µs below 1ms, 100µs below 10ms, 1ms below 100ms
+     */
+    @Test
+    fun testBucketUpperBounds() {
+        fun upper(us: Long) = LatencyHistogram.bucketUpperMicros(LatencyHistogram.bucketOf(us))
+
+        assertEquals(10L, upper(0))
+        assertEquals(130L, upper(123))
+        assertEquals(1_100L, upper(1_000))
+        assertEquals(2_600L, upper(2_550))
+        assertEquals(43_000L, upper(42_100))
+        assertEquals(LatencyHistogram.OVERFLOW_MICROS, upper(250_000))
+        assertEquals("negative clamps to first bucket", 10L, upper(-5))
+    }
+
+    /**
+     * Test: p50/p95/p99 pick the expected buckets from a uniform distribution
+     */
+    @Test
+    fun testPercentiles() {
+        val histogram = LatencyHistogram(windowSize = 100)
+        for (i in 1..100) histogram.record(micros(i * 100L))   // 0.1ms ~ 10ms
+
+        assertEquals(100, histogram.count)
+        assertEquals(5_100L, histogram.percentileMicros(0.50))
+        assertEquals(9_600L, histogram.percentileMicros(0.95))
+        assertEquals(10_000L, histogram.percentileMicros(0.99))
+    }
+
+    /**
+     * Test: Only the latest windowSize samples contribute
+     */
+    @Test
+    fun testRollingWindowEvictsOldSamples() {
+        val histogram = LatencyHistogram(windowSize = 4)
+        repeat(4) { histogram.record(micros(50_000)) }
+        repeat(4) { histogram.record(micros(200)) }
+
+        assertEquals(4, histogram.count)
+        assertEquals("old 50ms samples evicted", 210L, histogram.percentileMicros(0.99))
+    }
+
+    /**
+     * Test: Frames without a touch source only feed enqueue→write
+     */
+    @Test
+    fun testTrackerStageAttribution() {
+        val tracker = FrameLatencyTracker(windowSize = 16)
+        tracker.recordFrame(
+            sourceNanos = micros(1_000),
+            processedNanos = micros(1_500),
+            enqueueNanos = micros(2_000),
+            writtenNanos = micros(2_300)
+        )
+        tracker.recordFrame(sourceNanos = 0, processedNanos = 0, enqueueNanos = micros(5_000), writtenNanos = micros(5_100))
+        tracker.recordMerged(3)
+
+        val snapshot = tracker.snapshot(droppedFrames = 2)
+        assertEquals(2L, snapshot.framesWritten)
+        assertEquals(3L, snapshot.mergedSamples)
+        assertEquals(2L, snapshot.droppedFrames)
+        assertEquals(1, snapshot.stages.getValue(LatencyStage.TOUCH_TO_WIRE).count)
+        assertEquals(2, snapshot.stages.getValue(LatencyStage.ENQUEUE_TO_WRITE).count)
+        assertEquals(1_400L, snapshot.stages.getValue(LatencyStage.TOUCH_TO_WIRE).p50Us)
+        assertEquals(510L, snapshot.stages.getValue(LatencyStage.TOUCH_TO_DELTA).p50Us)
+    }
+
+    /**
+     * Test: CSV has a header, one row per stage and the counter rows
+     */
+    @Test
+    fun testCsvExport() {
+        val tracker = FrameLatencyTracker()
+        tracker.recordFrame(micros(0), micros(100), micros(200), micros(300))
+        val lines = tracker.snapshot(droppedFrames = 0).toCsv().trim().lines()
+
+        assertEquals("stage,p50_us,p95_us,p99_us,count", lines.first())
+        assertEquals(1 + LatencyStage.entries.size + 3, lines.size)
+        assertTrue(lines.any { it.startsWith("TOUCH_TO_WIRE,") })
+        assertTrue(lines.contains("frames_written,,,,1"))
+    }
+}
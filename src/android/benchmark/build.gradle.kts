@@ -0,0 +1,132 @@
+import groovy.json.JsonSlurper
+import java.util.Properties
+
+/**
+ * JVM 마이크로벤치마크 (JMH) - Android 프로토콜/다이나믹스 핫패스
+ *
+ * Android 프레임워크에 의존하지 않는 app 모듈 소스를 그대로 컴파일하여 일반 Linux JVM에서 측정합니다.
+ * Compose 타입(Offset, Density, ImageVector)은 Compose Multiplatform 데스크톱 아티팩트로 대체합니다.
+ *
+ * 실행:
+ *   ./gradlew :benchmark:jmh                    전체 측정 (ns/op + gc 프로파일러 B/op)
+ *   ./gradlew :benchmark:jmh -PjmhInclude=Frame 이름 필터
+ *   ./gradlew :benchmark:jmhGate                측정 후 게이트 검사
+ *   ./gradlew :benchmark:jmhGate -PjmhBaseline=<이전 results.json> [-PjmhTolerance=0.15]
+ *
+ * 게이트:
+ * - alloc-budget.properties: 벤치마크별 허용 할당량 (B/op, gc.alloc.rate.norm) - 초과 시 실패
+ * - jmhBaseline 지정 시: 기준 대비 ns/op가 jmhTolerance(기본 15%) 이상 느려지면 실패
+ */
+plugins {
+    alias(libs.plugins.kotlin.jvm)
+    alias(libs.plugins.kotlin.compose)
+    alias(libs.plugins.jmh)
+}
+
+kotlin {
+    jvmToolchain(17)
+}
+
+// 벤치마크 대상: app 모듈 소스 중 Android API를 쓰지 않는 파일만 포함
+val appSources = rootProject.file("app/src/main/java")
+sourceSets {
+    main {
+        kotlin {
+            srcDir(appSources)
+            include(
+                "com/bridgeone/app/protocol/**",
+                "com/bridgeone/app/ui/utils/DeltaCalculator.kt",
+                "com/bridgeone/app/ui/components/touchpad/TouchpadMode.kt",
+                "com/bridgeone/app/ui/common/AppIcons.kt",
+                "com/bridgeone/app/ui/common/PointerDynamicsConstants.kt"
+            )
+        }
+    }
+}
+
+dependencies {
+    implementation(libs.compose.desktop.ui)
+    implementation(libs.compose.desktop.material3)
+    implementation(libs.compose.desktop.material.icons.extended)
+}
+
+jmh {
+    jmhVersion.set(libs.versions.jmh)
+    benchmarkMode.set(listOf("avgt"))
+    timeUnit.set("ns")
+    warmupIterations.set(3)
+    iterations.set(5)
+    fork.set(1)
+    profilers.set(listOf("gc"))
+    resultFormat.set("JSON")
+    providers.gradleProperty("jmhInclude").orNull?.let { includes.set(listOf(it)) }
+}
+
+tasks.register("jmhGate") {
+    group = "verification"
+    description = "JMH 결과를 할당 예산/기준 ns/op와 비교하여 핫패스 회귀 시 실패합니다."
+    dependsOn("jmh")
+
+    val resultsFile = layout.buildDirectory.file("results/jmh/results.json")
+    val budgetFile = file("alloc-budget.properties")
+    val baselinePath = providers.gradleProperty("jmhBaseline")
+    val tolerance = providers.gradleProperty("jmhTolerance").map { it.toDouble() }.orElse(0.15)
+    inputs.file(budgetFile)
+
+    doLast {
+        // 결과 키: 벤치마크 이름 + @Param 값 (예: DeltaCalculatorBenchmark.applyPointerDynamics{presetIndex=2})
+        @Suppress("UNCHECKED_CAST")
+        fun loadResults(f: File): Map<String, Map<String, Any>> =
+            (JsonSlurper().parse(f) as List<Map<String, Any>>).associateBy { result ->
+                val name = (result["benchmark"] as String).split('.').takeLast(2).joinToString(".")
+                val params = result["params"] as? Map<String, Any>
+                if (params.isNullOrEmpty()) name else name + params.toSortedMap().toString()
+            }
+
+        fun shortName(key: String) = key.substringBefore('{')
+
+        @Suppress("UNCHECKED_CAST")
+        fun allocBytes(result: Map<String, Any>): Double? {
+            val secondary = result["secondaryMetrics"] as? Map<String, Map<String, Any>> ?: return null
+            // JMH 버전에 따라 키가 "·gc.alloc.rate.norm" 또는 "gc.alloc.rate.norm"
+            val entry = secondary.entries.firstOrNull { it.key.endsWith("gc.alloc.rate.norm") } ?: return null
+            return (entry.value["score"] as Number).toDouble()
+        }
+
+        @Suppress("UNCHECKED_CAST")
+        fun score(result: Map<String, Any>): Double =
+            ((result["primaryMetric"] as Map<String, Any>)["score"] as Number).toDouble()
+
+        val results = loadResults(resultsFile.get().asFile)
+        val budgets = Properties().apply { budgetFile.inputStream().use { load(it) } }
+        val failures = mutableListOf<String>()
+
+        for ((key, result) in results) {
+            val name = shortName(key)
+            val budget = budgets.getProperty(name)?.toDouble() ?: continue
+            val bytes = allocBytes(result) ?: continue
+            // gc 프로파일러 측정 잡음 (TLAB 경계) 허용: 0.5 B/op
+            if (bytes > budget + 0.5) {
+                failures += "$key allocates %.1f B/op (budget %.0f)".format(bytes, budget)
+            }
+        }
+
+        baselinePath.orNull?.let { path ->
+            val baseline = loadResults(File(path))
+            for ((key, result) in results) {
+                val before = baseline[key]?.let(::score) ?: continue
+                val after = score(result)
+                if (after > before * (1 + tolerance.get())) {
+                    failures += "$key %.1f → %.1f ns/op (+%.0f%%)".format(
+                        before, after, (after / before - 1) * 100
+                    )
+                }
+            }
+        }
+
+        if (failures.isNotEmpty()) {
+            throw GradleException("Benchmark gate failed:\n  " + failures.joinToString("\n  "))
+        }
+        logger.lifecycle("Benchmark gate passed (${results.size} benchmarks)")
+    }
+}
@@ -0,0 +1,62 @@
+package com.bridgeone.app.benchmark
+
+import androidx.compose.ui.geometry.Offset
+import androidx.compose.ui.unit.Density
+import com.bridgeone.app.ui.common.DYNAMICS_PRESETS
+import com.bridgeone.app.ui.components.touchpad.PointerDynamicsPreset
+import com.bridgeone.app.ui.utils.DeltaCalculator
+import org.openjdk.jmh.annotations.Benchmark
+import org.openjdk.jmh.annotations.OutputTimeUnit
+import org.openjdk.jmh.annotations.Param
+import org.openjdk.jmh.annotations.Scope
+import org.openjdk.jmh.annotations.Setup
+import org.openjdk.jmh.annotations.State
+import org.openjdk.jmh.infra.Blackhole
+import java.util.concurrent.TimeUnit
+
+/**
+ * 델타 계산 / 포인터 다이나믹스 벤치마크
+ *
+ * Offset은 Long으로 패킹된 value class이므로 결과를 그대로 반환하면 박싱이 측정에 섞입니다.
+ * 결과는 x/y Float로 나누어 Blackhole에 넘깁니다.
+ */
+@State(Scope.Thread)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+open class DeltaCalculatorBenchmark {
+
+    /** DYNAMICS_PRESETS 인덱스 (0 = Off, 1~ = 가속 곡선) */
+    @Param("0", "1", "2", "3")
+    var presetIndex: Int = 0
+
+    private lateinit var density: Density
+    private lateinit var preset: PointerDynamicsPreset
+    private var x = 0f
+    private var velocity = 0f
+
+    @Setup
+    fun setUp() {
+        density = Density(2.75f)   // 일반적인 FHD+ 폰 밀도
+        preset = DYNAMICS_PRESETS[presetIndex.coerceAtMost(DYNAMICS_PRESETS.lastIndex)]
+    }
+
+    @Benchmark
+    fun calculateAndCompensate(bh: Blackhole) {
+        x += 0.37f
+        if (x > 100f) x = 0f
+        val delta = DeltaCalculator.calculateAndCompensate(
+            density,
+            Offset(x, 200f),
+            Offset(x + 12.5f, 193f)
+        )
+        bh.consume(delta.x)
+        bh.consume(delta.y)
+    }
+
+    @Benchmark
+    fun applyPointerDynamics(): Float {
+        // 임계값 전후를 고르게 지나도록 속도를 순환 (0 ~ 3 dp/ms)
+        velocity += 0.013f
+        if (velocity > 3f) velocity = 0f
+        return DeltaCalculator.applyPointerDynamics(7.5f, velocity, preset)
+    }
+}
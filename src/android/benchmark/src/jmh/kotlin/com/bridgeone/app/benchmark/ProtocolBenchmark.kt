@@ -0,0 +1,69 @@
+package com.bridgeone.app.benchmark
+
+import com.bridgeone.app.protocol.BridgeFrame
+import com.bridgeone.app.protocol.FrameBuilder
+import com.bridgeone.app.protocol.FrameRing
+import com.bridgeone.app.protocol.NotificationFrame
+import org.openjdk.jmh.annotations.Benchmark
+import org.openjdk.jmh.annotations.OutputTimeUnit
+import org.openjdk.jmh.annotations.Scope
+import org.openjdk.jmh.annotations.Setup
+import org.openjdk.jmh.annotations.State
+import org.openjdk.jmh.annotations.Threads
+import org.openjdk.jmh.infra.Blackhole
+import java.util.concurrent.TimeUnit
+
+/**
+ * 프로토콜 프레임 생성/직렬화/파싱 벤치마크
+ *
+ * 터치 샘플마다 호출되는 경로:
+ * - FrameBuilder.buildFrame (AtomicInteger CAS 시퀀스 카운터 + BridgeFrame 할당)
+ * - BridgeFrame.toByteArray (8바이트 배열 할당)
+ * - FrameBuilder.writeFrame + FrameRing.poll (할당 없는 전송 경로, 0 B/op 기대)
+ * - NotificationFrame.parse (수신 스레드)
+ */
+@State(Scope.Thread)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+open class ProtocolBenchmark {
+
+    private lateinit var frame: BridgeFrame
+    private lateinit var notification: ByteArray
+    private lateinit var ring: FrameRing
+    private lateinit var dest: ByteArray
+    private var delta: Byte = 0
+
+    @Setup
+    fun setUp() {
+        frame = BridgeFrame(1u, 0x01u, 10, -5, 0, 0u, 0u, 0u)
+        notification = byteArrayOf(0xFE.toByte(), 0x01, 0x01, 0, 0, 0, 0, 0)
+        ring = FrameRing()
+        dest = ByteArray(FrameRing.FRAME_SIZE)
+    }
+
+    @Benchmark
+    fun buildFrame(): BridgeFrame {
+        delta++
+        return FrameBuilder.buildFrame(0x00u, delta, (-delta).toByte(), 0, 0u, 0u, 0u)
+    }
+
+    /** 입력 스레드 + UI 스레드 + 폴링 스레드가 동시에 프레임을 만드는 경우 (CAS 경합) */
+    @Benchmark
+    @Threads(4)
+    fun buildFrameContended(): BridgeFrame {
+        delta++
+        return FrameBuilder.buildFrame(0x00u, delta, (-delta).toByte(), 0, 0u, 0u, 0u)
+    }
+
+    @Benchmark
+    fun toByteArray(): ByteArray = frame.toByteArray()
+
+    @Benchmark
+    fun writeFrameAndPoll(bh: Blackhole) {
+        delta++
+        FrameBuilder.writeFrame(ring, 0x00u, delta, (-delta).toByte(), 0)
+        bh.consume(ring.poll(dest))
+    }
+
+    @Benchmark
+    fun parseNotification(): NotificationFrame? = NotificationFrame.parse(notification)
+}
@@ -22,3 +22,4 @@ dependencyResolutionManagement {
 
 rootProject.name = "BridgeOne"
 include(":app")
+include(":benchmark")
@@ -239,6 +239,35 @@ bool tud_cdc_n_peek(uint8_t itf, uint8_t* chr) {
   return tu_fifo_peek(&_cdcd_itf[itf].rx_ff, chr);
 }
 
+uint32_t tud_cdc_n_read_regions(uint8_t itf, tu_fifo_buffer_info_t* info) {
+  tu_fifo_get_read_info(&_cdcd_itf[itf].rx_ff, info);
+  return (uint32_t) info->len_lin + info->len_wrap;
+}
+
+uint32_t tud_cdc_n_read_advance(uint8_t itf, uint32_t count) {
+  cdcd_interface_t* p_cdc = &_cdcd_itf[itf];
+
+  #if OSAL_MUTEX_REQUIRED
+  if (p_cdc->rx_ff.mutex_rd) {
+    osal_mutex_lock(p_cdc->rx_ff.mutex_rd, OSAL_TIMEOUT_WAIT_FOREVER);
+  }
+  #endif
+
+  uint16_t const n = (uint16_t) TU_MIN(count, tu_fifo_count(&p_cdc->rx_ff));
+  if (n) {
+    tu_fifo_advance_read_pointer(&p_cdc->rx_ff, n);
+  }
+
+  #if OSAL_MUTEX_REQUIRED
+  if (p_cdc->rx_ff.mutex_rd) {
+    osal_mutex_unlock(p_cdc->rx_ff.mutex_rd);
+  }
+  #endif
+
+  _prep_out_transaction(itf);
+  return n;
+}
+
 void tud_cdc_n_read_flush(uint8_t itf) {
   cdcd_interface_t* p_cdc = &_cdcd_itf[itf];
   tu_fifo_clear(&p_cdc->rx_ff);
@@ -248,9 +277,8 @@ void tud_cdc_n_read_flush(uint8_t itf) {
 //--------------------------------------------------------------------+
 // WRITE API
 //--------------------------------------------------------------------+
-uint32_t tud_cdc_n_write(uint8_t itf, const void* buffer, uint32_t bufsize) {
+static void _write_flush_if_packet(uint8_t itf) {
   cdcd_interface_t* p_cdc = &_cdcd_itf[itf];
-  uint16_t wr_count = tu_fifo_write_n(&p_cdc->tx_ff, buffer, (uint16_t) TU_MIN(bufsize, UINT16_MAX));
 
   // flush if queue more than packet size
   if (tu_fifo_count(&p_cdc->tx_ff) >= BULK_PACKET_SIZE
@@ -260,10 +288,63 @@ uint32_t tud_cdc_n_write(uint8_t itf, const void* buffer, uint32_t bufsize) {
       ) {
     tud_cdc_n_write_flush(itf);
   }
+}
+
+uint32_t tud_cdc_n_write(uint8_t itf, const void* buffer, uint32_t bufsize) {
+  cdcd_interface_t* p_cdc = &_cdcd_itf[itf];
+  uint16_t wr_count = tu_fifo_write_n(&p_cdc->tx_ff, buffer, (uint16_t) TU_MIN(bufsize, UINT16_MAX));
+
+  _write_flush_if_packet(itf);
 
   return wr_count;
 }
 
+uint32_t tud_cdc_n_write_reserve(uint8_t itf, uint32_t bufsize, tu_fifo_buffer_info_t* info) {
+  cdcd_interface_t* p_cdc = &_cdcd_itf[itf];
+
+  #if OSAL_MUTEX_REQUIRED
+  // Held until tud_cdc_n_write_commit() so that other writers cannot interleave with the reserved space
+  if (p_cdc->tx_ff.mutex_wr) {
+    osal_mutex_lock(p_cdc->tx_ff.mutex_wr, OSAL_TIMEOUT_WAIT_FOREVER);
+  }
+  #endif
+
+  tu_fifo_get_write_info(&p_cdc->tx_ff, info);
+
+  // Limit regions to the requested size
+  if (info->len_lin >= bufsize) {
+    info->len_lin  = (uint16_t) bufsize;
+    info->len_wrap = 0;
+    info->ptr_wrap = NULL;
+  } else if ((uint32_t) info->len_lin + info->len_wrap > bufsize) {
+    info->len_wrap = (uint16_t) (bufsize - info->len_lin);
+  }
+
+  return (uint32_t) info->len_lin + info->len_wrap;
+}
+
+uint32_t tud_cdc_n_write_commit(uint8_t itf, uint32_t count) {
+  cdcd_interface_t* p_cdc = &_cdcd_itf[itf];
+
+  // Free space can only grow while reserved (reader side advances), never commit more than that
+  uint16_t const n = (uint16_t) TU_MIN(count, tu_fifo_remaining(&p_cdc->tx_ff));
+  if (n) {
+    tu_fifo_advance_write_pointer(&p_cdc->tx_ff, n);
+  }
+
+  #if OSAL_MUTEX_REQUIRED
+  if (p_cdc->tx_ff.mutex_wr) {
+    osal_mutex_unlock(p_cdc->tx_ff.mutex_wr);
+  }
+  #endif
+
+  if (n) {
+    _write_flush_if_packet(itf);
+  }
+
+  return n;
+}
+
 uint32_t tud_cdc_n_write_flush(uint8_t itf) {
   cdcd_interface_t* p_cdc = &_cdcd_itf[itf];
   cdcd_epbuf_t* p_epbuf = &_cdcd_epbuf[itf];
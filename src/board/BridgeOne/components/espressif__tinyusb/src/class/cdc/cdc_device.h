@@ -108,6 +108,14 @@ void tud_cdc_n_read_flush(uint8_t itf);
 // Get a byte from FIFO without removing it
 bool tud_cdc_n_peek(uint8_t itf, uint8_t* ui8);
 
+// Zero-copy read: return received data as a linear region (info->ptr_lin, len_lin) followed by a wrapped
+// region (info->ptr_wrap, len_wrap) without removing it from FIFO. Data stays valid until consumed with
+// tud_cdc_n_read_advance(). Must be used by a single reader only, e.g from tud_cdc_rx_cb()
+uint32_t tud_cdc_n_read_regions(uint8_t itf, tu_fifo_buffer_info_t* info);
+
+// Remove count bytes returned by tud_cdc_n_read_regions() from FIFO, return number of bytes removed
+uint32_t tud_cdc_n_read_advance(uint8_t itf, uint32_t count);
+
 // Write bytes to TX FIFO, data may remain in the FIFO for a while
 uint32_t tud_cdc_n_write(uint8_t itf, void const* buffer, uint32_t bufsize);
 
@@ -121,6 +129,15 @@ TU_ATTR_ALWAYS_INLINE static inline uint32_t tud_cdc_n_write_str(uint8_t itf, ch
   return tud_cdc_n_write(itf, str, strlen(str));
 }
 
+// Zero-copy write: lock TX FIFO and return up to bufsize bytes of free space as a linear region
+// (info->ptr_lin, len_lin) followed by a wrapped region (info->ptr_wrap, len_wrap). Fill the regions in
+// order, then call tud_cdc_n_write_commit() with the number of bytes written. Every reserve must be paired
+// with exactly one commit (count may be 0), and no other write API may be used in between.
+uint32_t tud_cdc_n_write_reserve(uint8_t itf, uint32_t bufsize, tu_fifo_buffer_info_t* info);
+
+// Publish count bytes written into the reserved regions and unlock TX FIFO. Flushes like tud_cdc_n_write()
+uint32_t tud_cdc_n_write_commit(uint8_t itf, uint32_t count);
+
 // Force sending data if possible, return number of forced bytes
 uint32_t tud_cdc_n_write_flush(uint8_t itf);
 
@@ -191,6 +208,14 @@ TU_ATTR_ALWAYS_INLINE static inline bool tud_cdc_peek(uint8_t* ui8) {
   return tud_cdc_n_peek(0, ui8);
 }
 
+TU_ATTR_ALWAYS_INLINE static inline uint32_t tud_cdc_read_regions(tu_fifo_buffer_info_t* info) {
+  return tud_cdc_n_read_regions(0, info);
+}
+
+TU_ATTR_ALWAYS_INLINE static inline uint32_t tud_cdc_read_advance(uint32_t count) {
+  return tud_cdc_n_read_advance(0, count);
+}
+
 TU_ATTR_ALWAYS_INLINE static inline uint32_t tud_cdc_write_char(char ch) {
   return tud_cdc_n_write_char(0, ch);
 }
@@ -203,6 +228,14 @@ TU_ATTR_ALWAYS_INLINE static inline uint32_t tud_cdc_write_str(char const* str)
   return tud_cdc_n_write_str(0, str);
 }
 
+TU_ATTR_ALWAYS_INLINE static inline uint32_t tud_cdc_write_reserve(uint32_t bufsize, tu_fifo_buffer_info_t* info) {
+  return tud_cdc_n_write_reserve(0, bufsize, info);
+}
+
+TU_ATTR_ALWAYS_INLINE static inline uint32_t tud_cdc_write_commit(uint32_t count) {
+  return tud_cdc_n_write_commit(0, count);
+}
+
 TU_ATTR_ALWAYS_INLINE static inline uint32_t tud_cdc_write_flush(void) {
   return tud_cdc_n_write_flush(0);
 }
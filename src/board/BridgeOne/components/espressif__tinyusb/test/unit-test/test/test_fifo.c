@@ -376,3 +376,131 @@ void test_rd_idx_wrap()
   TEST_ASSERT_EQUAL(n, 2);
   TEST_ASSERT_EQUAL(ff10.rd_idx, 6);
 }
+
+void test_get_read_info_advance_partial_when_wrapped()
+{
+  // fill fifo with 0..63, consume 60 then append 64..67: data wraps after 4 items
+  tu_fifo_write_n(ff, test_data, FIFO_SIZE);
+  tu_fifo_read_n(ff, rd_buf, FIFO_SIZE-4);
+  tu_fifo_write_n(ff, test_data+FIFO_SIZE, 4);
+
+  tu_fifo_get_read_info(ff, &info);
+  TEST_ASSERT_EQUAL(4, info.len_lin);
+  TEST_ASSERT_EQUAL(4, info.len_wrap);
+  TEST_ASSERT_EQUAL_MEMORY(test_data+FIFO_SIZE-4, info.ptr_lin, 4);
+  TEST_ASSERT_EQUAL_MEMORY(test_data+FIFO_SIZE, info.ptr_wrap, 4);
+
+  // consume part of linear region only, wrapped region is untouched
+  tu_fifo_advance_read_pointer(ff, 3);
+  tu_fifo_get_read_info(ff, &info);
+
+  TEST_ASSERT_EQUAL(1, info.len_lin);
+  TEST_ASSERT_EQUAL(4, info.len_wrap);
+  TEST_ASSERT_EQUAL_PTR(ff->buffer+FIFO_SIZE-1, info.ptr_lin);
+  TEST_ASSERT_EQUAL_PTR(ff->buffer, info.ptr_wrap);
+  TEST_ASSERT_EQUAL(FIFO_SIZE-1, ((uint8_t const*) info.ptr_lin)[0]);
+}
+
+void test_get_read_info_advance_exact_linear_when_wrapped()
+{
+  tu_fifo_write_n(ff, test_data, FIFO_SIZE);
+  tu_fifo_read_n(ff, rd_buf, FIFO_SIZE-4);
+  tu_fifo_write_n(ff, test_data+FIFO_SIZE, 4);
+
+  tu_fifo_get_read_info(ff, &info);
+
+  // consume exactly the linear region: former wrapped region becomes linear
+  tu_fifo_advance_read_pointer(ff, info.len_lin);
+  tu_fifo_get_read_info(ff, &info);
+
+  TEST_ASSERT_EQUAL(4, info.len_lin);
+  TEST_ASSERT_EQUAL(0, info.len_wrap);
+  TEST_ASSERT_EQUAL_PTR(ff->buffer, info.ptr_lin);
+  TEST_ASSERT_EQUAL_MEMORY(test_data+FIFO_SIZE, info.ptr_lin, 4);
+}
+
+void test_get_read_info_advance_across_wrap()
+{
+  tu_fifo_write_n(ff, test_data, FIFO_SIZE);
+  tu_fifo_read_n(ff, rd_buf, FIFO_SIZE-4);
+  tu_fifo_write_n(ff, test_data+FIFO_SIZE, 4);
+
+  // consume the linear region and part of the wrapped region in one call
+  tu_fifo_advance_read_pointer(ff, 4+1);
+  tu_fifo_get_read_info(ff, &info);
+
+  TEST_ASSERT_EQUAL(3, tu_fifo_count(ff));
+  TEST_ASSERT_EQUAL(3, info.len_lin);
+  TEST_ASSERT_EQUAL(0, info.len_wrap);
+  TEST_ASSERT_EQUAL_PTR(ff->buffer+1, info.ptr_lin);
+  TEST_ASSERT_EQUAL_MEMORY(test_data+FIFO_SIZE+1, info.ptr_lin, 3);
+}
+
+void test_get_read_info_keeps_unconsumed_data()
+{
+  // leave an incomplete record in fifo across the wrap boundary, then append the rest
+  tu_fifo_write_n(ff, test_data, FIFO_SIZE-2);
+  tu_fifo_read_n(ff, rd_buf, FIFO_SIZE-6);
+
+  tu_fifo_get_read_info(ff, &info);
+  TEST_ASSERT_EQUAL(4, info.len_lin);
+  TEST_ASSERT_EQUAL(0, info.len_wrap);
+
+  tu_fifo_advance_read_pointer(ff, 0);
+  tu_fifo_write_n(ff, test_data+FIFO_SIZE-2, 6);
+
+  tu_fifo_get_read_info(ff, &info);
+  TEST_ASSERT_EQUAL_PTR(ff->buffer+FIFO_SIZE-6, info.ptr_lin);
+  TEST_ASSERT_EQUAL(6, info.len_lin);
+  TEST_ASSERT_EQUAL(4, info.len_wrap);
+
+  // regions read in order give back the original stream
+  memcpy(rd_buf, info.ptr_lin, info.len_lin);
+  memcpy(rd_buf+info.len_lin, info.ptr_wrap, info.len_wrap);
+  TEST_ASSERT_EQUAL_MEMORY(test_data+FIFO_SIZE-6, rd_buf, 10);
+}
+
+void test_get_read_info_advance_idx_wrap()
+{
+  tu_fifo_t ff10;
+  uint8_t buf[10];
+
+  tu_fifo_config(&ff10, buf, 10, 1, false);
+
+  // rd_idx close to 2*depth, data wraps both buffer and index
+  ff10.wr_idx = 3;
+  ff10.rd_idx = 17;
+
+  tu_fifo_get_read_info(&ff10, &info);
+  TEST_ASSERT_EQUAL(3, info.len_lin);
+  TEST_ASSERT_EQUAL(3, info.len_wrap);
+  TEST_ASSERT_EQUAL_PTR(buf+7, info.ptr_lin);
+  TEST_ASSERT_EQUAL_PTR(buf, info.ptr_wrap);
+
+  tu_fifo_advance_read_pointer(&ff10, 4);
+  TEST_ASSERT_EQUAL(1, ff10.rd_idx);
+
+  tu_fifo_get_read_info(&ff10, &info);
+  TEST_ASSERT_EQUAL(2, info.len_lin);
+  TEST_ASSERT_EQUAL(0, info.len_wrap);
+  TEST_ASSERT_EQUAL_PTR(buf+1, info.ptr_lin);
+}
+
+void test_get_write_info_advance_when_wrapped()
+{
+  // free space wraps: 4 items at the end, 4 at the beginning
+  tu_fifo_write_n(ff, test_data, FIFO_SIZE-4);
+  tu_fifo_read_n(ff, rd_buf, FIFO_SIZE-4);
+
+  tu_fifo_get_write_info(ff, &info);
+  TEST_ASSERT_EQUAL(4, info.len_lin);
+
+  // fill linear region and part of wrapped region directly, then commit
+  memcpy(info.ptr_lin, test_data+100, 4);
+  memcpy(info.ptr_wrap, test_data+104, 3);
+  tu_fifo_advance_write_pointer(ff, 7);
+
+  TEST_ASSERT_EQUAL(7, tu_fifo_count(ff));
+  TEST_ASSERT_EQUAL(7, tu_fifo_read_n(ff, rd_buf, FIFO_SIZE));
+  TEST_ASSERT_EQUAL_MEMORY(test_data+100, rd_buf, 7);
+}
@@ -13,6 +13,13 @@
 #include "usb_cdc_log.h"  // USB CDC 디버그 로깅
 #include "vendor_cdc_handler.h"  // Vendor CDC 프로토콜 처리
 #include "connection_state.h"    // 연결 상태 머신
+#include "macro_engine.h"        // 펌웨어 매크로 엔진
+#include "scroll_inertia.h"      // 관성 스크롤 생성기
+#include "mem_report.h"          // 힙/스택/정적 RAM 보고서
+#include "mem_alloc.h"           // 명령 처리용 내부 SRAM 아레나
+#include "task_profiler.h"       // 태스크별 CPU/스케줄링 프로파일러
+#include "trace_recorder.h"      // 커널/파이프라인 이벤트 트레이스
+#include "input_trace.h"         // 입력 트레이스 기록/재생
 #include "esp_task_wdt.h"
 
 // ==================== 테스트 모드 설정 ====================
@@ -25,6 +32,8 @@
  * 테스트 내용 (1회 실행):
  * - 마우스 원형 이동
  * - 키보드 "HELLO" 타이핑
+ *
+ * 테스트 입력은 입력 트레이스 재생기로 frame_queue에 주입되어 실제 hid_task를 거칩니다.
  */
 // #define HID_TEST_MODE
 
@@ -45,6 +54,25 @@
 
 static const char* TAG = "BridgeOne";
 
+// ==================== 태스크 스택 크기 ====================
+/**
+ * 태스크 스택 크기 (bytes).
+ *
+ * 실측 여유는 CDC "mem" 명령 또는 VCDC MEM_QUERY의 high-water mark로 확인하고,
+ * 최소 여유가 MEM_BUDGET_STACK_MARGIN 아래로 내려가면 늘립니다.
+ * 줄이는 것은 실기기 high-water 측정값이 있을 때만 합니다.
+ * - VCDC: 4096 유지. 프레임 사본(456B)과 기능 협상 지역 변수(≈1KB)가 스택에서
+ *   빠졌지만 cJSON 파싱 깊이에 따른 사용량은 아직 측정하지 않았습니다.
+ *   "mem" 보고서의 VCDC 최소 여유가 1KB + MEM_BUDGET_STACK_MARGIN 이상으로
+ *   확인되면 3072로 줄입니다.
+ */
+#define USB_TASK_STACK_SIZE       4096
+#define UART_TASK_STACK_SIZE      3072
+#define HID_TASK_STACK_SIZE       3072
+#define VCDC_TASK_STACK_SIZE      4096
+#define HID_TEST_TASK_STACK_SIZE  4096
+#define VMON_TASK_STACK_SIZE      4096
+
 /**
  * @brief USB 디바이스 스택 태스크
  * 
@@ -153,13 +181,20 @@ void app_main(void) {
 
     // ==================== 1.3. Vendor CDC 파서 초기화 ====================
     // CDC 데이터 수신 전에 파서 상태 머신 및 프레임 큐를 초기화합니다.
-    // tud_cdc_rx_cb()에서 vendor_cdc_parser_feed()가 호출되기 전에 완료되어야 합니다.
+    // tud_cdc_rx_cb()에서 수신 파서(vcdc_rx)가 프레임을 넘기기 전에 완료되어야 합니다.
     if (vendor_cdc_parser_init()) {
         ESP_LOGI(TAG, "Vendor CDC parser initialized");
     } else {
         ESP_LOGE(TAG, "Vendor CDC parser init failed");
     }
 
+    // 명령 처리용 내부 SRAM 아레나 확보 + cJSON 할당 훅 설치
+    // 힙 단편화 전에 확보해야 하며, vendor_cdc_task가 cJSON을 쓰기 전에 완료되어야 합니다.
+    // 실패 시 cJSON은 기본 malloc(내부 SRAM 또는 PSRAM)을 사용합니다.
+    if (!mem_alloc_init()) {
+        ESP_LOGE(TAG, "Command arena init failed, cJSON falls back to malloc");
+    }
+
     // ==================== 1.4. 연결 상태 머신 초기화 ====================
     // 핸드셰이크 프로토콜(AUTH, STATE_SYNC)의 상태를 관리합니다.
     // Vendor CDC 파서 초기화 직후, 프레임 처리 태스크 시작 전에 호출해야 합니다.
@@ -196,6 +231,9 @@ void app_main(void) {
     ESP_LOGI(TAG, "VOLTAGE_MONITOR_MODE: All logs remain on UART0");
 #endif
 
+    // UART 수신 태스크(또는 입력 트레이스 재생)가 검증된 프레임을 보내는 큐 크기
+    #define UART_FRAME_QUEUE_SIZE 10
+
     // ==================== 1.5. UART 통신 초기화 ====================
 #if !defined(HID_TEST_MODE) && !defined(VOLTAGE_MONITOR_MODE)
     // 정상 모드: Android와의 UART 통신을 위해 UART 드라이버 초기화
@@ -214,12 +252,12 @@ void app_main(void) {
     // UART 수신 태스크가 검증된 프레임을 이 큐에 전송합니다.
     // - 큐 크기: UART_FRAME_QUEUE_SIZE (최대 10개 프레임 보관)
     // - 각 아이템 크기: sizeof(bridge_frame_t) = 8 바이트
-    #define UART_FRAME_QUEUE_SIZE 10
     frame_queue = xQueueCreate(UART_FRAME_QUEUE_SIZE, sizeof(bridge_frame_t));
     if (frame_queue == NULL) {
         ESP_LOGE(TAG, "Failed to create frame queue");
         return;
     }
+    trace_recorder_register_queue(frame_queue, "frame_queue");
     ESP_LOGI(TAG, "Frame queue created (size=%d, item_size=%u bytes)",
              UART_FRAME_QUEUE_SIZE, sizeof(bridge_frame_t));
 
@@ -231,9 +269,38 @@ void app_main(void) {
     // ==================== 1.8. 모드 전환 콜백 등록 ====================
     // Essential ↔ Standard 모드 전환 시 눌린 키/버튼 자동 해제
     hid_register_mode_callback();
+
+    // ==================== 1.9. 매크로 엔진 초기화 ====================
+    // "macros" 파티션 탐색 및 스텝 실행 타이머 생성
+    // HID 리포트 큐 초기화 이후, UART 태스크(매크로 트리거 수신) 시작 전에 호출해야 합니다.
+    if (!macro_engine_init()) {
+        ESP_LOGE(TAG, "Macro engine init failed");
+    }
+
+    // ==================== 1.10. 관성 스크롤 생성기 초기화 ====================
+    // UART_QUERY_SCROLL_FLING 수신 전에 1ms 주기 타이머를 준비합니다.
+    if (!scroll_inertia_init()) {
+        ESP_LOGE(TAG, "Scroll inertia init failed");
+    }
+
+    // ==================== 1.11. 입력 트레이스 레코더 초기화 ====================
+    // 검증된 프레임과 HID 리포트를 PSRAM 링에 상시 기록 (UART 태스크 시작 전)
+    if (!input_trace_init()) {
+        ESP_LOGE(TAG, "Input trace init failed, recording/replay disabled");
+    }
 #elif defined(HID_TEST_MODE)
-    // HID 테스트 모드: UART 초기화 및 큐 생성 건너뛰기
-    ESP_LOGI(TAG, "HID_TEST_MODE enabled - UART and frame queue skipped");
+    // HID 테스트 모드: UART 초기화 건너뛰기
+    // 테스트 시나리오는 입력 트레이스 재생으로 frame_queue에 주입되어 hid_task가 처리합니다.
+    frame_queue = xQueueCreate(UART_FRAME_QUEUE_SIZE, sizeof(bridge_frame_t));
+    if (frame_queue == NULL) {
+        ESP_LOGE(TAG, "Failed to create frame queue");
+        return;
+    }
+    hid_init_queues();
+    if (!input_trace_init()) {
+        ESP_LOGE(TAG, "Input trace init failed, test scenarios cannot be replayed");
+    }
+    ESP_LOGI(TAG, "HID_TEST_MODE enabled - UART skipped, frames come from trace replay");
 #elif defined(VOLTAGE_MONITOR_MODE)
     // 전압 모니터링 모드: UART 초기화 및 큐 생성 건너뛰기
     ESP_LOGI(TAG, "VOLTAGE_MONITOR_MODE enabled - UART and frame queue skipped");
@@ -256,19 +323,20 @@ void app_main(void) {
     // ==================== 테스트 모드: HID 테스트 태스크 생성 ====================
     ESP_LOGI(TAG, "Creating HID Test Task (TEST MODE)...");
 
-    // HID 테스트 태스크: Android 없이 자체 테스트 데이터 생성
-    // - 우선순위 5: USB 태스크(4)보다 높음
+    // HID 테스트 태스크: 테스트 시나리오를 트레이스로 적재하고 재생 (주입은 재생 태스크가 담당)
+    // - 우선순위 3: 재생 완료만 기다리므로 입력 처리 태스크보다 낮음
     // - Core 0에서 실행
     // - 스택 크기 4096 bytes: 테스트 로직에 충분
     static hid_test_type_t test_type = HID_TEST_ALL;  // 모든 테스트 순차 실행
+    TaskHandle_t test_task_handle = NULL;
 
     BaseType_t test_task_created = xTaskCreatePinnedToCore(
         hid_test_task,      // 태스크 함수
         "HID_TEST",         // 태스크 이름
-        4096,               // 스택 크기 (bytes)
+        HID_TEST_TASK_STACK_SIZE, // 스택 크기 (bytes)
         &test_type,         // 테스트 타입 전달
-        5,                  // 우선순위
-        &hid_task_handle,   // 태스크 핸들 저장
+        3,                  // 우선순위
+        &test_task_handle,  // 태스크 핸들 저장
         0                   // Core 0에서 실행
     );
 
@@ -276,7 +344,8 @@ void app_main(void) {
         ESP_LOGE(TAG, "Failed to create HID test task");
         return;
     }
-    ESP_LOGI(TAG, "HID test task created (Core 0, Priority 5)");
+    mem_report_register_task(test_task_handle, HID_TEST_TASK_STACK_SIZE);
+    ESP_LOGI(TAG, "HID test task created (Core 0, Priority 3)");
     ESP_LOGI(TAG, "Test mode: Mouse circle + Keyboard 'HELLO' (1 cycle)");
 
 #elif defined(VOLTAGE_MONITOR_MODE)
@@ -292,7 +361,7 @@ void app_main(void) {
     BaseType_t vmon_task_created = xTaskCreatePinnedToCore(
         voltage_monitor_task,   // 태스크 함수
         "VMON",                 // 태스크 이름
-        4096,                   // 스택 크기 (bytes)
+        VMON_TASK_STACK_SIZE,   // 스택 크기 (bytes)
         NULL,                   // 매개변수 없음
         5,                      // 우선순위
         &vmon_task_handle,      // 태스크 핸들 저장
@@ -303,6 +372,7 @@ void app_main(void) {
         ESP_LOGE(TAG, "Failed to create voltage monitor task");
         return;
     }
+    mem_report_register_task(vmon_task_handle, VMON_TASK_STACK_SIZE);
     ESP_LOGI(TAG, "Voltage monitor task created (Core 0, Priority 5)");
 
 #else
@@ -311,13 +381,13 @@ void app_main(void) {
     // Vendor CDC 태스크: CDC 프레임 처리 (JSON 파싱 + 명령 디스패칭)
     // - 우선순위 3: 가장 낮은 우선순위 (실시간 입력 처리보다 후순위)
     // - Core 0에서 실행
-    // - 스택 크기 4096 bytes: cJSON 파싱을 위한 여유 확보
+    // - 스택 크기 4096 bytes: cJSON 파싱 여유 (프레임은 풀에서 직접 처리)
     TaskHandle_t vcdc_task_handle = NULL;
 
     BaseType_t vcdc_task_created = xTaskCreatePinnedToCore(
         vendor_cdc_task,    // 태스크 함수
         "VCDC",             // 태스크 이름
-        4096,               // 스택 크기 (bytes)
+        VCDC_TASK_STACK_SIZE, // 스택 크기 (bytes)
         NULL,               // 매개변수
         3,                  // 우선순위 (UART=6, HID=5, USB=4 보다 낮음)
         &vcdc_task_handle,  // 태스크 핸들 저장
@@ -328,6 +398,8 @@ void app_main(void) {
         ESP_LOGE(TAG, "Failed to create Vendor CDC task");
         return;
     }
+    mem_report_register_task(vcdc_task_handle, VCDC_TASK_STACK_SIZE);
+    task_profiler_register(TASK_PROBE_VCDC, vcdc_task_handle);
     ESP_LOGI(TAG, "Vendor CDC task created (Core 0, Priority 3)");
 
     // UART 수신 태스크: Android로부터 마우스/키보드 입력 수신
@@ -337,7 +409,7 @@ void app_main(void) {
     BaseType_t uart_task_created = xTaskCreatePinnedToCore(
         uart_task,          // 태스크 함수
         "UART",             // 태스크 이름
-        3072,               // 스택 크기 (bytes)
+        UART_TASK_STACK_SIZE, // 스택 크기 (bytes)
         NULL,               // 매개변수
         6,                  // 우선순위 (USB 태스크보다 높음)
         &uart_task_handle,  // 태스크 핸들 저장
@@ -348,16 +420,22 @@ void app_main(void) {
         ESP_LOGE(TAG, "Failed to create UART task");
         return;
     }
+    mem_report_register_task(uart_task_handle, UART_TASK_STACK_SIZE);
+    task_profiler_register(TASK_PROBE_UART, uart_task_handle);
     ESP_LOGI(TAG, "UART task created (Core 0, Priority 6)");
 
+#endif
+
+#if !defined(VOLTAGE_MONITOR_MODE)
     // HID 태스크: UART 큐에서 프레임 수신하여 HID 리포트로 변환 및 전송
+    // (HID_TEST_MODE에서는 입력 트레이스 재생 프레임을 처리)
     // - 우선순위 5: UART 태스크(6)보다는 낮고, USB 태스크(4)보다는 높음 (데이터 흐름 순서)
     // - Core 0에서 실행: UART와 함께 Core 0에서 집중 처리
     // - 스택 크기 3072 bytes: HID 리포트 생성 처리에 충분
     BaseType_t hid_task_created = xTaskCreatePinnedToCore(
         hid_task,           // 태스크 함수
         "HID",              // 태스크 이름
-        3072,               // 스택 크기 (bytes)
+        HID_TASK_STACK_SIZE, // 스택 크기 (bytes)
         NULL,               // 매개변수
         5,                  // 우선순위 (UART보다는 낮음, USB보다는 높음)
         &hid_task_handle,   // 태스크 핸들 저장
@@ -368,8 +446,9 @@ void app_main(void) {
         ESP_LOGE(TAG, "Failed to create HID task");
         return;
     }
+    mem_report_register_task(hid_task_handle, HID_TASK_STACK_SIZE);
+    task_profiler_register(TASK_PROBE_HID, hid_task_handle);
     ESP_LOGI(TAG, "HID task created (Core 0, Priority 5)");
-
 #endif
 
     // USB 태스크: TinyUSB 스택 폴링 담당
@@ -379,7 +458,7 @@ void app_main(void) {
     BaseType_t usb_task_created = xTaskCreatePinnedToCore(
         usb_task,           // 태스크 함수
         "USB",              // 태스크 이름
-        4096,               // 스택 크기 (bytes)
+        USB_TASK_STACK_SIZE, // 스택 크기 (bytes)
         NULL,               // 매개변수
         4,                  // 우선순위
         &usb_task_handle,   // 태스크 핸들 저장
@@ -390,6 +469,8 @@ void app_main(void) {
         ESP_LOGE(TAG, "Failed to create USB task");
         return;
     }
+    mem_report_register_task(usb_task_handle, USB_TASK_STACK_SIZE);
+    task_profiler_register(TASK_PROBE_USB, usb_task_handle);
     ESP_LOGI(TAG, "USB task created (Core 1, Priority 4)");
     
     // ==================== 4. 초기화 완료 ====================
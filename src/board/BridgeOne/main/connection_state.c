@@ -4,6 +4,8 @@
  *
  * Windows 서버와의 핸드셰이크 연결 상태를 FreeRTOS 뮤텍스로
  * 보호하여 스레드 안전하게 관리합니다.
+ * 조회용 스냅샷은 쓰기 측이 뮤텍스를 쥔 채로 갱신하고(snapshot_publish_locked),
+ * 읽기 측은 원자적 load 한 번으로 가져갑니다.
  *
  * 참조:
  * - docs/development-plans/phase-3-3-handshake-protocol.md §3.3.1
@@ -13,6 +15,11 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_random.h"
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdio.h>
 #include <string.h>
 #include "uart_handler.h"
 
@@ -41,11 +48,70 @@ static bridge_mode_t s_bridge_mode = BRIDGE_MODE_ESSENTIAL;
 /** 모드 변경 콜백 */
 static bridge_mode_change_cb_t s_mode_change_cb = NULL;
 
+/** 현재 세션 토큰 (빈 문자열이면 발급된 세션 없음) */
+static char s_session_token[CONN_SESSION_TOKEN_LEN + 1];
+
+/** 보류된 세션의 기능 협상 결과 (CONNECTED → IDLE 시점에 저장) */
+static connection_features_t s_session_features;
+
+/** 세션 보류 시각 (esp_timer µs, 0이면 보류된 세션 없음) */
+static int64_t s_session_suspended_us = 0;
+
+/** 조회용 스냅샷 (connection_state.h의 conn_snapshot_t 배치, 쓰기는 뮤텍스 보유 시에만) */
+static _Atomic conn_snapshot_t s_snapshot = CONN_STATE_IDLE | (BRIDGE_MODE_ESSENTIAL << 8);
+
+// ==================== 기능 레지스트리 ====================
+
+/** 기능 이름 테이블 (conn_feature_t 순서, 협상 JSON의 문자열과 같음) */
+static const char *feature_names[] = {
+    [CONN_FEATURE_WHEEL]       = "wheel",
+    [CONN_FEATURE_DRAG]        = "drag",
+    [CONN_FEATURE_RIGHT_CLICK] = "right_click",
+};
+
+_Static_assert(sizeof(feature_names) / sizeof(feature_names[0]) == CONN_FEATURE_COUNT,
+               "feature_names must list every conn_feature_t");
+_Static_assert(CONN_FEATURE_COUNT <= 16, "feature mask must fit in 16 snapshot bits");
+
 // ==================== 전방 선언 ====================
 
 static void bridge_mode_auto_transition(connection_state_t old_state,
                                          connection_state_t new_state);
 
+// ==================== 스냅샷 게시 ====================
+
+/**
+ * 현재 상태/모드/기능으로 스냅샷 갱신 (뮤텍스 보유 상태).
+ * s_state, s_bridge_mode, s_features(_valid)를 바꾼 뒤 뮤텍스를 놓기 전에 호출합니다.
+ */
+static void snapshot_publish_locked(void)
+{
+    uint16_t mask = s_features_valid ? s_features.accepted_mask : 0;
+    conn_snapshot_t snap = (conn_snapshot_t)s_state
+                         | ((conn_snapshot_t)s_bridge_mode << 8)
+                         | ((conn_snapshot_t)mask << 16);
+    atomic_store_explicit(&s_snapshot, snap, memory_order_release);
+}
+
+// ==================== 세션 보류 ====================
+
+/**
+ * IDLE 진입 직전 호출 (뮤텍스 보유 상태).
+ * CONNECTED 세션이 끊기는 경우 기능 협상 결과를 보류하고 유예 시간 측정을 시작합니다.
+ */
+static void session_suspend_locked(connection_state_t old_state)
+{
+    if (old_state != CONN_STATE_CONNECTED || s_session_token[0] == '\0' || !s_features_valid) {
+        return;
+    }
+
+    memcpy(&s_session_features, &s_features, sizeof(connection_features_t));
+    s_session_suspended_us = esp_timer_get_time();
+    if (s_session_suspended_us == 0) {
+        s_session_suspended_us = 1;  // 0은 "보류 없음" 표시
+    }
+}
+
 // ==================== 상태 이름 테이블 ====================
 
 static const char *state_names[] = {
@@ -114,6 +180,9 @@ bool connection_state_init(void)
     memset(&s_features, 0, sizeof(s_features));
     s_bridge_mode = BRIDGE_MODE_ESSENTIAL;
     s_mode_change_cb = NULL;
+    s_session_token[0] = '\0';
+    s_session_suspended_us = 0;
+    snapshot_publish_locked();
 
     ESP_LOGI(TAG, "Connection state initialized (state=IDLE, mode=ESSENTIAL)");
     return true;
@@ -121,16 +190,12 @@ bool connection_state_init(void)
 
 connection_state_t connection_state_get(void)
 {
-    connection_state_t state;
-
-    if (s_mutex != NULL && xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        state = s_state;
-        xSemaphoreGive(s_mutex);
-    } else {
-        state = s_state;  // 뮤텍스 획득 실패 시 직접 읽기 (최선의 노력)
-    }
+    return conn_snapshot_state(connection_state_snapshot());
+}
 
-    return state;
+conn_snapshot_t connection_state_snapshot(void)
+{
+    return atomic_load_explicit(&s_snapshot, memory_order_acquire);
 }
 
 bool connection_state_transition(connection_state_t new_state)
@@ -169,11 +234,13 @@ bool connection_state_transition(connection_state_t new_state)
     // 상태 전이 수행
     s_state = new_state;
 
-    // IDLE로 돌아가면 기능 협상 결과 초기화
+    // IDLE로 돌아가면 (CONNECTED였다면 세션 보류 후) 기능 협상 결과 초기화
     if (new_state == CONN_STATE_IDLE) {
+        session_suspend_locked(old_state);
         s_features_valid = false;
         memset(&s_features, 0, sizeof(s_features));
     }
+    snapshot_publish_locked();
 
     // 콜백 포인터를 로컬에 복사 (뮤텍스 해제 후 호출하기 위함)
     connection_state_change_cb_t cb = s_change_cb;
@@ -200,15 +267,19 @@ void connection_state_reset(void)
 
     if (s_mutex != NULL && xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
         old_state = s_state;
+        session_suspend_locked(old_state);
         s_state = CONN_STATE_IDLE;
         s_features_valid = false;
         memset(&s_features, 0, sizeof(s_features));
+        snapshot_publish_locked();
         cb = s_change_cb;
         xSemaphoreGive(s_mutex);
     } else {
         old_state = s_state;
+        session_suspend_locked(old_state);
         s_state = CONN_STATE_IDLE;
         s_features_valid = false;
+        snapshot_publish_locked();
     }
 
     if (old_state != CONN_STATE_IDLE) {
@@ -223,6 +294,159 @@ void connection_state_reset(void)
     }
 }
 
+bool connection_state_establish(const connection_features_t *features)
+{
+    // 레거시 핸드셰이크와 같은 경로 (전이 테이블로 검증)
+    static const connection_state_t path[] = {
+        CONN_STATE_AUTH_PENDING,
+        CONN_STATE_AUTH_OK,
+        CONN_STATE_SYNC_PENDING,
+        CONN_STATE_CONNECTED,
+    };
+
+    if (features == NULL) {
+        ESP_LOGW(TAG, "establish called with NULL");
+        return false;
+    }
+
+    if (s_mutex == NULL) {
+        ESP_LOGE(TAG, "Module not initialized");
+        return false;
+    }
+
+    if (xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        ESP_LOGE(TAG, "Mutex timeout on establish");
+        return false;
+    }
+
+    connection_state_t old_state = s_state;
+    if (old_state != CONN_STATE_IDLE) {
+        ESP_LOGW(TAG, "Invalid establish: %s -> CONNECTED", state_names[old_state]);
+        xSemaphoreGive(s_mutex);
+        return false;
+    }
+
+    connection_state_t from = old_state;
+    for (size_t i = 0; i < sizeof(path) / sizeof(path[0]); i++) {
+        if (!transition_table[from][path[i]]) {
+            ESP_LOGE(TAG, "Invalid transition in establish: %s -> %s",
+                     state_names[from], state_names[path[i]]);
+            xSemaphoreGive(s_mutex);
+            return false;
+        }
+        from = path[i];
+    }
+
+    memcpy(&s_features, features, sizeof(connection_features_t));
+    s_features_valid = true;
+    s_state = CONN_STATE_CONNECTED;
+    snapshot_publish_locked();
+
+    connection_state_change_cb_t cb = s_change_cb;
+
+    xSemaphoreGive(s_mutex);
+
+    ESP_LOGI(TAG, "State: IDLE -> CONNECTED (established, accepted=%u, keepalive=%ums)",
+             features->accepted_count, features->keepalive_ms);
+
+    bridge_mode_auto_transition(old_state, CONN_STATE_CONNECTED);
+
+    if (cb != NULL) {
+        cb(old_state, CONN_STATE_CONNECTED);
+    }
+
+    return true;
+}
+
+void connection_state_issue_session(char *out_token)
+{
+    char token[CONN_SESSION_TOKEN_LEN + 1];
+    snprintf(token, sizeof(token), "%08" PRIx32 "%08" PRIx32, esp_random(), esp_random());
+
+    if (s_mutex != NULL && xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        memcpy(s_session_token, token, sizeof(token));
+        s_session_suspended_us = 0;
+        xSemaphoreGive(s_mutex);
+    } else {
+        memcpy(s_session_token, token, sizeof(token));
+        s_session_suspended_us = 0;
+    }
+
+    if (out_token != NULL) {
+        memcpy(out_token, token, sizeof(token));
+    }
+
+    // 토큰은 RESUME 자격 증명이므로 식별용 앞 4자만 로그에 남김
+    ESP_LOGI(TAG, "Session issued: %.4s...", token);
+}
+
+bool connection_state_resume(const char *token, connection_features_t *out_features)
+{
+    if (token == NULL) {
+        ESP_LOGW(TAG, "resume called with NULL");
+        return false;
+    }
+
+    if (s_mutex == NULL) {
+        ESP_LOGE(TAG, "Module not initialized");
+        return false;
+    }
+
+    if (xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        ESP_LOGE(TAG, "Mutex timeout on resume");
+        return false;
+    }
+
+    connection_state_t old_state = s_state;
+    if (old_state != CONN_STATE_IDLE) {
+        ESP_LOGW(TAG, "Invalid resume: %s -> CONNECTED", state_names[old_state]);
+        xSemaphoreGive(s_mutex);
+        return false;
+    }
+
+    if (s_session_suspended_us == 0 ||
+        strncmp(token, s_session_token, sizeof(s_session_token)) != 0) {
+        ESP_LOGW(TAG, "Resume rejected: no suspended session for token");
+        xSemaphoreGive(s_mutex);
+        return false;
+    }
+
+    int64_t suspended_ms = (esp_timer_get_time() - s_session_suspended_us) / 1000;
+    if (suspended_ms > CONN_SESSION_GRACE_MS) {
+        ESP_LOGW(TAG, "Resume rejected: session expired (%" PRId64 "ms > %dms)",
+                 suspended_ms, CONN_SESSION_GRACE_MS);
+        s_session_token[0] = '\0';
+        s_session_suspended_us = 0;
+        xSemaphoreGive(s_mutex);
+        return false;
+    }
+
+    memcpy(&s_features, &s_session_features, sizeof(connection_features_t));
+    s_features_valid = true;
+    s_session_suspended_us = 0;
+    s_state = CONN_STATE_CONNECTED;
+    snapshot_publish_locked();
+
+    if (out_features != NULL) {
+        memcpy(out_features, &s_features, sizeof(connection_features_t));
+    }
+
+    connection_state_change_cb_t cb = s_change_cb;
+
+    xSemaphoreGive(s_mutex);
+
+    ESP_LOGI(TAG, "State: IDLE -> CONNECTED (resumed after %" PRId64 "ms, accepted=%u)",
+             suspended_ms, s_session_features.accepted_count);
+
+    bridge_mode_auto_transition(old_state, CONN_STATE_CONNECTED);
+
+    if (cb != NULL) {
+        cb(old_state, CONN_STATE_CONNECTED);
+    }
+
+    return true;
+}
+
 void connection_state_on_change(connection_state_change_cb_t callback)
 {
     if (s_mutex != NULL && xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
@@ -246,6 +470,7 @@ void connection_state_set_features(const connection_features_t *features)
     if (s_mutex != NULL && xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
         memcpy(&s_features, features, sizeof(connection_features_t));
         s_features_valid = true;
+        snapshot_publish_locked();
         xSemaphoreGive(s_mutex);
     }
 
@@ -309,6 +534,7 @@ static void bridge_mode_set_internal(bridge_mode_t new_mode)
             return;
         }
         s_bridge_mode = new_mode;
+        snapshot_publish_locked();
         cb = s_mode_change_cb;
         xSemaphoreGive(s_mutex);
     } else {
@@ -317,6 +543,7 @@ static void bridge_mode_set_internal(bridge_mode_t new_mode)
             return;
         }
         s_bridge_mode = new_mode;
+        snapshot_publish_locked();
         cb = s_mode_change_cb;
     }
 
@@ -351,16 +578,7 @@ static void bridge_mode_auto_transition(connection_state_t old_state,
 
 bridge_mode_t bridge_mode_get(void)
 {
-    bridge_mode_t mode;
-
-    if (s_mutex != NULL && xSemaphoreTake(s_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        mode = s_bridge_mode;
-        xSemaphoreGive(s_mutex);
-    } else {
-        mode = s_bridge_mode;
-    }
-
-    return mode;
+    return conn_snapshot_mode(connection_state_snapshot());
 }
 
 void bridge_mode_on_change(bridge_mode_change_cb_t callback)
@@ -386,26 +604,47 @@ const char *bridge_mode_name(bridge_mode_t mode)
 
 bool bridge_mode_is_feature_active(const char *feature_name)
 {
-    if (feature_name == NULL) {
-        return false;
+    conn_feature_t feature = conn_feature_from_name(feature_name);
+    if (feature >= CONN_FEATURE_COUNT) {
+        return false;  // 레지스트리에 없는 기능은 협상에서 수락될 수 없음
     }
+    return bridge_mode_is_feature_id_active(feature);
+}
 
-    // Essential 모드에서는 확장 기능 비활성
-    if (bridge_mode_get() != BRIDGE_MODE_STANDARD) {
+bool bridge_mode_is_feature_id_active(conn_feature_t feature)
+{
+    if (feature >= CONN_FEATURE_COUNT) {
         return false;
     }
 
-    // Standard 모드: 수락된 기능 목록에서 조회
-    connection_features_t features;
-    if (!connection_state_get_features(&features)) {
+    conn_snapshot_t snap = connection_state_snapshot();
+
+    // Essential 모드에서는 확장 기능 비활성
+    if (conn_snapshot_mode(snap) != BRIDGE_MODE_STANDARD) {
         return false;
     }
 
-    for (uint8_t i = 0; i < features.accepted_count; i++) {
-        if (strcmp(features.accepted[i], feature_name) == 0) {
-            return true;
+    // Standard 모드: 수락된 기능 비트 조회
+    return (conn_snapshot_features(snap) & CONN_FEATURE_BIT(feature)) != 0;
+}
+
+conn_feature_t conn_feature_from_name(const char *name)
+{
+    if (name == NULL) {
+        return CONN_FEATURE_COUNT;
+    }
+    for (int f = 0; f < CONN_FEATURE_COUNT; f++) {
+        if (strcmp(name, feature_names[f]) == 0) {
+            return (conn_feature_t)f;
         }
     }
+    return CONN_FEATURE_COUNT;
+}
 
-    return false;
+const char *conn_feature_name(conn_feature_t feature)
+{
+    if (feature < CONN_FEATURE_COUNT) {
+        return feature_names[feature];
+    }
+    return "unknown";
 }
@@ -3,7 +3,10 @@
  * @brief ESP32-S3 연결 상태 머신
  *
  * Windows 서버와의 핸드셰이크 연결 상태를 관리합니다.
- * 상태 전이는 FreeRTOS 뮤텍스로 보호되어 스레드 안전합니다.
+ * 상태 전이(쓰기)는 FreeRTOS 뮤텍스로 보호되어 스레드 안전합니다.
+ * 조회(connection_state_get, bridge_mode_get, bridge_mode_is_feature_active)는
+ * 쓰기 측이 게시한 32비트 스냅샷(상태 + 모드 + 기능 비트마스크)을 한 번 읽으므로
+ * 뮤텍스 없이 대기 없이 끝납니다 (UART/HID 핫 경로용).
  *
  * 상태 흐름:
  *   IDLE ──(AUTH_CHALLENGE 수신)──> AUTH_PENDING
@@ -16,6 +19,14 @@
  *   CONNECTED ──(Keep-alive 실패 또는 CDC 해제)──> IDLE
  *   ERROR ──(리셋)──> IDLE
  *
+ *   IDLE ══(HELLO: 위 4단계를 한 번에)══> CONNECTED  (connection_state_establish)
+ *   IDLE ══(RESUME: 보류 세션 토큰 제시)══> CONNECTED   (connection_state_resume)
+ *
+ * 세션 재개:
+ *   HELLO_ACK / STATE_SYNC_ACK에 세션 토큰을 실어 보내고, CONNECTED에서 IDLE로 떨어지면
+ *   (DTR 해제, Keep-alive 타임아웃) 기능 협상 결과를 보류합니다. CONN_SESSION_GRACE_MS 안에
+ *   서버가 같은 토큰으로 RESUME하면 재협상 없이 같은 기능으로 CONNECTED에 복귀합니다.
+ *
  * 참조:
  * - docs/development-plans/phase-3-3-handshake-protocol.md §3.3.1
  * - docs/windows/technical-specification-server.md §3.2
@@ -45,32 +56,58 @@ typedef enum {
 
 // ==================== 기능 협상 ====================
 
-/** 서버가 요청할 수 있는 최대 기능 수 */
-#define CONN_MAX_FEATURES  16
+/**
+ * ESP32-S3가 지원하는 기능 레지스트리 (컴파일 타임).
+ *
+ * 협상(vendor_cdc_handler.c)은 이름으로 조회해 수락 여부를 정하고,
+ * 수락된 기능은 스냅샷의 비트마스크(CONN_FEATURE_BIT)로 게시됩니다.
+ * 기능을 추가하면 connection_state.c의 feature_names 테이블에도 이름을 넣어야 합니다.
+ */
+typedef enum {
+    CONN_FEATURE_WHEEL,        // "wheel": HID 리포트에 wheel 필드 있음
+    CONN_FEATURE_DRAG,         // "drag": buttons 필드의 지속 상태
+    CONN_FEATURE_RIGHT_CLICK,  // "right_click": buttons bit1
 
-/** 기능 이름 최대 길이 (null 포함) */
-#define CONN_FEATURE_NAME_MAX  32
+    CONN_FEATURE_COUNT         // 등록된 기능 수 (최대 16, 스냅샷 비트 폭)
+} conn_feature_t;
+
+/** 기능 비트마스크의 비트 */
+#define CONN_FEATURE_BIT(feature)  (1u << (feature))
+
+/** 서버가 요청할 수 있는 최대 기능 수 (초과분은 무시) */
+#define CONN_MAX_FEATURES  16
 
 /**
  * 기능 협상 결과 구조체.
  *
- * 서버가 STATE_SYNC에서 요청한 기능 목록과
- * ESP32-S3가 수락한 기능 목록을 저장합니다.
+ * 서버가 STATE_SYNC/HELLO에서 요청한 기능 수와
+ * ESP32-S3가 수락한 기능(레지스트리 비트마스크)을 저장합니다.
+ * 수락할 수 있는 기능은 레지스트리에 있는 것뿐이므로 이름 문자열 대신 ID 비트로 보관합니다
+ * (이전 이름 테이블 2 × 16 × 32바이트 → 6바이트). 이름은 conn_feature_name()으로 복원합니다.
  * Phase 3.5 (모드 전환)에서 모드별 동작 결정에 사용됩니다.
  */
 typedef struct {
-    /** 서버가 요청한 기능 목록 */
-    char     requested[CONN_MAX_FEATURES][CONN_FEATURE_NAME_MAX];
+    /** ESP32-S3가 수락한 기능 (CONN_FEATURE_BIT 조합) */
+    uint16_t accepted_mask;
+
+    /** 서버가 요청한 기능 수 (로그용, 미지원 기능 포함) */
     uint8_t  requested_count;
 
-    /** ESP32-S3가 수락한 기능 목록 */
-    char     accepted[CONN_MAX_FEATURES][CONN_FEATURE_NAME_MAX];
+    /** 수락한 기능 수 (accepted_mask의 비트 수) */
     uint8_t  accepted_count;
 
     /** 합의된 Keep-alive 주기 (ms) */
     uint16_t keepalive_ms;
 } connection_features_t;
 
+// ==================== 세션 재개 ====================
+
+/** 세션 토큰 길이 (hex 문자 수, null 제외) */
+#define CONN_SESSION_TOKEN_LEN  16
+
+/** CONNECTED → IDLE 이후 RESUME을 허용하는 유예 시간 (ms) */
+#define CONN_SESSION_GRACE_MS   10000
+
 // ==================== 브릿지 모드 열거형 ====================
 
 /**
@@ -97,6 +134,36 @@ typedef enum {
 typedef void (*bridge_mode_change_cb_t)(bridge_mode_t old_mode,
                                         bridge_mode_t new_mode);
 
+// ==================== 상태 스냅샷 ====================
+
+/**
+ * 연결 상태 스냅샷 (32비트, 원자적으로 게시).
+ *
+ *   bit  0- 7: connection_state_t
+ *   bit  8-15: bridge_mode_t
+ *   bit 16-31: 수락된 기능 비트마스크 (conn_feature_t, CONNECTED에서 협상 결과가 있을 때만)
+ *
+ * 상태와 기능은 같은 쓰기에서 함께 바뀌므로, 한 번 읽은 값 안에서는
+ * "CONNECTED인데 기능이 비어 있음" 같은 중간 조합이 보이지 않습니다.
+ * 모드는 상태 전이 직후 별도로 게시되므로 잠깐 이전 모드가 보일 수 있습니다 (콜백 순서와 동일).
+ */
+typedef uint32_t conn_snapshot_t;
+
+static inline connection_state_t conn_snapshot_state(conn_snapshot_t snap)
+{
+    return (connection_state_t)(snap & 0xFFu);
+}
+
+static inline bridge_mode_t conn_snapshot_mode(conn_snapshot_t snap)
+{
+    return (bridge_mode_t)((snap >> 8) & 0xFFu);
+}
+
+static inline uint16_t conn_snapshot_features(conn_snapshot_t snap)
+{
+    return (uint16_t)(snap >> 16);
+}
+
 // ==================== 콜백 타입 ====================
 
 /**
@@ -123,12 +190,21 @@ bool connection_state_init(void);
 /**
  * 현재 연결 상태 조회.
  *
- * 뮤텍스 보호 하에 현재 상태를 반환합니다.
+ * 스냅샷을 읽으므로 뮤텍스를 잡지 않습니다 (어느 태스크/코어에서나 대기 없음).
  *
  * @return 현재 connection_state_t 값
  */
 connection_state_t connection_state_get(void);
 
+/**
+ * 상태/모드/수락 기능을 한 번에 조회 (대기 없음).
+ *
+ * 여러 값을 함께 판단해야 할 때 각각 조회하는 대신 사용합니다.
+ *
+ * @return 현재 스냅샷 (conn_snapshot_state/mode/features로 분해)
+ */
+conn_snapshot_t connection_state_snapshot(void);
+
 /**
  * 연결 상태 전이.
  *
@@ -157,6 +233,46 @@ bool connection_state_transition(connection_state_t new_state);
  */
 void connection_state_reset(void);
 
+/**
+ * IDLE에서 CONNECTED까지 한 번에 전이하고 기능 협상 결과를 저장.
+ *
+ * HELLO 핸들러(1회 왕복 핸드셰이크)에서 사용합니다.
+ * IDLE → AUTH_PENDING → AUTH_OK → SYNC_PENDING → CONNECTED 경로를
+ * 전이 테이블로 검증한 뒤, 뮤텍스를 한 번만 잡은 채로 상태와 기능을 함께 갱신하므로
+ * 다른 태스크가 중간 상태나 기능 없는 CONNECTED를 관찰하지 않습니다.
+ * 콜백과 모드 전환은 IDLE → CONNECTED 한 번만 호출됩니다.
+ *
+ * @param features 저장할 기능 협상 결과
+ * @return true: CONNECTED 진입, false: IDLE이 아니거나 뮤텍스 획득 실패
+ */
+bool connection_state_establish(const connection_features_t *features);
+
+/**
+ * 새 세션 토큰 발급.
+ *
+ * HELLO_ACK / STATE_SYNC_ACK 조립 시 호출합니다. 이전 토큰과 보류 중인 세션은 폐기됩니다.
+ * 발급된 토큰은 이후 CONNECTED 세션에 묶이며, CONNECTED에서 IDLE로 떨어질 때
+ * 그 시점의 기능 협상 결과와 함께 보류됩니다.
+ *
+ * @param out_token 토큰을 받을 버퍼 (CONN_SESSION_TOKEN_LEN + 1 바이트)
+ */
+void connection_state_issue_session(char *out_token);
+
+/**
+ * 보류된 세션을 재개하여 IDLE에서 CONNECTED로 한 번에 전이.
+ *
+ * RESUME 핸들러에서 사용합니다. IDLE 상태이고, 토큰이 보류 세션과 일치하고,
+ * 보류 후 CONN_SESSION_GRACE_MS가 지나지 않았으면 보류해 둔 기능 협상 결과를 복원합니다.
+ * 복원된 세션은 전체 핸드셰이크를 거쳐 만들어진 것이므로 전이 경로를 다시 검증하지 않으며,
+ * 콜백과 모드 전환은 connection_state_establish()와 같이 IDLE → CONNECTED 한 번만 호출됩니다.
+ * 토큰은 재개 후에도 유지되어 다음 끊김에서 다시 사용할 수 있습니다.
+ *
+ * @param token 서버가 제시한 세션 토큰
+ * @param out_features 복원된 기능 협상 결과를 받을 구조체 (NULL 가능)
+ * @return true: CONNECTED 복귀, false: IDLE 아님, 보류 세션 없음, 토큰 불일치 또는 유예 시간 만료
+ */
+bool connection_state_resume(const char *token, connection_features_t *out_features);
+
 /**
  * 상태 변경 콜백 등록.
  *
@@ -199,7 +315,7 @@ const char *connection_state_name(connection_state_t state);
 // ==================== 브릿지 모드 관리 ====================
 
 /**
- * 현재 브릿지 모드 조회.
+ * 현재 브릿지 모드 조회 (스냅샷, 대기 없음).
  *
  * @return 현재 bridge_mode_t 값
  */
@@ -228,10 +344,35 @@ const char *bridge_mode_name(bridge_mode_t mode);
  *
  * CONNECTED 상태에서 협상된 accepted_features 중
  * 지정된 기능이 포함되어 있는지 확인합니다.
+ * 이름을 레지스트리에서 찾은 뒤 bridge_mode_is_feature_id_active()와 같이 판단합니다.
  *
  * @param feature_name 조회할 기능 이름 (예: "wheel", "drag", "right_click")
- * @return true: 기능이 수락됨, false: 미수락 또는 CONNECTED 상태 아님
+ * @return true: 기능이 수락됨, false: 미수락, 미등록 이름 또는 Standard 모드 아님
  */
 bool bridge_mode_is_feature_active(const char *feature_name);
 
+/**
+ * 기능 활성 여부 조회 (핫 경로용, 스냅샷 1회 읽기 + 비트 검사).
+ *
+ * @param feature 조회할 기능
+ * @return true: Standard 모드이고 해당 기능이 수락됨
+ */
+bool bridge_mode_is_feature_id_active(conn_feature_t feature);
+
+/**
+ * 기능 이름 → 레지스트리 ID.
+ *
+ * @param name 기능 이름
+ * @return 기능 ID, 등록되지 않은 이름(또는 NULL)이면 CONN_FEATURE_COUNT
+ */
+conn_feature_t conn_feature_from_name(const char *name);
+
+/**
+ * 레지스트리 ID → 기능 이름.
+ *
+ * @param feature 기능 ID
+ * @return 기능 이름 문자열, 범위 밖이면 "unknown"
+ */
+const char *conn_feature_name(conn_feature_t feature);
+
 #endif // CONNECTION_STATE_H
@@ -16,15 +16,25 @@
  */
 
 #include <string.h>
+#include <stdatomic.h>
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"    // esp_cpu_get_cycle_count() (핫 경로 계측)
 #include "tusb.h"
+#include "device/usbd_pvt.h"  // usbd_defer_func (메일박스 제출을 TinyUSB 태스크에서 실행)
 #include "class/hid/hid.h"
 #include "hid_handler.h"
 #include "usb_descriptors.h"
 #include "esp_task_wdt.h"
 #include "connection_state.h"
+#include "pointer_dynamics.h"
+#include "scroll_inertia.h"
+#include "task_profiler.h"
+#include "trace_recorder.h"
+#include "input_trace.h"
 
 // ==================== 로깅 설정 ====================
 static const char* TAG = "HID_HANDLER";
@@ -51,7 +61,7 @@ hid_keyboard_report_t g_last_kb_report = {0};
  * 
  * 초기값: 모두 0 (이동/버튼 없음)
  */
-hid_mouse_report_t g_last_mouse_report = {0};
+bridge_mouse_report_t g_last_mouse_report = {0};
 
 /**
  * @brief 키보드 LED 상태 버퍼
@@ -64,6 +74,112 @@ hid_mouse_report_t g_last_mouse_report = {0};
  */
 uint8_t g_hid_keyboard_led_status = 0;
 
+// ==================== 고해상도 스크롤 (Resolution Multiplier) ====================
+
+/** Feature 리포트 비트: 수직 휠 / 수평 휠(AC Pan) 배율 (usb_descriptors.c 참조) */
+#define HID_RES_MULT_WHEEL  0x01
+#define HID_RES_MULT_PAN    0x04
+
+/**
+ * @brief 호스트가 설정한 Resolution Multiplier Feature 값
+ *
+ * 0이면 휠/AC Pan을 디텐트 단위로, 해당 비트가 켜져 있으면
+ * 1/HID_WHEEL_UNITS_PER_DETENT 디텐트 단위로 전송합니다.
+ * USB 재열거(tud_mount_cb) 시 기본값 0으로 돌아갑니다.
+ */
+static uint8_t s_resolution_multiplier = 0;
+
+/** 디텐트 모드에서 1디텐트 미만으로 남은 고해상도 단위 (다음 리포트로 이월) */
+static int32_t s_wheel_remainder_units = 0;
+static int32_t s_pan_remainder_units = 0;
+
+/** 위 상태 보호 (hid_task, esp_timer 태스크, TinyUSB 콜백에서 접근) */
+static portMUX_TYPE s_scroll_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief 마지막으로 전송 요청한 마우스 버튼 (생산자 쪽, Core 0)
+ *
+ * 디텐트 이월만 있는 리포트 생략 판단과 관성 스크롤 리포트에 사용합니다.
+ * g_last_mouse_report는 메일박스 모드에서 Core 1이 제출 시점에 갱신하므로 읽지 않습니다.
+ */
+static volatile uint8_t s_mouse_buttons_requested = 0;
+
+// ==================== 핫 경로 계측 ====================
+
+/**
+ * @brief 핫 경로 처리 시간 누적 (측정 지점마다 기록 태스크 1개)
+ *
+ * reset은 다른 태스크(CDC 명령)가 요청만 하고, 기록 태스크가 다음 기록 때 비웁니다.
+ */
+typedef struct {
+    uint32_t    count;
+    uint32_t    cycles_min;
+    uint32_t    cycles_max;
+    uint32_t    stalls;
+    uint64_t    cycles_sum;
+    atomic_bool reset;
+} hotpath_acc_t;
+
+static hotpath_acc_t s_hotpath_process;   // hid_task 전용
+static hotpath_acc_t s_hotpath_submit;    // TinyUSB 태스크 전용
+
+#define HOTPATH_STALL_CYCLES  ((uint32_t)HID_HOTPATH_STALL_US * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ)
+
+static void hotpath_record(hotpath_acc_t* acc, uint32_t cycles) {
+    if (atomic_exchange(&acc->reset, false) || acc->count == 0) {
+        acc->count = 0;
+        acc->cycles_min = UINT32_MAX;
+        acc->cycles_max = 0;
+        acc->stalls = 0;
+        acc->cycles_sum = 0;
+    }
+    acc->count++;
+    acc->cycles_sum += cycles;
+    if (cycles < acc->cycles_min) acc->cycles_min = cycles;
+    if (cycles > acc->cycles_max) acc->cycles_max = cycles;
+    if (cycles > HOTPATH_STALL_CYCLES) acc->stalls++;
+}
+
+static void hotpath_snapshot(const hotpath_acc_t* acc, hid_hotpath_stats_t* out) {
+    out->count      = acc->count;
+    out->cycles_min = (acc->count > 0) ? acc->cycles_min : 0;
+    out->cycles_avg = (acc->count > 0) ? (uint32_t)(acc->cycles_sum / acc->count) : 0;
+    out->cycles_max = acc->cycles_max;
+    out->stalls     = acc->stalls;
+}
+
+void hid_get_hotpath_stats(hid_hotpath_stats_t* process, hid_hotpath_stats_t* submit) {
+    hotpath_snapshot(&s_hotpath_process, process);
+    hotpath_snapshot(&s_hotpath_submit, submit);
+}
+
+void hid_reset_hotpath_stats(void) {
+    atomic_store(&s_hotpath_process.reset, true);
+    atomic_store(&s_hotpath_submit.reset, true);
+}
+
+#if HID_SUBMIT_MAILBOX
+// ==================== HID 리포트 메일박스 ====================
+
+/**
+ * @brief 키보드/마우스 리포트 메일박스 (hid_mailbox.h)
+ *
+ * 생산자(hid_task, 키보드/관성 스크롤 esp_timer, 모드 전환 콜백)는 게시만 하고,
+ * TinyUSB 태스크(Core 1)가 mailbox_submit()으로 꺼내서 제출합니다.
+ * 엔드포인트 claim/release와 g_last_* 갱신은 TinyUSB 태스크에서만 일어납니다.
+ */
+static hid_mailbox_t s_kb_mailbox;
+static hid_mailbox_t s_mouse_mailbox;
+
+/**
+ * @brief 제출 서비스 함수가 TinyUSB 이벤트 큐에 올라가 있는지
+ *
+ * 게시가 몰려도 usbd_defer_func() 이벤트는 최대 1개만 쌓이도록 합니다
+ * (TinyUSB 이벤트 큐가 가득 차면 송신 측이 블로킹되므로).
+ */
+static atomic_bool s_submit_scheduled = false;
+
+#else
 // ==================== HID 리포트 대기 큐 ====================
 
 /**
@@ -93,6 +209,13 @@ static QueueHandle_t mouse_report_queue = NULL;
  * 일반적으로 1-2개만 대기하지만, 버스트 입력 시 여유분 확보.
  */
 #define HID_REPORT_QUEUE_SIZE 10
+#endif // HID_SUBMIT_MAILBOX
+
+// 키보드 디바운스/자동 반복 엔진 초기화 (아래 엔진 섹션에서 정의)
+static void kb_engine_init(void);
+
+// 포인터 다이나믹스 상태 초기화 (아래 다이나믹스 섹션에서 정의)
+static void dynamics_init(void);
 
 /**
  * @brief HID 리포트 대기 큐 초기화
@@ -101,21 +224,36 @@ static QueueHandle_t mouse_report_queue = NULL;
  * app_main()에서 HID 태스크 생성 전에 호출해야 합니다.
  */
 void hid_init_queues(void) {
+#if HID_SUBMIT_MAILBOX
+    hid_mailbox_init(&s_kb_mailbox);
+    hid_mailbox_init(&s_mouse_mailbox);
+    ESP_LOGI(TAG, "HID report mailboxes initialized (slots=%d, submit on TinyUSB task)",
+             HID_MAILBOX_SLOTS);
+#else
     // 키보드 리포트 큐 생성
     kb_report_queue = xQueueCreate(HID_REPORT_QUEUE_SIZE, sizeof(hid_keyboard_report_t));
     if (kb_report_queue == NULL) {
         ESP_LOGE(TAG, "Failed to create keyboard report queue");
     } else {
+        trace_recorder_register_queue(kb_report_queue, "kb_report_queue");
         ESP_LOGI(TAG, "Keyboard report queue created (size=%d)", HID_REPORT_QUEUE_SIZE);
     }
 
     // 마우스 리포트 큐 생성
-    mouse_report_queue = xQueueCreate(HID_REPORT_QUEUE_SIZE, sizeof(hid_mouse_report_t));
+    mouse_report_queue = xQueueCreate(HID_REPORT_QUEUE_SIZE, sizeof(bridge_mouse_report_t));
     if (mouse_report_queue == NULL) {
         ESP_LOGE(TAG, "Failed to create mouse report queue");
     } else {
+        trace_recorder_register_queue(mouse_report_queue, "mouse_report_queue");
         ESP_LOGI(TAG, "Mouse report queue created (size=%d)", HID_REPORT_QUEUE_SIZE);
     }
+#endif
+
+    // 키보드 디바운스/자동 반복 엔진 생성
+    kb_engine_init();
+
+    // 포인터 다이나믹스 (기본: Off, Android가 연결 후 프리셋 전송)
+    dynamics_init();
 }
 
 // ==================== 이전 입력 상태 추적 (변경 감지용) ====================
@@ -125,6 +263,458 @@ static uint8_t prev_kb_keycode1 = 0;
 static uint8_t prev_kb_keycode2 = 0;
 static uint8_t prev_mouse_buttons = 0;
 
+// ==================== 키보드 디바운스/자동 반복 엔진 ====================
+// Android는 키 누름/해제 프레임 한 쌍만 보내고, 디바운스와 typematic 반복은
+// 여기서 esp_timer로 처리합니다. prev_kb_* 는 "PC에 반영된 상태"로 사용됩니다.
+//
+// 호출 컨텍스트가 세 곳(hid_task, esp_timer 태스크, 모드 전환 콜백)이므로
+// 엔진 상태는 kb_engine_mutex로 보호합니다.
+
+static SemaphoreHandle_t kb_engine_mutex = NULL;
+static esp_timer_handle_t kb_debounce_timer = NULL;
+static esp_timer_handle_t kb_repeat_timer = NULL;
+
+/** 마지막으로 키보드 상태를 PC에 반영한 시각 (us, 디바운스 창 기준점) */
+static int64_t kb_last_change_us = 0;
+
+/** 디바운스 창 동안 보류된 최신 키보드 상태 */
+static bool kb_pending_valid = false;
+static uint8_t kb_pending_modifier = 0;
+static uint8_t kb_pending_keycode1 = 0;
+static uint8_t kb_pending_keycode2 = 0;
+
+/** 초기 지연(300ms)이 지나 주기 반복(30ms) 단계에 들어갔는지 여부 */
+static bool kb_repeat_periodic = false;
+
+/**
+ * 자동 반복 타이머를 멈추거나 다시 설정할 때마다 증가 (뮤텍스 보유 상태에서만 변경).
+ * 콜백이 뮤텍스를 기다리는 동안 kb_apply_state()가 새 키로 타이머를 다시 설정했다면
+ * 이전 키의 만료이므로 무시합니다.
+ */
+static atomic_uint kb_repeat_generation = 0;
+
+/** 보류 상태 전송 실패(리포트 큐/메일박스 가득 참) 시 재시도 간격 */
+#define KB_RETRY_US  1000
+
+/**
+ * 매크로 재생 중: 키보드 리포트는 매크로만 보내고 엔진(디바운스/반복)은 멈춥니다.
+ * 그동안의 실시간 요청은 kb_live_* 에 최신 상태만 기억했다가 재생 종료 시 다시 요청합니다.
+ */
+static bool kb_macro_active = false;
+static uint8_t kb_live_modifier = 0;
+static uint8_t kb_live_keycode1 = 0;
+static uint8_t kb_live_keycode2 = 0;
+
+/**
+ * @brief 자동 반복 대상 키인지 확인
+ *
+ * 수정자 키(0xE0~0xE7)는 반복하지 않습니다. Sticky Hold로 유지되는
+ * Ctrl/Shift가 반복되면 PC에서 단축키가 여러 번 입력됩니다.
+ */
+static inline bool kb_is_repeatable(uint8_t keycode) {
+    return keycode != 0 && keycode < HID_KEY_CONTROL_LEFT;
+}
+
+/**
+ * @brief 자동 반복 타이머 정지 (뮤텍스 보유 상태에서 호출)
+ */
+static void kb_repeat_stop(void) {
+    if (kb_repeat_timer != NULL) {
+        (void)esp_timer_stop(kb_repeat_timer);  // 미실행 상태면 ESP_ERR_INVALID_STATE (무시)
+    }
+    kb_repeat_periodic = false;
+    atomic_fetch_add(&kb_repeat_generation, 1);
+}
+
+/**
+ * @brief 키보드 상태를 PC에 반영 (뮤텍스 보유 상태에서 호출)
+ *
+ * 리포트 전송에 성공하면 prev_kb_* 와 디바운스 기준 시각을 갱신하고,
+ * 반복 대상 키가 눌려 있으면 초기 지연 타이머를 다시 시작합니다.
+ *
+ * @return true 전송(또는 큐 저장) 성공, false 전송 실패
+ */
+static bool kb_apply_state(uint8_t modifier, uint8_t keycode1, uint8_t keycode2) {
+    hid_keyboard_report_t kb_report = {
+        .modifier = modifier,
+        .reserved = 0,
+        .keycode = { keycode1, keycode2, 0, 0, 0, 0 }
+    };
+
+    if (!sendKeyboardReport(&kb_report)) {
+        return false;
+    }
+
+    prev_kb_modifier = modifier;
+    prev_kb_keycode1 = keycode1;
+    prev_kb_keycode2 = keycode2;
+    kb_last_change_us = esp_timer_get_time();
+
+    kb_repeat_stop();
+    if (kb_repeat_timer != NULL && (kb_is_repeatable(keycode1) || kb_is_repeatable(keycode2))) {
+        esp_err_t err = esp_timer_start_once(kb_repeat_timer, (uint64_t)KEYBOARD_REPEAT_INITIAL_MS * 1000);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Keyboard repeat: timer start failed (%s)", esp_err_to_name(err));
+        }
+    }
+
+    ESP_LOGD(TAG, "Keyboard state changed: mod=0x%02x, k1=0x%02x, k2=0x%02x",
+             modifier, keycode1, keycode2);
+    return true;
+}
+
+/**
+ * @brief 보류 상태를 반영할 디바운스 타이머 시작 (뮤텍스 보유 상태에서 호출)
+ *
+ * 시작에 실패하면 보류 상태를 반영할 수단이 없으므로 보류를 버리고 자동 반복을 멈춥니다
+ * (놓친 상태가 키 해제이면 반복이 stuck 키처럼 계속되므로).
+ */
+static void kb_arm_debounce(uint64_t delay_us) {
+    esp_err_t err = esp_timer_start_once(kb_debounce_timer, delay_us);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Keyboard debounce: timer start failed (%s), dropping pending state",
+                 esp_err_to_name(err));
+        kb_pending_valid = false;
+        kb_repeat_stop();
+    }
+}
+
+/**
+ * @brief 키보드 상태를 보류하고 delay_us 뒤 디바운스 타이머로 반영 (뮤텍스 보유 상태에서 호출)
+ *
+ * 이미 보류 중이면 상태만 최신으로 바꾸고 기존 타이머를 유지합니다.
+ */
+static void kb_set_pending(uint8_t modifier, uint8_t keycode1, uint8_t keycode2, int64_t delay_us) {
+    kb_pending_modifier = modifier;
+    kb_pending_keycode1 = keycode1;
+    kb_pending_keycode2 = keycode2;
+    if (!kb_pending_valid) {
+        kb_pending_valid = true;
+        if (delay_us < KB_RETRY_US) delay_us = KB_RETRY_US;
+        kb_arm_debounce((uint64_t)delay_us);
+    }
+}
+
+/**
+ * @brief 디바운스 타이머 콜백 - 보류된 최신 상태를 반영
+ *
+ * 전송에 실패하면 상태를 보류한 채 1ms 뒤 다시 시도합니다. 보류 상태는 대개 키 해제이므로
+ * 버리면 prev_kb_* 가 눌림으로 남아 자동 반복이 계속되는 stuck 키가 됩니다.
+ * 보류 중에는 자동 반복도 멈춥니다 (kb_repeat_timer_cb).
+ */
+static void kb_debounce_timer_cb(void* arg) {
+    (void)arg;
+
+    if (xSemaphoreTake(kb_engine_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        ESP_LOGW(TAG, "Keyboard debounce: mutex timeout");
+        return;
+    }
+
+    if (kb_pending_valid) {
+        if (kb_apply_state(kb_pending_modifier, kb_pending_keycode1, kb_pending_keycode2)) {
+            kb_pending_valid = false;
+        } else {
+            ESP_LOGD(TAG, "Failed to apply debounced keyboard state, retrying");
+            kb_arm_debounce(KB_RETRY_US);
+        }
+    }
+
+    xSemaphoreGive(kb_engine_mutex);
+}
+
+/**
+ * @brief 자동 반복 타이머 콜백 - 눌린 키를 해제 후 다시 눌러 한 번 더 입력
+ *
+ * HID 키보드는 눌림 상태만 보고하므로, 해제 리포트(수정자는 유지) 직후
+ * 동일한 눌림 리포트를 보내 PC가 새 키 입력으로 인식하게 합니다.
+ * 첫 호출(초기 지연 만료) 시 주기 타이머로 전환합니다.
+ *
+ * 전송 실패는 다음 주기에 다시 시도합니다. 해제가 실패하면 누름을 보내지 않고(PC 상태 그대로),
+ * 누름만 실패하면 PC에는 잠시 해제로 보이지만 다음 주기의 해제(변화 없음) + 누름으로 복구됩니다.
+ */
+static void kb_repeat_timer_cb(void* arg) {
+    (void)arg;
+
+    unsigned int generation = atomic_load(&kb_repeat_generation);
+
+    if (xSemaphoreTake(kb_engine_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        ESP_LOGW(TAG, "Keyboard repeat: mutex timeout");
+        return;
+    }
+
+    // 이전 키의 만료: 뮤텍스를 기다리는 동안 타이머가 다시 설정되었거나(세대 변경),
+    // 디스패치 직전에 다시 설정되어 초기 지연 단계인데 타이머가 여전히 동작 중
+    if (generation != atomic_load(&kb_repeat_generation) ||
+        (!kb_repeat_periodic && esp_timer_is_active(kb_repeat_timer))) {
+        xSemaphoreGive(kb_engine_mutex);
+        return;
+    }
+
+    bool k1_repeat = kb_is_repeatable(prev_kb_keycode1);
+    bool k2_repeat = kb_is_repeatable(prev_kb_keycode2);
+
+    if (!k1_repeat && !k2_repeat) {
+        // 반복 대상 키가 이미 해제됨
+        kb_repeat_stop();
+    } else if (!kb_pending_valid) {
+        // 디바운스 보류 중인 변경이 있으면 이번 반복은 건너뜀
+        hid_keyboard_report_t release_report = {
+            .modifier = prev_kb_modifier,
+            .reserved = 0,
+            .keycode = { k1_repeat ? 0 : prev_kb_keycode1,
+                         k2_repeat ? 0 : prev_kb_keycode2, 0, 0, 0, 0 }
+        };
+        hid_keyboard_report_t press_report = {
+            .modifier = prev_kb_modifier,
+            .reserved = 0,
+            .keycode = { prev_kb_keycode1, prev_kb_keycode2, 0, 0, 0, 0 }
+        };
+        if (!sendKeyboardReport(&release_report)) {
+            ESP_LOGD(TAG, "Keyboard repeat: release report failed, retrying next tick");
+        } else if (!sendKeyboardReport(&press_report)) {
+            ESP_LOGW(TAG, "Keyboard repeat: re-press report failed, retrying next tick");
+        }
+
+        if (!kb_repeat_periodic) {
+            esp_err_t err = esp_timer_start_periodic(kb_repeat_timer,
+                                                     (uint64_t)KEYBOARD_REPEAT_INTERVAL_MS * 1000);
+            if (err == ESP_OK) {
+                kb_repeat_periodic = true;
+            } else {
+                ESP_LOGW(TAG, "Keyboard repeat: periodic start failed (%s)", esp_err_to_name(err));
+            }
+        }
+    }
+
+    xSemaphoreGive(kb_engine_mutex);
+}
+
+/**
+ * @brief 키보드 엔진 초기화 - 뮤텍스와 디바운스/반복 타이머 생성
+ *
+ * 생성에 실패하면 엔진 없이 기존처럼 상태 변경 즉시 전송합니다.
+ */
+static void kb_engine_init(void) {
+    kb_engine_mutex = xSemaphoreCreateMutex();
+    if (kb_engine_mutex == NULL) {
+        ESP_LOGE(TAG, "Failed to create keyboard engine mutex");
+        return;
+    }
+
+    const esp_timer_create_args_t debounce_args = {
+        .callback = kb_debounce_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "kb_debounce"
+    };
+    const esp_timer_create_args_t repeat_args = {
+        .callback = kb_repeat_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "kb_repeat"
+    };
+
+    if (esp_timer_create(&debounce_args, &kb_debounce_timer) != ESP_OK ||
+        esp_timer_create(&repeat_args, &kb_repeat_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create keyboard engine timers");
+        return;
+    }
+
+    ESP_LOGI(TAG, "Keyboard engine ready (debounce=%dms, repeat=%d/%dms)",
+             KEYBOARD_DEBOUNCE_MS, KEYBOARD_REPEAT_INITIAL_MS, KEYBOARD_REPEAT_INTERVAL_MS);
+}
+
+/**
+ * @brief 프레임의 키보드 상태를 엔진에 요청
+ *
+ * 동작:
+ * 1. 요청 상태가 이미 반영된 상태와 같으면 보류 중인 변경을 취소 (채터링 흡수)
+ * 2. 마지막 반영 후 디바운스 창이 지났으면 즉시 반영
+ * 3. 창 안이면 최신 상태로 보류하고 창이 끝나는 시점에 타이머로 반영
+ *
+ * 해제 상태도 버려지지 않고 창 종료 시(전송 실패 시 성공할 때까지) 반영되므로 키 stuck이 생기지 않습니다.
+ */
+static void kb_engine_request(uint8_t modifier, uint8_t keycode1, uint8_t keycode2) {
+    // 엔진 미초기화: 상태 변경 시 즉시 전송 (디바운스/반복 없음)
+    if (kb_engine_mutex == NULL || kb_debounce_timer == NULL) {
+        if (modifier != prev_kb_modifier || keycode1 != prev_kb_keycode1 ||
+            keycode2 != prev_kb_keycode2) {
+            hid_keyboard_report_t kb_report = {
+                .modifier = modifier,
+                .reserved = 0,
+                .keycode = { keycode1, keycode2, 0, 0, 0, 0 }
+            };
+            if (sendKeyboardReport(&kb_report)) {
+                prev_kb_modifier = modifier;
+                prev_kb_keycode1 = keycode1;
+                prev_kb_keycode2 = keycode2;
+            }
+        }
+        return;
+    }
+
+    if (xSemaphoreTake(kb_engine_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        ESP_LOGW(TAG, "Keyboard request: mutex timeout");
+        return;
+    }
+
+    kb_live_modifier = modifier;
+    kb_live_keycode1 = keycode1;
+    kb_live_keycode2 = keycode2;
+    if (kb_macro_active) {
+        // 매크로가 키보드를 점유 중: 재생 종료 시 hid_keyboard_macro_end()가 반영
+        xSemaphoreGive(kb_engine_mutex);
+        return;
+    }
+
+    bool same_as_applied = (modifier == prev_kb_modifier) &&
+                           (keycode1 == prev_kb_keycode1) &&
+                           (keycode2 == prev_kb_keycode2);
+
+    if (same_as_applied) {
+        if (kb_pending_valid) {
+            kb_pending_valid = false;
+            (void)esp_timer_stop(kb_debounce_timer);
+            ESP_LOGD(TAG, "Keyboard chatter absorbed (mod=0x%02x, k1=0x%02x)", modifier, keycode1);
+        }
+    } else {
+        int64_t elapsed_us = esp_timer_get_time() - kb_last_change_us;
+        int64_t window_us = (int64_t)KEYBOARD_DEBOUNCE_MS * 1000;
+
+        if (elapsed_us >= window_us && !kb_pending_valid) {
+            if (!kb_apply_state(modifier, keycode1, keycode2)) {
+                // 전송 실패: 버리지 않고 보류해 디바운스 타이머로 재시도
+                ESP_LOGW(TAG, "Failed to send keyboard report, retrying");
+                kb_set_pending(modifier, keycode1, keycode2, KB_RETRY_US);
+            }
+        } else {
+            kb_set_pending(modifier, keycode1, keycode2, window_us - elapsed_us);
+        }
+    }
+
+    xSemaphoreGive(kb_engine_mutex);
+}
+
+// ==================== 매크로 재생의 키보드 점유 ====================
+
+void hid_keyboard_macro_begin(void) {
+    if (kb_engine_mutex == NULL || xSemaphoreTake(kb_engine_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return;
+    }
+    kb_macro_active = true;
+    kb_pending_valid = false;
+    (void)esp_timer_stop(kb_debounce_timer);
+    kb_repeat_stop();
+    xSemaphoreGive(kb_engine_mutex);
+}
+
+bool hid_keyboard_macro_send(uint8_t modifier, uint8_t keycode1, uint8_t keycode2) {
+    hid_keyboard_report_t kb_report = {
+        .modifier = modifier,
+        .reserved = 0,
+        .keycode = { keycode1, keycode2, 0, 0, 0, 0 }
+    };
+
+    bool locked = (kb_engine_mutex != NULL &&
+                   xSemaphoreTake(kb_engine_mutex, pdMS_TO_TICKS(100)) == pdTRUE);
+    bool sent = sendKeyboardReport(&kb_report);
+    if (sent) {
+        // 매크로가 보낸 상태가 곧 PC에 반영된 상태 (매크로가 뗀 키를 엔진이 눌린 것으로 보지 않음)
+        prev_kb_modifier = modifier;
+        prev_kb_keycode1 = keycode1;
+        prev_kb_keycode2 = keycode2;
+        kb_last_change_us = esp_timer_get_time();
+    }
+    if (locked) {
+        xSemaphoreGive(kb_engine_mutex);
+    }
+    return sent;
+}
+
+void hid_keyboard_macro_end(void) {
+    if (kb_engine_mutex == NULL || xSemaphoreTake(kb_engine_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return;
+    }
+    kb_macro_active = false;
+    uint8_t modifier = kb_live_modifier;
+    uint8_t keycode1 = kb_live_keycode1;
+    uint8_t keycode2 = kb_live_keycode2;
+    xSemaphoreGive(kb_engine_mutex);
+
+    // 재생 중에도 누르고 있던 실시간 키를 다시 반영 (디바운스/반복 포함)
+    kb_engine_request(modifier, keycode1, keycode2);
+}
+
+// ==================== 포인터 다이나믹스 (가속) ====================
+// Android는 가속 전(raw) 델타를 보내고, 가속은 hid_task에서 코얼레싱 후 적용합니다.
+// 설정은 uart_task에서 들어오므로 대기 설정만 스핀락으로 넘기고,
+// s_pointer_dynamics 자체는 hid_task에서만 접근합니다.
+
+static pointer_dynamics_t s_pointer_dynamics;
+static portMUX_TYPE s_dynamics_config_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool s_dynamics_config_pending = false;
+static uint8_t s_dynamics_pending_preset = POINTER_DYNAMICS_OFF;
+static uint16_t s_dynamics_pending_counts_per_dp_q8 = POINTER_DYNAMICS_DEFAULT_COUNTS_PER_DP_Q8;
+
+static void dynamics_init(void)
+{
+    pointer_dynamics_init(&s_pointer_dynamics);
+}
+
+void hid_set_pointer_dynamics(uint8_t preset_id, uint16_t counts_per_dp_q8)
+{
+    taskENTER_CRITICAL(&s_dynamics_config_lock);
+    s_dynamics_pending_preset = preset_id;
+    s_dynamics_pending_counts_per_dp_q8 = counts_per_dp_q8;
+    s_dynamics_config_pending = true;
+    taskEXIT_CRITICAL(&s_dynamics_config_lock);
+}
+
+/**
+ * @brief 대기 중인 다이나믹스 설정을 반영 (hid_task 전용)
+ */
+static void dynamics_apply_pending_config(void)
+{
+    bool pending;
+    uint8_t preset_id;
+    uint16_t counts_per_dp_q8;
+
+    taskENTER_CRITICAL(&s_dynamics_config_lock);
+    pending = s_dynamics_config_pending;
+    preset_id = s_dynamics_pending_preset;
+    counts_per_dp_q8 = s_dynamics_pending_counts_per_dp_q8;
+    s_dynamics_config_pending = false;
+    taskEXIT_CRITICAL(&s_dynamics_config_lock);
+
+    if (!pending) {
+        return;
+    }
+    if (pointer_dynamics_configure(&s_pointer_dynamics, preset_id, counts_per_dp_q8)) {
+        ESP_LOGI(TAG, "Pointer dynamics: preset=%u, counts/dp=%u.%02u",
+                 preset_id, counts_per_dp_q8 >> 8, ((counts_per_dp_q8 & 0xFFu) * 100u) >> 8);
+    } else {
+        ESP_LOGW(TAG, "Invalid pointer dynamics config ignored (preset=%u, counts/dp_q8=%u)",
+                 preset_id, counts_per_dp_q8);
+    }
+}
+
+/**
+ * @brief 다음 프레임이 현재 프레임의 이동 연속인지 판정 (코얼레싱 조건)
+ *
+ * 버튼/키보드 상태가 같고 휠 합계가 리포트 범위를 넘지 않을 때만 합칩니다.
+ * 상태 변화가 있는 프레임은 절대 합치지 않으므로 클릭/키 입력 순서는 보존됩니다.
+ */
+static bool frame_is_motion_continuation(const bridge_frame_t *frame, int32_t wheel_sum,
+                                         const bridge_frame_t *next)
+{
+    int32_t merged_wheel = wheel_sum + next->wheel;
+    return next->buttons == frame->buttons &&
+           next->modifier == frame->modifier &&
+           next->keycode1 == frame->keycode1 &&
+           next->keycode2 == frame->keycode2 &&
+           merged_wheel >= -127 && merged_wheel <= 127;
+}
+
 // ==================== 모드 전환 시 입력 해제 처리 ====================
 
 /**
@@ -143,6 +733,15 @@ static void hid_on_mode_change(bridge_mode_t old_mode, bridge_mode_t new_mode)
     ESP_LOGI(TAG, "Mode transition: %s -> %s, releasing all inputs",
              bridge_mode_name(old_mode), bridge_mode_name(new_mode));
 
+    // 키보드: 보류 중인 디바운스 변경과 자동 반복을 취소
+    bool kb_locked = (kb_engine_mutex != NULL &&
+                      xSemaphoreTake(kb_engine_mutex, pdMS_TO_TICKS(100)) == pdTRUE);
+    if (kb_locked) {
+        kb_pending_valid = false;
+        (void)esp_timer_stop(kb_debounce_timer);
+        kb_repeat_stop();
+    }
+
     // 키보드: 키가 눌려있으면 모든 키 해제 리포트 전송
     if (prev_kb_modifier != 0 || prev_kb_keycode1 != 0 || prev_kb_keycode2 != 0) {
         hid_keyboard_report_t release_kb = {0};
@@ -150,9 +749,14 @@ static void hid_on_mode_change(bridge_mode_t old_mode, bridge_mode_t new_mode)
         prev_kb_modifier = 0;
         prev_kb_keycode1 = 0;
         prev_kb_keycode2 = 0;
+        kb_last_change_us = esp_timer_get_time();
         ESP_LOGI(TAG, "Keyboard release report sent (mode transition)");
     }
 
+    if (kb_locked) {
+        xSemaphoreGive(kb_engine_mutex);
+    }
+
     // 마우스: 버튼이 눌려있으면 모든 버튼 해제 리포트 전송
     if (prev_mouse_buttons != 0) {
         hid_mouse_report_t release_mouse = {
@@ -179,6 +783,79 @@ void hid_register_mode_callback(void)
     ESP_LOGI(TAG, "Mode change callback registered for input release");
 }
 
+#if HID_SUBMIT_MAILBOX
+// ==================== 메일박스 제출 (TinyUSB 태스크 전용) ====================
+
+/**
+ * @brief 메일박스의 가장 오래된 리포트를 HID 전송 시도
+ *
+ * TinyUSB 태스크(Core 1)에서만 호출됩니다 (hid_submit_service, 전송 완료 콜백).
+ * 제출에 성공해야 메일박스에서 제거하므로, busy/미마운트면 다음 기회까지 남아 있습니다.
+ * tud_hid_n_report()는 리포트를 엔드포인트 버퍼로 복사하므로 제출 직후 슬롯을 반납해도 됩니다.
+ *
+ * @param last_report 마지막 리포트 상태 저장소 (g_last_kb_report 또는 g_last_mouse_report)
+ */
+static void mailbox_submit(uint8_t instance, hid_mailbox_t* mb,
+                           void* last_report, size_t report_size) {
+    const hid_mailbox_slot_t* slot = hid_mailbox_peek(mb);
+    if (slot == NULL) return;
+
+    if (!tud_hid_n_ready(instance)) return;
+
+    uint32_t start = esp_cpu_get_cycle_count();
+    if (!tud_hid_n_report(instance, slot->report_id, slot->data, slot->len)) {
+        ESP_LOGW(TAG, "Failed to submit report (instance=%d), kept in mailbox", instance);
+        return;
+    }
+    hotpath_record(&s_hotpath_submit, esp_cpu_get_cycle_count() - start);
+    trace_recorder_event(TRACE_EV_HID_SUBMIT, instance, 0);
+
+    memcpy(last_report, slot->data, report_size);
+    hid_mailbox_pop(mb, esp_timer_get_time());
+}
+
+/**
+ * @brief 키보드/마우스 메일박스 제출 (usbd_defer_func()로 TinyUSB 태스크에서 실행)
+ */
+static void hid_submit_service(void* param) {
+    (void)param;
+    task_probe_wake(TASK_PROBE_USB);
+
+    // 먼저 플래그를 내려서, 이후 게시된 리포트는 새 이벤트로 다시 깨우게 함
+    atomic_store(&s_submit_scheduled, false);
+
+    mailbox_submit(ITF_NUM_HID_KEYBOARD, &s_kb_mailbox,
+                   &g_last_kb_report, sizeof(hid_keyboard_report_t));
+    mailbox_submit(ITF_NUM_HID_MOUSE, &s_mouse_mailbox,
+                   &g_last_mouse_report, sizeof(bridge_mouse_report_t));
+}
+
+/**
+ * @brief TinyUSB 태스크에 제출 요청 (이미 요청되어 있으면 생략)
+ */
+static void hid_submit_kick(void) {
+    if (!tud_inited()) return;
+    if (!atomic_exchange(&s_submit_scheduled, true)) {
+        task_probe_signal(TASK_PROBE_USB);
+        usbd_defer_func(hid_submit_service, NULL, false);
+    }
+}
+
+/**
+ * @brief 리포트 게시 후 TinyUSB 태스크 깨우기
+ *
+ * @return true 게시 성공, false 메일박스 가득 참 (리포트 버려짐)
+ */
+static bool mailbox_publish(hid_mailbox_t* mb, uint8_t report_id,
+                            const void* report, uint8_t len) {
+    bool ok = hid_mailbox_publish(mb, report_id, report, len, esp_timer_get_time());
+    trace_recorder_event(TRACE_EV_HID_PUBLISH,
+                         (mb == &s_kb_mailbox) ? ITF_NUM_HID_KEYBOARD : ITF_NUM_HID_MOUSE, 0);
+    hid_submit_kick();
+    return ok;
+}
+
+#else
 // ==================== 큐 처리 헬퍼 함수 ====================
 
 /**
@@ -199,7 +876,7 @@ static bool try_send_queued_report(uint8_t instance, uint8_t report_id,
                                    size_t report_size) {
     if (queue == NULL) return false;
 
-    // 최대 리포트 크기: keyboard(8) > mouse(4)
+    // 최대 리포트 크기: keyboard(8) > mouse(7)
     uint8_t report_buf[sizeof(hid_keyboard_report_t)];
 
     // Peek으로 큐 내용 확인 (제거하지 않음)
@@ -216,6 +893,7 @@ static bool try_send_queued_report(uint8_t instance, uint8_t report_id,
 
     // 전송 시도
     if (tud_hid_n_report(instance, report_id, report_buf, report_size)) {
+        trace_recorder_event(TRACE_EV_HID_SUBMIT, instance, 0);
         ESP_LOGD(TAG, "Queued report sent (instance=%d, report_id=%d)", instance, report_id);
         return true;
     }
@@ -225,6 +903,7 @@ static bool try_send_queued_report(uint8_t instance, uint8_t report_id,
     ESP_LOGW(TAG, "Failed to send queued report (instance=%d), re-queued", instance);
     return false;
 }
+#endif // HID_SUBMIT_MAILBOX
 
 // ==================== TinyUSB HID 콜백 함수 ====================
 
@@ -243,7 +922,8 @@ static bool try_send_queued_report(uint8_t instance, uint8_t report_id,
  * @return: 실제로 복사된 바이트 수 (0=데이터 없음, 또는 오류)
  * 
  * 구현 흐름:
- * 1. report_type이 INPUT인 경우만 처리 (Output/Feature는 0 반환)
+ * 1. Mouse Feature 리포트는 Resolution Multiplier 값 반환,
+ *    그 외에는 report_type이 INPUT인 경우만 처리 (Output/Feature는 0 반환)
  * 2. instance 값으로 Keyboard/Mouse 구분
  * 3. 각 인스턴스에 맞는 last_report를 버퍼에 복사
  * 4. 복사된 바이트 수 반환
@@ -251,8 +931,14 @@ static bool try_send_queued_report(uint8_t instance, uint8_t report_id,
 uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id,
                                 hid_report_type_t report_type,
                                 uint8_t* buffer, uint16_t reqlen) {
-    // Input Report 요청만 처리
-    // Output/Feature Report는 처리 불필요 (0 반환)
+    // Mouse Feature Report: 휠 Resolution Multiplier 현재 값
+    if (instance == ITF_NUM_HID_MOUSE && report_id == 2 &&
+        report_type == HID_REPORT_TYPE_FEATURE && reqlen >= 1) {
+        buffer[0] = s_resolution_multiplier;
+        return 1;
+    }
+
+    // 그 외에는 Input Report 요청만 처리
     if (report_type != HID_REPORT_TYPE_INPUT) {
         return 0;
     }
@@ -271,7 +957,7 @@ uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id,
         return len;
     } 
     else if (instance == ITF_NUM_HID_MOUSE && report_id == 2) {
-        // Mouse Instance - Boot Protocol 리포트 (4바이트)
+        // Mouse Instance - bridge_mouse_report_t (7바이트)
         uint16_t len = (reqlen < sizeof(g_last_mouse_report)) 
                        ? reqlen 
                        : sizeof(g_last_mouse_report);
@@ -304,6 +990,7 @@ uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id,
  * @param bufsize: 버퍼 크기
  * 
  * 구현 흐름:
+ * 0. Mouse Feature Report는 휠 Resolution Multiplier로 저장
  * 1. Keyboard Output Report만 처리
  * 2. buffer[0]에서 LED 상태 비트마스크 추출
  * 3. LED 상태를 전역 변수에 저장
@@ -313,7 +1000,23 @@ uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id,
 void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id,
                             hid_report_type_t report_type,
                             uint8_t const* buffer, uint16_t bufsize) {
-    (void)report_id;  // report_id 미사용 (Keyboard는 일반적으로 1)
+    (void)report_id;  // report_id 미사용 (Keyboard는 일반적으로 1, Mouse는 2)
+
+    // Mouse Feature Report: 호스트가 휠 Resolution Multiplier 설정 (고해상도 스크롤 활성화)
+    if (instance == ITF_NUM_HID_MOUSE && report_type == HID_REPORT_TYPE_FEATURE) {
+        if (bufsize >= 1) {
+            taskENTER_CRITICAL(&s_scroll_lock);
+            s_resolution_multiplier = buffer[0] & (HID_RES_MULT_WHEEL | HID_RES_MULT_PAN);
+            s_wheel_remainder_units = 0;
+            s_pan_remainder_units = 0;
+            taskEXIT_CRITICAL(&s_scroll_lock);
+
+            ESP_LOGI(TAG, "Mouse resolution multiplier: wheel=%s, pan=%s",
+                     (buffer[0] & HID_RES_MULT_WHEEL) ? "hi-res" : "detent",
+                     (buffer[0] & HID_RES_MULT_PAN) ? "hi-res" : "detent");
+        }
+        return;
+    }
 
     // Keyboard 인스턴스의 Output Report만 처리
     // Mouse는 Output Report를 사용하지 않으므로 무시
@@ -357,17 +1060,29 @@ void tud_hid_report_complete_cb(uint8_t instance, uint8_t const* report, uint16_
     (void)report;  // 미사용
     (void)len;     // 미사용
 
+    trace_recorder_event(TRACE_EV_HID_COMPLETE, instance, 0);
+
     if (instance == ITF_NUM_HID_KEYBOARD) {
         ESP_LOGD(TAG, "Keyboard report transfer completed");
+#if HID_SUBMIT_MAILBOX
+        mailbox_submit(ITF_NUM_HID_KEYBOARD, &s_kb_mailbox,
+                       &g_last_kb_report, sizeof(hid_keyboard_report_t));
+#else
         try_send_queued_report(ITF_NUM_HID_KEYBOARD, 1,
                                kb_report_queue, &g_last_kb_report,
                                sizeof(hid_keyboard_report_t));
+#endif
     }
     else if (instance == ITF_NUM_HID_MOUSE) {
         ESP_LOGD(TAG, "Mouse report transfer completed");
+#if HID_SUBMIT_MAILBOX
+        mailbox_submit(ITF_NUM_HID_MOUSE, &s_mouse_mailbox,
+                       &g_last_mouse_report, sizeof(bridge_mouse_report_t));
+#else
         try_send_queued_report(ITF_NUM_HID_MOUSE, 2,
                                mouse_report_queue, &g_last_mouse_report,
-                               sizeof(hid_mouse_report_t));
+                               sizeof(bridge_mouse_report_t));
+#endif
     }
 }
 
@@ -394,7 +1109,17 @@ bool sendKeyboardReport(const hid_keyboard_report_t* report) {
         ESP_LOGW(TAG, "sendKeyboardReport: report is NULL");
         return false;
     }
+    input_trace_record(INPUT_TRACE_KB_REPORT, report, sizeof(hid_keyboard_report_t));
 
+#if HID_SUBMIT_MAILBOX
+    // 게시만 하고 제출은 TinyUSB 태스크에 맡김 (Report ID 1: Boot Protocol Keyboard)
+    if (!mailbox_publish(&s_kb_mailbox, 1, report, sizeof(hid_keyboard_report_t))) {
+        ESP_LOGW(TAG, "Keyboard mailbox full, report dropped (mod=0x%02x, k1=0x%02x)",
+                 report->modifier, report->keycode[0]);
+        return false;
+    }
+    return true;
+#else
     uint8_t instance = ITF_NUM_HID_KEYBOARD;
 
     // 1. USB가 마운트되었고, 이전 전송이 완료되었는지 확인
@@ -424,6 +1149,7 @@ bool sendKeyboardReport(const hid_keyboard_report_t* report) {
         ESP_LOGE(TAG, "Failed to send keyboard report");
         return false;
     }
+    trace_recorder_event(TRACE_EV_HID_SUBMIT, instance, 0);
 
     // 키보드 리포트 전송 로그 (검증 완료 후 DEBUG 레벨로 변경)
     ESP_LOGD(TAG, "HID Keyboard report sent: modifiers=0x%02X keyCodes=[0x%02X,0x%02X,0x%02X,0x%02X,0x%02X,0x%02X]",
@@ -432,12 +1158,13 @@ bool sendKeyboardReport(const hid_keyboard_report_t* report) {
              report->keycode[3], report->keycode[4], report->keycode[5]);
 
     return true;
+#endif // HID_SUBMIT_MAILBOX
 }
 
 /**
- * @brief HID Mouse 리포트 전송
+ * @brief HID Mouse 리포트 전송 (전송 포맷 그대로)
  * 
- * @param report 전송할 마우스 리포트 (4바이트)
+ * @param report 전송할 마우스 리포트 (bridge_mouse_report_t, 휠 단위 변환 완료)
  * @return true 전송 성공, false 전송 실패
  * 
  * 동작:
@@ -446,12 +1173,20 @@ bool sendKeyboardReport(const hid_keyboard_report_t* report) {
  * 3. tud_hid_n_report()로 리포트 전송
  * 4. g_last_mouse_report 업데이트 (GET_REPORT 콜백용)
  */
-bool sendMouseReport(const hid_mouse_report_t* report) {
-    if (report == NULL) {
-        ESP_LOGW(TAG, "sendMouseReport: report is NULL");
+static bool send_mouse_wire_report(const bridge_mouse_report_t* report) {
+
+    s_mouse_buttons_requested = report->buttons;
+    input_trace_record(INPUT_TRACE_MOUSE_REPORT, report, sizeof(bridge_mouse_report_t));
+
+#if HID_SUBMIT_MAILBOX
+    // 게시만 하고 제출은 TinyUSB 태스크에 맡김
+    // (Report ID 2: BridgeOne Mouse, Boot 호환 + 고해상도 휠/AC Pan)
+    if (!mailbox_publish(&s_mouse_mailbox, 2, report, sizeof(bridge_mouse_report_t))) {
+        ESP_LOGW(TAG, "Mouse mailbox full, report dropped (btn=0x%02x)", report->buttons);
         return false;
     }
-
+    return true;
+#else
     uint8_t instance = ITF_NUM_HID_MOUSE;
 
     // 1. USB가 마운트되었고, 이전 전송이 완료되었는지 확인
@@ -473,24 +1208,105 @@ bool sendMouseReport(const hid_mouse_report_t* report) {
     }
 
     // 2. 상태 저장 (GET_REPORT 콜백용)
-    memcpy(&g_last_mouse_report, report, sizeof(hid_mouse_report_t));
+    memcpy(&g_last_mouse_report, report, sizeof(bridge_mouse_report_t));
 
     // 3. 리포트 전송
-    // Report ID 2: Boot Protocol Mouse
-    if (!tud_hid_n_report(instance, 2, report, sizeof(hid_mouse_report_t))) {
+    // Report ID 2: BridgeOne Mouse (Boot 호환 + 고해상도 휠/AC Pan)
+    if (!tud_hid_n_report(instance, 2, report, sizeof(bridge_mouse_report_t))) {
         ESP_LOGE(TAG, "Failed to send mouse report");
         return false;
     }
+    trace_recorder_event(TRACE_EV_HID_SUBMIT, instance, 0);
 
     // 디버그 로그: 전송된 마우스 리포트 정보
-    ESP_LOGD(TAG, "Mouse report sent: buttons=0x%02x, x=%d, y=%d, wheel=%d",
-             report->buttons, report->x, report->y, report->wheel);
+    ESP_LOGD(TAG, "Mouse report sent: buttons=0x%02x, x=%d, y=%d, wheel=%d, pan=%d",
+             report->buttons, report->x, report->y, report->wheel, report->pan);
 
     return true;
+#endif // HID_SUBMIT_MAILBOX
+}
+
+/**
+ * @brief 고해상도 단위 스크롤을 호스트 설정에 맞는 전송 단위로 변환
+ *
+ * @param units     고해상도 단위 (1/HID_WHEEL_UNITS_PER_DETENT 디텐트)
+ * @param hires     호스트가 해당 축의 Resolution Multiplier를 활성화했는지
+ * @param remainder 디텐트 모드의 이월 나머지 (s_scroll_lock 보호)
+ */
+static int16_t scroll_units_to_report(int32_t units, bool hires, int32_t* remainder) {
+    int32_t value;
+    if (hires) {
+        value = units;
+    } else {
+        *remainder += units;
+        value = *remainder / HID_WHEEL_UNITS_PER_DETENT;
+        *remainder -= value * HID_WHEEL_UNITS_PER_DETENT;
+    }
+    if (value > INT16_MAX) value = INT16_MAX;
+    if (value < -INT16_MAX) value = -INT16_MAX;
+    return (int16_t)value;
+}
+
+bool sendMouseReportHiRes(uint8_t buttons, int8_t x, int8_t y,
+                          int32_t wheel_units, int32_t pan_units) {
+    bridge_mouse_report_t report = {
+        .buttons = buttons,
+        .x = x,
+        .y = y,
+    };
+
+    taskENTER_CRITICAL(&s_scroll_lock);
+    report.wheel = scroll_units_to_report(wheel_units,
+                                          (s_resolution_multiplier & HID_RES_MULT_WHEEL) != 0,
+                                          &s_wheel_remainder_units);
+    report.pan = scroll_units_to_report(pan_units,
+                                        (s_resolution_multiplier & HID_RES_MULT_PAN) != 0,
+                                        &s_pan_remainder_units);
+    taskEXIT_CRITICAL(&s_scroll_lock);
+
+    // 디텐트 모드에서 1디텐트 미만 스크롤만 있는 리포트는 이월만 하고 생략
+    if ((wheel_units != 0 || pan_units != 0) && report.wheel == 0 && report.pan == 0 &&
+        x == 0 && y == 0 && buttons == s_mouse_buttons_requested) {
+        return true;
+    }
+
+    return send_mouse_wire_report(&report);
+}
+
+/**
+ * @brief HID Mouse 리포트 전송 (디텐트 단위 휠)
+ *
+ * 기존 호출자(매크로 엔진, HID 테스트 등)용 래퍼입니다.
+ */
+bool sendMouseReport(const hid_mouse_report_t* report) {
+    if (report == NULL) {
+        ESP_LOGW(TAG, "sendMouseReport: report is NULL");
+        return false;
+    }
+    return sendMouseReportHiRes(report->buttons, report->x, report->y,
+                                (int32_t)report->wheel * HID_WHEEL_UNITS_PER_DETENT,
+                                (int32_t)report->pan * HID_WHEEL_UNITS_PER_DETENT);
+}
+
+/**
+ * @brief USB 열거 완료 콜백 - Resolution Multiplier를 기본값(디텐트)으로 초기화
+ *
+ * HID 규격상 배율 기본값은 0이며, 고해상도를 지원하는 호스트는 열거 후
+ * Feature 리포트로 다시 설정합니다.
+ */
+void tud_mount_cb(void) {
+    taskENTER_CRITICAL(&s_scroll_lock);
+    s_resolution_multiplier = 0;
+    s_wheel_remainder_units = 0;
+    s_pan_remainder_units = 0;
+    taskEXIT_CRITICAL(&s_scroll_lock);
 }
 
 // ==================== BridgeFrame 처리 함수 ====================
 
+static void process_coalesced_frame(const bridge_frame_t* frame,
+                                    int32_t dx, int32_t dy, int32_t wheel);
+
 /**
  * @brief BridgeFrame 처리 및 HID 리포트로 변환
  * 
@@ -498,9 +1314,9 @@ bool sendMouseReport(const hid_mouse_report_t* report) {
  * 생성하고 호스트에 전송합니다.
  * 
  * 세부 동작:
- * 1. frame->modifier, frame->keycode1/keycode2 추출 → Keyboard 리포트 생성
- * 2. frame->buttons, frame->x, frame->y, frame->wheel 추출 → Mouse 리포트 생성
- * 3. sendKeyboardReport()로 키보드 리포트 전송
+ * 1. frame->modifier, frame->keycode1/keycode2 추출 → 키보드 엔진에 요청 (디바운스/자동 반복)
+ * 2. frame->x, frame->y (가속 전 raw) → 포인터 다이나믹스 적용
+ * 3. frame->buttons, 가속된 이동량, frame->wheel → Mouse 리포트 생성
  * 4. sendMouseReport()로 마우스 리포트 전송
  * 5. 에러 발생 시 로깅
  * 
@@ -521,56 +1337,58 @@ void processBridgeFrame(const bridge_frame_t* frame) {
         ESP_LOGE(TAG, "processBridgeFrame: frame is NULL");
         return;
     }
+    process_coalesced_frame(frame, frame->x, frame->y, frame->wheel);
+}
 
-    // ==================== Keyboard 리포트 생성 및 전송 ====================
-    // 조건: 이전 상태와 다를 때 (키 눌림 AND 키 해제 모두 감지)
-    bool kb_changed = (frame->modifier != prev_kb_modifier) ||
-                      (frame->keycode1 != prev_kb_keycode1) ||
-                      (frame->keycode2 != prev_kb_keycode2);
-
-    if (kb_changed) {
-        // Boot Protocol Keyboard 리포트 구성 (8바이트)
-        hid_keyboard_report_t kb_report = {
-            .modifier = frame->modifier,    // 바이트 0: Ctrl/Shift/Alt/GUI
-            .reserved = 0,                  // 바이트 1: 예약 필드 (0x00)
-            .keycode = {                    // 바이트 2-7: 키 코드 배열 (6-Key Rollover)
-                frame->keycode1,            // 첫 번째 키 코드
-                frame->keycode2,            // 두 번째 키 코드
-                0, 0, 0, 0                  // 나머지는 0 (미사용)
-            }
-        };
-
-        if (sendKeyboardReport(&kb_report)) {
-            // 전송 성공 시에만 이전 상태 업데이트
-            prev_kb_modifier = frame->modifier;
-            prev_kb_keycode1 = frame->keycode1;
-            prev_kb_keycode2 = frame->keycode2;
-            ESP_LOGD(TAG, "Keyboard state changed: mod=0x%02x, k1=0x%02x, k2=0x%02x",
-                     frame->modifier, frame->keycode1, frame->keycode2);
-        } else {
-            ESP_LOGW(TAG, "Failed to send keyboard report (seq=%d)", frame->seq);
-        }
+/**
+ * @brief 코얼레싱된 프레임 처리 (processBridgeFrame 본체)
+ *
+ * @param frame 마지막으로 합쳐진 프레임 (버튼/키보드 상태, seq)
+ * @param dx, dy 합쳐진 raw 이동량 합계 (가속 전)
+ * @param wheel  합쳐진 휠 합계 (-127 ~ 127)
+ */
+static void process_coalesced_frame(const bridge_frame_t* frame,
+                                    int32_t dx, int32_t dy, int32_t wheel) {
+    // ==================== Keyboard 상태 → 디바운스/자동 반복 엔진 ====================
+    // 변경 감지, 디바운스, 리포트 전송은 엔진이 처리합니다 (키 눌림 AND 키 해제 모두).
+    // 디바운스 창 안의 변경은 보류되었다가 창 종료 시 최신 상태로 반영됩니다.
+    kb_engine_request(frame->modifier, frame->keycode1, frame->keycode2);
+
+    // ==================== 포인터 다이나믹스 적용 ====================
+    // raw 이동량 → 속도 기반 배율 → 서브픽셀 누산 → 이번 리포트 정수 이동량
+    int32_t move_x = 0;
+    int32_t move_y = 0;
+    if (dx != 0 || dy != 0) {
+        // 재생 프레임은 기록된 시각을 사용 (배속/지터와 무관한 속도 추정)
+        pointer_dynamics_apply(&s_pointer_dynamics, dx, dy, input_trace_frame_time_us(frame->seq),
+                               &move_x, &move_y);
     }
 
     // ==================== Mouse 리포트 생성 및 전송 ====================
+    // buttons 상위 비트는 wheel 해석 플래그 (uart_handler.h BRIDGE_FLAG_*)
+    uint8_t buttons = frame->buttons & BRIDGE_BUTTONS_MASK;
+    int32_t scroll_units = (frame->buttons & BRIDGE_FLAG_HIRES_WHEEL)
+                               ? wheel
+                               : wheel * HID_WHEEL_UNITS_PER_DETENT;
+    bool horizontal = (frame->buttons & BRIDGE_FLAG_HWHEEL) != 0;
+
+    // 사용자가 직접 스크롤하면 진행 중인 펌웨어 관성 스크롤은 양보
+    if (wheel != 0 && scroll_inertia_is_active()) {
+        scroll_inertia_stop();
+    }
+
     // 조건: 이동/휠이 있거나, 버튼 상태가 변경될 때
-    bool mouse_has_movement = (frame->x != 0 || frame->y != 0 || frame->wheel != 0);
-    bool mouse_button_changed = (frame->buttons != prev_mouse_buttons);
+    bool mouse_has_movement = (move_x != 0 || move_y != 0 || wheel != 0);
+    bool mouse_button_changed = (buttons != prev_mouse_buttons);
 
     if (mouse_has_movement || mouse_button_changed) {
-        // Boot Protocol Mouse 리포트 구성 (4바이트)
-        hid_mouse_report_t mouse_report = {
-            .buttons = frame->buttons,      // 바이트 0: Left/Right/Middle 버튼
-            .x = frame->x,                  // 바이트 1: X축 상대 이동 (-127~127)
-            .y = frame->y,                  // 바이트 2: Y축 상대 이동 (-127~127)
-            .wheel = frame->wheel           // 바이트 3: 휠 스크롤
-        };
-
-        if (sendMouseReport(&mouse_report)) {
+        if (sendMouseReportHiRes(buttons, (int8_t)move_x, (int8_t)move_y,
+                                 horizontal ? 0 : scroll_units,
+                                 horizontal ? scroll_units : 0)) {
             // 버튼 상태 변경 시에만 이전 상태 업데이트
             if (mouse_button_changed) {
-                prev_mouse_buttons = frame->buttons;
-                ESP_LOGD(TAG, "Mouse button state changed: btn=0x%02x", frame->buttons);
+                prev_mouse_buttons = buttons;
+                ESP_LOGD(TAG, "Mouse button state changed: btn=0x%02x", buttons);
             }
         } else {
             ESP_LOGW(TAG, "Failed to send mouse report (seq=%d)", frame->seq);
@@ -579,10 +1397,28 @@ void processBridgeFrame(const bridge_frame_t* frame) {
 
     // 디버그 로그: 처리된 프레임 정보
     ESP_LOGD(TAG, "Bridge frame processed: seq=%d, kb=[mod=0x%02x, k1=0x%02x, k2=0x%02x], "
-             "mouse=[btn=0x%02x, x=%d, y=%d, wheel=%d]",
+             "mouse=[btn=0x%02x, raw=(%ld,%ld), out=(%ld,%ld), wheel=%ld]",
              frame->seq,
              frame->modifier, frame->keycode1, frame->keycode2,
-             frame->buttons, frame->x, frame->y, frame->wheel);
+             frame->buttons, (long)dx, (long)dy, (long)move_x, (long)move_y, (long)wheel);
+}
+
+/**
+ * @brief 한도 초과로 이월된 이동량 배출 (입력이 없는 주기에 호출)
+ */
+static void flush_pointer_carry(void) {
+    int32_t move_x;
+    int32_t move_y;
+    if (!pointer_dynamics_drain(&s_pointer_dynamics, &move_x, &move_y)) {
+        return;
+    }
+    hid_mouse_report_t mouse_report = {
+        .buttons = prev_mouse_buttons,
+        .x = (int8_t)move_x,
+        .y = (int8_t)move_y,
+        .wheel = 0
+    };
+    sendMouseReport(&mouse_report);
 }
 
 // ==================== HID 태스크 ====================
@@ -592,7 +1428,8 @@ void processBridgeFrame(const bridge_frame_t* frame) {
  * 
  * FreeRTOS 태스크로서 다음 동작을 반복 수행합니다:
  * 1. xQueueReceive()로 frame_queue에서 검증된 bridge_frame_t 수신 (100ms 타임아웃)
- * 2. processBridgeFrame()을 호출하여 Keyboard/Mouse 리포트 생성
+ * 2. 큐에 이미 도착한 연속 이동 프레임을 합산 (코얼레싱) 후
+ *    포인터 다이나믹스를 적용하여 Keyboard/Mouse 리포트 생성
  * 3. 각 리포트를 USB HID 인터페이스로 전송
  * 4. 다음 프레임을 대기
  * 
@@ -628,12 +1465,21 @@ void hid_task(void* param) {
     while (1) {
         // ==================== 0. 대기 큐 확인 및 재전송 (백업 메커니즘) ====================
         // 콜백(tud_hid_report_complete_cb)이 동작하지 않을 경우를 대비한 백업
+#if HID_SUBMIT_MAILBOX
+        // 제출은 TinyUSB 태스크 몫이므로 남은 리포트가 있으면 깨우기만 함
+        // (미마운트/서스펜드로 ready가 아니어서 남아 있던 리포트)
+        if (hid_mailbox_pending(&s_kb_mailbox) != 0 ||
+            hid_mailbox_pending(&s_mouse_mailbox) != 0) {
+            hid_submit_kick();
+        }
+#else
         try_send_queued_report(ITF_NUM_HID_KEYBOARD, 1,
                                kb_report_queue, &g_last_kb_report,
                                sizeof(hid_keyboard_report_t));
         try_send_queued_report(ITF_NUM_HID_MOUSE, 2,
                                mouse_report_queue, &g_last_mouse_report,
-                               sizeof(hid_mouse_report_t));
+                               sizeof(bridge_mouse_report_t));
+#endif
 
         // ==================== 1. UART 프레임 큐에서 수신 ====================
         // - 10ms 타임아웃으로 변경 (큐 확인 주기 증가)
@@ -643,10 +1489,37 @@ void hid_task(void* param) {
             &frame_buffer,                  // 수신 버퍼
             pdMS_TO_TICKS(10)               // 10ms 타임아웃 (100ms에서 단축)
         );
+        task_probe_wake(TASK_PROBE_HID);
+
+        // 다이나믹스 프리셋 변경 반영 (uart_task에서 요청)
+        dynamics_apply_pending_config();
 
         if (result == pdTRUE) {
-            // 2. 검증된 프레임 처리: Keyboard/Mouse 리포트 생성 및 전송
-            processBridgeFrame(&frame_buffer);
+            // 2. 코얼레싱: 이미 도착한 연속 이동 프레임을 하나의 리포트로 합침
+            //    (버튼/키 상태가 바뀌는 프레임은 합치지 않음)
+            int32_t sum_x = frame_buffer.x;
+            int32_t sum_y = frame_buffer.y;
+            int32_t sum_wheel = frame_buffer.wheel;
+            uint16_t frames = 1;
+            bridge_frame_t next_frame;
+            for (int merged = 0; merged < HID_MOUSE_COALESCE_MAX_FRAMES; merged++) {
+                if (xQueuePeek(frame_queue, &next_frame, 0) != pdTRUE ||
+                    !frame_is_motion_continuation(&frame_buffer, sum_wheel, &next_frame)) {
+                    break;
+                }
+                xQueueReceive(frame_queue, &next_frame, 0);
+                sum_x += next_frame.x;
+                sum_y += next_frame.y;
+                sum_wheel += next_frame.wheel;
+                frame_buffer.seq = next_frame.seq;
+                frames++;
+            }
+            trace_recorder_event(TRACE_EV_HID_FRAME, frames, frame_buffer.seq);
+
+            // 3. 검증된 프레임 처리: Keyboard/Mouse 리포트 생성 및 전송
+            uint32_t start = esp_cpu_get_cycle_count();
+            process_coalesced_frame(&frame_buffer, sum_x, sum_y, sum_wheel);
+            hotpath_record(&s_hotpath_process, esp_cpu_get_cycle_count() - start);
 
             // 워치독 리셋 (무한 루프 방지)
             esp_task_wdt_reset();
@@ -661,6 +1534,9 @@ void hid_task(void* param) {
         }
         else {
             // 타임아웃 (정상 상황): 10ms 동안 프레임이 없음
+            // ±127 한도로 이월된 이동량이 남아 있으면 이어서 전송
+            flush_pointer_carry();
+
             // 워치독 리셋 (무한 루프 방지)
             esp_task_wdt_reset();
 
@@ -693,3 +1569,37 @@ void hid_task(void* param) {
 uint8_t hid_get_keyboard_led_status(void) {
     return g_hid_keyboard_led_status;
 }
+
+// ==================== 제출 경로 상태 조회 ====================
+
+bool hid_mouse_ready_for_report(void) {
+#if HID_SUBMIT_MAILBOX
+    return hid_mailbox_pending(&s_mouse_mailbox) == 0;
+#else
+    return tud_hid_n_ready(ITF_NUM_HID_MOUSE);
+#endif
+}
+
+uint8_t hid_get_mouse_buttons(void) {
+    return s_mouse_buttons_requested;
+}
+
+bool hid_get_submit_stats(hid_mailbox_stats_t* kb, hid_mailbox_stats_t* mouse) {
+#if HID_SUBMIT_MAILBOX
+    hid_mailbox_get_stats(&s_kb_mailbox, kb);
+    hid_mailbox_get_stats(&s_mouse_mailbox, mouse);
+    return true;
+#else
+    (void)kb;
+    (void)mouse;
+    return false;
+#endif
+}
+
+size_t hid_handler_static_ram_bytes(void) {
+#if HID_SUBMIT_MAILBOX
+    return sizeof(s_kb_mailbox) + sizeof(s_mouse_mailbox);
+#else
+    return 0;
+#endif
+}
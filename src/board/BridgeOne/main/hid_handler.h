@@ -18,9 +18,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "tusb.h"
 #include "class/hid/hid.h"  // HID_REPORT_TYPE_* 매크로 및 리포트 구조체 사용 필수
 #include "uart_handler.h"  // bridge_frame_t 정의 및 frame_queue 사용 필수
+#include "hid_mailbox.h"   // hid_mailbox_stats_t (hid_get_submit_stats)
 
 // ==================== HID 리포트 구조체 (TinyUSB에서 제공) ====================
 
@@ -64,6 +66,27 @@
 //     int8_t  wheel;
 // } hid_mouse_report_t;  // hid.h에서 정의됨
 
+/**
+ * @brief BridgeOne Mouse 리포트 (7바이트, Report ID 2로 전송)
+ *
+ * usb_descriptors.c의 마우스 Report Descriptor와 1:1로 대응하는 실제 전송 포맷입니다.
+ * 앞 3바이트(buttons, x, y)는 Boot Protocol Mouse와 동일합니다.
+ *
+ * wheel/pan 단위는 호스트의 Resolution Multiplier 설정에 따릅니다:
+ * - 활성 (Windows/Linux): 1/HID_WHEEL_UNITS_PER_DETENT 디텐트
+ * - 비활성 (BIOS 등): 디텐트
+ * 호출자는 항상 고해상도 단위로 넘기고, 변환은 sendMouseReportHiRes()가 담당합니다.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t buttons;    // Left/Right/Middle/Back/Forward
+    int8_t  x;          // X축 상대 이동 (-127 ~ 127)
+    int8_t  y;          // Y축 상대 이동 (-127 ~ 127)
+    int16_t wheel;      // 수직 휠 (-32767 ~ 32767)
+    int16_t pan;        // 수평 휠, AC Pan (-32767 ~ 32767)
+} bridge_mouse_report_t;
+
+_Static_assert(sizeof(bridge_mouse_report_t) == 7, "bridge_mouse_report_t must be 7 bytes");
+
 // ==================== Keyboard LED 상태 정의 ====================
 
 /**
@@ -75,6 +98,49 @@
 #define KEYBOARD_LED_CAPSLOCK   0x02    // Caps Lock
 #define KEYBOARD_LED_SCROLLLOCK 0x04    // Scroll Lock
 
+// ==================== Keyboard 디바운스/자동 반복 타이밍 ====================
+
+/**
+ * @brief 키보드 타이밍 상수 (docs/technical-specification.md §2.4.6.2)
+ *
+ * Android는 키 누름/해제 프레임 한 쌍만 전송하고,
+ * 디바운스와 자동 반복(typematic)은 ESP32-S3에서 esp_timer로 처리합니다.
+ * - DEBOUNCE: 상태 변경 후 이 시간 동안의 추가 변경은 보류 후 마지막 상태만 반영
+ * - REPEAT_INITIAL: 키를 누른 뒤 첫 반복까지의 지연
+ * - REPEAT_INTERVAL: 이후 반복 간격
+ */
+#define KEYBOARD_DEBOUNCE_MS         40    // 키보드 디바운싱
+#define KEYBOARD_REPEAT_INITIAL_MS  300    // 초기 반복 지연
+#define KEYBOARD_REPEAT_INTERVAL_MS  30    // 반복 간격
+
+// ==================== Mouse 이동 코얼레싱 ====================
+
+/**
+ * @brief 한 리포트로 합칠 수 있는 추가 프레임 수
+ *
+ * hid_task는 프레임 하나를 받은 뒤 큐에 이미 도착해 있는 연속 이동 프레임
+ * (버튼/키 상태 동일)을 최대 이 개수만큼 합산하고, 합계에 포인터 다이나믹스를
+ * 적용합니다 (pointer_dynamics.h).
+ */
+#define HID_MOUSE_COALESCE_MAX_FRAMES  8
+
+// ==================== 리포트 제출 경로 ====================
+
+/**
+ * @brief HID 리포트 제출 방식
+ *
+ * 1 (기본): Core 0 생산자(hid_task, esp_timer 콜백)는 hid_mailbox에 게시만 하고,
+ *           Core 1의 TinyUSB 태스크가 tud_hid_n_ready()/tud_hid_n_report()를 전담합니다.
+ *           (게시 시 usbd_defer_func()로 TinyUSB 태스크를 깨우고, 전송 완료 콜백에서 이어서 제출)
+ * 0: 이전 방식. 생산자가 직접 제출하고, busy이면 FreeRTOS 대기 큐에 넣어
+ *    전송 완료 콜백/hid_task가 재전송합니다.
+ *
+ * CDC "hidstat" 명령으로 게시 → 제출 지연을 확인할 수 있습니다.
+ */
+#ifndef HID_SUBMIT_MAILBOX
+#define HID_SUBMIT_MAILBOX  1
+#endif
+
 // ==================== HID 콜백 함수 선언 ====================
 // (usb_descriptors.c에서 구현되었지만, hid_handler.c에서 재정의될 수 있음)
 
@@ -153,13 +219,27 @@ bool sendKeyboardReport(const hid_keyboard_report_t* report);
  * 준비된 mouse 리포트를 USB HID Mouse 인터페이스(ITF_NUM_HID_MOUSE)로
  * 전송합니다. 이전 전송 완료 여부를 확인한 후 새 데이터를 전송합니다.
  * 
- * @param report 전송할 마우스 리포트 (4바이트)
+ * @param report 전송할 마우스 리포트 (wheel/pan은 디텐트 단위)
  * @return true 전송 성공, false 전송 실패 (USB 미연결 등)
  * 
- * @note Phase 2.1.2.3에서 구현됨
+ * @note Phase 2.1.2.3에서 구현됨. 내부적으로 sendMouseReportHiRes()를 사용합니다.
  */
 bool sendMouseReport(const hid_mouse_report_t* report);
 
+/**
+ * @brief 고해상도 휠 단위로 HID Mouse 리포트 전송
+ *
+ * wheel_units/pan_units는 1/HID_WHEEL_UNITS_PER_DETENT 디텐트 단위입니다.
+ * 호스트가 Resolution Multiplier를 활성화하지 않았으면 디텐트로 환산하고
+ * 1디텐트 미만의 나머지는 다음 호출로 이월합니다 (이때 스크롤만 있는 리포트는 생략).
+ *
+ * hid_task와 esp_timer 태스크(관성 스크롤)에서 호출됩니다.
+ *
+ * @return true 전송/큐 저장 성공 (또는 이월만 하고 생략), false 전송 실패
+ */
+bool sendMouseReportHiRes(uint8_t buttons, int8_t x, int8_t y,
+                          int32_t wheel_units, int32_t pan_units);
+
 /**
  * @brief 현재 키보드 LED 상태 조회
  *
@@ -181,6 +261,8 @@ uint8_t hid_get_keyboard_led_status(void);
  * - 키 해제 리포트 누락 방지 (키 stuck 문제 해결)
  * - 마우스 버튼 해제 리포트 누락 방지 (드래그 stuck 문제 해결)
  *
+ * 키보드 디바운스/자동 반복 엔진의 뮤텍스와 esp_timer도 함께 생성합니다.
+ *
  * @note app_main()에서 HID 태스크 생성 전에 호출해야 합니다.
  */
 void hid_init_queues(void);
@@ -197,12 +279,105 @@ void hid_init_queues(void);
  */
 void hid_register_mode_callback(void);
 
+/**
+ * @brief 포인터 다이나믹스 프리셋 설정 요청
+ *
+ * uart_task(UART_QUERY_SET_DYNAMICS)에서 호출되며, 실제 반영은 hid_task가
+ * 다음 루프에서 수행합니다. 잘못된 값은 그때 로그를 남기고 무시됩니다.
+ *
+ * @param preset_id        프리셋 ID (pointer_dynamics_preset_t, Android DYNAMICS_PRESETS 인덱스)
+ * @param counts_per_dp_q8 dp 1당 입력 카운트 (Q8.8, 화면 밀도 × DPI 배율)
+ */
+void hid_set_pointer_dynamics(uint8_t preset_id, uint16_t counts_per_dp_q8);
+
+/**
+ * @brief 매크로 재생의 키보드 점유 시작 / 스텝 전송 / 종료
+ *
+ * 재생 중에는 키보드 엔진(디바운스/자동 반복)을 멈추고 매크로 스텝만 PC에 보냅니다.
+ * 그동안 들어온 실시간 키 상태는 최신 값만 기억했다가 종료 시 엔진에 다시 요청하므로,
+ * 재생 중 누르고 있던 키는 재생이 끝나면 다시 눌립니다.
+ * hid_keyboard_macro_send()로 보낸 상태는 엔진의 "PC에 반영된 상태"가 되므로
+ * 매크로가 뗀 키를 엔진이 눌린 것으로 보고 반복하지 않습니다.
+ *
+ * macro_engine.c(esp_timer 태스크)에서 호출합니다.
+ */
+void hid_keyboard_macro_begin(void);
+bool hid_keyboard_macro_send(uint8_t modifier, uint8_t keycode1, uint8_t keycode2);
+void hid_keyboard_macro_end(void);
+
+/**
+ * @brief 마우스 리포트를 바로 제출할 수 있는지 확인
+ *
+ * 관성 스크롤 타이머가 누적량을 리포트로 꺼낼지 판단할 때 사용합니다.
+ * 메일박스 모드에서는 대기 중인 마우스 리포트가 없을 때 true
+ * (생산자가 USB 엔드포인트 상태를 직접 읽지 않음), 이전 방식에서는 tud_hid_n_ready().
+ */
+bool hid_mouse_ready_for_report(void);
+
+/**
+ * @brief 마지막으로 전송 요청한 마우스 버튼 상태
+ *
+ * g_last_mouse_report(Core 1에서 제출 시 갱신)와 달리 생산자 쪽에서 관리하므로
+ * 스크롤/이동 리포트에 현재 버튼 상태를 실을 때 사용합니다.
+ */
+uint8_t hid_get_mouse_buttons(void);
+
+/**
+ * @brief 리포트 게시 → 제출 통계 조회 (CDC "hidstat" 명령용)
+ *
+ * @return false: 메일박스 모드가 아님 (HID_SUBMIT_MAILBOX == 0)
+ */
+bool hid_get_submit_stats(hid_mailbox_stats_t* kb, hid_mailbox_stats_t* mouse);
+
+/**
+ * @brief 리포트 전달 경로의 정적 RAM 크기 (메모리 보고서용)
+ *
+ * 메일박스 모드: 메일박스 2개. 큐 모드: 0 (큐 저장소는 힙에 할당)
+ */
+size_t hid_handler_static_ram_bytes(void);
+
+// ==================== 핫 경로 계측 ====================
+
+/**
+ * @brief 정지(stall)로 간주하는 핫 경로 1회 처리 시간 (µs)
+ *
+ * 캐시에 올라와 있는 경로는 수 µs 안에 끝나므로, 이를 넘으면 플래시 캐시 미스
+ * (또는 상위 우선순위 태스크의 선점)로 봅니다. ESP32-S3는 플래시 캐시 미스 카운터를
+ * 노출하지 않으므로 CPU 사이클 측정으로 대신합니다.
+ */
+#define HID_HOTPATH_STALL_US  20
+
+/**
+ * @brief 핫 경로 처리 시간 통계 (CPU 사이클)
+ */
+typedef struct {
+    uint32_t count;        // 측정 횟수
+    uint32_t cycles_min;   // 최소
+    uint32_t cycles_avg;   // 평균
+    uint32_t cycles_max;   // 최대
+    uint32_t stalls;       // HID_HOTPATH_STALL_US 초과 횟수
+} hid_hotpath_stats_t;
+
+/**
+ * @brief 핫 경로 통계 조회 (CDC "hotpath" 명령용, 다른 코어에서 읽으면 근사값)
+ *
+ * @param process hid_task의 프레임 1회 처리 (코얼레싱 → 다이나믹스 → 게시)
+ * @param submit  TinyUSB 태스크의 리포트 1회 제출 (tud_hid_n_report → dcd_edpt_xfer)
+ */
+void hid_get_hotpath_stats(hid_hotpath_stats_t* process, hid_hotpath_stats_t* submit);
+
+/**
+ * @brief 핫 경로 통계 초기화 요청 (각 측정 태스크가 다음 기록 시 반영)
+ */
+void hid_reset_hotpath_stats(void);
+
 // ==================== HID 상태 저장소 ====================
 
 /**
  * @brief 마지막으로 전송된 Keyboard 리포트
  * 
  * tud_hid_get_report_cb()에서 반환될 상태 저장
+ * (메일박스 모드에서는 TinyUSB 태스크만 갱신)
  */
 extern hid_keyboard_report_t g_last_kb_report;
 
@@ -210,8 +385,9 @@ extern hid_keyboard_report_t g_last_kb_report;
  * @brief 마지막으로 전송된 Mouse 리포트
  * 
  * tud_hid_get_report_cb()에서 반환될 상태 저장
+ * (메일박스 모드에서는 TinyUSB 태스크만 갱신)
  */
-extern hid_mouse_report_t g_last_mouse_report;
+extern bridge_mouse_report_t g_last_mouse_report;
 
 /**
  * @brief 키보드 LED 상태 버퍼
@@ -0,0 +1,116 @@
+/**
+ * @file hid_mailbox.c
+ * @brief HID 리포트 메일박스 구현
+ *
+ * 참조: hid_mailbox.h
+ */
+
+#include "hid_mailbox.h"
+#include <string.h>
+
+#define SLOT_MASK  (HID_MAILBOX_SLOTS - 1u)
+
+_Static_assert((HID_MAILBOX_SLOTS & SLOT_MASK) == 0, "HID_MAILBOX_SLOTS must be a power of 2");
+
+void hid_mailbox_init(hid_mailbox_t *mb)
+{
+    for (uint32_t i = 0; i < HID_MAILBOX_SLOTS; i++) {
+        atomic_init(&mb->slots[i].seq, i);
+        mb->slots[i].report_id  = 0;
+        mb->slots[i].len        = 0;
+        mb->slots[i].publish_us = 0;
+    }
+    atomic_init(&mb->head, 0u);
+    atomic_init(&mb->dropped, 0u);
+    atomic_init(&mb->tail, 0u);
+    mb->latency_sum_us = 0;
+    mb->latency_max_us = 0;
+}
+
+bool hid_mailbox_publish(hid_mailbox_t *mb, uint8_t report_id,
+                         const void *report, uint8_t len, int64_t now_us)
+{
+    if (len > HID_MAILBOX_REPORT_MAX) {
+        return false;
+    }
+
+    hid_mailbox_slot_t *slot;
+    unsigned pos = atomic_load_explicit(&mb->head, memory_order_relaxed);
+
+    for (;;) {
+        slot = &mb->slots[pos & SLOT_MASK];
+        unsigned seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            // 빈 슬롯: 예약 시도 (다른 생산자가 먼저 가져가면 pos가 갱신되어 재시도)
+            if (atomic_compare_exchange_weak_explicit(&mb->head, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 소비자가 아직 반납하지 않은 슬롯: 가득 참
+            atomic_fetch_add_explicit(&mb->dropped, 1u, memory_order_relaxed);
+            return false;
+        } else {
+            // 다른 생산자가 이미 예약함
+            pos = atomic_load_explicit(&mb->head, memory_order_relaxed);
+        }
+    }
+
+    slot->report_id  = report_id;
+    slot->len        = len;
+    slot->publish_us = now_us;
+    memcpy(slot->data, report, len);
+
+    // 본문 기록 후 공개
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return true;
+}
+
+const hid_mailbox_slot_t *hid_mailbox_peek(hid_mailbox_t *mb)
+{
+    unsigned tail = atomic_load_explicit(&mb->tail, memory_order_relaxed);
+    hid_mailbox_slot_t *slot = &mb->slots[tail & SLOT_MASK];
+    unsigned seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+    // 예약만 되고 아직 기록 중인 슬롯도 비어 있는 것으로 봄 (순서 보존)
+    return (seq == tail + 1) ? slot : NULL;
+}
+
+void hid_mailbox_pop(hid_mailbox_t *mb, int64_t now_us)
+{
+    unsigned tail = atomic_load_explicit(&mb->tail, memory_order_relaxed);
+    hid_mailbox_slot_t *slot = &mb->slots[tail & SLOT_MASK];
+
+    int64_t latency_us = now_us - slot->publish_us;
+    mb->latency_sum_us += latency_us;
+    if (latency_us > mb->latency_max_us) {
+        mb->latency_max_us = latency_us;
+    }
+
+    // 슬롯 반납: 다음 바퀴의 생산자가 사용할 수 있음
+    atomic_store_explicit(&slot->seq, tail + HID_MAILBOX_SLOTS, memory_order_release);
+    atomic_store_explicit(&mb->tail, tail + 1, memory_order_relaxed);
+}
+
+uint32_t hid_mailbox_pending(const hid_mailbox_t *mb)
+{
+    unsigned tail = atomic_load_explicit(&mb->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&mb->head, memory_order_relaxed);
+    return head - tail;
+}
+
+void hid_mailbox_get_stats(const hid_mailbox_t *mb, hid_mailbox_stats_t *out)
+{
+    unsigned tail = atomic_load_explicit(&mb->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&mb->head, memory_order_relaxed);
+
+    out->published      = head;
+    out->submitted      = tail;
+    out->dropped        = atomic_load_explicit(&mb->dropped, memory_order_relaxed);
+    out->pending        = head - tail;
+    out->latency_avg_us = (tail > 0) ? mb->latency_sum_us / (int64_t)tail : 0;
+    out->latency_max_us = mb->latency_max_us;
+}
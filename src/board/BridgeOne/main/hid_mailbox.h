@@ -0,0 +1,126 @@
+/**
+ * @file hid_mailbox.h
+ * @brief HID 리포트 메일박스 - 락프리 다중 생산자/단일 소비자 링
+ *
+ * 역할:
+ * - Core 0의 생산자(hid_task, esp_timer 콜백, 매크로/모드 전환)가 전송할 리포트를 게시
+ * - Core 1의 USB 태스크(소비자)만 꺼내서 tud_hid_n_report()로 제출
+ *   → 엔드포인트 claim/release와 g_last_* 상태를 한 코어만 만짐
+ *
+ * 구조 (슬롯별 시퀀스 번호를 쓰는 bounded 큐):
+ * - 생산자: head를 CAS로 예약 → 슬롯 기록 → seq = pos + 1 (release)
+ * - 소비자: seq == tail + 1 이면 읽기 → seq = tail + SLOTS (release) 로 반납
+ * 뮤텍스/스핀락이 없으므로 생산자끼리 선점되어도, 코어가 달라도 안전합니다.
+ *
+ * 리포트는 덮어쓰지 않고 순서대로 전달합니다 (키 반복의 해제+누름, 클릭의 누름+해제 보존).
+ * 이동량 합산은 생산자(hid_task 코얼레싱)가 게시 전에 처리합니다.
+ *
+ * 핫 경로에서 공유되는 쓰기는 슬롯 1개 + head뿐이며, 통계는 head/tail과
+ * 소비자 전용 필드로 계산하므로 추가 공유 쓰기가 없습니다.
+ * 이 모듈은 ESP-IDF API에 의존하지 않으므로 호스트에서 단위 테스트합니다 (test/host/).
+ */
+
+#ifndef HID_MAILBOX_H
+#define HID_MAILBOX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// ==================== 상수 ====================
+
+/** 슬롯 수 (2의 거듭제곱). 기존 리포트 대기 큐(10개)보다 약간 여유 있게 */
+#define HID_MAILBOX_SLOTS        16
+
+/** 리포트 최대 크기: keyboard(8) > mouse(7) */
+#define HID_MAILBOX_REPORT_MAX   8
+
+/**
+ * 생산자/소비자가 쓰는 필드를 분리할 정렬 단위.
+ * ESP32-S3 내부 SRAM은 데이터 캐시를 거치지 않지만, 호스트 테스트와 PSRAM 배치에서
+ * head(생산자)와 tail(소비자)이 같은 캐시 라인을 주고받지 않도록 나눕니다.
+ */
+#define HID_MAILBOX_LINE_SIZE    64
+
+// ==================== 상태 ====================
+
+/**
+ * 리포트 슬롯.
+ */
+typedef struct {
+    atomic_uint seq;                            // 슬롯 시퀀스 (게시/반납 동기화)
+    uint8_t     report_id;                      // HID Report ID
+    uint8_t     len;                            // 리포트 길이
+    uint8_t     data[HID_MAILBOX_REPORT_MAX];   // 리포트 본문
+    int64_t     publish_us;                     // 게시 시각 (제출 지연 측정용)
+} hid_mailbox_slot_t;
+
+/**
+ * 메일박스 (인터페이스마다 1개, 정적 할당).
+ */
+typedef struct {
+    hid_mailbox_slot_t slots[HID_MAILBOX_SLOTS];
+
+    // 생산자 쪽
+    _Alignas(HID_MAILBOX_LINE_SIZE) atomic_uint head;   // 다음 예약 위치 (= 누적 게시 수)
+    atomic_uint dropped;                                // 가득 차서 버린 리포트 수
+
+    // 소비자 쪽 (tail은 다른 코어의 대기 여부 확인용으로만 atomic)
+    _Alignas(HID_MAILBOX_LINE_SIZE) atomic_uint tail;   // 다음 꺼낼 위치 (= 누적 제출 수)
+    int64_t  latency_sum_us;                            // 게시 → 제출 지연 합계
+    int64_t  latency_max_us;                            // 게시 → 제출 지연 최대
+} hid_mailbox_t;
+
+/**
+ * 메일박스 통계 (진단용, 다른 코어에서 읽으면 근사값).
+ */
+typedef struct {
+    uint32_t published;         // 게시된 리포트 수
+    uint32_t submitted;         // 제출(꺼냄) 완료 수
+    uint32_t dropped;           // 가득 차서 버린 수
+    uint32_t pending;           // 현재 대기 중인 수
+    int64_t  latency_avg_us;    // 게시 → 제출 평균 지연
+    int64_t  latency_max_us;    // 게시 → 제출 최대 지연
+} hid_mailbox_stats_t;
+
+// ==================== API ====================
+
+/**
+ * 메일박스 초기화 (생산자/소비자 시작 전 1회).
+ */
+void hid_mailbox_init(hid_mailbox_t *mb);
+
+/**
+ * 리포트 게시 (생산자, 여러 태스크/코어에서 동시 호출 가능).
+ *
+ * @param now_us 게시 시각 (esp_timer_get_time() 등, 지연 통계용)
+ * @return true: 게시됨, false: 가득 참 또는 길이 초과 (버려짐)
+ */
+bool hid_mailbox_publish(hid_mailbox_t *mb, uint8_t report_id,
+                         const void *report, uint8_t len, int64_t now_us);
+
+/**
+ * 가장 오래된 리포트 조회 (소비자 전용, 제거하지 않음).
+ *
+ * @return 슬롯 포인터, 비어 있으면 NULL. hid_mailbox_pop() 전까지 유효합니다.
+ */
+const hid_mailbox_slot_t *hid_mailbox_peek(hid_mailbox_t *mb);
+
+/**
+ * hid_mailbox_peek()로 조회한 리포트 제거 (소비자 전용, 제출 성공 후 호출).
+ *
+ * @param now_us 제출 시각 (지연 통계용)
+ */
+void hid_mailbox_pop(hid_mailbox_t *mb, int64_t now_us);
+
+/**
+ * 대기 중인 리포트 수 (어느 쪽에서나 호출 가능, 근사값).
+ */
+uint32_t hid_mailbox_pending(const hid_mailbox_t *mb);
+
+/**
+ * 통계 조회.
+ */
+void hid_mailbox_get_stats(const hid_mailbox_t *mb, hid_mailbox_stats_t *out);
+
+#endif // HID_MAILBOX_H
@@ -2,8 +2,9 @@
  * @file hid_test.c
  * @brief BridgeOne HID 테스트 모드 구현
  *
- * Android 없이 ESP32-S3 보드 자체에서 테스트 HID 데이터를 생성하여
- * PC에서 마우스/키보드 제어가 정상 작동하는지 검증합니다.
+ * Android 없이 ESP32-S3 보드 자체에서 테스트 입력(bridge_frame_t 트레이스)을 생성하고
+ * 입력 트레이스 재생기로 주입하여 PC에서 마우스/키보드 제어가 정상 작동하는지 검증합니다.
+ * 리포트를 직접 보내지 않으므로 실제 입력과 같은 경로(hid_task)를 검증합니다.
  */
 
 #include <string.h>
@@ -14,6 +15,7 @@
 #include "esp_task_wdt.h"
 #include "hid_test.h"
 #include "hid_handler.h"
+#include "input_trace.h"
 #include "class/hid/hid.h"
 
 // ==================== 로깅 설정 ====================
@@ -22,193 +24,140 @@ static const char* TAG = "HID_TEST";
 // ==================== 테스트 모드 전역 변수 ====================
 bool g_hid_test_mode = false;
 
-// ==================== 테스트 함수 구현 ====================
+// ==================== 시나리오 생성 ====================
 
 /**
- * @brief 마우스 원형 이동 테스트
- *
- * 원형 궤적을 그리는 마우스 이동 HID 리포트를 생성합니다.
- * - 반지름: 30 픽셀
- * - 각도: 0도부터 360도까지 10도씩 증가
- * - 각 단계마다 50ms 대기
+ * @brief 시나리오 작성 상태 (합성 시각과 seq)
  */
-void test_mouse_circle_movement(void) {
-    ESP_LOGI(TAG, "Starting mouse circle movement test...");
+typedef struct {
+    uint32_t t_us;      // 다음 프레임 타임스탬프
+    uint8_t  seq;       // 다음 프레임 seq (0~253, 0xFE/0xFF는 예약)
+    uint32_t frames;    // 적재한 프레임 수
+    bool     ok;
+} scenario_t;
 
+/**
+ * @brief 프레임 1개를 재생 버퍼에 추가하고 시각을 hold_ms만큼 진행
+ */
+static void scenario_frame(scenario_t* sc, uint8_t buttons, int8_t x, int8_t y,
+                           uint8_t modifier, uint8_t keycode, uint32_t hold_ms) {
+    if (!sc->ok) {
+        return;
+    }
+    input_trace_record_t rec = {
+        .ts_us = sc->t_us,
+        .kind  = INPUT_TRACE_FRAME,
+        .len   = INPUT_TRACE_DATA_MAX,
+    };
+    rec.data[INPUT_FRAME_SEQ]      = sc->seq;
+    rec.data[INPUT_FRAME_BUTTONS]  = buttons;
+    rec.data[INPUT_FRAME_X]        = (uint8_t)x;
+    rec.data[INPUT_FRAME_Y]        = (uint8_t)y;
+    rec.data[INPUT_FRAME_MODIFIER] = modifier;
+    rec.data[INPUT_FRAME_KEYCODE1] = keycode;
+
+    sc->ok = input_trace_replay_append(&rec, 1);
+    sc->seq = (uint8_t)((sc->seq + 1) % 254);
+    sc->t_us += hold_ms * 1000u;
+    sc->frames++;
+}
+
+/**
+ * @brief 마우스 원형 이동 (반지름 30, 10도 간격, 50ms 주기)
+ */
+static void scenario_mouse_circle(scenario_t* sc) {
     const int radius = 30;          // 원 반지름 (픽셀)
     const int step_degrees = 10;    // 각도 증가량 (도)
     const int delay_ms = 50;        // 각 단계 간격 (ms)
 
     for (int angle = 0; angle < 360; angle += step_degrees) {
-        // 라디안 변환
         float rad = angle * M_PI / 180.0f;
-
-        // 원형 좌표 계산
         int8_t dx = (int8_t)(radius * cosf(rad));
         int8_t dy = (int8_t)(radius * sinf(rad));
-
-        // 마우스 리포트 생성
-        hid_mouse_report_t mouse_report = {
-            .buttons = 0,       // 버튼 누르지 않음
-            .x = dx,            // X축 이동
-            .y = dy,            // Y축 이동
-            .wheel = 0          // 휠 사용 안 함
-        };
-
-        // HID 리포트 전송
-        if (sendMouseReport(&mouse_report)) {
-            ESP_LOGD(TAG, "Mouse moved: angle=%d, dx=%d, dy=%d", angle, dx, dy);
-        } else {
-            ESP_LOGW(TAG, "Failed to send mouse report at angle=%d", angle);
-        }
-
-        // 다음 단계까지 대기
-        vTaskDelay(pdMS_TO_TICKS(delay_ms));
+        scenario_frame(sc, 0, dx, dy, 0, 0, delay_ms);
     }
-
-    ESP_LOGI(TAG, "Mouse circle movement test completed");
 }
 
 /**
- * @brief "HELLO" 키보드 타이핑 테스트
- *
- * "HELLO" 문자열을 PC에 타이핑하는 HID 리포트를 생성합니다.
+ * @brief "HELLO" 타이핑 (키마다 50ms 누름 → 50ms 뗌)
  */
-void test_keyboard_typing_hello(void) {
-    ESP_LOGI(TAG, "Starting keyboard typing 'HELLO' test...");
-
-    // "HELLO" 문자열의 HID 키코드
-    // HID 키코드는 class/hid/hid.h에 정의되어 있음
-    const uint8_t hello_keys[] = {
-        HID_KEY_H,  // 'H'
-        HID_KEY_E,  // 'E'
-        HID_KEY_L,  // 'L'
-        HID_KEY_L,  // 'L'
-        HID_KEY_O   // 'O'
-    };
-
-    const int num_keys = sizeof(hello_keys) / sizeof(hello_keys[0]);
+static void scenario_keyboard_hello(scenario_t* sc) {
+    const uint8_t hello_keys[] = { HID_KEY_H, HID_KEY_E, HID_KEY_L, HID_KEY_L, HID_KEY_O };
     const int key_press_ms = 50;    // 키 누름 유지 시간
     const int key_release_ms = 50;  // 키 떼기 후 대기 시간
 
-    for (int i = 0; i < num_keys; i++) {
-        // 1. 키 누름 리포트 전송
-        hid_keyboard_report_t kb_report_press = {
-            .modifier = 0,                  // modifier 없음
-            .reserved = 0,
-            .keycode = {hello_keys[i], 0, 0, 0, 0, 0}  // 첫 번째 키만 사용
-        };
-
-        if (sendKeyboardReport(&kb_report_press)) {
-            ESP_LOGD(TAG, "Key pressed: keycode=0x%02x", hello_keys[i]);
-        } else {
-            ESP_LOGW(TAG, "Failed to send key press report");
-        }
-
-        vTaskDelay(pdMS_TO_TICKS(key_press_ms));
-
-        // 2. 키 떼기 리포트 전송 (모든 필드 0)
-        hid_keyboard_report_t kb_report_release = {0};
-
-        if (sendKeyboardReport(&kb_report_release)) {
-            ESP_LOGD(TAG, "Key released");
-        } else {
-            ESP_LOGW(TAG, "Failed to send key release report");
-        }
-
-        vTaskDelay(pdMS_TO_TICKS(key_release_ms));
+    for (size_t i = 0; i < sizeof(hello_keys); i++) {
+        scenario_frame(sc, 0, 0, 0, 0, hello_keys[i], key_press_ms);
+        scenario_frame(sc, 0, 0, 0, 0, 0, key_release_ms);
     }
-
-    ESP_LOGI(TAG, "Keyboard typing 'HELLO' test completed");
 }
 
 /**
- * @brief 마우스 클릭 테스트
- *
- * 마우스 좌클릭을 수행하는 HID 리포트를 생성합니다.
+ * @brief 마우스 좌클릭 (50ms 누름 → 100ms 뗌)
  */
-void test_mouse_click(void) {
-    ESP_LOGI(TAG, "Starting mouse click test...");
-
-    const int click_duration_ms = 50;   // 클릭 유지 시간
-    const int release_delay_ms = 100;   // 클릭 해제 후 대기
-
-    // 1. 좌클릭 누름
-    hid_mouse_report_t mouse_click_press = {
-        .buttons = MOUSE_BUTTON_LEFT,  // 좌클릭 (0x01)
-        .x = 0,
-        .y = 0,
-        .wheel = 0
-    };
-
-    if (sendMouseReport(&mouse_click_press)) {
-        ESP_LOGD(TAG, "Mouse left button pressed");
-    } else {
-        ESP_LOGW(TAG, "Failed to send mouse click press");
-    }
-
-    vTaskDelay(pdMS_TO_TICKS(click_duration_ms));
-
-    // 2. 좌클릭 떼기
-    hid_mouse_report_t mouse_click_release = {0};
-
-    if (sendMouseReport(&mouse_click_release)) {
-        ESP_LOGD(TAG, "Mouse left button released");
-    } else {
-        ESP_LOGW(TAG, "Failed to send mouse click release");
-    }
-
-    vTaskDelay(pdMS_TO_TICKS(release_delay_ms));
-
-    ESP_LOGI(TAG, "Mouse click test completed");
+static void scenario_mouse_click(scenario_t* sc) {
+    scenario_frame(sc, MOUSE_BUTTON_LEFT, 0, 0, 0, 0, 50);
+    scenario_frame(sc, 0, 0, 0, 0, 0, 100);
 }
 
 /**
- * @brief 키 조합 테스트 (Ctrl+C)
- *
- * Ctrl+C 키 조합을 전송하는 HID 리포트를 생성합니다.
+ * @brief Ctrl+C (100ms 누름 → 100ms 뗌)
  */
-void test_key_combination_ctrl_c(void) {
-    ESP_LOGI(TAG, "Starting key combination (Ctrl+C) test...");
-
-    const int key_press_ms = 100;
-    const int key_release_ms = 100;
+static void scenario_key_combo(scenario_t* sc) {
+    scenario_frame(sc, 0, 0, 0, KEYBOARD_MODIFIER_LEFTCTRL, HID_KEY_C, 100);
+    scenario_frame(sc, 0, 0, 0, 0, 0, 100);
+}
 
-    // 1. Ctrl+C 누름
-    hid_keyboard_report_t kb_ctrl_c_press = {
-        .modifier = KEYBOARD_MODIFIER_LEFTCTRL,  // Ctrl 키
-        .reserved = 0,
-        .keycode = {HID_KEY_C, 0, 0, 0, 0, 0}    // 'C' 키
-    };
+uint32_t hid_test_load_scenario(hid_test_type_t type) {
+    scenario_t sc = { .ok = input_trace_replay_clear() };
 
-    if (sendKeyboardReport(&kb_ctrl_c_press)) {
-        ESP_LOGD(TAG, "Ctrl+C pressed");
-    } else {
-        ESP_LOGW(TAG, "Failed to send Ctrl+C press");
+    switch (type) {
+        case HID_TEST_MOUSE_CIRCLE:
+            scenario_mouse_circle(&sc);
+            break;
+        case HID_TEST_KEYBOARD_HELLO:
+            scenario_keyboard_hello(&sc);
+            break;
+        case HID_TEST_MOUSE_CLICK:
+            scenario_mouse_click(&sc);
+            break;
+        case HID_TEST_KEY_COMBO:
+            scenario_key_combo(&sc);
+            break;
+        case HID_TEST_ALL:
+        default:
+            scenario_mouse_circle(&sc);
+            sc.t_us += 1000 * 1000;     // 1초 대기
+            scenario_keyboard_hello(&sc);
+            break;
     }
 
-    vTaskDelay(pdMS_TO_TICKS(key_press_ms));
-
-    // 2. Ctrl+C 떼기
-    hid_keyboard_report_t kb_release = {0};
-
-    if (sendKeyboardReport(&kb_release)) {
-        ESP_LOGD(TAG, "Ctrl+C released");
-    } else {
-        ESP_LOGW(TAG, "Failed to send key release");
+    if (!sc.ok) {
+        ESP_LOGE(TAG, "Failed to load scenario %d into replay buffer", type);
+        return 0;
     }
-
-    vTaskDelay(pdMS_TO_TICKS(key_release_ms));
-
-    ESP_LOGI(TAG, "Key combination (Ctrl+C) test completed");
+    return sc.frames;
 }
 
 // ==================== HID 테스트 태스크 ====================
 
+/**
+ * @brief 시나리오 반복 간격 (HID_TEST_ALL은 반복하지 않음)
+ */
+static uint32_t scenario_repeat_delay_ms(hid_test_type_t type) {
+    switch (type) {
+        case HID_TEST_KEYBOARD_HELLO:
+        case HID_TEST_KEY_COMBO:
+            return 3000;
+        default:
+            return 2000;
+    }
+}
+
 /**
  * @brief HID 테스트 태스크
  *
- * 테스트 타입에 따라 다른 패턴의 HID 데이터를 생성하여 전송합니다.
+ * 테스트 타입에 따른 시나리오를 재생합니다.
  *
  * @param param 테스트 타입 (hid_test_type_t*)
  */
@@ -243,49 +192,32 @@ void hid_test_task(void* param) {
     ESP_LOGI(TAG, "Waiting 2 seconds for USB enumeration...");
     vTaskDelay(pdMS_TO_TICKS(2000));
 
-    // 테스트 실행
+    // 테스트 실행: 시나리오 적재 → 원래 속도로 재생 (유휴 압축 없음) → 완료 대기
     while (1) {
-        switch (test_type) {
-            case HID_TEST_MOUSE_CIRCLE:
-                test_mouse_circle_movement();
-                vTaskDelay(pdMS_TO_TICKS(2000));  // 2초 대기 후 반복
-                break;
-
-            case HID_TEST_KEYBOARD_HELLO:
-                test_keyboard_typing_hello();
-                vTaskDelay(pdMS_TO_TICKS(3000));  // 3초 대기 후 반복
-                break;
-
-            case HID_TEST_MOUSE_CLICK:
-                test_mouse_click();
-                vTaskDelay(pdMS_TO_TICKS(2000));  // 2초 대기 후 반복
-                break;
-
-            case HID_TEST_KEY_COMBO:
-                test_key_combination_ctrl_c();
-                vTaskDelay(pdMS_TO_TICKS(3000));  // 3초 대기 후 반복
-                break;
-
-            case HID_TEST_ALL:
-            default:
-                ESP_LOGI(TAG, "=== Running tests (1 cycle) ===");
-
-                ESP_LOGI(TAG, "Test 1/2: Mouse circle movement");
-                test_mouse_circle_movement();
-                vTaskDelay(pdMS_TO_TICKS(1000));
-
-                ESP_LOGI(TAG, "Test 2/2: Keyboard typing 'HELLO'");
-                test_keyboard_typing_hello();
+        uint32_t frames = hid_test_load_scenario(test_type);
+        if (frames == 0 || !input_trace_replay_start(INPUT_TRACE_DEFAULT_SPEED, 0)) {
+            ESP_LOGE(TAG, "Scenario replay could not start");
+            break;
+        }
+        ESP_LOGI(TAG, "=== Replaying scenario %d (%u frames) ===", test_type, (unsigned)frames);
 
-                ESP_LOGI(TAG, "=== All tests completed - Task ending ===");
+        while (input_trace_replay_active()) {
+            vTaskDelay(pdMS_TO_TICKS(100));
+            esp_task_wdt_reset();
+        }
 
-                // 워치독 해제 후 태스크 종료
-                esp_task_wdt_delete(NULL);
-                vTaskDelete(NULL);
-                break;
+        if (test_type == HID_TEST_ALL) {
+            ESP_LOGI(TAG, "=== All tests completed - Task ending ===");
+            break;
         }
 
+        vTaskDelay(pdMS_TO_TICKS(scenario_repeat_delay_ms(test_type)));
+
         // 워치독 리셋
         esp_task_wdt_reset();
     }
+
+    // 워치독 해제 후 태스크 종료
+    esp_task_wdt_delete(NULL);
+    vTaskDelete(NULL);
 }
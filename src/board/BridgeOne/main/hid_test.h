@@ -1,11 +1,12 @@
 /**
  * @file hid_test.h
- * @brief BridgeOne HID 테스트 모드 - Android 없이 자체 테스트 데이터 생성
+ * @brief BridgeOne HID 테스트 모드 - Android 없이 자체 테스트 입력 생성
  *
  * 역할:
- * - Android 통신 없이 ESP32-S3 보드 자체에서 HID 프레임 생성
+ * - Android 통신 없이 ESP32-S3 보드 자체에서 bridge_frame_t 입력열(트레이스) 생성
+ * - 생성한 트레이스를 입력 트레이스 재생기(input_trace.h)로 frame_queue에 주입
+ *   → 실제 hid_task 파이프라인(코얼레싱, 키보드 엔진, 포인터 다이나믹스)을 그대로 통과
  * - PC에서 마우스/키보드 제어가 정상 작동하는지 검증
- * - UART 통신 대신 내부적으로 테스트 데이터 생성
  *
  * 테스트 항목:
  * - 마우스 원형 이동
@@ -44,54 +45,30 @@ typedef enum {
 /**
  * @brief HID 테스트 태스크
  *
- * UART 통신 대신 내부적으로 테스트 데이터를 생성하여 HID 리포트로 전송합니다.
+ * 테스트 시나리오를 트레이스로 만들어 재생 버퍼에 싣고 원래 속도로 재생합니다.
  * 이를 통해 Android 없이도 PC에서 마우스/키보드 제어가 정상 작동하는지 확인할 수 있습니다.
  *
  * 동작:
- * 1. 테스트 타입에 따라 다른 패턴의 HID 데이터 생성
- * 2. sendKeyboardReport() 및 sendMouseReport()로 전송
- * 3. 일정 간격으로 반복 실행
+ * 1. USB 연결 대기
+ * 2. hid_test_load_scenario()로 시나리오 적재 → input_trace_replay_start()
+ * 3. 재생이 끝날 때까지 대기 후 반복 (HID_TEST_ALL은 1회 실행 후 종료)
  *
  * @param param 테스트 타입 (hid_test_type_t*)
  */
 void hid_test_task(void* param);
 
 /**
- * @brief 마우스 원형 이동 테스트
+ * @brief 테스트 시나리오를 재생 버퍼에 적재
  *
- * 마우스 커서가 원형으로 이동하는 HID 리포트를 생성합니다.
- * - 반지름: 50 픽셀
- * - 속도: 초당 1회전
- * - PC 화면에서 원형 궤적을 그리는 것으로 확인 가능
- */
-void test_mouse_circle_movement(void);
-
-/**
- * @brief "HELLO" 키보드 타이핑 테스트
- *
- * "HELLO" 문자열을 PC에 타이핑하는 HID 리포트를 생성합니다.
- * - 각 키는 100ms 간격으로 전송
- * - 키 누름 → 키 떼기 순서 보장
- * - PC 메모장 등에서 "HELLO" 입력 확인 가능
- */
-void test_keyboard_typing_hello(void);
-
-/**
- * @brief 마우스 클릭 테스트
- *
- * 마우스 좌클릭을 수행하는 HID 리포트를 생성합니다.
- * - 클릭 누름 → 클릭 떼기 순서 보장
- * - 50ms 간격
- */
-void test_mouse_click(void);
-
-/**
- * @brief 키 조합 테스트 (Ctrl+C)
+ * 재생 버퍼를 비우고 시나리오의 프레임을 합성 타임스탬프(0부터)와 함께 채웁니다.
+ * - 마우스 원형 이동: 반지름 30, 10도 간격, 50ms 주기
+ * - "HELLO": 키마다 50ms 누름 → 50ms 뗌
+ * - 마우스 클릭: 좌클릭 50ms 누름 → 100ms 뗌
+ * - Ctrl+C: 100ms 누름 → 100ms 뗌
+ * - 전체: 원형 이동 → 1초 → "HELLO"
  *
- * Ctrl+C 키 조합을 전송하는 HID 리포트를 생성합니다.
- * - Ctrl 누름 → C 누름 → C 떼기 → Ctrl 떼기
- * - PC에서 복사 기능 동작 확인 가능
+ * @return 적재한 프레임 수 (0: 재생 버퍼 확보 실패)
  */
-void test_key_combination_ctrl_c(void);
+uint32_t hid_test_load_scenario(hid_test_type_t type);
 
 #endif // HID_TEST_H
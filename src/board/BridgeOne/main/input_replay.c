@@ -0,0 +1,66 @@
+/**
+ * @file input_replay.c
+ * @brief 입력 트레이스 재생 커서 구현
+ *
+ * 정수 연산만 사용하며, 같은 레코드와 설정이면 항상 같은 (프레임, 시각) 순서를 돌려줍니다.
+ */
+
+#include "input_replay.h"
+
+void input_replay_init(input_replay_t *r, const input_trace_record_t *records, uint32_t count,
+                       uint16_t speed_pct, uint32_t max_idle_us)
+{
+    if (speed_pct != 0) {
+        if (speed_pct < INPUT_REPLAY_SPEED_MIN) speed_pct = INPUT_REPLAY_SPEED_MIN;
+        if (speed_pct > INPUT_REPLAY_SPEED_MAX) speed_pct = INPUT_REPLAY_SPEED_MAX;
+    }
+
+    r->records       = records;
+    r->count         = count;
+    r->next          = 0;
+    r->speed_pct     = speed_pct;
+    r->max_idle_us   = max_idle_us;
+    r->started       = false;
+    r->prev_ts_us    = 0;
+    r->prev_released = true;
+    r->clock_us      = 0;
+    r->frames        = 0;
+}
+
+bool input_replay_frame_released(const input_trace_record_t *frame)
+{
+    return (frame->data[INPUT_FRAME_BUTTONS] & INPUT_FRAME_BUTTONS_MASK) == 0 &&
+           frame->data[INPUT_FRAME_MODIFIER] == 0 &&
+           frame->data[INPUT_FRAME_KEYCODE1] == 0 &&
+           frame->data[INPUT_FRAME_KEYCODE2] == 0;
+}
+
+bool input_replay_next(input_replay_t *r, const input_trace_record_t **frame,
+                       uint64_t *due_us, uint64_t *clock_us)
+{
+    while (r->next < r->count) {
+        const input_trace_record_t *rec = &r->records[r->next++];
+        if (rec->kind != INPUT_TRACE_FRAME || rec->len != INPUT_TRACE_DATA_MAX) {
+            continue;
+        }
+
+        if (r->started) {
+            // 부호 없는 차분이므로 ts_us 랩어라운드를 한 번 넘는 간격까지 그대로 처리
+            uint32_t gap = rec->ts_us - r->prev_ts_us;
+            if (r->max_idle_us != 0 && r->prev_released && gap > r->max_idle_us) {
+                gap = r->max_idle_us;
+            }
+            r->clock_us += gap;
+        }
+        r->started       = true;
+        r->prev_ts_us    = rec->ts_us;
+        r->prev_released = input_replay_frame_released(rec);
+        r->frames++;
+
+        *frame    = rec;
+        *clock_us = r->clock_us;
+        *due_us   = (r->speed_pct == 0) ? 0 : r->clock_us * 100u / r->speed_pct;
+        return true;
+    }
+    return false;
+}
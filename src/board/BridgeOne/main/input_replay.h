@@ -0,0 +1,121 @@
+/**
+ * @file input_replay.h
+ * @brief 입력 트레이스 레코드 형식과 재생 커서 (ESP-IDF 비의존)
+ *
+ * 역할:
+ * - input_trace.c가 PSRAM 링에 기록하는 레코드 형식 정의 (호스트 도구와 공유하는 16바이트 고정 형식)
+ * - 기록된 프레임 레코드를 원래 간격 또는 배속으로 다시 꺼내는 커서
+ *
+ * 재생 시각:
+ * - due_us: 재생 시작 후 이 프레임을 주입할 시각 (배속, 유휴 압축 적용)
+ * - clock_us: 기록 당시 첫 프레임 기준 경과 시각 (유휴 압축만 적용, 배속 무관)
+ *   hid_task는 재생 프레임의 포인터 다이나믹스 시각으로 clock_us를 쓰므로
+ *   배속과 스케줄링 지터가 속도 추정에 섞이지 않습니다.
+ *
+ * 이 모듈은 ESP-IDF API에 의존하지 않으므로 호스트에서 단위 테스트합니다 (test/host/).
+ */
+
+#ifndef INPUT_REPLAY_H
+#define INPUT_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== 레코드 형식 ====================
+
+/** 레코드 데이터 최대 길이 (bridge_frame_t 8바이트, 키보드 리포트 8바이트, 마우스 리포트 7바이트) */
+#define INPUT_TRACE_DATA_MAX        8
+
+/**
+ * 레코드 종류.
+ */
+typedef enum {
+    INPUT_TRACE_FRAME        = 1,   // 검증 완료된 bridge_frame_t (uart_task 또는 재생 주입)
+    INPUT_TRACE_KB_REPORT    = 2,   // hid_keyboard_report_t (sendKeyboardReport)
+    INPUT_TRACE_MOUSE_REPORT = 3,   // bridge_mouse_report_t (send_mouse_wire_report)
+} input_trace_kind_t;
+
+/** flags: 재생 중 기록됨 (주입된 프레임과 그 결과 리포트) */
+#define INPUT_TRACE_FLAG_REPLAY     0x01
+
+/**
+ * 트레이스 레코드 (16바이트, 리틀 엔디언 그대로 전송/저장).
+ */
+typedef struct {
+    uint32_t ts_us;                         // esp_timer 하위 32비트 (약 71분마다 랩어라운드)
+    uint8_t  kind;                          // input_trace_kind_t
+    uint8_t  flags;                         // INPUT_TRACE_FLAG_*
+    uint8_t  len;                           // data 유효 길이
+    uint8_t  reserved;
+    uint8_t  data[INPUT_TRACE_DATA_MAX];
+} input_trace_record_t;
+
+_Static_assert(sizeof(input_trace_record_t) == 16, "input_trace_record_t must be 16 bytes");
+
+/**
+ * 프레임 레코드 data의 바이트 위치 (uart_handler.h bridge_frame_t와 동일).
+ */
+#define INPUT_FRAME_SEQ             0
+#define INPUT_FRAME_BUTTONS         1
+#define INPUT_FRAME_X               2
+#define INPUT_FRAME_Y               3
+#define INPUT_FRAME_WHEEL           4
+#define INPUT_FRAME_MODIFIER        5
+#define INPUT_FRAME_KEYCODE1        6
+#define INPUT_FRAME_KEYCODE2        7
+
+/** 프레임 buttons 중 실제 버튼 비트 (uart_handler.h BRIDGE_BUTTONS_MASK) */
+#define INPUT_FRAME_BUTTONS_MASK    0x07
+
+// ==================== 재생 커서 ====================
+
+/** 배속 범위 (%, 0은 대기 없이 최대한 빨리) */
+#define INPUT_REPLAY_SPEED_MIN      10
+#define INPUT_REPLAY_SPEED_MAX      10000
+
+/**
+ * 재생 커서.
+ *
+ * 호출자가 소유하며 레코드 배열은 재생이 끝날 때까지 유지되어야 합니다.
+ */
+typedef struct {
+    const input_trace_record_t *records;
+    uint32_t count;
+    uint32_t next;              // 다음에 볼 레코드 인덱스
+    uint16_t speed_pct;         // 100 = 원래 속도, 0 = 대기 없음
+    uint32_t max_idle_us;       // 모두 뗀 상태의 간격 상한 (0 = 압축 안 함)
+
+    bool     started;
+    uint32_t prev_ts_us;        // 직전 프레임 ts_us (랩어라운드 차분용)
+    bool     prev_released;     // 직전 프레임이 버튼/키를 모두 뗀 상태였는지
+    uint64_t clock_us;          // 직전 프레임 clock_us
+    uint32_t frames;            // 지금까지 꺼낸 프레임 수
+} input_replay_t;
+
+/**
+ * 커서 초기화.
+ *
+ * @param speed_pct   배속 (%). 0이면 대기 없음, 그 외는 INPUT_REPLAY_SPEED_MIN~MAX로 제한
+ * @param max_idle_us 버튼/키가 모두 떼어진 구간의 간격 상한 (필드 트레이스의 긴 유휴 구간 압축).
+ *                    누른 채 유지한 구간은 자동 반복/드래그 동작이 달라지므로 압축하지 않습니다.
+ */
+void input_replay_init(input_replay_t *r, const input_trace_record_t *records, uint32_t count,
+                       uint16_t speed_pct, uint32_t max_idle_us);
+
+/**
+ * 다음 프레임 레코드 꺼내기 (리포트 레코드는 건너뜀).
+ *
+ * @param frame    [out] 프레임 레코드
+ * @param due_us   [out] 재생 시작 기준 주입 시각 (배속 적용)
+ * @param clock_us [out] 첫 프레임 기준 기록 시각 (배속 미적용)
+ * @return false: 더 이상 프레임 없음
+ */
+bool input_replay_next(input_replay_t *r, const input_trace_record_t **frame,
+                       uint64_t *due_us, uint64_t *clock_us);
+
+/**
+ * 프레임 레코드가 버튼/키를 모두 뗀 상태인지.
+ */
+bool input_replay_frame_released(const input_trace_record_t *frame);
+
+#endif // INPUT_REPLAY_H
@@ -0,0 +1,458 @@
+/**
+ * @file input_trace.c
+ * @brief 입력 트레이스 레코더 + 재생기 구현
+ *
+ * 참조: input_trace.h, input_replay.h
+ */
+
+#include "input_trace.h"
+#include "uart_handler.h"     // bridge_frame_t, frame_queue
+#include "task_profiler.h"
+#include "trace_recorder.h"
+#include "mem_alloc.h"
+#include "vcdc_chunk.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "INPUT_TRACE";
+
+_Static_assert(sizeof(bridge_frame_t) == INPUT_TRACE_DATA_MAX, "bridge_frame_t must fit a trace record");
+
+/** 재생 태스크 (uart_task와 같은 자리에서 frame_queue에 주입) */
+#define REPLAY_TASK_STACK_SIZE      3072
+#define REPLAY_TASK_PRIORITY        6
+
+/** frame_queue가 가득 찼을 때 기다리는 시간 (넘으면 프레임을 버리고 dropped 증가) */
+#define REPLAY_QUEUE_TIMEOUT_MS     100
+
+/** 재생 종료 후 hid_task가 남은 재생 프레임을 처리하도록 기다리는 최대 시간 */
+#define REPLAY_DRAIN_TIMEOUT_MS     100
+
+// ==================== 상태 ====================
+
+/** 기록 링 (PSRAM) */
+static input_trace_record_t *s_ring = NULL;
+
+/** 지금까지 기록을 시도한 레코드 수 (다음 쓰기 위치 = s_head % INPUT_TRACE_RING_RECORDS) */
+static atomic_uint s_head = 0;
+
+static volatile bool s_recording = false;
+
+/** 재생 버퍼와 seq별 재생 시각 (PSRAM, 처음 적재할 때 확보) */
+static input_trace_record_t *s_replay = NULL;
+static int64_t              *s_replay_clock = NULL;
+static uint32_t              s_replay_count = 0;
+
+/** 재생 상태 (uart_task/hid_task가 읽음) */
+static volatile bool     s_replay_active = false;
+static volatile bool     s_replay_stop = false;
+static TaskHandle_t      s_replay_task = NULL;
+/** s_replay_task 읽고 알림 ↔ 비우고 삭제 사이의 보호 (삭제된 TCB에 알림 금지) */
+static SemaphoreHandle_t s_replay_task_lock = NULL;
+static esp_timer_handle_t s_replay_timer = NULL;
+static uint16_t          s_replay_speed = 0;
+static uint32_t          s_replay_max_idle_us = 0;
+static volatile uint32_t s_replay_played = 0;
+static volatile uint32_t s_replay_dropped = 0;
+
+/** input_trace_frame_time_us() 단조 증가 보정 (hid_task 전용) */
+static int64_t s_clock_floor_us = 0;
+
+// ==================== 기록 ====================
+
+void input_trace_record(input_trace_kind_t kind, const void *data, uint8_t len)
+{
+    if (!s_recording) {
+        return;
+    }
+    if (len > INPUT_TRACE_DATA_MAX) {
+        len = INPUT_TRACE_DATA_MAX;
+    }
+    unsigned idx = atomic_fetch_add_explicit(&s_head, 1, memory_order_relaxed);
+    input_trace_record_t *rec = &s_ring[idx & (INPUT_TRACE_RING_RECORDS - 1)];
+    rec->ts_us    = (uint32_t)esp_timer_get_time();
+    rec->kind     = (uint8_t)kind;
+    rec->flags    = s_replay_active ? INPUT_TRACE_FLAG_REPLAY : 0;
+    rec->len      = len;
+    rec->reserved = 0;
+    memcpy(rec->data, data, len);
+    memset(&rec->data[len], 0, INPUT_TRACE_DATA_MAX - len);
+}
+
+bool input_trace_init(void)
+{
+    s_ring = mem_bulk_alloc(INPUT_TRACE_RING_RECORDS * sizeof(input_trace_record_t));
+    if (s_ring == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate %u byte input ring",
+                 (unsigned)(INPUT_TRACE_RING_RECORDS * sizeof(input_trace_record_t)));
+        return false;
+    }
+    input_trace_start();
+    return true;
+}
+
+void input_trace_start(void)
+{
+    if (s_ring == NULL) {
+        return;
+    }
+    s_recording = false;
+    atomic_store(&s_head, 0);
+    s_recording = true;
+    ESP_LOGI(TAG, "Recording started (%d records)", INPUT_TRACE_RING_RECORDS);
+}
+
+void input_trace_stop(void)
+{
+    if (!s_recording) {
+        return;
+    }
+    s_recording = false;
+
+    // 플래그를 보기 전에 들어온 기록이 끝나도록 잠시 양보
+    vTaskDelay(1);
+}
+
+// ==================== 재생 버퍼 ====================
+
+static bool replay_buffer_ensure(void)
+{
+    if (s_replay != NULL) {
+        return true;
+    }
+    s_replay = mem_bulk_alloc(INPUT_TRACE_REPLAY_RECORDS * sizeof(input_trace_record_t));
+    s_replay_clock = mem_bulk_alloc(256 * sizeof(int64_t));
+    if (s_replay == NULL || s_replay_clock == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate replay buffer");
+        mem_bulk_free(s_replay_clock);
+        mem_bulk_free(s_replay);
+        s_replay = NULL;
+        s_replay_clock = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool input_trace_replay_clear(void)
+{
+    if (s_replay_task != NULL) {
+        return false;
+    }
+    s_replay_count = 0;
+    return true;
+}
+
+bool input_trace_replay_append(const input_trace_record_t *records, uint32_t count)
+{
+    if (s_replay_task != NULL || !replay_buffer_ensure()) {
+        return false;
+    }
+    if (count > INPUT_TRACE_REPLAY_RECORDS - s_replay_count) {
+        ESP_LOGW(TAG, "Replay buffer full (%u + %u > %d)",
+                 (unsigned)s_replay_count, (unsigned)count, INPUT_TRACE_REPLAY_RECORDS);
+        return false;
+    }
+    memcpy(&s_replay[s_replay_count], records, count * sizeof(input_trace_record_t));
+    s_replay_count += count;
+    return true;
+}
+
+uint32_t input_trace_replay_load_recorded(void)
+{
+    if (s_ring == NULL || s_replay_task != NULL || !replay_buffer_ensure()) {
+        return 0;
+    }
+
+    bool was_recording = s_recording;
+    input_trace_stop();
+
+    unsigned head  = atomic_load(&s_head);
+    unsigned avail = (head > INPUT_TRACE_RING_RECORDS) ? INPUT_TRACE_RING_RECORDS : head;
+
+    // 최근 쪽에서 실제 입력 프레임을 세어 복사 시작 위치를 정함
+    unsigned first = head;
+    uint32_t frames = 0;
+    while (first > head - avail && frames < INPUT_TRACE_REPLAY_RECORDS) {
+        const input_trace_record_t *rec = &s_ring[(first - 1) & (INPUT_TRACE_RING_RECORDS - 1)];
+        if (rec->kind == INPUT_TRACE_FRAME && !(rec->flags & INPUT_TRACE_FLAG_REPLAY)) {
+            frames++;
+        }
+        first--;
+    }
+
+    s_replay_count = 0;
+    for (unsigned i = first; i != head; i++) {
+        const input_trace_record_t *rec = &s_ring[i & (INPUT_TRACE_RING_RECORDS - 1)];
+        if (rec->kind == INPUT_TRACE_FRAME && !(rec->flags & INPUT_TRACE_FLAG_REPLAY)) {
+            s_replay[s_replay_count++] = *rec;
+        }
+    }
+
+    if (was_recording) {
+        s_recording = true;
+    }
+    ESP_LOGI(TAG, "Loaded %u recorded frames for replay", (unsigned)s_replay_count);
+    return s_replay_count;
+}
+
+uint32_t input_trace_replay_loaded(void)
+{
+    return s_replay_count;
+}
+
+// ==================== 재생 ====================
+
+bool input_trace_replay_active(void)
+{
+    return s_replay_active;
+}
+
+int64_t input_trace_frame_time_us(uint8_t seq)
+{
+    int64_t now = esp_timer_get_time();
+    if (s_replay_active && s_replay_clock != NULL && s_replay_clock[seq] != 0) {
+        now = s_replay_clock[seq];
+    }
+    if (now < s_clock_floor_us) {
+        now = s_clock_floor_us;
+    }
+    s_clock_floor_us = now;
+    return now;
+}
+
+/**
+ * 재생 태스크 깨우기. 핸들 확인과 알림을 s_replay_task_lock 안에서 하므로
+ * 태스크가 핸들을 비우고 스스로 삭제하는 것과 겹치지 않습니다.
+ */
+static void replay_notify(TickType_t lock_timeout)
+{
+    if (xSemaphoreTake(s_replay_task_lock, lock_timeout) != pdTRUE) {
+        return;
+    }
+    if (s_replay_task != NULL) {
+        xTaskNotifyGive(s_replay_task);
+    }
+    xSemaphoreGive(s_replay_task_lock);
+}
+
+static void replay_timer_cb(void *arg)
+{
+    // esp_timer 태스크를 막지 않음: 잠금을 못 잡으면 중지 요청이 이미 깨우는 중이거나
+    // 태스크가 끝나는 중이며, 어느 쪽이든 대기는 예정 시각 + 10ms에서 스스로 끝남
+    replay_notify(0);
+}
+
+/** 프레임 1개를 uart_task와 같은 방식으로 frame_queue에 넣음 */
+static void replay_inject(const bridge_frame_t *frame, int64_t clock_us)
+{
+    s_replay_clock[frame->seq] = clock_us;
+    input_trace_record(INPUT_TRACE_FRAME, frame, sizeof(*frame));
+    trace_recorder_event(TRACE_EV_UART_FRAME, 1, frame->seq);
+    task_probe_signal(TASK_PROBE_HID);
+    if (xQueueSend(frame_queue, frame, pdMS_TO_TICKS(REPLAY_QUEUE_TIMEOUT_MS)) != pdPASS) {
+        s_replay_dropped++;
+    }
+}
+
+/** 다음 프레임 시각까지 대기. 중지 요청이면 false */
+static bool replay_wait_until(int64_t due_us)
+{
+    int64_t wait = due_us - esp_timer_get_time();
+    if (wait > 0) {
+        esp_timer_start_once(s_replay_timer, (uint64_t)wait);
+        // 타이머가 깨우지 못해도 멈추지 않도록 예정 시각 + 10ms에서 스스로 깸
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait / 1000 + 10));
+        esp_timer_stop(s_replay_timer);
+        // 시간 초과로 깬 뒤 타이머가 막 보낸 알림이 다음 대기를 바로 끝내지 않도록 비움
+        // (중지 요청도 비워지지만 아래의 s_replay_stop으로 판정)
+        ulTaskNotifyTake(pdTRUE, 0);
+    }
+    return !s_replay_stop;
+}
+
+static void replay_task(void *param)
+{
+    (void)param;
+
+    input_replay_t cursor;
+    input_replay_init(&cursor, s_replay, s_replay_count, s_replay_speed, s_replay_max_idle_us);
+
+    const int64_t start_us = esp_timer_get_time();
+    const input_trace_record_t *rec;
+    uint64_t due_us;
+    uint64_t clock_us;
+    bridge_frame_t frame = {0};
+    int64_t last_clock = start_us;
+
+    ESP_LOGI(TAG, "Replay started (%u records, speed %u%%, max idle %u ms)",
+             (unsigned)s_replay_count, s_replay_speed, (unsigned)(s_replay_max_idle_us / 1000));
+
+    while (input_replay_next(&cursor, &rec, &due_us, &clock_us)) {
+        if (!replay_wait_until(start_us + (int64_t)due_us)) {
+            break;
+        }
+        memcpy(&frame, rec->data, sizeof(frame));
+        last_clock = start_us + (int64_t)clock_us;
+        replay_inject(&frame, last_clock);
+        s_replay_played++;
+    }
+
+    // 눌린 채로 끝나지 않도록 모두 뗀 프레임 주입
+    bridge_frame_t release = { .seq = (uint8_t)((frame.seq + 1) % 254) };
+    replay_inject(&release, last_clock);
+
+    // hid_task가 남은 재생 프레임을 재생 시각으로 처리할 때까지 대기
+    for (int i = 0; i < REPLAY_DRAIN_TIMEOUT_MS && uxQueueMessagesWaiting(frame_queue) > 0; i++) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    vTaskDelay(pdMS_TO_TICKS(2));
+
+    ESP_LOGI(TAG, "Replay %s (%u frames, %u dropped, %lld ms)",
+             s_replay_stop ? "stopped" : "finished", (unsigned)s_replay_played,
+             (unsigned)s_replay_dropped, (long long)((esp_timer_get_time() - start_us) / 1000));
+
+    // 핸들을 먼저 비워야 replay_active()가 false가 된 직후의 재시작이 거부되지 않음.
+    // 잠금 안에서 비우므로 이후 replay_notify()는 이 태스크를 가리키지 않음
+    xSemaphoreTake(s_replay_task_lock, portMAX_DELAY);
+    s_replay_task = NULL;
+    s_replay_active = false;
+    xSemaphoreGive(s_replay_task_lock);
+    vTaskDelete(NULL);
+}
+
+bool input_trace_replay_start(uint16_t speed_pct, uint32_t max_idle_ms)
+{
+    if (s_replay_task != NULL || s_replay_count == 0 || frame_queue == NULL) {
+        return false;
+    }
+    if (s_replay_task_lock == NULL) {
+        s_replay_task_lock = xSemaphoreCreateMutex();
+        if (s_replay_task_lock == NULL) {
+            ESP_LOGE(TAG, "Failed to create replay lock");
+            return false;
+        }
+    }
+    if (s_replay_timer == NULL) {
+        const esp_timer_create_args_t args = {
+            .callback = replay_timer_cb,
+            .arg = NULL,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "input_replay"
+        };
+        if (esp_timer_create(&args, &s_replay_timer) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create replay timer");
+            return false;
+        }
+    }
+
+    memset(s_replay_clock, 0, 256 * sizeof(int64_t));
+    s_replay_speed       = speed_pct;
+    s_replay_max_idle_us = max_idle_ms * 1000u;
+    s_replay_played      = 0;
+    s_replay_dropped     = 0;
+    s_replay_stop        = false;
+    s_replay_active      = true;
+
+    if (xTaskCreatePinnedToCore(replay_task, "REPLAY", REPLAY_TASK_STACK_SIZE, NULL,
+                                REPLAY_TASK_PRIORITY, &s_replay_task, 0) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create replay task");
+        s_replay_task = NULL;
+        s_replay_active = false;
+        return false;
+    }
+    return true;
+}
+
+void input_trace_replay_stop(void)
+{
+    if (s_replay_task_lock == NULL || s_replay_task == NULL) {
+        return;
+    }
+    s_replay_stop = true;
+    replay_notify(portMAX_DELAY);
+}
+
+// ==================== 상태 보고 ====================
+
+size_t input_trace_build_status_json(char *buf, size_t cap)
+{
+    unsigned head = atomic_load(&s_head);
+    unsigned lost = (head > INPUT_TRACE_RING_RECORDS) ? head - INPUT_TRACE_RING_RECORDS : 0;
+    const char *replay_state = (s_replay_task != NULL) ? "running" : "idle";
+
+    int n = snprintf(buf, cap,
+                     "{\"recording\":%s,\"records\":%u,\"capacity\":%u,\"lost\":%u,"
+                     "\"replay\":{\"state\":\"%s\",\"loaded\":%u,\"capacity\":%u,"
+                     "\"played\":%u,\"dropped\":%u,\"speed\":%u}}",
+                     s_recording ? "true" : "false", head - lost,
+                     (unsigned)(s_ring != NULL ? INPUT_TRACE_RING_RECORDS : 0), lost,
+                     replay_state, (unsigned)s_replay_count, (unsigned)INPUT_TRACE_REPLAY_RECORDS,
+                     (unsigned)s_replay_played, (unsigned)s_replay_dropped, s_replay_speed);
+    return (n > 0 && (size_t)n < cap) ? (size_t)n : 0;
+}
+
+// ==================== 결과 전송 ====================
+
+bool input_trace_dump(uint32_t last, uint16_t max_chunk, input_trace_emit_fn emit, void *ctx)
+{
+    if (s_ring == NULL) {
+        return false;
+    }
+
+    uint8_t *chunk = mem_arena_alloc(max_chunk);
+    if (chunk == NULL) {
+        return false;
+    }
+
+    bool was_recording = s_recording;
+    input_trace_stop();
+
+    unsigned head  = atomic_load(&s_head);
+    unsigned count = (head > INPUT_TRACE_RING_RECORDS) ? INPUT_TRACE_RING_RECORDS : head;
+    if (last != 0 && last < count) {
+        count = last;
+    }
+
+    const uint16_t per_chunk = (uint16_t)((max_chunk - 4) / sizeof(input_trace_record_t));
+    unsigned pos = head - count;
+    unsigned remaining = count;
+    bool ok = true;
+
+    while (ok && remaining > 0) {
+        uint16_t n = (remaining < per_chunk) ? (uint16_t)remaining : per_chunk;
+        chunk[0] = INPUT_CHUNK_RECORDS;
+        chunk[1] = 0;
+        chunk[2] = (uint8_t)n;
+        chunk[3] = (uint8_t)(n >> 8);
+        for (uint16_t i = 0; i < n; i++) {
+            // 레코드는 이미 Little-Endian 16B 형식이므로 그대로 복사
+            memcpy(&chunk[4 + i * sizeof(input_trace_record_t)],
+                   &s_ring[(pos + i) & (INPUT_TRACE_RING_RECORDS - 1)],
+                   sizeof(input_trace_record_t));
+        }
+        ok = emit(chunk, (uint16_t)(4 + n * sizeof(input_trace_record_t)), ctx);
+        pos += n;
+        remaining -= n;
+    }
+
+    if (ok) {
+        memset(chunk, 0, 4);
+        chunk[0] = INPUT_CHUNK_END;
+        vcdc_put_u32(&chunk[4], count);
+        vcdc_put_u32(&chunk[8], (head > INPUT_TRACE_RING_RECORDS) ? head - INPUT_TRACE_RING_RECORDS : 0);
+        vcdc_put_u32(&chunk[12], (uint32_t)esp_timer_get_time());
+        ok = emit(chunk, 16, ctx);
+    }
+
+    if (was_recording) {
+        s_recording = true;
+    }
+    mem_arena_free(chunk);
+    return ok;
+}
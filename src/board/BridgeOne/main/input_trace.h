@@ -0,0 +1,167 @@
+/**
+ * @file input_trace.h
+ * @brief 입력 트레이스 레코더 + 재생기 (PSRAM)
+ *
+ * 역할:
+ * - 기록: 검증된 bridge_frame_t 전부와 그 결과로 나간 HID 리포트(키보드/마우스)를
+ *   us 타임스탬프와 함께 PSRAM 링에 상시 기록 (플라이트 레코더)
+ *   → "커서가 튐", "드래그가 안 풀림" 같은 현장 증상을 실제 입력열로 재현
+ * - 재생: 재생 버퍼의 프레임을 원래 간격 또는 배속으로 frame_queue에 주입
+ *   → uart_task 이후의 실제 파이프라인(코얼레싱, 키보드 엔진, 포인터 다이나믹스, 리포트 제출)을 그대로 통과
+ *   재생 중 들어온 실제 UART 프레임은 버립니다. 재생이 끝나거나 중지되면 모두 뗀 프레임을 주입합니다.
+ * - HID_TEST_MODE의 테스트 시나리오(hid_test.c)도 이 재생 경로로 실행됩니다.
+ *
+ * 결정성:
+ * - 재생 프레임의 포인터 다이나믹스 시각은 기록된 타임스탬프(input_replay.h clock_us)를 쓰므로
+ *   배속/지터와 무관하게 같은 속도 추정을 거칩니다 (input_trace_frame_time_us).
+ * - 코얼레싱 묶음과 키보드 엔진(디바운스/자동 반복)은 실제 시각을 따르므로,
+ *   하드웨어 재생의 리포트열은 원래 속도에서 근사적으로만 같습니다.
+ *   완전히 같은 결과는 호스트 시뮬레이션(test/host/input_sim.c)에서 얻습니다.
+ *
+ * 비용: 레코드 1개 = esp_timer_get_time() + 원자적 인덱스 증가 + 16B PSRAM 쓰기.
+ *
+ * 제어/전송 (Vendor CDC):
+ * - VCDC_CMD_INPUT_CONTROL (JSON): {"op":"status"} / "start" / "stop" / "dump"(last 선택)
+ *                                  / "load_recorded" / "replay"(speed, max_idle_ms 선택) / "replay_stop"
+ * - VCDC_CMD_INPUT_STATUS  (JSON): 상태 응답 (input_trace_build_status_json 참조)
+ * - VCDC_CMD_INPUT_DATA    (바이너리): dump 응답, 형식은 input_trace_chunk_t 참조
+ * - VCDC_CMD_INPUT_UPLOAD  (바이너리): [offset u32] + input_trace_record_t × n → 재생 버퍼 (INPUT_STATUS 응답)
+ */
+
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "input_replay.h"
+
+// ==================== 상수 ====================
+
+/** 기록 링 레코드 수 (2의 거듭제곱, 16B → 4MB, PSRAM) */
+#define INPUT_TRACE_RING_RECORDS    (256 * 1024)
+
+/** 재생 버퍼 레코드 수 (16B → 1MB, PSRAM, 처음 적재할 때 확보) */
+#define INPUT_TRACE_REPLAY_RECORDS  (64 * 1024)
+
+/** 재생 기본값: 원래 속도, 모두 뗀 상태의 간격은 1초로 압축 */
+#define INPUT_TRACE_DEFAULT_SPEED        100
+#define INPUT_TRACE_DEFAULT_MAX_IDLE_MS  1000
+
+// ==================== INPUT_DATA 청크 ====================
+
+/**
+ * INPUT_DATA 페이로드 첫 바이트 (청크 종류).
+ * dump 응답 순서: RECORDS (오래된 순, 여러 개) → END.
+ *
+ * - RECORDS: [kind][0][count u16] + count × input_trace_record_t
+ * - END:     [kind][0][0][0] + [records u32][lost u32][now_us u32]
+ *            lost = 링이 덮어써서 잃은 레코드 수, now_us = dump 시각 (ts_us와 같은 시계)
+ * 정수는 모두 Little-Endian입니다.
+ */
+typedef enum {
+    INPUT_CHUNK_RECORDS = 0,
+    INPUT_CHUNK_END     = 1,
+} input_trace_chunk_t;
+
+// ==================== 기록 API ====================
+
+/**
+ * 기록 링 확보 후 기록 시작 (app_main, 입력 태스크 생성 전 1회).
+ *
+ * @return false: PSRAM 부족 (기록/재생 비활성)
+ */
+bool input_trace_init(void);
+
+/**
+ * 레코드 기록 (uart_task, HID 리포트 전송 경로, 재생 태스크).
+ * 재생 중이면 INPUT_TRACE_FLAG_REPLAY가 붙습니다.
+ */
+void input_trace_record(input_trace_kind_t kind, const void *data, uint8_t len);
+
+/** 링을 비우고 다시 기록 */
+void input_trace_start(void);
+
+/** 기록 중지 (링 내용 유지) */
+void input_trace_stop(void);
+
+// ==================== 재생 API ====================
+
+/**
+ * 재생 중인지 (uart_task가 실제 입력을 버릴지 판단).
+ */
+bool input_trace_replay_active(void);
+
+/**
+ * hid_task가 프레임 처리 시 쓸 시각 (포인터 다이나믹스 입력).
+ *
+ * 재생 프레임이면 재생 시작 시각 + 기록된 경과 시각, 아니면 esp_timer_get_time().
+ * 배속 재생 뒤에도 단조 증가하도록 보정합니다. hid_task 전용.
+ *
+ * @param seq 처리할 (코얼레싱된 마지막) 프레임의 seq
+ */
+int64_t input_trace_frame_time_us(uint8_t seq);
+
+/** 재생 버퍼 비우기 (재생 중이면 무시) */
+bool input_trace_replay_clear(void);
+
+/**
+ * 재생 버퍼 끝에 레코드 추가 (재생 중이면 무시).
+ *
+ * @return false: 버퍼 확보 실패, 재생 중이거나 용량 초과
+ */
+bool input_trace_replay_append(const input_trace_record_t *records, uint32_t count);
+
+/**
+ * 기록 링의 실제 입력 프레임(재생 프레임 제외)을 재생 버퍼로 복사.
+ * 용량을 넘으면 가장 최근 INPUT_TRACE_REPLAY_RECORDS개를 복사합니다.
+ *
+ * @return 복사한 프레임 수
+ */
+uint32_t input_trace_replay_load_recorded(void);
+
+/** 적재된 재생 레코드 수 */
+uint32_t input_trace_replay_loaded(void);
+
+/**
+ * 재생 시작 (재생 태스크 생성).
+ *
+ * @param speed_pct   배속 (%, 100 = 원래 속도, 0 = 대기 없음)
+ * @param max_idle_ms 모두 뗀 상태의 간격 상한 (0 = 압축 안 함)
+ * @return false: 적재된 프레임 없음, 이미 재생 중, frame_queue 없음
+ */
+bool input_trace_replay_start(uint16_t speed_pct, uint32_t max_idle_ms);
+
+/** 재생 중지 (모두 뗀 프레임을 주입하고 태스크 종료) */
+void input_trace_replay_stop(void);
+
+// ==================== 상태/전송 ====================
+
+/**
+ * 상태를 압축 JSON으로 작성.
+ *
+ * 형식: {"recording":true,"records":n,"capacity":n,"lost":n,
+ *        "replay":{"state":"idle","loaded":n,"capacity":n,"played":n,"dropped":n,"speed":n}}
+ *
+ * @return 작성된 길이 (null 제외). 버퍼가 부족하면 0
+ */
+size_t input_trace_build_status_json(char *buf, size_t cap);
+
+/**
+ * 결과 전송 콜백 (청크 1개 = INPUT_DATA 프레임 1개).
+ *
+ * @return false면 전송을 중단합니다
+ */
+typedef bool (*input_trace_emit_fn)(const uint8_t *chunk, uint16_t len, void *ctx);
+
+/**
+ * 링의 레코드를 청크로 나눠 emit에 전달 (VCDC 태스크 전용).
+ * 전송하는 동안만 기록을 멈추고, 끝나면 원래 상태로 되돌립니다.
+ *
+ * @param last      최근 레코드만 보낼 개수 (0 = 전부)
+ * @param max_chunk 청크 최대 크기 (VCDC_MAX_PAYLOAD_SIZE)
+ * @return true: END 청크까지 전달, false: 링 없음 또는 전송 중단
+ */
+bool input_trace_dump(uint32_t last, uint16_t max_chunk, input_trace_emit_fn emit, void *ctx);
+
+#endif // INPUT_TRACE_H
@@ -0,0 +1,504 @@
+/**
+ * @file macro_engine.c
+ * @brief 펌웨어 매크로 엔진 구현
+ *
+ * 단축키 시퀀스를 Android 코루틴 지연 대신 ESP32-S3에서 재생합니다.
+ * - 저장: esp_partition API로 "macros" 파티션의 슬롯(4KB)에 기록
+ *         + 슬롯 캐시(PSRAM)에 같은 내용을 유지 (트리거는 플래시를 읽지 않음)
+ * - 재생: esp_timer one-shot을 스텝마다 재무장, 목표 시각은 절대 시각 기준
+ * - 전송: 키보드는 hid_keyboard_macro_*()로 키 엔진을 멈추고 전송,
+ *         마우스는 sendMouseReport() 공유
+ *
+ * 참조:
+ * - macro_engine.h - 플래시/업로드 포맷
+ * - vendor_cdc_handler.c - MACRO_UPLOAD 핸들러
+ * - uart_handler.c - UART_QUERY_MACRO_RUN 트리거
+ */
+
+#include "macro_engine.h"
+#include "hid_handler.h"
+#include "vendor_cdc_handler.h"  // vendor_cdc_crc16() 재사용
+#include "mem_alloc.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_partition.h"
+#include "freertos/FreeRTOS.h"
+#include <string.h>
+
+static const char *TAG = "MACRO";
+
+// ==================== 플래시 슬롯 포맷 ====================
+
+/** 유효한 슬롯 식별용 매직 ('BMAC') */
+#define MACRO_SLOT_MAGIC  0x43414D42u
+
+/**
+ * 슬롯 헤더 (8바이트).
+ * CRC16은 스텝 영역만 대상으로 계산합니다 (Vendor CDC와 동일 알고리즘).
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint8_t  macro_id;
+    uint8_t  step_count;
+    uint16_t crc16;
+} macro_slot_header_t;
+
+_Static_assert(sizeof(macro_slot_header_t) + MACRO_MAX_STEPS * sizeof(macro_step_t) <= MACRO_SLOT_SIZE,
+               "macro slot overflow");
+
+/**
+ * 슬롯 캐시 항목 (플래시 슬롯의 RAM 사본, step_count=0이면 빈 슬롯).
+ * 트리거는 UART 태스크에서 호출되므로 플래시 읽기 대신 이 사본을 사용합니다.
+ */
+typedef struct {
+    uint8_t      step_count;
+    macro_step_t steps[MACRO_MAX_STEPS];
+} macro_slot_cache_t;
+
+// ==================== 실행기 상태 ====================
+
+/** "macros" 파티션 (없으면 NULL, 저장/트리거 불가) */
+static const esp_partition_t *s_partition = NULL;
+
+/** 슬롯 캐시 (MACRO_MAX_COUNT개, mem_bulk_alloc; s_macro_lock으로 보호) */
+static macro_slot_cache_t *s_slot_cache = NULL;
+
+/** 스텝 실행 타이머 (one-shot, 스텝마다 재무장) */
+static esp_timer_handle_t s_step_timer = NULL;
+
+/** 재생 중 여부 및 트리거/타이머 콜백 간 보호용 스핀락 */
+static portMUX_TYPE s_macro_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool s_running = false;
+
+/** 재생 중인 매크로의 RAM 사본 (플래시 재기록과 무관하게 재생) */
+static macro_step_t s_active_steps[MACRO_MAX_STEPS];
+static uint8_t s_active_count = 0;
+static uint8_t s_step_index = 0;
+static uint8_t s_active_id = 0;
+
+/** 다음 스텝의 목표 실행 시각 (µs, esp_timer 기준) */
+static int64_t s_next_due_us = 0;
+
+/** 드라이런 (벤치마크): HID 전송 없이 타이밍만 측정 */
+static bool s_dry_run = false;
+
+/** 재생 중 눌린 상태 추적 (종료 시 자동 해제용) */
+static bool s_kb_pressed = false;
+static uint8_t s_mouse_buttons = 0;
+
+/** 스텝 타이밍 통계 */
+static macro_timing_stats_t s_stats;
+
+// ==================== 타이밍 통계 ====================
+
+static void stats_record(int64_t lateness_us)
+{
+    int32_t l = (int32_t)lateness_us;
+
+    if (s_stats.step_count == 0 || l < s_stats.min_lateness_us) s_stats.min_lateness_us = l;
+    if (s_stats.step_count == 0 || l > s_stats.max_lateness_us) s_stats.max_lateness_us = l;
+    s_stats.sum_lateness_us += l;
+    s_stats.step_count++;
+    if (l >= 100) s_stats.late_over_100us++;
+}
+
+void macro_engine_reset_timing_stats(void)
+{
+    taskENTER_CRITICAL(&s_macro_lock);
+    memset(&s_stats, 0, sizeof(s_stats));
+    taskEXIT_CRITICAL(&s_macro_lock);
+}
+
+void macro_engine_get_timing_stats(macro_timing_stats_t *out)
+{
+    if (out == NULL) return;
+    taskENTER_CRITICAL(&s_macro_lock);
+    *out = s_stats;
+    taskEXIT_CRITICAL(&s_macro_lock);
+}
+
+// ==================== 스텝 실행 ====================
+
+/**
+ * 스텝 하나를 HID 리포트로 변환하여 전송.
+ */
+static void execute_step(const macro_step_t *step)
+{
+    switch (step->type) {
+    case MACRO_STEP_KEYBOARD: {
+        hid_keyboard_macro_send(step->arg0, step->arg1, step->arg2);
+        s_kb_pressed = (step->arg0 != 0 || step->arg1 != 0 || step->arg2 != 0);
+        break;
+    }
+    case MACRO_STEP_MOUSE: {
+        hid_mouse_report_t mouse_report = {
+            .buttons = step->arg0,
+            .x = (int8_t)step->arg1,
+            .y = (int8_t)step->arg2,
+            .wheel = 0
+        };
+        sendMouseReport(&mouse_report);
+        s_mouse_buttons = step->arg0;
+        break;
+    }
+    case MACRO_STEP_WHEEL: {
+        hid_mouse_report_t mouse_report = {
+            .buttons = step->arg0,
+            .x = 0,
+            .y = 0,
+            .wheel = (int8_t)step->arg1
+        };
+        sendMouseReport(&mouse_report);
+        s_mouse_buttons = step->arg0;
+        break;
+    }
+    default:
+        ESP_LOGW(TAG, "Unknown step type 0x%02X (macro %u, step %u)",
+                 step->type, s_active_id, s_step_index);
+        break;
+    }
+}
+
+/**
+ * 재생 종료 처리: 눌린 키/버튼이 남아 있으면 해제 (키 stuck 방지).
+ */
+static void finish_playback(void)
+{
+    if (!s_dry_run) {
+        if (s_kb_pressed) {
+            hid_keyboard_macro_send(0, 0, 0);
+        }
+        if (s_mouse_buttons != 0) {
+            hid_mouse_report_t release_mouse = {0};
+            sendMouseReport(&release_mouse);
+        }
+        // 키 엔진 재개 (재생 중 누르고 있던 실시간 키가 있으면 다시 반영)
+        hid_keyboard_macro_end();
+    }
+
+    if (s_dry_run) {
+        macro_timing_stats_t stats;
+        macro_engine_get_timing_stats(&stats);
+        int32_t avg = (stats.step_count > 0)
+                      ? (int32_t)(stats.sum_lateness_us / stats.step_count) : 0;
+        ESP_LOGI(TAG, "Benchmark done: steps=%lu, lateness min=%ldus avg=%ldus max=%ldus, >=100us=%lu",
+                 (unsigned long)stats.step_count, (long)stats.min_lateness_us, (long)avg,
+                 (long)stats.max_lateness_us, (unsigned long)stats.late_over_100us);
+    } else {
+        ESP_LOGI(TAG, "Macro %u finished (%u steps)", s_active_id, s_active_count);
+    }
+
+    taskENTER_CRITICAL(&s_macro_lock);
+    s_running = false;
+    taskEXIT_CRITICAL(&s_macro_lock);
+}
+
+/**
+ * 스텝 타이머 콜백 (esp_timer 태스크 컨텍스트).
+ *
+ * 1. 목표 시각 대비 오차 기록
+ * 2. 스텝 실행 (첫 스텝 전에 키 엔진 정지)
+ * 3. 다음 목표 시각 = 이전 목표 시각 + delay_us (절대 시각 기준, 드리프트 없음)
+ * 4. 남은 시간으로 타이머 재무장 (이미 지났으면 즉시)
+ */
+static void macro_step_timer_cb(void *arg)
+{
+    (void)arg;
+
+    int64_t now = esp_timer_get_time();
+    const macro_step_t *step = &s_active_steps[s_step_index];
+
+    taskENTER_CRITICAL(&s_macro_lock);
+    stats_record(now - s_next_due_us);
+    taskEXIT_CRITICAL(&s_macro_lock);
+
+    if (!s_dry_run) {
+        if (s_step_index == 0) {
+            hid_keyboard_macro_begin();
+        }
+        execute_step(step);
+    }
+
+    s_step_index++;
+    if (s_step_index >= s_active_count) {
+        finish_playback();
+        return;
+    }
+
+    s_next_due_us += step->delay_us;
+    int64_t wait_us = s_next_due_us - esp_timer_get_time();
+    if (wait_us < 0) wait_us = 0;
+    esp_timer_start_once(s_step_timer, (uint64_t)wait_us);
+}
+
+/**
+ * 재생 시작 공통 처리 (s_active_steps/s_active_count 준비 후 호출).
+ */
+static void start_playback(void)
+{
+    s_step_index = 0;
+    s_kb_pressed = false;
+    s_mouse_buttons = 0;
+    s_next_due_us = esp_timer_get_time();
+    esp_timer_start_once(s_step_timer, 0);
+}
+
+/**
+ * 재생 슬롯 점유 시도 (이미 재생 중이면 false).
+ */
+static bool try_acquire_player(void)
+{
+    bool acquired = false;
+    taskENTER_CRITICAL(&s_macro_lock);
+    if (!s_running) {
+        s_running = true;
+        acquired = true;
+    }
+    taskEXIT_CRITICAL(&s_macro_lock);
+    return acquired;
+}
+
+static void release_player(void)
+{
+    taskENTER_CRITICAL(&s_macro_lock);
+    s_running = false;
+    taskEXIT_CRITICAL(&s_macro_lock);
+}
+
+// ==================== 슬롯 캐시 ====================
+
+/**
+ * 플래시 슬롯 하나를 캐시 항목으로 읽기 (무효/빈 슬롯이면 step_count=0).
+ */
+static void load_slot(uint8_t macro_id, macro_slot_cache_t *entry)
+{
+    size_t slot_offset = (size_t)macro_id * MACRO_SLOT_SIZE;
+    macro_slot_header_t header;
+
+    entry->step_count = 0;
+
+    if (esp_partition_read(s_partition, slot_offset, &header, sizeof(header)) != ESP_OK ||
+        header.magic != MACRO_SLOT_MAGIC || header.macro_id != macro_id ||
+        header.step_count == 0 || header.step_count > MACRO_MAX_STEPS) {
+        return;
+    }
+
+    size_t steps_size = (size_t)header.step_count * sizeof(macro_step_t);
+    if (esp_partition_read(s_partition, slot_offset + sizeof(header),
+                           entry->steps, steps_size) != ESP_OK ||
+        vendor_cdc_crc16((const uint8_t *)entry->steps, steps_size) != header.crc16) {
+        ESP_LOGE(TAG, "Macro %u CRC mismatch, slot ignored", macro_id);
+        return;
+    }
+
+    entry->step_count = header.step_count;
+}
+
+// ==================== 공개 API ====================
+
+bool macro_engine_init(void)
+{
+    s_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                           MACRO_PARTITION_SUBTYPE,
+                                           MACRO_PARTITION_LABEL);
+    if (s_partition == NULL) {
+        ESP_LOGW(TAG, "Partition '%s' not found, macro storage disabled", MACRO_PARTITION_LABEL);
+    } else if (s_partition->size < (uint32_t)MACRO_MAX_COUNT * MACRO_SLOT_SIZE) {
+        ESP_LOGW(TAG, "Partition '%s' too small (%lu bytes), macro storage disabled",
+                 MACRO_PARTITION_LABEL, (unsigned long)s_partition->size);
+        s_partition = NULL;
+    }
+
+    if (s_partition != NULL) {
+        s_slot_cache = mem_bulk_alloc((size_t)MACRO_MAX_COUNT * sizeof(macro_slot_cache_t));
+        if (s_slot_cache == NULL) {
+            ESP_LOGE(TAG, "Slot cache allocation failed, macro storage disabled");
+            s_partition = NULL;
+        } else {
+            uint8_t stored = 0;
+            for (uint8_t i = 0; i < MACRO_MAX_COUNT; i++) {
+                load_slot(i, &s_slot_cache[i]);
+                if (s_slot_cache[i].step_count > 0) stored++;
+            }
+            ESP_LOGI(TAG, "Slot cache loaded (%u macros)", stored);
+        }
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = macro_step_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "macro_step"
+    };
+
+    if (esp_timer_create(&timer_args, &s_step_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create macro step timer");
+        return false;
+    }
+
+    macro_engine_reset_timing_stats();
+
+    ESP_LOGI(TAG, "Macro engine initialized (slots=%d, max_steps=%d, storage=%s)",
+             MACRO_MAX_COUNT, MACRO_MAX_STEPS, s_partition ? "ok" : "none");
+    return true;
+}
+
+esp_err_t macro_engine_store(uint8_t macro_id, const macro_step_t *steps, uint8_t step_count)
+{
+    if (macro_id >= MACRO_MAX_COUNT || step_count > MACRO_MAX_STEPS ||
+        (step_count > 0 && steps == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_partition == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    size_t slot_offset = (size_t)macro_id * MACRO_SLOT_SIZE;
+    macro_slot_cache_t *entry = &s_slot_cache[macro_id];
+
+    // 같은 내용 재업로드: 플래시를 건드리지 않음 (쓰기는 이 태스크만 하므로 잠금 없이 비교)
+    if (entry->step_count == step_count &&
+        (step_count == 0 ||
+         memcmp(entry->steps, steps, (size_t)step_count * sizeof(macro_step_t)) == 0)) {
+        ESP_LOGD(TAG, "Macro %u unchanged, flash write skipped", macro_id);
+        return ESP_OK;
+    }
+
+    // 지우기 전에 캐시를 비움 (기록 실패 시 플래시와 같이 빈 슬롯으로 남음)
+    taskENTER_CRITICAL(&s_macro_lock);
+    entry->step_count = 0;
+    taskEXIT_CRITICAL(&s_macro_lock);
+
+    esp_err_t ret = esp_partition_erase_range(s_partition, slot_offset, MACRO_SLOT_SIZE);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Erase slot %u failed: %s", macro_id, esp_err_to_name(ret));
+        return ret;
+    }
+
+    // step_count=0: 지우기만 하고 종료 (빈 슬롯)
+    if (step_count == 0) {
+        ESP_LOGI(TAG, "Macro %u deleted", macro_id);
+        return ESP_OK;
+    }
+
+    size_t steps_size = (size_t)step_count * sizeof(macro_step_t);
+
+    // 스텝을 먼저 기록하고 헤더를 마지막에 기록 (쓰기 도중 전원 차단 시 슬롯이 무효로 남음)
+    ret = esp_partition_write(s_partition, slot_offset + sizeof(macro_slot_header_t),
+                              steps, steps_size);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Write steps for macro %u failed: %s", macro_id, esp_err_to_name(ret));
+        return ret;
+    }
+
+    macro_slot_header_t header = {
+        .magic = MACRO_SLOT_MAGIC,
+        .macro_id = macro_id,
+        .step_count = step_count,
+        .crc16 = vendor_cdc_crc16((const uint8_t *)steps, steps_size),
+    };
+
+    ret = esp_partition_write(s_partition, slot_offset, &header, sizeof(header));
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Write header for macro %u failed: %s", macro_id, esp_err_to_name(ret));
+        return ret;
+    }
+
+    // 스텝을 먼저 채우고 step_count를 마지막에 게시 (트리거는 s_macro_lock 아래에서 읽음)
+    memcpy(entry->steps, steps, steps_size);
+    taskENTER_CRITICAL(&s_macro_lock);
+    entry->step_count = step_count;
+    taskEXIT_CRITICAL(&s_macro_lock);
+
+    ESP_LOGI(TAG, "Macro %u stored (%u steps, crc=0x%04X)", macro_id, step_count, header.crc16);
+    return ESP_OK;
+}
+
+bool macro_engine_trigger(uint8_t macro_id)
+{
+    if (macro_id >= MACRO_MAX_COUNT || s_partition == NULL || s_step_timer == NULL) {
+        ESP_LOGW(TAG, "Trigger ignored: macro %u unavailable", macro_id);
+        return false;
+    }
+
+    if (!try_acquire_player()) {
+        ESP_LOGW(TAG, "Trigger ignored: macro %u already playing", s_active_id);
+        return false;
+    }
+
+    // 슬롯 캐시에서 재생 버퍼로 복사 (플래시 접근 없음, CRC는 적재 시 검증됨)
+    const macro_slot_cache_t *entry = &s_slot_cache[macro_id];
+    taskENTER_CRITICAL(&s_macro_lock);
+    uint8_t step_count = entry->step_count;
+    memcpy(s_active_steps, entry->steps, (size_t)step_count * sizeof(macro_step_t));
+    taskEXIT_CRITICAL(&s_macro_lock);
+
+    if (step_count == 0) {
+        ESP_LOGW(TAG, "Macro %u is empty or invalid", macro_id);
+        release_player();
+        return false;
+    }
+
+    s_active_id = macro_id;
+    s_active_count = step_count;
+    s_dry_run = false;
+
+    ESP_LOGD(TAG, "Macro %u triggered (%u steps)", macro_id, s_active_count);
+    start_playback();
+    return true;
+}
+
+bool macro_engine_is_running(void)
+{
+    return s_running;
+}
+
+bool macro_engine_run_benchmark(uint8_t step_count, uint32_t interval_us)
+{
+    if (step_count == 0 || step_count > MACRO_MAX_STEPS || s_step_timer == NULL) {
+        return false;
+    }
+
+    if (!try_acquire_player()) {
+        return false;
+    }
+
+    // 합성 매크로: 동일 간격의 빈 키보드 스텝 (드라이런이므로 전송되지 않음)
+    for (uint8_t i = 0; i < step_count; i++) {
+        s_active_steps[i] = (macro_step_t){
+            .type = MACRO_STEP_KEYBOARD,
+            .delay_us = interval_us,
+        };
+    }
+
+    s_active_id = 0xFF;
+    s_active_count = step_count;
+    s_dry_run = true;
+
+    macro_engine_reset_timing_stats();
+    ESP_LOGI(TAG, "Benchmark started: %u steps, interval=%luus",
+             step_count, (unsigned long)interval_us);
+    start_playback();
+    return true;
+}
+
+uint32_t macro_engine_stored_mask(void)
+{
+    uint32_t mask = 0;
+    if (s_slot_cache == NULL) {
+        return 0;
+    }
+    taskENTER_CRITICAL(&s_macro_lock);
+    for (uint8_t i = 0; i < MACRO_MAX_COUNT; i++) {
+        if (s_slot_cache[i].step_count > 0) {
+            mask |= 1u << i;
+        }
+    }
+    taskEXIT_CRITICAL(&s_macro_lock);
+    return mask;
+}
+
+size_t macro_engine_static_ram_bytes(void)
+{
+    return sizeof(s_active_steps);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file macro_engine.h
+ * @brief 펌웨어 매크로 엔진 - 플래시 저장 매크로의 µs 정밀도 재생
+ *
+ * 역할:
+ * - Windows 서버가 Vendor CDC(MACRO_UPLOAD)로 업로드한 매크로를 전용 파티션에 저장
+ * - Android의 1바이트 매크로 ID 프레임(UART_QUERY_MACRO_RUN)으로 재생 시작
+ * - esp_timer 기반 실행기가 절대 시각 기준으로 스텝 간 지연을 보장
+ *   (스텝 실행 시간이 다음 지연에 누적되지 않음)
+ * - 저장된 슬롯은 부팅/저장 시 RAM 캐시(PSRAM)에 유지하여 트리거가 플래시를 읽지 않음
+ * - 키보드 스텝은 재생 동안 키 엔진(디바운스/자동 반복)을 멈추고 전송 (hid_keyboard_macro_*),
+ *   마우스 스텝은 sendMouseReport() 경로를 그대로 공유
+ *
+ * 플래시 레이아웃 (partitions.csv의 "macros" 파티션):
+ * ┌───────────── 슬롯 0 (4KB) ─────────────┬── 슬롯 1 ──┬ ... ┬── 슬롯 31 ──┐
+ * │ header(8B) │ steps (8B × step_count)    │            │     │             │
+ * └────────────────────────────────────────┴────────────┴─────┴─────────────┘
+ * 매크로 ID = 슬롯 번호. 슬롯 단위로 섹터를 지우므로 다른 매크로에 영향 없음.
+ *
+ * MACRO_UPLOAD 페이로드 (바이너리, Little-Endian):
+ *   [macro_id 1B] [step_count 1B] [macro_step_t × step_count]
+ *   step_count = 0 이면 해당 슬롯 삭제
+ */
+
+#ifndef MACRO_ENGINE_H
+#define MACRO_ENGINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+// ==================== 매크로 상수 ====================
+
+/** 매크로 파티션 이름 / 서브타입 (partitions.csv와 일치해야 함) */
+#define MACRO_PARTITION_LABEL   "macros"
+#define MACRO_PARTITION_SUBTYPE 0x40
+
+/** 저장 가능한 최대 매크로 수 (슬롯 수) */
+#define MACRO_MAX_COUNT         32
+
+/** 슬롯 크기: 플래시 섹터 크기와 동일 (슬롯 단위 지우기) */
+#define MACRO_SLOT_SIZE         4096
+
+/** 매크로 하나의 최대 스텝 수: Vendor CDC 최대 페이로드(448B) - 헤더(2B) 를 스텝 크기로 나눈 값 */
+#define MACRO_MAX_STEPS         55
+
+// ==================== 매크로 스텝 ====================
+
+/**
+ * 매크로 스텝 종류.
+ */
+typedef enum {
+    MACRO_STEP_KEYBOARD = 0x01,  // arg0=modifier, arg1=keycode1, arg2=keycode2
+    MACRO_STEP_MOUSE    = 0x02,  // arg0=buttons, arg1=x (int8), arg2=y (int8)
+    MACRO_STEP_WHEEL    = 0x03,  // arg0=buttons, arg1=wheel (int8)
+} macro_step_type_t;
+
+/**
+ * 매크로 스텝 (8바이트 고정, 플래시/업로드 공통 포맷).
+ *
+ * delay_us는 "이 스텝 실행 후 다음 스텝까지의 지연"입니다.
+ * 실행기는 재생 시작 시각 + 누적 지연으로 각 스텝의 목표 시각을 계산합니다.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t  type;       // macro_step_type_t
+    uint8_t  arg0;
+    uint8_t  arg1;
+    uint8_t  arg2;
+    uint32_t delay_us;   // 다음 스텝까지 지연 (µs, Little-Endian)
+} macro_step_t;
+
+_Static_assert(sizeof(macro_step_t) == 8, "macro_step_t must be 8 bytes");
+
+// ==================== 타이밍 통계 ====================
+
+/**
+ * 스텝 타이밍 정확도 통계.
+ *
+ * lateness = 실제 실행 시각 - 목표 시각 (µs).
+ * 재생/벤치마크 모두 누적되며 macro_engine_reset_timing_stats()로 초기화합니다.
+ */
+typedef struct {
+    uint32_t step_count;       // 측정된 스텝 수
+    int32_t  min_lateness_us;  // 최소 지연 오차
+    int32_t  max_lateness_us;  // 최대 지연 오차
+    int64_t  sum_lateness_us;  // 평균 계산용 합계
+    uint32_t late_over_100us;  // 100µs 이상 늦은 스텝 수
+} macro_timing_stats_t;
+
+// ==================== 함수 선언 ====================
+
+/**
+ * 매크로 엔진 초기화.
+ *
+ * "macros" 파티션을 찾고 스텝 실행용 esp_timer를 생성합니다.
+ * 파티션이 없어도 벤치마크(드라이런)는 동작합니다.
+ *
+ * @return true: 초기화 성공, false: 타이머 생성 실패
+ */
+bool macro_engine_init(void);
+
+/**
+ * 매크로 저장 (플래시).
+ *
+ * 해당 슬롯 섹터를 지운 뒤 헤더(magic, id, step_count, CRC16)와 스텝을 기록하고
+ * 슬롯 캐시를 갱신합니다 (기록 실패 시 캐시도 빈 슬롯).
+ * 저장된 내용과 같으면 지우기/쓰기를 생략합니다 (Windows가 연결마다 다시 업로드해도 플래시 마모 없음).
+ * 재생 중인 매크로와 같은 ID여도 안전합니다 (재생은 RAM 사본 사용).
+ *
+ * @param macro_id   매크로 ID (0 ~ MACRO_MAX_COUNT-1)
+ * @param steps      스텝 배열 (step_count=0이면 NULL 가능)
+ * @param step_count 스텝 수 (0이면 슬롯 삭제)
+ * @return ESP_OK, ESP_ERR_INVALID_ARG (ID/스텝 범위 오류), ESP_ERR_NOT_FOUND (파티션 없음),
+ *         또는 플래시 오류 코드
+ */
+esp_err_t macro_engine_store(uint8_t macro_id, const macro_step_t *steps, uint8_t step_count);
+
+/**
+ * 매크로 재생 시작.
+ *
+ * 슬롯 캐시에서 매크로를 재생 버퍼로 복사하고 첫 스텝을 즉시 실행하도록 타이머를 시작합니다.
+ * 플래시를 읽지 않으므로 UART 태스크에서 호출해도 지연이 없습니다.
+ * 재생 중에는 새 트리거를 무시합니다.
+ *
+ * @param macro_id 매크로 ID
+ * @return true: 재생 시작, false: 재생 중/빈 슬롯/CRC 오류
+ */
+bool macro_engine_trigger(uint8_t macro_id);
+
+/**
+ * 매크로 재생 중 여부.
+ */
+bool macro_engine_is_running(void);
+
+/**
+ * 저장된 매크로 슬롯 비트맵 (비트 n = 매크로 ID n 저장됨, 슬롯 캐시 기준).
+ * UART_QUERY_MACRO_SLOTS 응답용이며 플래시를 읽지 않습니다.
+ */
+uint32_t macro_engine_stored_mask(void);
+
+/**
+ * 스텝 타이밍 벤치마크 시작 (드라이런).
+ *
+ * HID 리포트를 전송하지 않는 합성 매크로를 재생하여 실행기의
+ * 스케줄링 오차만 측정합니다. 통계를 초기화한 뒤 시작하며,
+ * 완료 시 결과를 로그로 출력합니다.
+ *
+ * @param step_count  스텝 수 (1 ~ MACRO_MAX_STEPS)
+ * @param interval_us 스텝 간격 (µs)
+ * @return true: 시작, false: 재생 중이거나 인자 오류
+ */
+bool macro_engine_run_benchmark(uint8_t step_count, uint32_t interval_us);
+
+/**
+ * 스텝 타이밍 통계 조회 / 초기화.
+ */
+void macro_engine_get_timing_stats(macro_timing_stats_t *out);
+void macro_engine_reset_timing_stats(void);
+
+/**
+ * 재생 버퍼의 정적 RAM 크기 (메모리 보고서용).
+ */
+size_t macro_engine_static_ram_bytes(void);
+
+#endif // MACRO_ENGINE_H
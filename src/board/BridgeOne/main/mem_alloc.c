@@ -0,0 +1,209 @@
+/**
+ * @file mem_alloc.c
+ * @brief 힙 capability 기반 할당 계층 구현
+ *
+ * 참조: mem_alloc.h
+ */
+
+#include "mem_alloc.h"
+#include "esp_heap_caps.h"
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "cJSON.h"
+
+static const char *TAG = "MEM_ALLOC";
+
+// ==================== 아레나 (VCDC 태스크 전용) ====================
+
+static uint8_t *s_arena      = NULL;    // 내부 SRAM에서 확보한 영역
+static size_t   s_arena_top  = 0;       // 다음 할당 오프셋
+static void    *s_arena_last = NULL;    // 마지막 할당 (해제 시 즉시 회수용)
+static uint32_t s_arena_live = 0;       // 해제되지 않은 할당 수 (아레나 + 내부 힙 fallback)
+
+// ==================== 통계 ====================
+
+typedef struct {
+    uint32_t count;
+    uint32_t bytes;
+    uint32_t failed;
+    uint64_t cycles_sum;
+    uint32_t cycles_max;
+} class_acc_t;
+
+static class_acc_t s_acc[MEM_ALLOC_CLASS_COUNT];
+static uint32_t s_arena_peak   = 0;
+static uint32_t s_arena_resets = 0;
+static uint32_t s_arena_leaks  = 0;
+
+/** 벌크 할당은 여러 태스크에서 호출되므로 통계 갱신을 보호 */
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *const s_class_names[MEM_ALLOC_CLASS_COUNT] = {
+    [MEM_ALLOC_ARENA]         = "arena",
+    [MEM_ALLOC_INTERNAL]      = "internal",
+    [MEM_ALLOC_BULK_PSRAM]    = "psram",
+    [MEM_ALLOC_BULK_INTERNAL] = "bulk-int",
+};
+
+static void stats_record(mem_alloc_class_t cls, size_t size, bool ok, uint32_t cycles)
+{
+    taskENTER_CRITICAL(&s_stats_lock);
+    class_acc_t *acc = &s_acc[cls];
+    if (ok) {
+        acc->count++;
+        acc->bytes += (uint32_t)size;
+        acc->cycles_sum += cycles;
+        if (cycles > acc->cycles_max) {
+            acc->cycles_max = cycles;
+        }
+    } else {
+        acc->failed++;
+    }
+    taskEXIT_CRITICAL(&s_stats_lock);
+}
+
+static bool in_arena(const void *ptr)
+{
+    return s_arena != NULL &&
+           (const uint8_t *)ptr >= s_arena && (const uint8_t *)ptr < s_arena + MEM_ARENA_SIZE;
+}
+
+// ==================== 아레나 API ====================
+
+void *mem_arena_alloc(size_t size)
+{
+    uint32_t start = esp_cpu_get_cycle_count();
+
+    size_t aligned = (size + (MEM_ARENA_ALIGN - 1)) & ~(size_t)(MEM_ARENA_ALIGN - 1);
+    if (s_arena != NULL && aligned <= MEM_ARENA_SIZE - s_arena_top) {
+        void *ptr = s_arena + s_arena_top;
+        s_arena_top += aligned;
+        s_arena_last = ptr;
+        s_arena_live++;
+        if (s_arena_top > s_arena_peak) {
+            s_arena_peak = (uint32_t)s_arena_top;
+        }
+        stats_record(MEM_ALLOC_ARENA, size, true, esp_cpu_get_cycle_count() - start);
+        return ptr;
+    }
+
+    // 아레나 부족: 내부 SRAM 힙 (PSRAM으로 넘어가지 않음)
+    void *ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (ptr != NULL) {
+        s_arena_live++;
+    }
+    stats_record(MEM_ALLOC_INTERNAL, size, ptr != NULL, esp_cpu_get_cycle_count() - start);
+    return ptr;
+}
+
+void mem_arena_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    s_arena_live--;
+
+    if (!in_arena(ptr)) {
+        heap_caps_free(ptr);
+        return;
+    }
+
+    // 직전 할당이면 바로 되돌림 (cJSON 출력 버퍼 확장 시 흔한 패턴)
+    if (ptr == s_arena_last) {
+        s_arena_top  = (size_t)((uint8_t *)ptr - s_arena);
+        s_arena_last = NULL;
+    }
+}
+
+void mem_arena_reset(void)
+{
+    if (s_arena_live != 0) {
+        // 아레나 포인터를 리셋 후까지 들고 있으면 다음 명령이 덮어씀
+        ESP_LOGW(TAG, "Arena reset with %lu live allocation(s)", (unsigned long)s_arena_live);
+        s_arena_leaks++;
+        s_arena_live = 0;
+    }
+    s_arena_top  = 0;
+    s_arena_last = NULL;
+    s_arena_resets++;
+}
+
+// ==================== 벌크 API ====================
+
+void *mem_bulk_alloc(size_t size)
+{
+    uint32_t start = esp_cpu_get_cycle_count();
+
+    void *ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ptr != NULL) {
+        stats_record(MEM_ALLOC_BULK_PSRAM, size, true, esp_cpu_get_cycle_count() - start);
+        return ptr;
+    }
+
+    ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    stats_record(MEM_ALLOC_BULK_INTERNAL, size, ptr != NULL, esp_cpu_get_cycle_count() - start);
+    return ptr;
+}
+
+void mem_bulk_free(void *ptr)
+{
+    heap_caps_free(ptr);
+}
+
+// ==================== 초기화 / 통계 ====================
+
+bool mem_alloc_init(void)
+{
+    s_arena = heap_caps_malloc(MEM_ARENA_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (s_arena == NULL) {
+        ESP_LOGE(TAG, "Failed to reserve %d byte internal arena", MEM_ARENA_SIZE);
+        return false;
+    }
+
+    // cJSON의 모든 할당(파싱 트리, 생성 객체, 직렬화 문자열)을 아레나로
+    cJSON_Hooks hooks = {
+        .malloc_fn = mem_arena_alloc,
+        .free_fn   = mem_arena_free,
+    };
+    cJSON_InitHooks(&hooks);
+
+    ESP_LOGI(TAG, "Internal arena reserved (%d bytes), cJSON hooks installed", MEM_ARENA_SIZE);
+    return true;
+}
+
+void mem_alloc_get_stats(mem_alloc_stats_t *out)
+{
+    taskENTER_CRITICAL(&s_stats_lock);
+    for (int i = 0; i < MEM_ALLOC_CLASS_COUNT; i++) {
+        const class_acc_t *acc = &s_acc[i];
+        out->cls[i].count      = acc->count;
+        out->cls[i].bytes      = acc->bytes;
+        out->cls[i].failed     = acc->failed;
+        out->cls[i].cycles_avg = (acc->count > 0) ? (uint32_t)(acc->cycles_sum / acc->count) : 0;
+        out->cls[i].cycles_max = acc->cycles_max;
+    }
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    out->arena_peak   = s_arena_peak;
+    out->arena_resets = s_arena_resets;
+    out->arena_leaks  = s_arena_leaks;
+}
+
+void mem_alloc_reset_stats(void)
+{
+    taskENTER_CRITICAL(&s_stats_lock);
+    for (int i = 0; i < MEM_ALLOC_CLASS_COUNT; i++) {
+        s_acc[i] = (class_acc_t){0};
+    }
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    s_arena_peak   = 0;
+    s_arena_resets = 0;
+    s_arena_leaks  = 0;
+}
+
+const char *mem_alloc_class_name(mem_alloc_class_t cls)
+{
+    return (cls < MEM_ALLOC_CLASS_COUNT) ? s_class_names[cls] : "?";
+}
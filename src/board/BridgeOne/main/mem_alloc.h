@@ -0,0 +1,124 @@
+/**
+ * @file mem_alloc.h
+ * @brief 힙 capability 기반 할당 계층 (명령 처리용 내부 SRAM 아레나 + 대용량 PSRAM)
+ *
+ * 배경:
+ * - sdkconfig.defaults가 CONFIG_SPIRAM_USE_MALLOC을 켜므로 malloc()은 내부 SRAM이 부족해지면
+ *   Octal PSRAM으로 넘어갑니다. PSRAM은 플래시와 캐시를 공유해 접근 시간이 들쭉날쭉합니다.
+ * - Vendor CDC 명령 처리 시간은 cJSON 할당 위치와 힙 단편화에 따라 달라졌습니다.
+ *
+ * 구조:
+ * - 아레나 (hot): 부팅 시 내부 SRAM에서 한 번 확보한 bump 할당 영역.
+ *   cJSON 훅과 명령 처리 중의 임시 버퍼가 여기서 할당되고,
+ *   vendor_cdc_task가 명령 하나를 끝낼 때마다 mem_arena_reset()으로 통째로 비웁니다.
+ *   아레나가 가득 차면 내부 SRAM 힙(MALLOC_CAP_INTERNAL)으로 넘어갑니다 (PSRAM 사용 안 함).
+ * - 벌크 (cold): 로그/트레이스처럼 크고 지연에 둔감한 버퍼는 PSRAM을 우선 사용합니다.
+ *
+ * 스레드 모델:
+ * - 아레나 API는 VCDC 태스크 전용입니다 (cJSON은 이 태스크에서만 사용).
+ * - 벌크 API와 통계 조회는 어느 태스크에서나 호출할 수 있습니다.
+ *
+ * 계측: 할당 종류별 횟수/바이트/실패/소요 CPU 사이클(평균, 최대)을 CDC "allocstat"로 확인합니다.
+ */
+
+#ifndef MEM_ALLOC_H
+#define MEM_ALLOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ==================== 상수 ====================
+
+/**
+ * 아레나 크기 (bytes).
+ * 최대 페이로드(448B) JSON 파싱 + 응답 생성/직렬화를 한 번에 담을 수 있는 크기.
+ * 실제 사용량은 allocstat의 arena peak로 확인합니다.
+ */
+#define MEM_ARENA_SIZE      4096
+
+/** 아레나 할당 정렬 단위 */
+#define MEM_ARENA_ALIGN     8
+
+// ==================== 통계 ====================
+
+/** 할당 종류 */
+typedef enum {
+    MEM_ALLOC_ARENA = 0,        // 내부 SRAM 아레나
+    MEM_ALLOC_INTERNAL,         // 아레나 초과 → 내부 SRAM 힙
+    MEM_ALLOC_BULK_PSRAM,       // 벌크 → PSRAM
+    MEM_ALLOC_BULK_INTERNAL,    // 벌크 → PSRAM 부족 시 내부 SRAM 힙
+    MEM_ALLOC_CLASS_COUNT
+} mem_alloc_class_t;
+
+/** 할당 종류별 통계 */
+typedef struct {
+    uint32_t count;             // 성공한 할당 수
+    uint32_t bytes;             // 누적 요청 바이트
+    uint32_t failed;            // 실패 수
+    uint32_t cycles_avg;        // 할당 1회 평균 CPU 사이클
+    uint32_t cycles_max;        // 할당 1회 최대 CPU 사이클
+} mem_alloc_class_stats_t;
+
+/** 전체 통계 */
+typedef struct {
+    mem_alloc_class_stats_t cls[MEM_ALLOC_CLASS_COUNT];
+    uint32_t arena_peak;        // 명령 하나가 사용한 아레나 최대 바이트
+    uint32_t arena_resets;      // 아레나 리셋 횟수 (처리한 명령 수)
+    uint32_t arena_leaks;       // 리셋 시점에 해제되지 않은 할당이 남아 있던 횟수
+} mem_alloc_stats_t;
+
+// ==================== API ====================
+
+/**
+ * 아레나 확보 및 cJSON 할당 훅 설치.
+ * vendor_cdc_task 시작 전 app_main()에서 1회 호출합니다.
+ *
+ * @return true: 성공, false: 내부 SRAM 부족 (cJSON은 기본 malloc 사용)
+ */
+bool mem_alloc_init(void);
+
+/**
+ * 명령 처리용 임시 메모리 할당 (VCDC 태스크 전용).
+ * 아레나에서 할당하고, 부족하면 내부 SRAM 힙을 사용합니다.
+ *
+ * @return 할당된 메모리, 실패 시 NULL
+ */
+void *mem_arena_alloc(size_t size);
+
+/**
+ * mem_arena_alloc() 메모리 해제.
+ * 아레나 영역이면 마지막 할당일 때만 즉시 회수되고 나머지는 mem_arena_reset()에서 회수됩니다.
+ */
+void mem_arena_free(void *ptr);
+
+/**
+ * 아레나 비우기 (명령 하나 처리 완료 후 VCDC 태스크에서 호출).
+ * 이 시점 이후 이전 아레나 포인터는 사용할 수 없습니다.
+ */
+void mem_arena_reset(void);
+
+/**
+ * 대용량/저빈도 버퍼 할당 (PSRAM 우선, 부족 시 내부 SRAM).
+ *
+ * @return 할당된 메모리, 실패 시 NULL
+ */
+void *mem_bulk_alloc(size_t size);
+
+/**
+ * mem_bulk_alloc() 메모리 해제.
+ */
+void mem_bulk_free(void *ptr);
+
+/**
+ * 통계 조회 / 초기화.
+ */
+void mem_alloc_get_stats(mem_alloc_stats_t *out);
+void mem_alloc_reset_stats(void);
+
+/**
+ * 할당 종류 이름 ("arena", "internal", "psram", "bulk-int").
+ */
+const char *mem_alloc_class_name(mem_alloc_class_t cls);
+
+#endif // MEM_ALLOC_H
@@ -0,0 +1,140 @@
+/**
+ * @file mem_report.c
+ * @brief 런타임 메모리 보고서 구현
+ *
+ * 참조: mem_report.h
+ */
+
+#include "mem_report.h"
+#include "vendor_cdc_handler.h"
+#include "hid_handler.h"
+#include "macro_engine.h"
+#include "usb_cdc_log.h"
+#include "vcdc_chunk.h"
+#include "esp_heap_caps.h"
+#include <stdio.h>
+
+/** 등록된 태스크 */
+typedef struct {
+    TaskHandle_t handle;
+    uint32_t     stack_size;
+} mem_task_entry_t;
+
+static mem_task_entry_t s_tasks[MEM_REPORT_MAX_TASKS];
+static uint8_t s_task_count = 0;
+
+/** 정적 RAM을 보고하는 모듈 */
+typedef struct {
+    const char *name;
+    size_t    (*static_bytes)(void);
+} mem_module_entry_t;
+
+static const mem_module_entry_t s_modules[] = {
+    { "vcdc",   vendor_cdc_static_ram_bytes   },
+    { "hid",    hid_handler_static_ram_bytes  },
+    { "macro",  macro_engine_static_ram_bytes },
+    { "cdclog", usb_cdc_log_static_ram_bytes  },
+};
+
+#define MEM_MODULE_COUNT  (sizeof(s_modules) / sizeof(s_modules[0]))
+
+/** 한 번의 조회 결과 */
+typedef struct {
+    size_t heap_free;
+    size_t heap_min;
+    size_t heap_largest;
+    size_t static_total;
+    bool   ok;
+} mem_summary_t;
+
+void mem_report_register_task(TaskHandle_t handle, uint32_t stack_size)
+{
+    if (handle == NULL || s_task_count >= MEM_REPORT_MAX_TASKS) {
+        return;
+    }
+    s_tasks[s_task_count].handle     = handle;
+    s_tasks[s_task_count].stack_size = stack_size;
+    s_task_count++;
+}
+
+/**
+ * 태스크의 남은 최소 스택 (bytes). ESP-IDF의 StackType_t는 1바이트입니다.
+ */
+static uint32_t task_high_water(const mem_task_entry_t *task)
+{
+    return (uint32_t)uxTaskGetStackHighWaterMark(task->handle) * sizeof(StackType_t);
+}
+
+static void mem_summarize(mem_summary_t *out)
+{
+    out->heap_free    = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    out->heap_min     = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+    out->heap_largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+
+    out->static_total = 0;
+    for (size_t i = 0; i < MEM_MODULE_COUNT; i++) {
+        out->static_total += s_modules[i].static_bytes();
+    }
+
+    out->ok = (out->static_total <= MEM_BUDGET_STATIC_BYTES) &&
+              (out->heap_min >= MEM_BUDGET_HEAP_MIN_FREE);
+    for (uint8_t i = 0; i < s_task_count; i++) {
+        if (task_high_water(&s_tasks[i]) < MEM_BUDGET_STACK_MARGIN) {
+            out->ok = false;
+        }
+    }
+}
+
+size_t mem_report_build_json(char *buf, size_t cap)
+{
+    mem_summary_t sum;
+    mem_summarize(&sum);
+
+    size_t pos = 0;
+    vcdc_json_append(buf, cap, &pos, "{\"heap\":[%u,%u,%u],\"tasks\":[",
+                     (unsigned)sum.heap_free, (unsigned)sum.heap_min, (unsigned)sum.heap_largest);
+    for (uint8_t i = 0; i < s_task_count; i++) {
+        vcdc_json_append(buf, cap, &pos, "%s[\"%s\",%u,%u]", (i > 0) ? "," : "",
+                         pcTaskGetName(s_tasks[i].handle),
+                         (unsigned)s_tasks[i].stack_size, (unsigned)task_high_water(&s_tasks[i]));
+    }
+    vcdc_json_append(buf, cap, &pos, "],\"static\":{");
+    for (size_t i = 0; i < MEM_MODULE_COUNT; i++) {
+        vcdc_json_append(buf, cap, &pos, "\"%s\":%u,", s_modules[i].name,
+                         (unsigned)s_modules[i].static_bytes());
+    }
+    vcdc_json_append(buf, cap, &pos, "\"total\":%u},\"ok\":%s}",
+                     (unsigned)sum.static_total, sum.ok ? "true" : "false");
+
+    return (pos < cap) ? pos : 0;
+}
+
+void mem_report_print(void)
+{
+    mem_summary_t sum;
+    mem_summarize(&sum);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "\r\nHeap (internal) free=%u min=%u largest=%u (budget min %u)\r\n",
+             (unsigned)sum.heap_free, (unsigned)sum.heap_min, (unsigned)sum.heap_largest,
+             (unsigned)MEM_BUDGET_HEAP_MIN_FREE);
+    usb_cdc_log_write(msg);
+
+    for (uint8_t i = 0; i < s_task_count; i++) {
+        snprintf(msg, sizeof(msg), "Task %-8s stack=%u free(min)=%u\r\n",
+                 pcTaskGetName(s_tasks[i].handle), (unsigned)s_tasks[i].stack_size,
+                 (unsigned)task_high_water(&s_tasks[i]));
+        usb_cdc_log_write(msg);
+    }
+
+    for (size_t i = 0; i < MEM_MODULE_COUNT; i++) {
+        snprintf(msg, sizeof(msg), "Static %-7s %u bytes\r\n",
+                 s_modules[i].name, (unsigned)s_modules[i].static_bytes());
+        usb_cdc_log_write(msg);
+    }
+
+    snprintf(msg, sizeof(msg), "Static total %u / %u bytes, budget %s\r\n",
+             (unsigned)sum.static_total, (unsigned)MEM_BUDGET_STATIC_BYTES,
+             sum.ok ? "OK" : "EXCEEDED");
+    usb_cdc_log_write(msg);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file mem_report.h
+ * @brief 런타임 메모리 보고서 (힙, 태스크 스택, 모듈별 정적 RAM)
+ *
+ * 역할:
+ * - 내부 SRAM 힙 사용량 (현재 여유, 부팅 후 최소 여유, 최대 연속 블록)
+ * - 등록된 태스크의 스택 크기와 최고 수위(high-water mark, 남은 최소 여유)
+ * - 주요 모듈의 정적 버퍼 크기 (각 모듈의 *_static_ram_bytes() 접근자)
+ * - 위 값을 예산(MEM_BUDGET_*)과 비교한 합격 여부
+ *
+ * 조회 경로:
+ * - Vendor CDC: VCDC_CMD_MEM_QUERY → VCDC_CMD_MEM_REPORT (압축 JSON)
+ * - CDC 텍스트 명령: "mem"
+ *
+ * 빌드 시점의 오브젝트별 .bss/.data 크기는 `idf.py size-files` /
+ * `idf.py size-components`로 확인합니다. 이 모듈은 그 중 런타임에만 알 수 있는
+ * 값(스택 수위, 힙 단편화)과 예산 판정을 담당합니다.
+ */
+
+#ifndef MEM_REPORT_H
+#define MEM_REPORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// ==================== 예산 ====================
+//
+// 아래 값은 sizeof 합계와 ESP-IDF 기본 태스크 여유를 기준으로 잡은 추정치이며
+// 실기기에서 측정한 값이 아닙니다. 예산이나 태스크 스택을 줄일 때는 먼저 실기기에서
+// 입력/VCDC 부하를 건 뒤 "mem" 보고서의 high-water 값을 기록하고 그 값에 맞춥니다.
+
+/** 모듈 정적 버퍼 합계 상한 (bytes). 현재 합계 ≈ 3.9KB (프레임 풀 1.8KB + HID 메일박스 1KB + …) */
+#define MEM_BUDGET_STATIC_BYTES      4096
+
+/** 태스크마다 남아 있어야 하는 최소 스택 여유 (bytes) */
+#define MEM_BUDGET_STACK_MARGIN      512
+
+/** 부팅 후 내부 힙 최소 여유 하한 (bytes) */
+#define MEM_BUDGET_HEAP_MIN_FREE     (32 * 1024)
+
+/** 등록 가능한 최대 태스크 수 */
+#define MEM_REPORT_MAX_TASKS         6
+
+// ==================== API ====================
+
+/**
+ * 보고 대상 태스크 등록 (app_main()에서 태스크 생성 직후 호출).
+ *
+ * @param handle     xTaskCreatePinnedToCore()가 돌려준 핸들
+ * @param stack_size 생성 시 지정한 스택 크기 (bytes)
+ */
+void mem_report_register_task(TaskHandle_t handle, uint32_t stack_size);
+
+/**
+ * 메모리 보고서를 압축 JSON으로 작성.
+ *
+ * 형식: {"heap":[free,min,largest],"tasks":[["VCDC",size,hwm],...],
+ *        "static":{"vcdc":n,...,"total":n},"ok":true}
+ *
+ * @param buf 출력 버퍼 (VCDC_MAX_PAYLOAD_SIZE 이하 권장)
+ * @param cap 버퍼 크기
+ * @return 작성된 길이 (null 제외). 버퍼가 부족하면 0
+ */
+size_t mem_report_build_json(char *buf, size_t cap);
+
+/**
+ * 보고서를 사람이 읽는 형식으로 CDC 텍스트 출력 ("mem" 명령).
+ */
+void mem_report_print(void);
+
+#endif // MEM_REPORT_H
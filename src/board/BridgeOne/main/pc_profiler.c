@@ -0,0 +1,459 @@
+/**
+ * @file pc_profiler.c
+ * @brief 타이머 인터럽트 기반 PC 샘플링 프로파일러 구현
+ *
+ * 참조: pc_profiler.h
+ */
+
+#include "pc_profiler.h"
+#include "mem_alloc.h"
+#include "vcdc_chunk.h"
+#include "driver/gptimer.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_debug_helpers.h"   // esp_backtrace_get_next_frame()
+#include "esp_log.h"
+#include "esp_memory_utils.h"    // esp_stack_ptr_is_sane()
+#include "esp_timer.h"
+#include "xtensa_context.h"      // XtExcFrame
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "PC_PROF";
+
+/**
+ * 코어별 인터럽트 중첩 깊이 (FreeRTOS Xtensa 포트, _frxt_int_enter/_frxt_int_exit에서 증감).
+ * 샘플링 ISR 안에서 1이면 태스크를, 2 이상이면 다른 ISR을 끊은 것입니다.
+ */
+extern volatile unsigned port_interruptNesting[];
+
+// ==================== 상수 ====================
+
+/** 타이머 해상도 (1 tick = 1us) */
+#define PC_PROF_TIMER_RES_HZ    1000000
+
+/** 샘플링 인터럽트 레벨 (C 핸들러로 가능한 최고 레벨, 레벨 1~2 ISR도 끊음) */
+#define PC_PROF_INTR_LEVEL      3
+
+/**
+ * 샘플 간격 흔들림 폭 (주기의 1/8, 즉 ±1/16). 1kHz FreeRTOS 틱이나 1ms 주기 태스크와
+ * 같은 위상에서만 샘플링되는 앨리어싱을 막습니다.
+ */
+#define PC_PROF_JITTER_SHIFT    3
+
+// ==================== 상태 ====================
+
+/** 코어별 샘플러 (ISR은 자기 코어 구조체만 씀) */
+typedef struct {
+    gptimer_handle_t timer;
+    uint32_t *table;            // PSRAM, PC_PROF_TABLE_ENTRIES × s_stride 워드
+    uint32_t  samples;          // 전체 샘플 수 (isr 포함)
+    uint32_t  isr;              // 다른 ISR 실행 중이던 샘플
+    uint32_t  dropped;          // 테이블 탐색 한도 초과로 버린 샘플
+    uint32_t  entries;          // 사용 중인 엔트리 수
+    uint64_t  cycles;           // 콜백 사이클 합 (오버헤드 계산용)
+    uint32_t  rng;              // 샘플 간격 흔들림용 xorshift 상태
+} core_prof_t;
+
+static core_prof_t s_core[portNUM_PROCESSORS];
+static pc_prof_config_t s_config = {
+    .hz    = PC_PROF_DEFAULT_HZ,
+    .ms    = PC_PROF_DEFAULT_MS,
+    .depth = PC_PROF_DEFAULT_DEPTH,
+};
+static uint32_t   s_period_us = 1000000 / PC_PROF_DEFAULT_HZ;
+static uint8_t    s_stride    = 2 + PC_PROF_DEFAULT_DEPTH;  // 엔트리 크기 (워드): count + task + PC × depth
+static atomic_int s_state     = PC_PROF_IDLE;
+static int64_t    s_start_us  = 0;
+static int64_t    s_stop_us   = 0;
+static bool       s_timers_ready = false;
+static esp_timer_handle_t s_stop_timer = NULL;
+
+// ==================== 샘플링 ISR ====================
+
+/**
+ * (task, PC...) 키의 샘플 수 증가. 키는 key[1..stride-1], key[0]은 사용하지 않음.
+ */
+static void IRAM_ATTR table_add(core_prof_t *cp, const uint32_t *key)
+{
+    const uint8_t stride = s_stride;
+
+    uint32_t hash = 2166136261u;  // FNV-1a (워드 단위)
+    for (uint8_t i = 1; i < stride; i++) {
+        hash = (hash ^ key[i]) * 16777619u;
+    }
+
+    for (uint32_t probe = 0; probe < PC_PROF_MAX_PROBE; probe++) {
+        uint32_t *entry = cp->table + ((hash + probe) & (PC_PROF_TABLE_ENTRIES - 1)) * stride;
+
+        if (entry[0] == 0) {
+            for (uint8_t i = 1; i < stride; i++) {
+                entry[i] = key[i];
+            }
+            entry[0] = 1;
+            cp->entries++;
+            return;
+        }
+
+        bool same = true;
+        for (uint8_t i = 1; i < stride && same; i++) {
+            same = (entry[i] == key[i]);
+        }
+        if (same) {
+            entry[0]++;
+            return;
+        }
+    }
+    cp->dropped++;
+}
+
+/**
+ * 끊긴 태스크의 예외 프레임에서 스택을 거슬러 올라가며 key[2..]를 채움.
+ */
+static void IRAM_ATTR capture_stack(const XtExcFrame *frame, uint32_t *key, uint8_t depth)
+{
+    key[2] = frame->pc;
+
+    esp_backtrace_frame_t bt = {
+        .pc        = frame->pc,
+        .sp        = frame->a1,
+        .next_pc   = frame->a0,
+        .exc_frame = NULL,
+    };
+    bool valid = esp_stack_ptr_is_sane(bt.sp);
+
+    for (uint8_t d = 1; d < depth; d++) {
+        if (valid && bt.next_pc != 0) {
+            valid = esp_backtrace_get_next_frame(&bt);
+            key[2 + d] = valid ? bt.pc : 0;
+        } else {
+            key[2 + d] = 0;
+        }
+    }
+}
+
+static bool IRAM_ATTR prof_on_alarm(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata,
+                                    void *user_ctx)
+{
+    uint32_t start = esp_cpu_get_cycle_count();
+    core_prof_t *cp = user_ctx;
+
+    if (atomic_load_explicit(&s_state, memory_order_relaxed) != PC_PROF_RUNNING) {
+        return false;
+    }
+
+    // 다음 알람: 주기 ± 1/16 주기
+    cp->rng ^= cp->rng << 13;
+    cp->rng ^= cp->rng >> 17;
+    cp->rng ^= cp->rng << 5;
+    uint32_t span   = s_period_us >> PC_PROF_JITTER_SHIFT;
+    uint32_t jitter = (span > 0) ? (cp->rng % span) : 0;
+    gptimer_alarm_config_t alarm = {
+        .alarm_count = edata->alarm_value + s_period_us - (span / 2) + jitter,
+    };
+    gptimer_set_alarm_action(timer, &alarm);
+
+    int core = esp_cpu_get_core_id();
+    if (port_interruptNesting[core] > 1) {
+        cp->isr++;
+    } else {
+        // TCB의 첫 필드(pxTopOfStack)에 인터럽트 진입 시점의 예외 프레임 주소가 저장됨
+        TaskHandle_t task = xTaskGetCurrentTaskHandleForCore(core);
+        const XtExcFrame *frame = (task != NULL) ? *(XtExcFrame *const *)task : NULL;
+        if (frame != NULL) {
+            uint32_t key[2 + PC_PROF_MAX_DEPTH];
+            key[1] = (uint32_t)task;
+            capture_stack(frame, key, (uint8_t)(s_stride - 2));
+            table_add(cp, key);
+        }
+    }
+    cp->samples++;
+    cp->cycles += esp_cpu_get_cycle_count() - start;
+    return false;
+}
+
+// ==================== 타이머 준비 ====================
+
+typedef struct {
+    core_prof_t      *cp;
+    SemaphoreHandle_t done;
+    esp_err_t         err;
+} timer_setup_t;
+
+/**
+ * GPTimer 생성 + 콜백 등록. 인터럽트는 이 함수를 실행한 코어에 할당되므로
+ * 코어마다 그 코어에 고정된 임시 태스크에서 실행합니다.
+ */
+static void timer_setup_task(void *arg)
+{
+    timer_setup_t *setup = arg;
+    core_prof_t *cp = setup->cp;
+
+    gptimer_config_t config = {
+        .clk_src       = GPTIMER_CLK_SRC_DEFAULT,
+        .direction     = GPTIMER_COUNT_UP,
+        .resolution_hz = PC_PROF_TIMER_RES_HZ,
+        .intr_priority = PC_PROF_INTR_LEVEL,
+    };
+    setup->err = gptimer_new_timer(&config, &cp->timer);
+    if (setup->err == ESP_OK) {
+        gptimer_event_callbacks_t cbs = { .on_alarm = prof_on_alarm };
+        setup->err = gptimer_register_event_callbacks(cp->timer, &cbs, cp);
+    }
+    if (setup->err == ESP_OK) {
+        setup->err = gptimer_enable(cp->timer);
+    }
+
+    xSemaphoreGive(setup->done);
+    vTaskDelete(NULL);
+}
+
+static void stop_timer_cb(void *arg)
+{
+    (void)arg;
+    pc_profiler_stop();
+}
+
+static bool timers_init(void)
+{
+    if (s_timers_ready) {
+        return true;
+    }
+
+    SemaphoreHandle_t done = xSemaphoreCreateBinary();
+    if (done == NULL) {
+        return false;
+    }
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (s_core[core].timer != NULL) {
+            continue;  // 이전 시도에서 이미 준비된 코어
+        }
+        timer_setup_t setup = { .cp = &s_core[core], .done = done, .err = ESP_FAIL };
+        if (xTaskCreatePinnedToCore(timer_setup_task, "prof_init", 3072, &setup,
+                                    configMAX_PRIORITIES - 1, NULL, core) != pdPASS) {
+            vSemaphoreDelete(done);
+            return false;
+        }
+        xSemaphoreTake(done, portMAX_DELAY);
+        if (setup.err != ESP_OK) {
+            ESP_LOGE(TAG, "GPTimer setup failed on core %d: %s", core, esp_err_to_name(setup.err));
+            vSemaphoreDelete(done);
+            return false;
+        }
+        s_core[core].rng = 0x9E3779B9u ^ (uint32_t)core;
+    }
+    vSemaphoreDelete(done);
+
+    const esp_timer_create_args_t args = {
+        .callback = stop_timer_cb,
+        .name     = "prof_stop",
+    };
+    if (esp_timer_create(&args, &s_stop_timer) != ESP_OK) {
+        return false;
+    }
+
+    s_timers_ready = true;
+    return true;
+}
+
+// ==================== 제어 API ====================
+
+static uint32_t clamp_u32(uint32_t v, uint32_t lo, uint32_t hi)
+{
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+bool pc_profiler_start(const pc_prof_config_t *config)
+{
+    pc_profiler_stop();
+
+    if (!timers_init()) {
+        return false;
+    }
+
+    s_config.hz    = clamp_u32(config->hz, PC_PROF_MIN_HZ, PC_PROF_MAX_HZ);
+    s_config.ms    = clamp_u32(config->ms, 1, PC_PROF_MAX_MS);
+    s_config.depth = (uint8_t)clamp_u32(config->depth, 1, PC_PROF_MAX_DEPTH);
+    s_period_us    = PC_PROF_TIMER_RES_HZ / s_config.hz;
+    s_stride       = (uint8_t)(2 + s_config.depth);
+
+    // 깊이가 바뀌면 엔트리 크기도 바뀌므로 매번 새로 확보
+    size_t table_bytes = (size_t)PC_PROF_TABLE_ENTRIES * s_stride * sizeof(uint32_t);
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        core_prof_t *cp = &s_core[core];
+        mem_bulk_free(cp->table);
+        cp->table = mem_bulk_alloc(table_bytes);
+        if (cp->table == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate %u byte sample table", (unsigned)table_bytes);
+            atomic_store(&s_state, PC_PROF_IDLE);
+            return false;
+        }
+        memset(cp->table, 0, table_bytes);
+        cp->samples = cp->isr = cp->dropped = cp->entries = 0;
+        cp->cycles  = 0;
+    }
+
+    s_start_us = esp_timer_get_time();
+    s_stop_us  = 0;
+    atomic_store(&s_state, PC_PROF_RUNNING);
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        gptimer_alarm_config_t alarm = { .alarm_count = s_period_us };
+        gptimer_set_raw_count(s_core[core].timer, 0);
+        gptimer_set_alarm_action(s_core[core].timer, &alarm);
+        gptimer_start(s_core[core].timer);
+    }
+    esp_timer_start_once(s_stop_timer, (uint64_t)s_config.ms * 1000);
+
+    ESP_LOGI(TAG, "Sampling started: %lu Hz x %lu ms, depth %u",
+             (unsigned long)s_config.hz, (unsigned long)s_config.ms, s_config.depth);
+    return true;
+}
+
+void pc_profiler_stop(void)
+{
+    int expected = PC_PROF_RUNNING;
+    if (!atomic_compare_exchange_strong(&s_state, &expected, PC_PROF_DONE)) {
+        return;
+    }
+
+    esp_timer_stop(s_stop_timer);  // 시간 만료로 호출된 경우 이미 멈춰 있음
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        gptimer_stop(s_core[core].timer);
+    }
+    s_stop_us = esp_timer_get_time();
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        ESP_LOGI(TAG, "Sampling stopped: core%d samples=%lu", core, (unsigned long)s_core[core].samples);
+    }
+}
+
+pc_prof_state_t pc_profiler_get_state(void)
+{
+    return (pc_prof_state_t)atomic_load(&s_state);
+}
+
+// ==================== 상태 보고 ====================
+
+/** 코어별 값 배열 ("name":[a,b]) */
+static void json_append_cores(char *buf, size_t cap, size_t *pos, const char *name,
+                              const uint32_t *values)
+{
+    vcdc_json_append(buf, cap, pos, ",\"%s\":[", name);
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        vcdc_json_append(buf, cap, pos, "%s%u", (core > 0) ? "," : "", (unsigned)values[core]);
+    }
+    vcdc_json_append(buf, cap, pos, "]");
+}
+
+size_t pc_profiler_build_status_json(char *buf, size_t cap)
+{
+    static const char *const state_names[] = { "idle", "running", "done" };
+    pc_prof_state_t state = pc_profiler_get_state();
+
+    int64_t end_us = (state == PC_PROF_RUNNING) ? esp_timer_get_time() : s_stop_us;
+    uint64_t elapsed_cycles = (uint64_t)(end_us - s_start_us) * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+
+    uint32_t samples[portNUM_PROCESSORS], isr[portNUM_PROCESSORS];
+    uint32_t dropped[portNUM_PROCESSORS], entries[portNUM_PROCESSORS], load[portNUM_PROCESSORS];
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        const core_prof_t *cp = &s_core[core];
+        samples[core] = cp->samples;
+        isr[core]     = cp->isr;
+        dropped[core] = cp->dropped;
+        entries[core] = cp->entries;
+        load[core]    = (state != PC_PROF_IDLE && elapsed_cycles > 0)
+                        ? (uint32_t)(cp->cycles * 1000000u / elapsed_cycles) : 0;
+    }
+
+    size_t pos = 0;
+    vcdc_json_append(buf, cap, &pos, "{\"state\":\"%s\",\"hz\":%u,\"ms\":%u,\"depth\":%u",
+                     state_names[state], (unsigned)s_config.hz, (unsigned)s_config.ms,
+                     (unsigned)s_config.depth);
+    json_append_cores(buf, cap, &pos, "samples", samples);
+    json_append_cores(buf, cap, &pos, "isr", isr);
+    json_append_cores(buf, cap, &pos, "dropped", dropped);
+    json_append_cores(buf, cap, &pos, "entries", entries);
+    json_append_cores(buf, cap, &pos, "load_ppm", load);
+    vcdc_json_append(buf, cap, &pos, "}");
+
+    return (pos < cap) ? pos : 0;
+}
+
+// ==================== 결과 전송 ====================
+
+static bool dump_records(int core, uint8_t *chunk, uint16_t max_chunk,
+                         pc_prof_emit_fn emit, void *ctx)
+{
+    const core_prof_t *cp = &s_core[core];
+    const uint16_t record_bytes = (uint16_t)(s_stride * sizeof(uint32_t));
+
+    chunk[0] = PC_PROF_CHUNK_RECORDS;
+    chunk[1] = (uint8_t)core;
+    chunk[2] = s_config.depth;
+    chunk[3] = 0;
+    uint16_t len = 4;
+
+    for (uint32_t i = 0; i < PC_PROF_TABLE_ENTRIES; i++) {
+        const uint32_t *entry = cp->table + i * s_stride;
+        if (entry[0] == 0) {
+            continue;
+        }
+        if (len + record_bytes > max_chunk || chunk[3] == UINT8_MAX) {
+            if (!emit(chunk, len, ctx)) {
+                return false;
+            }
+            len = 4;
+            chunk[3] = 0;
+        }
+        for (uint8_t w = 0; w < s_stride; w++) {
+            vcdc_put_u32(&chunk[len + w * 4], entry[w]);
+        }
+        len += record_bytes;
+        chunk[3]++;
+    }
+    return (chunk[3] == 0) || emit(chunk, len, ctx);
+}
+
+bool pc_profiler_dump(uint16_t max_chunk, pc_prof_emit_fn emit, void *ctx)
+{
+    pc_profiler_stop();
+    if (pc_profiler_get_state() != PC_PROF_DONE || s_core[0].table == NULL) {
+        return false;
+    }
+
+    uint8_t *chunk = mem_arena_alloc(max_chunk);
+    if (chunk == NULL) {
+        return false;
+    }
+
+    bool ok = vcdc_chunk_dump_tasks(PC_PROF_CHUNK_TASKS, chunk, max_chunk, emit, ctx);
+    for (int core = 0; core < portNUM_PROCESSORS && ok; core++) {
+        ok = dump_records(core, chunk, max_chunk, emit, ctx);
+    }
+
+    if (ok) {
+        uint32_t records = 0, samples = 0, isr = 0, dropped = 0;
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            records += s_core[core].entries;
+            samples += s_core[core].samples;
+            isr     += s_core[core].isr;
+            dropped += s_core[core].dropped;
+        }
+        memset(chunk, 0, 4);
+        chunk[0] = PC_PROF_CHUNK_END;
+        vcdc_put_u32(&chunk[4], records);
+        vcdc_put_u32(&chunk[8], samples);
+        vcdc_put_u32(&chunk[12], isr);
+        vcdc_put_u32(&chunk[16], dropped);
+        ok = emit(chunk, 20, ctx);
+    }
+
+    mem_arena_free(chunk);
+    return ok;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file pc_profiler.h
+ * @brief 타이머 인터럽트 기반 PC 샘플링 프로파일러
+ *
+ * 역할:
+ * - 코어마다 GPTimer 알람 인터럽트를 하나씩 두고, 인터럽트가 끊은 태스크의 PC와
+ *   호출 스택(최대 PC_PROF_MAX_DEPTH 단계)을 샘플링
+ * - (태스크, 스택)별 샘플 수를 PSRAM 해시 테이블(코어별)에 누적
+ * - 요청 시 Vendor CDC로 테이블 전체를 여러 프레임에 나눠 전송
+ *   → 호스트 CLI(tools/pcprof.py)가 펌웨어 ELF로 심볼화해 flat profile / folded stacks 출력
+ *
+ * 샘플링 방식:
+ * - 인터럽트 레벨 3 (C 핸들러 최고 레벨). 레벨 1~2 ISR 실행 중 샘플은 "isr"로만 셉니다.
+ * - 크리티컬 섹션(레벨 3 마스킹) 안의 코드는 샘플링되지 않고, 섹션이 끝난 직후 위치로 잡힙니다.
+ * - 인터럽트 진입 시 ESP-IDF 포트가 태스크 SP를 TCB(pxTopOfStack)에 저장하고
+ *   레지스터 윈도우를 스택에 내려 두므로, 그 예외 프레임에서 스택을 거슬러 올라갑니다.
+ * - 샘플링 인터럽트는 플래시 캐시가 꺼진 동안(플래시 쓰기) 지연되므로 그 구간은 빠집니다.
+ *
+ * 오버헤드: 샘플 1회 = 인터럽트 진입/복귀 + 콜백 (깊이 4 기준 수백 사이클).
+ * 기본 1kHz에서 코어당 1% 미만이며, 실측값(콜백 사이클 합 / 경과 사이클)은 상태 응답의 "load_ppm"입니다.
+ *
+ * 제어/전송 (Vendor CDC):
+ * - VCDC_CMD_PROF_CONTROL (JSON): {"op":"start","hz":1000,"ms":5000,"depth":4} / "stop" / "status" / "dump"
+ * - VCDC_CMD_PROF_STATUS  (JSON): 상태 응답 (pc_profiler_build_status_json 참조)
+ * - VCDC_CMD_PROF_DATA    (바이너리): dump 응답, 형식은 pc_prof_chunk_t 참조
+ */
+
+#ifndef PC_PROFILER_H
+#define PC_PROFILER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ==================== 상수 ====================
+
+/** 기본 / 허용 샘플링 주파수 (코어당, Hz) */
+#define PC_PROF_DEFAULT_HZ          1000
+#define PC_PROF_MIN_HZ              100
+#define PC_PROF_MAX_HZ              10000
+
+/** 기본 / 최대 샘플링 시간 (ms) */
+#define PC_PROF_DEFAULT_MS          5000
+#define PC_PROF_MAX_MS              60000
+
+/** 기본 / 최대 호출 스택 깊이 (1 = 끊긴 PC만) */
+#define PC_PROF_DEFAULT_DEPTH       4
+#define PC_PROF_MAX_DEPTH           8
+
+/**
+ * 코어별 해시 테이블 엔트리 수 (2의 거듭제곱).
+ * 엔트리 = count + task + PC × depth (깊이 8이면 40B → 코어당 160KB, PSRAM).
+ */
+#define PC_PROF_TABLE_ENTRIES       4096
+
+/** 빈 슬롯을 찾을 때 최대 탐색 횟수 (초과 시 dropped) */
+#define PC_PROF_MAX_PROBE           16
+
+// ==================== PROF_DATA 청크 ====================
+
+/**
+ * PROF_DATA 페이로드 첫 바이트 (청크 종류).
+ * dump 응답 순서: TASKS 1개 이상 → RECORDS (코어 0, 코어 1) → END 1개.
+ *
+ * - TASKS:   [kind][count] + count × ([handle u32][name_len u8][name])
+ * - RECORDS: [kind][core][depth][count] + count × ([samples u32][task u32][pc u32 × depth])
+ *            pc[0]은 끊긴 명령 주소, pc[1..]은 호출자의 리턴 주소(윈도우 비트 포함, 가공 안 함)
+ * - END:     [kind][0][0][0] + [records u32][samples u32][isr u32][dropped u32]
+ * 정수는 모두 Little-Endian입니다.
+ */
+typedef enum {
+    PC_PROF_CHUNK_TASKS   = 0,
+    PC_PROF_CHUNK_RECORDS = 1,
+    PC_PROF_CHUNK_END     = 2,
+} pc_prof_chunk_t;
+
+// ==================== 설정 / 상태 ====================
+
+/** 샘플링 설정 */
+typedef struct {
+    uint32_t hz;        // 코어당 샘플링 주파수
+    uint32_t ms;        // 샘플링 시간
+    uint8_t  depth;     // 기록할 스택 깊이
+} pc_prof_config_t;
+
+/** 프로파일러 상태 */
+typedef enum {
+    PC_PROF_IDLE = 0,   // 샘플 없음
+    PC_PROF_RUNNING,    // 샘플링 중
+    PC_PROF_DONE,       // 종료, 테이블 보존 (dump 가능)
+} pc_prof_state_t;
+
+// ==================== API ====================
+
+/**
+ * 샘플링 시작. 이전 결과는 버립니다.
+ * 범위를 벗어난 설정값은 허용 범위로 잘라냅니다.
+ *
+ * @return true: 시작, false: 타이머/PSRAM 확보 실패
+ */
+bool pc_profiler_start(const pc_prof_config_t *config);
+
+/**
+ * 샘플링 중지 (지정 시간이 지나면 자동으로 중지됨). 결과는 유지됩니다.
+ */
+void pc_profiler_stop(void);
+
+/**
+ * 현재 상태.
+ */
+pc_prof_state_t pc_profiler_get_state(void);
+
+/**
+ * 상태를 압축 JSON으로 작성.
+ *
+ * 형식: {"state":"done","hz":1000,"ms":5000,"depth":4,"samples":[n0,n1],"isr":[n0,n1],
+ *        "dropped":[n0,n1],"entries":[n0,n1],"load_ppm":[p0,p1]}
+ *
+ * @return 작성된 길이 (null 제외). 버퍼가 부족하면 0
+ */
+size_t pc_profiler_build_status_json(char *buf, size_t cap);
+
+/**
+ * 결과 전송 콜백 (청크 1개 = PROF_DATA 프레임 1개).
+ *
+ * @return false면 전송을 중단합니다
+ */
+typedef bool (*pc_prof_emit_fn)(const uint8_t *chunk, uint16_t len, void *ctx);
+
+/**
+ * 결과를 청크로 나눠 emit에 전달 (VCDC 태스크 전용). 샘플링 중이면 먼저 중지합니다.
+ *
+ * @param max_chunk 청크 최대 크기 (VCDC_MAX_PAYLOAD_SIZE)
+ * @return true: END 청크까지 전달, false: 결과 없음 또는 전송 중단
+ */
+bool pc_profiler_dump(uint16_t max_chunk, pc_prof_emit_fn emit, void *ctx);
+
+#endif // PC_PROFILER_H
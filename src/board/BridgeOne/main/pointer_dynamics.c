@@ -0,0 +1,198 @@
+/**
+ * @file pointer_dynamics.c
+ * @brief 포인터 다이나믹스(가속) 구현 - Q16 룩업 테이블 + 축별 서브픽셀 누산기
+ *
+ * 부동소수점 연산 없이 정수만 사용합니다 (ISR/핫패스 안전, FPU 컨텍스트 저장 불필요).
+ * 곡선 원본: Android DeltaCalculator.applyPointerDynamics()
+ */
+
+#include <string.h>
+#include "pointer_dynamics.h"
+#include "pointer_dynamics_table.h"
+
+// ==================== 프리셋 곡선 ====================
+
+/**
+ * 프리셋별 임계 속도와 배율 테이블.
+ * Off는 테이블이 없으며 항상 1.0입니다.
+ */
+typedef struct {
+    uint32_t        threshold_q16;  // 이 속도 미만은 배율 1.0 (dp/ms, Q16)
+    const uint32_t *lut;            // POINTER_DYNAMICS_LUT_SIZE 항목
+} pointer_dynamics_curve_t;
+
+static const pointer_dynamics_curve_t s_curves[POINTER_DYNAMICS_PRESET_COUNT] = {
+    [POINTER_DYNAMICS_OFF]       = { 0, NULL },
+    [POINTER_DYNAMICS_PRECISION] = { POINTER_DYNAMICS_THRESHOLD_Q16_PRECISION, POINTER_DYNAMICS_LUT_PRECISION },
+    [POINTER_DYNAMICS_STANDARD]  = { POINTER_DYNAMICS_THRESHOLD_Q16_STANDARD,  POINTER_DYNAMICS_LUT_STANDARD },
+    [POINTER_DYNAMICS_FAST]      = { POINTER_DYNAMICS_THRESHOLD_Q16_FAST,      POINTER_DYNAMICS_LUT_FAST },
+};
+
+// ==================== 내부 헬퍼 ====================
+
+/**
+ * 64비트 정수 제곱근 (내림).
+ */
+static uint64_t isqrt64(uint64_t n)
+{
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= result + bit) {
+            n -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+static void reset_motion(pointer_dynamics_t *pd)
+{
+    pd->accum_x_q16 = 0;
+    pd->accum_y_q16 = 0;
+    pd->sample_head = 0;
+    pd->sample_count = 0;
+    pd->sample_sum_q16 = 0;
+}
+
+static void drop_oldest_sample(pointer_dynamics_t *pd)
+{
+    pd->sample_sum_q16 -= pd->samples[pd->sample_head].dist_q16;
+    pd->sample_head = (uint8_t)((pd->sample_head + 1) % POINTER_DYNAMICS_MAX_SAMPLES);
+    pd->sample_count--;
+}
+
+/**
+ * 카운트 이동량 (dx, dy)의 거리를 dp 단위 Q16으로 환산.
+ */
+static uint32_t distance_dp_q16(const pointer_dynamics_t *pd, int32_t dx, int32_t dy)
+{
+    uint64_t sq = (uint64_t)((int64_t)dx * dx) + (uint64_t)((int64_t)dy * dy);
+    uint64_t dist_q8 = isqrt64(sq << 16);                 // 카운트, Q8
+    uint64_t dp_q16 = (dist_q8 << 16) / pd->counts_per_dp_q8;
+    return (dp_q16 > UINT32_MAX) ? UINT32_MAX : (uint32_t)dp_q16;
+}
+
+/**
+ * 누산기 정수부를 ±127 범위로 꺼내고 나머지는 누산기에 남김 (0 방향 절삭).
+ */
+static int32_t take_whole_counts(int64_t *accum_q16)
+{
+    int64_t whole = *accum_q16 / (int64_t)POINTER_DYNAMICS_Q16_ONE;
+
+    if (whole > POINTER_DYNAMICS_OUTPUT_MAX) {
+        whole = POINTER_DYNAMICS_OUTPUT_MAX;
+    } else if (whole < -POINTER_DYNAMICS_OUTPUT_MAX) {
+        whole = -POINTER_DYNAMICS_OUTPUT_MAX;
+    }
+    *accum_q16 -= whole * (int64_t)POINTER_DYNAMICS_Q16_ONE;
+    return (int32_t)whole;
+}
+
+// ==================== 공개 API ====================
+
+void pointer_dynamics_init(pointer_dynamics_t *pd)
+{
+    memset(pd, 0, sizeof(*pd));
+    pd->preset_id = POINTER_DYNAMICS_OFF;
+    pd->counts_per_dp_q8 = POINTER_DYNAMICS_DEFAULT_COUNTS_PER_DP_Q8;
+}
+
+bool pointer_dynamics_configure(pointer_dynamics_t *pd, uint8_t preset_id, uint16_t counts_per_dp_q8)
+{
+    if (preset_id >= POINTER_DYNAMICS_PRESET_COUNT || counts_per_dp_q8 == 0) {
+        return false;
+    }
+    if (pd->preset_id != preset_id || pd->counts_per_dp_q8 != counts_per_dp_q8) {
+        pd->preset_id = preset_id;
+        pd->counts_per_dp_q8 = counts_per_dp_q8;
+        reset_motion(pd);
+    }
+    return true;
+}
+
+uint32_t pointer_dynamics_multiplier_q16(uint8_t preset_id, uint32_t velocity_q16)
+{
+    if (preset_id >= POINTER_DYNAMICS_PRESET_COUNT) {
+        return POINTER_DYNAMICS_Q16_ONE;
+    }
+    const pointer_dynamics_curve_t *curve = &s_curves[preset_id];
+    if (curve->lut == NULL || velocity_q16 < curve->threshold_q16) {
+        return POINTER_DYNAMICS_Q16_ONE;
+    }
+
+    // 격자 위치 (Q16): 정수부 = 인덱스, 소수부 = 보간 비율
+    uint64_t pos_q16 = (uint64_t)velocity_q16 * POINTER_DYNAMICS_LUT_STEPS_PER_DP_MS;
+    uint32_t index = (uint32_t)(pos_q16 >> 16);
+    if (index >= POINTER_DYNAMICS_LUT_SIZE - 1) {
+        return curve->lut[POINTER_DYNAMICS_LUT_SIZE - 1];
+    }
+    uint32_t frac = (uint32_t)(pos_q16 & 0xFFFFu);
+    int64_t lo = curve->lut[index];
+    int64_t hi = curve->lut[index + 1];
+    return (uint32_t)(lo + (((hi - lo) * frac) >> 16));
+}
+
+uint32_t pointer_dynamics_velocity_q16(const pointer_dynamics_t *pd)
+{
+    if (pd->sample_count < 2) {
+        return 0;
+    }
+    uint8_t newest = (uint8_t)((pd->sample_head + pd->sample_count - 1) % POINTER_DYNAMICS_MAX_SAMPLES);
+    int64_t span_us = pd->samples[newest].time_us - pd->samples[pd->sample_head].time_us;
+    if (span_us <= 0) {
+        return 0;
+    }
+    // dp/ms = 거리 합(dp) / (span_us / 1000)
+    uint64_t v = (pd->sample_sum_q16 * 1000u) / (uint64_t)span_us;
+    return (v > UINT32_MAX) ? UINT32_MAX : (uint32_t)v;
+}
+
+void pointer_dynamics_apply(pointer_dynamics_t *pd, int32_t dx, int32_t dy, int64_t now_us,
+                            int32_t *out_x, int32_t *out_y)
+{
+    // 1. 속도 샘플 갱신 (입력 공백이 윈도우보다 길면 새 제스처로 간주)
+    if (pd->sample_count > 0) {
+        uint8_t newest = (uint8_t)((pd->sample_head + pd->sample_count - 1) % POINTER_DYNAMICS_MAX_SAMPLES);
+        if (now_us - pd->samples[newest].time_us > POINTER_DYNAMICS_WINDOW_US) {
+            reset_motion(pd);
+        }
+    }
+    while (pd->sample_count > 0 &&
+           pd->samples[pd->sample_head].time_us < now_us - POINTER_DYNAMICS_WINDOW_US) {
+        drop_oldest_sample(pd);
+    }
+    if (pd->sample_count == POINTER_DYNAMICS_MAX_SAMPLES) {
+        drop_oldest_sample(pd);
+    }
+
+    uint8_t slot = (uint8_t)((pd->sample_head + pd->sample_count) % POINTER_DYNAMICS_MAX_SAMPLES);
+    pd->samples[slot].time_us = now_us;
+    pd->samples[slot].dist_q16 = distance_dp_q16(pd, dx, dy);
+    pd->sample_sum_q16 += pd->samples[slot].dist_q16;
+    pd->sample_count++;
+
+    // 2. 배율 적용 → 누산
+    uint32_t multiplier = pointer_dynamics_multiplier_q16(pd->preset_id,
+                                                          pointer_dynamics_velocity_q16(pd));
+    pd->accum_x_q16 += (int64_t)dx * multiplier;
+    pd->accum_y_q16 += (int64_t)dy * multiplier;
+
+    // 3. 정수부 출력, 소수부/범위 초과분 이월
+    *out_x = take_whole_counts(&pd->accum_x_q16);
+    *out_y = take_whole_counts(&pd->accum_y_q16);
+}
+
+bool pointer_dynamics_drain(pointer_dynamics_t *pd, int32_t *out_x, int32_t *out_y)
+{
+    *out_x = take_whole_counts(&pd->accum_x_q16);
+    *out_y = take_whole_counts(&pd->accum_y_q16);
+    return (*out_x != 0 || *out_y != 0);
+}
@@ -0,0 +1,142 @@
+/**
+ * @file pointer_dynamics.h
+ * @brief 포인터 다이나믹스(가속) - Q16 고정소수점 룩업 테이블 기반
+ *
+ * 역할:
+ * - Android가 보낸 가속 전(raw) 마우스 델타에 프리셋별 속도-배율 곡선을 적용
+ * - 축별 Q16 서브픽셀 누산기로 소수부 이동량을 다음 리포트로 이월 (정수 절삭 손실 없음)
+ * - HID 범위(±127)를 넘는 이동량도 버리지 않고 이월하여 이후 리포트로 분할 전송
+ *
+ * 파이프라인 (hid_task):
+ *   frame_queue → 코얼레싱(연속 이동 프레임 합산) → pointer_dynamics_apply() → sendMouseReport()
+ *
+ * 속도 추정은 Android의 기존 방식(TouchpadWrapper 커서 속도 샘플)과 동일합니다:
+ *   최근 POINTER_DYNAMICS_WINDOW_US 내 샘플의 이동 거리 합 / (최신 - 최초 샘플 시각)
+ * 거리는 카운트(DPI 배율 적용 후 px)를 counts_per_dp로 나누어 dp 단위로 환산합니다.
+ *
+ * 프리셋 ID는 Android DYNAMICS_PRESETS 인덱스와 일치합니다 (ui/common/PointerDynamicsConstants.kt).
+ * 이 모듈은 ESP-IDF API에 의존하지 않으므로 호스트에서 단위 테스트합니다 (test/host/).
+ */
+
+#ifndef POINTER_DYNAMICS_H
+#define POINTER_DYNAMICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== 프리셋 ID ====================
+
+/**
+ * 다이나믹스 프리셋 ID (Android DYNAMICS_PRESETS 인덱스).
+ */
+typedef enum {
+    POINTER_DYNAMICS_OFF       = 0,  // 가속 없음 (배율 1.0)
+    POINTER_DYNAMICS_PRECISION = 1,  // Windows EPP S커브, 약함
+    POINTER_DYNAMICS_STANDARD  = 2,  // Windows EPP S커브, 표준
+    POINTER_DYNAMICS_FAST      = 3,  // 선형 가속
+    POINTER_DYNAMICS_PRESET_COUNT
+} pointer_dynamics_preset_t;
+
+// ==================== 상수 ====================
+
+/** Q16 고정소수점 1.0 */
+#define POINTER_DYNAMICS_Q16_ONE        65536u
+
+/** 속도 추정 윈도우 (Android INFINITE_SCROLL_VELOCITY_WINDOW_MS와 동일) */
+#define POINTER_DYNAMICS_WINDOW_US      100000
+
+/** 속도 추정 샘플 최대 수 (초과 시 가장 오래된 샘플부터 제거) */
+#define POINTER_DYNAMICS_MAX_SAMPLES    32
+
+/** HID Boot Mouse 리포트 한 축의 최대 이동량 */
+#define POINTER_DYNAMICS_OUTPUT_MAX     127
+
+/** counts_per_dp 기본값 (Q8.8): 1.0 count/dp */
+#define POINTER_DYNAMICS_DEFAULT_COUNTS_PER_DP_Q8  256u
+
+// ==================== 상태 ====================
+
+/**
+ * 속도 추정 샘플 (코얼레싱된 리포트 1회분).
+ */
+typedef struct {
+    int64_t  time_us;    // 수신 시각
+    uint32_t dist_q16;   // 이동 거리 (dp, Q16)
+} pointer_dynamics_sample_t;
+
+/**
+ * 포인터 다이나믹스 상태.
+ *
+ * 호출자가 소유하며 단일 태스크(hid_task)에서만 접근합니다.
+ */
+typedef struct {
+    uint8_t  preset_id;              // pointer_dynamics_preset_t
+    uint16_t counts_per_dp_q8;       // dp 1당 입력 카운트 (Q8.8, 화면 밀도 × DPI 배율)
+
+    int64_t  accum_x_q16;            // X축 서브픽셀 누산기 (Q16, 미전송 이동량)
+    int64_t  accum_y_q16;            // Y축 서브픽셀 누산기
+
+    pointer_dynamics_sample_t samples[POINTER_DYNAMICS_MAX_SAMPLES];
+    uint8_t  sample_head;            // 가장 오래된 샘플 인덱스
+    uint8_t  sample_count;
+    uint64_t sample_sum_q16;         // 윈도우 내 거리 합 (dp, Q16)
+} pointer_dynamics_t;
+
+// ==================== 함수 선언 ====================
+
+/**
+ * 상태 초기화 (프리셋 Off, counts_per_dp 1.0).
+ */
+void pointer_dynamics_init(pointer_dynamics_t *pd);
+
+/**
+ * 프리셋과 카운트 스케일 설정.
+ *
+ * 설정이 바뀌면 누산기와 속도 샘플을 초기화합니다.
+ *
+ * @param preset_id        프리셋 ID
+ * @param counts_per_dp_q8 dp 1당 입력 카운트 (Q8.8, 0 불가)
+ * @return true: 적용, false: 잘못된 인자 (기존 설정 유지)
+ */
+bool pointer_dynamics_configure(pointer_dynamics_t *pd, uint8_t preset_id, uint16_t counts_per_dp_q8);
+
+/**
+ * 속도에 해당하는 배율 조회 (Q16).
+ *
+ * 임계 속도 미만이면 1.0, 이상이면 테이블 선형 보간, 테이블 끝을 넘으면 마지막 값.
+ *
+ * @param preset_id    프리셋 ID (범위 밖이면 1.0)
+ * @param velocity_q16 속도 (dp/ms, Q16)
+ * @return 배율 (Q16)
+ */
+uint32_t pointer_dynamics_multiplier_q16(uint8_t preset_id, uint32_t velocity_q16);
+
+/**
+ * 이동량에 가속을 적용하고 이번 리포트로 보낼 정수 이동량을 반환.
+ *
+ * 1. (dx, dy) 거리를 속도 샘플에 추가 (윈도우 밖/공백 후 첫 샘플이면 상태 초기화)
+ * 2. 현재 속도의 배율을 조회하여 누산기에 dx × 배율, dy × 배율 가산
+ * 3. 누산기의 정수부(±127 제한)를 출력하고 나머지는 이월
+ *
+ * @param dx, dy  raw 이동량 (카운트, 코얼레싱 합계)
+ * @param now_us  현재 시각 (µs, 단조 증가)
+ * @param out_x, out_y 이번 리포트 이동량 (-127 ~ 127)
+ */
+void pointer_dynamics_apply(pointer_dynamics_t *pd, int32_t dx, int32_t dy, int64_t now_us,
+                            int32_t *out_x, int32_t *out_y);
+
+/**
+ * 이월된 정수 이동량 배출 (새 입력 없이 누산기만 비움).
+ *
+ * ±127 제한으로 남은 이동량을 입력이 없는 주기에 이어서 전송할 때 사용합니다.
+ *
+ * @return true: 보낼 이동량이 있음
+ */
+bool pointer_dynamics_drain(pointer_dynamics_t *pd, int32_t *out_x, int32_t *out_y);
+
+/**
+ * 현재 윈도우 기준 속도 (dp/ms, Q16). 샘플이 2개 미만이면 0.
+ */
+uint32_t pointer_dynamics_velocity_q16(const pointer_dynamics_t *pd);
+
+#endif // POINTER_DYNAMICS_H
@@ -0,0 +1,91 @@
+/**
+ * @file pointer_dynamics_table.h
+ * @brief 포인터 다이나믹스 Q16 룩업 테이블 (pointer_dynamics.c 전용)
+ *
+ * Android DeltaCalculator.applyPointerDynamics()의 곡선을 속도 격자에서 샘플링한 값입니다.
+ * - 인덱스 i ↔ 속도 i × POINTER_DYNAMICS_LUT_STEP_DP_MS (dp/ms), 0 ~ 6.4 dp/ms
+ * - 값 = round(배율 × 65536), 배율은 [1.0, maxMultiplier]로 제한된 값
+ * - 임계 속도 미만 구간은 1.0 (실행 시 임계값으로 먼저 분기하므로 보간에 쓰이지 않음)
+ *
+ * 프리셋 파라미터(ui/common/PointerDynamicsConstants.kt)를 바꾸면 이 테이블도 다시 생성해야 하며,
+ * Android 단위 테스트(PointerDynamicsTableTest)가 두 곡선의 불일치를 검출합니다.
+ */
+
+#ifndef POINTER_DYNAMICS_TABLE_H
+#define POINTER_DYNAMICS_TABLE_H
+
+#include <stdint.h>
+
+/** 테이블 항목 수 (0 ~ 6.4 dp/ms, 0.05 dp/ms 간격) */
+#define POINTER_DYNAMICS_LUT_SIZE       129
+
+/** 속도 격자 간격의 역수: index = velocity(dp/ms) × 20 */
+#define POINTER_DYNAMICS_LUT_STEPS_PER_DP_MS  20
+
+// ── Precision: WINDOWS_EPP, intensity=0.8, threshold=0.6 dp/ms, max=2.5x ──
+#define POINTER_DYNAMICS_THRESHOLD_Q16_PRECISION  39322u
+static const uint32_t POINTER_DYNAMICS_LUT_PRECISION[POINTER_DYNAMICS_LUT_SIZE] = {
+     65536u,  65536u,  65536u,  65536u,  65536u,  65536u,  65536u,  65536u,
+     65536u,  65536u,  65536u,  65536u,  91750u,  93930u,  96079u,  98171u,
+    100179u, 102082u, 103865u, 105515u, 107028u, 108400u, 109635u, 110738u,
+    111715u, 112576u, 113330u, 113988u, 114559u, 115052u, 115478u, 115845u,
+    116159u, 116428u, 116658u, 116854u, 117022u, 117164u, 117286u, 117389u,
+    117476u, 117551u, 117614u, 117667u, 117713u, 117751u, 117784u, 117812u,
+    117835u, 117855u, 117872u, 117886u, 117898u, 117908u, 117917u, 117924u,
+    117931u, 117936u, 117940u, 117944u, 117947u, 117950u, 117952u, 117954u,
+    117956u, 117957u, 117958u, 117959u, 117960u, 117961u, 117961u, 117962u,
+    117962u, 117963u, 117963u, 117963u, 117964u, 117964u, 117964u, 117964u,
+    117964u, 117964u, 117964u, 117964u, 117964u, 117965u, 117965u, 117965u,
+    117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u,
+    117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u,
+    117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u,
+    117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u,
+    117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u, 117965u,
+    117965u,
+};
+
+// ── Standard: WINDOWS_EPP, intensity=1.2, threshold=0.5 dp/ms, max=3.0x ──
+#define POINTER_DYNAMICS_THRESHOLD_Q16_STANDARD  32768u
+static const uint32_t POINTER_DYNAMICS_LUT_STANDARD[POINTER_DYNAMICS_LUT_SIZE] = {
+     65536u,  65536u,  65536u,  65536u,  65536u,  65536u,  65536u,  65536u,
+     65536u,  65536u, 104858u, 108777u, 112619u, 116312u, 119798u, 123029u,
+    125975u, 128622u, 130969u, 133024u, 134805u, 136335u, 137638u, 138742u,
+    139671u, 140449u, 141099u, 141639u, 142088u, 142458u, 142765u, 143017u,
+    143225u, 143397u, 143537u, 143653u, 143748u, 143826u, 143889u, 143942u,
+    143985u, 144020u, 144049u, 144072u, 144092u, 144108u, 144121u, 144131u,
+    144140u, 144147u, 144153u, 144158u, 144162u, 144165u, 144167u, 144169u,
+    144171u, 144173u, 144174u, 144175u, 144176u, 144176u, 144177u, 144177u,
+    144178u, 144178u, 144178u, 144178u, 144178u, 144179u, 144179u, 144179u,
+    144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u,
+    144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u,
+    144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u,
+    144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u,
+    144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u,
+    144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u,
+    144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u, 144179u,
+    144179u,
+};
+
+// ── Fast: LINEAR, intensity=1.5, threshold=0.4 dp/ms, max=4.0x ──
+#define POINTER_DYNAMICS_THRESHOLD_Q16_FAST  26214u
+static const uint32_t POINTER_DYNAMICS_LUT_FAST[POINTER_DYNAMICS_LUT_SIZE] = {
+     65536u,  65536u,  65536u,  65536u,  65536u,  65536u,  65536u,  65536u,
+     65536u,  77824u,  90112u, 102400u, 114688u, 126976u, 139264u, 151552u,
+    163840u, 176128u, 188416u, 200704u, 212992u, 225280u, 237568u, 249856u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u, 262144u,
+    262144u,
+};
+
+#endif // POINTER_DYNAMICS_TABLE_H
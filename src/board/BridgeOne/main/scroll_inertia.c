@@ -0,0 +1,156 @@
+/**
+ * @file scroll_inertia.c
+ * @brief 관성 스크롤 생성기 구현
+ *
+ * Android가 관성 구간 동안 8ms마다 휠 프레임을 보내던 방식을 대체합니다.
+ * UART로는 시작/정지 프레임만 오가고, 감쇠 곡선은 1ms 주기 esp_timer가 생성합니다.
+ *
+ * 참조:
+ * - scroll_inertia.h - 속도 모델/단위
+ * - uart_handler.c - UART_QUERY_SCROLL_FLING 트리거
+ * - hid_handler.c - sendMouseReportHiRes() (Resolution Multiplier 변환)
+ */
+
+#include "scroll_inertia.h"
+#include "hid_handler.h"
+#include "usb_descriptors.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "tusb.h"
+#include <math.h>
+#include <stdlib.h>
+
+static const char *TAG = "SCROLL_INERTIA";
+
+// ==================== 생성기 상태 ====================
+
+static esp_timer_handle_t s_tick_timer = NULL;
+
+/** 아래 상태 보호 (UART 태스크 ↔ esp_timer 태스크) */
+static portMUX_TYPE s_inertia_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool     s_active = false;
+static bool     s_horizontal = false;
+static int64_t  s_velocity_q16 = 0;   // 현재 속도 (단위/ms, Q16)
+static uint32_t s_decay_q16 = 0;      // 틱당 감쇠 계수 exp(-tick / tau) (Q16)
+static int64_t  s_stop_q16 = 0;       // 정지 속도 (단위/ms, Q16)
+static int64_t  s_accum_q16 = 0;      // 미전송 누적 이동량 (단위, Q16)
+
+// ==================== 내부 헬퍼 ====================
+
+/**
+ * 틱 타이머 콜백 (esp_timer 태스크 컨텍스트).
+ *
+ * 1. 이번 틱 이동량(속도 × 1ms)을 누산하고 속도 감쇠
+ * 2. 정지 속도 미만이면 종료 (남은 정수 단위는 마지막으로 전송)
+ * 3. 엔드포인트가 비어 있으면 누산기의 정수부 전송
+ */
+static void scroll_inertia_tick_cb(void *arg)
+{
+    (void)arg;
+
+    bool horizontal;
+    bool finished = false;
+    int32_t units = 0;
+
+    taskENTER_CRITICAL(&s_inertia_lock);
+    if (!s_active) {
+        taskEXIT_CRITICAL(&s_inertia_lock);
+        return;
+    }
+    horizontal = s_horizontal;
+    s_accum_q16 += s_velocity_q16 * SCROLL_INERTIA_TICK_US / 1000;
+    s_velocity_q16 = (s_velocity_q16 * s_decay_q16) / 65536;
+    if (llabs(s_velocity_q16) < s_stop_q16 || s_velocity_q16 == 0) {
+        s_active = false;
+        finished = true;
+    }
+    if (finished || hid_mouse_ready_for_report()) {
+        units = (int32_t)(s_accum_q16 / 65536);
+        s_accum_q16 -= (int64_t)units * 65536;
+    }
+    taskEXIT_CRITICAL(&s_inertia_lock);
+
+    if (finished) {
+        esp_timer_stop(s_tick_timer);
+        // 정지 직전에 새 fling이 시작되었으면 타이머를 다시 무장
+        if (s_active) {
+            esp_timer_start_periodic(s_tick_timer, SCROLL_INERTIA_TICK_US);
+        }
+        ESP_LOGD(TAG, "Fling finished");
+    }
+
+    if (units != 0) {
+        sendMouseReportHiRes(hid_get_mouse_buttons(), 0, 0,
+                             horizontal ? 0 : units,
+                             horizontal ? units : 0);
+    }
+}
+
+// ==================== 공개 API ====================
+
+bool scroll_inertia_init(void)
+{
+    const esp_timer_create_args_t timer_args = {
+        .callback = scroll_inertia_tick_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "scroll_inertia"
+    };
+
+    if (esp_timer_create(&timer_args, &s_tick_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create scroll inertia timer");
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Scroll inertia initialized (tick=%dus, units/detent=%d)",
+             SCROLL_INERTIA_TICK_US, HID_WHEEL_UNITS_PER_DETENT);
+    return true;
+}
+
+void scroll_inertia_start(bool horizontal, int16_t velocity_q8, uint16_t tau_ms, uint8_t stop_q4)
+{
+    if (s_tick_timer == NULL || velocity_q8 == 0 || tau_ms == 0) {
+        return;
+    }
+
+    // 틱당 감쇠 계수: 시작 시 한 번만 부동소수점 계산
+    float decay = expf(-(SCROLL_INERTIA_TICK_US / 1000.0f) / (float)tau_ms);
+
+    taskENTER_CRITICAL(&s_inertia_lock);
+    s_horizontal = horizontal;
+    s_velocity_q16 = (int64_t)velocity_q8 * 256;
+    s_decay_q16 = (uint32_t)(decay * 65536.0f);
+    s_stop_q16 = (int64_t)stop_q4 * 4096;
+    s_accum_q16 = 0;
+    bool was_active = s_active;
+    s_active = true;
+    taskEXIT_CRITICAL(&s_inertia_lock);
+
+    if (!was_active) {
+        esp_timer_start_periodic(s_tick_timer, SCROLL_INERTIA_TICK_US);
+    }
+
+    ESP_LOGD(TAG, "Fling start: axis=%s, v=%d/256 units/ms, tau=%ums, stop=%u/16",
+             horizontal ? "pan" : "wheel", velocity_q8, tau_ms, stop_q4);
+}
+
+void scroll_inertia_stop(void)
+{
+    taskENTER_CRITICAL(&s_inertia_lock);
+    bool was_active = s_active;
+    s_active = false;
+    s_velocity_q16 = 0;
+    s_accum_q16 = 0;
+    taskEXIT_CRITICAL(&s_inertia_lock);
+
+    if (was_active && s_tick_timer != NULL) {
+        esp_timer_stop(s_tick_timer);
+    }
+}
+
+bool scroll_inertia_is_active(void)
+{
+    return s_active;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file scroll_inertia.h
+ * @brief 관성 스크롤 생성기 - 1ms 주기 지수 감쇠 휠 리포트
+ *
+ * 역할:
+ * - Android가 손가락을 뗄 때 보낸 초기 속도 1프레임(UART_QUERY_SCROLL_FLING)으로 관성 스크롤 시작
+ * - esp_timer 1ms 주기로 속도를 지수 감쇠시키며 고해상도 휠 단위를 누산
+ * - 정수 단위가 쌓이고 마우스 리포트를 바로 제출할 수 있을 때만 sendMouseReportHiRes()로 전송
+ *   (hid_mouse_ready_for_report()가 false면 다음 틱에 합쳐서 전송 → 리포트 큐/메일박스를 채우지 않음)
+ *
+ * 속도 모델 (Android 무한 스크롤 관성과 동일):
+ *   v(t) = v0 × exp(-t / tau),  v < stop 이면 종료
+ * 틱당 감쇠 계수 exp(-1ms / tau)는 시작 시 한 번만 계산하고, 이후에는 Q16 정수 연산만 합니다.
+ *
+ * 단위: 1/HID_WHEEL_UNITS_PER_DETENT 디텐트 (usb_descriptors.h)
+ */
+
+#ifndef SCROLL_INERTIA_H
+#define SCROLL_INERTIA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** 생성기 틱 주기 (µs) - HID 마우스 bInterval(1ms)과 동일 */
+#define SCROLL_INERTIA_TICK_US  1000
+
+/**
+ * 관성 스크롤 초기화 (주기 타이머 생성).
+ *
+ * @return true: 성공, false: 타이머 생성 실패
+ */
+bool scroll_inertia_init(void);
+
+/**
+ * 관성 스크롤 시작 (진행 중이면 새 속도로 교체).
+ *
+ * @param horizontal  true: 수평 휠(AC Pan), false: 수직 휠
+ * @param velocity_q8 초기 속도 (단위/ms, Q8.8 signed, 0이면 무시)
+ * @param tau_ms      감쇠 시간 상수 (ms, 0이면 무시)
+ * @param stop_q4     정지 속도 (단위/ms, Q4.4)
+ */
+void scroll_inertia_start(bool horizontal, int16_t velocity_q8, uint16_t tau_ms, uint8_t stop_q4);
+
+/**
+ * 관성 스크롤 즉시 정지 (미전송 소수 단위는 버림).
+ */
+void scroll_inertia_stop(void);
+
+/**
+ * 관성 스크롤 진행 중 여부.
+ */
+bool scroll_inertia_is_active(void);
+
+#endif // SCROLL_INERTIA_H
@@ -0,0 +1,274 @@
+/**
+ * @file task_profiler.c
+ * @brief 태스크별 CPU 사용률/스케줄링 프로파일러 구현
+ *
+ * 참조: task_profiler.h
+ */
+
+#include "task_profiler.h"
+#include "mem_alloc.h"
+#include "vcdc_chunk.h"
+#include "esp_timer.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// ==================== 프로브 상태 ====================
+
+/**
+ * 프로브 1개.
+ * pending_us만 여러 생산자가 쓰고, 나머지 카운터는 소비 태스크만 씁니다.
+ * 누적 카운터(uint32, 랩어라운드 허용)를 보고 쪽이 직전 값과 빼서 구간 값을 얻습니다.
+ */
+typedef struct {
+    TaskHandle_t handle;
+    atomic_uint  pending_us;    // signal 시각 | 1 (0 = 대기 중인 signal 없음)
+    uint32_t     wakes;         // 누적 깨어남 횟수
+    uint32_t     lat_count;     // 누적 지연 측정 횟수
+    uint32_t     lat_sum_us;    // 누적 지연 합
+    uint32_t     lat_max_us;    // 직전 보고 이후 최대 지연
+    atomic_bool  reset_max;     // 보고 쪽 요청 → 소비 태스크가 다음 wake에서 lat_max_us 초기화
+} probe_state_t;
+
+static probe_state_t s_probes[TASK_PROBE_COUNT];
+
+/** 보고 쪽(VCDC 태스크)이 기억하는 직전 누적값 */
+typedef struct {
+    uint32_t wakes;
+    uint32_t lat_count;
+    uint32_t lat_sum_us;
+} probe_prev_t;
+
+static probe_prev_t s_probe_prev[TASK_PROBE_COUNT];
+
+// ==================== 런타임 통계 직전값 ====================
+
+typedef struct {
+    TaskHandle_t handle;
+    uint32_t     run;           // ulRunTimeCounter (us, 32비트 랩어라운드 허용)
+} run_prev_t;
+
+static run_prev_t s_run_prev[TASK_PROFILER_MAX_TASKS];
+static uint8_t    s_run_prev_count = 0;
+static uint32_t   s_total_prev     = 0;
+
+/** 보고 행 (태스크 1개) */
+typedef struct {
+    const char *name;
+    uint8_t     prio;
+    int8_t      affinity;       // 고정 코어, 미고정 -1 (실행 코어 아님)
+    int8_t      probe;          // 프로브 번호, 없으면 -1
+    uint16_t    cpu;            // 한 코어 기준 ‰
+    uint32_t    hwm;            // 남은 최소 스택 (bytes)
+} top_row_t;
+
+// ==================== 프로브 API ====================
+
+void task_profiler_register(task_probe_t probe, TaskHandle_t handle)
+{
+    if (probe < TASK_PROBE_COUNT) {
+        s_probes[probe].handle = handle;
+    }
+}
+
+void task_probe_signal(task_probe_t probe)
+{
+    unsigned stamp = (uint32_t)esp_timer_get_time() | 1u;
+    unsigned expected = 0;
+    atomic_compare_exchange_strong(&s_probes[probe].pending_us, &expected, stamp);
+}
+
+void task_probe_wake(task_probe_t probe)
+{
+    probe_state_t *p = &s_probes[probe];
+
+    if (atomic_exchange(&p->reset_max, false)) {
+        p->lat_max_us = 0;
+    }
+    p->wakes++;
+
+    unsigned stamp = atomic_exchange(&p->pending_us, 0);
+    if (stamp == 0) {
+        return;
+    }
+    // 양쪽 모두 최하위 비트를 세웠으므로 차이는 음수가 되지 않음
+    uint32_t lat = ((uint32_t)esp_timer_get_time() | 1u) - stamp;
+    p->lat_count++;
+    p->lat_sum_us += lat;
+    if (lat > p->lat_max_us) {
+        p->lat_max_us = lat;
+    }
+}
+
+// ==================== 보고 ====================
+
+static int8_t probe_of(TaskHandle_t handle)
+{
+    for (int i = 0; i < TASK_PROBE_COUNT; i++) {
+        if (s_probes[i].handle != NULL && s_probes[i].handle == handle) {
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+static bool is_idle_task(TaskHandle_t handle)
+{
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (xTaskGetIdleTaskHandleForCore(core) == handle) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * 직전 조회 이후 태스크가 사용한 런타임 (us).
+ * 직전 표에 없으면 그 사이 생성된 태스크로 보고 누적값 전체를 사용합니다.
+ */
+static uint32_t run_delta(TaskHandle_t handle, uint32_t run)
+{
+    for (uint8_t i = 0; i < s_run_prev_count; i++) {
+        if (s_run_prev[i].handle == handle) {
+            return run - s_run_prev[i].run;
+        }
+    }
+    return run;
+}
+
+static uint16_t permille(uint32_t part, uint32_t whole)
+{
+    if (whole == 0) {
+        return 0;
+    }
+    uint64_t v = (uint64_t)part * 1000u / whole;
+    return (uint16_t)((v > 1000u) ? 1000u : v);
+}
+
+/**
+ * 행 1개 추가. 프로브 태스크는 구간 깨어남/지연을 덧붙이고 직전값을 갱신합니다.
+ */
+static void append_row(char *buf, size_t cap, size_t *pos, const top_row_t *row, bool first)
+{
+    vcdc_json_append(buf, cap, pos, "%s[\"%s\",%u,%d,%u,%u", first ? "" : ",", row->name,
+                     (unsigned)row->prio, (int)row->affinity, (unsigned)row->cpu, (unsigned)row->hwm);
+
+    if (row->probe >= 0) {
+        probe_state_t *p    = &s_probes[row->probe];
+        probe_prev_t  *prev = &s_probe_prev[row->probe];
+
+        uint32_t wakes     = p->wakes;
+        uint32_t lat_count = p->lat_count;
+        uint32_t lat_sum   = p->lat_sum_us;
+        uint32_t lat_max   = p->lat_max_us;
+        atomic_store(&p->reset_max, true);
+
+        uint32_t d_count = lat_count - prev->lat_count;
+        uint32_t lat_avg = (d_count > 0) ? (lat_sum - prev->lat_sum_us) / d_count : 0;
+        vcdc_json_append(buf, cap, pos, ",%u,%u,%u", (unsigned)(wakes - prev->wakes),
+                         (unsigned)lat_avg, (unsigned)lat_max);
+
+        prev->wakes      = wakes;
+        prev->lat_count  = lat_count;
+        prev->lat_sum_us = lat_sum;
+    }
+    vcdc_json_append(buf, cap, pos, "]");
+}
+
+size_t task_profiler_build_json(char *buf, size_t cap)
+{
+    // 조회 사이에 태스크가 생길 수 있으므로 약간 여유를 둠
+    UBaseType_t capacity = uxTaskGetNumberOfTasks() + 2;
+    TaskStatus_t *status = mem_arena_alloc(capacity * sizeof(TaskStatus_t));
+    top_row_t    *rows   = mem_arena_alloc(capacity * sizeof(top_row_t));
+    if (status == NULL || rows == NULL) {
+        mem_arena_free(rows);
+        mem_arena_free(status);
+        return 0;
+    }
+
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t count = uxTaskGetSystemState(status, capacity, &total);
+    if (count == 0) {
+        mem_arena_free(rows);
+        mem_arena_free(status);
+        return 0;
+    }
+
+    uint32_t dt = (uint32_t)total - s_total_prev;
+    uint16_t idle[portNUM_PROCESSORS] = {0};
+    uint8_t  row_count = 0;
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t *ts = &status[i];
+        uint16_t cpu = permille(run_delta(ts->xHandle, (uint32_t)ts->ulRunTimeCounter), dt);
+
+        if (is_idle_task(ts->xHandle)) {
+            BaseType_t core = xTaskGetCoreID(ts->xHandle);
+            if (core >= 0 && core < portNUM_PROCESSORS) {
+                idle[core] = cpu;
+            }
+            continue;
+        }
+
+        BaseType_t core = xTaskGetCoreID(ts->xHandle);
+        top_row_t *row = &rows[row_count++];
+        row->name  = ts->pcTaskName;
+        row->prio  = (uint8_t)ts->uxCurrentPriority;
+        row->affinity = (core >= 0 && core < portNUM_PROCESSORS) ? (int8_t)core : -1;
+        row->probe = probe_of(ts->xHandle);
+        row->cpu   = cpu;
+        row->hwm   = (uint32_t)ts->usStackHighWaterMark * sizeof(StackType_t);
+    }
+
+    // 프로브 태스크 우선, 그 다음 CPU 사용률 내림차순 (삽입 정렬, 태스크 수십 개 이하)
+    for (uint8_t i = 1; i < row_count; i++) {
+        top_row_t key = rows[i];
+        int j = i - 1;
+        while (j >= 0 &&
+               ((rows[j].probe < 0 && key.probe >= 0) ||
+                ((rows[j].probe < 0) == (key.probe < 0) && rows[j].cpu < key.cpu))) {
+            rows[j + 1] = rows[j];
+            j--;
+        }
+        rows[j + 1] = key;
+    }
+
+    size_t pos = 0;
+    vcdc_json_append(buf, cap, &pos, "{\"dt\":%u,\"load\":[", (unsigned)dt);
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        vcdc_json_append(buf, cap, &pos, "%s%u", (core > 0) ? "," : "", 1000u - idle[core]);
+    }
+    vcdc_json_append(buf, cap, &pos, "],\"tasks\":[");
+
+    // 닫는 "]}" 자리를 남겨 두고, 들어가지 않는 비프로브 태스크부터 잘라냄
+    size_t body_cap = (cap > 2) ? cap - 2 : 0;
+    for (uint8_t i = 0; i < row_count; i++) {
+        size_t saved = pos;
+        append_row(buf, body_cap, &pos, &rows[i], i == 0);
+        if (pos >= body_cap) {
+            pos = saved;
+            if (rows[i].probe < 0) {
+                break;
+            }
+            // 프로브 태스크조차 안 들어가면 보고 불가
+            mem_arena_free(rows);
+            mem_arena_free(status);
+            return 0;
+        }
+    }
+    vcdc_json_append(buf, cap, &pos, "]}");
+
+    // 다음 구간의 기준값 저장
+    s_total_prev = (uint32_t)total;
+    s_run_prev_count = 0;
+    for (UBaseType_t i = 0; i < count && s_run_prev_count < TASK_PROFILER_MAX_TASKS; i++) {
+        s_run_prev[s_run_prev_count].handle = status[i].xHandle;
+        s_run_prev[s_run_prev_count].run    = (uint32_t)status[i].ulRunTimeCounter;
+        s_run_prev_count++;
+    }
+
+    mem_arena_free(rows);
+    mem_arena_free(status);
+    return (pos < cap) ? pos : 0;
+}
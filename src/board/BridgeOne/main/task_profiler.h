@@ -0,0 +1,87 @@
+/**
+ * @file task_profiler.h
+ * @brief 태스크별 CPU 사용률/스케줄링 프로파일러 ("top")
+ *
+ * 역할:
+ * - FreeRTOS 런타임 통계(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS, esp_timer 1us 클럭)로
+ *   조회 간격 동안의 태스크별 CPU 사용률과 코어별 부하(100% - IDLE)를 계산
+ * - 태스크 우선순위, 코어 고정(affinity), 스택 최고 수위
+ * - 프로브를 등록한 태스크(UART/HID/USB/VCDC)의 깨어남 횟수와 ready-to-run 지연
+ *
+ * 프로브 (생산자 → 소비 태스크):
+ * - 생산자는 작업을 넘기기 직전 task_probe_signal()로 시각을 남기고,
+ *   소비 태스크는 블로킹 호출에서 돌아온 직후 task_probe_wake()를 호출합니다.
+ * - 두 시각의 차이가 "작업이 준비된 뒤 태스크가 실제로 실행되기까지"의 지연입니다.
+ *   대기 중인 signal이 없으면(타임아웃 등) 깨어남만 세고 지연은 기록하지 않습니다.
+ * - 깨어남 횟수는 블로킹 대기 후 다시 스케줄된 횟수(자발적 컨텍스트 스위치)입니다.
+ *   ESP-IDF FreeRTOS는 커널 수정 없이 태스크별 스위치 횟수를 제공하지 않으므로 이것으로 대신하며,
+ *   선점당한 횟수는 포함되지 않습니다.
+ *
+ * 코어 표시(affinity): xTaskGetCoreID() 기준 고정 코어이며, 고정되지 않은 태스크는 -1입니다.
+ * 구간 동안 실제로 어느 코어에서 실행됐는지(residency)가 아닙니다. 미고정 태스크는 두 코어를
+ * 오갈 수 있고, 태스크별 코어 실행 시간은 런타임 통계가 구분하지 않으므로 보고하지 않습니다
+ * (필요하면 이벤트 트레이스의 태스크 스위치 기록으로 확인, trace_recorder.h).
+ *
+ * 조회 경로: Vendor CDC VCDC_CMD_TOP_QUERY → VCDC_CMD_TOP_REPORT (압축 JSON).
+ * CPU/깨어남/지연은 직전 조회 이후 구간 값이므로 조회하는 쪽이 주기를 정합니다 (Windows: 1초).
+ */
+
+#ifndef TASK_PROFILER_H
+#define TASK_PROFILER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// ==================== 상수 ====================
+
+/** 한 번에 수집하는 최대 태스크 수 (초과분은 보고에서 제외) */
+#define TASK_PROFILER_MAX_TASKS     20
+
+// ==================== 프로브 ====================
+
+/** 프로브를 두는 태스크 */
+typedef enum {
+    TASK_PROBE_UART = 0,    // uart_task: UART 수신 대기에서 깨어남 (지연 측정 없음)
+    TASK_PROBE_HID,         // hid_task: frame_queue 게시 → 수신
+    TASK_PROBE_USB,         // usb_task: 메일박스 제출 예약(usbd_defer_func) → 실행
+    TASK_PROBE_VCDC,        // vendor_cdc_task: 프레임 큐 게시 → 수신
+    TASK_PROBE_COUNT
+} task_probe_t;
+
+/**
+ * 프로브 태스크 등록 (app_main()에서 태스크 생성 직후 호출).
+ */
+void task_profiler_register(task_probe_t probe, TaskHandle_t handle);
+
+/**
+ * 작업 전달 시각 기록 (생산자 측, 여러 태스크/코어에서 호출 가능).
+ * 이미 대기 중인 signal이 있으면 먼저 기록된 시각을 유지합니다.
+ */
+void task_probe_signal(task_probe_t probe);
+
+/**
+ * 깨어남 기록 (소비 태스크 자신만 호출).
+ */
+void task_probe_wake(task_probe_t probe);
+
+// ==================== 보고 ====================
+
+/**
+ * 직전 호출 이후 구간의 프로파일을 압축 JSON으로 작성 (VCDC 태스크 전용).
+ *
+ * 형식: {"dt":us,"load":[c0,c1],"tasks":[[name,prio,affinity,cpu,hwm(,wake,lat_avg,lat_max)],...]}
+ * - load, cpu: 한 코어 기준 천분율 (‰)
+ * - affinity: 고정 코어 (미고정 -1, 실행 코어 아님)
+ * - hwm: 남은 최소 스택 (bytes)
+ * - wake/lat_*: 프로브 태스크만 (lat은 us)
+ * 프로브 태스크가 먼저 오고, 나머지는 CPU 사용률 순으로 버퍼가 허용하는 만큼 붙입니다.
+ *
+ * @param buf 출력 버퍼 (VCDC_MAX_PAYLOAD_SIZE 이하 권장)
+ * @param cap 버퍼 크기
+ * @return 작성된 길이 (null 제외). 수집 실패 시 0
+ */
+size_t task_profiler_build_json(char *buf, size_t cap);
+
+#endif // TASK_PROFILER_H
@@ -0,0 +1,42 @@
+/**
+ * @file trace_hooks.h
+ * @brief FreeRTOS 트레이스 매크로 → trace_recorder 연결
+ *
+ * CONFIG_BRIDGEONE_EVENT_TRACE=y일 때 FreeRTOS 컴포넌트에만 강제 포함됩니다
+ * (최상위 CMakeLists.txt, -include). FreeRTOS.h의 기본 정의(#ifndef)보다 먼저 와야 하므로
+ * 다른 헤더를 포함하지 않습니다. 매크로는 tasks.c/queue.c 안에서 전개되므로
+ * Queue_t 필드(uxMessagesWaiting)를 직접 읽을 수 있습니다.
+ *
+ * 훅은 커널 크리티컬 섹션과 IRAM ISR(캐시 비활성 구간 포함)에서도 호출되므로
+ * 구현(trace_recorder.c)은 IRAM에 있고, 훅이 건드리는 상태와 링 버퍼는 모두 내부 DRAM에 있습니다
+ * (PSRAM은 캐시 비활성 중 접근 불가).
+ */
+
+#ifndef TRACE_HOOKS_H
+#define TRACE_HOOKS_H
+
+#ifndef __ASSEMBLER__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void trace_hook_task_switched_in(void);
+void trace_hook_task_switched_out(void);
+void trace_hook_queue_send(const void *queue, unsigned waiting);
+void trace_hook_queue_receive(const void *queue, unsigned waiting);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define traceTASK_SWITCHED_IN()                 trace_hook_task_switched_in()
+#define traceTASK_SWITCHED_OUT()                trace_hook_task_switched_out()
+#define traceQUEUE_SEND(pxQueue)                trace_hook_queue_send((pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)       trace_hook_queue_send((pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE(pxQueue)             trace_hook_queue_receive((pxQueue), (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)    trace_hook_queue_receive((pxQueue), (pxQueue)->uxMessagesWaiting)
+
+#endif // __ASSEMBLER__
+
+#endif // TRACE_HOOKS_H
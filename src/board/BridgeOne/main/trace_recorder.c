@@ -0,0 +1,251 @@
+/**
+ * @file trace_recorder.c
+ * @brief 커널/입력 파이프라인 이벤트 트레이스 레코더 구현
+ *
+ * 참조: trace_recorder.h, trace_hooks.h
+ */
+
+#include "trace_hooks.h"      // 훅 원형 (FreeRTOS 헤더보다 먼저 와야 매크로 재정의 경고가 없음)
+#include "trace_recorder.h"
+#include "mem_alloc.h"
+#include "vcdc_chunk.h"
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "TRACE";
+
+/** 커널 훅 포함 여부 (최상위 CMakeLists.txt가 FreeRTOS에 trace_hooks.h를 강제 포함) */
+#if CONFIG_BRIDGEONE_EVENT_TRACE
+#define TRACE_KERNEL_HOOKS      1
+#else
+#define TRACE_KERNEL_HOOKS      0
+#endif
+
+// ==================== 상태 ====================
+
+/**
+ * 링 버퍼 (내부 DRAM, 처음 start 때 확보 후 유지).
+ * 커널 훅이 플래시 작업 중(캐시 비활성) ISR에서도 쓰므로 PSRAM에 두면 안 됨.
+ */
+static trace_event_t *s_ring = NULL;
+
+/** 지금까지 기록을 시도한 이벤트 수 (다음 쓰기 위치 = s_head % TRACE_RING_EVENTS) */
+static atomic_uint s_head = 0;
+
+/** 기록 중 여부 (훅에서 가장 먼저 확인, DRAM) */
+static volatile bool s_recording = false;
+
+/** 큐 이벤트를 기록할 큐 (훅이 링에 쓰기 전에 거르는 용도, DRAM) */
+static const void *s_queue_handles[TRACE_MAX_QUEUES];
+static const char *s_queue_names[TRACE_MAX_QUEUES];
+static uint8_t     s_queue_count = 0;
+
+// ==================== 기록 ====================
+
+static inline void IRAM_ATTR record(uint8_t type, uint8_t core, uint16_t aux, uint32_t arg)
+{
+    if (!s_recording) {
+        return;
+    }
+    unsigned idx = atomic_fetch_add_explicit(&s_head, 1, memory_order_relaxed);
+    trace_event_t *ev = &s_ring[idx & (TRACE_RING_EVENTS - 1)];
+    ev->ts_us = (uint32_t)esp_timer_get_time();
+    ev->type  = type;
+    ev->core  = core;
+    ev->aux   = aux;
+    ev->arg   = arg;
+}
+
+void IRAM_ATTR trace_recorder_event(trace_event_type_t type, uint16_t aux, uint32_t arg)
+{
+    record((uint8_t)type, (uint8_t)esp_cpu_get_core_id(), aux, arg);
+}
+
+void trace_recorder_register_queue(QueueHandle_t queue, const char *name)
+{
+    if (queue == NULL || s_queue_count >= TRACE_MAX_QUEUES) {
+        ESP_LOGW(TAG, "Queue '%s' not registered", name);
+        return;
+    }
+    s_queue_names[s_queue_count]   = name;
+    s_queue_handles[s_queue_count] = queue;
+    s_queue_count++;
+}
+
+// ==================== 커널 훅 (trace_hooks.h) ====================
+
+#if TRACE_KERNEL_HOOKS
+
+static inline void IRAM_ATTR record_task(uint8_t type)
+{
+    if (!s_recording) {
+        return;
+    }
+    int core = esp_cpu_get_core_id();
+    record(type, (uint8_t)core, 0, (uint32_t)xTaskGetCurrentTaskHandleForCore(core));
+}
+
+static inline void IRAM_ATTR record_queue(uint8_t type, const void *queue, unsigned waiting)
+{
+    if (!s_recording) {
+        return;
+    }
+    for (uint8_t i = 0; i < s_queue_count; i++) {
+        if (s_queue_handles[i] == queue) {
+            record(type, (uint8_t)esp_cpu_get_core_id(), (uint16_t)waiting, (uint32_t)queue);
+            return;
+        }
+    }
+}
+
+void IRAM_ATTR trace_hook_task_switched_in(void)
+{
+    record_task(TRACE_EV_TASK_IN);
+}
+
+void IRAM_ATTR trace_hook_task_switched_out(void)
+{
+    record_task(TRACE_EV_TASK_OUT);
+}
+
+void IRAM_ATTR trace_hook_queue_send(const void *queue, unsigned waiting)
+{
+    record_queue(TRACE_EV_QUEUE_SEND, queue, waiting);
+}
+
+void IRAM_ATTR trace_hook_queue_receive(const void *queue, unsigned waiting)
+{
+    record_queue(TRACE_EV_QUEUE_RECV, queue, waiting);
+}
+
+#endif // TRACE_KERNEL_HOOKS
+
+// ==================== 제어 API ====================
+
+bool trace_recorder_start(void)
+{
+    s_recording = false;
+
+    if (s_ring == NULL) {
+        s_ring = heap_caps_malloc(TRACE_RING_EVENTS * sizeof(trace_event_t),
+                                  MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (s_ring == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate %u byte trace ring",
+                     (unsigned)(TRACE_RING_EVENTS * sizeof(trace_event_t)));
+            return false;
+        }
+    }
+
+    atomic_store(&s_head, 0);
+    s_recording = true;
+
+    ESP_LOGI(TAG, "Recording started (%d events, kernel hooks %s)", TRACE_RING_EVENTS,
+             TRACE_KERNEL_HOOKS ? "on" : "off");
+    return true;
+}
+
+void trace_recorder_stop(void)
+{
+    if (!s_recording) {
+        return;
+    }
+    s_recording = false;
+
+    // 플래그를 보기 전에 들어온 기록이 끝나도록 잠시 양보
+    vTaskDelay(1);
+
+    ESP_LOGI(TAG, "Recording stopped (%u events)", (unsigned)atomic_load(&s_head));
+}
+
+// ==================== 상태 보고 ====================
+
+size_t trace_recorder_build_status_json(char *buf, size_t cap)
+{
+    const char *state = s_recording ? "recording" : (s_ring != NULL) ? "stopped" : "idle";
+    unsigned head = atomic_load(&s_head);
+    unsigned lost = (head > TRACE_RING_EVENTS) ? head - TRACE_RING_EVENTS : 0;
+
+    int n = snprintf(buf, cap,
+                     "{\"state\":\"%s\",\"kernel\":%s,\"events\":%u,\"capacity\":%u,\"lost\":%u}",
+                     state, TRACE_KERNEL_HOOKS ? "true" : "false",
+                     head - lost, (unsigned)TRACE_RING_EVENTS, lost);
+    return (n > 0 && (size_t)n < cap) ? (size_t)n : 0;
+}
+
+// ==================== 결과 전송 ====================
+
+static bool dump_events(unsigned first, unsigned count, uint8_t *chunk, uint16_t max_chunk,
+                        trace_emit_fn emit, void *ctx)
+{
+    const uint16_t per_chunk = (uint16_t)((max_chunk - 4) / sizeof(trace_event_t));
+
+    while (count > 0) {
+        uint16_t n = (count < per_chunk) ? (uint16_t)count : per_chunk;
+        chunk[0] = TRACE_CHUNK_EVENTS;
+        chunk[1] = 0;
+        chunk[2] = (uint8_t)n;
+        chunk[3] = (uint8_t)(n >> 8);
+        for (uint16_t i = 0; i < n; i++) {
+            const trace_event_t *ev = &s_ring[(first + i) & (TRACE_RING_EVENTS - 1)];
+            uint8_t *dst = &chunk[4 + i * sizeof(trace_event_t)];
+            vcdc_put_u32(&dst[0], ev->ts_us);
+            dst[4] = ev->type;
+            dst[5] = ev->core;
+            dst[6] = (uint8_t)ev->aux;
+            dst[7] = (uint8_t)(ev->aux >> 8);
+            vcdc_put_u32(&dst[8], ev->arg);
+        }
+        if (!emit(chunk, (uint16_t)(4 + n * sizeof(trace_event_t)), ctx)) {
+            return false;
+        }
+        first += n;
+        count -= n;
+    }
+    return true;
+}
+
+bool trace_recorder_dump(uint16_t max_chunk, trace_emit_fn emit, void *ctx)
+{
+    trace_recorder_stop();
+    if (s_ring == NULL) {
+        return false;
+    }
+
+    uint8_t *chunk = mem_arena_alloc(max_chunk);
+    if (chunk == NULL) {
+        return false;
+    }
+
+    unsigned head  = atomic_load(&s_head);
+    unsigned count = (head > TRACE_RING_EVENTS) ? TRACE_RING_EVENTS : head;
+
+    uint32_t queue_handles[TRACE_MAX_QUEUES];
+    for (uint8_t i = 0; i < s_queue_count; i++) {
+        queue_handles[i] = (uint32_t)s_queue_handles[i];
+    }
+
+    bool ok = vcdc_chunk_dump_tasks(TRACE_CHUNK_TASKS, chunk, max_chunk, emit, ctx) &&
+              vcdc_chunk_dump_names(TRACE_CHUNK_QUEUES, queue_handles, s_queue_names, s_queue_count,
+                                    chunk, max_chunk, emit, ctx) &&
+              dump_events(head - count, count, chunk, max_chunk, emit, ctx);
+
+    if (ok) {
+        memset(chunk, 0, 4);
+        chunk[0] = TRACE_CHUNK_END;
+        vcdc_put_u32(&chunk[4], count);
+        vcdc_put_u32(&chunk[8], head - count);
+        vcdc_put_u32(&chunk[12], (uint32_t)esp_timer_get_time());
+        ok = emit(chunk, 16, ctx);
+    }
+
+    mem_arena_free(chunk);
+    return ok;
+}
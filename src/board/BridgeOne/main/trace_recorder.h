@@ -0,0 +1,141 @@
+/**
+ * @file trace_recorder.h
+ * @brief 커널/입력 파이프라인 이벤트 트레이스 레코더 (타임라인)
+ *
+ * 역할:
+ * - FreeRTOS 트레이스 매크로(trace_hooks.h)로 태스크 스위치 in/out과
+ *   등록된 큐(frame_queue, HID 리포트 큐)의 send/receive를 기록
+ * - BridgeOne 이벤트: UART 프레임 디코드, HID 프레임 처리, 리포트 게시/제출/전송 완료, PING
+ * - 이벤트는 us 타임스탬프와 함께 내부 DRAM 링 버퍼에 쌓이며, 가득 차면 가장 오래된 것부터 덮어씁니다
+ *   (플라이트 레코더: dump 시점 직전 TRACE_RING_EVENTS개가 남음)
+ * - 요청 시 Vendor CDC로 전송 → 호스트 도구(tools/tracedump.py)가 Chrome 트레이스 JSON으로 변환
+ *   (Perfetto UI / chrome://tracing에서 프레임이 어디서 기다렸는지 확인)
+ *
+ * 비용: 기록 중이 아닐 때 이벤트 1개 = 함수 호출 + 플래그 확인.
+ * 기록 중에는 esp_timer_get_time() + 원자적 인덱스 증가 + 12B 쓰기입니다.
+ * 커널 훅은 CONFIG_BRIDGEONE_EVENT_TRACE(기본 꺼짐)로 켭니다 (꺼도 BridgeOne 이벤트는 기록됨).
+ *
+ * 제어/전송 (Vendor CDC):
+ * - VCDC_CMD_TRACE_CONTROL (JSON): {"op":"start"} / "stop" / "status" / "dump"
+ * - VCDC_CMD_TRACE_STATUS  (JSON): 상태 응답 (trace_recorder_build_status_json 참조)
+ * - VCDC_CMD_TRACE_DATA    (바이너리): dump 응답, 형식은 trace_chunk_t 참조
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+// ==================== 상수 ====================
+
+/**
+ * 링 버퍼 이벤트 수 (2의 거듭제곱, 이벤트 12B → 24KB, 내부 DRAM).
+ * 캐시 비활성 구간의 훅도 쓸 수 있도록 PSRAM 대신 내부 DRAM에 두므로 크기를 작게 유지합니다.
+ */
+#define TRACE_RING_EVENTS       2048
+
+/** 큐 이벤트를 기록할 최대 큐 수 */
+#define TRACE_MAX_QUEUES        4
+
+// ==================== 이벤트 ====================
+
+/**
+ * 이벤트 종류와 aux/arg 의미.
+ */
+typedef enum {
+    TRACE_EV_TASK_IN = 1,   // arg: 태스크 핸들 (이 코어에서 실행 시작)
+    TRACE_EV_TASK_OUT,      // arg: 태스크 핸들 (이 코어에서 실행 중단)
+    TRACE_EV_QUEUE_SEND,    // arg: 큐 핸들, aux: 보내기 전 대기 메시지 수
+    TRACE_EV_QUEUE_RECV,    // arg: 큐 핸들, aux: 받기 전 대기 메시지 수
+    TRACE_EV_UART_FRAME,    // arg: 프레임 seq, aux: 1 = 재생 주입 (frame_queue 전송 직전)
+    TRACE_EV_HID_FRAME,     // arg: 마지막 프레임 seq, aux: 합친 프레임 수 (hid_task, 처리 시작)
+    TRACE_EV_HID_PUBLISH,   // aux: HID 인스턴스 (리포트 게시, 메일박스 모드)
+    TRACE_EV_HID_SUBMIT,    // aux: HID 인스턴스 (tud_hid_n_report 성공)
+    TRACE_EV_HID_COMPLETE,  // aux: HID 인스턴스 (tud_hid_report_complete_cb)
+    TRACE_EV_PING,          // Vendor CDC PING 수신
+} trace_event_type_t;
+
+/** 링 버퍼 이벤트 (12B, 전송 시 그대로 Little-Endian) */
+typedef struct {
+    uint32_t ts_us;         // esp_timer_get_time() 하위 32비트
+    uint8_t  type;          // trace_event_type_t
+    uint8_t  core;          // 기록한 코어
+    uint16_t aux;
+    uint32_t arg;
+} trace_event_t;
+
+// ==================== TRACE_DATA 청크 ====================
+
+/**
+ * TRACE_DATA 페이로드 첫 바이트 (청크 종류).
+ * dump 응답 순서: TASKS → QUEUES → EVENTS (오래된 순, 여러 개) → END.
+ *
+ * - TASKS:  [kind][count] + count × ([handle u32][name_len u8][name])
+ * - QUEUES: [kind][count] + count × ([handle u32][name_len u8][name])
+ * - EVENTS: [kind][0][count u16] + count × trace_event_t
+ * - END:    [kind][0][0][0] + [events u32][lost u32][now_us u32]
+ *           lost = 링이 덮어써서 잃은 이벤트 수, now_us = dump 시각 (ts_us와 같은 시계)
+ * 정수는 모두 Little-Endian입니다.
+ */
+typedef enum {
+    TRACE_CHUNK_TASKS  = 0,
+    TRACE_CHUNK_QUEUES = 1,
+    TRACE_CHUNK_EVENTS = 2,
+    TRACE_CHUNK_END    = 3,
+} trace_chunk_t;
+
+// ==================== API ====================
+
+/**
+ * 큐 이벤트를 기록할 큐 등록 (큐 생성 직후 호출).
+ * 등록되지 않은 큐(세마포어/뮤텍스 포함)의 이벤트는 버립니다.
+ */
+void trace_recorder_register_queue(QueueHandle_t queue, const char *name);
+
+/**
+ * 이벤트 기록 (모든 태스크/코어/ISR에서 호출 가능, IRAM).
+ * 기록 중이 아니면 아무것도 하지 않습니다.
+ */
+void trace_recorder_event(trace_event_type_t type, uint16_t aux, uint32_t arg);
+
+/**
+ * 기록 시작. 링 버퍼를 비우고 처음부터 기록합니다.
+ *
+ * @return true: 시작, false: 링 버퍼 확보 실패
+ */
+bool trace_recorder_start(void);
+
+/**
+ * 기록 중지. 링 버퍼 내용은 유지됩니다.
+ */
+void trace_recorder_stop(void);
+
+/**
+ * 상태를 압축 JSON으로 작성.
+ *
+ * 형식: {"state":"recording","kernel":true,"events":n,"capacity":n,"lost":n}
+ *
+ * @return 작성된 길이 (null 제외). 버퍼가 부족하면 0
+ */
+size_t trace_recorder_build_status_json(char *buf, size_t cap);
+
+/**
+ * 결과 전송 콜백 (청크 1개 = TRACE_DATA 프레임 1개).
+ *
+ * @return false면 전송을 중단합니다
+ */
+typedef bool (*trace_emit_fn)(const uint8_t *chunk, uint16_t len, void *ctx);
+
+/**
+ * 기록을 중지하고 링 버퍼를 청크로 나눠 emit에 전달 (VCDC 태스크 전용).
+ *
+ * @param max_chunk 청크 최대 크기 (VCDC_MAX_PAYLOAD_SIZE)
+ * @return true: END 청크까지 전달, false: 기록 없음 또는 전송 중단
+ */
+bool trace_recorder_dump(uint16_t max_chunk, trace_emit_fn emit, void *ctx);
+
+#endif // TRACE_RECORDER_H
@@ -1,5 +1,11 @@
 #include "uart_handler.h"
 #include "connection_state.h"   // bridge_mode_get() 사용
+#include "macro_engine.h"       // macro_engine_trigger(), macro_engine_stored_mask()
+#include "hid_handler.h"        // hid_set_pointer_dynamics() 사용
+#include "scroll_inertia.h"     // scroll_inertia_start()/stop() 사용
+#include "task_profiler.h"      // 깨어남/지연 프로브
+#include "trace_recorder.h"     // 이벤트 트레이스
+#include "input_trace.h"        // 입력 트레이스 기록/재생
 #include "driver/uart.h"
 #include "esp_log.h"
 #include "esp_task_wdt.h"
@@ -144,7 +150,7 @@ static bool validateSequenceNumber(uint8_t current_seq, uint8_t* expected_seq) {
  *
  * 수신한 프레임의 필드 범위를 검증합니다.
  * - 프레임 크기: 정확히 8바이트
- * - buttons 필드: 0x00~0x07 범위 (마우스 버튼 3개만 지원)
+ * - buttons 필드: 마우스 버튼 3개(0x07) + 휠 플래그(0x18)만 허용
  *
  * @param frame 검증할 프레임 포인터
  * @return 프레임이 유효하면 true, 그렇지 않으면 false
@@ -157,15 +163,13 @@ static bool validateBridgeFrame(const bridge_frame_t* frame) {
         return false;
     }
     
-    // buttons 필드 범위 검증 (마우스 버튼 3개: L, R, M)
-    // 0x00: 아무 버튼 안 눌림
-    // 0x01: Left 버튼 (Bit 0)
-    // 0x02: Right 버튼 (Bit 1)
-    // 0x04: Middle 버튼 (Bit 2)
-    // 0x03, 0x05, 0x06, 0x07: 조합
-    if (frame->buttons > 0x07) {
-        ESP_LOGE(TAG, "Invalid buttons value: 0x%02X (expected 0x00~0x07)",
-                 frame->buttons);
+    // buttons 필드 검증
+    // Bit 0~2: Left/Right/Middle 버튼
+    // Bit 3: 수평 휠 플래그 (BRIDGE_FLAG_HWHEEL)
+    // Bit 4: 고해상도 휠 플래그 (BRIDGE_FLAG_HIRES_WHEEL)
+    if ((frame->buttons & ~BRIDGE_BUTTONS_VALID_MASK) != 0) {
+        ESP_LOGE(TAG, "Invalid buttons value: 0x%02X (allowed bits 0x%02X)",
+                 frame->buttons, BRIDGE_BUTTONS_VALID_MASK);
         return false;
     }
     
@@ -176,7 +180,11 @@ static bool validateBridgeFrame(const bridge_frame_t* frame) {
  * Android 쿼리 프레임 핸들러.
  *
  * 첫 바이트가 UART_QUERY_HEADER(0xFF)인 프레임을 처리합니다.
- * 현재는 모드 쿼리(UART_QUERY_MODE)만 지원합니다.
+ * - UART_QUERY_MODE: 현재 모드를 알림 프레임으로 응답
+ * - UART_QUERY_MACRO_RUN: query_buf[2]의 매크로 ID 재생 (응답 없음)
+ * - UART_QUERY_SET_DYNAMICS: 포인터 다이나믹스 프리셋/스케일 설정 (응답 없음)
+ * - UART_QUERY_SCROLL_FLING: 관성 스크롤 시작/정지 (응답 없음)
+ * - UART_QUERY_MACRO_SLOTS: 저장된 매크로 슬롯 비트맵을 알림 프레임으로 응답
  *
  * @param query_buf 수신한 8바이트 쿼리 프레임
  */
@@ -195,6 +203,28 @@ static void handle_uart_query(const uint8_t *query_buf)
         uart_write_bytes(UART_NUM, (const char *)response, sizeof(response));
         ESP_LOGD(TAG, "Mode query → %s",
                  (mode == BRIDGE_MODE_STANDARD) ? "STANDARD" : "ESSENTIAL");
+    } else if (query_type == UART_QUERY_MACRO_RUN) {
+        macro_engine_trigger(query_buf[2]);
+    } else if (query_type == UART_QUERY_SET_DYNAMICS) {
+        hid_set_pointer_dynamics(query_buf[2], (uint16_t)(query_buf[3] | (query_buf[4] << 8)));
+    } else if (query_type == UART_QUERY_MACRO_SLOTS) {
+        uint32_t mask = macro_engine_stored_mask();
+        uint8_t response[8] = {
+            UART_NOTIFY_HEADER,
+            UART_EVENT_MACRO_SLOTS,
+            (uint8_t)mask, (uint8_t)(mask >> 8), (uint8_t)(mask >> 16), (uint8_t)(mask >> 24),
+            0x00, 0x00
+        };
+        uart_write_bytes(UART_NUM, (const char *)response, sizeof(response));
+        ESP_LOGD(TAG, "Macro slots query → 0x%08lX", (unsigned long)mask);
+    } else if (query_type == UART_QUERY_SCROLL_FLING) {
+        int16_t velocity_q8 = (int16_t)(query_buf[3] | (query_buf[4] << 8));
+        uint16_t tau_ms = (uint16_t)(query_buf[5] | (query_buf[6] << 8));
+        if (velocity_q8 == 0) {
+            scroll_inertia_stop();
+        } else {
+            scroll_inertia_start(query_buf[2] != 0, velocity_q8, tau_ms, query_buf[7]);
+        }
     } else {
         ESP_LOGW(TAG, "Unknown query type: 0x%02X", query_type);
     }
@@ -240,6 +270,7 @@ void uart_task(void* param) {
             sizeof(bridge_frame_t),
             pdMS_TO_TICKS(UART_RX_TIMEOUT_MS)
         );
+        task_probe_wake(TASK_PROBE_UART);
         
         // 수신 바이트 수에 따른 오류 처리
         if (len < 0) {
@@ -283,10 +314,19 @@ void uart_task(void* param) {
             continue;
         }
         
+        // 트레이스 재생 중에는 실제 입력을 버림 (재생 태스크가 frame_queue를 사용)
+        if (input_trace_replay_active()) {
+            esp_task_wdt_reset();
+            continue;
+        }
+        input_trace_record(INPUT_TRACE_FRAME, &frame_buffer, sizeof(frame_buffer));
+
         // 검증 성공한 프레임을 큐에 전송
         // - frame_queue: FreeRTOS 큐 핸들
         // - &frame_buffer: 프레임 포인터 (8바이트)
         // - pdMS_TO_TICKS(10): 10ms 타임아웃 (대기하지 않고 즉시 전송 시도)
+        trace_recorder_event(TRACE_EV_UART_FRAME, 0, frame_buffer.seq);
+        task_probe_signal(TASK_PROBE_HID);
         BaseType_t queue_status = xQueueSend(
             frame_queue,
             &frame_buffer,
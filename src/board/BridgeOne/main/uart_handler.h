@@ -40,7 +40,7 @@
  *
  * 레이아웃 (총 8바이트):
  *  - seq:      시퀀스 번호 (0~253 순환, 0xFE/0xFF 예약)
- *  - buttons:  마우스 버튼 비트 (Bit 0: L, Bit 1: R, Bit 2: M)
+ *  - buttons:  마우스 버튼 비트 (Bit 0: L, Bit 1: R, Bit 2: M) + 휠 플래그 (Bit 3~4, 아래 참조)
  *  - x:        X축 이동값 (signed -127~127)
  *  - y:        Y축 이동값 (signed -127~127)
  *  - wheel:    스크롤 휠 값 (signed -127~127)
@@ -59,6 +59,18 @@ typedef struct {
     uint8_t keycode2;   // 바이트 7: 두 번째 키코드
 } bridge_frame_t;
 
+/**
+ * bridge_frame_t.buttons 비트 구성.
+ *
+ * 하위 3비트는 마우스 버튼, 상위 비트는 wheel 필드 해석 플래그입니다.
+ * - BRIDGE_FLAG_HWHEEL:      wheel 값을 수평 휠(AC Pan)로 전송
+ * - BRIDGE_FLAG_HIRES_WHEEL: wheel 값이 1/HID_WHEEL_UNITS_PER_DETENT 디텐트 단위 (없으면 디텐트 단위)
+ */
+#define BRIDGE_BUTTONS_MASK         0x07u   /**< 마우스 버튼 비트 (L, R, M) */
+#define BRIDGE_FLAG_HWHEEL          0x08u   /**< 플래그: 수평 휠 */
+#define BRIDGE_FLAG_HIRES_WHEEL     0x10u   /**< 플래그: 고해상도 휠 단위 */
+#define BRIDGE_BUTTONS_VALID_MASK   (BRIDGE_BUTTONS_MASK | BRIDGE_FLAG_HWHEEL | BRIDGE_FLAG_HIRES_WHEEL)
+
 /**
  * UART 초기화 함수.
  *
@@ -133,4 +145,47 @@ void uart_send_notification(uint8_t event_type, uint8_t data);
 #define UART_QUERY_HEADER               0xFFu   /**< 쿼리 프레임 식별자 */
 #define UART_QUERY_MODE                 0x01u   /**< 쿼리 타입: 현재 모드 조회 */
 
+/**
+ * Android → ESP32-S3 매크로 실행 프레임 (쿼리 헤더 공유, 응답 없음).
+ *
+ * 프레임: { 0xFF, UART_QUERY_MACRO_RUN, macro_id, 0x00, 0x00, 0x00, 0x00, 0x00 }
+ * 매크로는 Windows 서버가 Vendor CDC로 미리 업로드해 둔 것을 재생합니다 (macro_engine.h).
+ */
+#define UART_QUERY_MACRO_RUN            0x02u   /**< 쿼리 타입: 매크로 재생 */
+
+/**
+ * Android → ESP32-S3 포인터 다이나믹스 설정 프레임 (쿼리 헤더 공유, 응답 없음).
+ *
+ * 프레임: { 0xFF, UART_QUERY_SET_DYNAMICS, preset_id, scale_lo, scale_hi, 0x00, 0x00, 0x00 }
+ * - preset_id: Android DYNAMICS_PRESETS 인덱스 (pointer_dynamics.h)
+ * - scale: dp 1당 델타 카운트 (Q8.8, Little-Endian) = 화면 밀도 × DPI 배율
+ * Android는 가속 전 델타를 보내고 가속은 hid_task가 적용합니다.
+ */
+#define UART_QUERY_SET_DYNAMICS         0x03u   /**< 쿼리 타입: 포인터 다이나믹스 설정 */
+
+/**
+ * Android → ESP32-S3 관성 스크롤 시작/정지 프레임 (쿼리 헤더 공유, 응답 없음).
+ *
+ * 프레임: { 0xFF, UART_QUERY_SCROLL_FLING, axis, vel_lo, vel_hi, tau_lo, tau_hi, stop_q4 }
+ * - axis: 0 = 수직 휠, 1 = 수평 휠(AC Pan)
+ * - vel: 초기 속도 (1/HID_WHEEL_UNITS_PER_DETENT 디텐트 단위/ms, Q8.8 signed, Little-Endian)
+ *        0이면 진행 중인 관성 스크롤 정지
+ * - tau: 지수 감쇠 시간 상수 (ms, Little-Endian)
+ * - stop_q4: 정지 속도 (단위/ms, Q4.4) - 속도가 이 값 미만이 되면 종료
+ * 손가락을 뗄 때 한 번만 보내면 감쇠 곡선은 펌웨어가 1ms마다 생성합니다 (scroll_inertia.h).
+ */
+#define UART_QUERY_SCROLL_FLING         0x04u   /**< 쿼리 타입: 관성 스크롤 */
+
+/**
+ * Android → ESP32-S3 매크로 슬롯 조회 프레임 (쿼리 헤더 공유).
+ *
+ * 쿼리 프레임: { 0xFF, UART_QUERY_MACRO_SLOTS, 0x00, ... }
+ * 응답 프레임: { 0xFE, UART_EVENT_MACRO_SLOTS, mask(4B, Little-Endian), 0x00, 0x00 }
+ * - mask: 비트 n = 매크로 ID n이 저장되어 있음 (macro_engine_stored_mask())
+ * Android는 모드 폴링과 함께 조회하여, 저장된 매크로만 UART_QUERY_MACRO_RUN으로 트리거하고
+ * 나머지(Windows 업로드 전)는 개별 키 프레임으로 보냅니다.
+ */
+#define UART_QUERY_MACRO_SLOTS          0x05u   /**< 쿼리 타입: 저장된 매크로 슬롯 조회 */
+#define UART_EVENT_MACRO_SLOTS          0x03u   /**< 이벤트: 저장된 매크로 슬롯 비트맵 */
+
 #endif // UART_HANDLER_H
@@ -1,8 +1,13 @@
 #include "usb_cdc_log.h"
 #include "vendor_cdc_handler.h"
 #include "connection_state.h"
+#include "macro_engine.h"
+#include "hid_handler.h"  // hid_get_submit_stats()
+#include "mem_report.h"   // mem_report_print()
+#include "mem_alloc.h"    // mem_alloc_get_stats()
 #include "tusb.h"
 #include "esp_log.h"
+#include "esp_timer.h"  // esp_timer_get_time()
 #include "esp_system.h"  // esp_restart()
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"  // vTaskDelay()
@@ -19,41 +24,49 @@ static bool cdc_log_enabled = false;
 // 기존 vprintf 함수 포인터 (복원용)
 static vprintf_like_t original_vprintf = NULL;
 
-// CDC 출력 버퍼 (스레드 안전을 위해 정적 할당)
-// LF → CRLF 변환으로 최대 2배 크기 필요
+// CDC 로그 포맷 버퍼 (스레드 안전을 위해 정적 할당)
+// LF → CRLF 변환 결과는 별도 버퍼 없이 TX FIFO에 직접 기록
 #define CDC_LOG_BUFFER_SIZE 512
-#define CDC_OUTPUT_BUFFER_SIZE (CDC_LOG_BUFFER_SIZE * 2)
 static char cdc_log_buffer[CDC_LOG_BUFFER_SIZE];
-static char cdc_output_buffer[CDC_OUTPUT_BUFFER_SIZE];
 
 /**
- * LF(\n)를 CRLF(\r\n)로 변환하는 헬퍼 함수.
+ * LF(\n)를 CRLF(\r\n)로 변환하며 CDC TX FIFO에 직접 기록하는 헬퍼 함수.
  *
  * Windows 터미널(Tera Term 등)은 CRLF를 기대합니다.
  * LF만 전송하면 줄바꿈 시 커서가 줄 시작으로 돌아가지 않아
  * 로그가 계단식으로 밀려나가는 현상이 발생합니다.
  *
+ * tud_cdc_write_reserve()로 받은 FIFO 빈 영역(선형 + 래핑)에 변환 결과를 바로 쓰므로
+ * 중간 출력 버퍼와 복사가 없습니다. 공간이 부족하면 기존 tud_cdc_write()처럼
+ * 들어가는 만큼만 기록하며, CR/LF 쌍은 나누지 않습니다.
+ *
  * @param src 원본 문자열
  * @param src_len 원본 문자열 길이
- * @param dst 출력 버퍼 (최대 src_len * 2 크기 필요)
- * @param dst_size 출력 버퍼 크기
- * @return 변환된 문자열 길이
+ * @return FIFO에 기록된 바이트 수 (CR 포함)
  */
-static int convert_lf_to_crlf(const char* src, int src_len, char* dst, int dst_size) {
-    int j = 0;
-    for (int i = 0; i < src_len && j < dst_size - 1; i++) {
-        if (src[i] == '\n') {
-            // LF 앞에 CR이 없으면 CR 추가
-            if (i == 0 || src[i - 1] != '\r') {
-                if (j < dst_size - 2) {
-                    dst[j++] = '\r';
-                }
-            }
+static uint32_t write_crlf_to_fifo(const char* src, size_t src_len) {
+    tu_fifo_buffer_info_t info;
+    // 최악의 경우(모든 문자가 LF) 2배 크기 필요
+    uint32_t reserved = tud_cdc_write_reserve((uint32_t)(src_len * 2), &info);
+
+    uint32_t j = 0;
+    for (size_t i = 0; i < src_len; i++) {
+        // LF 앞에 CR이 없으면 CR 추가
+        bool add_cr = (src[i] == '\n') && (i == 0 || src[i - 1] != '\r');
+        if (j + (add_cr ? 2u : 1u) > reserved) {
+            break;
+        }
+        if (add_cr) {
+            char* dst = (j < info.len_lin) ? (char*)info.ptr_lin + j : (char*)info.ptr_wrap + (j - info.len_lin);
+            *dst = '\r';
+            j++;
         }
-        dst[j++] = src[i];
+        char* dst = (j < info.len_lin) ? (char*)info.ptr_lin + j : (char*)info.ptr_wrap + (j - info.len_lin);
+        *dst = src[i];
+        j++;
     }
-    dst[j] = '\0';
-    return j;
+
+    return tud_cdc_write_commit(j);
 }
 
 /**
@@ -82,12 +95,8 @@ static int cdc_vprintf(const char* fmt, va_list args) {
 
     // USB CDC가 연결되어 있는지 확인
     if (tud_cdc_connected()) {
-        // LF → CRLF 변환 (Windows 터미널 호환성)
-        int output_len = convert_lf_to_crlf(cdc_log_buffer, len,
-                                             cdc_output_buffer, CDC_OUTPUT_BUFFER_SIZE);
-
-        // CDC로 출력
-        uint32_t written = tud_cdc_write(cdc_output_buffer, output_len);
+        // LF → CRLF 변환하며 CDC로 출력 (Windows 터미널 호환성)
+        uint32_t written = write_crlf_to_fifo(cdc_log_buffer, (size_t)len);
 
         // 즉시 전송 (버퍼링 방지)
         tud_cdc_write_flush();
@@ -155,10 +164,8 @@ void usb_cdc_log_write(const char* str) {
     size_t len = strlen(str);
 
     if (tud_cdc_connected() && len > 0) {
-        // LF → CRLF 변환 (Windows 터미널 호환성)
-        int output_len = convert_lf_to_crlf(str, (int)len,
-                                             cdc_output_buffer, CDC_OUTPUT_BUFFER_SIZE);
-        tud_cdc_write(cdc_output_buffer, output_len);
+        // LF → CRLF 변환하며 CDC로 출력 (Windows 터미널 호환성)
+        write_crlf_to_fifo(str, len);
         tud_cdc_write_flush();
     }
 }
@@ -194,6 +201,7 @@ void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts) {
 
         // 서버가 CDC 포트를 닫으면 즉시 IDLE 상태로 전환 (Essential 모드 복귀)
         // 서버 비정상 종료 시에도 OS가 DTR=false를 보내므로 빠른 감지 가능
+        // CONNECTED였다면 세션이 보류되어 유예 시간 안에 RESUME으로 같은 기능 그대로 복귀 가능
         if (connection_state_get() != CONN_STATE_IDLE) {
             ESP_LOGW(TAG, "DTR released while connected, reverting to Essential mode");
             connection_state_reset();
@@ -238,10 +246,99 @@ static void process_cdc_command(const char* cmd) {
                  connection_state_name(connection_state_get()));
         usb_cdc_log_write(msg);
     }
+    else if (strcmp(lower_cmd, "macrobench") == 0) {
+        // 매크로 실행기 스텝 타이밍 벤치마크 (드라이런, 55스텝 × 1ms)
+        // 결과는 완료 시 MACRO 태그 로그로 출력됨
+        if (macro_engine_run_benchmark(MACRO_MAX_STEPS, 1000)) {
+            usb_cdc_log_write("\r\nMacro benchmark started (55 steps x 1000us)\r\n");
+        } else {
+            usb_cdc_log_write("\r\nMacro benchmark not started (macro playing?)\r\n");
+        }
+    }
+    else if (strcmp(lower_cmd, "macrostat") == 0) {
+        macro_timing_stats_t stats;
+        macro_engine_get_timing_stats(&stats);
+        int32_t avg = (stats.step_count > 0)
+                      ? (int32_t)(stats.sum_lateness_us / stats.step_count) : 0;
+        char msg[128];
+        snprintf(msg, sizeof(msg),
+                 "\r\nMacro steps=%lu lateness min=%ldus avg=%ldus max=%ldus >=100us=%lu\r\n",
+                 (unsigned long)stats.step_count, (long)stats.min_lateness_us, (long)avg,
+                 (long)stats.max_lateness_us, (unsigned long)stats.late_over_100us);
+        usb_cdc_log_write(msg);
+    }
+    else if (strcmp(lower_cmd, "hidstat") == 0) {
+        hid_mailbox_stats_t kb, mouse;
+        if (!hid_get_submit_stats(&kb, &mouse)) {
+            usb_cdc_log_write("\r\nHID mailbox disabled (HID_SUBMIT_MAILBOX=0)\r\n");
+        } else {
+            char msg[160];
+            snprintf(msg, sizeof(msg),
+                     "\r\nHID kb    submitted=%lu pending=%lu dropped=%lu latency avg=%ldus max=%ldus\r\n",
+                     (unsigned long)kb.submitted, (unsigned long)kb.pending,
+                     (unsigned long)kb.dropped, (long)kb.latency_avg_us, (long)kb.latency_max_us);
+            usb_cdc_log_write(msg);
+            snprintf(msg, sizeof(msg),
+                     "HID mouse submitted=%lu pending=%lu dropped=%lu latency avg=%ldus max=%ldus\r\n",
+                     (unsigned long)mouse.submitted, (unsigned long)mouse.pending,
+                     (unsigned long)mouse.dropped, (long)mouse.latency_avg_us,
+                     (long)mouse.latency_max_us);
+            usb_cdc_log_write(msg);
+        }
+    }
+    else if (strcmp(lower_cmd, "hotpath") == 0 || strcmp(lower_cmd, "hotpath reset") == 0) {
+        hid_hotpath_stats_t process, submit;
+        hid_get_hotpath_stats(&process, &submit);
+        char msg[160];
+        snprintf(msg, sizeof(msg),
+                 "\r\nHot path (cycles @%dMHz, stall >%dus)\r\n"
+                 "  process n=%lu min=%lu avg=%lu max=%lu stalls=%lu\r\n",
+                 CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, HID_HOTPATH_STALL_US,
+                 (unsigned long)process.count, (unsigned long)process.cycles_min,
+                 (unsigned long)process.cycles_avg, (unsigned long)process.cycles_max,
+                 (unsigned long)process.stalls);
+        usb_cdc_log_write(msg);
+        snprintf(msg, sizeof(msg), "  submit  n=%lu min=%lu avg=%lu max=%lu stalls=%lu\r\n",
+                 (unsigned long)submit.count, (unsigned long)submit.cycles_min,
+                 (unsigned long)submit.cycles_avg, (unsigned long)submit.cycles_max,
+                 (unsigned long)submit.stalls);
+        usb_cdc_log_write(msg);
+        if (strcmp(lower_cmd, "hotpath reset") == 0) {
+            hid_reset_hotpath_stats();
+            usb_cdc_log_write("  (statistics reset)\r\n");
+        }
+    }
+    else if (strcmp(lower_cmd, "mem") == 0) {
+        mem_report_print();
+    }
+    else if (strcmp(lower_cmd, "allocstat") == 0) {
+        mem_alloc_stats_t stats;
+        mem_alloc_get_stats(&stats);
+        char msg[128];
+        snprintf(msg, sizeof(msg), "\r\nArena %d bytes: peak=%lu commands=%lu leaks=%lu\r\n",
+                 MEM_ARENA_SIZE, (unsigned long)stats.arena_peak,
+                 (unsigned long)stats.arena_resets, (unsigned long)stats.arena_leaks);
+        usb_cdc_log_write(msg);
+        for (int i = 0; i < MEM_ALLOC_CLASS_COUNT; i++) {
+            const mem_alloc_class_stats_t *c = &stats.cls[i];
+            snprintf(msg, sizeof(msg),
+                     "  %-8s count=%lu bytes=%lu failed=%lu cycles avg=%lu max=%lu\r\n",
+                     mem_alloc_class_name((mem_alloc_class_t)i), (unsigned long)c->count,
+                     (unsigned long)c->bytes, (unsigned long)c->failed,
+                     (unsigned long)c->cycles_avg, (unsigned long)c->cycles_max);
+            usb_cdc_log_write(msg);
+        }
+    }
     else if (strcmp(lower_cmd, "help") == 0 || strcmp(lower_cmd, "?") == 0) {
         usb_cdc_log_write("\r\n=== BridgeOne CDC Commands ===\r\n");
         usb_cdc_log_write("  reset, reboot  - Software reset\r\n");
         usb_cdc_log_write("  status         - Show current connection state\r\n");
+        usb_cdc_log_write("  macrobench     - Measure macro step timing accuracy\r\n");
+        usb_cdc_log_write("  macrostat      - Show macro step timing statistics\r\n");
+        usb_cdc_log_write("  hidstat        - Show HID report publish-to-submit latency\r\n");
+        usb_cdc_log_write("  hotpath        - Show UART->HID hot path cycles/stalls ('hotpath reset' clears)\r\n");
+        usb_cdc_log_write("  mem            - Show heap, task stack and static RAM usage\r\n");
+        usb_cdc_log_write("  allocstat      - Show command arena / PSRAM allocation statistics\r\n");
         usb_cdc_log_write("  help, ?        - Show this help\r\n");
         usb_cdc_log_write("==============================\r\n");
     }
@@ -252,81 +349,87 @@ static void process_cdc_command(const char* cmd) {
     }
 }
 
+/**
+ * 텍스트 명령 입력 1바이트 처리 (에코백, 줄바꿈 시 명령 실행, 백스페이스).
+ *
+ * @param c 입력 문자
+ */
+static void cdc_text_input(char c) {
+    // 에코백 (입력한 문자를 터미널에 표시)
+    if (c >= 32 && c < 127) {
+        char echo[2] = {c, '\0'};
+        usb_cdc_log_write(echo);
+    }
+
+    // Enter 키 (줄바꿈) 처리
+    if (c == '\r' || c == '\n') {
+        cdc_cmd_buffer[cdc_cmd_index] = '\0';
+
+        // 공백 제거 (trim)
+        char* trimmed = cdc_cmd_buffer;
+        while (*trimmed == ' ') trimmed++;
+        char* end = trimmed + strlen(trimmed) - 1;
+        while (end > trimmed && *end == ' ') *end-- = '\0';
+
+        // 명령어 처리
+        process_cdc_command(trimmed);
+
+        // 버퍼 초기화
+        cdc_cmd_index = 0;
+        memset(cdc_cmd_buffer, 0, sizeof(cdc_cmd_buffer));
+    }
+    // Backspace 처리
+    else if (c == 8 || c == 127) {
+        if (cdc_cmd_index > 0) {
+            cdc_cmd_index--;
+            usb_cdc_log_write("\b \b");  // 화면에서 문자 삭제
+        }
+    }
+    // 일반 문자 버퍼에 추가
+    else if (c >= 32 && c < 127 && cdc_cmd_index < CDC_CMD_BUFFER_SIZE - 1) {
+        cdc_cmd_buffer[cdc_cmd_index++] = c;
+    }
+}
+
+// 미완성 프레임을 RX FIFO에 남겨둘 수 있어야 함 (최대 프레임 + OUT 패킷 1개 여유)
+_Static_assert(CFG_TUD_CDC_RX_BUFSIZE >= VCDC_MAX_FRAME_SIZE + CFG_TUD_CDC_EP_BUFSIZE,
+               "CDC RX FIFO too small for in-place frame parsing");
+
+/**
+ * vcdc_rx 콜백: 프레임에 속하지 않는 바이트는 텍스트 명령 입력으로 처리.
+ */
+void vcdc_rx_text_cb(uint8_t byte) {
+    cdc_text_input((char)byte);
+}
+
 /**
  * TinyUSB CDC RX 콜백 함수.
  *
  * 호스트로부터 데이터를 수신하면 호출됩니다.
  * 바이너리 프레임(0xFF 시작)과 텍스트 명령을 자동 분류합니다:
- * - 바이너리 프레임 → vendor_cdc_parser_feed()로 전달
+ * - 바이너리 프레임 → vcdc_rx_process_span()이 FIFO에서 바로 파싱
  * - 텍스트 명령 → 기존 텍스트 버퍼에 축적 후 명령어 처리
  *
- * 분류 로직:
- * 1. 각 바이트를 파서에 먼저 공급
- * 2. 파서가 WAIT_HEADER 상태였고 바이트가 0xFF가 아니면 → 텍스트로 처리
- * 3. 파서가 활성 상태이거나 0xFF이면 → 바이너리로 처리 (텍스트 무시)
+ * RX FIFO를 스택 버퍼로 복사하지 않고 tud_cdc_read_regions()로 받은 영역을 직접 읽은 뒤,
+ * 사용한 만큼만 tud_cdc_read_advance()로 소비합니다. 아직 다 도착하지 않은 프레임은
+ * FIFO에 남겨두고 다음 수신 시 이어서 파싱합니다.
  *
  * @param itf CDC 인터페이스 번호 (0-based)
  */
 void tud_cdc_rx_cb(uint8_t itf) {
-    uint8_t buf[64];
-    uint32_t count;
-
-    while (tud_cdc_available()) {
-        count = tud_cdc_read(buf, sizeof(buf));
-
-        for (uint32_t i = 0; i < count; i++) {
-            uint8_t byte = buf[i];
-
-            // 파서가 바이너리 프레임 수신 중인지 확인 (공급 전 상태)
-            bool parser_was_active = vendor_cdc_parser_is_active();
-
-            // 모든 바이트를 파서에 공급 (파서가 내부적으로 0xFF/비-0xFF 분류)
-            vendor_cdc_parser_feed(&byte, 1);
-
-            // 바이너리 프레임에 속하는 바이트는 텍스트 처리 건너뜀
-            // - 파서가 이미 활성 상태였거나 (프레임 수신 중)
-            // - 0xFF로 새 프레임이 시작된 경우
-            if (parser_was_active || byte == VCDC_FRAME_HEADER) {
-                continue;
-            }
-
-            // === 이하 텍스트 명령 처리 (기존 로직 유지) ===
-            char c = (char)byte;
-
-            // 에코백 (입력한 문자를 터미널에 표시)
-            if (c >= 32 && c < 127) {
-                char echo[2] = {c, '\0'};
-                usb_cdc_log_write(echo);
-            }
-
-            // Enter 키 (줄바꿈) 처리
-            if (c == '\r' || c == '\n') {
-                cdc_cmd_buffer[cdc_cmd_index] = '\0';
-
-                // 공백 제거 (trim)
-                char* trimmed = cdc_cmd_buffer;
-                while (*trimmed == ' ') trimmed++;
-                char* end = trimmed + strlen(trimmed) - 1;
-                while (end > trimmed && *end == ' ') *end-- = '\0';
-
-                // 명령어 처리
-                process_cdc_command(trimmed);
-
-                // 버퍼 초기화
-                cdc_cmd_index = 0;
-                memset(cdc_cmd_buffer, 0, sizeof(cdc_cmd_buffer));
-            }
-            // Backspace 처리
-            else if (c == 8 || c == 127) {
-                if (cdc_cmd_index > 0) {
-                    cdc_cmd_index--;
-                    usb_cdc_log_write("\b \b");  // 화면에서 문자 삭제
-                }
-            }
-            // 일반 문자 버퍼에 추가
-            else if (c >= 32 && c < 127 && cdc_cmd_index < CDC_CMD_BUFFER_SIZE - 1) {
-                cdc_cmd_buffer[cdc_cmd_index++] = c;
-            }
+    tu_fifo_buffer_info_t info;
+    int64_t now = esp_timer_get_time();
+
+    while (tud_cdc_read_regions(&info) > 0) {
+        uint32_t used = vcdc_rx_process_span(info.ptr_lin, info.len_lin, info.len_wrap > 0, now);
+        if (used == info.len_lin && info.len_wrap > 0) {
+            used += vcdc_rx_process_span(info.ptr_wrap, info.len_wrap, false, now);
+        }
+
+        tud_cdc_read_advance(used);
+
+        if (used < (uint32_t)info.len_lin + info.len_wrap) {
+            break;  // 미완성 프레임: 다음 RX 콜백에서 이어서 처리
         }
     }
 }
@@ -346,3 +449,7 @@ void tud_cdc_line_coding_cb(uint8_t itf, cdc_line_coding_t const* p_line_coding)
              p_line_coding->bit_rate, p_line_coding->data_bits,
              p_line_coding->stop_bits, p_line_coding->parity);
 }
+
+size_t usb_cdc_log_static_ram_bytes(void) {
+    return sizeof(cdc_log_buffer) + sizeof(cdc_cmd_buffer);
+}
@@ -2,6 +2,7 @@
 #define USB_CDC_LOG_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 /**
  * USB CDC 디버그 로깅 모듈.
@@ -59,4 +60,9 @@ bool usb_cdc_log_is_enabled(void);
  */
 void usb_cdc_log_write(const char* str);
 
+/**
+ * 로그/명령 버퍼의 정적 RAM 크기 (메모리 보고서용).
+ */
+size_t usb_cdc_log_static_ram_bytes(void);
+
 #endif // USB_CDC_LOG_H
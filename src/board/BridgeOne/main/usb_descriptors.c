@@ -10,7 +10,7 @@
  * 참고:
  * - 이 파일의 디스크립터 정의는 esp32s3-code-implementation-guide.md §1.3 규칙을 준수합니다
  * - 인터페이스 순서는 절대 변경 불가 (Keyboard→Mouse→CDC 순서 고정)
- * - HID Report Descriptor는 Boot Protocol 표준을 따름
+ * - HID Report Descriptor는 Boot Protocol 표준을 따름 (마우스는 고해상도 휠/AC Pan 확장)
  */
 
 #include <string.h>
@@ -70,22 +70,101 @@ uint8_t const desc_hid_keyboard_report[] = {
 };
 
 /**
- * HID Boot Mouse Report Descriptor (6바이트: Report ID 2 포함)
+ * HID Mouse Report Descriptor (Report ID 2, 고해상도 스크롤)
  *
- * 구조:
+ * Input 리포트 구조 (bridge_mouse_report_t, 7바이트 + Report ID):
  * - [0] Report ID (2) - 1 byte
- * - [1] Buttons (Left, Right, Middle) - 1 byte
+ * - [1] Buttons (Left, Right, Middle, Back, Forward) - 1 byte
  * - [2] Delta X (-127~127) - 1 byte signed
  * - [3] Delta Y (-127~127) - 1 byte signed
- * - [4] Wheel (-127~127) - 1 byte signed
- * - [5] Horizontal Wheel (-127~127) - 1 byte signed
+ * - [4-5] Wheel (-32767~32767) - 2 bytes signed
+ * - [6-7] AC Pan / 수평 휠 (-32767~32767) - 2 bytes signed
+ *
+ * Feature 리포트 (1바이트 + Report ID):
+ * - bit0-1: 수직 휠 Resolution Multiplier (0=1x, 1=HID_WHEEL_UNITS_PER_DETENT x)
+ * - bit2-3: 수평 휠 Resolution Multiplier
+ * - bit4-7: 패딩
  *
- * TUD_HID_REPORT_DESC_MOUSE(HID_REPORT_ID(2)): Report ID 포함 및 Boot Protocol 표준 준수
+ * Windows/Linux는 열거 시 Feature 리포트로 배율을 1로 설정하고, 이후 휠/AC Pan
+ * 값을 1/120 디텐트 단위로 해석합니다. 배율을 설정하지 않는 호스트(BIOS 등)에는
+ * 디텐트 단위로 보냅니다 (hid_handler.c sendMouseReportHiRes()).
  *
+ * 앞 3바이트(buttons, x, y)는 Boot Protocol Mouse와 동일하게 유지합니다.
  * 주의: hid_handler.c에서 Report ID 2로 전송하므로 Descriptor에도 명시 필수
  */
 uint8_t const desc_hid_mouse_report[] = {
-    TUD_HID_REPORT_DESC_MOUSE(HID_REPORT_ID(2))
+    HID_USAGE_PAGE ( HID_USAGE_PAGE_DESKTOP      ),
+    HID_USAGE      ( HID_USAGE_DESKTOP_MOUSE     ),
+    HID_COLLECTION ( HID_COLLECTION_APPLICATION  ),
+        HID_REPORT_ID  ( 2 )
+        HID_USAGE      ( HID_USAGE_DESKTOP_POINTER ),
+        HID_COLLECTION ( HID_COLLECTION_PHYSICAL   ),
+            // 버튼 5개 + 3비트 패딩
+            HID_USAGE_PAGE   ( HID_USAGE_PAGE_BUTTON ),
+            HID_USAGE_MIN    ( 1 ),
+            HID_USAGE_MAX    ( 5 ),
+            HID_LOGICAL_MIN  ( 0 ),
+            HID_LOGICAL_MAX  ( 1 ),
+            HID_REPORT_COUNT ( 5 ),
+            HID_REPORT_SIZE  ( 1 ),
+            HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ),
+            HID_REPORT_COUNT ( 1 ),
+            HID_REPORT_SIZE  ( 3 ),
+            HID_INPUT        ( HID_CONSTANT ),
+
+            // X, Y (-127 ~ 127)
+            HID_USAGE_PAGE   ( HID_USAGE_PAGE_DESKTOP ),
+            HID_USAGE        ( HID_USAGE_DESKTOP_X ),
+            HID_USAGE        ( HID_USAGE_DESKTOP_Y ),
+            HID_LOGICAL_MIN  ( 0x81 ),
+            HID_LOGICAL_MAX  ( 0x7f ),
+            HID_REPORT_COUNT ( 2 ),
+            HID_REPORT_SIZE  ( 8 ),
+            HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_RELATIVE ),
+
+            // 수직 휠 + Resolution Multiplier (Feature bit0-1)
+            HID_COLLECTION ( HID_COLLECTION_LOGICAL ),
+                HID_USAGE        ( HID_USAGE_DESKTOP_RESOLUTION_MULTIPLIER ),
+                HID_LOGICAL_MIN  ( 0 ),
+                HID_LOGICAL_MAX  ( 1 ),
+                HID_PHYSICAL_MIN ( 1 ),
+                HID_PHYSICAL_MAX ( HID_WHEEL_UNITS_PER_DETENT ),
+                HID_REPORT_COUNT ( 1 ),
+                HID_REPORT_SIZE  ( 2 ),
+                HID_FEATURE      ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ),
+                HID_USAGE        ( HID_USAGE_DESKTOP_WHEEL ),
+                HID_LOGICAL_MIN_N( -32767, 2 ),
+                HID_LOGICAL_MAX_N( 32767, 2 ),
+                HID_PHYSICAL_MIN ( 0 ),
+                HID_PHYSICAL_MAX ( 0 ),
+                HID_REPORT_SIZE  ( 16 ),
+                HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_RELATIVE ),
+            HID_COLLECTION_END,
+
+            // 수평 휠(AC Pan) + Resolution Multiplier (Feature bit2-3)
+            HID_COLLECTION ( HID_COLLECTION_LOGICAL ),
+                HID_USAGE        ( HID_USAGE_DESKTOP_RESOLUTION_MULTIPLIER ),
+                HID_LOGICAL_MIN  ( 0 ),
+                HID_LOGICAL_MAX  ( 1 ),
+                HID_PHYSICAL_MIN ( 1 ),
+                HID_PHYSICAL_MAX ( HID_WHEEL_UNITS_PER_DETENT ),
+                HID_REPORT_SIZE  ( 2 ),
+                HID_FEATURE      ( HID_DATA | HID_VARIABLE | HID_ABSOLUTE ),
+                HID_PHYSICAL_MIN ( 0 ),
+                HID_PHYSICAL_MAX ( 0 ),
+                HID_USAGE_PAGE   ( HID_USAGE_PAGE_CONSUMER ),
+                HID_USAGE_N      ( HID_USAGE_CONSUMER_AC_PAN, 2 ),
+                HID_LOGICAL_MIN_N( -32767, 2 ),
+                HID_LOGICAL_MAX_N( 32767, 2 ),
+                HID_REPORT_SIZE  ( 16 ),
+                HID_INPUT        ( HID_DATA | HID_VARIABLE | HID_RELATIVE ),
+            HID_COLLECTION_END,
+
+            // Feature 패딩 (4비트)
+            HID_REPORT_SIZE  ( 4 ),
+            HID_FEATURE      ( HID_CONSTANT ),
+        HID_COLLECTION_END,
+    HID_COLLECTION_END
 };
 
 /**
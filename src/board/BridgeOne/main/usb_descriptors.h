@@ -100,6 +100,15 @@ extern uint8_t const desc_hid_mouse_report[];
 #define CFG_TUD_HID_EP_BUFSIZE      64
 #define CFG_TUD_CDC_EP_BUFSIZE      64
 
+// ==================== 고해상도 스크롤 ====================
+/**
+ * 휠 1디텐트당 고해상도 단위 수 (Resolution Multiplier 물리 최댓값)
+ *
+ * Windows 고해상도 휠 규약(WHEEL_DELTA = 120)과 같은 값입니다.
+ * Android BridgeFrame.WHEEL_UNITS_PER_DETENT와 일치해야 합니다.
+ */
+#define HID_WHEEL_UNITS_PER_DETENT  120
+
 // ==================== 외부 참조 선언 ====================
 // usb_descriptors.c에서 정의되는 디스크립터 배열
 extern tusb_desc_device_t const desc_device;
@@ -0,0 +1,83 @@
+/**
+ * @file vcdc_chunk.c
+ * @brief Vendor CDC 응답 작성 공용 도우미 구현
+ *
+ * 참조: vcdc_chunk.h
+ */
+
+#include "vcdc_chunk.h"
+#include "mem_alloc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+void vcdc_put_u32(uint8_t *dst, uint32_t v)
+{
+    dst[0] = (uint8_t)v;
+    dst[1] = (uint8_t)(v >> 8);
+    dst[2] = (uint8_t)(v >> 16);
+    dst[3] = (uint8_t)(v >> 24);
+}
+
+bool vcdc_chunk_dump_names(uint8_t kind, const uint32_t *handles, const char *const *names,
+                           size_t count, uint8_t *chunk, uint16_t max_chunk,
+                           vcdc_chunk_emit_fn emit, void *ctx)
+{
+    uint16_t len = 2;
+    chunk[0] = kind;
+    chunk[1] = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t name_len = strnlen(names[i], configMAX_TASK_NAME_LEN);
+        if (len + 5 + name_len > max_chunk || chunk[1] == UINT8_MAX) {
+            if (!emit(chunk, len, ctx)) {
+                return false;
+            }
+            len = 2;
+            chunk[1] = 0;
+        }
+        vcdc_put_u32(&chunk[len], handles[i]);
+        chunk[len + 4] = (uint8_t)name_len;
+        memcpy(&chunk[len + 5], names[i], name_len);
+        len += (uint16_t)(5 + name_len);
+        chunk[1]++;
+    }
+    return emit(chunk, len, ctx);
+}
+
+bool vcdc_chunk_dump_tasks(uint8_t kind, uint8_t *chunk, uint16_t max_chunk,
+                           vcdc_chunk_emit_fn emit, void *ctx)
+{
+    UBaseType_t capacity = uxTaskGetNumberOfTasks() + 2;
+    TaskStatus_t *status  = mem_arena_alloc(capacity * sizeof(TaskStatus_t));
+    uint32_t     *handles = mem_arena_alloc(capacity * sizeof(uint32_t));
+    const char  **names   = mem_arena_alloc(capacity * sizeof(const char *));
+    bool ok = false;
+
+    if (status != NULL && handles != NULL && names != NULL) {
+        UBaseType_t count = uxTaskGetSystemState(status, capacity, NULL);
+        for (UBaseType_t i = 0; i < count; i++) {
+            handles[i] = (uint32_t)status[i].xHandle;
+            names[i]   = status[i].pcTaskName;
+        }
+        ok = vcdc_chunk_dump_names(kind, handles, names, count, chunk, max_chunk, emit, ctx);
+    }
+
+    mem_arena_free(names);
+    mem_arena_free(handles);
+    mem_arena_free(status);
+    return ok;
+}
+
+void vcdc_json_append(char *buf, size_t cap, size_t *pos, const char *fmt, ...)
+{
+    if (*pos >= cap) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf + *pos, cap - *pos, fmt, args);
+    va_end(args);
+    *pos = (n < 0 || (size_t)n >= cap - *pos) ? cap : *pos + (size_t)n;
+}
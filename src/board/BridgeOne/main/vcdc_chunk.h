@@ -0,0 +1,61 @@
+/**
+ * @file vcdc_chunk.h
+ * @brief Vendor CDC 응답 작성 공용 도우미 (바이너리 청크, 압축 JSON)
+ *
+ * 트레이스/프로파일러/보고서 모듈이 같은 형식으로 응답을 만들 때 공유합니다.
+ * - vcdc_put_u32(): 청크 필드 Little-Endian 기록
+ * - vcdc_chunk_dump_names(), vcdc_chunk_dump_tasks(): (핸들, 이름) 표 청크
+ *   [kind][count] + count × ([handle u32][name_len u8][name])
+ * - vcdc_json_append(): 고정 버퍼에 snprintf 이어쓰기
+ *
+ * 사용처: trace_recorder.c, pc_profiler.c, input_trace.c, mem_report.c, task_profiler.c
+ */
+
+#ifndef VCDC_CHUNK_H
+#define VCDC_CHUNK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * 청크 전송 콜백 (청크 1개 = VCDC 프레임 1개).
+ * trace_emit_fn / pc_prof_emit_fn / input_trace_emit_fn과 같은 형식입니다.
+ *
+ * @return false면 전송을 중단합니다
+ */
+typedef bool (*vcdc_chunk_emit_fn)(const uint8_t *chunk, uint16_t len, void *ctx);
+
+/**
+ * 32비트 값을 Little-Endian으로 기록.
+ */
+void vcdc_put_u32(uint8_t *dst, uint32_t v);
+
+/**
+ * (핸들, 이름) 표를 kind 청크로 전송. 청크가 가득 차면(크기 또는 count 255) 같은 kind로 이어서 보냅니다.
+ *
+ * @param chunk     작업 버퍼 (max_chunk 바이트 이상)
+ * @param max_chunk 청크 최대 크기 (VCDC_MAX_PAYLOAD_SIZE)
+ * @return true: 모두 전달, false: 전송 중단
+ */
+bool vcdc_chunk_dump_names(uint8_t kind, const uint32_t *handles, const char *const *names,
+                           size_t count, uint8_t *chunk, uint16_t max_chunk,
+                           vcdc_chunk_emit_fn emit, void *ctx);
+
+/**
+ * 현재 태스크 표(핸들 → 이름)를 kind 청크로 전송 (VCDC 태스크 전용, 임시 버퍼는 아레나 사용).
+ * 종료된 태스크는 호스트가 핸들 값으로 표시합니다.
+ *
+ * @return true: 모두 전달, false: 할당 실패 또는 전송 중단
+ */
+bool vcdc_chunk_dump_tasks(uint8_t kind, uint8_t *chunk, uint16_t max_chunk,
+                           vcdc_chunk_emit_fn emit, void *ctx);
+
+/**
+ * snprintf 이어쓰기. 버퍼가 부족하면 *pos를 cap으로 만들어 이후 호출을 무시합니다.
+ * 호출자는 마지막에 *pos < cap인지 확인합니다.
+ */
+void vcdc_json_append(char *buf, size_t cap, size_t *pos, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+#endif // VCDC_CHUNK_H
@@ -0,0 +1,305 @@
+/**
+ * @file vcdc_rx.c
+ * @brief Vendor CDC 수신 파서 구현
+ *
+ * CRC16 알고리즘은 Windows 서버의 C# 구현과 동일합니다:
+ * - 다항식: 0x1021
+ * - 초기값: 0x0000
+ * - 계산 범위: payload만
+ *
+ * 참조:
+ * - docs/windows/technical-specification-server.md §2.3.3 (C# 참조 구현)
+ */
+
+#include "vcdc_rx.h"
+
+/**
+ * CRC16-CCITT 계산 함수.
+ *
+ * Windows 서버 C# 구현의 정확한 포팅:
+ *   ushort crc = 0;
+ *   crc ^= (ushort)(data[i] << 8);
+ *   if ((crc & 0x8000) != 0) crc = (ushort)((crc << 1) ^ 0x1021);
+ *   else crc <<= 1;
+ */
+uint16_t vendor_cdc_crc16(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0x0000;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (int j = 0; j < 8; j++) {
+            if (crc & 0x8000) {
+                crc = (crc << 1) ^ 0x1021;
+            } else {
+                crc <<= 1;
+            }
+        }
+    }
+
+    return crc;
+}
+
+// ==================== 파서 상태 ====================
+
+/** 파싱 상태 정의 */
+typedef enum {
+    VCDC_PARSE_WAIT_HEADER,     // 0xFF 헤더 바이트 대기
+    VCDC_PARSE_READ_COMMAND,    // 명령 코드 1바이트 읽기
+    VCDC_PARSE_READ_LENGTH,     // 길이 2바이트 읽기 (Little-Endian)
+    VCDC_PARSE_READ_PAYLOAD,    // 페이로드 읽기
+    VCDC_PARSE_READ_CRC,        // CRC16 2바이트 읽기 (Little-Endian)
+} vcdc_parse_state_t;
+
+/** 파싱 컨텍스트 (정적 할당, 동적 할당 금지) */
+typedef struct {
+    vcdc_parse_state_t state;
+    uint8_t  command;
+    uint16_t payload_len;
+    uint16_t payload_received;
+    int8_t   buf_idx;               // 페이로드를 조립 중인 버퍼 인덱스 (-1: 없음)
+    uint8_t *buf;                   // 조립 버퍼 (buf_idx >= 0일 때)
+    uint8_t  length_buf[2];
+    uint8_t  length_bytes_read;
+    uint8_t  crc_buf[2];
+    uint8_t  crc_bytes_read;
+    int64_t  last_byte_time_us;     // 마지막 바이트 수신 시각 (us)
+
+    // 제자리 파싱: 미완성 프레임이 RX FIFO에 남아 있는 동안 마지막으로 바이트가 도착한 시각
+    bool     in_place_pending;
+    int64_t  in_place_last_rx_us;
+} vcdc_rx_ctx_t;
+
+static vcdc_rx_ctx_t s_ctx = { .buf_idx = -1 };
+
+/**
+ * 바이트 단위 상태 머신을 초기 상태(WAIT_HEADER)로 리셋.
+ * 조립 중이던 버퍼가 있으면 반납합니다.
+ */
+static void parser_state_reset(void)
+{
+    if (s_ctx.buf_idx >= 0) {
+        vcdc_rx_release_cb(s_ctx.buf_idx);
+    }
+    s_ctx.buf_idx           = -1;
+    s_ctx.buf               = NULL;
+    s_ctx.state             = VCDC_PARSE_WAIT_HEADER;
+    s_ctx.payload_received  = 0;
+    s_ctx.length_bytes_read = 0;
+    s_ctx.crc_bytes_read    = 0;
+    s_ctx.last_byte_time_us = 0;
+}
+
+void vcdc_rx_reset(void)
+{
+    parser_state_reset();
+    s_ctx.in_place_pending = false;
+}
+
+bool vcdc_rx_is_active(void)
+{
+    return s_ctx.state != VCDC_PARSE_WAIT_HEADER;
+}
+
+size_t vcdc_rx_static_ram_bytes(void)
+{
+    return sizeof(s_ctx);
+}
+
+/**
+ * 수신 완료된 프레임의 CRC16을 검증하고 전달.
+ * 바이트 단위 상태 머신과 제자리 파싱 경로가 공유합니다.
+ *
+ * @param idx 페이로드가 조립된 버퍼 인덱스 (-1: FIFO 메모리).
+ *            성공/실패와 관계없이 이 함수가 소유권을 가져갑니다.
+ */
+static void complete_frame(uint8_t command, const uint8_t *payload, uint16_t payload_len,
+                           uint16_t received_crc, int8_t idx)
+{
+    // CRC16 검증 (계산 범위: payload만)
+    uint16_t computed_crc = vendor_cdc_crc16(payload, payload_len);
+
+    if (received_crc != computed_crc) {
+        vcdc_rx_error_cb(VCDC_RX_ERR_CRC, command, ((uint32_t)received_crc << 16) | computed_crc);
+        if (idx >= 0) {
+            vcdc_rx_release_cb(idx);
+        }
+        return;
+    }
+
+    vcdc_rx_frame_cb(command, payload, payload_len, received_crc, idx);
+}
+
+// ==================== 바이트 단위 상태 머신 ====================
+
+void vcdc_rx_feed(const uint8_t *data, uint32_t len, int64_t now_us)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        uint8_t byte = data[i];
+
+        // 타임아웃 검사: 프레임 수신 중 500ms 이상 데이터 없으면 리셋
+        if (s_ctx.state != VCDC_PARSE_WAIT_HEADER &&
+            (now_us - s_ctx.last_byte_time_us) > VCDC_RX_TIMEOUT_US) {
+            vcdc_rx_error_cb(VCDC_RX_ERR_TIMEOUT, s_ctx.command, s_ctx.payload_received);
+            parser_state_reset();
+        }
+
+        s_ctx.last_byte_time_us = now_us;
+
+        switch (s_ctx.state) {
+
+        case VCDC_PARSE_WAIT_HEADER:
+            if (byte == VCDC_FRAME_HEADER) {
+                s_ctx.state = VCDC_PARSE_READ_COMMAND;
+            }
+            // 0xFF가 아닌 바이트는 무시 (디버그 텍스트로 간주)
+            break;
+
+        case VCDC_PARSE_READ_COMMAND:
+            s_ctx.command = byte;
+            s_ctx.state = VCDC_PARSE_READ_LENGTH;
+            s_ctx.length_bytes_read = 0;
+            break;
+
+        case VCDC_PARSE_READ_LENGTH:
+            s_ctx.length_buf[s_ctx.length_bytes_read++] = byte;
+
+            if (s_ctx.length_bytes_read >= 2) {
+                // Little-Endian으로 length 조립
+                s_ctx.payload_len = (uint16_t)(s_ctx.length_buf[0] | (s_ctx.length_buf[1] << 8));
+
+                // 페이로드 크기 검증
+                if (s_ctx.payload_len > VCDC_MAX_PAYLOAD_SIZE) {
+                    vcdc_rx_error_cb(VCDC_RX_ERR_TOO_LARGE, s_ctx.command, s_ctx.payload_len);
+                    parser_state_reset();
+                    break;
+                }
+
+                if (s_ctx.payload_len == 0) {
+                    // 페이로드 없는 프레임: 바로 CRC 읽기
+                    s_ctx.state = VCDC_PARSE_READ_CRC;
+                    s_ctx.crc_bytes_read = 0;
+                } else {
+                    // 페이로드는 확보한 버퍼에 바로 조립 (없으면 읽고 버림 → CRC 단계에서 폐기)
+                    s_ctx.buf_idx = vcdc_rx_acquire_cb(&s_ctx.buf);
+                    s_ctx.state = VCDC_PARSE_READ_PAYLOAD;
+                    s_ctx.payload_received = 0;
+                }
+            }
+            break;
+
+        case VCDC_PARSE_READ_PAYLOAD:
+            if (s_ctx.buf_idx >= 0) {
+                s_ctx.buf[s_ctx.payload_received] = byte;
+            }
+            s_ctx.payload_received++;
+
+            if (s_ctx.payload_received >= s_ctx.payload_len) {
+                s_ctx.state = VCDC_PARSE_READ_CRC;
+                s_ctx.crc_bytes_read = 0;
+            }
+            break;
+
+        case VCDC_PARSE_READ_CRC:
+            s_ctx.crc_buf[s_ctx.crc_bytes_read++] = byte;
+
+            if (s_ctx.crc_bytes_read >= 2) {
+                // Little-Endian으로 CRC 조립
+                uint16_t received_crc = (uint16_t)(s_ctx.crc_buf[0] | (s_ctx.crc_buf[1] << 8));
+
+                if (s_ctx.payload_len > 0 && s_ctx.buf_idx < 0) {
+                    vcdc_rx_error_cb(VCDC_RX_ERR_NO_BUFFER, s_ctx.command, s_ctx.payload_len);
+                } else {
+                    complete_frame(s_ctx.command, s_ctx.buf, s_ctx.payload_len, received_crc,
+                                   s_ctx.buf_idx);
+                    s_ctx.buf_idx = -1;     // 소유권 이전
+                }
+                parser_state_reset();
+            }
+            break;
+        }
+    }
+}
+
+// ==================== 제자리 파싱 ====================
+
+/**
+ * 헤더(0xFF)로 시작하는 연속 구간에서 프레임을 제자리 파싱.
+ *
+ * @return 소비한 바이트 수. 0이면 프레임이 아직 다 도착하지 않았으므로
+ *         FIFO에 남겨두고 다음 수신 시 같은 위치부터 다시 호출합니다.
+ */
+static uint32_t parse_in_place(const uint8_t *data, uint32_t len, bool span_continues, int64_t now_us)
+{
+    // 미완성 프레임을 남겨둔 뒤 500ms 넘게 아무것도 오지 않다가 이제 새 바이트가 도착:
+    // 잘린 프레임이나 떠돌이 0xFF로 보고 헤더만 버려 다음 바이트부터 재동기화.
+    // RX 콜백은 바이트가 도착할 때만 불리므로 비교 기준은 직전 도착 시각입니다.
+    if (s_ctx.in_place_pending) {
+        s_ctx.in_place_pending = false;
+        if ((now_us - s_ctx.in_place_last_rx_us) > VCDC_RX_TIMEOUT_US) {
+            vcdc_rx_error_cb(VCDC_RX_ERR_TIMEOUT, (len >= 2) ? data[1] : 0, len);
+            return 1;
+        }
+    }
+
+    // Header(1) + Command(1) + Length(2)를 읽을 수 있으면 프레임 길이 확인
+    if (len >= 4) {
+        uint16_t payload_len = (uint16_t)(data[2] | (data[3] << 8));
+
+        if (payload_len > VCDC_MAX_PAYLOAD_SIZE) {
+            vcdc_rx_error_cb(VCDC_RX_ERR_TOO_LARGE, data[1], payload_len);
+            return 1;   // 헤더만 건너뜀
+        }
+
+        uint32_t frame_len = VCDC_FRAME_OVERHEAD + payload_len;
+        if (len >= frame_len) {
+            // 프레임 전체가 연속 구간 안에 있음: FIFO 메모리에서 바로 CRC 검증
+            uint16_t received_crc = (uint16_t)(data[4 + payload_len] | (data[5 + payload_len] << 8));
+            complete_frame(data[1], &data[4], payload_len, received_crc, -1);
+            return frame_len;
+        }
+    }
+
+    // FIFO 래핑 경계에 걸친 프레임: 구간 나머지는 모두 이 프레임의 바이트이므로 상태 머신으로 이어서 처리
+    if (span_continues) {
+        vcdc_rx_feed(data, len, now_us);
+        return len;
+    }
+
+    // 아직 다 도착하지 않음: 소비하지 않고 다음 수신 시 처음부터 다시 파싱
+    s_ctx.in_place_pending    = true;
+    s_ctx.in_place_last_rx_us = now_us;
+    return 0;
+}
+
+uint32_t vcdc_rx_process_span(const uint8_t *data, uint32_t len, bool span_continues, int64_t now_us)
+{
+    uint32_t i = 0;
+
+    while (i < len) {
+        uint8_t byte = data[i];
+
+        // 래핑 경계에 걸친 프레임 수신 중: 바이트 단위 상태 머신으로 이어서 처리
+        if (vcdc_rx_is_active()) {
+            vcdc_rx_feed(&byte, 1, now_us);
+            i++;
+            continue;
+        }
+
+        // 0xFF로 새 프레임 시작: FIFO에서 바로 파싱
+        if (byte == VCDC_FRAME_HEADER) {
+            uint32_t used = parse_in_place(&data[i], len - i, span_continues, now_us);
+            if (used == 0) {
+                return i;   // 프레임 나머지 수신 대기
+            }
+            i += used;
+            continue;
+        }
+
+        // 텍스트 명령 바이트
+        vcdc_rx_text_cb(byte);
+        i++;
+    }
+
+    return len;
+}
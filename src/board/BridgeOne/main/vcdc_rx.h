@@ -0,0 +1,137 @@
+/**
+ * @file vcdc_rx.h
+ * @brief Vendor CDC 수신 파서 - CDC RX FIFO 구간 분류와 프레임 파싱
+ *
+ * 역할:
+ * - tud_cdc_rx_cb()가 넘긴 RX FIFO 구간에서 텍스트 명령 바이트와 바이너리 프레임(0xFF 시작)을 분류
+ * - 프레임 전체가 연속 구간 안에 있으면 FIFO 메모리에서 바로(in-place) CRC16 검증
+ * - FIFO 래핑 경계에 걸친 프레임은 바이트 단위 상태 머신으로 조립
+ * - 미완성 프레임은 FIFO에 남겨두고, 500ms 동안 이어지지 않으면 헤더를 버리고 재동기화
+ *
+ * 이 모듈은 ESP-IDF API에 의존하지 않으므로 호스트에서 단위 테스트/벤치마크합니다 (test/host/).
+ * 시각은 호출자가 넘기고, 프레임 버퍼와 결과 처리는 아래 콜백이 맡습니다
+ * (TinyUSB의 tud_*_cb와 같은 링크 시점 콜백. 펌웨어: vendor_cdc_handler.c, usb_cdc_log.c).
+ */
+
+#ifndef VCDC_RX_H
+#define VCDC_RX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ==================== 프레임 상수 ====================
+
+/** Vendor CDC 프레임 헤더 바이트 (텍스트 명령과 구분용) */
+#define VCDC_FRAME_HEADER       0xFF
+
+/** 최대 페이로드 크기 (바이트) */
+#define VCDC_MAX_PAYLOAD_SIZE   448
+
+/** 프레임 오버헤드: header(1) + command(1) + length(2) + crc16(2) = 6바이트 */
+#define VCDC_FRAME_OVERHEAD     6
+
+/** 최대 프레임 크기: 오버헤드 + 최대 페이로드 = 454바이트 */
+#define VCDC_MAX_FRAME_SIZE     (VCDC_FRAME_OVERHEAD + VCDC_MAX_PAYLOAD_SIZE)
+
+/** 파싱 타임아웃: 프레임 수신 중 500ms 이상 데이터 없으면 리셋 */
+#define VCDC_RX_TIMEOUT_US      (500 * 1000)
+
+/** 수신 오류 종류 (vcdc_rx_error_cb) */
+typedef enum {
+    VCDC_RX_ERR_CRC,            // CRC 불일치 (arg: 받은 CRC << 16 | 계산한 CRC)
+    VCDC_RX_ERR_TOO_LARGE,      // 길이 필드가 최대 페이로드 초과 (arg: 길이)
+    VCDC_RX_ERR_TIMEOUT,        // 프레임이 500ms 동안 이어지지 않음 (arg: 받은 바이트 수)
+    VCDC_RX_ERR_NO_BUFFER,      // 래핑 경계 프레임을 조립할 버퍼 없음 (arg: 길이)
+} vcdc_rx_error_t;
+
+// ==================== 함수 선언 ====================
+
+/**
+ * CRC16-CCITT 계산 함수.
+ *
+ * Windows 서버의 C# 구현과 동일한 알고리즘입니다.
+ * 다항식: 0x1021, 초기값: 0x0000
+ *
+ * @param data 계산 대상 데이터 (payload만)
+ * @param length 데이터 길이
+ * @return CRC16 값
+ */
+uint16_t vendor_cdc_crc16(const uint8_t *data, size_t length);
+
+/**
+ * RX FIFO의 연속 구간 하나를 처리.
+ *
+ * 텍스트 바이트는 vcdc_rx_text_cb()로, 검증된 프레임은 vcdc_rx_frame_cb()로 넘깁니다.
+ *
+ * @param data 구간 시작 (FIFO 메모리)
+ * @param len 구간 길이
+ * @param span_continues true: 뒤에 래핑 영역 데이터가 이어짐
+ * @param now_us 현재 시각 (us, 단조 증가)
+ * @return 소비한 바이트 수. len보다 작으면 나머지는 미완성 프레임이므로
+ *         FIFO에 남겨두고 다음 수신 시 그 위치부터 다시 넘깁니다.
+ */
+uint32_t vcdc_rx_process_span(const uint8_t *data, uint32_t len, bool span_continues, int64_t now_us);
+
+/**
+ * 바이트 스트림을 바이트 단위 상태 머신에 공급.
+ *
+ * 상태 머신 흐름:
+ * WAIT_HEADER → READ_COMMAND → READ_LENGTH → READ_PAYLOAD → READ_CRC → (전달 후 리셋)
+ *
+ * @param data 수신된 바이트 버퍼
+ * @param len 바이트 수
+ * @param now_us 현재 시각 (us)
+ */
+void vcdc_rx_feed(const uint8_t *data, uint32_t len, int64_t now_us);
+
+/**
+ * 파서 상태 리셋 (조립 중이던 버퍼 반납, 미완성 프레임 대기 해제).
+ */
+void vcdc_rx_reset(void);
+
+/**
+ * 바이트 단위 상태 머신이 프레임을 조립 중인지 확인.
+ */
+bool vcdc_rx_is_active(void);
+
+/**
+ * 파서 컨텍스트의 정적 RAM 크기 (메모리 보고서용).
+ */
+size_t vcdc_rx_static_ram_bytes(void);
+
+// ==================== 콜백 (사용하는 쪽에서 구현) ====================
+
+/**
+ * 바이트 단위 경로의 페이로드 조립 버퍼 확보.
+ *
+ * @param payload 버퍼 주소 (VCDC_MAX_PAYLOAD_SIZE 이상)
+ * @return 버퍼 인덱스, 없으면 -1 (페이로드를 읽고 버린 뒤 VCDC_RX_ERR_NO_BUFFER)
+ */
+int8_t vcdc_rx_acquire_cb(uint8_t **payload);
+
+/**
+ * 확보한 버퍼를 프레임 전달 없이 반납 (리셋/오류).
+ */
+void vcdc_rx_release_cb(int8_t idx);
+
+/**
+ * CRC16 검증을 통과한 프레임.
+ *
+ * @param payload 페이로드 위치 (idx >= 0: 확보한 버퍼, idx < 0: RX FIFO 메모리)
+ * @param idx 확보한 버퍼 인덱스 (-1: 제자리 파싱). 콜백이 소유권을 가져갑니다.
+ */
+void vcdc_rx_frame_cb(uint8_t command, const uint8_t *payload, uint16_t payload_len,
+                      uint16_t crc16, int8_t idx);
+
+/**
+ * 수신 오류 (로그/오류 응답용).
+ */
+void vcdc_rx_error_cb(vcdc_rx_error_t error, uint8_t command, uint32_t arg);
+
+/**
+ * 프레임에 속하지 않는 텍스트 바이트.
+ */
+void vcdc_rx_text_cb(uint8_t byte);
+
+#endif // VCDC_RX_H
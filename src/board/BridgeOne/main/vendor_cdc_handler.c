@@ -16,6 +16,13 @@
 
 #include "vendor_cdc_handler.h"
 #include "connection_state.h"
+#include "macro_engine.h"
+#include "mem_report.h"
+#include "mem_alloc.h"
+#include "task_profiler.h"
+#include "pc_profiler.h"
+#include "trace_recorder.h"
+#include "input_trace.h"
 #include "tusb.h"
 #include "esp_log.h"
 #include "esp_timer.h"
@@ -32,30 +39,26 @@ static int64_t s_last_ping_time_us = 0;
 #define KEEPALIVE_TIMEOUT_US  (3 * 1000 * 1000)
 
 /**
- * CRC16-CCITT 계산 함수.
- *
- * Windows 서버 C# 구현의 정확한 포팅:
- *   ushort crc = 0;
- *   crc ^= (ushort)(data[i] << 8);
- *   if ((crc & 0x8000) != 0) crc = (ushort)((crc << 1) ^ 0x1021);
- *   else crc <<= 1;
+ * TX FIFO 예약 영역(선형 + 래핑) 순차 기록용 커서.
+ * tud_cdc_write_reserve()가 돌려준 두 영역을 하나의 연속 버퍼처럼 채웁니다.
  */
-uint16_t vendor_cdc_crc16(const uint8_t *data, size_t length)
+typedef struct {
+    tu_fifo_buffer_info_t info;
+    uint32_t pos;
+} tx_region_cursor_t;
+
+static void tx_region_put(tx_region_cursor_t *cur, const uint8_t *src, uint32_t len)
 {
-    uint16_t crc = 0x0000;
+    uint32_t lin_left = (cur->pos < cur->info.len_lin) ? (cur->info.len_lin - cur->pos) : 0;
+    uint32_t n = (len < lin_left) ? len : lin_left;
 
-    for (size_t i = 0; i < length; i++) {
-        crc ^= (uint16_t)(data[i] << 8);
-        for (int j = 0; j < 8; j++) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ 0x1021;
-            } else {
-                crc <<= 1;
-            }
-        }
+    if (n > 0) {
+        memcpy((uint8_t *)cur->info.ptr_lin + cur->pos, src, n);
     }
-
-    return crc;
+    if (len > n) {
+        memcpy((uint8_t *)cur->info.ptr_wrap + (cur->pos + n - cur->info.len_lin), src + n, len - n);
+    }
+    cur->pos += len;
 }
 
 bool vendor_cdc_send_frame(uint8_t command, const uint8_t *payload, uint16_t payload_len)
@@ -72,34 +75,10 @@ bool vendor_cdc_send_frame(uint8_t command, const uint8_t *payload, uint16_t pay
         return false;
     }
 
-    // 프레임 조립용 버퍼 (정적 할당, 임베디드 환경 안정성)
-    uint8_t frame_buf[VCDC_MAX_FRAME_SIZE];
-    uint16_t frame_len = 0;
-
-    // Header (1B)
-    frame_buf[frame_len++] = VCDC_FRAME_HEADER;
-
-    // Command (1B)
-    frame_buf[frame_len++] = command;
+    uint16_t frame_len = (uint16_t)(VCDC_FRAME_OVERHEAD + payload_len);
 
-    // Length (2B, Little-Endian)
-    frame_buf[frame_len++] = (uint8_t)(payload_len & 0xFF);
-    frame_buf[frame_len++] = (uint8_t)((payload_len >> 8) & 0xFF);
-
-    // Payload (0~448B)
-    if (payload != NULL && payload_len > 0) {
-        memcpy(&frame_buf[frame_len], payload, payload_len);
-        frame_len += payload_len;
-    }
-
-    // CRC16 계산 (payload만 대상)
-    uint16_t crc = vendor_cdc_crc16(payload, payload_len);
-
-    // CRC16 (2B, Little-Endian)
-    frame_buf[frame_len++] = (uint8_t)(crc & 0xFF);
-    frame_buf[frame_len++] = (uint8_t)((crc >> 8) & 0xFF);
-
-    // CDC TX FIFO 가용 공간 확인 (부족 시 최대 20ms 대기)
+    // CDC TX FIFO 가용 공간 확인 (부족 시 최대 20ms 대기).
+    // 예약은 FIFO 쓰기 잠금을 잡으므로 대기는 반드시 예약 전에 끝냅니다.
     uint32_t available = tud_cdc_write_available();
     if (available < frame_len) {
         tud_cdc_write_flush();
@@ -114,8 +93,40 @@ bool vendor_cdc_send_frame(uint8_t command, const uint8_t *payload, uint16_t pay
         }
     }
 
+    // FIFO 빈 공간에 프레임을 직접 직렬화 (스택 프레임 버퍼/중간 복사 없음)
+    tx_region_cursor_t cur = { .pos = 0 };
+    uint32_t reserved = tud_cdc_write_reserve(frame_len, &cur.info);
+    if (reserved < frame_len) {
+        // 대기 후 다른 태스크(로그)가 공간을 차지한 경우
+        tud_cdc_write_commit(0);
+        ESP_LOGW(TAG, "TX FIFO reserve failed: %lu/%u bytes (cmd=0x%02X)",
+                 (unsigned long)reserved, frame_len, command);
+        return false;
+    }
+
+    // CRC16 계산 (payload만 대상)
+    uint16_t crc = vendor_cdc_crc16(payload, payload_len);
+
+    // Header (1B) + Command (1B) + Length (2B, Little-Endian)
+    const uint8_t head[4] = {
+        VCDC_FRAME_HEADER,
+        command,
+        (uint8_t)(payload_len & 0xFF),
+        (uint8_t)((payload_len >> 8) & 0xFF),
+    };
+    tx_region_put(&cur, head, sizeof(head));
+
+    // Payload (0~448B)
+    if (payload != NULL && payload_len > 0) {
+        tx_region_put(&cur, payload, payload_len);
+    }
+
+    // CRC16 (2B, Little-Endian)
+    const uint8_t tail[2] = { (uint8_t)(crc & 0xFF), (uint8_t)((crc >> 8) & 0xFF) };
+    tx_region_put(&cur, tail, sizeof(tail));
+
     // CDC 전송
-    uint32_t written = tud_cdc_write(frame_buf, frame_len);
+    uint32_t written = tud_cdc_write_commit(frame_len);
     tud_cdc_write_flush();
 
     if (written != frame_len) {
@@ -130,217 +141,157 @@ bool vendor_cdc_send_frame(uint8_t command, const uint8_t *payload, uint16_t pay
     return true;
 }
 
-// ==================== 프레임 파싱 상태 머신 ====================
+// ==================== 프레임 파싱 (vcdc_rx.c 콜백) ====================
 
-/** 파싱 상태 정의 */
-typedef enum {
-    VCDC_PARSE_WAIT_HEADER,     // 0xFF 헤더 바이트 대기
-    VCDC_PARSE_READ_COMMAND,    // command 바이트 1개 읽기
-    VCDC_PARSE_READ_LENGTH,     // length 2바이트 읽기 (Little-Endian)
-    VCDC_PARSE_READ_PAYLOAD,    // payload 읽기 (length만큼)
-    VCDC_PARSE_READ_CRC,        // CRC16 2바이트 읽기 (Little-Endian)
-} vcdc_parse_state_t;
+/** 프레임 풀 크기: 파서 조립 중 1 + VCDC 태스크 처리 중 1 + 처리 대기 2 */
+#define VCDC_FRAME_POOL_SIZE    4
 
-/** 파싱 컨텍스트 (정적 할당, 동적 할당 금지) */
-typedef struct {
-    vcdc_parse_state_t state;
-    uint8_t  command;
-    uint16_t payload_len;
-    uint16_t payload_received;
-    uint8_t  payload[VCDC_MAX_PAYLOAD_SIZE + 1]; // +1: JSON null 종료용
-    uint8_t  length_buf[2];
-    uint8_t  length_bytes_read;
-    uint8_t  crc_buf[2];
-    uint8_t  crc_bytes_read;
-    int64_t  last_byte_time_us;     // 마지막 바이트 수신 시각 (us)
-} vcdc_parser_ctx_t;
-
-/** 파싱 타임아웃: 프레임 수신 중 500ms 이상 데이터 없으면 리셋 */
-#define VCDC_PARSE_TIMEOUT_US   (500 * 1000)
-
-/** 파싱된 프레임 큐 크기 */
-#define VCDC_FRAME_QUEUE_SIZE   5
-
-/** FreeRTOS 큐 핸들 (외부에서 vendor_cdc_task가 수신 대기) */
+/**
+ * 프레임 풀 (정적 할당).
+ *
+ * 파서는 페이로드를 풀 프레임에 바로 조립하고, 큐로는 인덱스(1바이트)만 넘깁니다.
+ * VCDC 태스크는 처리가 끝나면 인덱스를 빈 목록으로 돌려줍니다.
+ * 이전 구조(파서 버퍼 449B + 큐 아이템 5 × 456B + 태스크 스택 복사본 456B)의
+ * 프레임 사본 3개를 없애고 풀 4개로 줄였습니다.
+ */
+static vendor_cdc_frame_t s_frame_pool[VCDC_FRAME_POOL_SIZE];
+
+/** 빈 프레임 인덱스 목록 (uint8_t) */
+static QueueHandle_t s_frame_free_queue = NULL;
+
+/** 수신 완료 프레임 인덱스 큐 (외부에서 vendor_cdc_task가 수신 대기) */
 QueueHandle_t vendor_cdc_frame_queue = NULL;
 
-/** 파서 컨텍스트 (정적 할당) */
-static vcdc_parser_ctx_t parser_ctx;
+/**
+ * 빈 프레임 하나를 가져옴 (대기 없음).
+ *
+ * @return 풀 인덱스, 남은 프레임이 없으면 -1
+ */
+static int8_t frame_pool_acquire(void)
+{
+    uint8_t idx;
+    if (s_frame_free_queue == NULL || xQueueReceive(s_frame_free_queue, &idx, 0) != pdTRUE) {
+        return -1;
+    }
+    return (int8_t)idx;
+}
 
 /**
- * 파서 상태를 초기 상태(WAIT_HEADER)로 리셋.
+ * 프레임을 풀에 반납.
  */
-static void parser_state_reset(void)
+static void frame_pool_release(int8_t idx)
 {
-    parser_ctx.state              = VCDC_PARSE_WAIT_HEADER;
-    parser_ctx.payload_received   = 0;
-    parser_ctx.length_bytes_read  = 0;
-    parser_ctx.crc_bytes_read     = 0;
-    parser_ctx.last_byte_time_us  = 0;
+    if (idx >= 0) {
+        uint8_t item = (uint8_t)idx;
+        xQueueSend(s_frame_free_queue, &item, 0);
+    }
 }
 
 bool vendor_cdc_parser_init(void)
 {
-    parser_state_reset();
+    vendor_cdc_frame_queue = xQueueCreate(VCDC_FRAME_POOL_SIZE, sizeof(uint8_t));
+    s_frame_free_queue     = xQueueCreate(VCDC_FRAME_POOL_SIZE, sizeof(uint8_t));
 
-    vendor_cdc_frame_queue = xQueueCreate(
-        VCDC_FRAME_QUEUE_SIZE,
-        sizeof(vendor_cdc_frame_t)
-    );
-
-    if (vendor_cdc_frame_queue == NULL) {
-        ESP_LOGE(TAG, "Failed to create vendor CDC frame queue");
+    if (vendor_cdc_frame_queue == NULL || s_frame_free_queue == NULL) {
+        ESP_LOGE(TAG, "Failed to create vendor CDC frame queues");
         return false;
     }
 
-    ESP_LOGI(TAG, "Vendor CDC parser initialized (queue_size=%d, frame_size=%u)",
-             VCDC_FRAME_QUEUE_SIZE, (unsigned)sizeof(vendor_cdc_frame_t));
+    for (uint8_t i = 0; i < VCDC_FRAME_POOL_SIZE; i++) {
+        xQueueSend(s_frame_free_queue, &i, 0);
+    }
+
+    vcdc_rx_reset();
+
+    ESP_LOGI(TAG, "Vendor CDC parser initialized (pool=%d x %u bytes)",
+             VCDC_FRAME_POOL_SIZE, (unsigned)sizeof(vendor_cdc_frame_t));
     return true;
 }
 
+size_t vendor_cdc_static_ram_bytes(void)
+{
+    return sizeof(s_frame_pool) + vcdc_rx_static_ram_bytes();
+}
+
 void vendor_cdc_parser_reset(void)
 {
-    if (parser_ctx.state != VCDC_PARSE_WAIT_HEADER) {
-        ESP_LOGW(TAG, "Parser reset (was in state %d)", parser_ctx.state);
+    if (vcdc_rx_is_active()) {
+        ESP_LOGW(TAG, "Parser reset while assembling a frame");
     }
-    parser_state_reset();
+    vcdc_rx_reset();
 }
 
-bool vendor_cdc_parser_is_active(void)
+int8_t vcdc_rx_acquire_cb(uint8_t **payload)
 {
-    return parser_ctx.state != VCDC_PARSE_WAIT_HEADER;
+    int8_t idx = frame_pool_acquire();
+    *payload = (idx >= 0) ? s_frame_pool[idx].payload : NULL;
+    return idx;
 }
 
-void vendor_cdc_parser_feed(const uint8_t *data, uint32_t len)
+void vcdc_rx_release_cb(int8_t idx)
 {
-    for (uint32_t i = 0; i < len; i++) {
-        uint8_t byte = data[i];
-        int64_t now  = esp_timer_get_time();
+    frame_pool_release(idx);
+}
 
-        // 타임아웃 검사: 프레임 수신 중 500ms 이상 데이터 없으면 리셋
-        if (parser_ctx.state != VCDC_PARSE_WAIT_HEADER &&
-            parser_ctx.last_byte_time_us > 0) {
-            if ((now - parser_ctx.last_byte_time_us) > VCDC_PARSE_TIMEOUT_US) {
-                ESP_LOGW(TAG, "Parse timeout in state %d, resetting", parser_ctx.state);
-                parser_state_reset();
-            }
+void vcdc_rx_frame_cb(uint8_t command, const uint8_t *payload, uint16_t payload_len,
+                      uint16_t crc16, int8_t idx)
+{
+    // 제자리 파싱 경로는 여기서 풀 프레임으로 복사
+    if (idx < 0) {
+        idx = frame_pool_acquire();
+        if (idx < 0) {
+            ESP_LOGW(TAG, "Frame pool exhausted, dropped (cmd=0x%02X)", command);
+            return;
         }
+        if (payload_len > 0) {
+            memcpy(s_frame_pool[idx].payload, payload, payload_len);
+        }
+    }
 
-        parser_ctx.last_byte_time_us = now;
-
-        switch (parser_ctx.state) {
-
-        case VCDC_PARSE_WAIT_HEADER:
-            if (byte == VCDC_FRAME_HEADER) {
-                parser_ctx.state = VCDC_PARSE_READ_COMMAND;
-            }
-            // 0xFF가 아닌 바이트는 무시 (디버그 텍스트로 간주)
-            break;
-
-        case VCDC_PARSE_READ_COMMAND:
-            parser_ctx.command = byte;
-            parser_ctx.state = VCDC_PARSE_READ_LENGTH;
-            parser_ctx.length_bytes_read = 0;
-            break;
-
-        case VCDC_PARSE_READ_LENGTH:
-            parser_ctx.length_buf[parser_ctx.length_bytes_read++] = byte;
-
-            if (parser_ctx.length_bytes_read >= 2) {
-                // Little-Endian으로 length 조립
-                parser_ctx.payload_len = (uint16_t)(
-                    parser_ctx.length_buf[0] |
-                    (parser_ctx.length_buf[1] << 8)
-                );
-
-                // 페이로드 크기 검증
-                if (parser_ctx.payload_len > VCDC_MAX_PAYLOAD_SIZE) {
-                    ESP_LOGE(TAG, "Payload too large: %u > %d, resetting",
-                             parser_ctx.payload_len, VCDC_MAX_PAYLOAD_SIZE);
-                    parser_state_reset();
-                    break;
-                }
-
-                if (parser_ctx.payload_len == 0) {
-                    // 페이로드 없는 프레임: 바로 CRC 읽기
-                    parser_ctx.state = VCDC_PARSE_READ_CRC;
-                    parser_ctx.crc_bytes_read = 0;
-                } else {
-                    parser_ctx.state = VCDC_PARSE_READ_PAYLOAD;
-                    parser_ctx.payload_received = 0;
-                }
-            }
-            break;
-
-        case VCDC_PARSE_READ_PAYLOAD:
-            parser_ctx.payload[parser_ctx.payload_received++] = byte;
+    vendor_cdc_frame_t *frame = &s_frame_pool[idx];
+    frame->header      = VCDC_FRAME_HEADER;
+    frame->command     = command;
+    frame->payload_len = payload_len;
+    frame->crc16       = crc16;
+
+    // FRAME_COMPLETE: 검증 성공한 프레임을 큐에 전달
+    uint8_t item = (uint8_t)idx;
+    task_probe_signal(TASK_PROBE_VCDC);
+    if (xQueueSend(vendor_cdc_frame_queue, &item, pdMS_TO_TICKS(10)) == pdPASS) {
+        ESP_LOGD(TAG, "Frame parsed OK: cmd=0x%02X, len=%u, crc=0x%04X",
+                 command, payload_len, crc16);
+    } else {
+        ESP_LOGW(TAG, "Frame queue full, dropped (cmd=0x%02X)", command);
+        frame_pool_release(idx);
+    }
+}
 
-            if (parser_ctx.payload_received >= parser_ctx.payload_len) {
-                parser_ctx.state = VCDC_PARSE_READ_CRC;
-                parser_ctx.crc_bytes_read = 0;
-            }
-            break;
-
-        case VCDC_PARSE_READ_CRC:
-            parser_ctx.crc_buf[parser_ctx.crc_bytes_read++] = byte;
-
-            if (parser_ctx.crc_bytes_read >= 2) {
-                // Little-Endian으로 CRC 조립
-                uint16_t received_crc = (uint16_t)(
-                    parser_ctx.crc_buf[0] |
-                    (parser_ctx.crc_buf[1] << 8)
-                );
-
-                // CRC16 검증 (계산 범위: payload만)
-                uint16_t computed_crc = vendor_cdc_crc16(
-                    parser_ctx.payload, parser_ctx.payload_len
-                );
-
-                if (received_crc != computed_crc) {
-                    ESP_LOGE(TAG, "CRC mismatch: recv=0x%04X, calc=0x%04X (cmd=0x%02X, len=%u)",
-                             received_crc, computed_crc,
-                             parser_ctx.command, parser_ctx.payload_len);
-
-                    // CRC 오류 응답 프레임 전송
-                    uint8_t err_payload[2] = {
-                        parser_ctx.command,  // 원래 명령 코드
-                        0x02                 // 에러 코드: CRC 불일치
-                    };
-                    vendor_cdc_send_frame(VCDC_CMD_ERROR, err_payload, sizeof(err_payload));
-
-                    parser_state_reset();
-                    break;
-                }
-
-                // FRAME_COMPLETE: 검증 성공한 프레임을 큐에 전달
-                vendor_cdc_frame_t frame;
-                frame.header      = VCDC_FRAME_HEADER;
-                frame.command     = parser_ctx.command;
-                frame.payload_len = parser_ctx.payload_len;
-                frame.crc16       = received_crc;
-
-                if (parser_ctx.payload_len > 0) {
-                    memcpy(frame.payload, parser_ctx.payload, parser_ctx.payload_len);
-                }
-
-                if (vendor_cdc_frame_queue != NULL) {
-                    BaseType_t status = xQueueSend(
-                        vendor_cdc_frame_queue, &frame, pdMS_TO_TICKS(10)
-                    );
-
-                    if (status == pdPASS) {
-                        ESP_LOGD(TAG, "Frame parsed OK: cmd=0x%02X, len=%u, crc=0x%04X",
-                                 frame.command, frame.payload_len, frame.crc16);
-                    } else {
-                        ESP_LOGW(TAG, "Frame queue full, dropped (cmd=0x%02X)",
-                                 frame.command);
-                    }
-                }
-
-                parser_state_reset();
-            }
-            break;
-        }
+void vcdc_rx_error_cb(vcdc_rx_error_t error, uint8_t command, uint32_t arg)
+{
+    switch (error) {
+    case VCDC_RX_ERR_CRC: {
+        ESP_LOGE(TAG, "CRC mismatch: recv=0x%04X, calc=0x%04X (cmd=0x%02X)",
+                 (unsigned)(arg >> 16), (unsigned)(arg & 0xFFFF), command);
+
+        // CRC 오류 응답 프레임 전송
+        uint8_t err_payload[2] = {
+            command,  // 원래 명령 코드
+            0x02      // 에러 코드: CRC 불일치
+        };
+        vendor_cdc_send_frame(VCDC_CMD_ERROR, err_payload, sizeof(err_payload));
+        break;
+    }
+    case VCDC_RX_ERR_TOO_LARGE:
+        ESP_LOGE(TAG, "Payload too large: %lu > %d, resetting",
+                 (unsigned long)arg, VCDC_MAX_PAYLOAD_SIZE);
+        break;
+    case VCDC_RX_ERR_TIMEOUT:
+        ESP_LOGW(TAG, "Parse timeout after %lu bytes (cmd=0x%02X), resetting",
+                 (unsigned long)arg, command);
+        break;
+    case VCDC_RX_ERR_NO_BUFFER:
+        ESP_LOGW(TAG, "Frame pool exhausted, dropped (cmd=0x%02X)", command);
+        break;
     }
 }
 
@@ -354,6 +305,7 @@ static void handle_cmd_ping(const vendor_cdc_frame_t *frame, cJSON *json)
 {
     // 마지막 PING 수신 시각 기록 (Keep-alive 타임아웃 감시용)
     s_last_ping_time_us = esp_timer_get_time();
+    trace_recorder_event(TRACE_EV_PING, 0, 0);
 
     ESP_LOGD(TAG, "PING received (payload_len=%u)", frame->payload_len);
 
@@ -397,6 +349,25 @@ static bool auth_verify(const char *challenge, char *out_response, size_t out_le
     return true;
 }
 
+/**
+ * version 필드로 프로토콜 버전 호환성 확인.
+ * 현재는 버전 체크를 경고 수준으로만 처리 (호환성 유지).
+ *
+ * @param json 수신 JSON (AUTH_CHALLENGE 또는 HELLO)
+ * @param cmd_name 로그용 명령 이름
+ */
+static void check_protocol_version(cJSON *json, const char *cmd_name)
+{
+    cJSON *version_item = cJSON_GetObjectItemCaseSensitive(json, "version");
+    if (cJSON_IsString(version_item) && version_item->valuestring != NULL) {
+        ESP_LOGI(TAG, "%s: protocol version=%s", cmd_name, version_item->valuestring);
+        if (strcmp(version_item->valuestring, AUTH_PROTOCOL_VERSION) != 0) {
+            ESP_LOGW(TAG, "Protocol version mismatch: server=%s, device=%s",
+                     version_item->valuestring, AUTH_PROTOCOL_VERSION);
+        }
+    }
+}
+
 /**
  * AUTH_CHALLENGE 명령 핸들러.
  * Server→ESP: 인증 챌린지 수신 → 에코백 응답 전송.
@@ -434,15 +405,7 @@ static void handle_cmd_auth_challenge(const vendor_cdc_frame_t *frame, cJSON *js
     const char *challenge = challenge_item->valuestring;
 
     // version 필드로 프로토콜 버전 호환성 확인
-    cJSON *version_item = cJSON_GetObjectItemCaseSensitive(json, "version");
-    if (cJSON_IsString(version_item) && version_item->valuestring != NULL) {
-        ESP_LOGI(TAG, "AUTH_CHALLENGE: protocol version=%s", version_item->valuestring);
-        // 현재는 버전 체크를 경고 수준으로만 처리 (호환성 유지)
-        if (strcmp(version_item->valuestring, AUTH_PROTOCOL_VERSION) != 0) {
-            ESP_LOGW(TAG, "Protocol version mismatch: server=%s, device=%s",
-                     version_item->valuestring, AUTH_PROTOCOL_VERSION);
-        }
-    }
+    check_protocol_version(json, "AUTH_CHALLENGE");
 
     // 인증 검증 (에코백)
     char response[128];
@@ -481,7 +444,7 @@ static void handle_cmd_auth_challenge(const vendor_cdc_frame_t *frame, cJSON *js
         (uint16_t)strlen(resp_str)
     );
 
-    free(resp_str);
+    cJSON_free(resp_str);
 
     if (send_ok) {
         // 상태 전이: AUTH_PENDING → AUTH_OK
@@ -498,32 +461,94 @@ static void handle_cmd_auth_challenge(const vendor_cdc_frame_t *frame, cJSON *js
     }
 }
 
-/** ESP32-S3가 지원하는 기능 목록 */
-static const char *supported_features[] = {
-    "wheel",        // HID 리포트에 wheel 필드 있음
-    "drag",         // buttons 필드의 지속 상태
-    "right_click",  // buttons bit1
-};
-#define SUPPORTED_FEATURES_COUNT \
-    (sizeof(supported_features) / sizeof(supported_features[0]))
-
 /** 기본 Keep-alive 주기 (ms) */
 #define DEFAULT_KEEPALIVE_MS  500
 
 /**
- * 기능이 ESP32-S3에서 지원되는지 확인.
+ * 기능 협상 (STATE_SYNC / HELLO 공통).
+ *
+ * features 배열 중 기능 레지스트리(conn_feature_t)에 있는 것만 수락하고,
+ * keepalive_ms(없거나 범위 밖이면 기본 500ms)를 함께 저장합니다.
  *
- * @param feature 기능 이름 문자열
- * @return true: 지원됨, false: 미지원
+ * @param json 수신 JSON ("features", "keepalive_ms" 필드)
+ * @param out 협상 결과
+ * @param cmd_name 로그용 명령 이름
  */
-static bool is_feature_supported(const char *feature)
+static void negotiate_features(cJSON *json, connection_features_t *out, const char *cmd_name)
 {
-    for (size_t i = 0; i < SUPPORTED_FEATURES_COUNT; i++) {
-        if (strcmp(feature, supported_features[i]) == 0) {
-            return true;
+    memset(out, 0, sizeof(*out));
+
+    // features 배열 추출
+    cJSON *features_arr = cJSON_GetObjectItemCaseSensitive(json, "features");
+
+    // keepalive_ms 추출 (기본값: 500ms)
+    uint16_t keepalive_ms = DEFAULT_KEEPALIVE_MS;
+    cJSON *keepalive_item = cJSON_GetObjectItemCaseSensitive(json, "keepalive_ms");
+    if (cJSON_IsNumber(keepalive_item)) {
+        int val = keepalive_item->valueint;
+        if (val > 0 && val <= UINT16_MAX) {
+            keepalive_ms = (uint16_t)val;
+        }
+    }
+    ESP_LOGI(TAG, "%s: keepalive_ms=%u", cmd_name, keepalive_ms);
+    out->keepalive_ms = keepalive_ms;
+
+    if (!cJSON_IsArray(features_arr)) {
+        return;
+    }
+
+    int arr_size = cJSON_GetArraySize(features_arr);
+
+    for (int i = 0; i < arr_size && out->requested_count < CONN_MAX_FEATURES; i++) {
+        cJSON *item = cJSON_GetArrayItem(features_arr, i);
+        if (!cJSON_IsString(item) || item->valuestring == NULL) {
+            continue;
+        }
+
+        const char *feature_name = item->valuestring;
+        out->requested_count++;
+
+        // 레지스트리에 있으면 수락 비트 설정 (중복 요청은 한 번만 계산)
+        conn_feature_t feature = conn_feature_from_name(feature_name);
+        if (feature < CONN_FEATURE_COUNT) {
+            if ((out->accepted_mask & CONN_FEATURE_BIT(feature)) == 0) {
+                out->accepted_mask |= (uint16_t)CONN_FEATURE_BIT(feature);
+                out->accepted_count++;
+            }
+            ESP_LOGI(TAG, "%s: feature '%s' → accepted", cmd_name, feature_name);
+        } else {
+            ESP_LOGI(TAG, "%s: feature '%s' → rejected", cmd_name, feature_name);
         }
     }
-    return false;
+}
+
+/**
+ * 수락된 기능 목록을 "accepted_features" 배열로 응답 JSON에 추가.
+ */
+static void add_accepted_features(cJSON *resp_json, const connection_features_t *negotiated)
+{
+    cJSON *accepted_arr = cJSON_CreateArray();
+    if (accepted_arr != NULL) {
+        for (int f = 0; f < CONN_FEATURE_COUNT; f++) {
+            if (negotiated->accepted_mask & CONN_FEATURE_BIT(f)) {
+                cJSON_AddItemToArray(accepted_arr,
+                                     cJSON_CreateString(conn_feature_name((conn_feature_t)f)));
+            }
+        }
+        cJSON_AddItemToObject(resp_json, "accepted_features", accepted_arr);
+    }
+}
+
+/**
+ * 새 세션 토큰을 발급해 응답 JSON에 "session"과 "resume_grace_ms"로 추가.
+ * 서버는 연결이 끊긴 뒤 유예 시간 안에 이 토큰으로 RESUME할 수 있습니다.
+ */
+static void add_session(cJSON *resp_json)
+{
+    char token[CONN_SESSION_TOKEN_LEN + 1];
+    connection_state_issue_session(token);
+    cJSON_AddStringToObject(resp_json, "session", token);
+    cJSON_AddNumberToObject(resp_json, "resume_grace_ms", CONN_SESSION_GRACE_MS);
 }
 
 /**
@@ -531,7 +556,8 @@ static bool is_feature_supported(const char *feature)
  * Server→ESP: 기능 협상 및 Keep-alive 주기 합의.
  *
  * 수신 JSON: {"command":"STATE_SYNC","features":["wheel","drag",...],"keepalive_ms":500}
- * 응답 JSON: {"command":"STATE_SYNC_ACK","accepted_features":["wheel","drag","right_click"],"mode":"standard"}
+ * 응답 JSON: {"command":"STATE_SYNC_ACK","accepted_features":["wheel","drag","right_click"],"mode":"standard",
+ *             "session":"<token>","resume_grace_ms":10000}
  */
 static void handle_cmd_state_sync(const vendor_cdc_frame_t *frame, cJSON *json)
 {
@@ -553,55 +579,9 @@ static void handle_cmd_state_sync(const vendor_cdc_frame_t *frame, cJSON *json)
     }
     ESP_LOGI(TAG, "State: %s", connection_state_name(connection_state_get()));
 
-    // features 배열 추출
-    cJSON *features_arr = cJSON_GetObjectItemCaseSensitive(json, "features");
-
-    // keepalive_ms 추출 (기본값: 500ms)
-    uint16_t keepalive_ms = DEFAULT_KEEPALIVE_MS;
-    cJSON *keepalive_item = cJSON_GetObjectItemCaseSensitive(json, "keepalive_ms");
-    if (cJSON_IsNumber(keepalive_item)) {
-        int val = keepalive_item->valueint;
-        if (val > 0 && val <= UINT16_MAX) {
-            keepalive_ms = (uint16_t)val;
-        }
-    }
-    ESP_LOGI(TAG, "STATE_SYNC: keepalive_ms=%u", keepalive_ms);
-
     // 기능 협상: 서버 요청 기능 중 지원 가능한 것만 수락
     connection_features_t negotiated;
-    memset(&negotiated, 0, sizeof(negotiated));
-    negotiated.keepalive_ms = keepalive_ms;
-
-    if (cJSON_IsArray(features_arr)) {
-        int arr_size = cJSON_GetArraySize(features_arr);
-
-        for (int i = 0; i < arr_size && negotiated.requested_count < CONN_MAX_FEATURES; i++) {
-            cJSON *item = cJSON_GetArrayItem(features_arr, i);
-            if (!cJSON_IsString(item) || item->valuestring == NULL) {
-                continue;
-            }
-
-            const char *feature_name = item->valuestring;
-
-            // 요청 목록에 추가
-            strncpy(negotiated.requested[negotiated.requested_count],
-                    feature_name, CONN_FEATURE_NAME_MAX - 1);
-            negotiated.requested[negotiated.requested_count][CONN_FEATURE_NAME_MAX - 1] = '\0';
-            negotiated.requested_count++;
-
-            // 지원 여부 확인 → 수락 목록에 추가
-            if (is_feature_supported(feature_name) &&
-                negotiated.accepted_count < CONN_MAX_FEATURES) {
-                strncpy(negotiated.accepted[negotiated.accepted_count],
-                        feature_name, CONN_FEATURE_NAME_MAX - 1);
-                negotiated.accepted[negotiated.accepted_count][CONN_FEATURE_NAME_MAX - 1] = '\0';
-                negotiated.accepted_count++;
-                ESP_LOGI(TAG, "STATE_SYNC: feature '%s' → accepted", feature_name);
-            } else {
-                ESP_LOGI(TAG, "STATE_SYNC: feature '%s' → rejected", feature_name);
-            }
-        }
-    }
+    negotiate_features(json, &negotiated, "STATE_SYNC");
 
     // STATE_SYNC_ACK JSON 생성
     cJSON *ack_json = cJSON_CreateObject();
@@ -612,17 +592,10 @@ static void handle_cmd_state_sync(const vendor_cdc_frame_t *frame, cJSON *json)
     }
 
     cJSON_AddStringToObject(ack_json, "command", "STATE_SYNC_ACK");
-
-    cJSON *accepted_arr = cJSON_CreateArray();
-    if (accepted_arr != NULL) {
-        for (uint8_t i = 0; i < negotiated.accepted_count; i++) {
-            cJSON_AddItemToArray(accepted_arr,
-                                 cJSON_CreateString(negotiated.accepted[i]));
-        }
-        cJSON_AddItemToObject(ack_json, "accepted_features", accepted_arr);
-    }
+    add_accepted_features(ack_json, &negotiated);
 
     cJSON_AddStringToObject(ack_json, "mode", "standard");
+    add_session(ack_json);
 
     char *ack_str = cJSON_PrintUnformatted(ack_json);
     cJSON_Delete(ack_json);
@@ -640,7 +613,7 @@ static void handle_cmd_state_sync(const vendor_cdc_frame_t *frame, cJSON *json)
         (uint16_t)strlen(ack_str)
     );
 
-    free(ack_str);
+    cJSON_free(ack_str);
 
     if (send_ok) {
         // 기능 협상 결과 저장
@@ -665,6 +638,515 @@ static void handle_cmd_state_sync(const vendor_cdc_frame_t *frame, cJSON *json)
     }
 }
 
+/**
+ * HELLO 명령 핸들러.
+ * Server→ESP: AUTH_CHALLENGE + STATE_SYNC를 한 프레임으로 처리 (1회 왕복 핸드셰이크).
+ *
+ * 수신 JSON: {"command":"HELLO","challenge":"<hex>","version":"1.0",
+ *             "features":["wheel","drag",...],"keepalive_ms":500}
+ * 응답 JSON: {"command":"HELLO_ACK","response":"<echo>","device":"BridgeOne","fw_version":"1.0.0",
+ *             "accepted_features":["wheel","drag","right_click"],"mode":"standard",
+ *             "session":"<token>","resume_grace_ms":10000}
+ *
+ * AUTH_CHALLENGE와 마찬가지로 IDLE에서만 허용하며, 다른 상태에서 수신하면 리셋 후 무응답.
+ * 응답 전송 성공 시 connection_state_establish()로 IDLE → CONNECTED를 한 번에 전이합니다.
+ * HELLO를 모르는 이전 펌웨어는 ERROR [0x05, 0x01]로 응답하므로 서버는 즉시 레거시 경로로 전환합니다.
+ */
+static void handle_cmd_hello(const vendor_cdc_frame_t *frame, cJSON *json)
+{
+    ESP_LOGI(TAG, "HELLO received (payload_len=%u)", frame->payload_len);
+
+    // JSON 페이로드 필수
+    if (json == NULL) {
+        ESP_LOGE(TAG, "HELLO: JSON payload required");
+        connection_state_reset();
+        return;
+    }
+
+    // IDLE에서만 허용 (IDLE → AUTH_PENDING 전이 규칙과 동일)
+    connection_state_t state = connection_state_get();
+    if (state != CONN_STATE_IDLE) {
+        ESP_LOGE(TAG, "HELLO: not allowed in state %s", connection_state_name(state));
+        connection_state_reset();
+        return;
+    }
+
+    // challenge 필드 추출
+    cJSON *challenge_item = cJSON_GetObjectItemCaseSensitive(json, "challenge");
+    if (!cJSON_IsString(challenge_item) || challenge_item->valuestring == NULL) {
+        ESP_LOGE(TAG, "HELLO: 'challenge' field missing or invalid");
+        return;
+    }
+
+    check_protocol_version(json, "HELLO");
+
+    // 인증 검증 (에코백)
+    char response[128];
+    if (!auth_verify(challenge_item->valuestring, response, sizeof(response))) {
+        ESP_LOGE(TAG, "HELLO: auth_verify() failed");
+        return;
+    }
+
+    // 기능 협상
+    connection_features_t negotiated;
+    negotiate_features(json, &negotiated, "HELLO");
+
+    // HELLO_ACK JSON 생성
+    cJSON *ack_json = cJSON_CreateObject();
+    if (ack_json == NULL) {
+        ESP_LOGE(TAG, "HELLO: Failed to create ACK JSON");
+        return;
+    }
+
+    cJSON_AddStringToObject(ack_json, "command", "HELLO_ACK");
+    cJSON_AddStringToObject(ack_json, "response", response);
+    cJSON_AddStringToObject(ack_json, "device", "BridgeOne");
+    cJSON_AddStringToObject(ack_json, "fw_version", AUTH_FW_VERSION);
+    add_accepted_features(ack_json, &negotiated);
+    cJSON_AddStringToObject(ack_json, "mode", "standard");
+    add_session(ack_json);
+
+    char *ack_str = cJSON_PrintUnformatted(ack_json);
+    cJSON_Delete(ack_json);
+
+    if (ack_str == NULL) {
+        ESP_LOGE(TAG, "HELLO: Failed to serialize ACK JSON");
+        return;
+    }
+
+    // HELLO_ACK 프레임 전송
+    bool send_ok = vendor_cdc_send_frame(
+        VCDC_CMD_HELLO_ACK,
+        (const uint8_t *)ack_str,
+        (uint16_t)strlen(ack_str)
+    );
+
+    cJSON_free(ack_str);
+
+    if (!send_ok) {
+        ESP_LOGE(TAG, "HELLO_ACK send failed");
+        return;
+    }
+
+    // 상태 전이: IDLE → CONNECTED (중간 상태 없이 기능과 함께 저장)
+    if (connection_state_establish(&negotiated)) {
+        // Keep-alive 타이머 리셋 (STATE_SYNC 핸들러와 동일)
+        s_last_ping_time_us = esp_timer_get_time();
+
+        ESP_LOGI(TAG, "HELLO_ACK sent, State: %s (accepted=%u/%u features)",
+                 connection_state_name(connection_state_get()),
+                 negotiated.accepted_count, negotiated.requested_count);
+    } else {
+        ESP_LOGE(TAG, "HELLO: establish failed");
+        connection_state_reset();
+    }
+}
+
+/**
+ * RESUME 명령 핸들러.
+ * Server→ESP: DTR 해제 / Keep-alive 타임아웃으로 끊긴 세션을 토큰으로 재개 (1회 왕복).
+ *
+ * 수신 JSON: {"command":"RESUME","session":"<token>"}
+ * 응답 JSON: {"command":"RESUME_ACK","accepted_features":["wheel","drag","right_click"],
+ *             "keepalive_ms":500,"mode":"standard"}
+ * 거부 시:   ERROR [0x07, 0x03] (보류 세션 없음, 토큰 불일치 또는 유예 시간 만료)
+ *
+ * 재협상 없이 보류해 둔 기능 그대로 CONNECTED에 복귀하므로 Standard 모드 기능이 바뀌지 않습니다.
+ * IDLE이 아닌 상태(끊김을 감지하지 못한 채 서버가 다시 연결한 경우)에서 받으면
+ * 먼저 리셋해 현재 세션을 보류시킨 뒤 재개를 시도합니다.
+ */
+static void handle_cmd_resume(const vendor_cdc_frame_t *frame, cJSON *json)
+{
+    ESP_LOGI(TAG, "RESUME received (payload_len=%u)", frame->payload_len);
+
+    cJSON *session_item = (json != NULL)
+        ? cJSON_GetObjectItemCaseSensitive(json, "session")
+        : NULL;
+
+    connection_features_t restored;
+    bool resumed = false;
+
+    if (cJSON_IsString(session_item) && session_item->valuestring != NULL) {
+        if (connection_state_get() != CONN_STATE_IDLE) {
+            ESP_LOGW(TAG, "RESUME: received in state %s, suspending current session",
+                     connection_state_name(connection_state_get()));
+            connection_state_reset();
+        }
+        resumed = connection_state_resume(session_item->valuestring, &restored);
+    } else {
+        ESP_LOGE(TAG, "RESUME: 'session' field missing or invalid");
+    }
+
+    if (!resumed) {
+        uint8_t err_payload[2] = {
+            VCDC_CMD_RESUME,
+            0x03                 // 에러 코드: 세션 재개 불가
+        };
+        vendor_cdc_send_frame(VCDC_CMD_ERROR, err_payload, sizeof(err_payload));
+        return;
+    }
+
+    // Keep-alive 타이머 리셋 (STATE_SYNC 핸들러와 동일)
+    s_last_ping_time_us = esp_timer_get_time();
+
+    // RESUME_ACK JSON 생성
+    cJSON *ack_json = cJSON_CreateObject();
+    if (ack_json == NULL) {
+        ESP_LOGE(TAG, "RESUME: Failed to create ACK JSON");
+        connection_state_reset();
+        return;
+    }
+
+    cJSON_AddStringToObject(ack_json, "command", "RESUME_ACK");
+    add_accepted_features(ack_json, &restored);
+    cJSON_AddNumberToObject(ack_json, "keepalive_ms", restored.keepalive_ms);
+    cJSON_AddStringToObject(ack_json, "mode", "standard");
+
+    char *ack_str = cJSON_PrintUnformatted(ack_json);
+    cJSON_Delete(ack_json);
+
+    if (ack_str == NULL) {
+        ESP_LOGE(TAG, "RESUME: Failed to serialize ACK JSON");
+        connection_state_reset();
+        return;
+    }
+
+    bool send_ok = vendor_cdc_send_frame(
+        VCDC_CMD_RESUME_ACK,
+        (const uint8_t *)ack_str,
+        (uint16_t)strlen(ack_str)
+    );
+
+    cJSON_free(ack_str);
+
+    if (send_ok) {
+        ESP_LOGI(TAG, "RESUME_ACK sent, State: %s (accepted=%u features)",
+                 connection_state_name(connection_state_get()), restored.accepted_count);
+    } else {
+        // 리셋하면 세션이 다시 보류되므로 서버는 같은 토큰으로 재시도할 수 있음
+        ESP_LOGE(TAG, "RESUME_ACK send failed");
+        connection_state_reset();
+    }
+}
+
+/**
+ * MACRO_UPLOAD 명령 핸들러.
+ * Server→ESP: 매크로를 플래시 슬롯에 저장 (step_count=0이면 삭제) → MACRO_ACK 응답.
+ *
+ * 수신 페이로드 (바이너리): [macro_id 1B] [step_count 1B] [macro_step_t × step_count]
+ * 응답 JSON: {"command":"MACRO_ACK","id":3,"steps":4,"result":"ok"}
+ *            실패 시 "result":"error", "reason":"<esp_err 이름>"
+ */
+static void handle_cmd_macro_upload(const vendor_cdc_frame_t *frame, cJSON *json)
+{
+    (void)json;  // 바이너리 페이로드
+
+    esp_err_t ret = ESP_ERR_INVALID_ARG;
+    uint8_t macro_id = 0;
+    uint8_t step_count = 0;
+
+    if (frame->payload_len >= 2) {
+        macro_id = frame->payload[0];
+        step_count = frame->payload[1];
+
+        size_t expected_len = 2 + (size_t)step_count * sizeof(macro_step_t);
+        if (frame->payload_len == expected_len) {
+            // payload[2]부터 스텝 배열 (정렬 보장이 없으므로 복사 후 전달)
+            macro_step_t steps[MACRO_MAX_STEPS];
+            if (step_count <= MACRO_MAX_STEPS) {
+                memcpy(steps, &frame->payload[2], (size_t)step_count * sizeof(macro_step_t));
+                ret = macro_engine_store(macro_id, steps, step_count);
+            }
+        } else {
+            ESP_LOGE(TAG, "MACRO_UPLOAD: length mismatch (len=%u, expected=%u)",
+                     frame->payload_len, (unsigned)expected_len);
+        }
+    } else {
+        ESP_LOGE(TAG, "MACRO_UPLOAD: payload too short (len=%u)", frame->payload_len);
+    }
+
+    cJSON *ack_json = cJSON_CreateObject();
+    if (ack_json == NULL) {
+        ESP_LOGE(TAG, "MACRO_UPLOAD: Failed to create ACK JSON");
+        return;
+    }
+
+    cJSON_AddStringToObject(ack_json, "command", "MACRO_ACK");
+    cJSON_AddNumberToObject(ack_json, "id", macro_id);
+    cJSON_AddNumberToObject(ack_json, "steps", step_count);
+    cJSON_AddStringToObject(ack_json, "result", (ret == ESP_OK) ? "ok" : "error");
+    if (ret != ESP_OK) {
+        cJSON_AddStringToObject(ack_json, "reason", esp_err_to_name(ret));
+    }
+
+    char *ack_str = cJSON_PrintUnformatted(ack_json);
+    cJSON_Delete(ack_json);
+
+    if (ack_str == NULL) {
+        ESP_LOGE(TAG, "MACRO_UPLOAD: Failed to serialize ACK JSON");
+        return;
+    }
+
+    vendor_cdc_send_frame(VCDC_CMD_MACRO_ACK, (const uint8_t *)ack_str, (uint16_t)strlen(ack_str));
+    cJSON_free(ack_str);
+}
+
+/**
+ * MEM_QUERY 명령 핸들러.
+ * 힙/태스크 스택/모듈 정적 RAM 보고서를 MEM_REPORT로 응답합니다.
+ * 응답은 연결 상태와 무관하게 보냅니다 (핸드셰이크 전 진단용).
+ */
+static void handle_cmd_mem_query(const vendor_cdc_frame_t *frame, cJSON *json)
+{
+    // 명령 아레나에서 잠시 빌려 씀: 스택/정적 RAM 예산에서 제외
+    char *report = mem_arena_alloc(VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (report == NULL) {
+        ESP_LOGE(TAG, "MEM_QUERY: Failed to allocate report buffer");
+        return;
+    }
+
+    size_t len = mem_report_build_json(report, VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (len > 0) {
+        vendor_cdc_send_frame(VCDC_CMD_MEM_REPORT, (const uint8_t *)report, (uint16_t)len);
+    } else {
+        ESP_LOGE(TAG, "MEM_QUERY: report exceeds payload limit");
+    }
+    mem_arena_free(report);
+}
+
+/**
+ * TOP_QUERY 명령 핸들러.
+ * 직전 조회 이후 구간의 태스크 프로파일을 TOP_REPORT로 응답합니다.
+ * MEM_QUERY와 마찬가지로 연결 상태와 무관하게 응답합니다.
+ */
+static void handle_cmd_top_query(const vendor_cdc_frame_t *frame, cJSON *json)
+{
+    char *report = mem_arena_alloc(VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (report == NULL) {
+        ESP_LOGE(TAG, "TOP_QUERY: Failed to allocate report buffer");
+        return;
+    }
+
+    size_t len = task_profiler_build_json(report, VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (len > 0) {
+        vendor_cdc_send_frame(VCDC_CMD_TOP_REPORT, (const uint8_t *)report, (uint16_t)len);
+    } else {
+        ESP_LOGE(TAG, "TOP_QUERY: failed to build task profile");
+    }
+    mem_arena_free(report);
+}
+
+/**
+ * 덤프 청크 전송 (FIFO가 비기를 잠시 기다리며 재시도).
+ * ctx: 보낼 명령 코드 (const uint8_t *, PROF_DATA / TRACE_DATA / INPUT_DATA)
+ */
+static bool send_data_chunk(const uint8_t *chunk, uint16_t len, void *ctx)
+{
+    const uint8_t command = *(const uint8_t *)ctx;
+    for (int attempt = 0; attempt < 5; attempt++) {
+        if (vendor_cdc_send_frame(command, chunk, len)) {
+            return true;
+        }
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    return false;
+}
+
+/**
+ * PROF_CONTROL 명령 핸들러.
+ * op: "start"(hz/ms/depth 선택) / "stop" / "status" → PROF_STATUS 응답,
+ *     "dump" → PROF_DATA 청크 연속 전송 (실패 시 PROF_STATUS).
+ */
+static void handle_cmd_prof_control(const vendor_cdc_frame_t *frame, cJSON *json)
+{
+    const cJSON *op = cJSON_GetObjectItemCaseSensitive(json, "op");
+    const char *op_name = cJSON_IsString(op) ? op->valuestring : "status";
+
+    if (strcmp(op_name, "start") == 0) {
+        pc_prof_config_t config = {
+            .hz    = PC_PROF_DEFAULT_HZ,
+            .ms    = PC_PROF_DEFAULT_MS,
+            .depth = PC_PROF_DEFAULT_DEPTH,
+        };
+        const cJSON *hz    = cJSON_GetObjectItemCaseSensitive(json, "hz");
+        const cJSON *ms    = cJSON_GetObjectItemCaseSensitive(json, "ms");
+        const cJSON *depth = cJSON_GetObjectItemCaseSensitive(json, "depth");
+        if (cJSON_IsNumber(hz) && hz->valueint > 0) {
+            config.hz = (uint32_t)hz->valueint;
+        }
+        if (cJSON_IsNumber(ms) && ms->valueint > 0) {
+            config.ms = (uint32_t)ms->valueint;
+        }
+        if (cJSON_IsNumber(depth) && depth->valueint > 0) {
+            config.depth = (uint8_t)depth->valueint;
+        }
+        if (!pc_profiler_start(&config)) {
+            ESP_LOGE(TAG, "PROF_CONTROL: start failed");
+        }
+    } else if (strcmp(op_name, "stop") == 0) {
+        pc_profiler_stop();
+    } else if (strcmp(op_name, "dump") == 0) {
+        uint8_t command = VCDC_CMD_PROF_DATA;
+        if (pc_profiler_dump(VCDC_MAX_PAYLOAD_SIZE, send_data_chunk, &command)) {
+            return;
+        }
+        ESP_LOGW(TAG, "PROF_CONTROL: dump failed or no samples");
+    }
+
+    char *status = mem_arena_alloc(VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (status == NULL) {
+        ESP_LOGE(TAG, "PROF_CONTROL: Failed to allocate status buffer");
+        return;
+    }
+    size_t len = pc_profiler_build_status_json(status, VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (len > 0) {
+        vendor_cdc_send_frame(VCDC_CMD_PROF_STATUS, (const uint8_t *)status, (uint16_t)len);
+    }
+    mem_arena_free(status);
+}
+
+/**
+ * TRACE_CONTROL 명령 핸들러.
+ * op: "start" / "stop" / "status" → TRACE_STATUS 응답,
+ *     "dump" → 기록 중지 후 TRACE_DATA 청크 연속 전송 (실패 시 TRACE_STATUS).
+ */
+static void handle_cmd_trace_control(const vendor_cdc_frame_t *frame, cJSON *json)
+{
+    const cJSON *op = cJSON_GetObjectItemCaseSensitive(json, "op");
+    const char *op_name = cJSON_IsString(op) ? op->valuestring : "status";
+
+    if (strcmp(op_name, "start") == 0) {
+        if (!trace_recorder_start()) {
+            ESP_LOGE(TAG, "TRACE_CONTROL: start failed");
+        }
+    } else if (strcmp(op_name, "stop") == 0) {
+        trace_recorder_stop();
+    } else if (strcmp(op_name, "dump") == 0) {
+        uint8_t command = VCDC_CMD_TRACE_DATA;
+        if (trace_recorder_dump(VCDC_MAX_PAYLOAD_SIZE, send_data_chunk, &command)) {
+            return;
+        }
+        ESP_LOGW(TAG, "TRACE_CONTROL: dump failed or nothing recorded");
+    }
+
+    char *status = mem_arena_alloc(VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (status == NULL) {
+        ESP_LOGE(TAG, "TRACE_CONTROL: Failed to allocate status buffer");
+        return;
+    }
+    size_t len = trace_recorder_build_status_json(status, VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (len > 0) {
+        vendor_cdc_send_frame(VCDC_CMD_TRACE_STATUS, (const uint8_t *)status, (uint16_t)len);
+    }
+    mem_arena_free(status);
+}
+
+/** INPUT_STATUS 응답 전송 */
+static void send_input_status(void)
+{
+    char *status = mem_arena_alloc(VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (status == NULL) {
+        ESP_LOGE(TAG, "INPUT: Failed to allocate status buffer");
+        return;
+    }
+    size_t len = input_trace_build_status_json(status, VCDC_MAX_PAYLOAD_SIZE + 1);
+    if (len > 0) {
+        vendor_cdc_send_frame(VCDC_CMD_INPUT_STATUS, (const uint8_t *)status, (uint16_t)len);
+    }
+    mem_arena_free(status);
+}
+
+/**
+ * INPUT_CONTROL 명령 핸들러.
+ * op: "start" / "stop" / "status" / "load_recorded" / "replay"(speed, max_idle_ms 선택)
+ *     / "replay_stop" → INPUT_STATUS 응답,
+ *     "dump"(last 선택) → INPUT_DATA 청크 연속 전송 (실패 시 INPUT_STATUS).
+ */
+static void handle_cmd_input_control(const vendor_cdc_frame_t *frame, cJSON *json)
+{
+    const cJSON *op = cJSON_GetObjectItemCaseSensitive(json, "op");
+    const char *op_name = cJSON_IsString(op) ? op->valuestring : "status";
+
+    if (strcmp(op_name, "start") == 0) {
+        input_trace_start();
+    } else if (strcmp(op_name, "stop") == 0) {
+        input_trace_stop();
+    } else if (strcmp(op_name, "dump") == 0) {
+        const cJSON *last = cJSON_GetObjectItemCaseSensitive(json, "last");
+        uint32_t last_records = (cJSON_IsNumber(last) && last->valueint > 0) ? (uint32_t)last->valueint : 0;
+        uint8_t command = VCDC_CMD_INPUT_DATA;
+        if (input_trace_dump(last_records, VCDC_MAX_PAYLOAD_SIZE, send_data_chunk, &command)) {
+            return;
+        }
+        ESP_LOGW(TAG, "INPUT_CONTROL: dump failed or recorder unavailable");
+    } else if (strcmp(op_name, "load_recorded") == 0) {
+        input_trace_replay_load_recorded();
+    } else if (strcmp(op_name, "replay") == 0) {
+        uint16_t speed = INPUT_TRACE_DEFAULT_SPEED;
+        uint32_t max_idle_ms = INPUT_TRACE_DEFAULT_MAX_IDLE_MS;
+        const cJSON *speed_item = cJSON_GetObjectItemCaseSensitive(json, "speed");
+        const cJSON *idle_item  = cJSON_GetObjectItemCaseSensitive(json, "max_idle_ms");
+        if (cJSON_IsNumber(speed_item) && speed_item->valueint >= 0) {
+            speed = (uint16_t)((speed_item->valueint > INPUT_REPLAY_SPEED_MAX)
+                                   ? INPUT_REPLAY_SPEED_MAX : speed_item->valueint);
+        }
+        if (cJSON_IsNumber(idle_item) && idle_item->valueint >= 0) {
+            max_idle_ms = (uint32_t)idle_item->valueint;
+        }
+        if (!input_trace_replay_start(speed, max_idle_ms)) {
+            ESP_LOGW(TAG, "INPUT_CONTROL: replay not started (loaded=%u)",
+                     (unsigned)input_trace_replay_loaded());
+        }
+    } else if (strcmp(op_name, "replay_stop") == 0) {
+        input_trace_replay_stop();
+    }
+
+    send_input_status();
+}
+
+/**
+ * INPUT_UPLOAD 명령 핸들러 (바이너리).
+ * 페이로드: [offset u32 LE] + input_trace_record_t × n.
+ * offset은 이미 적재된 레코드 수와 같아야 하며, 0이면 재생 버퍼를 비우고 시작합니다.
+ * 결과와 관계없이 INPUT_STATUS로 응답합니다 (호스트는 loaded로 다음 offset을 확인).
+ */
+static void handle_cmd_input_upload(const vendor_cdc_frame_t *frame, cJSON *json)
+{
+    (void)json;
+
+    if (frame->payload_len < 4 ||
+        (frame->payload_len - 4) % sizeof(input_trace_record_t) != 0) {
+        ESP_LOGW(TAG, "INPUT_UPLOAD: invalid payload length %u", frame->payload_len);
+        send_input_status();
+        return;
+    }
+
+    const uint8_t *p = frame->payload;
+    uint32_t offset = (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+                      ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    uint32_t count = (uint32_t)((frame->payload_len - 4) / sizeof(input_trace_record_t));
+
+    if (offset == 0) {
+        input_trace_replay_clear();
+    }
+    if (offset != input_trace_replay_loaded()) {
+        ESP_LOGW(TAG, "INPUT_UPLOAD: offset %u, expected %u",
+                 (unsigned)offset, (unsigned)input_trace_replay_loaded());
+    } else if (count > 0) {
+        // 페이로드는 정렬되지 않았을 수 있으므로 레코드 단위로 복사
+        for (uint32_t i = 0; i < count; i++) {
+            input_trace_record_t rec;
+            memcpy(&rec, &p[4 + i * sizeof(rec)], sizeof(rec));
+            if (!input_trace_replay_append(&rec, 1)) {
+                ESP_LOGW(TAG, "INPUT_UPLOAD: append failed at %u", (unsigned)(offset + i));
+                break;
+            }
+        }
+    }
+
+    send_input_status();
+}
+
 /**
  * ERROR 명령 핸들러.
  * 양방향: 오류 응답 수신 시 로그 출력.
@@ -696,6 +1178,15 @@ static const vcdc_cmd_entry_t cmd_dispatch_table[] = {
     { VCDC_CMD_PING,            handle_cmd_ping,            "PING"           },
     { VCDC_CMD_AUTH_CHALLENGE,   handle_cmd_auth_challenge,  "AUTH_CHALLENGE" },
     { VCDC_CMD_STATE_SYNC,       handle_cmd_state_sync,      "STATE_SYNC"    },
+    { VCDC_CMD_HELLO,            handle_cmd_hello,           "HELLO"         },
+    { VCDC_CMD_RESUME,           handle_cmd_resume,          "RESUME"        },
+    { VCDC_CMD_MACRO_UPLOAD,     handle_cmd_macro_upload,    "MACRO_UPLOAD"  },
+    { VCDC_CMD_MEM_QUERY,        handle_cmd_mem_query,       "MEM_QUERY"     },
+    { VCDC_CMD_TOP_QUERY,        handle_cmd_top_query,       "TOP_QUERY"     },
+    { VCDC_CMD_PROF_CONTROL,     handle_cmd_prof_control,    "PROF_CONTROL"  },
+    { VCDC_CMD_TRACE_CONTROL,    handle_cmd_trace_control,   "TRACE_CONTROL" },
+    { VCDC_CMD_INPUT_CONTROL,    handle_cmd_input_control,   "INPUT_CONTROL" },
+    { VCDC_CMD_INPUT_UPLOAD,     handle_cmd_input_upload,    "INPUT_UPLOAD"  },
     { VCDC_CMD_ERROR,            handle_cmd_error,           "ERROR"         },
 };
 
@@ -730,13 +1221,13 @@ void vendor_cdc_task(void *param)
 
     ESP_LOGI(TAG, "Vendor CDC task started");
 
-    vendor_cdc_frame_t frame;
-
     while (1) {
-        // 큐에서 파싱된 프레임 대기 (100ms 타임아웃으로 주기적 체크)
+        // 큐에서 파싱된 프레임(풀 인덱스) 대기 (100ms 타임아웃으로 주기적 체크)
+        uint8_t frame_idx;
         BaseType_t queue_result = xQueueReceive(
-            vendor_cdc_frame_queue, &frame, pdMS_TO_TICKS(100)
+            vendor_cdc_frame_queue, &frame_idx, pdMS_TO_TICKS(100)
         );
+        task_probe_wake(TASK_PROBE_VCDC);
 
         // ── Keep-alive 타임아웃 체크 ──
         // CONNECTED 상태에서 3초간 PING 미수신 시 IDLE로 전환
@@ -755,36 +1246,39 @@ void vendor_cdc_task(void *param)
             continue;
         }
 
+        // 처리가 끝날 때까지 풀 프레임을 직접 사용 (복사 없음)
+        vendor_cdc_frame_t *frame = &s_frame_pool[frame_idx];
+
         ESP_LOGI(TAG, "Frame received: cmd=0x%02X, payload_len=%u, crc=0x%04X",
-                 frame.command, frame.payload_len, frame.crc16);
+                 frame->command, frame->payload_len, frame->crc16);
 
         // JSON 페이로드 파싱 (payload가 있는 경우)
         cJSON *json = NULL;
 
-        if (frame.payload_len > 0) {
+        if (frame->payload_len > 0) {
             // payload를 null-terminate (버퍼는 VCDC_MAX_PAYLOAD_SIZE+1이므로 항상 안전)
-            frame.payload[frame.payload_len] = '\0';
+            frame->payload[frame->payload_len] = '\0';
 
-            json = cJSON_Parse((const char *)frame.payload);
+            json = cJSON_Parse((const char *)frame->payload);
 
             if (json == NULL) {
                 // JSON 파싱 실패: 바이너리 payload일 수 있으므로 경고만 출력
                 // (모든 payload가 JSON인 것은 아님)
                 ESP_LOGD(TAG, "Payload is not JSON (cmd=0x%02X, len=%u)",
-                         frame.command, frame.payload_len);
+                         frame->command, frame->payload_len);
             } else {
-                ESP_LOGD(TAG, "JSON parsed OK (cmd=0x%02X)", frame.command);
+                ESP_LOGD(TAG, "JSON parsed OK (cmd=0x%02X)", frame->command);
             }
         }
 
         // 명령 디스패처 호출
-        if (!dispatch_command(&frame, json)) {
+        if (!dispatch_command(frame, json)) {
             ESP_LOGW(TAG, "Unknown command: 0x%02X (payload_len=%u)",
-                     frame.command, frame.payload_len);
+                     frame->command, frame->payload_len);
 
             // 미지원 명령 에러 응답
             uint8_t err_payload[2] = {
-                frame.command,  // 원래 명령 코드
+                frame->command,  // 원래 명령 코드
                 0x01            // 에러 코드: 미지원 명령
             };
             vendor_cdc_send_frame(VCDC_CMD_ERROR, err_payload, sizeof(err_payload));
@@ -794,5 +1288,9 @@ void vendor_cdc_task(void *param)
         if (json != NULL) {
             cJSON_Delete(json);
         }
+
+        // 명령 하나 처리 완료: 아레나 통째로 회수
+        mem_arena_reset();
+        frame_pool_release((int8_t)frame_idx);
     }
 }
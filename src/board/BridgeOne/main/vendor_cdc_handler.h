@@ -26,20 +26,9 @@
 #include <stddef.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "vcdc_rx.h"
 
-// ==================== 프레임 상수 ====================
-
-/** Vendor CDC 프레임 헤더 바이트 (텍스트 명령과 구분용) */
-#define VCDC_FRAME_HEADER       0xFF
-
-/** 최대 페이로드 크기 (바이트) */
-#define VCDC_MAX_PAYLOAD_SIZE   448
-
-/** 프레임 오버헤드: header(1) + command(1) + length(2) + crc16(2) = 6바이트 */
-#define VCDC_FRAME_OVERHEAD     6
-
-/** 최대 프레임 크기: 오버헤드 + 최대 페이로드 = 454바이트 */
-#define VCDC_MAX_FRAME_SIZE     (VCDC_FRAME_OVERHEAD + VCDC_MAX_PAYLOAD_SIZE)
+// 프레임 상수(VCDC_FRAME_HEADER, VCDC_MAX_PAYLOAD_SIZE 등)와 vendor_cdc_crc16()은 vcdc_rx.h
 
 // ==================== 명령 코드 정의 ====================
 
@@ -54,9 +43,29 @@ typedef enum {
     VCDC_CMD_AUTH_RESPONSE   = 0x02,  // ESP→Server: 인증 응답
     VCDC_CMD_STATE_SYNC      = 0x03,  // Server→ESP: 상태 동기화 요청
     VCDC_CMD_STATE_SYNC_ACK  = 0x04,  // ESP→Server: 상태 동기화 확인
+    VCDC_CMD_HELLO           = 0x05,  // Server→ESP: 인증 + 상태 동기화 통합 요청 (1회 왕복)
+    VCDC_CMD_HELLO_ACK       = 0x06,  // ESP→Server: 인증 응답 + 수락 기능 통합 응답
+    VCDC_CMD_RESUME          = 0x07,  // Server→ESP: 세션 토큰으로 이전 세션 재개 (1회 왕복)
+    VCDC_CMD_RESUME_ACK      = 0x08,  // ESP→Server: 세션 재개 응답 (복원된 기능)
     VCDC_CMD_PING            = 0x10,  // Server→ESP: Keep-alive ping
     VCDC_CMD_PONG            = 0x11,  // ESP→Server: Keep-alive pong
     VCDC_CMD_MODE_NOTIFY     = 0x20,  // ESP→Server: 모드 변경 알림
+    VCDC_CMD_MACRO_UPLOAD    = 0x30,  // Server→ESP: 매크로 저장/삭제 (바이너리 페이로드)
+    VCDC_CMD_MACRO_ACK       = 0x31,  // ESP→Server: 매크로 저장 결과
+    VCDC_CMD_MEM_QUERY       = 0x40,  // Server→ESP: 메모리 보고서 요청
+    VCDC_CMD_MEM_REPORT      = 0x41,  // ESP→Server: 힙/스택/정적 RAM 보고서 (JSON)
+    VCDC_CMD_TOP_QUERY       = 0x42,  // Server→ESP: 태스크 프로파일 요청
+    VCDC_CMD_TOP_REPORT      = 0x43,  // ESP→Server: 태스크별 CPU/깨어남/지연/스택 (JSON)
+    VCDC_CMD_PROF_CONTROL    = 0x44,  // Server→ESP: PC 샘플링 시작/중지/상태/덤프 (JSON)
+    VCDC_CMD_PROF_STATUS     = 0x45,  // ESP→Server: PC 샘플링 상태 (JSON)
+    VCDC_CMD_PROF_DATA       = 0x46,  // ESP→Server: PC 샘플 히스토그램 청크 (바이너리)
+    VCDC_CMD_TRACE_CONTROL   = 0x47,  // Server→ESP: 이벤트 트레이스 시작/중지/상태/덤프 (JSON)
+    VCDC_CMD_TRACE_STATUS    = 0x48,  // ESP→Server: 이벤트 트레이스 상태 (JSON)
+    VCDC_CMD_TRACE_DATA      = 0x49,  // ESP→Server: 이벤트 트레이스 청크 (바이너리)
+    VCDC_CMD_INPUT_CONTROL   = 0x4A,  // Server→ESP: 입력 트레이스 기록/덤프/재생 제어 (JSON)
+    VCDC_CMD_INPUT_STATUS    = 0x4B,  // ESP→Server: 입력 트레이스 상태 (JSON)
+    VCDC_CMD_INPUT_DATA      = 0x4C,  // ESP→Server: 입력 트레이스 레코드 청크 (바이너리)
+    VCDC_CMD_INPUT_UPLOAD    = 0x4D,  // Server→ESP: 재생 버퍼에 레코드 적재 (바이너리)
     VCDC_CMD_ERROR           = 0xFE,  // 양방향: 오류 응답
 } vendor_cdc_cmd_t;
 
@@ -78,18 +87,6 @@ typedef struct {
 
 // ==================== 함수 선언 ====================
 
-/**
- * CRC16-CCITT 계산 함수.
- *
- * Windows 서버의 C# 구현과 동일한 알고리즘입니다.
- * 다항식: 0x1021, 초기값: 0x0000
- *
- * @param data 계산 대상 데이터 (payload만)
- * @param length 데이터 길이
- * @return CRC16 값
- */
-uint16_t vendor_cdc_crc16(const uint8_t *data, size_t length);
-
 /**
  * Vendor CDC 프레임 조립 및 전송.
  *
@@ -105,9 +102,12 @@ uint16_t vendor_cdc_crc16(const uint8_t *data, size_t length);
  */
 bool vendor_cdc_send_frame(uint8_t command, const uint8_t *payload, uint16_t payload_len);
 
-// ==================== 프레임 파싱 상태 머신 ====================
+// ==================== 프레임 수신 (파서 본체는 vcdc_rx.h) ====================
 
-/** 파싱된 Vendor CDC 프레임을 수신하는 FreeRTOS 큐 */
+/**
+ * 파싱된 Vendor CDC 프레임을 수신하는 FreeRTOS 큐.
+ * 아이템은 내부 프레임 풀의 인덱스(uint8_t)이며, vendor_cdc_task만 수신합니다.
+ */
 extern QueueHandle_t vendor_cdc_frame_queue;
 
 /**
@@ -121,18 +121,9 @@ extern QueueHandle_t vendor_cdc_frame_queue;
 bool vendor_cdc_parser_init(void);
 
 /**
- * 바이트 스트림을 파서에 공급.
- *
- * CDC RX 콜백에서 수신된 바이트를 상태 머신에 공급합니다.
- * 완전한 프레임이 파싱되면 CRC16 검증 후 vendor_cdc_frame_queue에 전달합니다.
- *
- * 상태 머신 흐름:
- * WAIT_HEADER → READ_COMMAND → READ_LENGTH → READ_PAYLOAD → READ_CRC → (큐 전달 후 리셋)
- *
- * @param data 수신된 바이트 버퍼
- * @param len 바이트 수
+ * 프레임 풀과 파서 컨텍스트의 정적 RAM 크기 (메모리 보고서용).
  */
-void vendor_cdc_parser_feed(const uint8_t *data, uint32_t len);
+size_t vendor_cdc_static_ram_bytes(void);
 
 /**
  * 파서 상태 리셋.
@@ -141,16 +132,6 @@ void vendor_cdc_parser_feed(const uint8_t *data, uint32_t len);
  */
 void vendor_cdc_parser_reset(void);
 
-/**
- * 파서가 바이너리 프레임을 수신 중인지 확인.
- *
- * CDC RX 콜백에서 바이트별 텍스트/바이너리 분류에 사용합니다.
- * WAIT_HEADER 상태가 아니면 바이너리 프레임 수신 중으로 판단합니다.
- *
- * @return true: 바이너리 프레임 수신 중, false: 대기 상태 (텍스트 처리 가능)
- */
-bool vendor_cdc_parser_is_active(void);
-
 // ==================== Vendor CDC 태스크 ====================
 
 /**
@@ -162,7 +143,7 @@ bool vendor_cdc_parser_is_active(void);
  * 3. 미지원 명령/파싱 실패 시 에러 응답 전송
  *
  * app_main()에서 xTaskCreatePinnedToCore()로 생성해야 합니다.
- * - Priority: 3, Core: 0, Stack: 4096 bytes
+ * - Priority: 3, Core: 0, Stack: 4096 bytes (BridgeOne.c VCDC_TASK_STACK_SIZE)
  *
  * @param param 미사용
  */
@@ -0,0 +1,231 @@
+/**
+ * @file bench_vcdc_rx.c
+ * @brief CDC RX 경로 처리량 비교 (호스트 벤치마크, 테스트 아님)
+ *
+ * 같은 프레임 스트림을 64바이트 OUT 패킷 단위로 1024바이트 RX FIFO 모델에 넣고,
+ * 패킷마다 RX 콜백을 한 번 실행합니다 (펌웨어 CFG_TUD_CDC_RX_BUFSIZE / CFG_TUD_CDC_EP_BUFSIZE).
+ *
+ * - copy:     이전 tud_cdc_rx_cb. FIFO를 64바이트 스택 버퍼로 복사(tud_cdc_read)한 뒤
+ *             바이트마다 상태 머신(vcdc_rx_feed)에 공급하고 텍스트/바이너리를 분류
+ * - in-place: 현재 tud_cdc_rx_cb. FIFO 영역을 vcdc_rx_process_span()에 바로 넘기고 소비한 만큼만 advance
+ *
+ * 두 경로 모두 검증된 프레임은 풀 프레임 버퍼에 한 번 놓이며(펌웨어와 같음), 전달된 프레임 수가
+ * 같은지 확인합니다. 호스트 CPU 기준의 상대 비교이며 ESP32-S3 절대 성능이 아닙니다.
+ *
+ *   bench_vcdc_rx [MB per case]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "vcdc_rx.h"
+
+#define FIFO_SIZE   1024    // CFG_TUD_CDC_RX_BUFSIZE
+#define PACKET_SIZE 64      // CFG_TUD_CDC_EP_BUFSIZE
+
+// ==================== vcdc_rx 콜백 (펌웨어: vendor_cdc_handler.c, usb_cdc_log.c) ====================
+
+static uint8_t  s_pool[VCDC_MAX_PAYLOAD_SIZE + 1];
+static uint32_t s_frames;
+static uint32_t s_text_bytes;
+
+int8_t vcdc_rx_acquire_cb(uint8_t **payload)
+{
+    *payload = s_pool;
+    return 0;
+}
+
+void vcdc_rx_release_cb(int8_t idx)
+{
+    (void)idx;
+}
+
+void vcdc_rx_frame_cb(uint8_t command, const uint8_t *payload, uint16_t payload_len,
+                      uint16_t crc16, int8_t idx)
+{
+    (void)command;
+    (void)crc16;
+    // 제자리 파싱 경로는 펌웨어와 같이 풀 프레임으로 한 번 복사
+    if (idx < 0 && payload_len > 0) {
+        memcpy(s_pool, payload, payload_len);
+    }
+    s_frames++;
+}
+
+void vcdc_rx_error_cb(vcdc_rx_error_t error, uint8_t command, uint32_t arg)
+{
+    (void)command;
+    (void)arg;
+    fprintf(stderr, "unexpected rx error %d\n", error);
+    exit(EXIT_FAILURE);
+}
+
+void vcdc_rx_text_cb(uint8_t byte)
+{
+    (void)byte;
+    s_text_bytes++;
+}
+
+// ==================== RX FIFO 모델 ====================
+
+static uint8_t  s_fifo[FIFO_SIZE];
+static uint32_t s_rd, s_count;
+
+static void fifo_write(const uint8_t *data, uint32_t len)
+{
+    uint32_t wr = (s_rd + s_count) % FIFO_SIZE;
+    uint32_t n = (len < FIFO_SIZE - wr) ? len : FIFO_SIZE - wr;
+    memcpy(&s_fifo[wr], data, n);
+    memcpy(s_fifo, data + n, len - n);
+    s_count += len;
+}
+
+/** tud_cdc_read(): FIFO에서 복사하며 소비 */
+static uint32_t fifo_read(uint8_t *out, uint32_t max)
+{
+    uint32_t len = (s_count < max) ? s_count : max;
+    uint32_t n = (len < FIFO_SIZE - s_rd) ? len : FIFO_SIZE - s_rd;
+    memcpy(out, &s_fifo[s_rd], n);
+    memcpy(out + n, s_fifo, len - n);
+    s_rd = (s_rd + len) % FIFO_SIZE;
+    s_count -= len;
+    return len;
+}
+
+/** 이전 RX 콜백: 64바이트 스택 버퍼로 복사 후 바이트 단위 분류 */
+static void rx_cb_copy(int64_t now_us)
+{
+    uint8_t buf[64];
+    uint32_t count;
+
+    while (s_count > 0) {
+        count = fifo_read(buf, sizeof(buf));
+
+        for (uint32_t i = 0; i < count; i++) {
+            uint8_t byte = buf[i];
+            bool parser_was_active = vcdc_rx_is_active();
+            vcdc_rx_feed(&byte, 1, now_us);
+            if (parser_was_active || byte == VCDC_FRAME_HEADER) {
+                continue;
+            }
+            vcdc_rx_text_cb(byte);
+        }
+    }
+}
+
+/** 현재 RX 콜백: FIFO 영역을 제자리 파싱하고 소비한 만큼만 advance */
+static void rx_cb_in_place(int64_t now_us)
+{
+    while (s_count > 0) {
+        uint32_t len_lin  = (s_rd + s_count <= FIFO_SIZE) ? s_count : FIFO_SIZE - s_rd;
+        uint32_t len_wrap = s_count - len_lin;
+
+        uint32_t used = vcdc_rx_process_span(&s_fifo[s_rd], len_lin, len_wrap > 0, now_us);
+        if (used == len_lin && len_wrap > 0) {
+            used += vcdc_rx_process_span(s_fifo, len_wrap, false, now_us);
+        }
+
+        s_rd = (s_rd + used) % FIFO_SIZE;
+        s_count -= used;
+
+        if (used < len_lin + len_wrap) {
+            break;
+        }
+    }
+}
+
+// ==================== 벤치마크 ====================
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/** 프레임 반복 스트림 작성 (vendor_cdc_send_frame과 같은 형식) */
+static uint32_t build_stream(uint8_t *out, uint32_t cap, uint16_t payload_len)
+{
+    uint8_t payload[VCDC_MAX_PAYLOAD_SIZE];
+    for (uint16_t i = 0; i < payload_len; i++) {
+        payload[i] = (uint8_t)(i * 7 + 1);     // 0xFF 없음
+    }
+    uint16_t crc = vendor_cdc_crc16(payload, payload_len);
+    uint32_t frame_len = VCDC_FRAME_OVERHEAD + payload_len;
+    uint32_t n = 0;
+    while (n + frame_len <= cap) {
+        out[n++] = VCDC_FRAME_HEADER;
+        out[n++] = 0x10;
+        out[n++] = (uint8_t)(payload_len & 0xFF);
+        out[n++] = (uint8_t)(payload_len >> 8);
+        memcpy(&out[n], payload, payload_len);
+        n += payload_len;
+        out[n++] = (uint8_t)(crc & 0xFF);
+        out[n++] = (uint8_t)(crc >> 8);
+    }
+    return n;
+}
+
+/** 스트림을 bytes만큼 패킷 단위로 흘려 보내고 MB/s 반환 */
+static double run(void (*rx_cb)(int64_t), const uint8_t *stream, uint32_t stream_len,
+                  uint64_t bytes, uint32_t *frames)
+{
+    vcdc_rx_reset();
+    s_rd = s_count = 0;
+    s_frames = 0;
+    s_text_bytes = 0;
+
+    uint64_t sent = 0;
+    uint32_t pos = 0;
+    double start = now_sec();
+    while (sent < bytes) {
+        uint32_t n = stream_len - pos;
+        if (n > PACKET_SIZE) n = PACKET_SIZE;
+        fifo_write(&stream[pos], n);
+        rx_cb((int64_t)sent);  // 시각은 타임아웃이 나지 않게 단조 증가만
+        pos = (pos + n) % stream_len;
+        sent += n;
+    }
+    double elapsed = now_sec() - start;
+
+    *frames = s_frames;
+    if (s_text_bytes != 0) {
+        fprintf(stderr, "unexpected text bytes: %u\n", s_text_bytes);
+        exit(EXIT_FAILURE);
+    }
+    return (double)sent / elapsed / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t mb = (argc > 1) ? strtoull(argv[1], NULL, 10) : 64;
+    uint64_t bytes = mb * 1000 * 1000;
+
+    static uint8_t stream[64 * 1024];
+    const uint16_t payloads[] = { 0, 40, 128, VCDC_MAX_PAYLOAD_SIZE };
+
+    printf("CDC RX throughput (%llu MB per case, %d-byte packets, RX callback per packet)\n",
+           (unsigned long long)mb, PACKET_SIZE);
+    printf("payload    copy MB/s  in-place MB/s  frames\n");
+
+    for (size_t i = 0; i < sizeof(payloads) / sizeof(payloads[0]); i++) {
+        // 패킷 경계와 프레임 경계가 맞물리도록 스트림 길이를 패킷 크기의 배수로 맞춤
+        uint32_t frame_len = VCDC_FRAME_OVERHEAD + payloads[i];
+        uint32_t frames_per_stream = (uint32_t)(sizeof(stream) / frame_len);
+        while (frames_per_stream > 0 && (frames_per_stream * frame_len) % PACKET_SIZE != 0) {
+            frames_per_stream--;
+        }
+        uint32_t len = build_stream(stream, frames_per_stream * frame_len, payloads[i]);
+
+        uint32_t frames_copy, frames_in_place;
+        double copy     = run(rx_cb_copy, stream, len, bytes, &frames_copy);
+        double in_place = run(rx_cb_in_place, stream, len, bytes, &frames_in_place);
+        if (frames_copy != frames_in_place) {
+            fprintf(stderr, "frame count mismatch: %u vs %u\n", frames_copy, frames_in_place);
+            return EXIT_FAILURE;
+        }
+        printf("%5u B  %11.1f  %13.1f  %u\n", payloads[i], copy, in_place, frames_in_place);
+    }
+    return EXIT_SUCCESS;
+}
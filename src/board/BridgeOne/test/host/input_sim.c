@@ -0,0 +1,90 @@
+/**
+ * @file input_sim.c
+ * @brief 입력 트레이스 호스트 시뮬레이션 (결정적 회귀 실행)
+ *
+ * tools/inputtrace.py download로 받은 트레이스(input_trace_record_t 배열)의 프레임을
+ * 펌웨어와 같은 재생 커서(input_replay.c)와 포인터 다이나믹스(pointer_dynamics.c)에 통과시켜
+ * 프레임별 마우스 출력을 한 줄씩 출력합니다. 같은 트레이스와 설정이면 출력은 항상 같으므로
+ * 펌웨어 변경 전후 출력을 diff하여 회귀를 확인합니다.
+ *
+ *   input_sim trace.bin [preset] [counts_per_dp_q8] [max_idle_ms]
+ *
+ * 출력: "clock_us seq buttons x y wheel modifier keycode1 keycode2" (x, y는 다이나믹스 적용 후)
+ * 마지막 줄: "# frames N sum_x X sum_y Y"
+ *
+ * 하드웨어 hid_task와 달리 코얼레싱과 키보드 엔진 타이밍은 모델링하지 않습니다 (프레임 1개 = 리포트 1개).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "input_replay.h"
+#include "pointer_dynamics.h"
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s trace.bin [preset] [counts_per_dp_q8] [max_idle_ms]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    uint8_t  preset      = (argc > 2) ? (uint8_t)atoi(argv[2]) : POINTER_DYNAMICS_OFF;
+    uint16_t cpd_q8      = (argc > 3) ? (uint16_t)atoi(argv[3]) : POINTER_DYNAMICS_DEFAULT_COUNTS_PER_DP_Q8;
+    uint32_t max_idle_ms = (argc > 4) ? (uint32_t)atoi(argv[4]) : 1000;
+
+    FILE *fp = fopen(argv[1], "rb");
+    if (fp == NULL) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size < 0 || size % (long)sizeof(input_trace_record_t) != 0) {
+        fprintf(stderr, "%s: size %ld is not a multiple of %zu\n", argv[1], size,
+                sizeof(input_trace_record_t));
+        fclose(fp);
+        return EXIT_FAILURE;
+    }
+    uint32_t count = (uint32_t)(size / (long)sizeof(input_trace_record_t));
+    input_trace_record_t *records = malloc(count ? count * sizeof(input_trace_record_t) : 1);
+    if (records == NULL || fread(records, sizeof(input_trace_record_t), count, fp) != count) {
+        fprintf(stderr, "%s: read failed\n", argv[1]);
+        fclose(fp);
+        free(records);
+        return EXIT_FAILURE;
+    }
+    fclose(fp);
+
+    pointer_dynamics_t pd;
+    pointer_dynamics_init(&pd);
+    if (!pointer_dynamics_configure(&pd, preset, cpd_q8)) {
+        fprintf(stderr, "invalid preset %u / counts_per_dp_q8 %u\n", preset, cpd_q8);
+        free(records);
+        return EXIT_FAILURE;
+    }
+
+    // 원래 속도 여부는 출력에 영향이 없음 (시각은 clock_us만 사용)
+    input_replay_t r;
+    input_replay_init(&r, records, count, 0, max_idle_ms * 1000u);
+
+    const input_trace_record_t *f;
+    uint64_t due_us, clock_us;
+    int64_t sum_x = 0, sum_y = 0;
+    while (input_replay_next(&r, &f, &due_us, &clock_us)) {
+        int32_t dx = (int8_t)f->data[INPUT_FRAME_X];
+        int32_t dy = (int8_t)f->data[INPUT_FRAME_Y];
+        int32_t x = 0, y = 0;
+        if (dx != 0 || dy != 0) {
+            pointer_dynamics_apply(&pd, dx, dy, (int64_t)clock_us, &x, &y);
+        }
+        sum_x += x;
+        sum_y += y;
+        printf("%llu %u %u %d %d %d %u %u %u\n", (unsigned long long)clock_us,
+               f->data[INPUT_FRAME_SEQ], f->data[INPUT_FRAME_BUTTONS] & INPUT_FRAME_BUTTONS_MASK,
+               x, y, (int8_t)f->data[INPUT_FRAME_WHEEL], f->data[INPUT_FRAME_MODIFIER],
+               f->data[INPUT_FRAME_KEYCODE1], f->data[INPUT_FRAME_KEYCODE2]);
+    }
+    printf("# frames %u sum_x %lld sum_y %lld\n", r.frames, (long long)sum_x, (long long)sum_y);
+
+    free(records);
+    return EXIT_SUCCESS;
+}
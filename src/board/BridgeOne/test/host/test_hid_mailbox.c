@@ -0,0 +1,210 @@
+/**
+ * @file test_hid_mailbox.c
+ * @brief hid_mailbox.c 호스트 단위 테스트
+ *
+ * 펌웨어에서는 Core 0 생산자(hid_task, esp_timer 태스크)와 Core 1 소비자(TinyUSB 태스크)가
+ * 동시에 접근하므로, 마지막 테스트는 pthread로 생산자 여럿 + 소비자 1개를 돌려
+ * 유실/중복/순서 뒤바뀜이 없는지 확인합니다.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hid_mailbox.h"
+
+// ==================== 최소 테스트 하네스 ====================
+
+static int s_failures = 0;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__);             \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+        s_failures++;                                           \
+    }                                                           \
+} while (0)
+
+// ==================== 단일 스레드 ====================
+
+/** 게시 순서대로 꺼내지고, 본문/Report ID/길이가 그대로 전달됨 */
+static void test_fifo_order_and_payload(void)
+{
+    static hid_mailbox_t mb;
+    hid_mailbox_init(&mb);
+
+    CHECK(hid_mailbox_peek(&mb) == NULL, "new mailbox must be empty");
+
+    for (uint8_t i = 0; i < 5; i++) {
+        uint8_t report[7] = { i, (uint8_t)(i + 1), 0, 0, 0, 0, 0xAA };
+        CHECK(hid_mailbox_publish(&mb, 2, report, sizeof(report), 100 + i), "publish %u", i);
+    }
+    CHECK(hid_mailbox_pending(&mb) == 5, "pending=%u", hid_mailbox_pending(&mb));
+
+    for (uint8_t i = 0; i < 5; i++) {
+        const hid_mailbox_slot_t *slot = hid_mailbox_peek(&mb);
+        CHECK(slot != NULL, "slot %u missing", i);
+        if (slot == NULL) return;
+        CHECK(slot->report_id == 2 && slot->len == 7, "header id=%u len=%u", slot->report_id, slot->len);
+        CHECK(slot->data[0] == i && slot->data[1] == i + 1 && slot->data[6] == 0xAA,
+              "payload mismatch at %u", i);
+        // peek는 제거하지 않음
+        CHECK(hid_mailbox_peek(&mb) == slot, "peek must not consume");
+        hid_mailbox_pop(&mb, 110 + i);
+    }
+    CHECK(hid_mailbox_peek(&mb) == NULL, "mailbox must be empty after pops");
+
+    hid_mailbox_stats_t st;
+    hid_mailbox_get_stats(&mb, &st);
+    CHECK(st.published == 5 && st.submitted == 5 && st.pending == 0 && st.dropped == 0,
+          "stats pub=%u sub=%u pend=%u drop=%u", st.published, st.submitted, st.pending, st.dropped);
+    CHECK(st.latency_avg_us == 10 && st.latency_max_us == 10,
+          "latency avg=%lld max=%lld", (long long)st.latency_avg_us, (long long)st.latency_max_us);
+}
+
+/** 가득 차면 새 리포트를 버리고(기존 리포트 유지) dropped를 센다 */
+static void test_full_drops_newest(void)
+{
+    static hid_mailbox_t mb;
+    hid_mailbox_init(&mb);
+
+    for (uint32_t i = 0; i < HID_MAILBOX_SLOTS; i++) {
+        uint8_t v = (uint8_t)i;
+        CHECK(hid_mailbox_publish(&mb, 1, &v, 1, 0), "publish %u", i);
+    }
+    uint8_t extra = 0xFF;
+    CHECK(!hid_mailbox_publish(&mb, 1, &extra, 1, 0), "publish into full mailbox must fail");
+    CHECK(!hid_mailbox_publish(&mb, 1, &extra, 1, 0), "publish into full mailbox must fail");
+
+    hid_mailbox_stats_t st;
+    hid_mailbox_get_stats(&mb, &st);
+    CHECK(st.dropped == 2 && st.pending == HID_MAILBOX_SLOTS, "drop=%u pend=%u", st.dropped, st.pending);
+
+    // 하나 꺼내면 다시 게시 가능, 순서 유지
+    const hid_mailbox_slot_t *slot = hid_mailbox_peek(&mb);
+    CHECK(slot != NULL && slot->data[0] == 0, "oldest report must survive");
+    hid_mailbox_pop(&mb, 0);
+    CHECK(hid_mailbox_publish(&mb, 1, &extra, 1, 0), "publish after pop");
+    for (uint32_t i = 1; i <= HID_MAILBOX_SLOTS; i++) {
+        slot = hid_mailbox_peek(&mb);
+        uint8_t expect = (i == HID_MAILBOX_SLOTS) ? 0xFF : (uint8_t)i;
+        CHECK(slot != NULL && slot->data[0] == expect, "order after refill at %u", i);
+        if (slot == NULL) return;
+        hid_mailbox_pop(&mb, 0);
+    }
+}
+
+/** 최대 길이를 넘는 리포트는 거부 */
+static void test_oversized_report_rejected(void)
+{
+    static hid_mailbox_t mb;
+    hid_mailbox_init(&mb);
+
+    uint8_t big[HID_MAILBOX_REPORT_MAX + 1] = {0};
+    CHECK(!hid_mailbox_publish(&mb, 1, big, sizeof(big), 0), "oversized report must be rejected");
+    CHECK(hid_mailbox_pending(&mb) == 0, "rejected report must not occupy a slot");
+    CHECK(hid_mailbox_publish(&mb, 1, big, HID_MAILBOX_REPORT_MAX, 0), "max-size report accepted");
+}
+
+/** 여러 바퀴(슬롯 재사용) 돌아도 시퀀스가 어긋나지 않음 */
+static void test_many_laps(void)
+{
+    static hid_mailbox_t mb;
+    hid_mailbox_init(&mb);
+
+    uint32_t next_expected = 0;
+    for (uint32_t i = 0; i < HID_MAILBOX_SLOTS * 100; i++) {
+        CHECK(hid_mailbox_publish(&mb, 1, &i, sizeof(i), 0), "publish %u", i);
+        if (i % 3 == 2) {
+            // 가끔 몰아서 꺼내기
+            const hid_mailbox_slot_t *slot;
+            while ((slot = hid_mailbox_peek(&mb)) != NULL) {
+                uint32_t v;
+                memcpy(&v, slot->data, sizeof(v));
+                CHECK(v == next_expected, "expected %u got %u", next_expected, v);
+                next_expected++;
+                hid_mailbox_pop(&mb, 0);
+            }
+        }
+    }
+}
+
+// ==================== 다중 생산자 + 단일 소비자 ====================
+
+#define STRESS_PRODUCERS   3
+#define STRESS_PER_PRODUCER 200000
+
+static hid_mailbox_t s_stress_mb;
+
+static void *stress_producer(void *arg)
+{
+    uint32_t id = (uint32_t)(uintptr_t)arg;
+    for (uint32_t i = 0; i < STRESS_PER_PRODUCER; i++) {
+        uint32_t tag[2] = { id, i };
+        // 가득 차면 소비자가 비울 때까지 재시도 (유실 없이 전부 전달되는지 확인)
+        while (!hid_mailbox_publish(&s_stress_mb, (uint8_t)id, tag, sizeof(tag), 0)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void test_multi_producer_stress(void)
+{
+    hid_mailbox_init(&s_stress_mb);
+
+    pthread_t th[STRESS_PRODUCERS];
+    for (uintptr_t p = 0; p < STRESS_PRODUCERS; p++) {
+        pthread_create(&th[p], NULL, stress_producer, (void *)p);
+    }
+
+    uint32_t next[STRESS_PRODUCERS] = {0};
+    uint32_t received = 0;
+    int errors = 0;
+    while (received < STRESS_PRODUCERS * STRESS_PER_PRODUCER) {
+        const hid_mailbox_slot_t *slot = hid_mailbox_peek(&s_stress_mb);
+        if (slot == NULL) {
+            sched_yield();
+            continue;
+        }
+
+        uint32_t tag[2];
+        memcpy(tag, slot->data, sizeof(tag));
+        if (slot->len != sizeof(tag) || tag[0] >= STRESS_PRODUCERS ||
+            slot->report_id != tag[0] || tag[1] != next[tag[0]]) {
+            if (errors++ < 5) {
+                printf("stress: bad report len=%u id=%u tag=(%u,%u)\n",
+                       slot->len, slot->report_id, tag[0], tag[1]);
+            }
+        } else {
+            next[tag[0]]++;
+        }
+        hid_mailbox_pop(&s_stress_mb, 0);
+        received++;
+    }
+
+    for (int p = 0; p < STRESS_PRODUCERS; p++) {
+        pthread_join(th[p], NULL);
+        CHECK(next[p] == STRESS_PER_PRODUCER, "producer %d delivered %u", p, next[p]);
+    }
+    CHECK(errors == 0, "%d corrupted/out-of-order report(s)", errors);
+    CHECK(hid_mailbox_peek(&s_stress_mb) == NULL, "mailbox must be empty");
+}
+
+int main(void)
+{
+    test_fifo_order_and_payload();
+    test_full_drops_newest();
+    test_oversized_report_rejected();
+    test_many_laps();
+    test_multi_producer_stress();
+
+    if (s_failures != 0) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("hid_mailbox: all tests passed\n");
+    return EXIT_SUCCESS;
+}
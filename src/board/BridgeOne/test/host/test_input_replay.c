@@ -0,0 +1,204 @@
+/**
+ * @file test_input_replay.c
+ * @brief input_replay.c 호스트 단위 테스트
+ *
+ * 재생 커서의 시각 계산(배속, 랩어라운드, 유휴 압축)과,
+ * 재생 시각(clock_us)으로 포인터 다이나믹스를 돌린 결과가 배속과 무관하게 같은지 확인합니다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "input_replay.h"
+#include "pointer_dynamics.h"
+
+// ==================== 최소 테스트 하네스 ====================
+
+static int s_failures = 0;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__);             \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+        s_failures++;                                           \
+    }                                                           \
+} while (0)
+
+// ==================== 트레이스 작성 ====================
+
+static input_trace_record_t frame_rec(uint32_t ts_us, uint8_t seq, uint8_t buttons,
+                                      int8_t x, int8_t y, uint8_t keycode)
+{
+    input_trace_record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.ts_us = ts_us;
+    rec.kind  = INPUT_TRACE_FRAME;
+    rec.len   = INPUT_TRACE_DATA_MAX;
+    rec.data[INPUT_FRAME_SEQ]      = seq;
+    rec.data[INPUT_FRAME_BUTTONS]  = buttons;
+    rec.data[INPUT_FRAME_X]        = (uint8_t)x;
+    rec.data[INPUT_FRAME_Y]        = (uint8_t)y;
+    rec.data[INPUT_FRAME_KEYCODE1] = keycode;
+    return rec;
+}
+
+static input_trace_record_t report_rec(uint32_t ts_us, uint8_t kind)
+{
+    input_trace_record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.ts_us = ts_us;
+    rec.kind  = kind;
+    rec.len   = 7;
+    return rec;
+}
+
+// ==================== 테스트 ====================
+
+/** 리포트 레코드는 건너뛰고 프레임만 기록 순서대로 꺼냄 */
+static void test_skips_reports(void)
+{
+    input_trace_record_t recs[] = {
+        report_rec(10, INPUT_TRACE_MOUSE_REPORT),
+        frame_rec(100, 0, 0, 1, 0, 0),
+        report_rec(150, INPUT_TRACE_MOUSE_REPORT),
+        report_rec(160, INPUT_TRACE_KB_REPORT),
+        frame_rec(300, 1, 0, 2, 0, 0),
+    };
+    input_replay_t r;
+    input_replay_init(&r, recs, 5, 100, 0);
+
+    const input_trace_record_t *f;
+    uint64_t due, clock;
+    CHECK(input_replay_next(&r, &f, &due, &clock), "first frame");
+    CHECK(f == &recs[1] && due == 0 && clock == 0, "first frame at 0 (due=%llu)", (unsigned long long)due);
+    CHECK(input_replay_next(&r, &f, &due, &clock), "second frame");
+    CHECK(f == &recs[4] && due == 200 && clock == 200, "second frame at 200 (due=%llu)",
+          (unsigned long long)due);
+    CHECK(!input_replay_next(&r, &f, &due, &clock), "end of trace");
+    CHECK(r.frames == 2, "frame count %u", r.frames);
+}
+
+/** 배속은 due_us만 줄이고 clock_us는 기록 시각 그대로 */
+static void test_speed_scales_due_only(void)
+{
+    input_trace_record_t recs[] = {
+        frame_rec(1000, 0, 0, 1, 0, 0),
+        frame_rec(9000, 1, 0, 1, 0, 0),
+    };
+    const struct { uint16_t speed; uint64_t due; } cases[] = {
+        { 100, 8000 }, { 400, 2000 }, { 50, 16000 }, { 0, 0 },
+        { 1, 8000 * 100 / INPUT_REPLAY_SPEED_MIN },     // 범위 밖은 제한
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        input_replay_t r;
+        input_replay_init(&r, recs, 2, cases[i].speed, 0);
+        const input_trace_record_t *f;
+        uint64_t due, clock;
+        input_replay_next(&r, &f, &due, &clock);
+        input_replay_next(&r, &f, &due, &clock);
+        CHECK(clock == 8000, "speed %u: clock %llu", cases[i].speed, (unsigned long long)clock);
+        CHECK(due == cases[i].due, "speed %u: due %llu, expected %llu", cases[i].speed,
+              (unsigned long long)due, (unsigned long long)cases[i].due);
+    }
+}
+
+/** ts_us(esp_timer 하위 32비트) 랩어라운드를 넘어도 간격이 이어짐 */
+static void test_timestamp_wraparound(void)
+{
+    input_trace_record_t recs[] = {
+        frame_rec(0xFFFFF000u, 0, 0, 1, 0, 0),
+        frame_rec(0x00000800u, 1, 0, 1, 0, 0),
+    };
+    input_replay_t r;
+    input_replay_init(&r, recs, 2, 100, 0);
+    const input_trace_record_t *f;
+    uint64_t due, clock;
+    input_replay_next(&r, &f, &due, &clock);
+    input_replay_next(&r, &f, &due, &clock);
+    CHECK(clock == 0x1800, "wrapped gap %llu", (unsigned long long)clock);
+}
+
+/** 모두 뗀 상태의 긴 간격만 압축하고, 누른 채 유지한 간격은 그대로 */
+static void test_idle_compression_only_when_released(void)
+{
+    input_trace_record_t recs[] = {
+        frame_rec(0,        0, 0, 1, 0, 0),         // 모두 뗌
+        frame_rec(5000000,  1, 1, 0, 0, 0),         // 5초 유휴 후 좌버튼 누름
+        frame_rec(8000000,  2, 0, 0, 0, 0),         // 3초 드래그 유지 후 뗌
+        frame_rec(8100000,  3, 0, 0, 0, 0x04),      // 키 누름
+        frame_rec(10100000, 4, 0, 0, 0, 0),         // 2초 유지 (자동 반복 구간)
+    };
+    input_replay_t r;
+    input_replay_init(&r, recs, 5, 100, 1000000);
+
+    const uint64_t expected[] = { 0, 1000000, 4000000, 4100000, 6100000 };
+    const input_trace_record_t *f;
+    uint64_t due, clock;
+    for (int i = 0; i < 5; i++) {
+        CHECK(input_replay_next(&r, &f, &due, &clock), "frame %d", i);
+        CHECK(clock == expected[i], "frame %d: clock %llu, expected %llu", i,
+              (unsigned long long)clock, (unsigned long long)expected[i]);
+    }
+}
+
+/** 재생 시각으로 다이나믹스를 적용하면 배속과 관계없이 같은 출력 (결정적 회귀 실행) */
+static void test_dynamics_deterministic_across_speeds(void)
+{
+    enum { N = 200 };
+    static input_trace_record_t recs[N];
+    uint32_t ts = 123456;
+    for (int i = 0; i < N; i++) {
+        // 가감속이 섞인 이동 (8ms 주기, 가끔 긴 간격)
+        int8_t dx = (int8_t)((i % 40) - 10);
+        int8_t dy = (int8_t)((i * 7) % 23 - 11);
+        recs[i] = frame_rec(ts, (uint8_t)(i % 254), 0, dx, dy, 0);
+        ts += (i % 50 == 49) ? 150000 : 8000;
+    }
+
+    const uint16_t speeds[] = { 100, 250, 0 };
+    int32_t sum_x[3] = {0}, sum_y[3] = {0};
+    uint32_t digest[3] = {0};
+
+    for (int s = 0; s < 3; s++) {
+        pointer_dynamics_t pd;
+        pointer_dynamics_init(&pd);
+        pointer_dynamics_configure(&pd, POINTER_DYNAMICS_STANDARD, 384);
+
+        input_replay_t r;
+        input_replay_init(&r, recs, N, speeds[s], 1000000);
+        const input_trace_record_t *f;
+        uint64_t due, clock;
+        const int64_t base_us = 1000000 * (s + 1);    // 재생 시작 시각은 실행마다 다름
+        while (input_replay_next(&r, &f, &due, &clock)) {
+            int32_t ox, oy;
+            pointer_dynamics_apply(&pd, (int8_t)f->data[INPUT_FRAME_X], (int8_t)f->data[INPUT_FRAME_Y],
+                                   base_us + (int64_t)clock, &ox, &oy);
+            sum_x[s] += ox;
+            sum_y[s] += oy;
+            digest[s] = digest[s] * 31u + (uint32_t)(ox * 256 + oy);
+        }
+    }
+
+    for (int s = 1; s < 3; s++) {
+        CHECK(digest[s] == digest[0] && sum_x[s] == sum_x[0] && sum_y[s] == sum_y[0],
+              "speed %u output differs from 100%% (%d,%d vs %d,%d)",
+              speeds[s], sum_x[s], sum_y[s], sum_x[0], sum_y[0]);
+    }
+}
+
+int main(void)
+{
+    test_skips_reports();
+    test_speed_scales_due_only();
+    test_timestamp_wraparound();
+    test_idle_compression_only_when_released();
+    test_dynamics_deterministic_across_speeds();
+
+    if (s_failures != 0) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("input_replay: all tests passed\n");
+    return EXIT_SUCCESS;
+}
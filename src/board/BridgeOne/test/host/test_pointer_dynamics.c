@@ -0,0 +1,244 @@
+/**
+ * @file test_pointer_dynamics.c
+ * @brief pointer_dynamics.c 호스트 단위 테스트
+ *
+ * 기준 곡선은 Android DeltaCalculator.applyPointerDynamics()를 그대로 옮긴 double 구현입니다.
+ * 프리셋 파라미터는 ui/common/PointerDynamicsConstants.kt의 DYNAMICS_PRESETS와 같아야 합니다.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "pointer_dynamics.h"
+
+// ==================== 최소 테스트 하네스 ====================
+
+static int s_failures = 0;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__);             \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+        s_failures++;                                           \
+    }                                                           \
+} while (0)
+
+// ==================== Kotlin 기준 곡선 ====================
+
+typedef enum { ALG_NONE, ALG_WINDOWS_EPP, ALG_LINEAR } ref_algorithm_t;
+
+typedef struct {
+    const char     *name;
+    ref_algorithm_t algorithm;
+    double          intensity;
+    double          threshold_dp_ms;
+    double          max_multiplier;
+} ref_preset_t;
+
+static const ref_preset_t REF_PRESETS[POINTER_DYNAMICS_PRESET_COUNT] = {
+    { "Off",       ALG_NONE,        1.0, 0.5, 1.0 },
+    { "Precision", ALG_WINDOWS_EPP, 0.8, 0.6, 2.5 },
+    { "Standard",  ALG_WINDOWS_EPP, 1.2, 0.5, 3.0 },
+    { "Fast",      ALG_LINEAR,      1.5, 0.4, 4.0 },
+};
+
+static double ref_multiplier(const ref_preset_t *p, double v)
+{
+    double m = 1.0;
+    switch (p->algorithm) {
+    case ALG_NONE:
+        break;
+    case ALG_WINDOWS_EPP:
+        if (v >= p->threshold_dp_ms) {
+            double x = (v / p->threshold_dp_ms - 1.0) * 2.0;
+            m = 1.0 + p->intensity / (1.0 + exp(-x));
+        }
+        break;
+    case ALG_LINEAR: {
+        double excess = (v - p->threshold_dp_ms) / p->threshold_dp_ms;
+        m = 1.0 + p->intensity * (excess > 0.0 ? excess : 0.0);
+        break;
+    }
+    }
+    if (m < 1.0) m = 1.0;
+    if (m > p->max_multiplier) m = p->max_multiplier;
+    return m;
+}
+
+static uint32_t to_q16(double v)
+{
+    return (uint32_t)llround(v * 65536.0);
+}
+
+// ==================== 테스트 ====================
+
+/** LUT 보간 배율이 0 ~ 8 dp/ms 전 구간에서 Kotlin 곡선과 일치 */
+static void test_multiplier_matches_kotlin_curve(void)
+{
+    for (uint8_t id = 0; id < POINTER_DYNAMICS_PRESET_COUNT; id++) {
+        const ref_preset_t *p = &REF_PRESETS[id];
+        for (int i = 0; i <= 8000; i++) {
+            double v = i / 1000.0;
+            if (fabs(v - p->threshold_dp_ms) < 0.001) {
+                continue;  // 임계값 경계는 Q16 반올림에 따라 어느 쪽이든 허용
+            }
+            double expected = ref_multiplier(p, v);
+            double actual = pointer_dynamics_multiplier_q16(id, to_q16(v)) / 65536.0;
+            CHECK(fabs(actual - expected) < 0.002,
+                  "%s v=%.3f expected=%.5f actual=%.5f", p->name, v, expected, actual);
+        }
+    }
+}
+
+/** 범위 밖 프리셋은 가속 없음 */
+static void test_invalid_preset_is_identity(void)
+{
+    CHECK(pointer_dynamics_multiplier_q16(POINTER_DYNAMICS_PRESET_COUNT, to_q16(3.0)) == POINTER_DYNAMICS_Q16_ONE,
+          "invalid preset must return 1.0");
+
+    pointer_dynamics_t pd;
+    pointer_dynamics_init(&pd);
+    CHECK(!pointer_dynamics_configure(&pd, POINTER_DYNAMICS_PRESET_COUNT, 256), "invalid preset accepted");
+    CHECK(!pointer_dynamics_configure(&pd, POINTER_DYNAMICS_FAST, 0), "zero scale accepted");
+    CHECK(pd.preset_id == POINTER_DYNAMICS_OFF, "config changed by rejected call");
+}
+
+/** Off 프리셋: 입력 그대로 출력 (누산 잔여 없음) */
+static void test_off_passes_raw_delta(void)
+{
+    pointer_dynamics_t pd;
+    pointer_dynamics_init(&pd);
+    int64_t t = 0;
+    for (int i = 0; i < 50; i++) {
+        int32_t ox, oy;
+        int32_t dx = (i % 7) - 3;
+        int32_t dy = 40 - i;
+        pointer_dynamics_apply(&pd, dx, dy, t, &ox, &oy);
+        CHECK(ox == dx && oy == dy, "frame %d: in=(%d,%d) out=(%d,%d)", i, dx, dy, ox, oy);
+        t += 8000;
+    }
+}
+
+/**
+ * 등속 스트림: 출력 누적이 Kotlin 곡선의 정확한(실수) 누적과 1카운트 이내로 일치.
+ * 속도 추정 방식(윈도우 합/시간폭)도 Android와 동일하게 재현합니다.
+ */
+static void test_stream_total_matches_kotlin(void)
+{
+    const double counts_per_dp = 2.75;  // 밀도 2.75, DPI 1.0
+    const int32_t dx = 3, dy = 1;
+    const int64_t period_us = 8000;
+
+    for (uint8_t id = 0; id < POINTER_DYNAMICS_PRESET_COUNT; id++) {
+        const ref_preset_t *p = &REF_PRESETS[id];
+        pointer_dynamics_t pd;
+        pointer_dynamics_init(&pd);
+        CHECK(pointer_dynamics_configure(&pd, id, (uint16_t)lround(counts_per_dp * 256)), "configure");
+
+        double ref_x = 0.0, ref_y = 0.0;
+        int64_t out_x = 0, out_y = 0;
+        double dist_dp = sqrt((double)(dx * dx + dy * dy)) / counts_per_dp;
+
+        for (int i = 0; i < 60; i++) {
+            int64_t now = i * period_us;
+            // Android: 윈도우(100ms) 내 샘플 수 n → 속도 = n × dist / ((n-1) × period)
+            int n = (int)(POINTER_DYNAMICS_WINDOW_US / period_us) + 1;
+            if (n > i + 1) n = i + 1;
+            double v = (n >= 2) ? (n * dist_dp) / ((n - 1) * period_us / 1000.0) : 0.0;
+            double m = ref_multiplier(p, v);
+            ref_x += dx * m;
+            ref_y += dy * m;
+
+            int32_t ox, oy;
+            pointer_dynamics_apply(&pd, dx, dy, now, &ox, &oy);
+            out_x += ox;
+            out_y += oy;
+        }
+        CHECK(fabs(out_x - ref_x) <= 1.0 && fabs(out_y - ref_y) <= 1.0,
+              "%s total expected=(%.2f,%.2f) actual=(%lld,%lld)",
+              p->name, ref_x, ref_y, (long long)out_x, (long long)out_y);
+    }
+}
+
+/** 서브픽셀 누산: 1카운트 미만 이동도 누적되어 전송됨 */
+static void test_subpixel_carry(void)
+{
+    pointer_dynamics_t pd;
+    pointer_dynamics_init(&pd);
+    CHECK(pointer_dynamics_configure(&pd, POINTER_DYNAMICS_STANDARD, 256), "configure");
+
+    // 속도 1.5 dp/ms 근처: 배율 ≈ 2.18 → 3카운트 입력이 6.5카운트 정도
+    int64_t total = 0;
+    double expected = 0.0;
+    for (int i = 0; i < 200; i++) {
+        int32_t ox, oy;
+        pointer_dynamics_apply(&pd, 3, 0, (int64_t)i * 2000, &ox, &oy);
+        total += ox;
+        CHECK(oy == 0, "no Y motion expected");
+        uint32_t m = pointer_dynamics_multiplier_q16(POINTER_DYNAMICS_STANDARD,
+                                                     pointer_dynamics_velocity_q16(&pd));
+        expected += 3.0 * m / 65536.0;
+    }
+    CHECK(fabs(total - expected) < 1.0, "carry lost: expected=%.2f actual=%lld", expected, (long long)total);
+}
+
+/** ±127 초과분은 버려지지 않고 drain으로 이어서 전송 */
+static void test_clamp_overflow_is_carried(void)
+{
+    pointer_dynamics_t pd;
+    pointer_dynamics_init(&pd);
+    CHECK(pointer_dynamics_configure(&pd, POINTER_DYNAMICS_FAST, 256), "configure");
+
+    int32_t ox, oy;
+    pointer_dynamics_apply(&pd, 100, -100, 0, &ox, &oy);          // 첫 샘플: 속도 0 → 배율 1
+    CHECK(ox == 100 && oy == -100, "first sample must be unaccelerated (%d,%d)", ox, oy);
+
+    pointer_dynamics_apply(&pd, 100, -100, 8000, &ox, &oy);       // 고속: 배율 4.0 → 400
+    CHECK(ox == 127 && oy == -127, "clamped output expected (%d,%d)", ox, oy);
+
+    int64_t rest_x = 0, rest_y = 0;
+    int guard = 0;
+    while (pointer_dynamics_drain(&pd, &ox, &oy) && guard++ < 10) {
+        rest_x += ox;
+        rest_y += oy;
+    }
+    CHECK(rest_x == 400 - 127 && rest_y == -(400 - 127),
+          "carried remainder expected 273 got (%lld,%lld)", (long long)rest_x, (long long)rest_y);
+}
+
+/** 윈도우보다 긴 입력 공백 후에는 속도 0에서 다시 시작 */
+static void test_gap_resets_velocity(void)
+{
+    pointer_dynamics_t pd;
+    pointer_dynamics_init(&pd);
+    CHECK(pointer_dynamics_configure(&pd, POINTER_DYNAMICS_FAST, 256), "configure");
+
+    int32_t ox, oy;
+    for (int i = 0; i < 10; i++) {
+        pointer_dynamics_apply(&pd, 20, 0, (int64_t)i * 8000, &ox, &oy);
+    }
+    CHECK(pointer_dynamics_velocity_q16(&pd) > to_q16(1.0), "fast motion expected");
+
+    pointer_dynamics_apply(&pd, 2, 0, 9 * 8000 + POINTER_DYNAMICS_WINDOW_US + 1, &ox, &oy);
+    CHECK(pointer_dynamics_velocity_q16(&pd) == 0, "velocity must reset after gap");
+    CHECK(ox == 2, "first sample after gap must be unaccelerated (%d)", ox);
+}
+
+int main(void)
+{
+    test_multiplier_matches_kotlin_curve();
+    test_invalid_preset_is_identity();
+    test_off_passes_raw_delta();
+    test_stream_total_matches_kotlin();
+    test_subpixel_carry();
+    test_clamp_overflow_is_carried();
+    test_gap_resets_velocity();
+
+    if (s_failures != 0) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("pointer_dynamics: all tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,307 @@
+/**
+ * @file test_vcdc_rx.c
+ * @brief vcdc_rx.c 호스트 단위 테스트
+ *
+ * 펌웨어 tud_cdc_rx_cb()와 같은 방식(RX FIFO 선형/래핑 영역을 넘기고 소비한 만큼만 advance)으로
+ * 작은 링 버퍼를 구동하여 텍스트/프레임 분류, 제자리 파싱, 래핑 경계 조립, 재동기화를 확인합니다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vcdc_rx.h"
+
+// ==================== 최소 테스트 하네스 ====================
+
+static int s_failures = 0;
+
+#define CHECK(cond, ...) do {                                   \
+    if (!(cond)) {                                              \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__);             \
+        printf(__VA_ARGS__);                                    \
+        printf("\n");                                           \
+        s_failures++;                                           \
+    }                                                           \
+} while (0)
+
+// ==================== vcdc_rx 콜백 (펌웨어: vendor_cdc_handler.c, usb_cdc_log.c) ====================
+
+#define POOL_SIZE 2
+
+static uint8_t  s_pool[POOL_SIZE][VCDC_MAX_PAYLOAD_SIZE];
+static bool     s_pool_used[POOL_SIZE];
+
+static uint32_t s_frames;
+static uint8_t  s_last_cmd;
+static uint16_t s_last_len;
+static uint8_t  s_last_payload[VCDC_MAX_PAYLOAD_SIZE];
+static uint32_t s_errors[VCDC_RX_ERR_NO_BUFFER + 1];
+static char     s_text[64];
+static uint32_t s_text_len;
+
+int8_t vcdc_rx_acquire_cb(uint8_t **payload)
+{
+    for (int8_t i = 0; i < POOL_SIZE; i++) {
+        if (!s_pool_used[i]) {
+            s_pool_used[i] = true;
+            *payload = s_pool[i];
+            return i;
+        }
+    }
+    *payload = NULL;
+    return -1;
+}
+
+void vcdc_rx_release_cb(int8_t idx)
+{
+    s_pool_used[idx] = false;
+}
+
+void vcdc_rx_frame_cb(uint8_t command, const uint8_t *payload, uint16_t payload_len,
+                      uint16_t crc16, int8_t idx)
+{
+    (void)crc16;
+    s_frames++;
+    s_last_cmd = command;
+    s_last_len = payload_len;
+    memcpy(s_last_payload, payload, payload_len);
+    if (idx >= 0) {
+        vcdc_rx_release_cb(idx);
+    }
+}
+
+void vcdc_rx_error_cb(vcdc_rx_error_t error, uint8_t command, uint32_t arg)
+{
+    (void)command;
+    (void)arg;
+    s_errors[error]++;
+}
+
+void vcdc_rx_text_cb(uint8_t byte)
+{
+    if (s_text_len < sizeof(s_text) - 1) {
+        s_text[s_text_len++] = (char)byte;
+    }
+}
+
+// ==================== RX FIFO 모델 ====================
+
+#define FIFO_SIZE 512
+
+static uint8_t  s_fifo[FIFO_SIZE];
+static uint32_t s_rd, s_count;
+
+static void reset_all(void)
+{
+    vcdc_rx_reset();
+    memset(s_pool_used, 0, sizeof(s_pool_used));
+    memset(s_errors, 0, sizeof(s_errors));
+    s_frames = 0;
+    s_last_cmd = 0;
+    s_last_len = 0;
+    s_text_len = 0;
+    memset(s_text, 0, sizeof(s_text));
+    s_rd = 0;
+    s_count = 0;
+}
+
+/** 읽기 위치를 옮겨 다음 데이터가 FIFO 끝에서 래핑되게 함 (비어 있을 때만) */
+static void fifo_seek(uint32_t pos)
+{
+    s_rd = pos % FIFO_SIZE;
+}
+
+/** 호스트 OUT 패킷 도착 → tud_cdc_rx_cb()와 같은 루프 */
+static void rx_packet(const uint8_t *data, uint32_t len, int64_t now_us)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        s_fifo[(s_rd + s_count + i) % FIFO_SIZE] = data[i];
+    }
+    s_count += len;
+
+    while (s_count > 0) {
+        uint32_t len_lin  = (s_rd + s_count <= FIFO_SIZE) ? s_count : FIFO_SIZE - s_rd;
+        uint32_t len_wrap = s_count - len_lin;
+
+        uint32_t used = vcdc_rx_process_span(&s_fifo[s_rd], len_lin, len_wrap > 0, now_us);
+        if (used == len_lin && len_wrap > 0) {
+            used += vcdc_rx_process_span(&s_fifo[0], len_wrap, false, now_us);
+        }
+
+        s_rd = (s_rd + used) % FIFO_SIZE;
+        s_count -= used;
+
+        if (used < len_lin + len_wrap) {
+            break;  // 미완성 프레임
+        }
+    }
+}
+
+/** 프레임 직렬화 (vendor_cdc_send_frame과 같은 형식) */
+static uint32_t build_frame(uint8_t *out, uint8_t command, const uint8_t *payload, uint16_t len)
+{
+    uint16_t crc = vendor_cdc_crc16(payload, len);
+    out[0] = VCDC_FRAME_HEADER;
+    out[1] = command;
+    out[2] = (uint8_t)(len & 0xFF);
+    out[3] = (uint8_t)(len >> 8);
+    memcpy(&out[4], payload, len);
+    out[4 + len] = (uint8_t)(crc & 0xFF);
+    out[5 + len] = (uint8_t)(crc >> 8);
+    return VCDC_FRAME_OVERHEAD + len;
+}
+
+// ==================== 테스트 ====================
+
+/** CRC16-CCITT 기준값 (Windows 서버 C# 구현과 같은 결과) */
+static void test_crc16_reference(void)
+{
+    const uint8_t check[] = "123456789";
+    CHECK(vendor_cdc_crc16(check, 9) == 0x31C3, "crc16(123456789)=0x%04X", vendor_cdc_crc16(check, 9));
+    CHECK(vendor_cdc_crc16(NULL, 0) == 0x0000, "crc16(empty)");
+}
+
+/** 텍스트와 프레임이 섞인 패킷: 텍스트는 텍스트 콜백으로, 프레임은 제자리 파싱으로 전달 */
+static void test_text_and_frame(void)
+{
+    reset_all();
+    uint8_t pkt[64];
+    const char *text = "mem\r";
+    memcpy(pkt, text, 4);
+    const uint8_t payload[] = { 'p', 'i', 'n', 'g' };
+    uint32_t n = 4 + build_frame(&pkt[4], 0x10, payload, sizeof(payload));
+    pkt[n++] = 'x';
+
+    rx_packet(pkt, n, 1000);
+    CHECK(s_frames == 1 && s_last_cmd == 0x10 && s_last_len == 4, "frame not delivered");
+    CHECK(memcmp(s_last_payload, payload, 4) == 0, "payload mismatch");
+    CHECK(strcmp(s_text, "mem\rx") == 0, "text '%s'", s_text);
+    CHECK(s_count == 0, "fifo not drained (%u)", s_count);
+}
+
+/** 패킷 여러 개로 나뉜 프레임: 다 도착할 때까지 FIFO에 남겨 두었다가 전달 */
+static void test_frame_split_across_packets(void)
+{
+    reset_all();
+    uint8_t payload[100];
+    for (int i = 0; i < 100; i++) payload[i] = (uint8_t)i;
+    uint8_t frame[VCDC_MAX_FRAME_SIZE];
+    uint32_t n = build_frame(frame, 0x30, payload, sizeof(payload));
+
+    rx_packet(frame, 2, 0);             // 길이 필드도 아직 없음
+    rx_packet(&frame[2], 60, 400000);   // 직전 도착 후 400ms
+    CHECK(s_frames == 0 && s_count == 62, "must wait for the rest (frames=%u count=%u)", s_frames, s_count);
+    rx_packet(&frame[62], n - 62, 800000);  // 첫 도착 후 800ms지만 직전 도착 후 400ms
+    CHECK(s_frames == 1 && s_last_len == 100, "split frame not delivered");
+    CHECK(s_errors[VCDC_RX_ERR_TIMEOUT] == 0, "no timeout expected");
+}
+
+/** 잘린 헤더(FF 01 10 00) 뒤로 500ms 넘게 아무것도 없으면 버리고 다음 프레임/텍스트를 받음 */
+static void test_stale_header_resync(void)
+{
+    reset_all();
+    const uint8_t stale[] = { 0xFF, 0x01, 0x10, 0x00 };
+    rx_packet(stale, sizeof(stale), 0);
+    CHECK(s_count == 4, "stale header kept in fifo while waiting");
+
+    uint8_t pkt[64];
+    const uint8_t payload[] = { 1, 2, 3 };
+    uint32_t n = build_frame(pkt, 0x10, payload, sizeof(payload));
+    memcpy(&pkt[n], "ok\r", 3);
+    n += 3;
+
+    rx_packet(pkt, n, 600000);
+    CHECK(s_errors[VCDC_RX_ERR_TIMEOUT] == 1, "timeout count %u", s_errors[VCDC_RX_ERR_TIMEOUT]);
+    CHECK(s_errors[VCDC_RX_ERR_CRC] == 0, "valid frame must not be absorbed into the stale one");
+    CHECK(s_frames == 1 && s_last_cmd == 0x10 && s_last_len == 3, "valid frame not delivered");
+    CHECK(s_text_len == 6 && memcmp(s_text, "\x01\x10\x00ok\r", 6) == 0,
+          "bytes after the dropped header must be text (%u bytes)", s_text_len);
+    CHECK(s_count == 0, "fifo not drained (%u)", s_count);
+}
+
+/** 500ms 안에 이어지면 헤더를 버리지 않음 (헤더만 먼저 도착) */
+static void test_header_within_timeout_kept(void)
+{
+    reset_all();
+    uint8_t frame[32];
+    const uint8_t payload[] = { 9, 8, 7, 6 };
+    uint32_t n = build_frame(frame, 0x05, payload, sizeof(payload));
+    rx_packet(frame, 1, 0);
+    rx_packet(&frame[1], n - 1, 499000);
+    CHECK(s_frames == 1 && s_errors[VCDC_RX_ERR_TIMEOUT] == 0, "frame within timeout dropped");
+}
+
+/** FIFO 래핑 경계에 걸친 프레임은 바이트 단위 상태 머신으로 조립 */
+static void test_frame_across_fifo_wrap(void)
+{
+    reset_all();
+    fifo_seek(FIFO_SIZE - 10);
+    uint8_t payload[64];
+    for (int i = 0; i < 64; i++) payload[i] = (uint8_t)(0xA0 + i);
+    uint8_t frame[VCDC_MAX_FRAME_SIZE];
+    uint32_t n = build_frame(frame, 0x40, payload, sizeof(payload));
+
+    rx_packet(frame, n, 0);
+    CHECK(s_frames == 1 && s_last_len == 64 && memcmp(s_last_payload, payload, 64) == 0,
+          "wrapped frame not delivered");
+    CHECK(!s_pool_used[0] && !s_pool_used[1], "assembly buffer not returned");
+    CHECK(!vcdc_rx_is_active(), "parser must be idle");
+}
+
+/** 래핑 경계 조립 중 500ms 끊기면 리셋하고 다음 프레임을 받음 */
+static void test_bytewise_timeout(void)
+{
+    reset_all();
+    fifo_seek(FIFO_SIZE - 6);
+    uint8_t frame[64];
+    const uint8_t payload[20] = { 0 };
+    uint32_t n = build_frame(frame, 0x41, payload, sizeof(payload));
+    rx_packet(frame, 12, 0);            // 래핑 영역까지 넘어가 바이트 단위 조립 중
+    CHECK(vcdc_rx_is_active(), "parser must be assembling");
+
+    uint8_t next[64];
+    uint32_t m = build_frame(next, 0x42, payload, 4);
+    rx_packet(next, m, 700000);
+    CHECK(s_errors[VCDC_RX_ERR_TIMEOUT] == 1, "timeout count %u", s_errors[VCDC_RX_ERR_TIMEOUT]);
+    CHECK(s_frames == 1 && s_last_cmd == 0x42, "next frame not delivered");
+    CHECK(!s_pool_used[0] && !s_pool_used[1], "assembly buffer leaked");
+    (void)n;
+}
+
+/** CRC 오류는 전달하지 않고, 최대 길이 초과 헤더는 건너뜀 */
+static void test_crc_error_and_oversize(void)
+{
+    reset_all();
+    uint8_t pkt[64];
+    const uint8_t payload[] = { 1, 2 };
+    uint32_t n = build_frame(pkt, 0x10, payload, sizeof(payload));
+    pkt[n - 1] ^= 0x55;
+    rx_packet(pkt, n, 0);
+    CHECK(s_frames == 0 && s_errors[VCDC_RX_ERR_CRC] == 1, "crc error not reported");
+
+    const uint8_t oversize[] = { 0xFF, 0x10, 0xC1, 0x01 };     // 449바이트
+    rx_packet(oversize, sizeof(oversize), 10);
+    n = build_frame(pkt, 0x11, payload, sizeof(payload));
+    rx_packet(pkt, n, 20);
+    CHECK(s_errors[VCDC_RX_ERR_TOO_LARGE] == 1, "oversize not reported");
+    CHECK(s_frames == 1 && s_last_cmd == 0x11, "frame after oversize header not delivered");
+}
+
+int main(void)
+{
+    test_crc16_reference();
+    test_text_and_frame();
+    test_frame_split_across_packets();
+    test_stale_header_resync();
+    test_header_within_timeout_kept();
+    test_frame_across_fifo_wrap();
+    test_bytewise_timeout();
+    test_crc_error_and_oversize();
+
+    if (s_failures != 0) {
+        printf("%d check(s) failed\n", s_failures);
+        return EXIT_FAILURE;
+    }
+    printf("vcdc_rx: all tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,272 @@
+#!/usr/bin/env python3
+"""
+BridgeOne 입력 트레이스 CLI (펌웨어 input_trace.c 참조).
+
+동글은 검증된 입력 프레임(bridge_frame_t)과 그 결과 HID 리포트를 PSRAM 링에 상시 기록합니다.
+이 도구로 기록을 받아 보고, 같은 입력을 동글에서 다시 재생합니다.
+
+    inputtrace.py --port /dev/ttyACM1 status
+    inputtrace.py --port /dev/ttyACM1 download -o field.bin [--last 20000]   # 증상 직후 받기
+    inputtrace.py show field.bin                                              # 사람이 읽는 형식
+    inputtrace.py --port /dev/ttyACM1 upload field.bin                        # 재생 버퍼에 적재
+    inputtrace.py --port /dev/ttyACM1 load-recorded                           # 또는 링의 실제 입력을 적재
+    inputtrace.py --port /dev/ttyACM1 replay --speed 100 --wait
+    inputtrace.py --port /dev/ttyACM1 run field.bin -o result.bin --speed 100 # 적재 → 재생 → 결과 받기
+    inputtrace.py diff before.bin after.bin                                   # 재생 결과 리포트열 비교
+
+파일 형식: input_trace_record_t(16B, Little-Endian) 배열 그대로.
+test/host의 input_sim으로 같은 파일을 호스트에서 결정적으로 재생할 수 있습니다.
+의존성: pyserial (show/diff 제외)
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+from vcdc import Dongle, VCDC_MAX_PAYLOAD, encode_frame
+
+# ==================== 프로토콜 (vendor_cdc_handler.h, input_trace.h, input_replay.h) ====================
+
+VCDC_CMD_INPUT_CONTROL = 0x4A
+VCDC_CMD_INPUT_STATUS = 0x4B
+VCDC_CMD_INPUT_DATA = 0x4C
+VCDC_CMD_INPUT_UPLOAD = 0x4D
+
+CHUNK_RECORDS = 0
+CHUNK_END = 1
+
+KIND_FRAME = 1
+KIND_KB_REPORT = 2
+KIND_MOUSE_REPORT = 3
+KIND_NAMES = {KIND_FRAME: "frame", KIND_KB_REPORT: "kb", KIND_MOUSE_REPORT: "mouse"}
+
+FLAG_REPLAY = 0x01
+
+RECORD = struct.Struct("<IBBBB8s")      # input_trace_record_t
+UPLOAD_PER_CHUNK = (VCDC_MAX_PAYLOAD - 4) // RECORD.size
+
+
+# ==================== 레코드 ====================
+
+def parse_records(data):
+    if len(data) % RECORD.size != 0:
+        sys.exit("레코드 크기(%dB)의 배수가 아닙니다: %dB" % (RECORD.size, len(data)))
+    return [RECORD.unpack_from(data, i) for i in range(0, len(data), RECORD.size)]
+
+
+def pack_records(records):
+    return b"".join(RECORD.pack(*r) for r in records)
+
+
+def load_file(path):
+    with open(path, "rb") as f:
+        return parse_records(f.read())
+
+
+def save_file(path, records):
+    with open(path, "wb") as f:
+        f.write(pack_records(records))
+    print("%s: %d records" % (path, len(records)))
+
+
+def describe(kind, length, data):
+    if kind == KIND_FRAME:
+        seq, buttons, x, y, wheel, mod, k1, k2 = struct.unpack("<BBbbbBBB", data)
+        return "seq=%3d btn=0x%02x x=%4d y=%4d wheel=%4d mod=0x%02x keys=%02x,%02x" % (
+            seq, buttons, x, y, wheel, mod, k1, k2)
+    if kind == KIND_KB_REPORT:
+        mod, keys = data[0], data[2:8]
+        return "mod=0x%02x keys=%s" % (mod, ",".join("%02x" % k for k in keys))
+    if kind == KIND_MOUSE_REPORT:
+        buttons, x, y, wheel, pan = struct.unpack_from("<Bbbhh", data)
+        return "btn=0x%02x x=%4d y=%4d wheel=%d pan=%d" % (buttons, x, y, wheel, pan)
+    return data[:length].hex()
+
+
+# ==================== 동글 ====================
+
+def input_status(dongle, request=None):
+    return dongle.request_json(VCDC_CMD_INPUT_CONTROL, VCDC_CMD_INPUT_STATUS,
+                               request or {"op": "status"})
+
+
+def download(dongle, last=0):
+    request = {"op": "dump", "last": last} if last else {"op": "dump"}
+    chunks = dongle.collect_dump(VCDC_CMD_INPUT_CONTROL, VCDC_CMD_INPUT_STATUS, VCDC_CMD_INPUT_DATA,
+                                 lambda chunk: chunk[0] == CHUNK_END, timeout=10.0, request=request)
+    records = []
+    for chunk in chunks:
+        if chunk[0] == CHUNK_RECORDS:
+            (count,) = struct.unpack_from("<H", chunk, 2)
+            records += parse_records(chunk[4:4 + count * RECORD.size])
+        elif chunk[0] == CHUNK_END:
+            (lost,) = struct.unpack_from("<I", chunk, 8)
+            if lost:
+                print("링이 덮어써서 잃은 레코드: %d" % lost)
+    return records
+
+
+def upload(dongle, records):
+    for offset in range(0, len(records), UPLOAD_PER_CHUNK):
+        part = records[offset:offset + UPLOAD_PER_CHUNK]
+        payload = struct.pack("<I", offset) + pack_records(part)
+        dongle.port.write(encode_frame(VCDC_CMD_INPUT_UPLOAD, payload))
+        _, reply = dongle.wait_for({VCDC_CMD_INPUT_STATUS}, 2.0)
+        if reply is None:
+            sys.exit("업로드 응답 없음 (offset %d)" % offset)
+        loaded = json.loads(reply)["replay"]["loaded"]
+        if loaded != offset + len(part):
+            sys.exit("업로드 실패: offset %d, 적재 %d" % (offset, loaded))
+    print("uploaded %d records" % len(records))
+
+
+def wait_replay(dongle):
+    while True:
+        status = input_status(dongle)
+        if status["replay"]["state"] == "idle":
+            return status
+        time.sleep(0.2)
+
+
+# ==================== 비교 ====================
+
+def report_summary(records, replay_only):
+    """리포트열 요약: 키보드 리포트 순서, 마우스 버튼 전이, 이동/휠 합계."""
+    kb, buttons, prev_buttons = [], [], 0
+    sum_x = sum_y = sum_wheel = mouse = 0
+    for _, kind, flags, length, _, data in records:
+        if replay_only and not (flags & FLAG_REPLAY):
+            continue
+        if kind == KIND_KB_REPORT:
+            kb.append(data[:length])
+        elif kind == KIND_MOUSE_REPORT:
+            b, x, y, wheel, _ = struct.unpack_from("<Bbbhh", data)
+            mouse += 1
+            sum_x += x
+            sum_y += y
+            sum_wheel += wheel
+            if b != prev_buttons:
+                buttons.append(b)
+                prev_buttons = b
+    return {"kb": kb, "buttons": buttons, "sum_x": sum_x, "sum_y": sum_y,
+            "sum_wheel": sum_wheel, "mouse": mouse}
+
+
+def diff(a, b, replay_only):
+    sa, sb = report_summary(a, replay_only), report_summary(b, replay_only)
+    same = True
+    for key in ("sum_x", "sum_y", "sum_wheel", "buttons"):
+        mark = "" if sa[key] == sb[key] else "  <-- 다름"
+        same &= sa[key] == sb[key]
+        print("%-10s %s | %s%s" % (key, sa[key], sb[key], mark))
+    print("%-10s %d | %d (코얼레싱에 따라 달라질 수 있음)" % ("mouse", sa["mouse"], sb["mouse"]))
+    if sa["kb"] != sb["kb"]:
+        same = False
+        n = next((i for i, (x, y) in enumerate(zip(sa["kb"], sb["kb"])) if x != y),
+                 min(len(sa["kb"]), len(sb["kb"])))
+        print("kb reports differ at #%d (%d vs %d reports)" % (n, len(sa["kb"]), len(sb["kb"])))
+    else:
+        print("kb reports identical (%d)" % len(sa["kb"]))
+    return same
+
+
+# ==================== 명령 ====================
+
+def cmd_show(args):
+    records = load_file(args.input)
+    base = records[0][0] if records else 0
+    for ts, kind, flags, length, _, data in records:
+        print("%10.3f ms %-5s %s %s" % (((ts - base) & 0xFFFFFFFF) / 1000.0, KIND_NAMES.get(kind, kind),
+                                        "R" if flags & FLAG_REPLAY else " ", describe(kind, length, data)))
+
+
+def cmd_download(dongle, args):
+    save_file(args.output, download(dongle, args.last))
+
+
+def cmd_upload(dongle, args):
+    frames = [r for r in load_file(args.input) if r[1] == KIND_FRAME]
+    upload(dongle, frames)
+
+
+def cmd_replay(dongle, args):
+    status = input_status(dongle, {"op": "replay", "speed": args.speed, "max_idle_ms": args.max_idle_ms})
+    print(json.dumps(status))
+    if args.wait and status["replay"]["state"] == "running":
+        print(json.dumps(wait_replay(dongle)))
+
+
+def cmd_run(dongle, args):
+    """적재 → 재생 → 재생 중 기록된 레코드만 받아 저장 (회귀 실행 1회)."""
+    cmd_upload(dongle, args)
+    before = input_status(dongle)["records"]
+    status = input_status(dongle, {"op": "replay", "speed": args.speed, "max_idle_ms": args.max_idle_ms})
+    if status["replay"]["state"] != "running":
+        sys.exit("재생 시작 실패: %s" % json.dumps(status))
+    status = wait_replay(dongle)
+    print(json.dumps(status))
+    records = download(dongle, max(status["records"] - before, 1))
+    save_file(args.output, [r for r in records if r[2] & FLAG_REPLAY])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BridgeOne 입력 트레이스")
+    parser.add_argument("--port", help="동글 Vendor CDC 포트 (예: /dev/ttyACM1)")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    def add_replay_args(p):
+        p.add_argument("--speed", type=int, default=100, help="배속 %% (100 = 원래 속도, 0 = 대기 없음)")
+        p.add_argument("--max-idle-ms", type=int, default=1000, help="모두 뗀 상태의 간격 상한 (0 = 압축 안 함)")
+
+    for op, text in (("start", "링을 비우고 기록 시작"), ("stop", "기록 중지"), ("status", "상태 조회"),
+                     ("load-recorded", "링의 실제 입력 프레임을 재생 버퍼로"),
+                     ("replay-stop", "재생 중지")):
+        sub.add_parser(op, help=text)
+
+    p = sub.add_parser("download", help="링 덤프 → 파일")
+    p.add_argument("-o", "--output", default="input.bin")
+    p.add_argument("--last", type=int, default=0, help="최근 N개 레코드만")
+
+    p = sub.add_parser("upload", help="파일의 프레임 → 재생 버퍼")
+    p.add_argument("input")
+
+    p = sub.add_parser("replay", help="재생 시작")
+    add_replay_args(p)
+    p.add_argument("--wait", action="store_true", help="재생이 끝날 때까지 대기")
+
+    p = sub.add_parser("run", help="upload → replay → 재생 결과 download")
+    p.add_argument("input")
+    p.add_argument("-o", "--output", default="result.bin")
+    add_replay_args(p)
+
+    p = sub.add_parser("show", help="파일 내용 출력")
+    p.add_argument("input")
+
+    p = sub.add_parser("diff", help="두 파일의 리포트열 비교")
+    p.add_argument("a")
+    p.add_argument("b")
+    p.add_argument("--all", action="store_true", help="재생 외 리포트도 포함")
+
+    args = parser.parse_args()
+    if args.command == "show":
+        cmd_show(args)
+        return
+    if args.command == "diff":
+        sys.exit(0 if diff(load_file(args.a), load_file(args.b), not args.all) else 1)
+
+    if args.port is None:
+        parser.error("--port가 필요합니다")
+    dongle = Dongle(args.port)
+    simple = {"start": "start", "stop": "stop", "status": "status",
+              "load-recorded": "load_recorded", "replay-stop": "replay_stop"}
+    if args.command in simple:
+        print(json.dumps(input_status(dongle, {"op": simple[args.command]})))
+        return
+    {"download": cmd_download, "upload": cmd_upload, "replay": cmd_replay,
+     "run": cmd_run}[args.command](dongle, args)
+
+
+if __name__ == "__main__":
+    main()
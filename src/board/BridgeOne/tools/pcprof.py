@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""
+BridgeOne PC 샘플링 프로파일러 CLI (펌웨어 pc_profiler.c 참조).
+
+동글의 Vendor CDC 포트로 샘플링을 제어하고, 결과를 펌웨어 ELF로 심볼화해 출력합니다.
+
+    pcprof.py --port /dev/ttyACM1 start --hz 1000 --ms 5000 --depth 4
+    pcprof.py --port /dev/ttyACM1 status
+    pcprof.py --port /dev/ttyACM1 report --elf build/BridgeOne.elf            # flat profile
+    pcprof.py --port /dev/ttyACM1 report --elf build/BridgeOne.elf --folded   # folded stacks
+    pcprof.py --port /dev/ttyACM1 run --elf build/BridgeOne.elf --ms 3000     # start → 대기 → report
+
+folded 출력은 flamegraph.pl / speedscope에 그대로 넣을 수 있습니다.
+의존성: pyserial, ESP-IDF 툴체인의 xtensa-esp32s3-elf-addr2line
+"""
+
+import argparse
+import json
+import shutil
+import struct
+import subprocess
+import sys
+import time
+from collections import Counter, defaultdict
+
+from vcdc import Dongle, parse_name_table
+
+# ==================== 프로토콜 (vendor_cdc_handler.h, pc_profiler.h) ====================
+
+VCDC_CMD_PROF_CONTROL = 0x44
+VCDC_CMD_PROF_STATUS = 0x45
+VCDC_CMD_PROF_DATA = 0x46
+
+CHUNK_TASKS = 0
+CHUNK_RECORDS = 1
+CHUNK_END = 2
+
+ADDR2LINE = "xtensa-esp32s3-elf-addr2line"
+
+
+def prof_status(dongle, request=None):
+    return dongle.request_json(VCDC_CMD_PROF_CONTROL, VCDC_CMD_PROF_STATUS,
+                               request or {"op": "status"})
+
+
+def prof_dump(dongle):
+    return dongle.collect_dump(VCDC_CMD_PROF_CONTROL, VCDC_CMD_PROF_STATUS, VCDC_CMD_PROF_DATA,
+                               lambda chunk: chunk[0] == CHUNK_END)
+
+
+# ==================== 결과 해석 ====================
+
+class Profile:
+    def __init__(self):
+        self.tasks = {}             # handle → name
+        self.records = []           # (core, samples, task, [pc...])
+        self.totals = {}
+
+
+def parse_chunks(chunks):
+    profile = Profile()
+    for chunk in chunks:
+        kind = chunk[0]
+        if kind == CHUNK_TASKS:
+            profile.tasks.update(parse_name_table(chunk))
+        elif kind == CHUNK_RECORDS:
+            core, depth, count = chunk[1], chunk[2], chunk[3]
+            fmt = "<%dI" % (2 + depth)
+            size = struct.calcsize(fmt)
+            for i in range(count):
+                words = struct.unpack_from(fmt, chunk, 4 + i * size)
+                profile.records.append((core, words[0], words[1], list(words[2:])))
+        elif kind == CHUNK_END:
+            records, samples, isr, dropped = struct.unpack_from("<4I", chunk, 4)
+            profile.totals = {"records": records, "samples": samples, "isr": isr, "dropped": dropped}
+    return profile
+
+
+def caller_address(ret):
+    """윈도우 ABI 리턴 주소 → 호출 명령 주소. 상위 2비트는 윈도우 증분이므로 코드 영역 비트로 교체."""
+    return ((ret & 0x3FFFFFFF) | 0x40000000) - 3
+
+
+class Symbolizer:
+    def __init__(self, elf, addr2line):
+        self.elf = elf
+        self.addr2line = addr2line
+        self.cache = {}
+
+    def resolve(self, addresses):
+        pending = sorted({a for a in addresses if a not in self.cache})
+        if not pending:
+            return
+        if self.elf is None:
+            for a in pending:
+                self.cache[a] = "0x%08x" % a
+            return
+        tool = shutil.which(self.addr2line) or self.addr2line
+        out = subprocess.run([tool, "-f", "-C", "-e", self.elf] + ["0x%x" % a for a in pending],
+                             check=True, capture_output=True, text=True).stdout.splitlines()
+        for i, a in enumerate(pending):
+            name = out[2 * i] if 2 * i < len(out) else "??"
+            self.cache[a] = name if name != "??" else "0x%08x" % a
+
+    def name(self, address):
+        return self.cache.get(address, "0x%08x" % address)
+
+
+def symbolize(profile, symbolizer):
+    """레코드마다 (task, [leaf, caller, ...]) 함수 이름 스택으로 변환."""
+    stacks = []
+    for core, samples, task, pcs in profile.records:
+        addresses = [pcs[0]] + [caller_address(pc) for pc in pcs[1:] if pc != 0]
+        stacks.append((core, samples, task, addresses))
+    symbolizer.resolve(a for _, _, _, addresses in stacks for a in addresses)
+
+    result = []
+    for core, samples, task, addresses in stacks:
+        frames = [symbolizer.name(a) for a in addresses]
+        task_name = profile.tasks.get(task, "task@0x%08x" % task)
+        result.append((core, samples, task_name, frames))
+    return result
+
+
+def print_flat(profile, stacks, limit):
+    total = sum(samples for _, samples, _, _ in stacks)
+    if total == 0:
+        print("샘플 없음")
+        return
+    self_count = Counter()
+    total_count = Counter()
+    task_count = Counter()
+    for _, samples, task, frames in stacks:
+        self_count[frames[0]] += samples
+        for frame in set(frames):
+            total_count[frame] += samples
+        task_count[task] += samples
+
+    t = profile.totals
+    print("samples %d (isr %d, dropped %d), records %d" %
+          (t.get("samples", total), t.get("isr", 0), t.get("dropped", 0), t.get("records", 0)))
+    print()
+    print("%7s %7s  %s" % ("self%", "total%", "function"))
+    for name, count in self_count.most_common(limit):
+        print("%6.2f%% %6.2f%%  %s" % (100.0 * count / total, 100.0 * total_count[name] / total, name))
+    print()
+    print("%7s  %s" % ("task%", "task"))
+    for name, count in task_count.most_common():
+        print("%6.2f%%  %s" % (100.0 * count / total, name))
+
+
+def print_folded(profile, stacks):
+    folded = defaultdict(int)
+    for _, samples, task, frames in stacks:
+        folded[";".join([task] + frames[::-1])] += samples
+    isr = profile.totals.get("isr", 0)
+    if isr:
+        folded["[isr]"] += isr
+    for stack, count in sorted(folded.items()):
+        print("%s %d" % (stack, count))
+
+
+# ==================== 명령 ====================
+
+def print_status(status):
+    print(json.dumps(status))
+    load = status.get("load_ppm", [])
+    if load:
+        print("overhead: " + ", ".join("core%d %.3f%%" % (i, ppm / 10000.0) for i, ppm in enumerate(load)))
+
+
+def start_request(args):
+    return {"op": "start", "hz": args.hz, "ms": args.ms, "depth": args.depth}
+
+
+def cmd_start(dongle, args):
+    print_status(prof_status(dongle, start_request(args)))
+
+
+def cmd_stop(dongle, args):
+    print_status(prof_status(dongle, {"op": "stop"}))
+
+
+def cmd_status(dongle, args):
+    print_status(prof_status(dongle))
+
+
+def cmd_report(dongle, args):
+    profile = parse_chunks(prof_dump(dongle))
+    stacks = symbolize(profile, Symbolizer(args.elf, args.addr2line))
+    if args.folded:
+        print_folded(profile, stacks)
+    else:
+        print_flat(profile, stacks, args.limit)
+
+
+def cmd_run(dongle, args):
+    status = prof_status(dongle, start_request(args))
+    if status.get("state") != "running":
+        sys.exit("샘플링 시작 실패: %s" % json.dumps(status))
+    time.sleep(args.ms / 1000.0 + 0.2)
+    print_status(prof_status(dongle))
+    cmd_report(dongle, args)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BridgeOne PC 샘플링 프로파일러")
+    parser.add_argument("--port", required=True, help="동글 Vendor CDC 포트 (예: /dev/ttyACM1)")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    def add_start_args(p):
+        p.add_argument("--hz", type=int, default=1000, help="코어당 샘플링 주파수 (100~10000)")
+        p.add_argument("--ms", type=int, default=5000, help="샘플링 시간 (최대 60000)")
+        p.add_argument("--depth", type=int, default=4, help="호출 스택 깊이 (1~8)")
+
+    def add_report_args(p):
+        p.add_argument("--elf", help="펌웨어 ELF (없으면 주소만 출력)")
+        p.add_argument("--addr2line", default=ADDR2LINE, help="addr2line 경로")
+        p.add_argument("--folded", action="store_true", help="folded stacks 출력")
+        p.add_argument("--limit", type=int, default=30, help="flat profile 함수 수")
+
+    add_start_args(sub.add_parser("start", help="샘플링 시작"))
+    sub.add_parser("stop", help="샘플링 중지")
+    sub.add_parser("status", help="상태 조회")
+    add_report_args(sub.add_parser("report", help="결과 덤프 + 심볼화"))
+    run = sub.add_parser("run", help="시작 → 완료 대기 → report")
+    add_start_args(run)
+    add_report_args(run)
+
+    args = parser.parse_args()
+    dongle = Dongle(args.port)
+    {"start": cmd_start, "stop": cmd_stop, "status": cmd_status,
+     "report": cmd_report, "run": cmd_run}[args.command](dongle, args)
+
+
+if __name__ == "__main__":
+    main()
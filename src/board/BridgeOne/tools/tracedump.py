@@ -0,0 +1,332 @@
+#!/usr/bin/env python3
+"""
+BridgeOne 이벤트 트레이스 CLI (펌웨어 trace_recorder.c 참조).
+
+동글의 트레이스 레코더를 제어하고, 링 버퍼 덤프를 Chrome 트레이스 JSON으로 변환합니다.
+결과는 https://ui.perfetto.dev 또는 chrome://tracing에서 엽니다.
+
+    tracedump.py --port /dev/ttyACM1 start
+    (입력 재현)
+    tracedump.py --port /dev/ttyACM1 dump -o trace.json --raw trace.bin
+    tracedump.py convert trace.bin -o trace.json      # 저장해 둔 원본 재변환
+
+타임라인 구성:
+- "tasks" 프로세스: 태스크마다 스레드 1개, 실행 구간(running)과 그 동안 발생한 이벤트
+- "cpu" 프로세스: 코어마다 스레드 1개, 어떤 태스크가 돌고 있었는지
+- 큐 카운터: 등록된 큐(frame_queue 등)의 대기 메시지 수
+- 흐름 화살표: UART 프레임 → hid_task 처리 (seq로 연결), 리포트 게시 → 제출 (HID 인스턴스별)
+  HID 프레임/제출/완료 이벤트의 args에 앞 단계부터의 대기 시간(us)이 붙습니다.
+의존성: pyserial (dump/start/stop/status)
+"""
+
+import argparse
+import json
+import struct
+
+from vcdc import Dongle, parse_name_table
+
+# ==================== 프로토콜 (vendor_cdc_handler.h, trace_recorder.h) ====================
+
+VCDC_CMD_TRACE_CONTROL = 0x47
+VCDC_CMD_TRACE_STATUS = 0x48
+VCDC_CMD_TRACE_DATA = 0x49
+
+CHUNK_TASKS = 0
+CHUNK_QUEUES = 1
+CHUNK_EVENTS = 2
+CHUNK_END = 3
+
+EV_TASK_IN = 1
+EV_TASK_OUT = 2
+EV_QUEUE_SEND = 3
+EV_QUEUE_RECV = 4
+EV_UART_FRAME = 5
+EV_HID_FRAME = 6
+EV_HID_PUBLISH = 7
+EV_HID_SUBMIT = 8
+EV_HID_COMPLETE = 9
+EV_PING = 10
+
+EVENT_FORMAT = struct.Struct("<IBBHI")   # trace_event_t
+
+HID_INSTANCES = {0: "keyboard", 1: "mouse"}
+FRAME_SEQ_MODULO = 254                  # UART 프레임 seq 0~253 순환
+
+PID_TASKS = 1
+PID_CPU = 2
+PSEUDO_TASK_BASE = 0xC0DE0000           # 커널 훅이 없을 때 코어별 가상 태스크 핸들
+
+
+# ==================== 덤프 해석 ====================
+
+class Trace:
+    def __init__(self):
+        self.tasks = {}             # handle → name
+        self.queues = {}            # handle → name
+        self.events = []            # (ts_us 32비트, type, core, aux, arg)
+        self.lost = 0
+
+
+def parse_chunks(chunks):
+    trace = Trace()
+    for chunk in chunks:
+        kind = chunk[0]
+        if kind == CHUNK_TASKS:
+            trace.tasks.update(parse_name_table(chunk))
+        elif kind == CHUNK_QUEUES:
+            trace.queues.update(parse_name_table(chunk))
+        elif kind == CHUNK_EVENTS:
+            (count,) = struct.unpack_from("<H", chunk, 2)
+            for i in range(count):
+                trace.events.append(EVENT_FORMAT.unpack_from(chunk, 4 + i * EVENT_FORMAT.size))
+        elif kind == CHUNK_END:
+            _, trace.lost, _ = struct.unpack_from("<3I", chunk, 4)
+    return trace
+
+
+def unwrap_timestamps(events):
+    """32비트 us 타임스탬프를 이어 붙임. 코어 간 기록 순서가 조금 뒤섞여도 되도록 차이를 부호 있는 값으로 봄."""
+    result = []
+    prev32 = None
+    now = 0
+    for ts32, etype, core, aux, arg in events:
+        if prev32 is not None:
+            delta = (ts32 - prev32) & 0xFFFFFFFF
+            now += delta - (1 << 32) if delta & 0x80000000 else delta
+        prev32 = ts32
+        result.append((now, etype, core, aux, arg))
+    if result:
+        origin = min(e[0] for e in result)
+        result = [(ts - origin, etype, core, aux, arg) for ts, etype, core, aux, arg in result]
+    result.sort(key=lambda e: e[0])
+    return result
+
+
+# ==================== Chrome 트레이스 변환 ====================
+
+class ChromeTraceBuilder:
+    def __init__(self, trace):
+        self.trace = trace
+        self.out = []
+        self.task_tids = {}
+        self.running = {}           # core → (task, start_ts)
+        self.next_flow = 1
+        self.pending_frames = {}    # seq → (flow_id, ts)
+        self.pending_publish = {}   # instance → (flow_id, ts)
+        self.last_submit = {}       # instance → ts
+        self._metadata()
+
+    # ---------- 스레드 ----------
+
+    def _metadata(self):
+        self.out.append({"ph": "M", "pid": PID_TASKS, "name": "process_name", "args": {"name": "tasks"}})
+        self.out.append({"ph": "M", "pid": PID_CPU, "name": "process_name", "args": {"name": "cpu"}})
+        for core in range(2):
+            self.out.append({"ph": "M", "pid": PID_CPU, "tid": core, "name": "thread_name",
+                             "args": {"name": "core%d" % core}})
+
+    def task_name(self, handle):
+        return self.trace.tasks.get(handle, "task@0x%08x" % handle)
+
+    def task_tid(self, handle):
+        tid = self.task_tids.get(handle)
+        if tid is None:
+            tid = self.task_tids[handle] = len(self.task_tids) + 1
+            self.out.append({"ph": "M", "pid": PID_TASKS, "tid": tid, "name": "thread_name",
+                             "args": {"name": self.task_name(handle)}})
+        return tid
+
+    def current_tid(self, core):
+        """이 코어에서 실행 중인 태스크의 스레드 (커널 훅이 없으면 코어별 가상 스레드)."""
+        running = self.running.get(core)
+        if running is not None:
+            return self.task_tid(running[0])
+        pseudo = PSEUDO_TASK_BASE | core
+        self.trace.tasks.setdefault(pseudo, "core%d" % core)
+        return self.task_tid(pseudo)
+
+    # ---------- 실행 구간 ----------
+
+    def close_slice(self, core, ts):
+        running = self.running.pop(core, None)
+        if running is None:
+            return
+        task, start = running
+        name = self.task_name(task)
+        self.out.append({"ph": "X", "pid": PID_TASKS, "tid": self.task_tid(task), "name": "running",
+                         "ts": start, "dur": ts - start, "args": {"core": core}})
+        self.out.append({"ph": "X", "pid": PID_CPU, "tid": core, "name": name,
+                         "ts": start, "dur": ts - start})
+
+    # ---------- 이벤트 ----------
+
+    def instant(self, core, ts, name, args=None):
+        event = {"ph": "i", "s": "t", "pid": PID_TASKS, "tid": self.current_tid(core),
+                 "name": name, "ts": ts, "cat": "bridgeone"}
+        if args:
+            event["args"] = args
+        self.out.append(event)
+
+    def flow(self, phase, flow_id, core, ts, name):
+        event = {"ph": phase, "id": flow_id, "pid": PID_TASKS, "tid": self.current_tid(core),
+                 "name": name, "cat": "flow", "ts": ts}
+        if phase == "f":
+            event["bp"] = "e"
+        self.out.append(event)
+
+    def queue_event(self, etype, core, ts, handle, waiting):
+        name = self.trace.queues.get(handle, "queue@0x%08x" % handle)
+        sending = etype == EV_QUEUE_SEND
+        depth = waiting + 1 if sending else max(waiting - 1, 0)
+        self.instant(core, ts, ("send " if sending else "recv ") + name, {"waiting": waiting})
+        self.out.append({"ph": "C", "pid": PID_TASKS, "name": name, "ts": ts, "args": {"depth": depth}})
+
+    def hid_frame(self, core, ts, seq, merged):
+        args = {"seq": seq, "merged": merged}
+        waits = []
+        for k in range(merged):
+            pending = self.pending_frames.pop((seq - k) % FRAME_SEQ_MODULO, None)
+            if pending is not None:
+                flow_id, uart_ts = pending
+                self.flow("f", flow_id, core, ts, "frame")
+                waits.append(ts - uart_ts)
+        if waits:
+            args["wait_us"] = max(waits)
+        self.instant(core, ts, "hid frame", args)
+
+    def add(self, ts, etype, core, aux, arg):
+        if etype == EV_TASK_IN:
+            self.close_slice(core, ts)
+            self.running[core] = (arg, ts)
+        elif etype == EV_TASK_OUT:
+            running = self.running.get(core)
+            if running is not None and running[0] == arg:
+                self.close_slice(core, ts)
+        elif etype in (EV_QUEUE_SEND, EV_QUEUE_RECV):
+            self.queue_event(etype, core, ts, arg, aux)
+        elif etype == EV_UART_FRAME:
+            self.instant(core, ts, "uart frame", {"seq": arg})
+            self.flow("s", self.next_flow, core, ts, "frame")
+            self.pending_frames[arg % FRAME_SEQ_MODULO] = (self.next_flow, ts)
+            self.next_flow += 1
+        elif etype == EV_HID_FRAME:
+            self.hid_frame(core, ts, arg, max(aux, 1))
+        elif etype == EV_HID_PUBLISH:
+            instance = HID_INSTANCES.get(aux, str(aux))
+            self.instant(core, ts, "publish " + instance)
+            if aux not in self.pending_publish:
+                self.flow("s", self.next_flow, core, ts, "report")
+                self.pending_publish[aux] = (self.next_flow, ts)
+                self.next_flow += 1
+        elif etype == EV_HID_SUBMIT:
+            instance = HID_INSTANCES.get(aux, str(aux))
+            args = {}
+            pending = self.pending_publish.pop(aux, None)
+            if pending is not None:
+                self.flow("f", pending[0], core, ts, "report")
+                args["wait_us"] = ts - pending[1]
+            self.last_submit[aux] = ts
+            self.instant(core, ts, "submit " + instance, args)
+        elif etype == EV_HID_COMPLETE:
+            instance = HID_INSTANCES.get(aux, str(aux))
+            submitted = self.last_submit.pop(aux, None)
+            self.instant(core, ts, "complete " + instance,
+                         {"transfer_us": ts - submitted} if submitted is not None else None)
+        elif etype == EV_PING:
+            self.instant(core, ts, "ping")
+
+    def build(self, events):
+        end = 0
+        for ts, etype, core, aux, arg in events:
+            self.add(ts, etype, core, aux, arg)
+            end = ts
+        for core in list(self.running):
+            self.close_slice(core, end)
+        return {"traceEvents": self.out, "displayTimeUnit": "ms",
+                "otherData": {"source": "BridgeOne trace_recorder", "events": len(events),
+                              "lost": self.trace.lost}}
+
+
+def to_chrome_trace(chunks):
+    trace = parse_chunks(chunks)
+    return ChromeTraceBuilder(trace).build(unwrap_timestamps(trace.events))
+
+
+# ==================== 원본 저장 ====================
+
+def save_raw(path, chunks):
+    """[len u16 LE][chunk] 반복"""
+    with open(path, "wb") as f:
+        for chunk in chunks:
+            f.write(struct.pack("<H", len(chunk)) + chunk)
+
+
+def load_raw(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    chunks = []
+    pos = 0
+    while pos + 2 <= len(data):
+        (length,) = struct.unpack_from("<H", data, pos)
+        chunks.append(data[pos + 2:pos + 2 + length])
+        pos += 2 + length
+    return chunks
+
+
+def write_chrome_trace(path, chunks):
+    result = to_chrome_trace(chunks)
+    with open(path, "w") as f:
+        json.dump(result, f, separators=(",", ":"))
+    other = result["otherData"]
+    print("%s: %d events (lost %d)" % (path, other["events"], other["lost"]))
+
+
+# ==================== 명령 ====================
+
+def trace_status(dongle, op):
+    status = dongle.request_json(VCDC_CMD_TRACE_CONTROL, VCDC_CMD_TRACE_STATUS, {"op": op})
+    print(json.dumps(status))
+    return status
+
+
+def cmd_dump(args):
+    dongle = Dongle(args.port)
+    chunks = dongle.collect_dump(VCDC_CMD_TRACE_CONTROL, VCDC_CMD_TRACE_STATUS, VCDC_CMD_TRACE_DATA,
+                                 lambda chunk: chunk[0] == CHUNK_END)
+    if args.raw:
+        save_raw(args.raw, chunks)
+    write_chrome_trace(args.output, chunks)
+
+
+def cmd_convert(args):
+    write_chrome_trace(args.output, load_raw(args.input))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BridgeOne 이벤트 트레이스")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    for op, text in (("start", "기록 시작 (링 버퍼 비움)"), ("stop", "기록 중지"), ("status", "상태 조회")):
+        p = sub.add_parser(op, help=text)
+        p.add_argument("--port", required=True, help="동글 Vendor CDC 포트 (예: /dev/ttyACM1)")
+
+    dump = sub.add_parser("dump", help="기록 중지 + 덤프 → Chrome 트레이스 JSON")
+    dump.add_argument("--port", required=True, help="동글 Vendor CDC 포트 (예: /dev/ttyACM1)")
+    dump.add_argument("-o", "--output", default="trace.json", help="출력 JSON")
+    dump.add_argument("--raw", help="수신한 원본 청크 저장 (convert로 재변환)")
+
+    convert = sub.add_parser("convert", help="저장한 원본 → Chrome 트레이스 JSON")
+    convert.add_argument("input", help="dump --raw로 저장한 파일")
+    convert.add_argument("-o", "--output", default="trace.json", help="출력 JSON")
+
+    args = parser.parse_args()
+    if args.command == "dump":
+        cmd_dump(args)
+    elif args.command == "convert":
+        cmd_convert(args)
+    else:
+        trace_status(Dongle(args.port), args.command)
+
+
+if __name__ == "__main__":
+    main()
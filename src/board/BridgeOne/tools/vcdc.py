@@ -0,0 +1,136 @@
+"""
+BridgeOne Vendor CDC 프레임 입출력 (펌웨어 vendor_cdc_handler.h 참조).
+
+프레임: [0xFF][cmd][len LE16][payload ≤448][crc16 LE16], CRC는 페이로드만 계산합니다.
+pcprof.py, tracedump.py, inputtrace.py가 공용으로 사용합니다.
+"""
+
+import json
+import struct
+import sys
+import time
+
+try:
+    import serial
+except ImportError:
+    serial = None
+
+VCDC_HEADER = 0xFF
+VCDC_MAX_PAYLOAD = 448
+
+
+def crc16_xmodem(data):
+    """CRC16-CCITT (XMODEM): init 0x0000, poly 0x1021, MSB-first."""
+    crc = 0
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def encode_frame(command, payload=b""):
+    return (struct.pack("<BBH", VCDC_HEADER, command, len(payload)) + payload +
+            struct.pack("<H", crc16_xmodem(payload)))
+
+
+class FrameReader:
+    """직렬 스트림에서 프레임을 꺼냄. 헤더가 아닌 바이트(디버그 로그 등)는 건너뜁니다."""
+
+    def __init__(self, port):
+        self.port = port
+        self.buf = bytearray()
+
+    def read(self, timeout):
+        deadline = time.monotonic() + timeout
+        while True:
+            frame = self._take()
+            if frame is not None:
+                return frame
+            if time.monotonic() >= deadline:
+                return None
+            self.buf += self.port.read(self.port.in_waiting or 1)
+
+    def _take(self):
+        while True:
+            start = self.buf.find(VCDC_HEADER)
+            if start < 0:
+                self.buf.clear()
+                return None
+            del self.buf[:start]
+            if len(self.buf) < 4:
+                return None
+            command, length = struct.unpack_from("<BH", self.buf, 1)
+            if length > VCDC_MAX_PAYLOAD:
+                del self.buf[0]
+                continue
+            if len(self.buf) < 6 + length:
+                return None
+            payload = bytes(self.buf[4:4 + length])
+            (crc,) = struct.unpack_from("<H", self.buf, 4 + length)
+            if crc != crc16_xmodem(payload):
+                del self.buf[0]
+                continue
+            del self.buf[:6 + length]
+            return command, payload
+
+
+class Dongle:
+    """동글 Vendor CDC 포트. Windows 앱 등 다른 프로그램이 포트를 열고 있으면 안 됩니다."""
+
+    def __init__(self, port_name):
+        if serial is None:
+            sys.exit("pyserial이 필요합니다: pip install pyserial")
+        self.port = serial.Serial(port_name, 115200, timeout=0.05)
+        self.port.reset_input_buffer()
+        self.reader = FrameReader(self.port)
+
+    def send_json(self, command, request):
+        payload = json.dumps(request, separators=(",", ":")).encode()
+        self.port.write(encode_frame(command, payload))
+
+    def wait_for(self, commands, timeout):
+        """지정 명령 프레임이 올 때까지 대기 (다른 프레임은 버림). 시간 초과 시 (None, None)."""
+        deadline = time.monotonic() + timeout
+        while True:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                return None, None
+            command, payload = self.reader.read(remaining) or (None, None)
+            if command in commands:
+                return command, payload
+
+    def request_json(self, control, reply, request, timeout=2.0):
+        """JSON 제어 명령을 보내고 JSON 상태 응답을 받음."""
+        self.send_json(control, request)
+        _, payload = self.wait_for({reply}, timeout)
+        if payload is None:
+            sys.exit("응답 없음 (명령 0x%02X)" % control)
+        return json.loads(payload)
+
+    def collect_dump(self, control, status, data, is_end, timeout=5.0, request=None):
+        """request(기본 {"op":"dump"})를 보내고 data 청크를 is_end(청크)가 참일 때까지 모음.
+        펌웨어는 보낼 결과가 없으면 status 명령으로 응답합니다."""
+        self.send_json(control, request or {"op": "dump"})
+        chunks = []
+        while True:
+            command, payload = self.wait_for({data, status}, timeout)
+            if command is None:
+                sys.exit("덤프 수신 시간 초과 (청크 %d개 수신)" % len(chunks))
+            if command == status:
+                sys.exit("덤프할 결과가 없습니다: %s" % payload.decode(errors="replace"))
+            chunks.append(payload)
+            if is_end(payload):
+                return chunks
+
+
+def parse_name_table(chunk):
+    """[kind][count] + count × ([handle u32][name_len u8][name]) → {handle: name}"""
+    names = {}
+    pos = 2
+    for _ in range(chunk[1]):
+        handle, name_len = struct.unpack_from("<IB", chunk, pos)
+        names[handle] = chunk[pos + 5:pos + 5 + name_len].decode(errors="replace")
+        pos += 5 + name_len
+    return names
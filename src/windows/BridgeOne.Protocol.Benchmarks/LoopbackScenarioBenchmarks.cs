@@ -0,0 +1,180 @@
+using System.Text;
+using BenchmarkDotNet.Attributes;
+using BenchmarkDotNet.Engines;
+using BridgeOne.Protocol;
+using BridgeOne.Protocol.Simulation;
+using BridgeOne.Services;
+
+namespace BridgeOne.Protocol.Benchmarks;
+
+/// <summary>
+/// 시뮬레이터 동글(LoopbackTransport)을 상대로 한 연결 시나리오 벤치마크.
+/// 하드웨어 없이 Linux에서도 실행되며, 앱과 같은 VendorCdcProtocol / HandshakeService /
+/// KeepAliveService 코드를 그대로 사용합니다.
+///
+/// - Handshake: 포트 연결 → HELLO → HELLO_ACK 완료까지 (Essential → Standard 전환 시간)
+/// - LegacyHandshake: 같은 구간을 AUTH → STATE_SYNC 2회 왕복으로 (HELLO 도입 전 기준선)
+/// - PingRoundTrip: PING 전송 → PONG 수신 1회 왕복 (지속 처리량 = 1 / 평균)
+/// - ReconnectAfterUnplug: USB 제거 → PONG 3회 미수신 판정 → 재연결 + 핸드셰이크 완료까지
+/// - ResumeAfterPortReopen: 포트 닫기(DTR 해제) → 재오픈 → RESUME으로 Standard 복귀까지
+/// - FullHandshakeAfterPortReopen: 같은 구간을 세션 재개 없이 HELLO로 (재개 도입 전 기준선)
+///
+/// 시나리오당 수 ms ~ 수 초 단위이므로 Monitoring 전략(반복당 1회 호출)으로 측정합니다.
+/// </summary>
+[SimpleJob(RunStrategy.Monitoring, launchCount: 1, warmupCount: 1, iterationCount: 5)]
+public class LoopbackScenarioBenchmarks
+{
+    private const int PingsPerInvoke = 200;
+
+    private LoopbackTransport _transport = null!;
+    private VendorCdcProtocol _protocol = null!;
+    private HandshakeService _handshake = null!;
+    private KeepAliveService _keepAlive = null!;
+    private byte[] _pingPayload = Array.Empty<byte>();
+
+    /// <summary>시뮬레이터 응답 지연 (0 = 이상적 링크, 1 = USB Full-Speed 1 ms 폴링 근사)</summary>
+    [Params(0, 1)]
+    public int LatencyMs { get; set; }
+
+    private void CreateSession()
+    {
+        _transport = new LoopbackTransport(new SimulatedDevice(new SimulatedDeviceOptions
+        {
+            Latency = TimeSpan.FromMilliseconds(LatencyMs),
+            LogNoiseInterval = TimeSpan.FromMilliseconds(100),
+        }));
+        _protocol = new VendorCdcProtocol(_transport);
+        _handshake = new HandshakeService(_protocol);
+        _keepAlive = new KeepAliveService(_protocol, _transport, _handshake);
+    }
+
+    private void EnsureConnected()
+    {
+        if (!_transport.TryConnect())
+            throw new InvalidOperationException("루프백 연결 실패");
+
+        var result = _handshake.PerformHandshakeAsync().GetAwaiter().GetResult();
+        if (!result.Success)
+            throw new InvalidOperationException($"핸드셰이크 실패: {result.ErrorMessage}");
+    }
+
+    [IterationSetup(Target = nameof(Handshake))]
+    public void SetupHandshake()
+    {
+        CreateSession();
+        if (!_transport.TryConnect())
+            throw new InvalidOperationException("루프백 연결 실패");
+    }
+
+    [IterationSetup(Target = nameof(LegacyHandshake))]
+    public void SetupLegacyHandshake()
+    {
+        SetupHandshake();
+        _handshake.UseHello = false;
+    }
+
+    [IterationSetup(Target = nameof(PingRoundTrip))]
+    public void SetupPing()
+    {
+        CreateSession();
+        EnsureConnected();
+        _pingPayload = Encoding.UTF8.GetBytes("{\"command\":\"PING\",\"timestamp\":0}");
+    }
+
+    [IterationSetup(Target = nameof(ReconnectAfterUnplug))]
+    public void SetupReconnect()
+    {
+        CreateSession();
+        EnsureConnected();
+        _keepAlive.Start();
+    }
+
+    [IterationSetup(Target = nameof(ResumeAfterPortReopen))]
+    public void SetupResume()
+    {
+        CreateSession();
+        EnsureConnected();
+    }
+
+    [IterationSetup(Target = nameof(FullHandshakeAfterPortReopen))]
+    public void SetupFullHandshakeAfterReopen()
+    {
+        CreateSession();
+        _handshake.UseResume = false;
+        EnsureConnected();
+    }
+
+    [IterationCleanup]
+    public void Cleanup()
+    {
+        _keepAlive.Dispose();
+        _protocol.Dispose();
+        _transport.Dispose();
+    }
+
+    /// <summary>HELLO → HELLO_ACK 완료까지</summary>
+    [Benchmark]
+    public async Task<bool> Handshake()
+        => (await _handshake.PerformHandshakeAsync()).Success;
+
+    /// <summary>AUTH_CHALLENGE → STATE_SYNC_ACK 완료까지</summary>
+    [Benchmark]
+    public async Task<bool> LegacyHandshake()
+        => (await _handshake.PerformHandshakeAsync()).Success;
+
+    /// <summary>PING → PONG 1회 왕복 (KeepAliveService와 같은 JSON PING)</summary>
+    [Benchmark(OperationsPerInvoke = PingsPerInvoke)]
+    public async Task PingRoundTrip()
+    {
+        for (int i = 0; i < PingsPerInvoke; i++)
+        {
+            await _protocol.SendFrameAsync((byte)VendorCdcCommand.Ping, _pingPayload);
+
+            bool pong = false;
+            while (!pong)
+            {
+                using var frame = await _protocol.FrameReader.ReadAsync();
+                pong = frame.Command == (byte)VendorCdcCommand.Pong;
+            }
+        }
+    }
+
+    /// <summary>DTR 해제 → 포트 재오픈 → RESUME_ACK (동글 Standard 복귀)까지</summary>
+    [Benchmark]
+    public Task<bool> ResumeAfterPortReopen() => ReopenAndHandshakeAsync();
+
+    /// <summary>DTR 해제 → 포트 재오픈 → HELLO_ACK까지</summary>
+    [Benchmark]
+    public Task<bool> FullHandshakeAfterPortReopen() => ReopenAndHandshakeAsync();
+
+    private async Task<bool> ReopenAndHandshakeAsync()
+    {
+        // 실제 동글처럼 DTR 해제 처리(IDLE 전환)가 끝난 뒤 포트를 다시 엶
+        var idle = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        _transport.Device.StateChanged += (_, state) =>
+        {
+            if (state == SimulatedConnectionState.Idle)
+                idle.TrySetResult();
+        };
+
+        _transport.Disconnect();
+        await idle.Task.WaitAsync(TimeSpan.FromSeconds(5));
+
+        if (!_transport.TryConnect())
+            throw new InvalidOperationException("루프백 연결 실패");
+
+        return (await _handshake.PerformHandshakeAsync()).Success;
+    }
+
+    /// <summary>USB 제거 후 즉시 재삽입 → KeepAliveService.Reconnected까지</summary>
+    [Benchmark]
+    public async Task ReconnectAfterUnplug()
+    {
+        var reconnected = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        _keepAlive.Reconnected += (_, _) => reconnected.TrySetResult();
+
+        _transport.Unplug();
+        _transport.Replug();
+        await reconnected.Task.WaitAsync(TimeSpan.FromSeconds(30));
+    }
+}
@@ -0,0 +1,62 @@
+using System.Buffers;
+using System.Text;
+using BenchmarkDotNet.Attributes;
+using BridgeOne.Protocol;
+
+namespace BridgeOne.Protocol.Benchmarks;
+
+/// <summary>
+/// Vendor CDC 수신 경로 벤치마크.
+/// PONG(JSON 타임스탬프) 크기 프레임과 디버그 로그가 섞인 스트림을 파싱합니다.
+/// MemoryDiagnoser의 Allocated 열로 프레임당 할당(VendorCdcFrame 객체만)을 확인합니다.
+/// </summary>
+[MemoryDiagnoser]
+public class ReceivePathBenchmarks
+{
+    private const int FrameCount = 1000;
+
+    private byte[] _stream = Array.Empty<byte>();
+    private byte[] _payload = Array.Empty<byte>();
+    private VendorCdcReceiver _receiver = new();
+
+    [Params(32, 448)]
+    public int PayloadSize { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _payload = new byte[PayloadSize];
+        new Random(7).NextBytes(_payload);
+
+        var frame = new VendorCdcFrame((byte)VendorCdcCommand.Pong, _payload).ToBytes();
+        var log = Encoding.UTF8.GetBytes("I (1234) vendor_cdc: pong\n");
+        using var ms = new MemoryStream();
+        for (int i = 0; i < FrameCount; i++)
+        {
+            ms.Write(frame);
+            if (i % 10 == 0)
+                ms.Write(log);
+        }
+        _stream = ms.ToArray();
+
+        // 이벤트 구독자가 없으면 텍스트 디코딩을 생략하므로 실제 앱처럼 구독
+        _receiver = new VendorCdcReceiver();
+        _receiver.DebugTextReceived += (_, _) => { };
+    }
+
+    /// <summary>단일 세그먼트 버퍼 파싱 (파서 + CRC + 풀 페이로드)</summary>
+    [Benchmark(OperationsPerInvoke = FrameCount)]
+    public void ParseContiguous()
+    {
+        var buffer = new ReadOnlySequence<byte>(_stream);
+        _receiver.Process(ref buffer);
+    }
+
+    /// <summary>MemoryStream → PipeReader → 파서 전체 수신 루프</summary>
+    [Benchmark(OperationsPerInvoke = FrameCount)]
+    public Task ReceiveFromStream()
+        => _receiver.RunAsync(new MemoryStream(_stream, writable: false));
+
+    [Benchmark]
+    public ushort Crc16Payload() => Crc16.Calculate(_payload);
+}
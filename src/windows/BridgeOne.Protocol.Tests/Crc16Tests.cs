@@ -0,0 +1,65 @@
+using System.Text;
+
+namespace BridgeOne.Protocol.Tests;
+
+/// <summary>
+/// Unit tests for Crc16
+///
+/// Verifies the CCITT (XMODEM) check value, equality with the firmware's
+/// bit-by-bit algorithm, and segment-independent results for sequences.
+/// </summary>
+public class Crc16Tests
+{
+    /// <summary>ESP32-S3 vendor_cdc_crc16()과 같은 비트 루프 구현 (기준값)</summary>
+    private static ushort Reference(ReadOnlySpan<byte> data)
+    {
+        ushort crc = 0;
+        foreach (byte b in data)
+        {
+            crc ^= (ushort)(b << 8);
+            for (int j = 0; j < 8; j++)
+                crc = (crc & 0x8000) != 0 ? (ushort)((crc << 1) ^ 0x1021) : (ushort)(crc << 1);
+        }
+        return crc;
+    }
+
+    /// <summary>
+    /// Test: Standard check value for "123456789" and empty input
+    /// </summary>
+    [Fact]
+    public void CheckValue()
+    {
+        Assert.Equal(0x31C3, Crc16.Calculate(Encoding.ASCII.GetBytes("123456789")));
+        Assert.Equal(0x0000, Crc16.Calculate(ReadOnlySpan<byte>.Empty));
+    }
+
+    /// <summary>
+    /// Test: Table lookup matches the bitwise firmware algorithm for random payloads
+    /// </summary>
+    [Fact]
+    public void MatchesBitwiseReference()
+    {
+        var random = new Random(1234);
+        for (int length = 0; length <= VendorCdcFrame.MaxPayloadSize; length += 7)
+        {
+            var data = new byte[length];
+            random.NextBytes(data);
+            Assert.Equal(Reference(data), Crc16.Calculate(data));
+        }
+    }
+
+    /// <summary>
+    /// Test: Multi-segment sequences give the same CRC as the contiguous buffer
+    /// </summary>
+    [Theory]
+    [InlineData(1)]
+    [InlineData(3)]
+    [InlineData(64)]
+    public void SequenceMatchesContiguous(int chunkSize)
+    {
+        var data = new byte[200];
+        new Random(42).NextBytes(data);
+
+        Assert.Equal(Crc16.Calculate(data), Crc16.Calculate(TestStreams.Segmented(data, chunkSize)));
+    }
+}
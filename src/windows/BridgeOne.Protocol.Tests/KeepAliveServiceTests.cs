@@ -0,0 +1,70 @@
+using BridgeOne.Protocol.Simulation;
+using BridgeOne.Services;
+
+namespace BridgeOne.Protocol.Tests;
+
+/// <summary>
+/// Unit tests for KeepAliveService
+///
+/// Verifies tail-latency/loss quality classification and PING interval configuration.
+/// </summary>
+public class KeepAliveServiceTests
+{
+    private static RttPercentiles Stats(double p99, int count = 20, int lost = 0)
+        => new(count, lost, p99 / 2, p99 / 2, p99, p99);
+
+    private static KeepAliveService CreateService()
+    {
+        var transport = new LoopbackTransport();
+        var protocol = new VendorCdcProtocol(transport);
+        return new KeepAliveService(protocol, transport, new HandshakeService(protocol));
+    }
+
+    /// <summary>
+    /// Test: Quality follows p99 thresholds (20ms / 100ms)
+    /// </summary>
+    [Fact]
+    public void ClassifiesOnTailLatency()
+    {
+        Assert.Equal(ConnectionQuality.Good, KeepAliveService.ClassifyQuality(Stats(p99: 20)));
+        Assert.Equal(ConnectionQuality.Fair, KeepAliveService.ClassifyQuality(Stats(p99: 21)));
+        Assert.Equal(ConnectionQuality.Fair, KeepAliveService.ClassifyQuality(Stats(p99: 100)));
+        Assert.Equal(ConnectionQuality.Unstable, KeepAliveService.ClassifyQuality(Stats(p99: 150)));
+    }
+
+    /// <summary>
+    /// Test: Loss downgrades an otherwise fast link (1% / 5% limits)
+    /// </summary>
+    [Fact]
+    public void ClassifiesOnLossRate()
+    {
+        Assert.Equal(ConnectionQuality.Good, KeepAliveService.ClassifyQuality(Stats(p99: 2, count: 100, lost: 1)));
+        Assert.Equal(ConnectionQuality.Fair, KeepAliveService.ClassifyQuality(Stats(p99: 2, count: 19, lost: 1)));
+        Assert.Equal(ConnectionQuality.Unstable, KeepAliveService.ClassifyQuality(Stats(p99: 2, count: 9, lost: 1)));
+    }
+
+    /// <summary>
+    /// Test: No samples → Unknown, only losses → Unstable
+    /// </summary>
+    [Fact]
+    public void ClassifiesEmptyWindow()
+    {
+        Assert.Equal(ConnectionQuality.Unknown, KeepAliveService.ClassifyQuality(RttPercentiles.Empty));
+        Assert.Equal(ConnectionQuality.Unstable, KeepAliveService.ClassifyQuality(new RttPercentiles(0, 2, -1, -1, -1, -1)));
+    }
+
+    /// <summary>
+    /// Test: PING interval accepts 50ms and rejects faster rates
+    /// </summary>
+    [Fact]
+    public void PingIntervalHasFloor()
+    {
+        using var service = CreateService();
+
+        Assert.Equal(TimeSpan.FromMilliseconds(500), service.PingInterval);
+        service.PingInterval = TimeSpan.FromMilliseconds(50);
+        Assert.Equal(TimeSpan.FromMilliseconds(50), service.PingInterval);
+
+        Assert.Throws<ArgumentOutOfRangeException>(() => service.PingInterval = TimeSpan.FromMilliseconds(49));
+    }
+}
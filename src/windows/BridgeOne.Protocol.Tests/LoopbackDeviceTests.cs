@@ -0,0 +1,377 @@
+using BridgeOne.Protocol.Simulation;
+using BridgeOne.Services;
+
+namespace BridgeOne.Protocol.Tests;
+
+/// <summary>
+/// Integration tests for VendorCdcProtocol, HandshakeService and KeepAliveService
+/// against the in-process SimulatedDevice over LoopbackTransport.
+///
+/// Verifies the handshake, firmware state rules, injected link faults and the
+/// keep-alive unplug → reconnect path without hardware.
+/// </summary>
+public class LoopbackDeviceTests
+{
+    private sealed class Harness : IDisposable
+    {
+        public readonly LoopbackTransport Transport;
+        public readonly VendorCdcProtocol Protocol;
+        public readonly HandshakeService Handshake;
+        public readonly KeepAliveService KeepAlive;
+
+        public Harness(SimulatedDeviceOptions? options = null)
+        {
+            Transport = new LoopbackTransport(new SimulatedDevice(options));
+            Protocol = new VendorCdcProtocol(Transport);
+            Handshake = new HandshakeService(Protocol);
+            KeepAlive = new KeepAliveService(Protocol, Transport, Handshake);
+            Assert.True(Transport.TryConnect());
+        }
+
+        public SimulatedDevice Device => Transport.Device;
+
+        public void Dispose()
+        {
+            KeepAlive.Dispose();
+            Protocol.Dispose();
+            Transport.Dispose();
+        }
+    }
+
+    private static async Task WaitUntil(Func<bool> condition, TimeSpan timeout)
+    {
+        var deadline = DateTime.UtcNow + timeout;
+        while (!condition())
+        {
+            Assert.True(DateTime.UtcNow < deadline, "condition not met before timeout");
+            await Task.Delay(10);
+        }
+    }
+
+    /// <summary>
+    /// Test: Full handshake negotiates the firmware's supported features and reaches CONNECTED
+    /// </summary>
+    [Fact]
+    public async Task HandshakeReachesConnected()
+    {
+        using var h = new Harness();
+
+        var result = await h.Handshake.PerformHandshakeAsync();
+
+        Assert.True(result.Success, result.ErrorMessage);
+        Assert.Equal(new[] { "wheel", "drag", "right_click" }, result.AcceptedFeatures);
+        Assert.Equal("standard", result.Mode);
+        Assert.Equal("BridgeOne", result.DeviceName);
+        Assert.Equal(SimulatedConnectionState.Connected, h.Device.State);
+        Assert.Equal(500, h.Device.NegotiatedKeepaliveMs);
+    }
+
+    /// <summary>
+    /// Test: HELLO authenticates and negotiates features in a single round trip
+    /// </summary>
+    [Fact]
+    public async Task HelloHandshakeIsSingleRoundTrip()
+    {
+        using var h = new Harness();
+
+        var result = await h.Handshake.PerformHandshakeAsync();
+
+        Assert.True(result.Success, result.ErrorMessage);
+        Assert.Equal(HandshakeMethod.Hello, result.Method);
+        Assert.Equal(1L, h.Device.FramesHandled);
+        Assert.Equal(new[] { "wheel", "drag", "right_click" }, result.AcceptedFeatures);
+        Assert.Equal("1.0.0", result.FirmwareVersion);
+        Assert.Equal(SimulatedConnectionState.Connected, h.Device.State);
+    }
+
+    /// <summary>
+    /// Test: Firmware without HELLO answers ERROR [0x05, 0x01] and the same attempt falls back to AUTH + STATE_SYNC
+    /// </summary>
+    [Fact]
+    public async Task LegacyFirmwareFallsBackToTwoPhaseHandshake()
+    {
+        using var h = new Harness(new SimulatedDeviceOptions { SupportsHello = false, SupportsResume = false });
+
+        var first = await h.Handshake.PerformHandshakeAsync();
+
+        Assert.True(first.Success, first.ErrorMessage);
+        Assert.Equal(HandshakeMethod.TwoPhase, first.Method);
+        Assert.True(h.Handshake.IsHelloUnsupported);
+        Assert.Equal(SimulatedConnectionState.Connected, h.Device.State);
+
+        // 이후 재연결은 HELLO를 다시 시도하지 않음
+        h.Transport.Disconnect();
+        await WaitUntil(() => h.Device.State == SimulatedConnectionState.Idle, TimeSpan.FromSeconds(2));
+        Assert.True(h.Transport.TryConnect());
+        long handled = h.Device.FramesHandled;
+
+        var second = await h.Handshake.PerformHandshakeAsync();
+
+        Assert.True(second.Success, second.ErrorMessage);
+        Assert.Equal(handled + 2, h.Device.FramesHandled);
+    }
+
+    /// <summary>
+    /// Test: UseHello = false keeps the two-phase handshake even on HELLO-capable firmware
+    /// </summary>
+    [Fact]
+    public async Task UseHelloFalseUsesTwoPhaseHandshake()
+    {
+        using var h = new Harness();
+        h.Handshake.UseHello = false;
+
+        var result = await h.Handshake.PerformHandshakeAsync();
+
+        Assert.True(result.Success, result.ErrorMessage);
+        Assert.Equal(HandshakeMethod.TwoPhase, result.Method);
+        Assert.False(h.Handshake.IsHelloUnsupported);
+        Assert.Equal(2L, h.Device.FramesHandled);
+    }
+
+    /// <summary>
+    /// Test: HELLO while CONNECTED resets the device without a reply (same rule as AUTH_CHALLENGE)
+    /// </summary>
+    [Fact]
+    public async Task HelloWhileConnectedResetsDevice()
+    {
+        using var h = new Harness();
+        Assert.True((await h.Handshake.PerformHandshakeAsync()).Success);
+
+        var again = await h.Handshake.HelloAsync();
+
+        Assert.False(again.Success);
+        Assert.Equal(HandshakeFailReason.HelloFailed, again.FailReason);
+        Assert.Equal(SimulatedConnectionState.Idle, h.Device.State);
+        Assert.Empty(h.Device.NegotiatedFeatures);
+    }
+
+    /// <summary>
+    /// Test: After a DTR drop the session resumes in one round trip with the same features
+    /// </summary>
+    [Fact]
+    public async Task ResumeAfterPortReopenRestoresSession()
+    {
+        using var h = new Harness();
+        var first = await h.Handshake.PerformHandshakeAsync();
+        Assert.True(first.Success, first.ErrorMessage);
+        Assert.True(h.Handshake.HasSession);
+
+        h.Transport.Disconnect();
+        await WaitUntil(() => h.Device.State == SimulatedConnectionState.Idle, TimeSpan.FromSeconds(2));
+        Assert.True(h.Transport.TryConnect());
+        long handled = h.Device.FramesHandled;
+
+        var resumed = await h.Handshake.PerformHandshakeAsync();
+
+        Assert.True(resumed.Success, resumed.ErrorMessage);
+        Assert.Equal(HandshakeMethod.Resume, resumed.Method);
+        Assert.Equal(handled + 1, h.Device.FramesHandled);
+        Assert.Equal(first.AcceptedFeatures, resumed.AcceptedFeatures);
+        Assert.Equal(first.AcceptedFeatures, h.Device.NegotiatedFeatures);
+        Assert.Equal(500, h.Device.NegotiatedKeepaliveMs);
+        Assert.Equal(SimulatedConnectionState.Connected, h.Device.State);
+        Assert.True(h.Handshake.HasSession);
+    }
+
+    /// <summary>
+    /// Test: An expired session is rejected with ERROR [0x07, 0x03] and the same attempt falls back to HELLO
+    /// </summary>
+    [Fact]
+    public async Task ExpiredSessionFallsBackToHello()
+    {
+        using var h = new Harness(new SimulatedDeviceOptions { SessionGrace = TimeSpan.FromMilliseconds(50) });
+        Assert.True((await h.Handshake.PerformHandshakeAsync()).Success);
+
+        h.Transport.Disconnect();
+        await WaitUntil(() => h.Device.State == SimulatedConnectionState.Idle, TimeSpan.FromSeconds(2));
+        await Task.Delay(150);
+        Assert.True(h.Transport.TryConnect());
+
+        var result = await h.Handshake.PerformHandshakeAsync();
+
+        Assert.True(result.Success, result.ErrorMessage);
+        Assert.Equal(HandshakeMethod.Hello, result.Method);
+        Assert.True(h.Handshake.HasSession);
+    }
+
+    /// <summary>
+    /// Test: RESUME while still CONNECTED (missed DTR drop) suspends and resumes the same session
+    /// </summary>
+    [Fact]
+    public async Task ResumeWhileConnectedKeepsSession()
+    {
+        using var h = new Harness();
+        Assert.True((await h.Handshake.PerformHandshakeAsync()).Success);
+
+        var result = await h.Handshake.ResumeAsync();
+
+        Assert.True(result.Success, result.ErrorMessage);
+        Assert.Equal(HandshakeMethod.Resume, result.Method);
+        Assert.Equal(SimulatedConnectionState.Connected, h.Device.State);
+        Assert.Equal(new[] { "wheel", "drag", "right_click" }, h.Device.NegotiatedFeatures);
+    }
+
+
+    [Fact]
+    public async Task HandshakeToleratesLatencyJitterAndLogNoise()
+    {
+        using var h = new Harness(new SimulatedDeviceOptions
+        {
+            Latency = TimeSpan.FromMilliseconds(5),
+            Jitter = TimeSpan.FromMilliseconds(10),
+            LogNoiseInterval = TimeSpan.FromMilliseconds(1),
+        });
+        int textLines = 0;
+        h.Protocol.DebugTextReceived += (_, _) => Interlocked.Increment(ref textLines);
+
+        var result = await h.Handshake.PerformHandshakeAsync();
+
+        Assert.True(result.Success, result.ErrorMessage);
+        Assert.True(textLines > 0, "banner/log text expected");
+    }
+
+    /// <summary>
+    /// Test: A device that drops every frame makes authentication time out
+    /// </summary>
+    [Fact]
+    public async Task AuthTimesOutOnTotalLoss()
+    {
+        using var h = new Harness(new SimulatedDeviceOptions { LossRate = 1.0 });
+
+        var result = await h.Handshake.AuthenticateAsync();
+
+        Assert.False(result.Success);
+        Assert.Equal("AUTH_RESPONSE 타임아웃", result.ErrorMessage);
+        Assert.True(h.Device.FramesLost >= 1);
+    }
+
+    /// <summary>
+    /// Test: AUTH_CHALLENGE while CONNECTED resets the device without a reply (firmware transition table)
+    /// </summary>
+    [Fact]
+    public async Task ChallengeWhileConnectedResetsDevice()
+    {
+        using var h = new Harness();
+        Assert.True((await h.Handshake.PerformHandshakeAsync()).Success);
+
+        var again = await h.Handshake.AuthenticateAsync();
+
+        Assert.False(again.Success);
+        Assert.Equal(SimulatedConnectionState.Idle, h.Device.State);
+        Assert.Empty(h.Device.NegotiatedFeatures);
+    }
+
+    /// <summary>
+    /// Test: Unknown command is answered with ERROR [cmd, 0x01]
+    /// </summary>
+    [Fact]
+    public async Task UnknownCommandReturnsError()
+    {
+        using var h = new Harness();
+
+        await h.Protocol.SendFrameAsync(0x77);
+
+        using var cts = new CancellationTokenSource(TimeSpan.FromSeconds(2));
+        VendorCdcFrame? reply = null;
+        while (reply == null)
+        {
+            var frame = await h.Protocol.FrameReader.ReadAsync(cts.Token);
+            if (frame.Command == (byte)VendorCdcCommand.Error)
+                reply = frame;
+            else
+                frame.Dispose();
+        }
+
+        using (reply)
+            Assert.Equal(new byte[] { 0x77, 0x01 }, reply.Payload.ToArray());
+    }
+
+    /// <summary>
+    /// Test: Closing the port (DTR drop) and missing PINGs both return the device to IDLE
+    /// </summary>
+    [Fact]
+    public async Task DeviceResetsOnDisconnectAndPingTimeout()
+    {
+        using var h = new Harness(new SimulatedDeviceOptions
+        {
+            KeepAliveTimeout = TimeSpan.FromMilliseconds(300)
+        });
+
+        Assert.True((await h.Handshake.PerformHandshakeAsync()).Success);
+        await WaitUntil(() => h.Device.State == SimulatedConnectionState.Idle, TimeSpan.FromSeconds(2));
+
+        Assert.True((await h.Handshake.PerformHandshakeAsync()).Success);
+        h.Transport.Disconnect();
+        await WaitUntil(() => h.Device.State == SimulatedConnectionState.Idle, TimeSpan.FromSeconds(2));
+    }
+
+    /// <summary>
+    /// Test: Keep-alive measures RTT including injected latency
+    /// </summary>
+    [Fact]
+    public async Task KeepAliveMeasuresInjectedLatency()
+    {
+        using var h = new Harness(new SimulatedDeviceOptions { Latency = TimeSpan.FromMilliseconds(30) });
+        Assert.True((await h.Handshake.PerformHandshakeAsync()).Success);
+        var rtts = new List<double>();
+        h.KeepAlive.RttUpdated += (_, e) => { lock (rtts) rtts.Add(e.CurrentRttMs); };
+
+        h.KeepAlive.Start();
+        await WaitUntil(() => { lock (rtts) return rtts.Count >= 2; }, TimeSpan.FromSeconds(3));
+
+        lock (rtts)
+            Assert.All(rtts, rtt => Assert.InRange(rtt, 25, 200));
+    }
+
+    /// <summary>
+    /// Test: 50ms PING rate fills the RTT histogram and classifies a clean fast link as Good
+    /// </summary>
+    [Fact]
+    public async Task FastPingRateFeedsPercentiles()
+    {
+        using var h = new Harness(new SimulatedDeviceOptions { Latency = TimeSpan.FromMilliseconds(2) });
+        Assert.True((await h.Handshake.PerformHandshakeAsync()).Success);
+        h.KeepAlive.PingInterval = KeepAliveService.MinPingInterval;
+
+        h.KeepAlive.Start();
+        await WaitUntil(() => h.KeepAlive.RecentRtt.Count >= 10, TimeSpan.FromSeconds(3));
+
+        var recent = h.KeepAlive.RecentRtt;
+        Assert.InRange(recent.P50Ms, 1.5, 50);
+        Assert.True(recent.P99Ms >= recent.P50Ms);
+        Assert.Equal(0, recent.LostCount);
+        Assert.Equal(ConnectionQuality.Good, h.KeepAlive.Quality);
+
+        var bins = new int[KeepAliveService.DisplayBinEdgesMs.Length + 1];
+        var display = h.KeepAlive.CopyRttHistogram(bins);
+        Assert.Equal(display.Count, bins.Sum());
+    }
+
+    /// <summary>
+    /// Test: Unplug is detected by missed PONGs and keep-alive reconnects (first attempt immediately, via RESUME) after replug
+    /// </summary>
+    [Fact]
+    public async Task KeepAliveReconnectsAfterUnplug()
+    {
+        using var h = new Harness();
+        Assert.True((await h.Handshake.PerformHandshakeAsync()).Success);
+        var lost = new TaskCompletionSource();
+        var reconnected = new TaskCompletionSource();
+        var firstDelay = new TaskCompletionSource<int>();
+        h.KeepAlive.ConnectionLost += (_, _) => lost.TrySetResult();
+        h.KeepAlive.Reconnected += (_, _) => reconnected.TrySetResult();
+        h.KeepAlive.ReconnectAttempt += (_, e) => firstDelay.TrySetResult(e.DelaySeconds);
+        h.KeepAlive.Start();
+
+        h.Transport.Unplug();
+        await lost.Task.WaitAsync(TimeSpan.FromSeconds(10));
+        h.Transport.Replug();
+        await reconnected.Task.WaitAsync(TimeSpan.FromSeconds(10));
+
+        await WaitUntil(() => h.KeepAlive.IsRunning, TimeSpan.FromSeconds(1));
+        Assert.Equal(SimulatedConnectionState.Connected, h.Device.State);
+
+        // 세션 토큰이 있으므로 첫 재연결은 백오프 없이 시도
+        Assert.Equal(0, await firstDelay.Task);
+    }
+}
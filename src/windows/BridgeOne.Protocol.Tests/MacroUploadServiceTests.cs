@@ -0,0 +1,106 @@
+using System.Text;
+using BridgeOne.Protocol.Simulation;
+using BridgeOne.Services;
+
+namespace BridgeOne.Protocol.Tests;
+
+/// <summary>
+/// Unit and loopback tests for MacroUploadService
+///
+/// Verifies the MACRO_UPLOAD payload layout, MACRO_ACK parsing and the
+/// upload → ACK round trip against SimulatedDevice.
+/// </summary>
+public class MacroUploadServiceTests
+{
+    /// <summary>
+    /// Test: Payload is [id][count] followed by 8-byte little-endian steps (firmware macro_step_t)
+    /// </summary>
+    [Fact]
+    public void BuildsFirmwarePayload()
+    {
+        var payload = MacroUploadService.BuildPayload(3,
+        [
+            MacroStep.Keyboard(0x01, 0x06, 8_000),
+            new MacroStep(MacroStepType.Wheel, 0x00, 0xFF, 0x00, 0),
+        ]);
+
+        Assert.Equal(new byte[]
+        {
+            0x03, 0x02,
+            0x01, 0x01, 0x06, 0x00, 0x40, 0x1F, 0x00, 0x00,
+            0x03, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+        }, payload);
+    }
+
+    /// <summary>
+    /// Test: Out-of-range ID or step count is rejected before sending
+    /// </summary>
+    [Fact]
+    public void RejectsOutOfRangeMacro()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(
+            () => MacroUploadService.BuildPayload(MacroUploadService.MaxMacroCount, []));
+        Assert.Throws<ArgumentOutOfRangeException>(
+            () => MacroUploadService.BuildPayload(0,
+                Enumerable.Repeat(MacroStep.Keyboard(0, 0, 0), MacroUploadService.MaxSteps + 1).ToArray()));
+    }
+
+    /// <summary>
+    /// Test: MACRO_ACK as built by firmware handle_cmd_macro_upload()
+    /// </summary>
+    [Fact]
+    public void ParsesFirmwareAck()
+    {
+        Assert.True(MacroUploadService.TryParseAck(
+            Encoding.UTF8.GetBytes("{\"command\":\"MACRO_ACK\",\"id\":3,\"steps\":4,\"result\":\"ok\"}"),
+            out var ok));
+        Assert.Equal(new MacroAck(3, true, null), ok);
+
+        Assert.True(MacroUploadService.TryParseAck(
+            Encoding.UTF8.GetBytes("{\"command\":\"MACRO_ACK\",\"id\":40,\"steps\":1,\"result\":\"error\",\"reason\":\"ESP_ERR_INVALID_ARG\"}"),
+            out var error));
+        Assert.False(error.Success);
+        Assert.Equal("ESP_ERR_INVALID_ARG", error.Reason);
+
+        Assert.False(MacroUploadService.TryParseAck(ReadOnlySpan<byte>.Empty, out _));
+        Assert.False(MacroUploadService.TryParseAck(Encoding.UTF8.GetBytes("{\"id\":3"), out _));
+    }
+
+    /// <summary>
+    /// Test: Shortcut macro IDs are unique and fit the firmware slots
+    /// </summary>
+    [Fact]
+    public void ShortcutDefaultsFitSlots()
+    {
+        var ids = ShortcutMacros.Defaults.Select(m => m.Id).ToArray();
+        Assert.Equal(ids.Length, ids.Distinct().Count());
+        Assert.All(ShortcutMacros.Defaults, m =>
+        {
+            Assert.InRange(m.Id, 0, MacroUploadService.MaxMacroCount - 1);
+            Assert.InRange(m.Steps.Count, 1, MacroUploadService.MaxSteps);
+            // 탭 매크로는 항상 모든 키를 뗀 상태로 끝나야 함
+            Assert.Equal(MacroStep.Keyboard(0, 0, 0), m.Steps[^1]);
+        });
+    }
+
+    /// <summary>
+    /// Test: Uploading the shortcut macros stores every one on the device and returns its ACK
+    /// </summary>
+    [Fact]
+    public async Task UploadsShortcutsToDevice()
+    {
+        using var transport = new LoopbackTransport(new SimulatedDevice());
+        using var protocol = new VendorCdcProtocol(transport);
+        using var uploader = new MacroUploadService(protocol);
+        Assert.True(transport.TryConnect());
+
+        var acks = await uploader.UploadShortcutsAsync();
+
+        Assert.All(acks, ack => Assert.True(ack.Success, ack.Reason));
+        Assert.Equal(ShortcutMacros.Defaults.Select(m => m.Id), acks.Select(a => a.Id));
+
+        var stored = transport.Device.StoredMacros;
+        foreach (var macro in ShortcutMacros.Defaults)
+            Assert.Equal(MacroUploadService.BuildPayload(macro.Id, macro.Steps)[2..], stored[macro.Id]);
+    }
+}
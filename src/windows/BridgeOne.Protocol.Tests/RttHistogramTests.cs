@@ -0,0 +1,170 @@
+using System.Diagnostics;
+using BridgeOne.Services;
+
+namespace BridgeOne.Protocol.Tests;
+
+/// <summary>
+/// Unit tests for RttHistogram
+///
+/// Verifies log-linear bucketing accuracy, percentile/max reporting,
+/// sliding window expiry, loss accounting and allocation-free recording.
+/// </summary>
+public class RttHistogramTests
+{
+    private static long At(double seconds) => (long)(seconds * Stopwatch.Frequency);
+
+    private static RttHistogram Create() => new(TimeSpan.FromSeconds(1), 60);
+
+    /// <summary>
+    /// Test: Bucket index/highest value round-trips with ≤ 12.5% relative error over the full range
+    /// </summary>
+    [Fact]
+    public void BucketsCoverRangeWithBoundedError()
+    {
+        for (long us = 0; us <= RttHistogram.MaxValueUs; us = us < 64 ? us + 1 : us * 9 / 8)
+        {
+            int index = RttHistogram.BucketIndex(us);
+            long highest = RttHistogram.BucketHighestUs(index);
+
+            Assert.True(highest >= us, $"{us}us → bucket {index} highest {highest}");
+            Assert.True(highest - us <= Math.Max(0, us / 8), $"{us}us → {highest}us");
+        }
+
+        Assert.Equal(RttHistogram.BucketCount - 1, RttHistogram.BucketIndex(long.MaxValue));
+        Assert.Equal(0, RttHistogram.BucketIndex(-5));
+    }
+
+    /// <summary>
+    /// Test: Percentiles reflect the tail that a mean would hide
+    /// </summary>
+    [Fact]
+    public void PercentilesExposeTailLatency()
+    {
+        var h = Create();
+        for (int i = 0; i < 95; i++)
+            h.Record(2.0, At(1));
+        for (int i = 0; i < 5; i++)
+            h.Record(80.0, At(1));
+
+        var p = h.GetPercentiles(TimeSpan.FromSeconds(10), At(1));
+
+        Assert.Equal(100, p.Count);
+        Assert.InRange(p.P50Ms, 2.0, 2.25);
+        Assert.InRange(p.P90Ms, 2.0, 2.25);
+        Assert.InRange(p.P99Ms, 80.0, 80.0);
+        Assert.Equal(80.0, p.MaxMs);
+    }
+
+    /// <summary>
+    /// Test: Sub-millisecond samples keep µs resolution
+    /// </summary>
+    [Fact]
+    public void SubMillisecondResolution()
+    {
+        var h = Create();
+        h.Record(0.012, At(0));
+        h.Record(0.350, At(0));
+
+        var p = h.GetPercentiles(TimeSpan.FromSeconds(1), At(0));
+
+        Assert.Equal(0.012, p.P50Ms);
+        Assert.Equal(0.350, p.MaxMs);
+    }
+
+    /// <summary>
+    /// Test: Samples older than the window are excluded, ring slots are reused after expiry
+    /// </summary>
+    [Fact]
+    public void SlidingWindowExpiresOldSamples()
+    {
+        var h = Create();
+        h.Record(150.0, At(0.5));
+        h.Record(3.0, At(20.5));
+
+        var shortWindow = h.GetPercentiles(TimeSpan.FromSeconds(10), At(20.5));
+        var longWindow = h.GetPercentiles(TimeSpan.FromSeconds(60), At(20.5));
+
+        Assert.Equal(1, shortWindow.Count);
+        Assert.Equal(3.0, shortWindow.MaxMs);
+        Assert.Equal(2, longWindow.Count);
+        Assert.Equal(150.0, longWindow.MaxMs);
+
+        // 60초 뒤 같은 링 슬롯에 기록 → 이전 데이터는 지워져야 함
+        h.Record(4.0, At(60.5));
+        var wrapped = h.GetPercentiles(TimeSpan.FromSeconds(60), At(60.5));
+        Assert.Equal(2, wrapped.Count);
+        Assert.Equal(4.0, wrapped.MaxMs);
+    }
+
+    /// <summary>
+    /// Test: Loss rate counts lost PINGs against answered ones in the window
+    /// </summary>
+    [Fact]
+    public void LossRateWithinWindow()
+    {
+        var h = Create();
+        for (int i = 0; i < 18; i++)
+            h.Record(1.0, At(5));
+        h.RecordLoss(At(5));
+        h.RecordLoss(At(5));
+
+        var p = h.GetPercentiles(TimeSpan.FromSeconds(10), At(5));
+
+        Assert.Equal(2, p.LostCount);
+        Assert.Equal(0.1, p.LossRate);
+    }
+
+    /// <summary>
+    /// Test: Empty window reports -1 percentiles
+    /// </summary>
+    [Fact]
+    public void EmptyWindowHasNoPercentiles()
+    {
+        var h = Create();
+
+        var p = h.GetPercentiles(TimeSpan.FromSeconds(10), At(1));
+
+        Assert.Equal(RttPercentiles.Empty, p);
+    }
+
+    /// <summary>
+    /// Test: Display bins split counts at the given upper edges, overflow goes to the last bin
+    /// </summary>
+    [Fact]
+    public void CopyBinsGroupsByEdges()
+    {
+        var h = Create();
+        h.Record(0.5, At(1));
+        h.Record(1.5, At(1));
+        h.Record(1.7, At(1));
+        h.Record(30.0, At(1));
+        h.Record(900.0, At(1));
+        var bins = new int[4];
+
+        h.CopyBins(TimeSpan.FromSeconds(60), At(1), [1, 2, 50], bins);
+
+        Assert.Equal(new[] { 1, 2, 1, 1 }, bins);
+    }
+
+    /// <summary>
+    /// Test: Recording and querying do not allocate
+    /// </summary>
+    [Fact]
+    public void RecordAndQueryAreAllocationFree()
+    {
+        var h = Create();
+        h.Record(1.0, At(0));
+        h.GetPercentiles(TimeSpan.FromSeconds(10), At(0));
+
+        long before = GC.GetAllocatedBytesForCurrentThread();
+        for (int i = 0; i < 10_000; i++)
+        {
+            h.Record(i % 200 * 0.37, At(i * 0.05));
+            if (i % 7 == 0) h.RecordLoss(At(i * 0.05));
+            h.GetPercentiles(TimeSpan.FromSeconds(10), At(i * 0.05));
+        }
+        long allocated = GC.GetAllocatedBytesForCurrentThread() - before;
+
+        Assert.Equal(0L, allocated);
+    }
+}
@@ -0,0 +1,62 @@
+using System.Text;
+using BridgeOne.Services;
+
+namespace BridgeOne.Protocol.Tests;
+
+/// <summary>
+/// Unit tests for TaskProfilerService
+///
+/// Verifies TOP_REPORT parsing (probe tasks with wake/latency, plain tasks without).
+/// </summary>
+public class TaskProfilerServiceTests
+{
+    private static bool Parse(string json, out TaskProfileSnapshot snapshot)
+        => TaskProfilerService.TryParseReport(Encoding.UTF8.GetBytes(json), out snapshot);
+
+    /// <summary>
+    /// Test: Report as built by firmware task_profiler_build_json()
+    /// </summary>
+    [Fact]
+    public void ParsesFirmwareReport()
+    {
+        const string json =
+            "{\"dt\":1001850,\"load\":[202,57],\"tasks\":[" +
+            "[\"HID\",5,0,21,1001,812,37,120]," +
+            "[\"USB\",4,1,48,2210,640,12,95]," +
+            "[\"Tmr Svc\",1,-1,3,1400]]}";
+
+        Assert.True(Parse(json, out var snapshot));
+        Assert.Equal(1001850, snapshot.IntervalUs);
+        Assert.Equal([202, 57], snapshot.CoreLoadPermille);
+        Assert.Equal(3, snapshot.Tasks.Count);
+
+        var hid = snapshot.Tasks[0];
+        Assert.Equal("HID", hid.Name);
+        Assert.Equal(5, hid.Priority);
+        Assert.Equal(0, hid.Affinity);
+        Assert.Equal(21, hid.CpuPermille);
+        Assert.Equal(1001, hid.StackFreeBytes);
+        Assert.Equal(812, hid.Wakes);
+        Assert.Equal(37, hid.LatencyAvgUs);
+        Assert.Equal(120, hid.LatencyMaxUs);
+
+        var timer = snapshot.Tasks[2];
+        Assert.Equal(-1, timer.Affinity);
+        Assert.Null(timer.Wakes);
+        Assert.Null(timer.LatencyAvgUs);
+        Assert.Null(timer.LatencyMaxUs);
+    }
+
+    /// <summary>
+    /// Test: Malformed or truncated payloads are rejected
+    /// </summary>
+    [Fact]
+    public void RejectsMalformedReport()
+    {
+        Assert.False(TaskProfilerService.TryParseReport(ReadOnlySpan<byte>.Empty, out _));
+        Assert.False(Parse("{\"dt\":1000,\"load\":[0,0]}", out _));
+        Assert.False(Parse("{\"dt\":1000,\"load\":[0,0],\"tasks\":[[\"HID\",5,0]]}", out _));
+        Assert.False(Parse("{\"dt\":1000,\"load\":[0,0],\"tasks\":[", out var snapshot));
+        Assert.Same(TaskProfileSnapshot.Empty, snapshot);
+    }
+}
@@ -0,0 +1,80 @@
+using System.Buffers;
+
+namespace BridgeOne.Protocol.Tests;
+
+/// <summary>
+/// 테스트용 입력 생성 도우미: 프레임 인코딩, 다중 세그먼트 시퀀스, 조각 수신 스트림.
+/// </summary>
+internal static class TestStreams
+{
+    public static byte[] Frame(byte command, params byte[] payload)
+        => new VendorCdcFrame(command, payload).ToBytes();
+
+    public static byte[] Concat(params byte[][] parts)
+        => parts.SelectMany(p => p).ToArray();
+
+    /// <summary>
+    /// data를 chunkSize 바이트씩 별도 세그먼트로 나눈 시퀀스 (PipeReader 다중 세그먼트 재현).
+    /// </summary>
+    public static ReadOnlySequence<byte> Segmented(byte[] data, int chunkSize)
+    {
+        if (data.Length == 0)
+            return ReadOnlySequence<byte>.Empty;
+
+        Segment? first = null;
+        Segment? last = null;
+        for (int i = 0; i < data.Length; i += chunkSize)
+        {
+            var memory = data.AsMemory(i, Math.Min(chunkSize, data.Length - i));
+            if (last == null)
+                first = last = new Segment(memory, 0);
+            else
+                last = last.Append(memory);
+        }
+
+        return new ReadOnlySequence<byte>(first!, 0, last!, last!.Memory.Length);
+    }
+
+    private sealed class Segment : ReadOnlySequenceSegment<byte>
+    {
+        public Segment(ReadOnlyMemory<byte> memory, long runningIndex)
+        {
+            Memory = memory;
+            RunningIndex = runningIndex;
+        }
+
+        public Segment Append(ReadOnlyMemory<byte> memory)
+        {
+            var next = new Segment(memory, RunningIndex + Memory.Length);
+            Next = next;
+            return next;
+        }
+    }
+}
+
+/// <summary>
+/// Read 한 번에 최대 chunkSize 바이트만 돌려주는 스트림 (USB 패킷 단위 조각 수신 재현).
+/// </summary>
+internal sealed class ChunkedStream : MemoryStream
+{
+    private readonly int _chunkSize;
+
+    public ChunkedStream(byte[] data, int chunkSize) : base(data, writable: false)
+    {
+        _chunkSize = chunkSize;
+    }
+
+    public override int Read(byte[] buffer, int offset, int count)
+        => base.Read(buffer, offset, Math.Min(count, _chunkSize));
+
+    public override int Read(Span<byte> buffer)
+        => base.Read(buffer[..Math.Min(buffer.Length, _chunkSize)]);
+
+    public override Task<int> ReadAsync(byte[] buffer, int offset, int count,
+        CancellationToken cancellationToken)
+        => base.ReadAsync(buffer, offset, Math.Min(count, _chunkSize), cancellationToken);
+
+    public override ValueTask<int> ReadAsync(Memory<byte> buffer,
+        CancellationToken cancellationToken = default)
+        => base.ReadAsync(buffer[..Math.Min(buffer.Length, _chunkSize)], cancellationToken);
+}
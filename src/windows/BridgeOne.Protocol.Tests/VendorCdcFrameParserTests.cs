@@ -0,0 +1,187 @@
+using System.Buffers;
+using System.Text;
+
+namespace BridgeOne.Protocol.Tests;
+
+/// <summary>
+/// Unit tests for VendorCdcFrameParser
+///
+/// Verifies frame/debug-text separation, partial frames, frames split across
+/// sequence segments, CRC errors and non-frame 0xFF bytes.
+/// </summary>
+public class VendorCdcFrameParserTests
+{
+    /// <summary>buffer의 완성된 토큰을 모두 읽어 (종류, 명령/텍스트) 목록으로 반환</summary>
+    private static List<string> ReadAll(ref ReadOnlySequence<byte> buffer)
+    {
+        var tokens = new List<string>();
+        while (true)
+        {
+            var token = VendorCdcFrameParser.TryRead(ref buffer, out var frame, out var text);
+            switch (token)
+            {
+                case VendorCdcToken.NeedMoreData:
+                    return tokens;
+                case VendorCdcToken.Frame:
+                    using (frame)
+                        tokens.Add($"{(frame!.IsValid ? "frame" : "bad")}:{frame.Command:X2}:{Convert.ToHexString(frame.Payload.Span)}");
+                    break;
+                case VendorCdcToken.DebugText:
+                    tokens.Add($"text:{Encoding.UTF8.GetString(text)}");
+                    break;
+                case VendorCdcToken.NonFrameHeader:
+                    tokens.Add("nonframe");
+                    break;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Test: Encoded frame parses back with the same command and payload
+    /// </summary>
+    [Fact]
+    public void RoundTrip()
+    {
+        var buffer = new ReadOnlySequence<byte>(TestStreams.Frame(0x11, 1, 2, 3));
+
+        var token = VendorCdcFrameParser.TryRead(ref buffer, out var frame, out _);
+
+        Assert.Equal(VendorCdcToken.Frame, token);
+        using (frame)
+        {
+            Assert.True(frame!.IsValid);
+            Assert.Equal(0x11, frame.Command);
+            Assert.Equal(new byte[] { 1, 2, 3 }, frame.Payload.ToArray());
+        }
+        Assert.True(buffer.IsEmpty);
+    }
+
+    /// <summary>
+    /// Test: Debug text before and between frames is split at the 0xFF header
+    /// </summary>
+    [Fact]
+    public void SeparatesDebugTextAndFrames()
+    {
+        var data = TestStreams.Concat(
+            Encoding.UTF8.GetBytes("boot ok\n"),
+            TestStreams.Frame(0x10),
+            Encoding.UTF8.GetBytes("상태"),
+            TestStreams.Frame(0x20, 0xAB));
+        var buffer = new ReadOnlySequence<byte>(data);
+
+        Assert.Equal(
+            new[] { "text:boot ok\n", "frame:10:", "text:상태", "frame:20:AB" },
+            ReadAll(ref buffer));
+    }
+
+    /// <summary>
+    /// Test: Incomplete frame is left in the buffer untouched until the rest arrives
+    /// </summary>
+    [Fact]
+    public void PartialFrameNeedsMoreData()
+    {
+        var frame = TestStreams.Frame(0x03, new byte[40]);
+        for (int cut = 1; cut < frame.Length; cut++)
+        {
+            var buffer = new ReadOnlySequence<byte>(frame, 0, cut);
+            var token = VendorCdcFrameParser.TryRead(ref buffer, out var parsed, out _);
+
+            Assert.Equal(VendorCdcToken.NeedMoreData, token);
+            Assert.Null(parsed);
+            Assert.Equal(cut, buffer.Length);
+        }
+    }
+
+    /// <summary>
+    /// Test: Frames split across arbitrary segment boundaries parse identically
+    /// </summary>
+    [Theory]
+    [InlineData(1)]
+    [InlineData(2)]
+    [InlineData(5)]
+    [InlineData(64)]
+    public void FramesAcrossSegments(int chunkSize)
+    {
+        var payload = Enumerable.Range(0, VendorCdcFrame.MaxPayloadSize).Select(i => (byte)i).ToArray();
+        var data = TestStreams.Concat(
+            TestStreams.Frame(0x31, payload),
+            Encoding.UTF8.GetBytes("log"),
+            TestStreams.Frame(0x11, 9, 8));
+        var buffer = TestStreams.Segmented(data, chunkSize);
+
+        var tokens = ReadAll(ref buffer);
+
+        Assert.Equal(3, tokens.Count);
+        Assert.Equal($"frame:31:{Convert.ToHexString(payload)}", tokens[0]);
+        Assert.Equal("text:log", tokens[1]);
+        Assert.Equal("frame:11:0908", tokens[2]);
+    }
+
+    /// <summary>
+    /// Test: Corrupted payload yields IsValid=false and consumes the whole frame
+    /// </summary>
+    [Fact]
+    public void CrcErrorMarksFrameInvalid()
+    {
+        var frame = TestStreams.Frame(0x04, 1, 2, 3);
+        frame[5] ^= 0x40;
+        var buffer = new ReadOnlySequence<byte>(TestStreams.Concat(frame, TestStreams.Frame(0x11)));
+
+        Assert.Equal(new[] { "bad:04:014203", "frame:11:" }, ReadAll(ref buffer));
+    }
+
+    /// <summary>
+    /// Test: 0xFF with an impossible length is skipped one byte at a time
+    /// </summary>
+    [Fact]
+    public void OversizedLengthIsNotAFrame()
+    {
+        // length = 0x7F00 (> 448) → 0xFF만 건너뛰고 나머지는 텍스트로 재동기화
+        var bogus = new byte[] { 0xFF, 0x01, 0x00, 0x7F, (byte)'o', (byte)'k' };
+        var buffer = new ReadOnlySequence<byte>(TestStreams.Concat(bogus, TestStreams.Frame(0x11)));
+
+        Assert.Equal(new[] { "nonframe", "text:\u0001\0\u007Fok", "frame:11:" }, ReadAll(ref buffer));
+    }
+
+    /// <summary>
+    /// Test: Dispose returns the pooled payload once and empties Payload
+    /// </summary>
+    [Fact]
+    public void DisposeReleasesPayload()
+    {
+        var buffer = new ReadOnlySequence<byte>(TestStreams.Frame(0x02, 7, 7, 7));
+        VendorCdcFrameParser.TryRead(ref buffer, out var frame, out _);
+
+        Assert.Equal(3, frame!.Payload.Length);
+        frame.Dispose();
+        frame.Dispose();
+        Assert.True(frame.Payload.IsEmpty);
+    }
+
+    /// <summary>
+    /// Test: Steady-state parsing allocates only the frame object, not payload arrays
+    /// </summary>
+    [Fact]
+    public void ParsingDoesNotAllocatePayloads()
+    {
+        const int frameCount = 1000;
+        var one = TestStreams.Frame(0x10, new byte[64]);
+        var data = Enumerable.Repeat(one, frameCount).SelectMany(f => f).ToArray();
+
+        // 워밍업 (JIT, 풀 버킷 생성)
+        var warm = new ReadOnlySequence<byte>(data);
+        while (VendorCdcFrameParser.TryRead(ref warm, out var f, out _) == VendorCdcToken.Frame)
+            f!.Dispose();
+
+        var buffer = new ReadOnlySequence<byte>(data);
+        long before = GC.GetAllocatedBytesForCurrentThread();
+        while (VendorCdcFrameParser.TryRead(ref buffer, out var frame, out _) == VendorCdcToken.Frame)
+            frame!.Dispose();
+        long perFrame = (GC.GetAllocatedBytesForCurrentThread() - before) / frameCount;
+
+        // VendorCdcFrame 객체 1개(~48B)만 허용, 64B 페이로드 배열이 매번 할당되면 초과
+        Assert.True(perFrame <= MaxBytesPerFrame, $"{perFrame} B/frame");
+    }
+
+    private const long MaxBytesPerFrame = 64;
+}
@@ -0,0 +1,110 @@
+using System.Text;
+
+namespace BridgeOne.Protocol.Tests;
+
+/// <summary>
+/// Unit tests for VendorCdcReceiver
+///
+/// Runs the Pipelines receive loop against in-memory streams and verifies
+/// event order, chunked delivery, CRC discards and frame ownership hand-off.
+/// </summary>
+public class VendorCdcReceiverTests
+{
+    private sealed class Recorder
+    {
+        public readonly List<string> Events = new();
+        public readonly List<VendorCdcFrame> Owned = new();
+
+        public Recorder(VendorCdcReceiver receiver, bool takeOwnership)
+        {
+            receiver.FrameReceived += (_, f) =>
+                Events.Add($"frame:{f.Command:X2}:{Convert.ToHexString(f.Payload.Span)}");
+            receiver.FrameDiscarded += (_, f) => Events.Add($"discard:{f.Command:X2}");
+            receiver.DebugTextReceived += (_, t) => Events.Add($"text:{t}");
+            if (takeOwnership)
+                receiver.FrameHandler = Owned.Add;
+        }
+    }
+
+    private static byte[] SampleStream() => TestStreams.Concat(
+        Encoding.UTF8.GetBytes("I (120) vendor_cdc: ready\n"),
+        TestStreams.Frame((byte)VendorCdcCommand.AuthResponse, Encoding.UTF8.GetBytes("{\"response\":\"ok\"}")),
+        TestStreams.Frame((byte)VendorCdcCommand.Pong, 1, 2),
+        Encoding.UTF8.GetBytes("tick\0"),
+        TestStreams.Frame((byte)VendorCdcCommand.ModeNotify, 0x01));
+
+    /// <summary>
+    /// Test: Whole stream is delivered as text and frames in arrival order
+    /// </summary>
+    [Theory]
+    [InlineData(int.MaxValue)]
+    [InlineData(64)]
+    [InlineData(7)]
+    [InlineData(1)]
+    public async Task DeliversInOrderRegardlessOfChunking(int chunkSize)
+    {
+        var receiver = new VendorCdcReceiver();
+        var recorder = new Recorder(receiver, takeOwnership: false);
+
+        await receiver.RunAsync(new ChunkedStream(SampleStream(), chunkSize));
+
+        // 조각 수신 시 텍스트는 수신 단위로 나뉠 수 있으므로 이어 붙여 비교
+        var text = string.Concat(recorder.Events.Where(e => e.StartsWith("text:")).Select(e => e[5..]));
+        var frames = recorder.Events.Where(e => e.StartsWith("frame:")).ToList();
+
+        Assert.Equal("I (120) vendor_cdc: ready\ntick", text);
+        Assert.Equal(3, frames.Count);
+        Assert.StartsWith("frame:02:", frames[0]);
+        Assert.Equal("frame:11:0102", frames[1]);
+        Assert.Equal("frame:20:01", frames[2]);
+    }
+
+    /// <summary>
+    /// Test: CRC error raises FrameDiscarded and the next frame is still received
+    /// </summary>
+    [Fact]
+    public async Task CrcErrorIsDiscarded()
+    {
+        var bad = TestStreams.Frame(0x11, 5, 5);
+        bad[^1] ^= 0xFF;
+        var receiver = new VendorCdcReceiver();
+        var recorder = new Recorder(receiver, takeOwnership: false);
+
+        await receiver.RunAsync(new MemoryStream(TestStreams.Concat(bad, TestStreams.Frame(0x11, 6))));
+
+        Assert.Equal(new[] { "discard:11", "frame:11:06" }, recorder.Events);
+    }
+
+    /// <summary>
+    /// Test: FrameHandler receives ownership after the event, with payload intact
+    /// </summary>
+    [Fact]
+    public async Task FrameHandlerOwnsFrames()
+    {
+        var receiver = new VendorCdcReceiver();
+        var recorder = new Recorder(receiver, takeOwnership: true);
+
+        await receiver.RunAsync(new ChunkedStream(SampleStream(), 3));
+
+        Assert.Equal(3, recorder.Owned.Count);
+        Assert.Equal("{\"response\":\"ok\"}", Encoding.UTF8.GetString(recorder.Owned[0].Payload.Span));
+        Assert.Equal(new byte[] { 1, 2 }, recorder.Owned[1].Payload.ToArray());
+        recorder.Owned.ForEach(f => f.Dispose());
+    }
+
+    /// <summary>
+    /// Test: Cancellation stops a loop waiting on a stream that never completes
+    /// </summary>
+    [Fact]
+    public async Task CancellationStopsLoop()
+    {
+        var receiver = new VendorCdcReceiver();
+        using var cts = new CancellationTokenSource(TimeSpan.FromMilliseconds(100));
+        var pipe = new System.IO.Pipelines.Pipe();
+
+        var run = receiver.RunAsync(pipe.Reader.AsStream(), cts.Token);
+
+        Assert.Same(run, await Task.WhenAny(run, Task.Delay(TimeSpan.FromSeconds(5))));
+        await pipe.Writer.CompleteAsync();
+    }
+}
@@ -0,0 +1,77 @@
+using System.Buffers;
+
+namespace BridgeOne.Protocol;
+
+/// <summary>
+/// CRC16-CCITT 체크섬 계산기.
+/// ESP32-S3 측 vendor_cdc_crc16()과 동일한 알고리즘 (다항식 0x1021, 초기값 0x0000).
+/// 바이트당 8회 비트 루프 대신 256-엔트리 테이블로 계산합니다.
+/// </summary>
+public static class Crc16
+{
+    private const ushort Polynomial = 0x1021;
+    private const ushort InitialValue = 0x0000;
+
+    private static readonly ushort[] Table = BuildTable();
+
+    private static ushort[] BuildTable()
+    {
+        var table = new ushort[256];
+        for (int i = 0; i < 256; i++)
+        {
+            ushort crc = (ushort)(i << 8);
+            for (int j = 0; j < 8; j++)
+            {
+                if ((crc & 0x8000) != 0)
+                    crc = (ushort)((crc << 1) ^ Polynomial);
+                else
+                    crc <<= 1;
+            }
+            table[i] = crc;
+        }
+        return table;
+    }
+
+    /// <summary>
+    /// 이전 CRC 값에 이어서 데이터를 누적 계산합니다 (분할된 버퍼용).
+    /// </summary>
+    public static ushort Update(ushort crc, ReadOnlySpan<byte> data)
+    {
+        var table = Table;
+        foreach (byte b in data)
+            crc = (ushort)((crc << 8) ^ table[(crc >> 8) ^ b]);
+        return crc;
+    }
+
+    /// <summary>
+    /// 지정된 바이트 범위에 대해 CRC16-CCITT를 계산합니다.
+    /// </summary>
+    public static ushort Calculate(ReadOnlySpan<byte> data)
+        => Update(InitialValue, data);
+
+    /// <summary>
+    /// 여러 세그먼트로 나뉜 시퀀스에 대해 CRC16-CCITT를 계산합니다 (복사 없음).
+    /// </summary>
+    public static ushort Calculate(in ReadOnlySequence<byte> data)
+    {
+        if (data.IsSingleSegment)
+            return Calculate(data.FirstSpan);
+
+        ushort crc = InitialValue;
+        foreach (var segment in data)
+            crc = Update(crc, segment.Span);
+        return crc;
+    }
+
+    /// <summary>
+    /// 지정된 바이트 범위에 대해 CRC16-CCITT를 계산합니다.
+    /// </summary>
+    public static ushort Calculate(byte[] data, int offset, int length)
+        => Calculate(data.AsSpan(offset, length));
+
+    /// <summary>
+    /// 전체 바이트 배열에 대해 CRC16-CCITT를 계산합니다.
+    /// </summary>
+    public static ushort Calculate(byte[] data)
+        => Calculate(data.AsSpan());
+}
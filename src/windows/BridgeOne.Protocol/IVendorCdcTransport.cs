@@ -0,0 +1,28 @@
+namespace BridgeOne.Protocol;
+
+/// <summary>
+/// Vendor CDC 바이트 스트림을 제공하는 전송 계층.
+/// VendorCdcProtocol / KeepAliveService는 이 인터페이스만 사용하므로
+/// 실제 동글(CdcConnectionService, SerialPort)과 인프로세스 시뮬레이터(LoopbackTransport)를
+/// 같은 코드로 구동할 수 있습니다.
+/// </summary>
+public interface IVendorCdcTransport
+{
+    /// <summary>연결되어 있는지 여부</summary>
+    bool IsConnected { get; }
+
+    /// <summary>연결된 장치와의 양방향 스트림 (미연결 시 null)</summary>
+    Stream? Stream { get; }
+
+    /// <summary>
+    /// 연결/해제 시 발생합니다 (IsConnected로 현재 상태 확인).
+    /// 같은 전이를 구독하는 상위 계층보다 먼저 발생하여 수신 루프가 먼저 준비되게 합니다.
+    /// </summary>
+    event EventHandler? ConnectedChanged;
+
+    /// <summary>장치를 찾아 연결을 시도합니다. 이미 연결되어 있으면 true.</summary>
+    bool TryConnect();
+
+    /// <summary>현재 연결을 해제합니다 (CDC 포트 닫기 = DTR 해제).</summary>
+    void Disconnect();
+}
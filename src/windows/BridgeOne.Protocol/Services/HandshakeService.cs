@@ -0,0 +1,814 @@
+using System.Diagnostics;
+using System.Text;
+using System.Text.Json;
+using BridgeOne.Protocol;
+
+namespace BridgeOne.Services;
+
+/// <summary>
+/// 핸드셰이크 서비스.
+/// ESP32-S3와의 Authentication + State Sync 핸드셰이크를 수행합니다.
+///
+/// 기본: HELLO (0x05) → HELLO_ACK (0x06) 1회 왕복으로 인증과 기능 협상을 함께 처리
+/// 재연결: 이전 ACK로 받은 세션 토큰이 있으면 RESUME (0x07) → RESUME_ACK (0x08)로
+///         재협상 없이 같은 기능 그대로 복귀 (동글 유예 시간 내, 실패 시 같은 시도에서 HELLO로 전환)
+/// 레거시 (HELLO 미지원 펌웨어 또는 UseHello = false):
+///   Phase 1: Authentication - 에코백 방식 인증
+///   Phase 2: State Sync - 기능 협상 및 Keep-alive 주기 합의
+/// </summary>
+public sealed class HandshakeService
+{
+    /// <summary>인증 타임아웃 (1초)</summary>
+    private static readonly TimeSpan AuthTimeout = TimeSpan.FromSeconds(1);
+
+    /// <summary>State Sync 타임아웃 (1초)</summary>
+    private static readonly TimeSpan SyncTimeout = TimeSpan.FromSeconds(1);
+
+    /// <summary>HELLO 타임아웃 (1초)</summary>
+    private static readonly TimeSpan HelloTimeout = TimeSpan.FromSeconds(1);
+
+    /// <summary>RESUME 타임아웃 (1초)</summary>
+    private static readonly TimeSpan ResumeTimeout = TimeSpan.FromSeconds(1);
+
+    /// <summary>ERROR 프레임의 미지원 명령 에러 코드 (vendor_cdc_task)</summary>
+    private const byte UnsupportedCommandError = 0x01;
+
+    /// <summary>ERROR 프레임의 세션 재개 불가 에러 코드 (보류 세션 없음/토큰 불일치/만료)</summary>
+    private const byte SessionRejectedError = 0x03;
+
+    /// <summary>핸드셰이크 최대 재시도 횟수</summary>
+    private const int MaxRetries = 3;
+
+    /// <summary>서버가 지원하는 전체 기능 목록</summary>
+    private static readonly string[] ServerFeatures =
+        ["wheel", "drag", "right_click", "multi_cursor", "macro", "extended_keyboard"];
+
+    /// <summary>기본 Keep-alive 주기 (ms)</summary>
+    private const int DefaultKeepaliveMs = 500;
+
+    private readonly VendorCdcProtocol _protocol;
+    private readonly IAuthVerifier _authVerifier;
+
+    /// <summary>동글이 HELLO에 ERROR(미지원)로 응답한 적 있음 → 이후 레거시 경로만 사용</summary>
+    private volatile bool _helloUnsupported;
+
+    /// <summary>
+    /// HELLO 1회 왕복 핸드셰이크 사용 여부 (기본 true).
+    /// 동글이 HELLO를 지원하지 않으면 자동으로 레거시 2단계 경로를 사용합니다.
+    /// </summary>
+    public bool UseHello { get; set; } = true;
+
+    /// <summary>연결된 동글이 HELLO를 지원하지 않는 것으로 확인되었는지 여부</summary>
+    public bool IsHelloUnsupported => _helloUnsupported;
+
+    /// <summary>마지막 HELLO_ACK / STATE_SYNC_ACK로 받은 세션 토큰 (재개 실패 시 폐기)</summary>
+    private volatile string? _sessionToken;
+
+    /// <summary>동글이 RESUME에 ERROR(미지원)로 응답한 적 있음</summary>
+    private volatile bool _resumeUnsupported;
+
+    /// <summary>
+    /// 재연결 시 세션 토큰으로 RESUME을 먼저 시도할지 여부 (기본 true).
+    /// </summary>
+    public bool UseResume { get; set; } = true;
+
+    /// <summary>RESUME에 사용할 세션 토큰을 보유하고 있는지 여부</summary>
+    public bool HasSession => _sessionToken != null;
+
+    /// <summary>인증 성공 시 ESP32-S3가 보고한 디바이스 이름</summary>
+    public string? DeviceName { get; private set; }
+
+    /// <summary>인증 성공 시 ESP32-S3가 보고한 펌웨어 버전</summary>
+    public string? FirmwareVersion { get; private set; }
+
+    public HandshakeService(VendorCdcProtocol protocol, IAuthVerifier? authVerifier = null)
+    {
+        _protocol = protocol;
+        _authVerifier = authVerifier ?? new EchoBackVerifier();
+    }
+
+    /// <summary>
+    /// Authentication 단계를 수행합니다.
+    ///
+    /// 1. 랜덤 챌린지 생성
+    /// 2. CMD_AUTH_CHALLENGE (0x01) 프레임 전송
+    /// 3. 1초 타임아웃으로 CMD_AUTH_RESPONSE (0x02) 대기
+    /// 4. 응답의 response 필드가 challenge와 일치하는지 검증
+    /// 5. 디바이스 정보 저장
+    /// </summary>
+    /// <param name="cancellationToken">외부 취소 토큰</param>
+    /// <returns>인증 결과</returns>
+    public async Task<AuthResult> AuthenticateAsync(CancellationToken cancellationToken = default)
+    {
+        // 1. 챌린지 생성
+        var challenge = _authVerifier.GenerateChallenge();
+        Debug.WriteLine($"[HandshakeService] Challenge generated: {challenge}");
+
+        // 2. AUTH_CHALLENGE JSON 조립 및 전송
+        var challengeJson = JsonSerializer.Serialize(new
+        {
+            command = "AUTH_CHALLENGE",
+            challenge,
+            version = "1.0"
+        });
+
+        try
+        {
+            await _protocol.SendFrameAsync(
+                (byte)VendorCdcCommand.AuthChallenge,
+                challengeJson,
+                cancellationToken);
+        }
+        catch (Exception ex)
+        {
+            Debug.WriteLine($"[HandshakeService] AUTH_CHALLENGE 전송 실패: {ex.Message}");
+            return AuthResult.Failed("AUTH_CHALLENGE 전송 실패");
+        }
+
+        // 3. AUTH_RESPONSE 대기 (1초 타임아웃)
+        using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        timeoutCts.CancelAfter(AuthTimeout);
+
+        try
+        {
+            while (await _protocol.FrameReader.WaitToReadAsync(timeoutCts.Token))
+            {
+                while (_protocol.FrameReader.TryRead(out var received))
+                {
+                    using var frame = received;
+
+                    // AUTH_RESPONSE가 아닌 프레임은 무시
+                    if (frame.Command != (byte)VendorCdcCommand.AuthResponse)
+                        continue;
+
+                    // JSON 파싱
+                    var payloadStr = Encoding.UTF8.GetString(frame.Payload.Span);
+                    Debug.WriteLine($"[HandshakeService] AUTH_RESPONSE received: {payloadStr}");
+
+                    JsonDocument? doc;
+                    try
+                    {
+                        doc = JsonDocument.Parse(payloadStr);
+                    }
+                    catch (JsonException ex)
+                    {
+                        Debug.WriteLine(
+                            $"[HandshakeService] AUTH_RESPONSE JSON 파싱 실패: {ex.Message}");
+                        return AuthResult.Failed("AUTH_RESPONSE JSON 파싱 실패");
+                    }
+
+                    using (doc)
+                    {
+                        if (!TryVerifyAuthResponse(doc.RootElement, challenge, "AUTH_RESPONSE", out var error))
+                            return AuthResult.Failed(error);
+
+                        Debug.WriteLine(
+                            $"[HandshakeService] 인증 성공: device={DeviceName}, fw={FirmwareVersion}");
+
+                        return AuthResult.Succeeded(DeviceName, FirmwareVersion);
+                    }
+                }
+            }
+        }
+        catch (OperationCanceledException) when (timeoutCts.IsCancellationRequested
+                                                   && !cancellationToken.IsCancellationRequested)
+        {
+            Debug.WriteLine("[HandshakeService] AUTH_RESPONSE 타임아웃 (1초)");
+            return AuthResult.Failed("AUTH_RESPONSE 타임아웃");
+        }
+
+        return AuthResult.Failed("AUTH_RESPONSE를 수신하지 못함");
+    }
+
+    /// <summary>
+    /// State Sync 단계를 수행합니다.
+    ///
+    /// 1. 서버가 지원하는 전체 기능 목록과 Keep-alive 주기를 전송
+    /// 2. CMD_STATE_SYNC (0x03) 프레임 전송
+    /// 3. 1초 타임아웃으로 CMD_STATE_SYNC_ACK (0x04) 대기
+    /// 4. ESP32-S3가 수락한 기능 목록 저장
+    /// </summary>
+    /// <param name="cancellationToken">외부 취소 토큰</param>
+    /// <returns>State Sync 결과</returns>
+    public async Task<SyncResult> StateSyncAsync(CancellationToken cancellationToken = default)
+    {
+        // 1. STATE_SYNC JSON 조립 및 전송
+        var syncJson = JsonSerializer.Serialize(new
+        {
+            command = "STATE_SYNC",
+            features = ServerFeatures,
+            keepalive_ms = DefaultKeepaliveMs
+        });
+
+        Debug.WriteLine($"[HandshakeService] STATE_SYNC 전송: {syncJson}");
+
+        try
+        {
+            await _protocol.SendFrameAsync(
+                (byte)VendorCdcCommand.StateSync,
+                syncJson,
+                cancellationToken);
+        }
+        catch (Exception ex)
+        {
+            Debug.WriteLine($"[HandshakeService] STATE_SYNC 전송 실패: {ex.Message}");
+            return SyncResult.Failed("STATE_SYNC 전송 실패");
+        }
+
+        // 2. STATE_SYNC_ACK 대기 (1초 타임아웃)
+        using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        timeoutCts.CancelAfter(SyncTimeout);
+
+        try
+        {
+            while (await _protocol.FrameReader.WaitToReadAsync(timeoutCts.Token))
+            {
+                while (_protocol.FrameReader.TryRead(out var received))
+                {
+                    using var frame = received;
+
+                    // STATE_SYNC_ACK가 아닌 프레임은 무시
+                    if (frame.Command != (byte)VendorCdcCommand.StateSyncAck)
+                        continue;
+
+                    // JSON 파싱
+                    var payloadStr = Encoding.UTF8.GetString(frame.Payload.Span);
+                    Debug.WriteLine($"[HandshakeService] STATE_SYNC_ACK received: {payloadStr}");
+
+                    JsonDocument? doc;
+                    try
+                    {
+                        doc = JsonDocument.Parse(payloadStr);
+                    }
+                    catch (JsonException ex)
+                    {
+                        Debug.WriteLine(
+                            $"[HandshakeService] STATE_SYNC_ACK JSON 파싱 실패: {ex.Message}");
+                        return SyncResult.Failed("STATE_SYNC_ACK JSON 파싱 실패");
+                    }
+
+                    using (doc)
+                    {
+                        var root = doc.RootElement;
+                        var acceptedFeatures = ReadAcceptedFeatures(root);
+                        var mode = ReadMode(root);
+                        _sessionToken = ReadSessionToken(root);
+
+                        Debug.WriteLine(
+                            $"[HandshakeService] State Sync 성공: accepted=[{string.Join(", ", acceptedFeatures)}], mode={mode}");
+
+                        return SyncResult.Succeeded(acceptedFeatures, mode);
+                    }
+                }
+            }
+        }
+        catch (OperationCanceledException) when (timeoutCts.IsCancellationRequested
+                                                   && !cancellationToken.IsCancellationRequested)
+        {
+            Debug.WriteLine("[HandshakeService] STATE_SYNC_ACK 타임아웃 (1초)");
+            return SyncResult.Failed("STATE_SYNC_ACK 타임아웃");
+        }
+
+        return SyncResult.Failed("STATE_SYNC_ACK를 수신하지 못함");
+    }
+
+    /// <summary>
+    /// HELLO 1회 왕복 핸드셰이크를 수행합니다.
+    ///
+    /// 1. 랜덤 챌린지 생성
+    /// 2. CMD_HELLO (0x05) 프레임 전송 (challenge + version + features + keepalive_ms)
+    /// 3. 1초 타임아웃으로 CMD_HELLO_ACK (0x06) 대기
+    /// 4. response 검증 + 디바이스 정보 + 수락된 기능 목록 저장
+    ///
+    /// 동글이 ERROR [0x05, 0x01]로 응답하면(이전 펌웨어) HelloUnsupported로 실패하고
+    /// 이후 PerformHandshakeAsync는 레거시 경로만 사용합니다.
+    /// </summary>
+    /// <param name="cancellationToken">외부 취소 토큰</param>
+    /// <returns>핸드셰이크 결과</returns>
+    public async Task<HandshakeResult> HelloAsync(CancellationToken cancellationToken = default)
+    {
+        // 1. 챌린지 생성
+        var challenge = _authVerifier.GenerateChallenge();
+
+        // 2. HELLO JSON 조립 및 전송
+        var helloJson = JsonSerializer.Serialize(new
+        {
+            command = "HELLO",
+            challenge,
+            version = "1.0",
+            features = ServerFeatures,
+            keepalive_ms = DefaultKeepaliveMs
+        });
+
+        Debug.WriteLine($"[HandshakeService] HELLO 전송: {helloJson}");
+
+        try
+        {
+            await _protocol.SendFrameAsync(
+                (byte)VendorCdcCommand.Hello,
+                helloJson,
+                cancellationToken);
+        }
+        catch (Exception ex)
+        {
+            Debug.WriteLine($"[HandshakeService] HELLO 전송 실패: {ex.Message}");
+            return HandshakeResult.Failed(HandshakeFailReason.HelloFailed, "HELLO 전송 실패");
+        }
+
+        // 3. HELLO_ACK 또는 미지원 ERROR 대기 (1초 타임아웃)
+        using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        timeoutCts.CancelAfter(HelloTimeout);
+
+        try
+        {
+            while (await _protocol.FrameReader.WaitToReadAsync(timeoutCts.Token))
+            {
+                while (_protocol.FrameReader.TryRead(out var received))
+                {
+                    using var frame = received;
+
+                    if (frame.Command == (byte)VendorCdcCommand.Error)
+                    {
+                        if (IsHelloUnsupportedError(frame.Payload.Span))
+                        {
+                            _helloUnsupported = true;
+                            Debug.WriteLine("[HandshakeService] HELLO 미지원 펌웨어 → 레거시 핸드셰이크 사용");
+                            return HandshakeResult.Failed(HandshakeFailReason.HelloUnsupported,
+                                "HELLO 미지원 펌웨어");
+                        }
+                        continue;
+                    }
+
+                    // HELLO_ACK가 아닌 프레임은 무시
+                    if (frame.Command != (byte)VendorCdcCommand.HelloAck)
+                        continue;
+
+                    // JSON 파싱
+                    var payloadStr = Encoding.UTF8.GetString(frame.Payload.Span);
+                    Debug.WriteLine($"[HandshakeService] HELLO_ACK received: {payloadStr}");
+
+                    JsonDocument? doc;
+                    try
+                    {
+                        doc = JsonDocument.Parse(payloadStr);
+                    }
+                    catch (JsonException ex)
+                    {
+                        Debug.WriteLine(
+                            $"[HandshakeService] HELLO_ACK JSON 파싱 실패: {ex.Message}");
+                        return HandshakeResult.Failed(HandshakeFailReason.HelloFailed,
+                            "HELLO_ACK JSON 파싱 실패");
+                    }
+
+                    using (doc)
+                    {
+                        var root = doc.RootElement;
+
+                        // 4. 인증 검증 + 기능 목록
+                        if (!TryVerifyAuthResponse(root, challenge, "HELLO_ACK", out var authError))
+                            return HandshakeResult.Failed(HandshakeFailReason.HelloFailed, authError);
+
+                        var acceptedFeatures = ReadAcceptedFeatures(root);
+                        var mode = ReadMode(root);
+                        _sessionToken = ReadSessionToken(root);
+
+                        Debug.WriteLine(
+                            $"[HandshakeService] HELLO 성공: device={DeviceName}, " +
+                            $"accepted=[{string.Join(", ", acceptedFeatures)}], mode={mode}");
+
+                        return HandshakeResult.Connected(
+                            acceptedFeatures, mode, DeviceName, FirmwareVersion, HandshakeMethod.Hello);
+                    }
+                }
+            }
+        }
+        catch (OperationCanceledException) when (timeoutCts.IsCancellationRequested
+                                                   && !cancellationToken.IsCancellationRequested)
+        {
+            Debug.WriteLine("[HandshakeService] HELLO_ACK 타임아웃 (1초)");
+            return HandshakeResult.Failed(HandshakeFailReason.HelloFailed, "HELLO_ACK 타임아웃");
+        }
+
+        return HandshakeResult.Failed(HandshakeFailReason.HelloFailed, "HELLO_ACK를 수신하지 못함");
+    }
+
+    /// <summary>
+    /// 세션 재개를 수행합니다 (DTR 해제 / Keep-alive 타임아웃 후 재연결).
+    ///
+    /// 1. 보유한 세션 토큰으로 CMD_RESUME (0x07) 전송
+    /// 2. 1초 타임아웃으로 CMD_RESUME_ACK (0x08) 대기
+    /// 3. 동글이 보류해 둔 기능 목록 그대로 연결 완료 (재인증/재협상 없음)
+    ///
+    /// 동글이 ERROR [0x07, 0x03](세션 없음/만료) 또는 [0x07, 0x01](이전 펌웨어)로 응답하면
+    /// 토큰을 폐기하고 실패를 반환하므로 호출자는 전체 핸드셰이크로 진행합니다.
+    /// </summary>
+    /// <param name="cancellationToken">외부 취소 토큰</param>
+    /// <returns>핸드셰이크 결과</returns>
+    public async Task<HandshakeResult> ResumeAsync(CancellationToken cancellationToken = default)
+    {
+        var token = _sessionToken;
+        if (token == null)
+            return HandshakeResult.Failed(HandshakeFailReason.ResumeRejected, "재개할 세션 없음");
+
+        // 재개는 한 번만 시도 (성공하면 동글이 같은 토큰을 계속 유지하므로 다시 설정)
+        _sessionToken = null;
+
+        var resumeJson = JsonSerializer.Serialize(new
+        {
+            command = "RESUME",
+            session = token
+        });
+
+        Debug.WriteLine($"[HandshakeService] RESUME 전송: {resumeJson}");
+
+        try
+        {
+            await _protocol.SendFrameAsync(
+                (byte)VendorCdcCommand.Resume,
+                resumeJson,
+                cancellationToken);
+        }
+        catch (Exception ex)
+        {
+            Debug.WriteLine($"[HandshakeService] RESUME 전송 실패: {ex.Message}");
+            return HandshakeResult.Failed(HandshakeFailReason.ResumeFailed, "RESUME 전송 실패");
+        }
+
+        using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        timeoutCts.CancelAfter(ResumeTimeout);
+
+        try
+        {
+            while (await _protocol.FrameReader.WaitToReadAsync(timeoutCts.Token))
+            {
+                while (_protocol.FrameReader.TryRead(out var received))
+                {
+                    using var frame = received;
+
+                    if (frame.Command == (byte)VendorCdcCommand.Error)
+                    {
+                        var errorCode = GetErrorCodeFor(frame.Payload.Span, VendorCdcCommand.Resume);
+                        if (errorCode == UnsupportedCommandError)
+                        {
+                            _resumeUnsupported = true;
+                            Debug.WriteLine("[HandshakeService] RESUME 미지원 펌웨어 → 전체 핸드셰이크 사용");
+                            return HandshakeResult.Failed(HandshakeFailReason.ResumeRejected,
+                                "RESUME 미지원 펌웨어");
+                        }
+                        if (errorCode == SessionRejectedError)
+                        {
+                            Debug.WriteLine("[HandshakeService] 세션 재개 거부 (만료 또는 토큰 불일치)");
+                            return HandshakeResult.Failed(HandshakeFailReason.ResumeRejected,
+                                "세션 만료 또는 토큰 불일치");
+                        }
+                        continue;
+                    }
+
+                    if (frame.Command != (byte)VendorCdcCommand.ResumeAck)
+                        continue;
+
+                    var payloadStr = Encoding.UTF8.GetString(frame.Payload.Span);
+                    Debug.WriteLine($"[HandshakeService] RESUME_ACK received: {payloadStr}");
+
+                    JsonDocument? doc;
+                    try
+                    {
+                        doc = JsonDocument.Parse(payloadStr);
+                    }
+                    catch (JsonException ex)
+                    {
+                        Debug.WriteLine(
+                            $"[HandshakeService] RESUME_ACK JSON 파싱 실패: {ex.Message}");
+                        return HandshakeResult.Failed(HandshakeFailReason.ResumeFailed,
+                            "RESUME_ACK JSON 파싱 실패");
+                    }
+
+                    using (doc)
+                    {
+                        var root = doc.RootElement;
+                        var acceptedFeatures = ReadAcceptedFeatures(root);
+                        var mode = ReadMode(root);
+                        _sessionToken = token;
+
+                        Debug.WriteLine(
+                            $"[HandshakeService] 세션 재개 성공: accepted=[{string.Join(", ", acceptedFeatures)}], mode={mode}");
+
+                        return HandshakeResult.Connected(
+                            acceptedFeatures, mode, DeviceName, FirmwareVersion, HandshakeMethod.Resume);
+                    }
+                }
+            }
+        }
+        catch (OperationCanceledException) when (timeoutCts.IsCancellationRequested
+                                                   && !cancellationToken.IsCancellationRequested)
+        {
+            Debug.WriteLine("[HandshakeService] RESUME_ACK 타임아웃 (1초)");
+            return HandshakeResult.Failed(HandshakeFailReason.ResumeFailed, "RESUME_ACK 타임아웃");
+        }
+
+        return HandshakeResult.Failed(HandshakeFailReason.ResumeFailed, "RESUME_ACK를 수신하지 못함");
+    }
+
+    /// <summary>ERROR 페이로드 [원래 명령, 에러 코드]가 command에 대한 것이면 에러 코드, 아니면 null</summary>
+    private static byte? GetErrorCodeFor(ReadOnlySpan<byte> payload, VendorCdcCommand command)
+        => payload.Length >= 2 && payload[0] == (byte)command ? payload[1] : null;
+
+    /// <summary>ERROR 페이로드가 [CMD_HELLO, 미지원 명령]인지 확인</summary>
+    private static bool IsHelloUnsupportedError(ReadOnlySpan<byte> payload)
+        => GetErrorCodeFor(payload, VendorCdcCommand.Hello) == UnsupportedCommandError;
+
+    /// <summary>
+    /// AUTH_RESPONSE / HELLO_ACK의 response 필드를 검증하고 디바이스 정보를 저장합니다.
+    /// </summary>
+    private bool TryVerifyAuthResponse(JsonElement root, string challenge, string frameName, out string error)
+    {
+        // response 필드 추출 및 검증
+        if (!root.TryGetProperty("response", out var responseProp))
+        {
+            error = $"{frameName}에 'response' 필드 없음";
+            return false;
+        }
+
+        var response = responseProp.GetString();
+        if (response == null)
+        {
+            error = $"{frameName}의 'response' 필드가 null";
+            return false;
+        }
+
+        if (!_authVerifier.VerifyResponse(challenge, response))
+        {
+            Debug.WriteLine(
+                $"[HandshakeService] 인증 실패: challenge={challenge}, response={response}");
+            error = "챌린지 응답 불일치";
+            return false;
+        }
+
+        // 디바이스 정보 저장
+        DeviceName = root.TryGetProperty("device", out var deviceProp)
+            ? deviceProp.GetString()
+            : null;
+        FirmwareVersion = root.TryGetProperty("fw_version", out var fwProp)
+            ? fwProp.GetString()
+            : null;
+
+        error = string.Empty;
+        return true;
+    }
+
+    /// <summary>STATE_SYNC_ACK / HELLO_ACK / RESUME_ACK의 accepted_features 배열 추출</summary>
+    private static string[] ReadAcceptedFeatures(JsonElement root)
+    {
+        var acceptedFeatures = new List<string>();
+        if (root.TryGetProperty("accepted_features", out var featuresProp) &&
+            featuresProp.ValueKind == JsonValueKind.Array)
+        {
+            foreach (var item in featuresProp.EnumerateArray())
+            {
+                var name = item.GetString();
+                if (name != null)
+                    acceptedFeatures.Add(name);
+            }
+        }
+        return acceptedFeatures.ToArray();
+    }
+
+    /// <summary>STATE_SYNC_ACK / HELLO_ACK의 session 필드 추출 (세션 재개 미지원 펌웨어면 null)</summary>
+    private static string? ReadSessionToken(JsonElement root)
+        => root.TryGetProperty("session", out var sessionProp) && sessionProp.ValueKind == JsonValueKind.String
+            ? sessionProp.GetString()
+            : null;
+
+    /// <summary>STATE_SYNC_ACK / HELLO_ACK / RESUME_ACK의 mode 필드 추출 (기본 "standard")</summary>
+    private static string ReadMode(JsonElement root)
+        => root.TryGetProperty("mode", out var modeProp)
+            ? modeProp.GetString() ?? "standard"
+            : "standard";
+
+    /// <summary>
+    /// 전체 핸드셰이크를 수행합니다.
+    /// 세션 토큰이 있으면 RESUME을 먼저 시도하고, 거부되면 같은 시도 안에서 HELLO로 진행합니다.
+    /// HELLO는 동글이 미지원이면 같은 시도 안에서 Auth + State Sync로 전환합니다.
+    /// 실패 시 최대 3회 재시도하며 지수 백오프(1초 → 2초 → 4초)를 적용합니다.
+    /// </summary>
+    /// <param name="cancellationToken">외부 취소 토큰</param>
+    /// <returns>핸드셰이크 결과</returns>
+    public async Task<HandshakeResult> PerformHandshakeAsync(CancellationToken cancellationToken = default)
+    {
+        for (int attempt = 1; attempt <= MaxRetries; attempt++)
+        {
+            Debug.WriteLine($"[HandshakeService] 핸드셰이크 시도 {attempt}/{MaxRetries}");
+
+            // RESUME: 이전 세션 그대로 1회 왕복 복귀 (실패하면 토큰 폐기 후 전체 핸드셰이크)
+            if (UseResume && !_resumeUnsupported && _sessionToken != null)
+            {
+                var resumeResult = await ResumeAsync(cancellationToken);
+                if (resumeResult.Success)
+                    return resumeResult;
+
+                Debug.WriteLine(
+                    $"[HandshakeService] 세션 재개 실패 (시도 {attempt}): {resumeResult.ErrorMessage}");
+            }
+
+            // HELLO: 1회 왕복 (미지원이면 아래 레거시 경로로 계속)
+            if (UseHello && !_helloUnsupported)
+            {
+                var helloResult = await HelloAsync(cancellationToken);
+                if (helloResult.Success)
+                    return helloResult;
+
+                if (helloResult.FailReason != HandshakeFailReason.HelloUnsupported)
+                {
+                    Debug.WriteLine(
+                        $"[HandshakeService] HELLO 실패 (시도 {attempt}): {helloResult.ErrorMessage}");
+
+                    if (attempt < MaxRetries)
+                    {
+                        var delay = TimeSpan.FromSeconds(Math.Pow(2, attempt - 1));
+                        Debug.WriteLine($"[HandshakeService] {delay.TotalSeconds}초 후 재시도...");
+                        await Task.Delay(delay, cancellationToken);
+                        continue;
+                    }
+
+                    return helloResult;
+                }
+            }
+
+            // Phase 1: Authentication
+            var authResult = await AuthenticateAsync(cancellationToken);
+            if (!authResult.Success)
+            {
+                Debug.WriteLine(
+                    $"[HandshakeService] 인증 실패 (시도 {attempt}): {authResult.ErrorMessage}");
+
+                if (attempt < MaxRetries)
+                {
+                    var delay = TimeSpan.FromSeconds(Math.Pow(2, attempt - 1)); // 1s, 2s, 4s
+                    Debug.WriteLine($"[HandshakeService] {delay.TotalSeconds}초 후 재시도...");
+                    await Task.Delay(delay, cancellationToken);
+                    continue;
+                }
+
+                return HandshakeResult.Failed(HandshakeFailReason.AuthFailed, authResult.ErrorMessage);
+            }
+
+            // Phase 2: State Sync
+            var syncResult = await StateSyncAsync(cancellationToken);
+            if (!syncResult.Success)
+            {
+                Debug.WriteLine(
+                    $"[HandshakeService] State Sync 실패 (시도 {attempt}): {syncResult.ErrorMessage}");
+
+                if (attempt < MaxRetries)
+                {
+                    var delay = TimeSpan.FromSeconds(Math.Pow(2, attempt - 1));
+                    Debug.WriteLine($"[HandshakeService] {delay.TotalSeconds}초 후 재시도...");
+                    await Task.Delay(delay, cancellationToken);
+                    continue;
+                }
+
+                return HandshakeResult.Failed(HandshakeFailReason.SyncFailed, syncResult.ErrorMessage);
+            }
+
+            // 핸드셰이크 성공
+            Debug.WriteLine(
+                $"[HandshakeService] 핸드셰이크 완료 (시도 {attempt}): " +
+                $"device={DeviceName}, features=[{string.Join(", ", syncResult.AcceptedFeatures)}]");
+
+            return HandshakeResult.Connected(
+                syncResult.AcceptedFeatures,
+                syncResult.Mode,
+                DeviceName,
+                FirmwareVersion,
+                HandshakeMethod.TwoPhase);
+        }
+
+        return HandshakeResult.Failed(HandshakeFailReason.MaxRetriesExceeded,
+            $"최대 재시도 횟수({MaxRetries}) 초과");
+    }
+}
+
+/// <summary>
+/// 인증 결과를 나타내는 클래스.
+/// </summary>
+public sealed class AuthResult
+{
+    public bool Success { get; }
+    public string? ErrorMessage { get; }
+    public string? DeviceName { get; }
+    public string? FirmwareVersion { get; }
+
+    private AuthResult(bool success, string? errorMessage, string? deviceName, string? fwVersion)
+    {
+        Success = success;
+        ErrorMessage = errorMessage;
+        DeviceName = deviceName;
+        FirmwareVersion = fwVersion;
+    }
+
+    public static AuthResult Succeeded(string? deviceName, string? fwVersion)
+        => new(true, null, deviceName, fwVersion);
+
+    public static AuthResult Failed(string errorMessage)
+        => new(false, errorMessage, null, null);
+}
+
+/// <summary>
+/// State Sync 결과를 나타내는 클래스.
+/// </summary>
+public sealed class SyncResult
+{
+    public bool Success { get; }
+    public string? ErrorMessage { get; }
+    public string[] AcceptedFeatures { get; }
+    public string Mode { get; }
+
+    private SyncResult(bool success, string? errorMessage, string[] acceptedFeatures, string mode)
+    {
+        Success = success;
+        ErrorMessage = errorMessage;
+        AcceptedFeatures = acceptedFeatures;
+        Mode = mode;
+    }
+
+    public static SyncResult Succeeded(string[] acceptedFeatures, string mode)
+        => new(true, null, acceptedFeatures, mode);
+
+    public static SyncResult Failed(string errorMessage)
+        => new(false, errorMessage, Array.Empty<string>(), "");
+}
+
+/// <summary>
+/// 핸드셰이크 실패 사유.
+/// </summary>
+public enum HandshakeFailReason
+{
+    AuthFailed,
+    SyncFailed,
+    MaxRetriesExceeded,
+    HelloFailed,
+    HelloUnsupported,
+    ResumeFailed,
+    ResumeRejected,
+}
+
+/// <summary>
+/// 연결에 사용된 핸드셰이크 방식.
+/// </summary>
+public enum HandshakeMethod
+{
+    /// <summary>AUTH_CHALLENGE + STATE_SYNC (2회 왕복)</summary>
+    TwoPhase,
+
+    /// <summary>HELLO (1회 왕복)</summary>
+    Hello,
+
+    /// <summary>RESUME: 세션 토큰으로 이전 기능 그대로 복귀 (1회 왕복)</summary>
+    Resume,
+}
+
+/// <summary>
+/// 전체 핸드셰이크(RESUME, HELLO 또는 Auth + State Sync) 결과를 나타내는 클래스.
+/// </summary>
+public sealed class HandshakeResult
+{
+    public bool Success { get; }
+    public HandshakeFailReason? FailReason { get; }
+    public string? ErrorMessage { get; }
+    public string[] AcceptedFeatures { get; }
+    public string Mode { get; }
+    public string? DeviceName { get; }
+    public string? FirmwareVersion { get; }
+
+    /// <summary>연결에 사용된 핸드셰이크 방식</summary>
+    public HandshakeMethod Method { get; }
+
+    private HandshakeResult(
+        bool success,
+        HandshakeFailReason? failReason,
+        string? errorMessage,
+        string[] acceptedFeatures,
+        string mode,
+        string? deviceName,
+        string? fwVersion,
+        HandshakeMethod method = HandshakeMethod.TwoPhase)
+    {
+        Success = success;
+        FailReason = failReason;
+        ErrorMessage = errorMessage;
+        AcceptedFeatures = acceptedFeatures;
+        Mode = mode;
+        DeviceName = deviceName;
+        FirmwareVersion = fwVersion;
+        Method = method;
+    }
+
+    public static HandshakeResult Connected(
+        string[] acceptedFeatures, string mode,
+        string? deviceName, string? fwVersion,
+        HandshakeMethod method = HandshakeMethod.TwoPhase)
+        => new(true, null, null, acceptedFeatures, mode, deviceName, fwVersion, method);
+
+    public static HandshakeResult Failed(HandshakeFailReason reason, string? errorMessage)
+        => new(false, reason, errorMessage, Array.Empty<string>(), "", null, null);
+}
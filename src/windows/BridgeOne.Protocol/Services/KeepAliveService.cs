@@ -1,5 +1,4 @@
 using System.Diagnostics;
-using System.Text;
 using System.Text.Json;
 using BridgeOne.Protocol;
 
@@ -9,18 +8,23 @@ namespace BridgeOne.Services;
 /// Keep-alive 서비스.
 /// 핸드셰이크 완료 후 주기적으로 PING을 전송하고 PONG 응답을 모니터링합니다.
 ///
-/// - 0.5초(500ms) 주기 PING 전송
-/// - PONG 응답으로 RTT(왕복 지연) 측정
+/// - 기본 0.5초(500ms) 주기 PING 전송 (PingInterval로 최소 50ms까지 조정)
+/// - PONG 응답으로 RTT(왕복 지연) 측정 (Stopwatch 기준, ms 미만 해상도)
 /// - 연속 3회 실패 시 ConnectionLost 이벤트 발생
 /// - 지수 백오프 자동 재연결 (1초 → 2초 → 4초 → 8초 → 16초 → 30초)
-/// - 최근 10개 RTT의 이동 평균으로 연결 품질 판정
+///   세션 토큰이 있으면 첫 시도는 대기 없이 RESUME (동글 유예 시간 안에 같은 기능으로 복귀)
+/// - RTT/손실을 RttHistogram에 기록하고 최근 10초의 p99 + 손실률로 연결 품질 판정
+///   (평균은 간헐적인 지연 스파이크를 가리므로 꼬리 지연 기준)
 /// </summary>
 public sealed class KeepAliveService : IDisposable
 {
     // ==================== 상수 ====================
 
-    /// <summary>PING 전송 주기 (ms)</summary>
-    private const int PingIntervalMs = 500;
+    /// <summary>기본 PING 전송 주기</summary>
+    public static readonly TimeSpan DefaultPingInterval = TimeSpan.FromMilliseconds(500);
+
+    /// <summary>허용되는 최소 PING 전송 주기</summary>
+    public static readonly TimeSpan MinPingInterval = TimeSpan.FromMilliseconds(50);
 
     /// <summary>PONG 응답 타임아웃 (ms)</summary>
     private const int PongTimeoutMs = 1000;
@@ -28,22 +32,34 @@ public sealed class KeepAliveService : IDisposable
     /// <summary>연속 실패 허용 횟수</summary>
     private const int MaxConsecutiveFailures = 3;
 
-    /// <summary>RTT 이동 평균 윈도우 크기</summary>
-    private const int RttWindowSize = 10;
+    /// <summary>품질 판정에 쓰는 윈도우 (500ms 주기 기준 20샘플)</summary>
+    public static readonly TimeSpan QualityWindow = TimeSpan.FromSeconds(10);
+
+    /// <summary>UI 표시용 히스토그램 윈도우 (= 히스토그램 최대 보관 기간)</summary>
+    public static readonly TimeSpan DisplayWindow = TimeSpan.FromSeconds(60);
+
+    /// <summary>UI 히스토그램 구간 상한 (ms). 마지막 칸은 200ms 이상.</summary>
+    public static readonly double[] DisplayBinEdgesMs = [1, 2, 5, 10, 20, 50, 100, 200];
 
     /// <summary>재연결 지수 백오프 최대 대기 시간 (초)</summary>
     private const int MaxReconnectDelaySec = 30;
 
-    /// <summary>연결 품질 기준: 양호 (RTT < 20ms)</summary>
+    /// <summary>연결 품질 기준: 양호 (p99 RTT ≤ 20ms)</summary>
     private const double QualityGoodThresholdMs = 20;
 
-    /// <summary>연결 품질 기준: 보통 (RTT < 100ms)</summary>
+    /// <summary>연결 품질 기준: 보통 (p99 RTT ≤ 100ms)</summary>
     private const double QualityFairThresholdMs = 100;
 
+    /// <summary>연결 품질 기준: 양호 손실률 상한 (1%)</summary>
+    private const double QualityGoodMaxLossRate = 0.01;
+
+    /// <summary>연결 품질 기준: 보통 손실률 상한 (5%)</summary>
+    private const double QualityFairMaxLossRate = 0.05;
+
     // ==================== 의존성 ====================
 
     private readonly VendorCdcProtocol _protocol;
-    private readonly CdcConnectionService _connectionService;
+    private readonly IVendorCdcTransport _transport;
     private readonly HandshakeService _handshakeService;
 
     // ==================== 상태 ====================
@@ -54,8 +70,9 @@ public sealed class KeepAliveService : IDisposable
     private Task? _reconnectTask;
 
     private int _consecutiveFailures;
-    private readonly Queue<double> _rttWindow = new();
+    private readonly RttHistogram _rttHistogram = new(TimeSpan.FromSeconds(1), (int)DisplayWindow.TotalSeconds);
     private readonly object _rttLock = new();
+    private TimeSpan _pingInterval = DefaultPingInterval;
     private bool _disposed;
     private bool _isRunning;
 
@@ -81,19 +98,24 @@ public sealed class KeepAliveService : IDisposable
 
     // ==================== 공개 속성 ====================
 
-    /// <summary>현재 평균 RTT (ms). 측정값 없으면 -1.</summary>
-    public double AverageRttMs
+    /// <summary>
+    /// PING 전송 주기 (기본 500ms, 최소 50ms). 동작 중 변경하면 다음 주기부터 적용됩니다.
+    /// </summary>
+    public TimeSpan PingInterval
     {
-        get
+        get => _pingInterval;
+        set
         {
-            lock (_rttLock)
-            {
-                if (_rttWindow.Count == 0) return -1;
-                return _rttWindow.Average();
-            }
+            if (value < MinPingInterval)
+                throw new ArgumentOutOfRangeException(nameof(value), value,
+                    $"PING 주기는 {MinPingInterval.TotalMilliseconds}ms 이상이어야 합니다.");
+            _pingInterval = value;
         }
     }
 
+    /// <summary>품질 판정 윈도우(최근 10초)의 RTT 통계</summary>
+    public RttPercentiles RecentRtt => GetRttPercentiles(QualityWindow);
+
     /// <summary>마지막 RTT (ms). 측정값 없으면 -1.</summary>
     public double LastRttMs { get; private set; } = -1;
 
@@ -110,11 +132,11 @@ public sealed class KeepAliveService : IDisposable
 
     public KeepAliveService(
         VendorCdcProtocol protocol,
-        CdcConnectionService connectionService,
+        IVendorCdcTransport transport,
         HandshakeService handshakeService)
     {
         _protocol = protocol;
-        _connectionService = connectionService;
+        _transport = transport;
         _handshakeService = handshakeService;
     }
 
@@ -136,7 +158,7 @@ public sealed class KeepAliveService : IDisposable
         _keepAliveTask = Task.Run(() => KeepAliveLoopAsync(_keepAliveCts.Token));
         _isRunning = true;
 
-        RaiseStatusLog("Keep-alive 시작 (500ms 주기)");
+        RaiseStatusLog($"Keep-alive 시작 ({_pingInterval.TotalMilliseconds:F0}ms 주기)");
         Debug.WriteLine("[KeepAliveService] Keep-alive 루프 시작");
     }
 
@@ -159,17 +181,41 @@ public sealed class KeepAliveService : IDisposable
         Debug.WriteLine("[KeepAliveService] Keep-alive 루프 중지");
     }
 
+    /// <summary>최근 window 동안의 RTT 백분위 / 손실 통계 (최대 DisplayWindow)</summary>
+    public RttPercentiles GetRttPercentiles(TimeSpan window)
+    {
+        lock (_rttLock)
+        {
+            return _rttHistogram.GetPercentiles(window, Stopwatch.GetTimestamp());
+        }
+    }
+
+    /// <summary>
+    /// DisplayWindow(최근 60초) RTT 분포를 DisplayBinEdgesMs 구간별 개수로 binCounts에 씁니다.
+    /// binCounts 길이는 DisplayBinEdgesMs.Length + 1.
+    /// </summary>
+    public RttPercentiles CopyRttHistogram(Span<int> binCounts)
+    {
+        lock (_rttLock)
+        {
+            return _rttHistogram.CopyBins(DisplayWindow, Stopwatch.GetTimestamp(), DisplayBinEdgesMs, binCounts);
+        }
+    }
+
     // ==================== Keep-alive 루프 ====================
 
     private async Task KeepAliveLoopAsync(CancellationToken ct)
     {
-        using var timer = new PeriodicTimer(TimeSpan.FromMilliseconds(PingIntervalMs));
+        using var timer = new PeriodicTimer(_pingInterval);
 
         try
         {
             while (await timer.WaitForNextTickAsync(ct))
             {
                 await SendPingAndWaitPongAsync(ct);
+
+                if (timer.Period != _pingInterval)
+                    timer.Period = _pingInterval;
             }
         }
         catch (OperationCanceledException)
@@ -186,6 +232,7 @@ public sealed class KeepAliveService : IDisposable
     private async Task SendPingAndWaitPongAsync(CancellationToken ct)
     {
         var timestamp = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
+        long sentAt = 0;
 
         // PING 전송
         try
@@ -200,6 +247,7 @@ public sealed class KeepAliveService : IDisposable
                 (byte)VendorCdcCommand.Ping,
                 pingJson,
                 ct);
+            sentAt = Stopwatch.GetTimestamp();
         }
         catch (Exception ex) when (ex is not OperationCanceledException)
         {
@@ -216,26 +264,21 @@ public sealed class KeepAliveService : IDisposable
         {
             while (await _protocol.FrameReader.WaitToReadAsync(timeoutCts.Token))
             {
-                while (_protocol.FrameReader.TryRead(out var frame))
+                while (_protocol.FrameReader.TryRead(out var received))
                 {
+                    using var frame = received;
+
                     if (frame.Command != (byte)VendorCdcCommand.Pong)
                         continue;
 
-                    // PONG 수신 → RTT 계산
-                    var now = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
-                    var echoTimestamp = ExtractTimestamp(frame.Payload);
-
-                    if (echoTimestamp.HasValue)
-                    {
-                        var rtt = now - echoTimestamp.Value;
-                        OnPongReceived(rtt);
-                    }
-                    else
-                    {
-                        // timestamp 파싱 실패해도 PONG 수신은 성공으로 처리
-                        var rtt = now - timestamp;
-                        OnPongReceived(rtt);
-                    }
+                    // 이전에 타임아웃 처리된 PING의 늦은 PONG은 건너뜀
+                    // (timestamp 파싱 실패 시에는 이번 PING의 응답으로 간주)
+                    var echoTimestamp = ExtractTimestamp(frame.Payload.Span);
+                    if (echoTimestamp.HasValue && echoTimestamp.Value != timestamp)
+                        continue;
+
+                    // PONG 수신 → RTT 계산 (Unix ms 대신 Stopwatch로 ms 미만까지 측정)
+                    OnPongReceived(Stopwatch.GetElapsedTime(sentAt).TotalMilliseconds);
 
                     return; // PONG 수신 완료
                 }
@@ -251,44 +294,46 @@ public sealed class KeepAliveService : IDisposable
 
     // ==================== PONG 결과 처리 ====================
 
-    private void OnPongReceived(long rttMs)
+    private void OnPongReceived(double rttMs)
     {
         _consecutiveFailures = 0;
         LastRttMs = rttMs;
 
-        // RTT 이동 평균 업데이트
+        RttPercentiles recent;
         lock (_rttLock)
         {
-            _rttWindow.Enqueue(rttMs);
-            while (_rttWindow.Count > RttWindowSize)
-                _rttWindow.Dequeue();
+            long now = Stopwatch.GetTimestamp();
+            _rttHistogram.Record(rttMs, now);
+            recent = _rttHistogram.GetPercentiles(QualityWindow, now);
         }
 
-        var avgRtt = AverageRttMs;
-        var newQuality = ClassifyQuality(avgRtt);
-
-        RttUpdated?.Invoke(this, new RttUpdatedEventArgs(rttMs, avgRtt));
-
-        if (newQuality != Quality)
-        {
-            Quality = newQuality;
-            QualityChanged?.Invoke(this, newQuality);
-        }
+        RttUpdated?.Invoke(this, new RttUpdatedEventArgs(rttMs, recent));
+        UpdateQuality(ClassifyQuality(recent));
 
-        Debug.WriteLine($"[KeepAliveService] PONG 수신: RTT={rttMs}ms, 평균={avgRtt:F1}ms, 품질={Quality}");
+        Debug.WriteLine($"[KeepAliveService] PONG 수신: RTT={rttMs:F2}ms, p50={recent.P50Ms:F2}ms, p99={recent.P99Ms:F2}ms, 품질={Quality}");
     }
 
     private void OnPongFailed()
     {
         _consecutiveFailures++;
 
+        RttPercentiles recent;
+        lock (_rttLock)
+        {
+            long now = Stopwatch.GetTimestamp();
+            _rttHistogram.RecordLoss(now);
+            recent = _rttHistogram.GetPercentiles(QualityWindow, now);
+        }
+
         if (_consecutiveFailures == 1)
+        {
             RaiseStatusLog("PONG 미수신 (1회)");
+            UpdateQuality(ClassifyQuality(recent));
+        }
         else if (_consecutiveFailures == 2)
         {
             RaiseStatusLog("PONG 미수신 (2회) - 연결 불안정");
-            Quality = ConnectionQuality.Unstable;
-            QualityChanged?.Invoke(this, ConnectionQuality.Unstable);
+            UpdateQuality(ConnectionQuality.Unstable);
         }
 
         Debug.WriteLine($"[KeepAliveService] PONG 실패: 연속 {_consecutiveFailures}회");
@@ -334,7 +379,9 @@ public sealed class KeepAliveService : IDisposable
         while (!ct.IsCancellationRequested)
         {
             attempt++;
-            var delaySec = Math.Min((int)Math.Pow(2, attempt - 1), MaxReconnectDelaySec);
+            var delaySec = attempt == 1 && _handshakeService.UseResume && _handshakeService.HasSession
+                ? 0
+                : Math.Min((int)Math.Pow(2, attempt - 1), MaxReconnectDelaySec);
 
             RaiseStatusLog($"재연결 대기 중... ({delaySec}초 후 시도 #{attempt})");
             ReconnectAttempt?.Invoke(this, new ReconnectAttemptEventArgs(attempt, delaySec));
@@ -351,8 +398,8 @@ public sealed class KeepAliveService : IDisposable
             RaiseStatusLog($"재연결 시도 #{attempt}...");
 
             // 1. CDC 포트 재연결
-            _connectionService.Disconnect();
-            if (!_connectionService.TryScanAndConnect())
+            _transport.Disconnect();
+            if (!_transport.TryConnect())
             {
                 RaiseStatusLog($"재연결 #{attempt} 실패: 장치 미발견");
                 continue;
@@ -405,18 +452,27 @@ public sealed class KeepAliveService : IDisposable
 
     // ==================== 유틸리티 ====================
 
-    private static long? ExtractTimestamp(byte[] payload)
+    private static long? ExtractTimestamp(ReadOnlySpan<byte> payload)
     {
         if (payload.Length == 0) return null;
 
+        // JsonDocument 없이 토큰만 훑어 샘플당 할당을 피함
         try
         {
-            var json = Encoding.UTF8.GetString(payload);
-            using var doc = JsonDocument.Parse(json);
-            if (doc.RootElement.TryGetProperty("timestamp", out var ts))
-                return ts.GetInt64();
+            var reader = new Utf8JsonReader(payload);
+            while (reader.Read())
+            {
+                if (reader.TokenType == JsonTokenType.PropertyName &&
+                    reader.CurrentDepth == 1 &&
+                    reader.ValueTextEquals("timestamp"u8) &&
+                    reader.Read() &&
+                    reader.TryGetInt64(out var ts))
+                {
+                    return ts;
+                }
+            }
         }
-        catch
+        catch (JsonException)
         {
             // 파싱 실패 시 null 반환
         }
@@ -424,19 +480,36 @@ public sealed class KeepAliveService : IDisposable
         return null;
     }
 
-    private static ConnectionQuality ClassifyQuality(double avgRttMs)
+    /// <summary>
+    /// 꼬리 지연(p99)과 손실률로 연결 품질을 판정합니다.
+    /// 손실만 있고 RTT 샘플이 없으면 불안정, 둘 다 없으면 Unknown.
+    /// </summary>
+    public static ConnectionQuality ClassifyQuality(in RttPercentiles stats)
     {
-        if (avgRttMs < 0) return ConnectionQuality.Unknown;
-        if (avgRttMs <= QualityGoodThresholdMs) return ConnectionQuality.Good;
-        if (avgRttMs <= QualityFairThresholdMs) return ConnectionQuality.Fair;
+        if (stats.Count == 0)
+            return stats.LostCount > 0 ? ConnectionQuality.Unstable : ConnectionQuality.Unknown;
+
+        var lossRate = stats.LossRate;
+        if (stats.P99Ms <= QualityGoodThresholdMs && lossRate <= QualityGoodMaxLossRate)
+            return ConnectionQuality.Good;
+        if (stats.P99Ms <= QualityFairThresholdMs && lossRate <= QualityFairMaxLossRate)
+            return ConnectionQuality.Fair;
         return ConnectionQuality.Unstable;
     }
 
+    private void UpdateQuality(ConnectionQuality quality)
+    {
+        if (quality == Quality) return;
+
+        Quality = quality;
+        QualityChanged?.Invoke(this, quality);
+    }
+
     private void ClearRttWindow()
     {
         lock (_rttLock)
         {
-            _rttWindow.Clear();
+            _rttHistogram.Clear();
         }
 
         LastRttMs = -1;
@@ -467,13 +540,13 @@ public enum ConnectionQuality
     /// <summary>측정값 없음</summary>
     Unknown,
 
-    /// <summary>양호 (평균 RTT ≤ 20ms)</summary>
+    /// <summary>양호 (p99 RTT ≤ 20ms, 손실 ≤ 1%)</summary>
     Good,
 
-    /// <summary>보통 (평균 RTT ≤ 100ms)</summary>
+    /// <summary>보통 (p99 RTT ≤ 100ms, 손실 ≤ 5%)</summary>
     Fair,
 
-    /// <summary>불안정 (평균 RTT > 100ms 또는 PONG 실패 다수)</summary>
+    /// <summary>불안정 (p99 RTT > 100ms, 손실 > 5% 또는 PONG 연속 실패)</summary>
     Unstable,
 
     /// <summary>연결 끊김</summary>
@@ -486,13 +559,13 @@ public sealed class RttUpdatedEventArgs : EventArgs
     /// <summary>이번 RTT (ms)</summary>
     public double CurrentRttMs { get; }
 
-    /// <summary>이동 평균 RTT (ms)</summary>
-    public double AverageRttMs { get; }
+    /// <summary>품질 판정 윈도우(최근 10초)의 RTT 백분위 / 손실 통계</summary>
+    public RttPercentiles Recent { get; }
 
-    public RttUpdatedEventArgs(double currentRttMs, double averageRttMs)
+    public RttUpdatedEventArgs(double currentRttMs, RttPercentiles recent)
     {
         CurrentRttMs = currentRttMs;
-        AverageRttMs = averageRttMs;
+        Recent = recent;
     }
 }
 
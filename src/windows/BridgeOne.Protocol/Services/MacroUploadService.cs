@@ -0,0 +1,275 @@
+using System.Buffers.Binary;
+using System.Diagnostics;
+using System.Text.Json;
+using BridgeOne.Protocol;
+
+namespace BridgeOne.Services;
+
+/// <summary>
+/// 동글 매크로 업로드 서비스.
+/// MACRO_UPLOAD (0x30)로 매크로를 동글 플래시 슬롯에 저장하고 MACRO_ACK (0x31)를 기다립니다.
+///
+/// - 페이로드 (바이너리): [macro_id 1B] [step_count 1B] [스텝 8B × step_count] (펌웨어 macro_engine.h)
+/// - 동글은 저장된 내용과 같으면 플래시를 다시 쓰지 않으므로 연결할 때마다 업로드해도 됩니다.
+/// - 응답은 FrameReceived 이벤트로 받습니다 (FrameReader 채널은 KeepAliveService 전용).
+/// - 업로드는 한 번에 하나씩 순서대로 보냅니다 (ACK에 요청 식별자가 매크로 ID뿐).
+/// </summary>
+public sealed class MacroUploadService : IDisposable
+{
+    // ==================== 상수 ====================
+
+    /// <summary>저장 가능한 최대 매크로 수 (펌웨어 MACRO_MAX_COUNT)</summary>
+    public const int MaxMacroCount = 32;
+
+    /// <summary>매크로 하나의 최대 스텝 수 (펌웨어 MACRO_MAX_STEPS)</summary>
+    public const int MaxSteps = 55;
+
+    /// <summary>ACK 타임아웃: 4KB 섹터 지우기 + 쓰기를 포함하므로 여유 있게 잡음</summary>
+    private static readonly TimeSpan AckTimeout = TimeSpan.FromSeconds(2);
+
+    // ==================== 의존성 / 상태 ====================
+
+    private readonly VendorCdcProtocol _protocol;
+    private readonly SemaphoreSlim _uploadLock = new(1, 1);
+    private TaskCompletionSource<MacroAck>? _pendingAck;
+    private bool _disposed;
+
+    // ==================== 생성자 ====================
+
+    public MacroUploadService(VendorCdcProtocol protocol)
+    {
+        _protocol = protocol;
+        _protocol.FrameReceived += OnFrameReceived;
+    }
+
+    // ==================== 공개 API ====================
+
+    /// <summary>
+    /// 매크로 하나를 업로드하고 ACK를 기다립니다. 스텝이 없으면 슬롯을 지웁니다.
+    /// </summary>
+    /// <returns>동글 ACK (타임아웃이면 <see cref="MacroAck.Timeout"/>)</returns>
+    public async Task<MacroAck> UploadAsync(byte macroId, IReadOnlyList<MacroStep> steps,
+        CancellationToken cancellationToken = default)
+    {
+        var payload = BuildPayload(macroId, steps);
+
+        await _uploadLock.WaitAsync(cancellationToken);
+        try
+        {
+            var tcs = new TaskCompletionSource<MacroAck>(TaskCreationOptions.RunContinuationsAsynchronously);
+            Volatile.Write(ref _pendingAck, tcs);
+
+            await _protocol.SendFrameAsync((byte)VendorCdcCommand.MacroUpload, payload, cancellationToken);
+
+            var completed = await Task.WhenAny(tcs.Task, Task.Delay(AckTimeout, cancellationToken));
+            cancellationToken.ThrowIfCancellationRequested();
+            return completed == tcs.Task ? tcs.Task.Result : MacroAck.Timeout(macroId);
+        }
+        finally
+        {
+            Volatile.Write(ref _pendingAck, null);
+            _uploadLock.Release();
+        }
+    }
+
+    /// <summary>
+    /// 단축키 탭 매크로(<see cref="ShortcutMacros.Defaults"/>)를 모두 업로드합니다.
+    /// </summary>
+    /// <returns>매크로별 ACK (정의 순서)</returns>
+    public async Task<IReadOnlyList<MacroAck>> UploadShortcutsAsync(CancellationToken cancellationToken = default)
+    {
+        var results = new List<MacroAck>(ShortcutMacros.Defaults.Count);
+        foreach (var macro in ShortcutMacros.Defaults)
+        {
+            var ack = await UploadAsync(macro.Id, macro.Steps, cancellationToken);
+            results.Add(ack);
+            if (!ack.Success)
+                Debug.WriteLine($"[MacroUploadService] 매크로 {macro.Id} ({macro.Label}) 업로드 실패: {ack.Reason}");
+        }
+        return results;
+    }
+
+    // ==================== 인코딩 ====================
+
+    /// <summary>
+    /// MACRO_UPLOAD 페이로드를 만듭니다.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">ID 또는 스텝 수 범위 초과</exception>
+    public static byte[] BuildPayload(byte macroId, IReadOnlyList<MacroStep> steps)
+    {
+        if (macroId >= MaxMacroCount)
+            throw new ArgumentOutOfRangeException(nameof(macroId), $"매크로 ID 범위 초과: {macroId}");
+        if (steps.Count > MaxSteps)
+            throw new ArgumentOutOfRangeException(nameof(steps), $"스텝 수 초과: {steps.Count} > {MaxSteps}");
+
+        var payload = new byte[2 + steps.Count * MacroStep.Size];
+        payload[0] = macroId;
+        payload[1] = (byte)steps.Count;
+        for (int i = 0; i < steps.Count; i++)
+            steps[i].WriteTo(payload.AsSpan(2 + i * MacroStep.Size, MacroStep.Size));
+        return payload;
+    }
+
+    // ==================== 수신 ====================
+
+    /// <summary>프레임 수신 (백그라운드 스레드, 페이로드는 핸들러 안에서만 유효)</summary>
+    private void OnFrameReceived(object? sender, VendorCdcFrame frame)
+    {
+        if (frame.Command != (byte)VendorCdcCommand.MacroAck)
+            return;
+
+        var pending = Volatile.Read(ref _pendingAck);
+        if (pending == null)
+            return;
+
+        if (!TryParseAck(frame.Payload.Span, out var ack))
+        {
+            Debug.WriteLine($"[MacroUploadService] MACRO_ACK 파싱 실패 ({frame.Payload.Length}B)");
+            return;
+        }
+        pending.TrySetResult(ack);
+    }
+
+    /// <summary>
+    /// MACRO_ACK 페이로드(JSON)를 파싱합니다.
+    /// 형식: {"command":"MACRO_ACK","id":3,"steps":4,"result":"ok"} (실패 시 "reason")
+    /// </summary>
+    public static bool TryParseAck(ReadOnlySpan<byte> payload, out MacroAck ack)
+    {
+        ack = default;
+        if (payload.Length == 0) return false;
+
+        try
+        {
+            var reader = new Utf8JsonReader(payload);
+            using var doc = JsonDocument.ParseValue(ref reader);
+            var root = doc.RootElement;
+
+            if (!root.TryGetProperty("id", out var idElement) ||
+                !root.TryGetProperty("result", out var resultElement))
+                return false;
+
+            ack = new MacroAck(
+                idElement.GetByte(),
+                resultElement.GetString() == "ok",
+                root.TryGetProperty("reason", out var reasonElement) ? reasonElement.GetString() : null);
+            return true;
+        }
+        catch (Exception ex) when (ex is JsonException or InvalidOperationException or FormatException)
+        {
+            return false;
+        }
+    }
+
+    // ==================== IDisposable ====================
+
+    public void Dispose()
+    {
+        if (_disposed) return;
+        _disposed = true;
+
+        _protocol.FrameReceived -= OnFrameReceived;
+        _uploadLock.Dispose();
+    }
+}
+
+// ==================== 매크로 데이터 ====================
+
+/// <summary>매크로 스텝 종류 (펌웨어 macro_step_type_t)</summary>
+public enum MacroStepType : byte
+{
+    /// <summary>Arg0=modifier, Arg1=keycode1, Arg2=keycode2</summary>
+    Keyboard = 0x01,
+
+    /// <summary>Arg0=buttons, Arg1=x (int8), Arg2=y (int8)</summary>
+    Mouse = 0x02,
+
+    /// <summary>Arg0=buttons, Arg1=wheel (int8)</summary>
+    Wheel = 0x03,
+}
+
+/// <summary>
+/// 매크로 스텝 (8바이트, 펌웨어 macro_step_t).
+/// </summary>
+/// <param name="DelayUs">이 스텝 실행 후 다음 스텝까지의 지연 (µs)</param>
+public readonly record struct MacroStep(MacroStepType Type, byte Arg0, byte Arg1, byte Arg2, uint DelayUs)
+{
+    /// <summary>직렬화 크기 (bytes)</summary>
+    public const int Size = 8;
+
+    /// <summary>키보드 상태 스텝</summary>
+    public static MacroStep Keyboard(byte modifier, byte keycode, uint delayUs)
+        => new(MacroStepType.Keyboard, modifier, keycode, 0, delayUs);
+
+    /// <summary>[type][arg0][arg1][arg2][delay_us LE32]</summary>
+    public void WriteTo(Span<byte> destination)
+    {
+        destination[0] = (byte)Type;
+        destination[1] = Arg0;
+        destination[2] = Arg1;
+        destination[3] = Arg2;
+        BinaryPrimitives.WriteUInt32LittleEndian(destination[4..], DelayUs);
+    }
+}
+
+/// <summary>
+/// MACRO_ACK 응답.
+/// </summary>
+/// <param name="Reason">실패 사유 (펌웨어 esp_err 이름, 타임아웃이면 "timeout")</param>
+public readonly record struct MacroAck(byte Id, bool Success, string? Reason)
+{
+    /// <summary>ACK를 받지 못함</summary>
+    public static MacroAck Timeout(byte id) => new(id, false, "timeout");
+}
+
+/// <summary>정의된 매크로 하나</summary>
+public sealed record MacroDefinition(byte Id, string Label, IReadOnlyList<MacroStep> Steps);
+
+/// <summary>
+/// Android 단축키 버튼의 탭 매크로.
+/// ID는 Android ShortcutDef.macroId와 일치해야 합니다 (ui/components/ShortcutDef.kt).
+/// Alt+Tab처럼 누르는 동안 유지하는 단축키는 손가락 시간에 따르므로 매크로가 없습니다.
+/// </summary>
+public static class ShortcutMacros
+{
+    // HID 수정자 비트 / 키 코드 (HID Usage Tables, Keyboard page)
+    private const byte LeftCtrl = 0x01;
+    private const byte LeftShift = 0x02;
+    private const byte LeftGui = 0x08;
+    private const byte KeyC = 0x06;
+    private const byte KeyD = 0x07;
+    private const byte KeyS = 0x16;
+    private const byte KeyV = 0x19;
+    private const byte KeyX = 0x1B;
+    private const byte KeyZ = 0x1D;
+
+    /// <summary>수정자만 누른 뒤 주 키를 누르기까지 (µs)</summary>
+    public const uint ModifierLeadUs = 8_000;
+
+    /// <summary>주 키를 누르고 있는 시간 (µs)</summary>
+    public const uint KeyHoldUs = 20_000;
+
+    /// <summary>
+    /// 탭: Modifier↓ → Key↓ → Key↑ → Modifier↑.
+    /// 앱이 수정자를 먼저 인식하도록 단계마다 간격을 두며, 간격은 동글이 보장합니다.
+    /// </summary>
+    public static IReadOnlyList<MacroStep> Tap(byte modifiers, byte key) =>
+    [
+        MacroStep.Keyboard(modifiers, 0, ModifierLeadUs),
+        MacroStep.Keyboard(modifiers, key, KeyHoldUs),
+        MacroStep.Keyboard(modifiers, 0, ModifierLeadUs),
+        MacroStep.Keyboard(0, 0, 0),
+    ];
+
+    /// <summary>기본 단축키 매크로 (ID 0~6)</summary>
+    public static readonly IReadOnlyList<MacroDefinition> Defaults =
+    [
+        new(0, "Ctrl+C", Tap(LeftCtrl, KeyC)),
+        new(1, "Ctrl+V", Tap(LeftCtrl, KeyV)),
+        new(2, "Ctrl+S", Tap(LeftCtrl, KeyS)),
+        new(3, "Ctrl+Z", Tap(LeftCtrl, KeyZ)),
+        new(4, "Ctrl+Shift+Z", Tap(LeftCtrl | LeftShift, KeyZ)),
+        new(5, "Ctrl+X", Tap(LeftCtrl, KeyX)),
+        new(6, "Win+D", Tap(LeftGui, KeyD)),
+    ];
+}
@@ -0,0 +1,246 @@
+using System.Diagnostics;
+using System.Numerics;
+
+namespace BridgeOne.Services;
+
+/// <summary>
+/// 고정 메모리 로그 버킷 RTT 히스토그램 (시간 슬롯 링 버퍼 기반 슬라이딩 윈도우).
+///
+/// - 값은 µs 단위 정수로 기록. 16µs 미만은 정확히, 그 이상은 2배 구간(octave)마다
+///   8개 선형 버킷으로 나눠 상대 오차 ≤ 12.5% (HdrHistogram과 같은 log-linear 방식)
+/// - slotDuration 단위 슬롯 slotCount개를 링으로 유지하고, 조회 시 최근 N개 슬롯을 합산
+/// - Record / RecordLoss / GetPercentiles는 할당 없음 (생성 시 모든 배열 확보)
+///
+/// 스레드 안전하지 않으므로 호출 측(KeepAliveService)에서 잠금합니다.
+/// </summary>
+public sealed class RttHistogram
+{
+    /// <summary>octave당 선형 버킷 수 (2^SubBucketBits)</summary>
+    private const int SubBucketBits = 3;
+    private const int SubBucketCount = 1 << SubBucketBits;
+
+    /// <summary>기록 가능한 최대값 (µs, 약 33초). 초과 값은 마지막 버킷에 기록.</summary>
+    public const long MaxValueUs = (1L << 25) - 1;
+
+    /// <summary>버킷 개수 (0 ~ MaxValueUs 범위)</summary>
+    public static readonly int BucketCount = BucketIndex(MaxValueUs) + 1;
+
+    private readonly long _slotTicks;
+    private readonly int _slotCount;
+
+    // 슬롯 i의 데이터: _counts[i * BucketCount ..], 해당 슬롯이 담고 있는 절대 슬롯 번호 _slotIds[i]
+    private readonly int[] _counts;
+    private readonly long[] _slotIds;
+    private readonly int[] _samples;
+    private readonly int[] _losses;
+    private readonly long[] _maxUs;
+
+    // 조회용 합산 버퍼 (GetPercentiles 할당 방지)
+    private readonly int[] _merged;
+
+    /// <param name="slotDuration">슬롯 하나가 담당하는 시간</param>
+    /// <param name="slotCount">유지할 슬롯 수 (최대 윈도우 = slotDuration × slotCount)</param>
+    public RttHistogram(TimeSpan slotDuration, int slotCount)
+    {
+        if (slotDuration <= TimeSpan.Zero)
+            throw new ArgumentOutOfRangeException(nameof(slotDuration));
+        if (slotCount < 1)
+            throw new ArgumentOutOfRangeException(nameof(slotCount));
+
+        _slotTicks = (long)(slotDuration.TotalSeconds * Stopwatch.Frequency);
+        _slotCount = slotCount;
+        _counts = new int[slotCount * BucketCount];
+        _slotIds = new long[slotCount];
+        _samples = new int[slotCount];
+        _losses = new int[slotCount];
+        _maxUs = new long[slotCount];
+        _merged = new int[BucketCount];
+
+        Clear();
+    }
+
+    /// <summary>유지되는 최대 윈도우 길이</summary>
+    public TimeSpan MaxWindow => TimeSpan.FromSeconds((double)_slotTicks * _slotCount / Stopwatch.Frequency);
+
+    // ==================== 버킷 계산 ====================
+
+    /// <summary>µs 값의 버킷 인덱스. 16 미만은 값 그대로, 이후 octave × 8 + 상위 3비트.</summary>
+    public static int BucketIndex(long valueUs)
+    {
+        if (valueUs < 2 * SubBucketCount)
+            return (int)Math.Max(valueUs, 0);
+        if (valueUs > MaxValueUs)
+            valueUs = MaxValueUs;
+
+        int msb = 63 - BitOperations.LeadingZeroCount((ulong)valueUs);
+        int shift = msb - SubBucketBits;
+        int sub = (int)(valueUs >> shift) - SubBucketCount;
+        return (shift + 1) * SubBucketCount + sub;
+    }
+
+    /// <summary>버킷에 속하는 가장 큰 µs 값 (백분위 보고값)</summary>
+    public static long BucketHighestUs(int index)
+    {
+        if (index < 2 * SubBucketCount)
+            return index;
+
+        int shift = index / SubBucketCount - 1;
+        long lower = (long)(SubBucketCount + index % SubBucketCount) << shift;
+        return lower + (1L << shift) - 1;
+    }
+
+    // ==================== 기록 ====================
+
+    /// <summary>RTT 샘플 1개를 기록합니다.</summary>
+    /// <param name="rttMs">RTT (ms)</param>
+    /// <param name="timestamp">Stopwatch.GetTimestamp() 값</param>
+    public void Record(double rttMs, long timestamp)
+    {
+        long us = rttMs <= 0 ? 0 : (long)Math.Round(rttMs * 1000.0);
+        if (us > MaxValueUs) us = MaxValueUs;
+
+        int slot = SlotFor(timestamp);
+        _counts[slot * BucketCount + BucketIndex(us)]++;
+        _samples[slot]++;
+        if (us > _maxUs[slot])
+            _maxUs[slot] = us;
+    }
+
+    /// <summary>응답 없는 PING(손실) 1개를 기록합니다.</summary>
+    public void RecordLoss(long timestamp)
+    {
+        _losses[SlotFor(timestamp)]++;
+    }
+
+    /// <summary>모든 슬롯을 비웁니다.</summary>
+    public void Clear()
+    {
+        Array.Clear(_counts);
+        Array.Clear(_samples);
+        Array.Clear(_losses);
+        Array.Clear(_maxUs);
+        Array.Fill(_slotIds, long.MinValue);
+    }
+
+    /// <summary>timestamp가 속한 슬롯을 찾고, 링에서 만료된 이전 데이터면 비웁니다.</summary>
+    private int SlotFor(long timestamp)
+    {
+        long id = timestamp / _slotTicks;
+        int slot = (int)(id % _slotCount);
+        if (_slotIds[slot] != id)
+        {
+            Array.Clear(_counts, slot * BucketCount, BucketCount);
+            _samples[slot] = 0;
+            _losses[slot] = 0;
+            _maxUs[slot] = 0;
+            _slotIds[slot] = id;
+        }
+        return slot;
+    }
+
+    // ==================== 조회 ====================
+
+    /// <summary>
+    /// timestamp 기준 최근 window 동안의 백분위를 계산합니다.
+    /// window는 슬롯 단위로 올림되며 MaxWindow를 넘지 않습니다.
+    /// </summary>
+    public RttPercentiles GetPercentiles(TimeSpan window, long timestamp)
+    {
+        Merge(window, timestamp, out int count, out int losses, out long maxUs);
+        if (count == 0)
+            return new RttPercentiles(0, losses, -1, -1, -1, -1);
+
+        return new RttPercentiles(
+            count,
+            losses,
+            ValueAtPercentile(0.50, count, maxUs) / 1000.0,
+            ValueAtPercentile(0.90, count, maxUs) / 1000.0,
+            ValueAtPercentile(0.99, count, maxUs) / 1000.0,
+            maxUs / 1000.0);
+    }
+
+    /// <summary>
+    /// 최근 window의 샘플 수를 표시용 구간으로 합산해 destination에 씁니다.
+    /// destination[i]는 upperEdgesMs[i-1] ≤ RTT &lt; upperEdgesMs[i] 구간, 마지막 칸은 나머지 전부.
+    /// destination 길이는 upperEdgesMs.Length + 1이어야 합니다.
+    /// </summary>
+    public RttPercentiles CopyBins(TimeSpan window, long timestamp,
+        ReadOnlySpan<double> upperEdgesMs, Span<int> destination)
+    {
+        if (destination.Length != upperEdgesMs.Length + 1)
+            throw new ArgumentException("destination 길이는 구간 경계 수 + 1이어야 합니다.", nameof(destination));
+
+        var stats = GetPercentiles(window, timestamp);
+
+        destination.Clear();
+        int bin = 0;
+        for (int i = 0; i < BucketCount; i++)
+        {
+            if (_merged[i] == 0) continue;
+
+            double valueMs = BucketHighestUs(i) / 1000.0;
+            while (bin < upperEdgesMs.Length && valueMs >= upperEdgesMs[bin])
+                bin++;
+            destination[bin] += _merged[i];
+        }
+
+        return stats;
+    }
+
+    private void Merge(TimeSpan window, long timestamp, out int count, out int losses, out long maxUs)
+    {
+        long slots = (long)Math.Ceiling(window.TotalSeconds * Stopwatch.Frequency / _slotTicks);
+        slots = Math.Clamp(slots, 1, _slotCount);
+
+        Array.Clear(_merged);
+        count = 0;
+        losses = 0;
+        maxUs = 0;
+
+        long newest = timestamp / _slotTicks;
+        for (long id = newest - slots + 1; id <= newest; id++)
+        {
+            int slot = (int)(((id % _slotCount) + _slotCount) % _slotCount);
+            if (_slotIds[slot] != id) continue;
+
+            count += _samples[slot];
+            losses += _losses[slot];
+            if (_maxUs[slot] > maxUs) maxUs = _maxUs[slot];
+
+            var src = _counts.AsSpan(slot * BucketCount, BucketCount);
+            for (int i = 0; i < src.Length; i++)
+                _merged[i] += src[i];
+        }
+    }
+
+    private long ValueAtPercentile(double percentile, int count, long maxUs)
+    {
+        long rank = Math.Max(1, (long)Math.Ceiling(percentile * count));
+        long seen = 0;
+        for (int i = 0; i < BucketCount; i++)
+        {
+            seen += _merged[i];
+            if (seen >= rank)
+                return Math.Min(BucketHighestUs(i), maxUs);
+        }
+        return maxUs;
+    }
+}
+
+/// <summary>
+/// 슬라이딩 윈도우 RTT 통계. 샘플이 없으면 백분위 값은 -1.
+/// </summary>
+public readonly record struct RttPercentiles(
+    int Count,
+    int LostCount,
+    double P50Ms,
+    double P90Ms,
+    double P99Ms,
+    double MaxMs)
+{
+    /// <summary>측정값 없음</summary>
+    public static RttPercentiles Empty => new(0, 0, -1, -1, -1, -1);
+
+    /// <summary>PONG 미수신 비율 (0.0 ~ 1.0)</summary>
+    public double LossRate => Count + LostCount == 0 ? 0 : (double)LostCount / (Count + LostCount);
+}
@@ -0,0 +1,230 @@
+using System.Diagnostics;
+using System.Text.Json;
+using BridgeOne.Protocol;
+
+namespace BridgeOne.Services;
+
+/// <summary>
+/// 동글 태스크 프로파일러 ("top") 폴링 서비스.
+/// 주기적으로 TOP_QUERY를 보내고 TOP_REPORT를 파싱해 <see cref="SnapshotReceived"/>로 알립니다.
+///
+/// - 펌웨어는 직전 조회 이후 구간 값을 보내므로 폴링 주기가 곧 샘플 구간입니다 (기본 1초).
+/// - 응답은 FrameReceived 이벤트로 받습니다. FrameReader 채널은 KeepAliveService가 읽으므로
+///   여기서 읽으면 PONG을 가로채게 됩니다.
+/// - 보고서 형식: {"dt":us,"load":[c0,c1],"tasks":[[name,prio,affinity,cpu,hwm(,wake,lat_avg,lat_max)],...]}
+///   (cpu/load는 한 코어 기준 ‰, 펌웨어 task_profiler.h 참조)
+/// </summary>
+public sealed class TaskProfilerService : IDisposable
+{
+    // ==================== 상수 ====================
+
+    /// <summary>기본 조회 주기</summary>
+    public static readonly TimeSpan DefaultPollInterval = TimeSpan.FromSeconds(1);
+
+    // ==================== 의존성 ====================
+
+    private readonly VendorCdcProtocol _protocol;
+
+    // ==================== 상태 ====================
+
+    private CancellationTokenSource? _pollCts;
+    private bool _isRunning;
+    private bool _disposed;
+
+    // ==================== 이벤트 ====================
+
+    /// <summary>TOP_REPORT 수신 및 파싱 성공 시 발생 (백그라운드 스레드)</summary>
+    public event EventHandler<TaskProfileSnapshot>? SnapshotReceived;
+
+    // ==================== 공개 속성 ====================
+
+    /// <summary>폴링 동작 중인지 여부</summary>
+    public bool IsRunning => _isRunning;
+
+    /// <summary>마지막으로 받은 스냅샷 (없으면 null)</summary>
+    public TaskProfileSnapshot? LastSnapshot { get; private set; }
+
+    // ==================== 생성자 ====================
+
+    public TaskProfilerService(VendorCdcProtocol protocol)
+    {
+        _protocol = protocol;
+        _protocol.FrameReceived += OnFrameReceived;
+    }
+
+    // ==================== 공개 API ====================
+
+    /// <summary>
+    /// 폴링을 시작합니다. 첫 응답은 직전 조회(또는 부팅) 이후 평균이므로 두 번째부터가 1초 구간입니다.
+    /// </summary>
+    public void Start()
+    {
+        if (_isRunning) return;
+
+        _pollCts = new CancellationTokenSource();
+        _ = Task.Run(() => PollLoopAsync(_pollCts.Token));
+        _isRunning = true;
+
+        Debug.WriteLine("[TaskProfilerService] 폴링 시작");
+    }
+
+    /// <summary>
+    /// 폴링을 중지합니다.
+    /// </summary>
+    public void Stop()
+    {
+        if (!_isRunning) return;
+
+        _pollCts?.Cancel();
+        _pollCts?.Dispose();
+        _pollCts = null;
+        _isRunning = false;
+        LastSnapshot = null;
+
+        Debug.WriteLine("[TaskProfilerService] 폴링 중지");
+    }
+
+    // ==================== 폴링 루프 ====================
+
+    private async Task PollLoopAsync(CancellationToken ct)
+    {
+        using var timer = new PeriodicTimer(DefaultPollInterval);
+
+        try
+        {
+            while (await timer.WaitForNextTickAsync(ct))
+            {
+                try
+                {
+                    await _protocol.SendFrameAsync((byte)VendorCdcCommand.TopQuery, ct);
+                }
+                catch (Exception ex) when (ex is not OperationCanceledException)
+                {
+                    // 재연결 중에는 전송이 실패할 수 있음 → 다음 주기에 다시 시도
+                    Debug.WriteLine($"[TaskProfilerService] TOP_QUERY 전송 실패: {ex.Message}");
+                }
+            }
+        }
+        catch (OperationCanceledException)
+        {
+            // 정상 종료
+        }
+    }
+
+    /// <summary>프레임 수신 (백그라운드 스레드, 페이로드는 핸들러 안에서만 유효)</summary>
+    private void OnFrameReceived(object? sender, VendorCdcFrame frame)
+    {
+        if (!_isRunning || frame.Command != (byte)VendorCdcCommand.TopReport)
+            return;
+
+        if (!TryParseReport(frame.Payload.Span, out var snapshot))
+        {
+            Debug.WriteLine($"[TaskProfilerService] TOP_REPORT 파싱 실패 ({frame.Payload.Length}B)");
+            return;
+        }
+
+        LastSnapshot = snapshot;
+        SnapshotReceived?.Invoke(this, snapshot);
+    }
+
+    // ==================== 파싱 ====================
+
+    /// <summary>
+    /// TOP_REPORT 페이로드(JSON)를 스냅샷으로 변환합니다.
+    /// 프로브가 없는 태스크(배열 원소 5개)는 깨어남/지연이 null입니다.
+    /// </summary>
+    public static bool TryParseReport(ReadOnlySpan<byte> payload, out TaskProfileSnapshot snapshot)
+    {
+        snapshot = TaskProfileSnapshot.Empty;
+        if (payload.Length == 0) return false;
+
+        try
+        {
+            var reader = new Utf8JsonReader(payload);
+            using var doc = JsonDocument.ParseValue(ref reader);
+            var root = doc.RootElement;
+
+            if (!root.TryGetProperty("dt", out var dtElement) ||
+                !root.TryGetProperty("load", out var loadElement) ||
+                !root.TryGetProperty("tasks", out var tasksElement))
+                return false;
+
+            var load = new int[loadElement.GetArrayLength()];
+            int core = 0;
+            foreach (var item in loadElement.EnumerateArray())
+                load[core++] = item.GetInt32();
+
+            var tasks = new List<TaskProfileEntry>(tasksElement.GetArrayLength());
+            foreach (var row in tasksElement.EnumerateArray())
+            {
+                int fields = row.GetArrayLength();
+                if (fields < 5) return false;
+
+                bool probed = fields >= 8;
+                tasks.Add(new TaskProfileEntry(
+                    Name: row[0].GetString() ?? string.Empty,
+                    Priority: row[1].GetInt32(),
+                    Affinity: row[2].GetInt32(),
+                    CpuPermille: row[3].GetInt32(),
+                    StackFreeBytes: row[4].GetInt32(),
+                    Wakes: probed ? row[5].GetInt32() : null,
+                    LatencyAvgUs: probed ? row[6].GetInt32() : null,
+                    LatencyMaxUs: probed ? row[7].GetInt32() : null));
+            }
+
+            snapshot = new TaskProfileSnapshot(dtElement.GetInt64(), load, tasks);
+            return true;
+        }
+        catch (Exception ex) when (ex is JsonException or InvalidOperationException or FormatException)
+        {
+            return false;
+        }
+    }
+
+    // ==================== IDisposable ====================
+
+    public void Dispose()
+    {
+        if (_disposed) return;
+        _disposed = true;
+
+        Stop();
+        _protocol.FrameReceived -= OnFrameReceived;
+    }
+}
+
+// ==================== 스냅샷 ====================
+
+/// <summary>
+/// 태스크 프로파일 한 구간.
+/// </summary>
+/// <param name="IntervalUs">구간 길이 (us, 동글 런타임 통계 클럭 기준)</param>
+/// <param name="CoreLoadPermille">코어별 부하 (‰, 1000 - IDLE 태스크 사용률)</param>
+/// <param name="Tasks">프로브 태스크가 먼저, 나머지는 CPU 사용률 순</param>
+public sealed record TaskProfileSnapshot(
+    long IntervalUs,
+    IReadOnlyList<int> CoreLoadPermille,
+    IReadOnlyList<TaskProfileEntry> Tasks)
+{
+    /// <summary>빈 스냅샷</summary>
+    public static readonly TaskProfileSnapshot Empty = new(0, [], []);
+}
+
+/// <summary>
+/// 태스크 1개의 구간 통계.
+/// </summary>
+/// <param name="Affinity">고정 코어 (미고정 -1). 구간 동안 실행된 코어가 아님</param>
+/// <param name="CpuPermille">한 코어 기준 CPU 사용률 (‰)</param>
+/// <param name="StackFreeBytes">남은 최소 스택 (bytes)</param>
+/// <param name="Wakes">구간 동안 블로킹 대기에서 깨어난 횟수 (프로브 태스크만)</param>
+/// <param name="LatencyAvgUs">작업 전달 → 실행까지 평균 지연 (프로브 태스크만)</param>
+/// <param name="LatencyMaxUs">작업 전달 → 실행까지 최대 지연 (프로브 태스크만)</param>
+public sealed record TaskProfileEntry(
+    string Name,
+    int Priority,
+    int Affinity,
+    int CpuPermille,
+    int StackFreeBytes,
+    int? Wakes,
+    int? LatencyAvgUs,
+    int? LatencyMaxUs);
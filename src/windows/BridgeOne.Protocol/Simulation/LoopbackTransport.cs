@@ -0,0 +1,187 @@
+using System.Diagnostics;
+using System.IO.Pipelines;
+
+namespace BridgeOne.Protocol.Simulation;
+
+/// <summary>
+/// <see cref="SimulatedDevice"/>에 연결하는 인프로세스 전송 계층.
+/// 연결마다 Pipe 두 개(호스트→동글, 동글→호스트)를 만들고 시뮬레이터 세션을 실행합니다.
+///
+/// - <see cref="Disconnect"/>: 포트 닫기 (동글은 DTR 해제로 보고 IDLE 리셋)
+/// - <see cref="Unplug"/>: USB 제거. 호스트 측 포트는 열린 채로 남아 있고 응답만 끊기므로
+///   Keep-alive가 끊김을 감지하는 경로를 그대로 재현합니다. <see cref="Replug"/> 전까지 연결 실패.
+/// </summary>
+public sealed class LoopbackTransport : IVendorCdcTransport, IDisposable
+{
+    private readonly object _lock = new();
+
+    private Stream? _hostStream;
+    private CancellationTokenSource? _sessionCts;
+    private Task? _sessionTask;
+    private bool _disposed;
+
+    /// <summary>연결 대상 시뮬레이터</summary>
+    public SimulatedDevice Device { get; }
+
+    /// <summary>USB가 꽂혀 있는지 여부 (false면 TryConnect 실패)</summary>
+    public bool IsPresent { get; private set; } = true;
+
+    public bool IsConnected => _hostStream != null;
+
+    public Stream? Stream => _hostStream;
+
+    public event EventHandler? ConnectedChanged;
+
+    public LoopbackTransport(SimulatedDevice? device = null)
+    {
+        Device = device ?? new SimulatedDevice();
+    }
+
+    public bool TryConnect()
+    {
+        lock (_lock)
+        {
+            if (_hostStream != null)
+                return true;
+            if (!IsPresent || _disposed)
+                return false;
+
+            var toDevice = new Pipe();
+            var toHost = new Pipe();
+            _hostStream = new DuplexStream(toHost.Reader.AsStream(), toDevice.Writer.AsStream());
+            _sessionCts = new CancellationTokenSource();
+            _sessionTask = Task.Run(() => Device.RunAsync(toDevice.Reader, toHost.Writer, _sessionCts.Token));
+        }
+
+        Debug.WriteLine("[LoopbackTransport] 연결됨");
+        ConnectedChanged?.Invoke(this, EventArgs.Empty);
+        return true;
+    }
+
+    public void Disconnect()
+    {
+        Stream? stream;
+        lock (_lock)
+        {
+            stream = _hostStream;
+            if (stream == null)
+                return;
+            _hostStream = null;
+        }
+
+        // 호스트 쪽 Pipe 완료 → 동글이 EOF(DTR 해제)를 보고 세션 종료
+        ConnectedChanged?.Invoke(this, EventArgs.Empty);
+        stream.Dispose();
+        EndSession(cancel: false);
+
+        Debug.WriteLine("[LoopbackTransport] 연결 해제");
+    }
+
+    /// <summary>
+    /// USB 제거를 흉내냅니다. 동글 세션을 중단하지만 호스트 포트 상태는 그대로 둡니다.
+    /// </summary>
+    public void Unplug()
+    {
+        IsPresent = false;
+        EndSession(cancel: true);
+        Debug.WriteLine("[LoopbackTransport] USB 제거");
+    }
+
+    /// <summary>USB를 다시 꽂습니다 (다음 TryConnect부터 성공).</summary>
+    public void Replug()
+    {
+        IsPresent = true;
+        Debug.WriteLine("[LoopbackTransport] USB 재연결");
+    }
+
+    private void EndSession(bool cancel)
+    {
+        CancellationTokenSource? cts;
+        Task? session;
+        lock (_lock)
+        {
+            cts = _sessionCts;
+            session = _sessionTask;
+            _sessionCts = null;
+            _sessionTask = null;
+        }
+
+        if (cancel)
+            cts?.Cancel();
+
+        // 세션 종료를 짧게 기다린 뒤 정리 (동글 상태 리셋이 반영되도록)
+        session?.Wait(TimeSpan.FromSeconds(1));
+        cts?.Dispose();
+    }
+
+    public void Dispose()
+    {
+        if (_disposed) return;
+        _disposed = true;
+
+        Disconnect();
+        EndSession(cancel: true);
+    }
+
+    /// <summary>
+    /// 읽기/쓰기 방향이 다른 두 스트림을 하나의 양방향 스트림으로 묶습니다 (SerialPort.BaseStream 대용).
+    /// </summary>
+    private sealed class DuplexStream : Stream
+    {
+        private readonly Stream _input;
+        private readonly Stream _output;
+
+        public DuplexStream(Stream input, Stream output)
+        {
+            _input = input;
+            _output = output;
+        }
+
+        public override bool CanRead => true;
+        public override bool CanWrite => true;
+        public override bool CanSeek => false;
+        public override long Length => throw new NotSupportedException();
+
+        public override long Position
+        {
+            get => throw new NotSupportedException();
+            set => throw new NotSupportedException();
+        }
+
+        public override int Read(byte[] buffer, int offset, int count)
+            => _input.Read(buffer, offset, count);
+
+        public override ValueTask<int> ReadAsync(Memory<byte> buffer, CancellationToken cancellationToken = default)
+            => _input.ReadAsync(buffer, cancellationToken);
+
+        public override Task<int> ReadAsync(byte[] buffer, int offset, int count, CancellationToken cancellationToken)
+            => _input.ReadAsync(buffer, offset, count, cancellationToken);
+
+        public override void Write(byte[] buffer, int offset, int count)
+            => _output.Write(buffer, offset, count);
+
+        public override ValueTask WriteAsync(ReadOnlyMemory<byte> buffer, CancellationToken cancellationToken = default)
+            => _output.WriteAsync(buffer, cancellationToken);
+
+        public override Task WriteAsync(byte[] buffer, int offset, int count, CancellationToken cancellationToken)
+            => _output.WriteAsync(buffer, offset, count, cancellationToken);
+
+        public override void Flush() => _output.Flush();
+
+        public override Task FlushAsync(CancellationToken cancellationToken)
+            => _output.FlushAsync(cancellationToken);
+
+        public override long Seek(long offset, SeekOrigin origin) => throw new NotSupportedException();
+        public override void SetLength(long value) => throw new NotSupportedException();
+
+        protected override void Dispose(bool disposing)
+        {
+            if (disposing)
+            {
+                _output.Dispose();
+                _input.Dispose();
+            }
+            base.Dispose(disposing);
+        }
+    }
+}
@@ -0,0 +1,625 @@
+using System.Diagnostics;
+using System.IO.Pipelines;
+using System.Text;
+using System.Text.Json;
+using System.Text.Json.Serialization;
+using System.Threading.Channels;
+
+namespace BridgeOne.Protocol.Simulation;
+
+/// <summary>
+/// 시뮬레이터 동글의 connection_state (펌웨어 connection_state_t와 동일한 순서)
+/// </summary>
+public enum SimulatedConnectionState
+{
+    Idle,
+    AuthPending,
+    AuthOk,
+    SyncPending,
+    Connected,
+}
+
+/// <summary>
+/// ESP32-S3 Vendor CDC 동작을 재현하는 인프로세스 동글 시뮬레이터.
+/// vendor_cdc_handler.c / connection_state.c의 명령 처리와 상태 전이 규칙을 따릅니다.
+///
+/// - AUTH_CHALLENGE: IDLE에서만 허용, challenge 에코백 (그 외 상태면 리셋 후 무응답)
+/// - STATE_SYNC: AUTH_OK에서만 허용, 요청 기능 중 지원 기능만 수락 → CONNECTED
+/// - HELLO: IDLE에서만 허용, 인증 + 기능 협상을 한 번에 처리하고 IDLE → CONNECTED
+/// - STATE_SYNC_ACK / HELLO_ACK에 세션 토큰 발급, CONNECTED에서 IDLE로 떨어지면 기능을 보류하고
+///   SessionGrace 안의 RESUME이면 같은 기능으로 CONNECTED 복귀 (아니면 ERROR [0x07, 0x03])
+/// - PING: 페이로드 그대로 PONG 에코, CONNECTED에서 KeepAliveTimeout 동안 PING 없으면 IDLE
+/// - MACRO_UPLOAD: 길이/ID/스텝 수 검증 후 <see cref="StoredMacros"/>에 저장하고 MACRO_ACK 응답
+/// - 호스트가 포트를 닫으면(DTR 해제) IDLE로 리셋
+/// - 미지원 명령: ERROR [cmd, 0x01]
+///
+/// 링크 특성(지연/지터/손실/로그 노이즈)은 <see cref="SimulatedDeviceOptions"/>로 주입합니다.
+/// <see cref="LoopbackTransport"/>가 연결마다 <see cref="RunAsync"/>를 호출합니다.
+/// </summary>
+public sealed class SimulatedDevice
+{
+    private const byte UnsupportedCommandError = 0x01;
+    private const byte SessionRejectedError = 0x03;
+    private const string ProtocolVersion = "1.0";
+
+    // macro_engine.h MACRO_MAX_COUNT / MACRO_MAX_STEPS / sizeof(macro_step_t)
+    private const int MacroMaxCount = 32;
+    private const int MacroMaxSteps = 55;
+    private const int MacroStepSize = 8;
+
+    private static readonly JsonSerializerOptions OmitNullJsonOptions =
+        new() { DefaultIgnoreCondition = JsonIgnoreCondition.WhenWritingNull };
+
+    private static readonly TimeSpan MaintenancePeriod = TimeSpan.FromMilliseconds(100);
+
+    private readonly SimulatedDeviceOptions _options;
+    private readonly Random _random;
+    private readonly object _lock = new();
+
+    private SimulatedConnectionState _state = SimulatedConnectionState.Idle;
+    private ChannelWriter<(long Due, byte[] Data)>? _outgoing;
+    private long _lastPingTimestamp;
+    private long _lastDueTimestamp;
+    private long _logSequence;
+
+    // 매크로 슬롯 (macro_engine.c 플래시 슬롯, 스텝 바이트 그대로)
+    private readonly Dictionary<byte, byte[]> _storedMacros = new();
+
+    // 세션 재개 (connection_state.c s_session_*)
+    private string? _sessionToken;
+    private string[] _suspendedFeatures = [];
+    private int _suspendedKeepaliveMs;
+    private long _suspendedTimestamp;
+
+    /// <summary>현재 연결 상태</summary>
+    public SimulatedConnectionState State
+    {
+        get { lock (_lock) return _state; }
+    }
+
+    /// <summary>마지막 STATE_SYNC/HELLO에서 수락한 기능 (IDLE로 돌아가면 비워짐)</summary>
+    public string[] NegotiatedFeatures { get; private set; } = [];
+
+    /// <summary>마지막 STATE_SYNC/HELLO에서 합의한 keepalive_ms</summary>
+    public int NegotiatedKeepaliveMs { get; private set; }
+
+    /// <summary>MACRO_UPLOAD로 저장된 매크로 (ID → 스텝 바이트 사본)</summary>
+    public IReadOnlyDictionary<byte, byte[]> StoredMacros
+    {
+        get { lock (_lock) return new Dictionary<byte, byte[]>(_storedMacros); }
+    }
+
+    /// <summary>수신(처리)한 프레임 수</summary>
+    public long FramesHandled => Interlocked.Read(ref _framesHandled);
+    private long _framesHandled;
+
+    /// <summary>LossRate로 버린 프레임 수</summary>
+    public long FramesLost => Interlocked.Read(ref _framesLost);
+    private long _framesLost;
+
+    /// <summary>상태 전이 시 발생 (시뮬레이터 스레드에서 호출)</summary>
+    public event EventHandler<SimulatedConnectionState>? StateChanged;
+
+    public SimulatedDevice(SimulatedDeviceOptions? options = null)
+    {
+        _options = options ?? new SimulatedDeviceOptions();
+        _random = new Random(_options.Seed);
+    }
+
+    /// <summary>
+    /// 한 번의 CDC 세션을 실행합니다 (포트 열림 → 닫힘/취소).
+    /// </summary>
+    /// <param name="input">호스트 → 동글 바이트</param>
+    /// <param name="output">동글 → 호스트 바이트</param>
+    public async Task RunAsync(PipeReader input, PipeWriter output, CancellationToken cancellationToken)
+    {
+        var outgoing = Channel.CreateUnbounded<(long Due, byte[] Data)>(
+            new UnboundedChannelOptions { SingleReader = true });
+        _outgoing = outgoing.Writer;
+        _lastDueTimestamp = 0;
+
+        // DTR 연결 배너 (usb_cdc_log.c tud_cdc_line_state_cb)
+        Enqueue(Encoding.ASCII.GetBytes(
+            "\r\n\r\n=== BridgeOne USB CDC Debug Log ===\r\n" +
+            $"Connected successfully. Logs will appear below.\r\nCurrent state: {StateName(State)}\r\n\r\n"),
+            immediate: true);
+
+        using var linked = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        var sender = SendLoopAsync(outgoing.Reader, output, linked.Token);
+        var maintenance = MaintenanceLoopAsync(linked.Token);
+
+        try
+        {
+            await ReceiveLoopAsync(input, linked.Token);
+        }
+        finally
+        {
+            // 포트 닫힘 = DTR 해제 → IDLE (Essential 모드 복귀)
+            Reset("DTR released");
+            linked.Cancel();
+            outgoing.Writer.TryComplete();
+            await Task.WhenAll(sender, maintenance);
+            await input.CompleteAsync();
+        }
+    }
+
+    // ==================== 수신/명령 처리 ====================
+
+    private async Task ReceiveLoopAsync(PipeReader input, CancellationToken ct)
+    {
+        while (true)
+        {
+            ReadResult result;
+            try
+            {
+                result = await input.ReadAsync(ct);
+            }
+            catch (OperationCanceledException)
+            {
+                return;
+            }
+
+            var buffer = result.Buffer;
+            while (true)
+            {
+                var token = VendorCdcFrameParser.TryRead(ref buffer, out var frame, out _);
+                if (token == VendorCdcToken.NeedMoreData)
+                    break;
+                if (token != VendorCdcToken.Frame)
+                    continue;
+
+                using (frame)
+                {
+                    if (!frame!.IsValid)
+                        continue;
+
+                    if (_options.LossRate > 0 && NextDouble() < _options.LossRate)
+                    {
+                        Interlocked.Increment(ref _framesLost);
+                        continue;
+                    }
+
+                    Interlocked.Increment(ref _framesHandled);
+                    var response = Handle(frame);
+                    if (response != null)
+                        Enqueue(response, immediate: false);
+                }
+            }
+
+            input.AdvanceTo(buffer.Start, buffer.End);
+            if (result.IsCompleted)
+                return;
+        }
+    }
+
+    /// <summary>
+    /// 프레임 하나를 처리하고 응답 프레임 바이트를 반환합니다 (응답 없으면 null).
+    /// </summary>
+    private byte[]? Handle(VendorCdcFrame frame)
+    {
+        switch ((VendorCdcCommand)frame.Command)
+        {
+            case VendorCdcCommand.Ping:
+                Interlocked.Exchange(ref _lastPingTimestamp, Stopwatch.GetTimestamp());
+                return Encode(VendorCdcCommand.Pong, frame.Payload.Span);
+
+            case VendorCdcCommand.AuthChallenge:
+                return HandleAuthChallenge(frame.Payload.Span);
+
+            case VendorCdcCommand.StateSync:
+                return HandleStateSync(frame.Payload.Span);
+
+            case VendorCdcCommand.Hello when _options.SupportsHello:
+                return HandleHello(frame.Payload.Span);
+
+            case VendorCdcCommand.Resume when _options.SupportsResume:
+                return HandleResume(frame.Payload.Span);
+
+            case VendorCdcCommand.MacroUpload:
+                return HandleMacroUpload(frame.Payload.Span);
+
+            case VendorCdcCommand.Error:
+                return null;
+
+            default:
+                return Encode(VendorCdcCommand.Error, [frame.Command, UnsupportedCommandError]);
+        }
+    }
+
+    private byte[]? HandleAuthChallenge(ReadOnlySpan<byte> payload)
+    {
+        using var json = TryParseJson(payload);
+        if (json == null || !TryTransition(SimulatedConnectionState.Idle, SimulatedConnectionState.AuthPending))
+        {
+            Reset("AUTH_CHALLENGE rejected");
+            return null;
+        }
+
+        var root = json.RootElement;
+        if (!root.TryGetProperty("challenge", out var challengeProp)
+            || challengeProp.ValueKind != JsonValueKind.String)
+        {
+            Reset("AUTH_CHALLENGE without challenge");
+            return null;
+        }
+
+        CheckProtocolVersion(root);
+
+        var response = JsonSerializer.SerializeToUtf8Bytes(new
+        {
+            command = "AUTH_RESPONSE",
+            response = challengeProp.GetString(),
+            device = _options.DeviceName,
+            fw_version = _options.FirmwareVersion
+        });
+
+        TryTransition(SimulatedConnectionState.AuthPending, SimulatedConnectionState.AuthOk);
+        return Encode(VendorCdcCommand.AuthResponse, response);
+    }
+
+    private byte[]? HandleStateSync(ReadOnlySpan<byte> payload)
+    {
+        using var json = TryParseJson(payload);
+        if (json == null || !TryTransition(SimulatedConnectionState.AuthOk, SimulatedConnectionState.SyncPending))
+        {
+            Reset("STATE_SYNC rejected");
+            return null;
+        }
+
+        var accepted = Negotiate(json.RootElement);
+
+        var ack = WithSession(new Dictionary<string, object>
+        {
+            ["command"] = "STATE_SYNC_ACK",
+            ["accepted_features"] = accepted,
+            ["mode"] = "standard"
+        });
+
+        // 서버의 첫 PING 전에 타임아웃되지 않도록 기준 시각 리셋
+        Interlocked.Exchange(ref _lastPingTimestamp, Stopwatch.GetTimestamp());
+        TryTransition(SimulatedConnectionState.SyncPending, SimulatedConnectionState.Connected);
+        return Encode(VendorCdcCommand.StateSyncAck, ack);
+    }
+
+    private byte[]? HandleHello(ReadOnlySpan<byte> payload)
+    {
+        using var json = TryParseJson(payload);
+        if (json == null || State != SimulatedConnectionState.Idle)
+        {
+            Reset("HELLO rejected");
+            return null;
+        }
+
+        var root = json.RootElement;
+        if (!root.TryGetProperty("challenge", out var challengeProp)
+            || challengeProp.ValueKind != JsonValueKind.String)
+        {
+            return null;
+        }
+
+        CheckProtocolVersion(root);
+        var accepted = Negotiate(root);
+
+        var ack = WithSession(new Dictionary<string, object>
+        {
+            ["command"] = "HELLO_ACK",
+            ["response"] = challengeProp.GetString()!,
+            ["device"] = _options.DeviceName,
+            ["fw_version"] = _options.FirmwareVersion,
+            ["accepted_features"] = accepted,
+            ["mode"] = "standard"
+        });
+
+        // connection_state_establish(): 중간 상태 없이 IDLE → CONNECTED
+        Interlocked.Exchange(ref _lastPingTimestamp, Stopwatch.GetTimestamp());
+        TryTransition(SimulatedConnectionState.Idle, SimulatedConnectionState.Connected);
+        return Encode(VendorCdcCommand.HelloAck, ack);
+    }
+
+    private byte[]? HandleResume(ReadOnlySpan<byte> payload)
+    {
+        using var json = TryParseJson(payload);
+        string? token = json != null
+                        && json.RootElement.TryGetProperty("session", out var sessionProp)
+                        && sessionProp.ValueKind == JsonValueKind.String
+            ? sessionProp.GetString()
+            : null;
+
+        // 끊김을 감지하지 못한 채 다시 연결된 경우: 리셋으로 현재 세션을 보류시킨 뒤 재개
+        if (token != null && State != SimulatedConnectionState.Idle)
+            Reset("RESUME while not IDLE");
+
+        string[] features;
+        int keepaliveMs;
+        lock (_lock)
+        {
+            bool valid = token != null
+                         && _state == SimulatedConnectionState.Idle
+                         && _suspendedTimestamp != 0
+                         && token == _sessionToken;
+            if (valid && Stopwatch.GetElapsedTime(_suspendedTimestamp) > _options.SessionGrace)
+            {
+                _sessionToken = null;
+                valid = false;
+            }
+
+            if (!valid)
+                return Encode(VendorCdcCommand.Error, [(byte)VendorCdcCommand.Resume, SessionRejectedError]);
+
+            _suspendedTimestamp = 0;
+            features = _suspendedFeatures;
+            keepaliveMs = _suspendedKeepaliveMs;
+        }
+
+        NegotiatedFeatures = features;
+        NegotiatedKeepaliveMs = keepaliveMs;
+
+        var ack = JsonSerializer.SerializeToUtf8Bytes(new
+        {
+            command = "RESUME_ACK",
+            accepted_features = features,
+            keepalive_ms = keepaliveMs,
+            mode = "standard"
+        });
+
+        // connection_state_resume(): 보류 기능 그대로 IDLE → CONNECTED
+        Interlocked.Exchange(ref _lastPingTimestamp, Stopwatch.GetTimestamp());
+        TryTransition(SimulatedConnectionState.Idle, SimulatedConnectionState.Connected);
+        return Encode(VendorCdcCommand.ResumeAck, ack);
+    }
+
+    /// <summary>펌웨어 add_session(): 새 세션 토큰 발급 후 ACK JSON에 추가 (이전 보류 세션 폐기)</summary>
+    private byte[] WithSession(Dictionary<string, object> ack)
+    {
+        if (_options.SupportsResume)
+        {
+            long random;
+            lock (_random)
+                random = _random.NextInt64();
+            var token = random.ToString("x16");
+            lock (_lock)
+            {
+                _sessionToken = token;
+                _suspendedTimestamp = 0;
+            }
+
+            ack["session"] = token;
+            ack["resume_grace_ms"] = (int)_options.SessionGrace.TotalMilliseconds;
+        }
+
+        return JsonSerializer.SerializeToUtf8Bytes(ack);
+    }
+
+    private void CheckProtocolVersion(JsonElement root)
+    {
+        if (root.TryGetProperty("version", out var versionProp)
+            && versionProp.GetString() != ProtocolVersion)
+        {
+            Log($"W VENDOR_CDC: protocol version mismatch: {versionProp.GetString()}");
+        }
+    }
+
+    /// <summary>펌웨어 negotiate_features(): 지원 기능만 수락하고 keepalive_ms 저장</summary>
+    private List<string> Negotiate(JsonElement root)
+    {
+        var accepted = new List<string>();
+        if (root.TryGetProperty("features", out var featuresProp)
+            && featuresProp.ValueKind == JsonValueKind.Array)
+        {
+            foreach (var item in featuresProp.EnumerateArray())
+            {
+                var name = item.GetString();
+                if (name != null && _options.SupportedFeatures.Contains(name))
+                    accepted.Add(name);
+            }
+        }
+
+        NegotiatedKeepaliveMs = root.TryGetProperty("keepalive_ms", out var keepaliveProp)
+                                && keepaliveProp.TryGetInt32(out var keepaliveMs) && keepaliveMs > 0
+            ? keepaliveMs
+            : 500;
+        NegotiatedFeatures = accepted.ToArray();
+        return accepted;
+    }
+
+    private byte[] HandleMacroUpload(ReadOnlySpan<byte> payload)
+    {
+        // vendor_cdc_handler.c handle_cmd_macro_upload와 같은 검증 (ID 범위는 macro_engine_store)
+        bool ok = payload.Length >= 2
+                  && payload[0] < MacroMaxCount
+                  && payload[1] <= MacroMaxSteps
+                  && payload.Length == 2 + payload[1] * MacroStepSize;
+        if (ok)
+        {
+            lock (_lock)
+            {
+                if (payload[1] == 0)
+                    _storedMacros.Remove(payload[0]);
+                else
+                    _storedMacros[payload[0]] = payload[2..].ToArray();
+            }
+        }
+
+        var ack = JsonSerializer.SerializeToUtf8Bytes(new
+        {
+            command = "MACRO_ACK",
+            id = payload.Length >= 2 ? payload[0] : 0,
+            steps = payload.Length >= 2 ? payload[1] : 0,
+            result = ok ? "ok" : "error",
+            reason = ok ? null : "ESP_ERR_INVALID_ARG"
+        }, OmitNullJsonOptions);
+        return Encode(VendorCdcCommand.MacroAck, ack);
+    }
+
+    // ==================== 상태 전이 ====================
+
+    private bool TryTransition(SimulatedConnectionState from, SimulatedConnectionState to)
+    {
+        lock (_lock)
+        {
+            if (_state != from)
+                return false;
+            _state = to;
+        }
+
+        StateChanged?.Invoke(this, to);
+        return true;
+    }
+
+    private void Reset(string reason)
+    {
+        lock (_lock)
+        {
+            if (_state == SimulatedConnectionState.Idle)
+                return;
+
+            // CONNECTED 세션이 끊기면 기능 보류 (session_suspend_locked)
+            if (_state == SimulatedConnectionState.Connected && _sessionToken != null)
+            {
+                _suspendedFeatures = NegotiatedFeatures;
+                _suspendedKeepaliveMs = NegotiatedKeepaliveMs;
+                _suspendedTimestamp = Stopwatch.GetTimestamp();
+            }
+
+            _state = SimulatedConnectionState.Idle;
+        }
+
+        NegotiatedFeatures = [];
+        Debug.WriteLine($"[SimulatedDevice] {reason} → IDLE");
+        StateChanged?.Invoke(this, SimulatedConnectionState.Idle);
+    }
+
+    // ==================== 송신 (지연/지터 적용) ====================
+
+    /// <summary>
+    /// 응답을 전송 큐에 넣습니다. 도착 시각은 이전 응답보다 앞서지 않으므로 순서가 유지됩니다.
+    /// </summary>
+    private void Enqueue(byte[] data, bool immediate)
+    {
+        long now = Stopwatch.GetTimestamp();
+        long delay = 0;
+        if (!immediate)
+        {
+            delay = _options.Latency.Ticks;
+            if (_options.Jitter > TimeSpan.Zero)
+                delay += (long)(_options.Jitter.Ticks * NextDouble());
+        }
+
+        long due;
+        lock (_lock)
+        {
+            due = Math.Max(_lastDueTimestamp, now + delay * Stopwatch.Frequency / TimeSpan.TicksPerSecond);
+            _lastDueTimestamp = due;
+        }
+
+        _outgoing?.TryWrite((due, data));
+    }
+
+    private static async Task SendLoopAsync(ChannelReader<(long Due, byte[] Data)> reader,
+        PipeWriter output, CancellationToken ct)
+    {
+        try
+        {
+            await foreach (var (due, data) in reader.ReadAllAsync(ct))
+            {
+                // Task.Delay는 ms 미만을 버리므로 올림 (1 ms 지연이 0으로 사라지지 않게)
+                var wait = Stopwatch.GetElapsedTime(Stopwatch.GetTimestamp(), due);
+                if (wait > TimeSpan.Zero)
+                    await Task.Delay(TimeSpan.FromMilliseconds(Math.Ceiling(wait.TotalMilliseconds)), ct);
+
+                var flush = await output.WriteAsync(data, ct);
+                if (flush.IsCompleted)
+                    return;
+            }
+        }
+        catch (OperationCanceledException)
+        {
+        }
+        finally
+        {
+            await output.CompleteAsync();
+        }
+    }
+
+    // ==================== 주기 작업 (Keep-alive 타임아웃, 로그 노이즈) ====================
+
+    private async Task MaintenanceLoopAsync(CancellationToken ct)
+    {
+        using var timer = new PeriodicTimer(MaintenancePeriod);
+        long lastNoise = Stopwatch.GetTimestamp();
+
+        try
+        {
+            while (await timer.WaitForNextTickAsync(ct))
+            {
+                long now = Stopwatch.GetTimestamp();
+
+                if (State == SimulatedConnectionState.Connected
+                    && Stopwatch.GetElapsedTime(Interlocked.Read(ref _lastPingTimestamp), now)
+                       > _options.KeepAliveTimeout)
+                {
+                    Log("W VENDOR_CDC: Server keep-alive timeout, reverting to Essential mode");
+                    Reset("keep-alive timeout");
+                }
+
+                if (_options.LogNoiseInterval > TimeSpan.Zero
+                    && Stopwatch.GetElapsedTime(lastNoise, now) >= _options.LogNoiseInterval)
+                {
+                    lastNoise = now;
+                    Log($"I HID: report sent (seq={Interlocked.Increment(ref _logSequence)})");
+                }
+            }
+        }
+        catch (OperationCanceledException)
+        {
+        }
+    }
+
+    /// <summary>ESP_LOG 형식 한 줄 출력 ("I (1234) TAG: message")</summary>
+    private void Log(string message)
+    {
+        var line = $"{message[0]} ({Environment.TickCount64 % 1_000_000}) {message[2..]}\r\n";
+        Enqueue(Encoding.ASCII.GetBytes(line), immediate: true);
+    }
+
+    // ==================== 유틸리티 ====================
+
+    private double NextDouble()
+    {
+        lock (_random)
+            return _random.NextDouble();
+    }
+
+    private static JsonDocument? TryParseJson(ReadOnlySpan<byte> payload)
+    {
+        if (payload.IsEmpty)
+            return null;
+
+        try
+        {
+            var reader = new Utf8JsonReader(payload);
+            return JsonDocument.ParseValue(ref reader);
+        }
+        catch (JsonException)
+        {
+            return null;
+        }
+    }
+
+    private static byte[] Encode(VendorCdcCommand command, ReadOnlySpan<byte> payload)
+    {
+        var buffer = new byte[VendorCdcFrame.OverheadSize + payload.Length];
+        VendorCdcFrame.Write(buffer, (byte)command, payload);
+        return buffer;
+    }
+
+    private static string StateName(SimulatedConnectionState state) => state switch
+    {
+        SimulatedConnectionState.Idle => "IDLE",
+        SimulatedConnectionState.AuthPending => "AUTH_PENDING",
+        SimulatedConnectionState.AuthOk => "AUTH_OK",
+        SimulatedConnectionState.SyncPending => "SYNC_PENDING",
+        SimulatedConnectionState.Connected => "CONNECTED",
+        _ => state.ToString()
+    };
+}
@@ -0,0 +1,49 @@
+namespace BridgeOne.Protocol.Simulation;
+
+/// <summary>
+/// 시뮬레이터 동글의 동작/링크 특성 설정.
+/// 기본값은 지연 없는 이상적인 링크와 펌웨어(vendor_cdc_handler.c)와 같은 기능 목록입니다.
+/// </summary>
+public sealed class SimulatedDeviceOptions
+{
+    /// <summary>
+    /// 요청 수신 → 응답 도착까지 고정 지연 (USB 왕복 + VCDC 태스크 처리 시간 근사).
+    /// Task.Delay 타이머 해상도 때문에 수 ms 이하 값은 실제로 더 길게 적용될 수 있습니다.
+    /// </summary>
+    public TimeSpan Latency { get; init; } = TimeSpan.Zero;
+
+    /// <summary>응답마다 0 ~ Jitter 균등 분포로 추가되는 지연 (응답 순서는 유지)</summary>
+    public TimeSpan Jitter { get; init; } = TimeSpan.Zero;
+
+    /// <summary>수신 프레임을 처리하지 않고 버릴 확률 (0.0 ~ 1.0)</summary>
+    public double LossRate { get; init; }
+
+    /// <summary>디버그 로그 텍스트(ESP_LOG 형식) 출력 주기. Zero면 출력 안 함.</summary>
+    public TimeSpan LogNoiseInterval { get; init; } = TimeSpan.Zero;
+
+    /// <summary>CONNECTED 상태에서 PING이 없으면 IDLE로 되돌리는 시간 (펌웨어 KEEPALIVE_TIMEOUT_US)</summary>
+    public TimeSpan KeepAliveTimeout { get; init; } = TimeSpan.FromSeconds(3);
+
+    /// <summary>동글이 지원하는 기능 (펌웨어 supported_features)</summary>
+    public string[] SupportedFeatures { get; init; } = ["wheel", "drag", "right_click"];
+
+    /// <summary>HELLO(1회 왕복 핸드셰이크) 지원 여부. false면 이전 펌웨어처럼 ERROR [0x05, 0x01] 응답.</summary>
+    public bool SupportsHello { get; init; } = true;
+
+    /// <summary>
+    /// 세션 재개 지원 여부. false면 ACK에 세션 토큰을 싣지 않고 RESUME에 ERROR [0x07, 0x01] 응답.
+    /// </summary>
+    public bool SupportsResume { get; init; } = true;
+
+    /// <summary>CONNECTED → IDLE 이후 RESUME을 받아주는 유예 시간 (펌웨어 CONN_SESSION_GRACE_MS)</summary>
+    public TimeSpan SessionGrace { get; init; } = TimeSpan.FromSeconds(10);
+
+    /// <summary>AUTH_RESPONSE / HELLO_ACK의 device 필드</summary>
+    public string DeviceName { get; init; } = "BridgeOne";
+
+    /// <summary>AUTH_RESPONSE / HELLO_ACK의 fw_version 필드</summary>
+    public string FirmwareVersion { get; init; } = "1.0.0";
+
+    /// <summary>지터/손실 난수 시드 (재현 가능한 테스트용)</summary>
+    public int Seed { get; init; } = 1;
+}
@@ -0,0 +1,183 @@
+using System.Buffers;
+using System.Buffers.Binary;
+
+namespace BridgeOne.Protocol;
+
+/// <summary>
+/// Vendor CDC 명령 코드. ESP32-S3 vendor_cdc_cmd_t와 동일.
+/// </summary>
+public enum VendorCdcCommand : byte
+{
+    AuthChallenge = 0x01,
+    AuthResponse  = 0x02,
+    StateSync     = 0x03,
+    StateSyncAck  = 0x04,
+    Hello         = 0x05,
+    HelloAck      = 0x06,
+    Resume        = 0x07,
+    ResumeAck     = 0x08,
+    Ping          = 0x10,
+    Pong          = 0x11,
+    ModeNotify    = 0x20,
+    MacroUpload   = 0x30,
+    MacroAck      = 0x31,
+    MemQuery      = 0x40,
+    MemReport     = 0x41,
+    TopQuery      = 0x42,
+    TopReport     = 0x43,
+    ProfControl   = 0x44,
+    ProfStatus    = 0x45,
+    ProfData      = 0x46,
+    TraceControl  = 0x47,
+    TraceStatus   = 0x48,
+    TraceData     = 0x49,
+    InputControl  = 0x4A,
+    InputStatus   = 0x4B,
+    InputData     = 0x4C,
+    InputUpload   = 0x4D,
+    Error         = 0xFE,
+}
+
+/// <summary>
+/// Vendor CDC 바이너리 프레임.
+/// 구조: [0xFF] [command 1B] [length_LE 2B] [payload 0~448B] [crc16_LE 2B]
+/// CRC16은 payload만 대상으로 계산합니다.
+///
+/// 수신 프레임(<see cref="VendorCdcFrameParser"/>)의 페이로드는 ArrayPool에서 빌린 버퍼입니다.
+/// 프레임을 다 쓴 소유자가 <see cref="Dispose"/>로 반환하며, 반환하지 않아도 GC가 회수하므로
+/// 누수는 없고 풀 재사용만 놓칩니다. Dispose 이후 <see cref="Payload"/>는 빈 값입니다.
+/// </summary>
+public sealed class VendorCdcFrame : IDisposable
+{
+    /// <summary>프레임 헤더 마커</summary>
+    public const byte Header = 0xFF;
+
+    /// <summary>헤더(1) + 명령(1) + 길이(2) + CRC(2)</summary>
+    public const int OverheadSize = 6;
+
+    /// <summary>헤더(1) + 명령(1) + 길이(2)</summary>
+    public const int PrefixSize = 4;
+
+    /// <summary>최대 페이로드 크기 (ESP32-S3과 동일)</summary>
+    public const int MaxPayloadSize = 448;
+
+    /// <summary>최대 프레임 크기</summary>
+    public const int MaxFrameSize = OverheadSize + MaxPayloadSize;
+
+    private byte[]? _pooledBuffer;
+    private ReadOnlyMemory<byte> _payload;
+
+    /// <summary>명령 코드</summary>
+    public byte Command { get; }
+
+    /// <summary>페이로드 데이터 (비어 있을 수 있음)</summary>
+    public ReadOnlyMemory<byte> Payload => _payload;
+
+    /// <summary>CRC 검증 통과 여부 (Parse로 생성된 경우에만 의미 있음)</summary>
+    public bool IsValid { get; }
+
+    public VendorCdcFrame(byte command, byte[] payload, bool isValid = true)
+    {
+        Command = command;
+        _payload = payload;
+        IsValid = isValid;
+    }
+
+    /// <summary>
+    /// 풀에서 빌린 버퍼를 페이로드로 소유하는 프레임 (파서 전용).
+    /// </summary>
+    internal VendorCdcFrame(byte command, byte[] pooledBuffer, int length, bool isValid)
+    {
+        Command = command;
+        _pooledBuffer = pooledBuffer;
+        _payload = new ReadOnlyMemory<byte>(pooledBuffer, 0, length);
+        IsValid = isValid;
+    }
+
+    /// <summary>
+    /// 프레임을 바이트 배열로 직렬화합니다.
+    /// CRC16은 payload만 대상으로 계산하여 Little-Endian으로 부착합니다.
+    /// </summary>
+    public byte[] ToBytes()
+    {
+        var buffer = new byte[FrameSize];
+        Write(buffer, Command, Payload.Span);
+        return buffer;
+    }
+
+    /// <summary>
+    /// 프레임을 destination에 직렬화합니다 (할당 없음).
+    /// </summary>
+    /// <returns>기록한 바이트 수 (OverheadSize + payload.Length)</returns>
+    public static int Write(Span<byte> destination, byte command, ReadOnlySpan<byte> payload)
+    {
+        if (payload.Length > MaxPayloadSize)
+            throw new ArgumentException(
+                $"페이로드 크기 초과: {payload.Length} > {MaxPayloadSize}", nameof(payload));
+
+        int frameSize = OverheadSize + payload.Length;
+        destination[0] = Header;
+        destination[1] = command;
+        BinaryPrimitives.WriteUInt16LittleEndian(destination[2..], (ushort)payload.Length);
+        payload.CopyTo(destination[PrefixSize..]);
+        BinaryPrimitives.WriteUInt16LittleEndian(
+            destination[(PrefixSize + payload.Length)..], Crc16.Calculate(payload));
+        return frameSize;
+    }
+
+    /// <summary>
+    /// 프레임을 IBufferWriter(예: PipeWriter)에 직렬화합니다 (중간 배열 없음).
+    /// </summary>
+    public static void Write(IBufferWriter<byte> writer, byte command, ReadOnlySpan<byte> payload)
+    {
+        int frameSize = OverheadSize + payload.Length;
+        int written = Write(writer.GetSpan(frameSize), command, payload);
+        writer.Advance(written);
+    }
+
+    /// <summary>
+    /// 완전한 프레임 바이트 배열에서 VendorCdcFrame을 파싱합니다.
+    /// 헤더(0xFF)부터 CRC까지 포함된 전체 프레임이어야 합니다.
+    /// 스트림 수신에는 <see cref="VendorCdcFrameParser"/>를 사용합니다.
+    /// </summary>
+    /// <returns>파싱된 프레임 (CRC 오류 시 IsValid=false), 구조 오류 시 null</returns>
+    public static VendorCdcFrame? Parse(byte[] data, int offset = 0)
+    {
+        var span = data.AsSpan(offset);
+
+        // 최소 크기 / 헤더 검증
+        if (span.Length < OverheadSize || span[0] != Header)
+            return null;
+
+        byte command = span[1];
+        ushort payloadLen = BinaryPrimitives.ReadUInt16LittleEndian(span[2..]);
+
+        // 페이로드 길이 검증
+        if (payloadLen > MaxPayloadSize || span.Length < OverheadSize + payloadLen)
+            return null;
+
+        var payload = span.Slice(PrefixSize, payloadLen);
+        ushort receivedCrc = BinaryPrimitives.ReadUInt16LittleEndian(span[(PrefixSize + payloadLen)..]);
+        bool isValid = receivedCrc == Crc16.Calculate(payload);
+
+        return new VendorCdcFrame(command, payload.ToArray(), isValid);
+    }
+
+    /// <summary>
+    /// 프레임의 전체 바이트 크기를 반환합니다.
+    /// </summary>
+    public int FrameSize => OverheadSize + Payload.Length;
+
+    /// <summary>
+    /// 풀에서 빌린 페이로드 버퍼를 반환합니다. 여러 번 호출해도 안전합니다.
+    /// </summary>
+    public void Dispose()
+    {
+        var buffer = Interlocked.Exchange(ref _pooledBuffer, null);
+        if (buffer == null)
+            return;
+
+        _payload = ReadOnlyMemory<byte>.Empty;
+        ArrayPool<byte>.Shared.Return(buffer);
+    }
+}
@@ -0,0 +1,109 @@
+using System.Buffers;
+using System.Buffers.Binary;
+
+namespace BridgeOne.Protocol;
+
+/// <summary>
+/// <see cref="VendorCdcFrameParser.TryRead"/>가 읽은 토큰 종류.
+/// </summary>
+public enum VendorCdcToken
+{
+    /// <summary>완전한 토큰이 아직 없음 (더 수신해야 함)</summary>
+    NeedMoreData,
+
+    /// <summary>프레임 (CRC 오류 시 IsValid=false)</summary>
+    Frame,
+
+    /// <summary>0xFF가 아닌 바이트열 (ESP32-S3 디버그 로그)</summary>
+    DebugText,
+
+    /// <summary>길이 필드가 비정상인 0xFF 1바이트 (프레임 헤더가 아님)</summary>
+    NonFrameHeader,
+}
+
+/// <summary>
+/// Vendor CDC 수신 바이트열 파서.
+/// PipeReader가 넘겨주는 ReadOnlySequence를 복사 없이 스캔하여
+/// 0xFF 바이너리 프레임과 디버그 텍스트를 분리합니다.
+/// 세그먼트 경계에 걸친 프레임도 그대로 처리하며, 페이로드만 풀 버퍼로 한 번 복사합니다.
+/// </summary>
+public static class VendorCdcFrameParser
+{
+    /// <summary>
+    /// buffer 앞에서 토큰 하나를 읽고, 읽은 만큼 buffer를 전진시킵니다.
+    /// </summary>
+    /// <param name="buffer">수신 버퍼. 소비한 부분이 잘려 나간 나머지로 갱신됩니다.</param>
+    /// <param name="frame">Frame일 때 파싱된 프레임 (소유권은 호출자에게 넘어감)</param>
+    /// <param name="text">DebugText일 때 텍스트 바이트 구간 (buffer와 같은 메모리, 복사 없음)</param>
+    /// <returns>읽은 토큰 종류. NeedMoreData면 buffer는 변경되지 않습니다.</returns>
+    public static VendorCdcToken TryRead(ref ReadOnlySequence<byte> buffer,
+        out VendorCdcFrame? frame, out ReadOnlySequence<byte> text)
+    {
+        frame = null;
+        text = default;
+
+        if (buffer.IsEmpty)
+            return VendorCdcToken.NeedMoreData;
+
+        var reader = new SequenceReader<byte>(buffer);
+        reader.TryPeek(out byte first);
+
+        // 0xFF가 아닌 바이트 → 다음 0xFF(또는 버퍼 끝)까지 디버그 텍스트
+        if (first != VendorCdcFrame.Header)
+        {
+            if (!reader.TryReadTo(out text, VendorCdcFrame.Header, advancePastDelimiter: false))
+            {
+                text = buffer;
+                reader.AdvanceToEnd();
+            }
+
+            buffer = buffer.Slice(reader.Position);
+            return VendorCdcToken.DebugText;
+        }
+
+        // 0xFF 발견 → 최소 오버헤드 크기(6바이트)를 받을 때까지 대기
+        if (buffer.Length < VendorCdcFrame.OverheadSize)
+            return VendorCdcToken.NeedMoreData;
+
+        reader.Advance(1);
+        reader.TryRead(out byte command);
+        reader.TryReadLittleEndian(out short rawLength);
+        int payloadLen = (ushort)rawLength;
+
+        // 비정상적인 length → 이 0xFF는 프레임 헤더가 아님
+        if (payloadLen > VendorCdcFrame.MaxPayloadSize)
+        {
+            buffer = buffer.Slice(1);
+            return VendorCdcToken.NonFrameHeader;
+        }
+
+        // 프레임 전체를 아직 다 받지 못함 → 대기
+        if (reader.Remaining < payloadLen + 2)
+            return VendorCdcToken.NeedMoreData;
+
+        frame = ReadFrame(ref reader, command, payloadLen);
+        buffer = buffer.Slice(reader.Position);
+        return VendorCdcToken.Frame;
+    }
+
+    private static VendorCdcFrame ReadFrame(ref SequenceReader<byte> reader, byte command, int payloadLen)
+    {
+        byte[] pooled = payloadLen > 0
+            ? ArrayPool<byte>.Shared.Rent(payloadLen)
+            : Array.Empty<byte>();
+
+        var payload = pooled.AsSpan(0, payloadLen);
+        reader.TryCopyTo(payload);
+        reader.Advance(payloadLen);
+
+        Span<byte> crcBytes = stackalloc byte[2];
+        reader.TryCopyTo(crcBytes);
+        reader.Advance(2);
+
+        bool isValid = BinaryPrimitives.ReadUInt16LittleEndian(crcBytes) == Crc16.Calculate(payload);
+
+        return payloadLen > 0
+            ? new VendorCdcFrame(command, pooled, payloadLen, isValid)
+            : new VendorCdcFrame(command, pooled, isValid);
+    }
+}
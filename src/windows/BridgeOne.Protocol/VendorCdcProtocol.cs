@@ -0,0 +1,233 @@
+using System.Buffers;
+using System.Diagnostics;
+using System.Text;
+using System.Threading.Channels;
+
+namespace BridgeOne.Protocol;
+
+/// <summary>
+/// Vendor CDC 프레임 프로토콜 계층.
+/// <see cref="IVendorCdcTransport"/>의 스트림(실제 동글: SerialPort.BaseStream) 위에서
+/// <see cref="VendorCdcReceiver"/>(System.IO.Pipelines 기반)로 수신 루프를 돌며
+/// 0xFF 바이너리 프레임과 디버그 텍스트를 분리합니다.
+///
+/// 수신 프레임의 페이로드는 풀 버퍼입니다. FrameReader에서 꺼낸 쪽이 Dispose하고,
+/// 이벤트 핸들러는 핸들러 안에서만 페이로드를 참조합니다.
+/// </summary>
+public sealed class VendorCdcProtocol : IDisposable
+{
+    private readonly IVendorCdcTransport _transport;
+    private readonly Channel<VendorCdcFrame> _frameChannel;
+    private readonly VendorCdcReceiver _receiver = new();
+
+    private CancellationTokenSource? _receiveCts;
+    private Task? _receiveTask;
+    private readonly SemaphoreSlim _sendLock = new(1, 1);
+
+    private bool _disposed;
+
+    // ==================== 이벤트 ====================
+
+    /// <summary>
+    /// 유효한 프레임 수신 시 발생 (Channel과 병행 사용 가능).
+    /// 핸들러 반환 후 프레임은 Channel로 넘어가므로 페이로드는 핸들러 안에서만 참조합니다.
+    /// </summary>
+    public event EventHandler<VendorCdcFrame>? FrameReceived
+    {
+        add => _receiver.FrameReceived += value;
+        remove => _receiver.FrameReceived -= value;
+    }
+
+    /// <summary>디버그 텍스트 수신 시 발생 (0xFF가 아닌 바이트열)</summary>
+    public event EventHandler<string>? DebugTextReceived
+    {
+        add => _receiver.DebugTextReceived += value;
+        remove => _receiver.DebugTextReceived -= value;
+    }
+
+    /// <summary>CRC 오류로 프레임 폐기 시 발생</summary>
+    public event EventHandler<VendorCdcFrame>? FrameDiscarded
+    {
+        add => _receiver.FrameDiscarded += value;
+        remove => _receiver.FrameDiscarded -= value;
+    }
+
+    // ==================== 공개 API ====================
+
+    /// <summary>
+    /// 수신된 프레임을 읽는 Channel Reader.
+    /// 꺼낸 프레임은 처리 후 Dispose하여 페이로드 버퍼를 풀로 반환합니다.
+    /// </summary>
+    public ChannelReader<VendorCdcFrame> FrameReader => _frameChannel.Reader;
+
+    public VendorCdcProtocol(IVendorCdcTransport transport)
+    {
+        _transport = transport;
+
+        _frameChannel = Channel.CreateBounded<VendorCdcFrame>(
+            new BoundedChannelOptions(64)
+            {
+                FullMode = BoundedChannelFullMode.DropOldest,
+                SingleReader = false,
+                SingleWriter = true
+            },
+            // 가득 차서 밀려난 프레임은 아무도 읽지 않으므로 여기서 반환
+            dropped => dropped.Dispose());
+
+        _receiver.FrameHandler = OnFrameParsed;
+
+        // 연결 상태 변경 시 수신 루프 자동 시작/중지
+        _transport.ConnectedChanged += OnConnectedChanged;
+    }
+
+    /// <summary>
+    /// 바이너리 페이로드로 프레임을 전송합니다.
+    /// </summary>
+    public async Task SendFrameAsync(byte command, byte[] payload,
+        CancellationToken cancellationToken = default)
+    {
+        var stream = _transport.Stream
+            ?? throw new InvalidOperationException("장치가 연결되어 있지 않습니다.");
+
+        if (payload.Length > VendorCdcFrame.MaxPayloadSize)
+            throw new ArgumentException(
+                $"페이로드 크기 초과: {payload.Length} > {VendorCdcFrame.MaxPayloadSize}");
+
+        var buffer = ArrayPool<byte>.Shared.Rent(VendorCdcFrame.OverheadSize + payload.Length);
+        int frameSize = VendorCdcFrame.Write(buffer, command, payload);
+
+        await _sendLock.WaitAsync(cancellationToken);
+        try
+        {
+            await stream.WriteAsync(buffer.AsMemory(0, frameSize), cancellationToken);
+            await stream.FlushAsync(cancellationToken);
+        }
+        finally
+        {
+            _sendLock.Release();
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+
+        Debug.WriteLine(
+            $"[VendorCdcProtocol] TX: cmd=0x{command:X2}, payload={payload.Length}B");
+    }
+
+    /// <summary>
+    /// JSON 문자열 페이로드로 프레임을 전송합니다.
+    /// </summary>
+    public Task SendFrameAsync(byte command, string jsonPayload,
+        CancellationToken cancellationToken = default)
+    {
+        var payload = Encoding.UTF8.GetBytes(jsonPayload);
+        return SendFrameAsync(command, payload, cancellationToken);
+    }
+
+    /// <summary>
+    /// 페이로드 없이 프레임을 전송합니다 (예: PING).
+    /// </summary>
+    public Task SendFrameAsync(byte command,
+        CancellationToken cancellationToken = default)
+        => SendFrameAsync(command, Array.Empty<byte>(), cancellationToken);
+
+    /// <summary>
+    /// 이미 직렬화된 raw 바이트를 그대로 전송합니다 (테스트 전용).
+    /// CRC를 의도적으로 틀리게 보내는 등 진단 용도로 사용합니다.
+    /// </summary>
+    public async Task SendRawBytesAsync(byte[] rawBytes,
+        CancellationToken cancellationToken = default)
+    {
+        var stream = _transport.Stream
+            ?? throw new InvalidOperationException("장치가 연결되어 있지 않습니다.");
+
+        await _sendLock.WaitAsync(cancellationToken);
+        try
+        {
+            await stream.WriteAsync(rawBytes, cancellationToken);
+            await stream.FlushAsync(cancellationToken);
+        }
+        finally
+        {
+            _sendLock.Release();
+        }
+
+        Debug.WriteLine($"[VendorCdcProtocol] TX RAW: {rawBytes.Length}B");
+    }
+
+    // ==================== 수신 루프 ====================
+
+    private void StartReceiveLoop()
+    {
+        if (_receiveTask is { IsCompleted: false })
+            return;
+
+        _receiveCts = new CancellationTokenSource();
+        _receiveTask = Task.Run(() => ReceiveLoopAsync(_receiveCts.Token));
+
+        Debug.WriteLine("[VendorCdcProtocol] 수신 루프 시작");
+    }
+
+    private void StopReceiveLoop()
+    {
+        _receiveCts?.Cancel();
+        _receiveCts?.Dispose();
+        _receiveCts = null;
+        _receiveTask = null;
+
+        Debug.WriteLine("[VendorCdcProtocol] 수신 루프 중지");
+    }
+
+    private async Task ReceiveLoopAsync(CancellationToken ct)
+    {
+        var stream = _transport.Stream;
+        if (stream == null)
+            return;
+
+        try
+        {
+            // 수신 버퍼 관리(부분 프레임 보관, 경계 처리)는 PipeReader가 담당
+            await _receiver.RunAsync(stream, ct);
+        }
+        catch (Exception ex) when (ex is not OperationCanceledException)
+        {
+            Debug.WriteLine($"[VendorCdcProtocol] 수신 루프 예외: {ex.Message}");
+        }
+    }
+
+    /// <summary>
+    /// 유효 프레임 소유권 인계 (FrameReceived 이벤트 이후 호출).
+    /// </summary>
+    private void OnFrameParsed(VendorCdcFrame frame)
+    {
+        Debug.WriteLine(
+            $"[VendorCdcProtocol] RX: cmd=0x{frame.Command:X2}, payload={frame.Payload.Length}B");
+
+        // Dispose 이후에는 Writer가 완료되어 쓰기 실패 → 직접 반환
+        if (!_frameChannel.Writer.TryWrite(frame))
+            frame.Dispose();
+    }
+
+    // ==================== 연결 상태 연동 ====================
+
+    private void OnConnectedChanged(object? sender, EventArgs e)
+    {
+        if (_transport.IsConnected)
+            StartReceiveLoop();
+        else
+            StopReceiveLoop();
+    }
+
+    // ==================== IDisposable ====================
+
+    public void Dispose()
+    {
+        if (_disposed) return;
+        _disposed = true;
+
+        _transport.ConnectedChanged -= OnConnectedChanged;
+        StopReceiveLoop();
+        _frameChannel.Writer.TryComplete();
+        while (_frameChannel.Reader.TryRead(out var pending))
+            pending.Dispose();
+        _sendLock.Dispose();
+    }
+}
@@ -0,0 +1,143 @@
+using System.Buffers;
+using System.Diagnostics;
+using System.IO.Pipelines;
+using System.Text;
+
+namespace BridgeOne.Protocol;
+
+/// <summary>
+/// Vendor CDC 수신 루프.
+/// 임의의 Stream(SerialPort.BaseStream, 테스트용 MemoryStream 등)을 PipeReader로 감싸
+/// <see cref="VendorCdcFrameParser"/>로 파싱하고 결과를 이벤트로 전달합니다.
+/// 부분 수신된 데이터는 Pipe가 보관하므로 별도 누적 버퍼/시프트가 없습니다.
+/// </summary>
+public sealed class VendorCdcReceiver
+{
+    /// <summary>PipeReader가 Stream에서 한 번에 읽는 최소 크기</summary>
+    public const int ReadBufferSize = 1024;
+
+    // ==================== 이벤트 ====================
+
+    /// <summary>
+    /// 유효한 프레임 수신 시 발생 (수신 스레드에서 동기 호출).
+    /// 반환 후 프레임은 <see cref="FrameHandler"/>로 넘어가거나 Dispose되므로,
+    /// 핸들러 밖(예: Dispatcher 람다)에서 페이로드가 필요하면 핸들러 안에서 복사해야 합니다.
+    /// </summary>
+    public event EventHandler<VendorCdcFrame>? FrameReceived;
+
+    /// <summary>디버그 텍스트 수신 시 발생 (0xFF가 아닌 바이트열)</summary>
+    public event EventHandler<string>? DebugTextReceived;
+
+    /// <summary>CRC 오류로 프레임 폐기 시 발생 (이벤트 반환 후 페이로드 버퍼는 풀로 반환됨)</summary>
+    public event EventHandler<VendorCdcFrame>? FrameDiscarded;
+
+    /// <summary>
+    /// 이벤트 발생 후 유효 프레임의 소유권을 넘겨받는 콜백 (예: Channel 쓰기).
+    /// null이면 프레임은 이벤트 직후 Dispose됩니다.
+    /// </summary>
+    public Action<VendorCdcFrame>? FrameHandler { get; set; }
+
+    /// <summary>
+    /// Stream이 끝나거나(읽기 0/IsCompleted), 오류가 나거나, 취소될 때까지 수신합니다.
+    /// Stream은 닫지 않습니다.
+    /// </summary>
+    public async Task RunAsync(Stream stream, CancellationToken cancellationToken = default)
+    {
+        var reader = PipeReader.Create(stream,
+            new StreamPipeReaderOptions(bufferSize: ReadBufferSize, leaveOpen: true));
+
+        try
+        {
+            while (true)
+            {
+                ReadResult result;
+                try
+                {
+                    result = await reader.ReadAsync(cancellationToken);
+                }
+                catch (OperationCanceledException)
+                {
+                    break;
+                }
+                catch (Exception ex) when (ex is IOException or ObjectDisposedException)
+                {
+                    Debug.WriteLine(
+                        $"[VendorCdcReceiver] 수신 스트림 오류 (연결 해제 가능): {ex.Message}");
+                    break;
+                }
+
+                var buffer = result.Buffer;
+                Process(ref buffer);
+
+                // 소비한 곳까지 해제, 남은 부분 프레임은 전부 검사했으므로 다음 수신까지 대기
+                reader.AdvanceTo(buffer.Start, buffer.End);
+
+                if (result.IsCompleted || result.IsCanceled)
+                    break;
+            }
+        }
+        finally
+        {
+            await reader.CompleteAsync();
+        }
+    }
+
+    /// <summary>
+    /// 버퍼에서 완성된 토큰을 모두 처리하고, 미완성 꼬리만 buffer에 남깁니다.
+    /// </summary>
+    public void Process(ref ReadOnlySequence<byte> buffer)
+    {
+        while (true)
+        {
+            var token = VendorCdcFrameParser.TryRead(ref buffer, out var frame, out var text);
+            switch (token)
+            {
+                case VendorCdcToken.NeedMoreData:
+                    return;
+
+                case VendorCdcToken.DebugText:
+                    RaiseDebugText(text);
+                    break;
+
+                case VendorCdcToken.NonFrameHeader:
+                    DebugTextReceived?.Invoke(this, "[0xFF:non-frame]");
+                    break;
+
+                case VendorCdcToken.Frame:
+                    DispatchFrame(frame!);
+                    break;
+            }
+        }
+    }
+
+    private void DispatchFrame(VendorCdcFrame frame)
+    {
+        if (!frame.IsValid)
+        {
+            Debug.WriteLine(
+                $"[VendorCdcReceiver] CRC 오류 → 프레임 폐기: cmd=0x{frame.Command:X2}");
+            FrameDiscarded?.Invoke(this, frame);
+            frame.Dispose();
+            return;
+        }
+
+        FrameReceived?.Invoke(this, frame);
+
+        var handler = FrameHandler;
+        if (handler != null)
+            handler(frame);
+        else
+            frame.Dispose();
+    }
+
+    private void RaiseDebugText(in ReadOnlySequence<byte> text)
+    {
+        var handler = DebugTextReceived;
+        if (handler == null)
+            return;
+
+        var decoded = Encoding.UTF8.GetString(text).Replace("\0", string.Empty);
+        if (!string.IsNullOrEmpty(decoded))
+            handler(this, decoded);
+    }
+}
@@ -24,9 +24,13 @@ namespace BridgeOne
 
             // 서비스 계층 (등록 순서 = 해제 역순)
             services.AddSingleton<CdcConnectionService>();
+            services.AddSingleton<IVendorCdcTransport>(
+                sp => sp.GetRequiredService<CdcConnectionService>());
             services.AddSingleton<VendorCdcProtocol>();
             services.AddSingleton<HandshakeService>();
             services.AddSingleton<KeepAliveService>();
+            services.AddSingleton<TaskProfilerService>();
+            services.AddSingleton<MacroUploadService>();
 
             // ViewModel 계층
             services.AddSingleton<ConnectionViewModel>();
@@ -53,6 +57,9 @@ namespace BridgeOne
                 // Keep-alive 서비스 중지 (재연결 루프 정리)
                 _serviceProvider.GetService<KeepAliveService>()?.Stop();
 
+                // 태스크 프로파일러 폴링 중지
+                _serviceProvider.GetService<TaskProfilerService>()?.Stop();
+
                 // 연결 서비스 명시적 중지 (핫플러그 워처 정리)
                 _serviceProvider.GetService<CdcConnectionService>()?.Stop();
 
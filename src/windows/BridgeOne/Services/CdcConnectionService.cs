@@ -3,14 +3,16 @@ using System.IO;
 using System.IO.Ports;
 using System.Management;
 using BridgeOne.Models;
+using BridgeOne.Protocol;
 
 namespace BridgeOne.Services;
 
 /// <summary>
 /// ESP32-S3 BridgeOne 동글의 CDC COM 포트를 자동 감지하고 SerialPort로 연결하는 서비스.
 /// USB 핫플러그(연결/해제)를 실시간 모니터링합니다.
+/// Protocol 계층에는 <see cref="IVendorCdcTransport"/>로 SerialPort.BaseStream을 제공합니다.
 /// </summary>
-public sealed class CdcConnectionService : IDisposable
+public sealed class CdcConnectionService : IVendorCdcTransport, IDisposable
 {
     // ==================== 상수 ====================
 
@@ -42,6 +44,11 @@ public sealed class CdcConnectionService : IDisposable
             if (_state == value) return;
             var old = _state;
             _state = value;
+
+            // Protocol 수신 루프가 ViewModel의 자동 핸드셰이크보다 먼저 시작되도록 선행 발생
+            if (old == ConnectionState.Connected || value == ConnectionState.Connected)
+                ConnectedChanged?.Invoke(this, EventArgs.Empty);
+
             StateChanged?.Invoke(this, new ConnectionStateEventArgs(old, value));
         }
     }
@@ -49,9 +56,19 @@ public sealed class CdcConnectionService : IDisposable
     /// <summary>현재 연결된 장치 정보 (미연결 시 null)</summary>
     public DeviceInfo? ConnectedDevice { get; private set; }
 
-    /// <summary>내부 SerialPort (Protocol 계층에서 BaseStream 접근용)</summary>
+    /// <summary>내부 SerialPort</summary>
     public SerialPort? Port { get; private set; }
 
+    // ==================== IVendorCdcTransport ====================
+
+    public bool IsConnected => State == ConnectionState.Connected;
+
+    public Stream? Stream => Port is { IsOpen: true } port ? port.BaseStream : null;
+
+    public event EventHandler? ConnectedChanged;
+
+    bool IVendorCdcTransport.TryConnect() => TryScanAndConnect();
+
     // ==================== 이벤트 ====================
 
     public event EventHandler<ConnectionStateEventArgs>? StateChanged;
@@ -21,8 +21,19 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
     private readonly VendorCdcProtocol _protocol;
     private readonly HandshakeService _handshakeService;
     private readonly KeepAliveService _keepAliveService;
+    private readonly TaskProfilerService _taskProfilerService;
+    private readonly MacroUploadService _macroUploadService;
     private readonly StringBuilder _debugLogBuilder = new();
     private const int MaxDebugLogLines = 200;
+    private const int RttHistogramRefreshMs = 1000;
+    private const double RttHistogramBarMaxHeight = 24;
+    private readonly int[] _rttBinCounts = new int[KeepAliveService.DisplayBinEdgesMs.Length + 1];
+    private long _lastRttHistogramRefresh;
+    private const double TaskCpuBarMaxWidth = 120;
+    private const int CoreLoadHistoryLength = 60;
+    private const double CoreLoadChartWidth = 120;
+    private const double CoreLoadChartHeight = 24;
+    private readonly List<int>[] _coreLoadHistory = [new(), new()];
     private bool _disposed;
 
     // ==================== Observable Properties ====================
@@ -56,7 +67,28 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
 
     [ObservableProperty]
     [NotifyPropertyChangedFor(nameof(RttDisplayText))]
-    private double _averageRttMs = -1;
+    [NotifyPropertyChangedFor(nameof(RttTailDisplayText))]
+    private RttPercentiles _recentRtt = RttPercentiles.Empty;
+
+    /// <summary>최근 60초 RTT 분포 (KeepAliveService.DisplayBinEdgesMs 구간, 1초마다 갱신)</summary>
+    [ObservableProperty]
+    private IReadOnlyList<RttHistogramBar> _rttHistogramBars = [];
+
+    /// <summary>태스크별 CPU/스케줄링 (TaskProfilerService, 1초마다 갱신)</summary>
+    [ObservableProperty]
+    private IReadOnlyList<TaskProfileRow> _taskProfileRows = [];
+
+    /// <summary>코어별 부하 텍스트 (예: "Core0 23% · Core1 8%")</summary>
+    [ObservableProperty]
+    private string _coreLoadText = "--";
+
+    /// <summary>최근 60초 Core 0 부하 추이 (CoreLoadChartWidth × CoreLoadChartHeight px)</summary>
+    [ObservableProperty]
+    private PointCollection _core0LoadPoints = [];
+
+    /// <summary>최근 60초 Core 1 부하 추이</summary>
+    [ObservableProperty]
+    private PointCollection _core1LoadPoints = [];
 
     [ObservableProperty]
     [NotifyPropertyChangedFor(nameof(QualityDisplayText))]
@@ -114,17 +146,23 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
     public bool IsDeviceInfoVisible => ConnectionState == ConnectionState.Connected && !string.IsNullOrEmpty(ComPort);
     public string ToggleButtonText => IsConnected ? "연결 해제" : "연결";
 
-    /// <summary>RTT 표시 텍스트 (예: "RTT: 5ms (평균 4.2ms)")</summary>
+    /// <summary>RTT 표시 텍스트 (예: "RTT: 5.2ms (p50 4.1ms · p99 9.8ms)")</summary>
     public string RttDisplayText
     {
         get
         {
             if (LastRttMs < 0) return "RTT: --";
-            if (AverageRttMs < 0) return $"RTT: {LastRttMs:F0}ms";
-            return $"RTT: {LastRttMs:F0}ms (평균 {AverageRttMs:F1}ms)";
+            if (RecentRtt.Count == 0) return $"RTT: {LastRttMs:F1}ms";
+            return $"RTT: {LastRttMs:F1}ms (p50 {RecentRtt.P50Ms:F1}ms · p99 {RecentRtt.P99Ms:F1}ms)";
         }
     }
 
+    /// <summary>꼬리 지연/손실 표시 텍스트 (예: "p90 6.0ms · max 12.0ms · 손실 0.0% (최근 10초)")</summary>
+    public string RttTailDisplayText => RecentRtt.Count == 0 && RecentRtt.LostCount == 0
+        ? string.Empty
+        : $"p90 {Math.Max(RecentRtt.P90Ms, 0):F1}ms · max {Math.Max(RecentRtt.MaxMs, 0):F1}ms · " +
+          $"손실 {RecentRtt.LossRate * 100:F1}% (최근 {KeepAliveService.QualityWindow.TotalSeconds:F0}초)";
+
     /// <summary>연결 품질 표시 텍스트</summary>
     public string QualityDisplayText => ConnectionQuality switch
     {
@@ -167,12 +205,16 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         CdcConnectionService connectionService,
         VendorCdcProtocol protocol,
         HandshakeService handshakeService,
-        KeepAliveService keepAliveService)
+        KeepAliveService keepAliveService,
+        TaskProfilerService taskProfilerService,
+        MacroUploadService macroUploadService)
     {
         _connectionService = connectionService;
         _protocol = protocol;
         _handshakeService = handshakeService;
         _keepAliveService = keepAliveService;
+        _taskProfilerService = taskProfilerService;
+        _macroUploadService = macroUploadService;
 
         // CdcConnectionService 이벤트 (UI 스레드에서 발생)
         _connectionService.StateChanged += OnConnectionStateChanged;
@@ -191,6 +233,9 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         _keepAliveService.ReconnectAttempt += OnKeepAliveReconnectAttempt;
         _keepAliveService.StatusLog += OnKeepAliveStatusLog;
 
+        // TaskProfilerService 이벤트 (백그라운드 스레드에서 발생 → Dispatcher 필요)
+        _taskProfilerService.SnapshotReceived += OnTaskProfileSnapshot;
+
         // 초기 상태 동기화
         SyncFromCurrentState();
     }
@@ -239,6 +284,13 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
                 AppendDebugLog($"[핸드셰이크] 성공 ({sw.ElapsedMilliseconds}ms)");
                 AppendDebugLog($"  디바이스: {result.DeviceName ?? "(없음)"}");
                 AppendDebugLog($"  펌웨어: {result.FirmwareVersion ?? "(없음)"}");
+                var method = result.Method switch
+                {
+                    HandshakeMethod.Resume => "RESUME (세션 재개)",
+                    HandshakeMethod.Hello => "HELLO (1회 왕복)",
+                    _ => "AUTH + STATE_SYNC (2회 왕복)",
+                };
+                AppendDebugLog($"  방식: {method}");
                 AppendDebugLog($"  모드: {result.Mode}");
                 AppendDebugLog($"  수락된 기능: [{string.Join(", ", result.AcceptedFeatures)}]");
 
@@ -249,6 +301,12 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
                 // 핸드셰이크 성공 → Keep-alive 자동 시작
                 _keepAliveService.Start();
                 AppendDebugLog("[Keep-alive] 자동 시작됨");
+
+                // 태스크 프로파일 폴링 (1초 주기 TOP_QUERY)
+                _taskProfilerService.Start();
+
+                // Android 단축키 버튼이 트리거할 탭 매크로 (내용이 같으면 동글이 플래시 쓰기 생략)
+                await UploadShortcutMacrosAsync();
             }
             else
             {
@@ -271,6 +329,30 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         AppendDebugLog("========== 핸드셰이크 테스트 완료 ==========");
     }
 
+    /// <summary>
+    /// 단축키 매크로(ShortcutMacros.Defaults)를 동글에 업로드하고 결과를 로그에 남깁니다.
+    /// </summary>
+    private async Task UploadShortcutMacrosAsync()
+    {
+        try
+        {
+            var acks = await _macroUploadService.UploadShortcutsAsync();
+            var failed = acks.Where(ack => !ack.Success).ToList();
+            if (failed.Count == 0)
+            {
+                AppendDebugLog($"[매크로] 단축키 매크로 {acks.Count}개 업로드 완료");
+                return;
+            }
+
+            foreach (var ack in failed)
+                AppendDebugLog($"[매크로] 매크로 {ack.Id} 업로드 실패: {ack.Reason}");
+        }
+        catch (Exception ex)
+        {
+            AppendDebugLog($"[매크로] 업로드 예외: {ex.Message}");
+        }
+    }
+
     [RelayCommand(CanExecute = nameof(IsConnected))]
     private async Task SendPingAsync()
     {
@@ -306,8 +388,11 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         if (e.NewState == ConnectionState.Disconnected || e.NewState == ConnectionState.Error)
         {
             _keepAliveService.Stop();
+            _taskProfilerService.Stop();
+            ClearTaskProfile();
             LastRttMs = -1;
-            AverageRttMs = -1;
+            RecentRtt = RttPercentiles.Empty;
+            RttHistogramBars = [];
             ConnectionQuality = ConnectionQuality.Unknown;
             ActiveFeatures = [];
             Esp32Mode = Esp32Mode.Unknown;
@@ -336,6 +421,10 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         if (frame.Command == (byte)VendorCdcCommand.Pong && _keepAliveService.IsRunning)
             return;
 
+        // TOP_REPORT도 1초마다 오므로 프로파일러 동작 중에는 로그 생략
+        if (frame.Command == (byte)VendorCdcCommand.TopReport && _taskProfilerService.IsRunning)
+            return;
+
         var cmdName = frame.Command switch
         {
             (byte)VendorCdcCommand.Pong => "PONG",
@@ -346,29 +435,45 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
             _ => $"0x{frame.Command:X2}"
         };
 
-        var payloadHex = frame.Payload.Length > 0
-            ? $" [{BitConverter.ToString(frame.Payload).Replace("-", " ")}]"
+        // 페이로드는 풀 버퍼라 핸들러 반환 후 재사용됨 → Dispatcher 람다 전에 문자열로 변환
+        var payloadLength = frame.Payload.Length;
+        var payloadHex = payloadLength > 0
+            ? $" [{BitConverter.ToString(frame.Payload.ToArray()).Replace("-", " ")}]"
             : "";
 
         Application.Current.Dispatcher.BeginInvoke(() =>
-            AppendDebugLog($"[수신] {cmdName} (payload={frame.Payload.Length}B){payloadHex}"));
+            AppendDebugLog($"[수신] {cmdName} (payload={payloadLength}B){payloadHex}"));
     }
 
     /// <summary>CRC 오류 프레임 폐기 (백그라운드 스레드 → Dispatcher 마샬링)</summary>
     private void OnFrameDiscarded(object? sender, VendorCdcFrame frame)
     {
+        var command = frame.Command;
+        var payloadLength = frame.Payload.Length;
         Application.Current.Dispatcher.BeginInvoke(() =>
-            AppendDebugLog($"[CRC 오류] cmd=0x{frame.Command:X2}, payload={frame.Payload.Length}B"));
+            AppendDebugLog($"[CRC 오류] cmd=0x{command:X2}, payload={payloadLength}B"));
     }
 
     // ==================== KeepAliveService Event Handlers ====================
 
     private void OnRttUpdated(object? sender, RttUpdatedEventArgs e)
     {
+        // 50ms PING 주기에서도 UI 부하가 없도록 히스토그램은 1초마다만 다시 계산
+        IReadOnlyList<RttHistogramBar>? bars = null;
+        var now = Environment.TickCount64;
+        if (now - _lastRttHistogramRefresh >= RttHistogramRefreshMs)
+        {
+            _lastRttHistogramRefresh = now;
+            _keepAliveService.CopyRttHistogram(_rttBinCounts);
+            bars = BuildHistogramBars(_rttBinCounts);
+        }
+
         Application.Current.Dispatcher.BeginInvoke(() =>
         {
             LastRttMs = e.CurrentRttMs;
-            AverageRttMs = e.AverageRttMs;
+            RecentRtt = e.Recent;
+            if (bars != null)
+                RttHistogramBars = bars;
         });
     }
 
@@ -385,8 +490,11 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         Application.Current.Dispatcher.BeginInvoke(() =>
         {
             AppendDebugLog("[Keep-alive] 연결 끊김 감지 → 자동 재연결 시작");
+            _taskProfilerService.Stop();
+            ClearTaskProfile();
             LastRttMs = -1;
-            AverageRttMs = -1;
+            RecentRtt = RttPercentiles.Empty;
+            RttHistogramBars = [];
             ActiveFeatures = [];
             Esp32Mode = Esp32Mode.Disconnected;
             IsReconnecting = true;
@@ -398,6 +506,8 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         Application.Current.Dispatcher.BeginInvoke(() =>
         {
             AppendDebugLog("[Keep-alive] 재연결 성공! Keep-alive 재시작됨");
+            _taskProfilerService.Start();
+            _ = UploadShortcutMacrosAsync();
             Esp32Mode = Esp32Mode.Standard;
             IsReconnecting = false;
             ReconnectStatusText = string.Empty;
@@ -420,6 +530,33 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         });
     }
 
+    // ==================== TaskProfilerService Event Handlers ====================
+
+    private void OnTaskProfileSnapshot(object? sender, TaskProfileSnapshot snapshot)
+    {
+        var rows = BuildTaskProfileRows(snapshot);
+
+        Application.Current.Dispatcher.BeginInvoke(() =>
+        {
+            TaskProfileRows = rows;
+
+            var load = snapshot.CoreLoadPermille;
+            CoreLoadText = load.Count == 0
+                ? "--"
+                : string.Join(" · ", load.Select((l, core) => $"Core{core} {l / 10.0:F1}%"));
+
+            for (int core = 0; core < _coreLoadHistory.Length; core++)
+            {
+                var history = _coreLoadHistory[core];
+                history.Add(core < load.Count ? load[core] : 0);
+                if (history.Count > CoreLoadHistoryLength)
+                    history.RemoveAt(0);
+            }
+            Core0LoadPoints = BuildLoadPoints(_coreLoadHistory[0]);
+            Core1LoadPoints = BuildLoadPoints(_coreLoadHistory[1]);
+        });
+    }
+
     // ==================== Private Helpers ====================
 
     private void SyncFromCurrentState()
@@ -435,6 +572,69 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         DeviceDescription = device?.Description ?? string.Empty;
     }
 
+    /// <summary>구간별 개수 → 막대 목록 (가장 많은 구간을 RttHistogramBarMaxHeight px로)</summary>
+    private static IReadOnlyList<RttHistogramBar> BuildHistogramBars(ReadOnlySpan<int> counts)
+    {
+        var edges = KeepAliveService.DisplayBinEdgesMs;
+        int max = 0;
+        foreach (var c in counts)
+            max = Math.Max(max, c);
+
+        var bars = new RttHistogramBar[counts.Length];
+        for (int i = 0; i < counts.Length; i++)
+        {
+            var label = i == 0 ? $"<{edges[0]:G}"
+                : i == edges.Length ? $"{edges[^1]:G}+"
+                : $"{edges[i - 1]:G}-{edges[i]:G}";
+            bars[i] = new RttHistogramBar($"{label}ms", counts[i],
+                max == 0 ? 0 : RttHistogramBarMaxHeight * counts[i] / max);
+        }
+        return bars;
+    }
+
+    /// <summary>스냅샷 → 표시 행 (CPU 100% = TaskCpuBarMaxWidth px)</summary>
+    private static IReadOnlyList<TaskProfileRow> BuildTaskProfileRows(TaskProfileSnapshot snapshot)
+    {
+        var seconds = snapshot.IntervalUs > 0 ? snapshot.IntervalUs / 1_000_000.0 : 1;
+        var rows = new TaskProfileRow[snapshot.Tasks.Count];
+
+        for (int i = 0; i < rows.Length; i++)
+        {
+            var t = snapshot.Tasks[i];
+            // 고정 코어(affinity)이며 실제 실행 코어가 아님
+            var affinity = t.Affinity >= 0 ? $"C{t.Affinity}" : "any";
+            var detail = $"P{t.Priority} affinity {affinity} · stack {t.StackFreeBytes}B";
+            if (t.Wakes.HasValue)
+                detail += $" · wake {t.Wakes.Value / seconds:F0}/s · lat {t.LatencyAvgUs}/{t.LatencyMaxUs}us";
+
+            rows[i] = new TaskProfileRow(t.Name, $"{t.CpuPermille / 10.0:F1}%", detail,
+                TaskCpuBarMaxWidth * Math.Min(t.CpuPermille, 1000) / 1000);
+        }
+        return rows;
+    }
+
+    /// <summary>부하 추이 (‰) → 꺾은선 좌표 (오른쪽 끝이 최신)</summary>
+    private static PointCollection BuildLoadPoints(List<int> history)
+    {
+        var points = new PointCollection(history.Count);
+        var step = CoreLoadChartWidth / (CoreLoadHistoryLength - 1);
+        var x0 = CoreLoadChartWidth - step * (history.Count - 1);
+        for (int i = 0; i < history.Count; i++)
+            points.Add(new Point(x0 + step * i, CoreLoadChartHeight * (1 - history[i] / 1000.0)));
+        points.Freeze();
+        return points;
+    }
+
+    private void ClearTaskProfile()
+    {
+        TaskProfileRows = [];
+        CoreLoadText = "--";
+        foreach (var history in _coreLoadHistory)
+            history.Clear();
+        Core0LoadPoints = [];
+        Core1LoadPoints = [];
+    }
+
     private void AppendDebugLog(string text)
     {
         var trimmed = text.TrimEnd('\r', '\n');
@@ -474,9 +674,20 @@ public sealed partial class ConnectionViewModel : ObservableObject, IDisposable
         _keepAliveService.Reconnected -= OnKeepAliveReconnected;
         _keepAliveService.ReconnectAttempt -= OnKeepAliveReconnectAttempt;
         _keepAliveService.StatusLog -= OnKeepAliveStatusLog;
+        _taskProfilerService.SnapshotReceived -= OnTaskProfileSnapshot;
     }
 }
 
+// ==================== RTT 히스토그램 막대 ====================
+
+/// <summary>RTT 분포 막대 하나 (Label: 구간, Count: 샘플 수, Height: 막대 높이 px)</summary>
+public sealed record RttHistogramBar(string Label, int Count, double Height);
+
+// ==================== 태스크 프로파일 행 ====================
+
+/// <summary>태스크 1개 표시 행 (Cpu: "12.3%", Detail: 우선순위/코어/스택/깨어남/지연, BarWidth: px)</summary>
+public sealed record TaskProfileRow(string Name, string Cpu, string Detail, double BarWidth);
+
 // ==================== ESP32 모드 열거형 ====================
 
 /// <summary>ESP32 동글의 현재 운영 모드</summary>